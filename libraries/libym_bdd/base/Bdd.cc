@@ -19,6 +19,7 @@
 
 #include "BddMgr.h"
 #include "Dumper.h"
+#include "BinDumper.h"
 
 
 BEGIN_NAMESPACE_YM_BDD
@@ -669,6 +670,60 @@ dump(const BddList& array,
   }
 }
 
+// @brief 内容をバイナリ形式でダンプする．
+void
+Bdd::bin_dump(ostream& s,
+	      bool compress) const
+{
+  BinDumper dumper(mMgr, s, compress);
+  dumper.add_root(root());
+  dumper.write();
+}
+
+// @brief BDD ベクタの内容をバイナリ形式でダンプする．
+// @param[in] array BDD の配列
+// @param[in] s 出力ストリーム
+// @param[in] compress true の時には圧縮する．
+void
+bin_dump(const BddVector& array,
+	 ostream& s,
+	 bool compress)
+{
+  if ( array.empty() ) {
+    return;
+  }
+  // 今は array の中のBDDのマネージャがすべて同じと仮定している．
+  BddMgr* mgr = array.front().mMgr;
+  BinDumper dumper(mgr, s, compress);
+  for (BddVector::const_iterator p = array.begin();
+       p != array.end(); ++ p) {
+    dumper.add_root(p->root());
+  }
+  dumper.write();
+}
+
+// @brief BDD リストの内容をバイナリ形式でダンプする．
+// @param[in] array BDD のリスト
+// @param[in] s 出力ストリーム
+// @param[in] compress true の時には圧縮する．
+void
+bin_dump(const BddList& array,
+	 ostream& s,
+	 bool compress)
+{
+  if ( array.empty() ) {
+    return;
+  }
+  // 今は array の中のBDDのマネージャがすべて同じと仮定している．
+  BddMgr* mgr = array.front().mMgr;
+  BinDumper dumper(mgr, s, compress);
+  for (BddList::const_iterator p = array.begin();
+       p != array.end(); ++ p) {
+    dumper.add_root(p->root());
+  }
+  dumper.write();
+}
+
 // @brief ダンプされた情報を BDD を読み込む．
 // @param[in] s 入力ストリーム
 // @return 読み込まれた BDD
@@ -715,6 +770,67 @@ BddMgrRef::restore(istream& s,
   }
 }
 
+// @brief バイナリ形式でダンプされた情報を BDD を読み込む．
+// @param[in] s 入力ストリーム
+// @return 読み込まれた BDD
+Bdd
+BddMgrRef::bin_restore(istream& s)
+{
+  BinRestorer restorer(mPtr);
+  size_t n = restorer.read(s);
+  if ( n != 1 ) {
+    // エラーもしくは複数の BDD データだった．
+    return Bdd(mPtr, kEdgeError);
+  }
+  else {
+    return Bdd(mPtr, restorer.root(0));
+  }
+}
+
+// @brief バイナリ形式でダンプされた情報を BDD ベクタに読み込む．
+// @param[in] s 入力ストリーム
+// @param[in] array 読み込み先の BDD ベクタ
+void
+BddMgrRef::bin_restore(istream& s,
+		       BddVector& array)
+{
+  BinRestorer restorer(mPtr);
+  size_t n = restorer.read(s);
+  array.resize(n);
+  for (size_t i = 0; i < n; ++ i) {
+    array[i] = Bdd(mPtr, restorer.root(i));
+  }
+}
+
+// @brief バイナリ形式でダンプされた情報を BDD リストに読み込む．
+// @param[in] s 入力ストリーム
+// @param[in] array 読み込み先の BDD リスト
+void
+BddMgrRef::bin_restore(istream& s,
+		       BddList& array)
+{
+  BinRestorer restorer(mPtr);
+  size_t n = restorer.read(s);
+  for (size_t i = 0; i < n; ++ i) {
+    array.push_back(Bdd(mPtr, restorer.root(i)));
+  }
+}
+
+// @brief バイナリ形式でダンプされたファイルを BDD ベクタに読み込む．
+// @param[in] filename ファイル名
+// @param[in] array 読み込み先の BDD ベクタ
+void
+BddMgrRef::bin_restore(const string& filename,
+		       BddVector& array)
+{
+  BinRestorer restorer(mPtr);
+  size_t n = restorer.read(filename);
+  array.resize(n);
+  for (size_t i = 0; i < n; ++ i) {
+    array[i] = Bdd(mPtr, restorer.root(i));
+  }
+}
+
 // @brief BDD が使っているノード数を数える．
 size_t
 Bdd::size() const
@@ -342,4 +342,114 @@ BddMgr::xor_op(const list<tBddEdge>& edge_list)
   return ans;
 }
 
+
+//////////////////////////////////////////////////////////////////////
+// ZDD 関係の演算
+// ZDD を扱えるマネージャはこれらをオーバーライドする．
+//////////////////////////////////////////////////////////////////////
+
+// varid のみからなる集合を唯一の要素とする集合族を作る．
+tBddEdge
+BddMgr::zdd_single(tVarId varid)
+{
+  return kEdgeError;
+}
+
+// 集合族の和を計算する．
+tBddEdge
+BddMgr::zdd_union(tBddEdge e1,
+		  tBddEdge e2)
+{
+  return kEdgeError;
+}
+
+// 集合族の共通部分を計算する．
+tBddEdge
+BddMgr::zdd_intersect(tBddEdge e1,
+		      tBddEdge e2)
+{
+  return kEdgeError;
+}
+
+// 集合族の差を計算する．
+tBddEdge
+BddMgr::zdd_diff(tBddEdge e1,
+		 tBddEdge e2)
+{
+  return kEdgeError;
+}
+
+// 集合族の積を計算する．
+tBddEdge
+BddMgr::zdd_product(tBddEdge e1,
+		    tBddEdge e2)
+{
+  return kEdgeError;
+}
+
+// 集合族の商を計算する．
+tBddEdge
+BddMgr::zdd_quotient(tBddEdge e1,
+		     tBddEdge e2)
+{
+  return kEdgeError;
+}
+
+// varid を含まない集合のみを取り出す．
+tBddEdge
+BddMgr::zdd_subset0(tBddEdge e,
+		    tVarId varid)
+{
+  return kEdgeError;
+}
+
+// varid を含む集合のみを取り出して varid を取り除く．
+tBddEdge
+BddMgr::zdd_subset1(tBddEdge e,
+		    tVarId varid)
+{
+  return kEdgeError;
+}
+
+// 各集合の varid の有無を反転させる．
+tBddEdge
+BddMgr::zdd_change(tBddEdge e,
+		   tVarId varid)
+{
+  return kEdgeError;
+}
+
+// 集合族の要素数を数える．
+mpz_class
+BddMgr::zdd_count(tBddEdge e)
+{
+  return 0;
+}
+
+// BDD の表す関数の 1 となる最小項の集合族を作る．
+tBddEdge
+BddMgr::bdd_to_zdd(tBddEdge e,
+		   tBddEdge s)
+{
+  return kEdgeError;
+}
+
+// ZDD の表す集合族を特性関数とする BDD を作る．
+tBddEdge
+BddMgr::zdd_to_bdd(tBddEdge e,
+		   tBddEdge s)
+{
+  return kEdgeError;
+}
+
+// 非冗長積和形を ZDD で求める．
+tBddEdge
+BddMgr::zdd_isop(tBddEdge l,
+		 tBddEdge u,
+		 tBddEdge& cover)
+{
+  cover = kEdgeError;
+  return kEdgeError;
+}
+
 END_NAMESPACE_YM_BDD
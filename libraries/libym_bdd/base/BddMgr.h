@@ -105,6 +105,11 @@ public:
   void
   disable_DVO() = 0;
 
+  // 変数順の最適化(sifting)を行う．
+  virtual
+  void
+  reorder() = 0;
+
   
   //////////////////////////////////////////////////////////////////////
   // BDD 生成用関数
@@ -299,6 +304,95 @@ public:
   tBddEdge
   SCC(tBddEdge e) = 0;
 
+
+  //////////////////////////////////////////////////////////////////////
+  // ZDD 関係の演算
+  // ZDD の節点は BDD と同じ節点テーブルに置かれる．
+  // 枝の否定属性は空集合を要素として含むかどうかの反転を表す．
+  // ZDD を扱えないマネージャでは kEdgeError を返す．
+  //////////////////////////////////////////////////////////////////////
+
+  // varid のみからなる集合を唯一の要素とする集合族を作る．
+  virtual
+  tBddEdge
+  zdd_single(tVarId varid);
+
+  // 集合族の和を計算する．
+  virtual
+  tBddEdge
+  zdd_union(tBddEdge e1,
+	    tBddEdge e2);
+
+  // 集合族の共通部分を計算する．
+  virtual
+  tBddEdge
+  zdd_intersect(tBddEdge e1,
+		tBddEdge e2);
+
+  // 集合族の差を計算する．
+  virtual
+  tBddEdge
+  zdd_diff(tBddEdge e1,
+	   tBddEdge e2);
+
+  // 集合族の積 { a ∪ b | a ∈ e1, b ∈ e2 } を計算する．
+  virtual
+  tBddEdge
+  zdd_product(tBddEdge e1,
+	      tBddEdge e2);
+
+  // 集合族の商(weak division)を計算する．
+  virtual
+  tBddEdge
+  zdd_quotient(tBddEdge e1,
+	       tBddEdge e2);
+
+  // varid を含まない集合のみを取り出す．
+  virtual
+  tBddEdge
+  zdd_subset0(tBddEdge e,
+	      tVarId varid);
+
+  // varid を含む集合のみを取り出して varid を取り除く．
+  virtual
+  tBddEdge
+  zdd_subset1(tBddEdge e,
+	      tVarId varid);
+
+  // 各集合の varid の有無を反転させる．
+  virtual
+  tBddEdge
+  zdd_change(tBddEdge e,
+	     tVarId varid);
+
+  // 集合族の要素数を数える．
+  virtual
+  mpz_class
+  zdd_count(tBddEdge e);
+
+  // BDD の表す関数の 1 となる最小項(1 の変数の集合)の集合族を作る．
+  // s は全体の変数集合を表すキューブ
+  virtual
+  tBddEdge
+  bdd_to_zdd(tBddEdge e,
+	     tBddEdge s);
+
+  // ZDD の表す集合族を特性関数とする BDD を作る．
+  // s は全体の変数集合を表すキューブ
+  virtual
+  tBddEdge
+  zdd_to_bdd(tBddEdge e,
+	     tBddEdge s);
+
+  // lower と upper で指定された不完全指定論理関数の非冗長積和形を
+  // ZDD で求める．
+  // 変数 x の肯定リテラルは 2x, 否定リテラルは 2x + 1 の ZDD 変数で表す．
+  virtual
+  tBddEdge
+  zdd_isop(tBddEdge l,
+	   tBddEdge u,
+	   tBddEdge& cover);
+
   
   //////////////////////////////////////////////////////////////////////
   // BDD の構造に関係したメソッド
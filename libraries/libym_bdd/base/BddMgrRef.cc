@@ -444,6 +444,13 @@ BddMgrRef::disable_DVO()
   mPtr->disable_DVO();
 }
 
+// 変数順の最適化(sifting)を行う．
+void
+BddMgrRef::reorder()
+{
+  mPtr->reorder();
+}
+
 // ガーベージコレクションを行なう．
 // 具体的には各ノードの参照回数が0のノードをフリーリストに回収し
 // 再利用できるよ うにする．
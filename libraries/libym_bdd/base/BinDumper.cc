@@ -0,0 +1,545 @@
+
+/// @file libym_bdd/base/BinDumper.cc
+/// @brief BinDumper, BinRestorer の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#if HAVE_CONFIG_H
+#include <ymconfig.h>
+#endif
+
+#include "BinDumper.h"
+
+#if defined(HAVE_ZLIB)
+#include "ym_zstream/zstream.h"
+#endif
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+BEGIN_NONAMESPACE
+
+// マジックナンバー
+const char kBinMagic[8] = { 'Y', 'M', 'B', 'D', 'D', 'B', 'I', 'N' };
+
+// 形式のバージョン番号
+const ymuint32 kBinVersion = 1;
+
+// バイトオーダー検査用の値
+const ymuint32 kBinByteOrder = 0x01020304;
+
+// 本体が圧縮されていることを表すフラグ
+const ymuint32 kBinCompressed = 1U;
+
+// 枝を 64 ビットで表していることを表すフラグ
+const ymuint32 kBinWide = 2U;
+
+// エラーとオーバーフローを表す符号
+const ymuint64 kBinError = ~static_cast<ymuint64>(0);
+const ymuint64 kBinOverflow = kBinError - 1;
+
+// 一度に読み書きする節点数
+const size_t kBinChunk = 64 * 1024;
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// BinDumper
+//////////////////////////////////////////////////////////////////////
+
+// コンストラクタ
+BinDumper::BinDumper(BddMgr* mgr,
+		     ostream& s,
+		     bool compress) :
+  mMgr(mgr),
+  mStream(s),
+  mCompress(compress),
+  mNodeNum(0)
+{
+#if !defined(HAVE_ZLIB)
+  // 圧縮はできない．
+  mCompress = false;
+#endif
+}
+
+// デストラクタ
+BinDumper::~BinDumper()
+{
+  mStream.flush();
+}
+
+// e を根として登録する．
+void
+BinDumper::add_root(tBddEdge e)
+{
+  mRootList.push_back(e);
+}
+
+// 登録された根から到達可能な節点を書き出す．
+void
+BinDumper::write()
+{
+  for (vector<tBddEdge>::iterator p = mRootList.begin();
+       p != mRootList.end(); ++ p) {
+    collect(*p);
+  }
+
+  // 深いレベルから順に番号を振る．
+  ymuint32 block_num = 0;
+  mNodeNum = 0;
+  for (size_t level = mLevelList.size(); level -- > 0; ) {
+    vector<tBddEdge>& node_list = mLevelList[level];
+    if ( node_list.empty() ) {
+      continue;
+    }
+    ++ block_num;
+    for (vector<tBddEdge>::iterator p = node_list.begin();
+	 p != node_list.end(); ++ p) {
+      ++ mNodeNum;
+      mIdMap[*p] = mNodeNum;
+    }
+  }
+  bool wide = ( mNodeNum > 0x7fffffffUL );
+
+  BinHeader header;
+  memcpy(header.mMagic, kBinMagic, sizeof(kBinMagic));
+  header.mVersion = kBinVersion;
+  header.mFlags = 0U;
+  if ( mCompress ) {
+    header.mFlags |= kBinCompressed;
+  }
+  if ( wide ) {
+    header.mFlags |= kBinWide;
+  }
+  header.mNodeNum = mNodeNum;
+  header.mRootNum = mRootList.size();
+  header.mBlockNum = block_num;
+  header.mByteOrder = kBinByteOrder;
+  mStream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  ostream* os = &mStream;
+#if defined(HAVE_ZLIB)
+  ozstream* zs = NULL;
+  if ( mCompress ) {
+    zs = new ozstream(mStream);
+    os = zs;
+  }
+#endif
+
+  vector<ymuint32> buff32;
+  vector<ymuint64> buff64;
+  for (size_t level = mLevelList.size(); level -- > 0; ) {
+    vector<tBddEdge>& node_list = mLevelList[level];
+    if ( node_list.empty() ) {
+      continue;
+    }
+    ymuint64 block_header[2];
+    block_header[0] = mMgr->varid(level);
+    block_header[1] = node_list.size();
+    os->write(reinterpret_cast<const char*>(block_header),
+	      sizeof(block_header));
+    for (size_t top = 0; top < node_list.size(); top += kBinChunk) {
+      size_t end = top + kBinChunk;
+      if ( end > node_list.size() ) {
+	end = node_list.size();
+      }
+      buff32.clear();
+      buff64.clear();
+      for (size_t i = top; i < end; ++ i) {
+	tBddEdge e0;
+	tBddEdge e1;
+	(void) mMgr->root_decomp(node_list[i], e0, e1);
+	if ( wide ) {
+	  buff64.push_back(encode(e0));
+	  buff64.push_back(encode(e1));
+	}
+	else {
+	  buff32.push_back(static_cast<ymuint32>(encode(e0)));
+	  buff32.push_back(static_cast<ymuint32>(encode(e1)));
+	}
+      }
+      if ( wide ) {
+	os->write(reinterpret_cast<const char*>(&buff64[0]),
+		  buff64.size() * sizeof(ymuint64));
+      }
+      else {
+	os->write(reinterpret_cast<const char*>(&buff32[0]),
+		  buff32.size() * sizeof(ymuint32));
+      }
+    }
+  }
+
+  for (vector<tBddEdge>::iterator p = mRootList.begin();
+       p != mRootList.end(); ++ p) {
+    ymuint64 code = encode(*p);
+    os->write(reinterpret_cast<const char*>(&code), sizeof(code));
+  }
+
+#if defined(HAVE_ZLIB)
+  // 削除する時に圧縮データが全て書き出される．
+  delete zs;
+#endif
+}
+
+// e から到達可能な節点をレベルごとに分類する．
+void
+BinDumper::collect(tBddEdge e)
+{
+  if ( check_leaf(e) ) {
+    return;
+  }
+  tBddEdge e_p = normalize(e);
+  if ( mIdMap.count(e_p) > 0 ) {
+    return;
+  }
+  mIdMap.insert(make_pair(e_p, 0));
+  tBddEdge e0;
+  tBddEdge e1;
+  tVarId varid = mMgr->root_decomp(e_p, e0, e1);
+  collect(e0);
+  collect(e1);
+  tLevel level = mMgr->level(varid);
+  if ( mLevelList.size() <= level ) {
+    mLevelList.resize(level + 1);
+  }
+  mLevelList[level].push_back(e_p);
+}
+
+// e を符号化する．
+ymuint64
+BinDumper::encode(tBddEdge e) const
+{
+  if ( check_one(e) ) {
+    return 0;
+  }
+  if ( check_zero(e) ) {
+    return 1;
+  }
+  if ( check_error(e) ) {
+    return kBinError;
+  }
+  if ( check_overflow(e) ) {
+    return kBinOverflow;
+  }
+  hash_map<tBddEdge, ymuint64>::const_iterator p = mIdMap.find(normalize(e));
+  assert_cond(p != mIdMap.end(), __FILE__, __LINE__);
+  return (p->second << 1) | static_cast<ymuint64>(get_pol(e));
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// BinRestorer の下請けクラス
+// 指定したバイト数のデータの先頭を返す．
+//////////////////////////////////////////////////////////////////////
+class BinRestorer::Reader
+{
+public:
+
+  // デストラクタ
+  virtual
+  ~Reader() { }
+
+  // n バイトのデータを読み込んで先頭のポインタを返す．
+  // 足りなければ NULL を返す．
+  virtual
+  const char*
+  get(size_t n) = 0;
+
+};
+
+// メモリ上のデータ(mmap したファイル)を読むクラス
+// コピーは行わない．
+class BinRestorer::MemReader :
+  public BinRestorer::Reader
+{
+public:
+
+  // コンストラクタ
+  MemReader(const char* buff,
+	    size_t size) :
+    mBuff(buff),
+    mSize(size),
+    mPos(0)
+  {
+  }
+
+  // n バイトのデータを読み込んで先頭のポインタを返す．
+  virtual
+  const char*
+  get(size_t n)
+  {
+    if ( mSize - mPos < n ) {
+      return NULL;
+    }
+    const char* ans = mBuff + mPos;
+    mPos += n;
+    return ans;
+  }
+
+private:
+
+  const char* mBuff;
+
+  size_t mSize;
+
+  size_t mPos;
+
+};
+
+// ストリームから読むクラス
+class BinRestorer::StreamReader :
+  public BinRestorer::Reader
+{
+public:
+
+  // コンストラクタ
+  StreamReader(istream& s) :
+    mStream(s)
+  {
+  }
+
+  // n バイトのデータを読み込んで先頭のポインタを返す．
+  virtual
+  const char*
+  get(size_t n)
+  {
+    if ( mBuff.size() < n ) {
+      mBuff.resize(n);
+    }
+    mStream.read(&mBuff[0], n);
+    if ( static_cast<size_t>(mStream.gcount()) != n ) {
+      return NULL;
+    }
+    return &mBuff[0];
+  }
+
+private:
+
+  istream& mStream;
+
+  vector<char> mBuff;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// BinRestorer
+//////////////////////////////////////////////////////////////////////
+
+// コンストラクタ
+BinRestorer::BinRestorer(BddMgr* mgr) :
+  mMgr(mgr)
+{
+}
+
+// デストラクタ
+BinRestorer::~BinRestorer()
+{
+}
+
+// ストリームから読み込む．
+size_t
+BinRestorer::read(istream& s)
+{
+  mRootVector.clear();
+
+  BinHeader header;
+  s.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if ( static_cast<size_t>(s.gcount()) != sizeof(header) ||
+       !check_header(header) ) {
+    return 0;
+  }
+
+  if ( header.mFlags & kBinCompressed ) {
+#if defined(HAVE_ZLIB)
+    izstream zs(s);
+    StreamReader reader(zs);
+    return read_body(header, reader);
+#else
+    return 0;
+#endif
+  }
+
+  StreamReader reader(s);
+  return read_body(header, reader);
+}
+
+// ファイルから読み込む．
+size_t
+BinRestorer::read(const string& filename)
+{
+  mRootVector.clear();
+
+  int fd = open(filename.c_str(), O_RDONLY);
+  if ( fd < 0 ) {
+    return 0;
+  }
+  struct stat sbuf;
+  if ( fstat(fd, &sbuf) < 0 ||
+       static_cast<size_t>(sbuf.st_size) < sizeof(BinHeader) ) {
+    close(fd);
+    return 0;
+  }
+  size_t size = sbuf.st_size;
+  void* addr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if ( addr == MAP_FAILED ) {
+    return 0;
+  }
+
+  const char* buff = static_cast<const char*>(addr);
+  BinHeader header;
+  memcpy(&header, buff, sizeof(header));
+  size_t n = 0;
+  if ( check_header(header) ) {
+    if ( header.mFlags & kBinCompressed ) {
+      // 圧縮されている時は普通に読む．
+      munmap(addr, size);
+      ifstream ifs(filename.c_str(), ios::in | ios::binary);
+      if ( !ifs ) {
+	return 0;
+      }
+      return read(ifs);
+    }
+    madvise(addr, size, MADV_SEQUENTIAL);
+    MemReader reader(buff + sizeof(header), size - sizeof(header));
+    n = read_body(header, reader);
+  }
+  munmap(addr, size);
+  return n;
+}
+
+// pos 番目の枝を返す．
+tBddEdge
+BinRestorer::root(size_t pos)
+{
+  if ( pos < mRootVector.size() ) {
+    return mRootVector[pos];
+  }
+  return kEdgeError;
+}
+
+// ヘッダを検査する．
+bool
+BinRestorer::check_header(const BinHeader& header)
+{
+  return memcmp(header.mMagic, kBinMagic, sizeof(kBinMagic)) == 0 &&
+    header.mVersion == kBinVersion &&
+    header.mByteOrder == kBinByteOrder;
+}
+
+// 本体を読み込む．
+// レベルの深い順に並んでいるので，節点ごとの ite_op() は
+// 変数のリテラルと子供から直接節点を作るだけになる．
+size_t
+BinRestorer::read_body(const BinHeader& header,
+		       Reader& reader)
+{
+  mEdgeVector.clear();
+  mEdgeVector.reserve(header.mNodeNum + 1);
+  // 節点番号 0 は定数 1
+  mEdgeVector.push_back(kEdge1);
+
+  bool wide = (header.mFlags & kBinWide) != 0;
+  size_t rec_size = wide ? sizeof(ymuint64) * 2 : sizeof(ymuint32) * 2;
+  for (ymuint32 b = 0; b < header.mBlockNum; ++ b) {
+    const char* ptr = reader.get(sizeof(ymuint64) * 2);
+    if ( ptr == NULL ) {
+      return 0;
+    }
+    ymuint64 block_header[2];
+    memcpy(block_header, ptr, sizeof(block_header));
+    tVarId varid = static_cast<tVarId>(block_header[0]);
+    ymuint64 num = block_header[1];
+    if ( num > header.mNodeNum + 1 - mEdgeVector.size() ) {
+      return 0;
+    }
+
+    tBddEdge lit = mMgr->make_posiliteral(varid);
+    if ( check_invalid(lit) ) {
+      return 0;
+    }
+    for (ymuint64 top = 0; top < num; top += kBinChunk) {
+      size_t n = kBinChunk;
+      if ( n > num - top ) {
+	n = num - top;
+      }
+      ptr = reader.get(n * rec_size);
+      if ( ptr == NULL ) {
+	return 0;
+      }
+      for (size_t i = 0; i < n; ++ i, ptr += rec_size) {
+	ymuint64 code0;
+	ymuint64 code1;
+	if ( wide ) {
+	  memcpy(&code0, ptr, sizeof(ymuint64));
+	  memcpy(&code1, ptr + sizeof(ymuint64), sizeof(ymuint64));
+	}
+	else {
+	  ymuint32 tmp[2];
+	  memcpy(tmp, ptr, sizeof(tmp));
+	  code0 = tmp[0];
+	  code1 = tmp[1];
+	}
+	tBddEdge e0 = decode(code0);
+	tBddEdge e1 = decode(code1);
+	if ( check_invalid(e0) || check_invalid(e1) ) {
+	  return 0;
+	}
+	tBddEdge ans = mMgr->ite_op(lit, e1, e0);
+	if ( check_invalid(ans) ) {
+	  return 0;
+	}
+	mEdgeVector.push_back(ans);
+      }
+    }
+  }
+
+  const char* ptr = reader.get(sizeof(ymuint64) * header.mRootNum);
+  if ( ptr == NULL ) {
+    return 0;
+  }
+  mRootVector.resize(header.mRootNum);
+  for (ymuint64 i = 0; i < header.mRootNum; ++ i) {
+    ymuint64 code;
+    memcpy(&code, ptr + i * sizeof(ymuint64), sizeof(ymuint64));
+    if ( code == kBinError ) {
+      mRootVector[i] = kEdgeError;
+    }
+    else if ( code == kBinOverflow ) {
+      mRootVector[i] = kEdgeOverflow;
+    }
+    else {
+      mRootVector[i] = decode(code);
+    }
+  }
+  return mRootVector.size();
+}
+
+// 符号化された枝を元に戻す．
+tBddEdge
+BinRestorer::decode(ymuint64 code) const
+{
+  ymuint64 id = code >> 1;
+  if ( id >= mEdgeVector.size() ) {
+    return kEdgeError;
+  }
+  tBddEdge ans = mEdgeVector[id];
+  if ( code & 1 ) {
+    ans = negate(ans);
+  }
+  return ans;
+}
+
+END_NAMESPACE_YM_BDD
@@ -0,0 +1,198 @@
+#ifndef LIBYM_BDD_BINDUMPER_H
+#define LIBYM_BDD_BINDUMPER_H
+
+/// @file libym_bdd/base/BinDumper.h
+/// @brief BinDumper, BinRestorer のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "BddMgr.h"
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+//////////////////////////////////////////////////////////////////////
+// バイナリ形式のダンプファイルの構成
+//
+// ヘッダ(BinHeader)
+//   以下はヘッダの mFlags に kBinCompressed が立っていたら
+//   zlib で圧縮されている．
+// レベルブロック × mBlockNum
+//   ymuint64 の変数番号と節点数に続いて，節点の 0 枝と 1 枝が
+//   節点数分並ぶ．枝の大きさは kBinWide が立っていたら 64 ビット，
+//   そうでなければ 32 ビット．
+//   ブロックはレベルの深い順に並んでいるので，子供の節点は
+//   必ず親よりも前に現れる．
+// 根の枝 × mRootNum (64 ビット)
+//
+// 枝は (節点番号 << 1) | 極性 で表す．節点番号はファイル中の出現順に
+// 1 から振られ，0 は定数 1 を表す．
+//////////////////////////////////////////////////////////////////////
+
+// ヘッダ
+struct BinHeader
+{
+  // "YMBDDBIN"
+  char mMagic[8];
+
+  // 形式のバージョン番号
+  ymuint32 mVersion;
+
+  // フラグ
+  ymuint32 mFlags;
+
+  // 節点数
+  ymuint64 mNodeNum;
+
+  // 根の数
+  ymuint64 mRootNum;
+
+  // レベルブロックの数
+  ymuint32 mBlockNum;
+
+  // バイトオーダーの検査用
+  ymuint32 mByteOrder;
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// BDD の内容をバイナリ形式で保存するためのクラス
+//////////////////////////////////////////////////////////////////////
+class BinDumper
+{
+public:
+
+  // コンストラクタ
+  // compress が true の時には本体を圧縮する．
+  BinDumper(BddMgr* mgr,
+	    ostream& s,
+	    bool compress);
+
+  // デストラクタ
+  ~BinDumper();
+
+  // e を根として登録する．
+  void
+  add_root(tBddEdge e);
+
+  // 登録された根から到達可能な節点を書き出す．
+  void
+  write();
+
+
+private:
+
+  // e から到達可能な節点をレベルごとに分類する．
+  void
+  collect(tBddEdge e);
+
+  // e を符号化する．
+  ymuint64
+  encode(tBddEdge e) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // BddMgr へのポインタ
+  BddMgr* mMgr;
+
+  // 出力用のストリーム
+  ostream& mStream;
+
+  // 圧縮フラグ
+  bool mCompress;
+
+  // 根の枝のリスト
+  vector<tBddEdge> mRootList;
+
+  // レベルごとの節点(の正極性の枝)のリスト
+  vector<vector<tBddEdge> > mLevelList;
+
+  // 節点番号の対応表
+  hash_map<tBddEdge, ymuint64> mIdMap;
+
+  // 節点数
+  ymuint64 mNodeNum;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// バイナリ形式のダンプを読み込むためのクラス
+//////////////////////////////////////////////////////////////////////
+class BinRestorer
+{
+public:
+
+  // コンストラクタ
+  BinRestorer(BddMgr* mgr);
+
+  // デストラクタ
+  ~BinRestorer();
+
+  // ストリームから読み込む．
+  // 読み込んだBDDの根の枝の数を返す．
+  // エラーが起きたら 0 を返す．
+  size_t
+  read(istream& s);
+
+  // ファイルから読み込む．
+  // 圧縮されていなければファイルを mmap して読む．
+  // 読み込んだBDDの根の枝の数を返す．
+  // エラーが起きたら 0 を返す．
+  size_t
+  read(const string& filename);
+
+  // pos 番目の枝を返す．
+  tBddEdge
+  root(size_t pos);
+
+
+private:
+
+  class Reader;
+  class MemReader;
+  class StreamReader;
+
+  // ヘッダを検査する．
+  bool
+  check_header(const BinHeader& header);
+
+  // 本体を読み込む．
+  size_t
+  read_body(const BinHeader& header,
+	    Reader& reader);
+
+  // 符号化された枝を元に戻す．
+  // 不正な値なら kEdgeError を返す．
+  tBddEdge
+  decode(ymuint64 code) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // BddMgr へのポインタ
+  BddMgr* mMgr;
+
+  // 根の枝を格納しておくベクタ
+  vector<tBddEdge> mRootVector;
+
+  // 節点番号から枝を得るためのベクタ
+  vector<tBddEdge> mEdgeVector;
+
+};
+
+END_NAMESPACE_YM_BDD
+
+#endif // LIBYM_BDD_BINDUMPER_H
@@ -0,0 +1,54 @@
+
+/// @file libym_bdd/base/BmpFactory.cc
+/// @brief BmpFactory の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#if HAVE_CONFIG_H
+#include <ymconfig.h>
+#endif
+
+#include <ym_bdd/BmpFactory.h>
+
+#include "bmp/BddMgrParallel.h"
+
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+//////////////////////////////////////////////////////////////////////
+// BddMgrParallel を生成するクラス
+//////////////////////////////////////////////////////////////////////
+
+// コンストラクタ
+BmpFactory::BmpFactory(ymuint thread_num,
+		       const string& name) :
+  mThreadNum(thread_num),
+  mName(name)
+{
+}
+
+// デストラクタ
+BmpFactory::~BmpFactory()
+{
+}
+
+// BddMgrParallel を生成する．
+BddMgr*
+BmpFactory::operator()() const
+{
+  ymuint n = mThreadNum;
+  if ( n == 0 ) {
+    long np = sysconf(_SC_NPROCESSORS_ONLN);
+    n = ( np > 0 ) ? static_cast<ymuint>(np) : 1;
+  }
+  return new BddMgrParallel(mName, n);
+}
+
+END_NAMESPACE_YM_BDD
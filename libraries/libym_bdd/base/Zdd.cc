@@ -0,0 +1,310 @@
+
+/// @file libym_bdd/base/Zdd.cc
+/// @brief Zdd の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#if HAVE_CONFIG_H
+#include <ymconfig.h>
+#endif
+
+#include <ym_bdd/Zdd.h>
+
+#include "BddMgr.h"
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+// デフォルトのコンストラクタ
+// mBody のデフォルト値(定数0)は空の集合族を表す．
+Zdd::Zdd()
+{
+}
+
+// コピーコンストラクタ
+Zdd::Zdd(const Zdd& src) :
+  mBody(src.mBody)
+{
+}
+
+// 代入演算子
+const Zdd&
+Zdd::operator=(const Zdd& src)
+{
+  mBody = src.mBody;
+  return *this;
+}
+
+// 変数一つからなる集合のみを要素とする集合族を作るコンストラクタ
+Zdd::Zdd(BddMgrRef mgr,
+	 tVarId varid) :
+  mBody(mgr.mPtr, mgr.mPtr->zdd_single(varid))
+{
+}
+
+// BDD からの変換用コンストラクタ
+Zdd::Zdd(const Bdd& f,
+	 const BddVarSet& vars)
+{
+  BddMgr* mgr = f.mMgr;
+  Bdd s = vars.function();
+  tBddEdge ans;
+  if ( mgr != s.mMgr ) {
+    // マネージャが異なる．
+    ans = kEdgeError;
+  }
+  else {
+    ans = mgr->bdd_to_zdd(f.root(), s.root());
+  }
+  mBody = Bdd(mgr, ans);
+}
+
+// ZDD の根の枝を持つ Bdd を指定するコンストラクタ
+Zdd::Zdd(const Bdd& body) :
+  mBody(body)
+{
+}
+
+// デストラクタ
+Zdd::~Zdd()
+{
+}
+
+// 空の集合族を作る．
+Zdd
+Zdd::make_empty(BddMgrRef mgr)
+{
+  return Zdd(mgr.make_zero());
+}
+
+// 空集合のみを要素とする集合族を作る．
+Zdd
+Zdd::make_base(BddMgrRef mgr)
+{
+  return Zdd(mgr.make_one());
+}
+
+// 和集合を計算して代入する．
+const Zdd&
+Zdd::operator|=(const Zdd& src)
+{
+  BddMgr* mgr = mBody.mMgr;
+  tBddEdge ans;
+  if ( mgr != src.mBody.mMgr ) {
+    // マネージャが異なる．
+    ans = kEdgeError;
+  }
+  else {
+    ans = mgr->zdd_union(root(), src.root());
+  }
+  mBody.assign(ans);
+  return *this;
+}
+
+// 共通部分を計算して代入する．
+const Zdd&
+Zdd::operator&=(const Zdd& src)
+{
+  BddMgr* mgr = mBody.mMgr;
+  tBddEdge ans;
+  if ( mgr != src.mBody.mMgr ) {
+    // マネージャが異なる．
+    ans = kEdgeError;
+  }
+  else {
+    ans = mgr->zdd_intersect(root(), src.root());
+  }
+  mBody.assign(ans);
+  return *this;
+}
+
+// 差集合を計算して代入する．
+const Zdd&
+Zdd::operator-=(const Zdd& src)
+{
+  BddMgr* mgr = mBody.mMgr;
+  tBddEdge ans;
+  if ( mgr != src.mBody.mMgr ) {
+    // マネージャが異なる．
+    ans = kEdgeError;
+  }
+  else {
+    ans = mgr->zdd_diff(root(), src.root());
+  }
+  mBody.assign(ans);
+  return *this;
+}
+
+// 積を計算して代入する．
+const Zdd&
+Zdd::operator*=(const Zdd& src)
+{
+  BddMgr* mgr = mBody.mMgr;
+  tBddEdge ans;
+  if ( mgr != src.mBody.mMgr ) {
+    // マネージャが異なる．
+    ans = kEdgeError;
+  }
+  else {
+    ans = mgr->zdd_product(root(), src.root());
+  }
+  mBody.assign(ans);
+  return *this;
+}
+
+// 商を計算して代入する．
+const Zdd&
+Zdd::operator/=(const Zdd& src)
+{
+  BddMgr* mgr = mBody.mMgr;
+  tBddEdge ans;
+  if ( mgr != src.mBody.mMgr ) {
+    // マネージャが異なる．
+    ans = kEdgeError;
+  }
+  else {
+    ans = mgr->zdd_quotient(root(), src.root());
+  }
+  mBody.assign(ans);
+  return *this;
+}
+
+// 剰余を計算して代入する．
+const Zdd&
+Zdd::operator%=(const Zdd& src)
+{
+  Zdd q = *this / src;
+  return operator-=(q * src);
+}
+
+// varid を含まない集合のみを取り出す．
+Zdd
+Zdd::subset0(tVarId varid) const
+{
+  BddMgr* mgr = mBody.mMgr;
+  return Zdd(Bdd(mgr, mgr->zdd_subset0(root(), varid)));
+}
+
+// varid を含む集合のみを取り出して varid を取り除く．
+Zdd
+Zdd::subset1(tVarId varid) const
+{
+  BddMgr* mgr = mBody.mMgr;
+  return Zdd(Bdd(mgr, mgr->zdd_subset1(root(), varid)));
+}
+
+// 各集合の varid の有無を反転させる．
+Zdd
+Zdd::change(tVarId varid) const
+{
+  BddMgr* mgr = mBody.mMgr;
+  return Zdd(Bdd(mgr, mgr->zdd_change(root(), varid)));
+}
+
+// 要素数を数える．
+mpz_class
+Zdd::count() const
+{
+  return mBody.mMgr->zdd_count(root());
+}
+
+// ZDD の節点数を数える．
+// 節点の数え方は BDD と同じでよい．
+size_t
+Zdd::size() const
+{
+  return mBody.size();
+}
+
+// 集合族を特性関数とする BDD を作る．
+Bdd
+Zdd::to_bdd(const BddVarSet& vars) const
+{
+  BddMgr* mgr = mBody.mMgr;
+  Bdd s = vars.function();
+  tBddEdge ans;
+  if ( mgr != s.mMgr ) {
+    // マネージャが異なる．
+    ans = kEdgeError;
+  }
+  else {
+    ans = mgr->zdd_to_bdd(root(), s.root());
+  }
+  return Bdd(mgr, ans);
+}
+
+// 和集合
+Zdd
+operator|(const Zdd& src1,
+	  const Zdd& src2)
+{
+  return Zdd(src1).operator|=(src2);
+}
+
+// 共通部分
+Zdd
+operator&(const Zdd& src1,
+	  const Zdd& src2)
+{
+  return Zdd(src1).operator&=(src2);
+}
+
+// 差集合
+Zdd
+operator-(const Zdd& src1,
+	  const Zdd& src2)
+{
+  return Zdd(src1).operator-=(src2);
+}
+
+// 積
+Zdd
+operator*(const Zdd& src1,
+	  const Zdd& src2)
+{
+  return Zdd(src1).operator*=(src2);
+}
+
+// 商
+Zdd
+operator/(const Zdd& src1,
+	  const Zdd& src2)
+{
+  return Zdd(src1).operator/=(src2);
+}
+
+// 剰余
+Zdd
+operator%(const Zdd& src1,
+	  const Zdd& src2)
+{
+  return Zdd(src1).operator%=(src2);
+}
+
+// 非冗長積和形を ZDD で求める．
+Bdd
+isop(const Bdd& lower,
+     const Bdd& upper,
+     Zdd& cover)
+{
+  BddMgr* mgr = lower.mMgr;
+  tBddEdge ans;
+  tBddEdge cov;
+  if ( mgr != upper.mMgr ) {
+    // マネージャが異なる．
+    ans = kEdgeError;
+    cov = kEdgeError;
+  }
+  else {
+    ans = mgr->zdd_isop(lower.root(), upper.root(), cov);
+  }
+  cover = Zdd(Bdd(mgr, cov));
+  return Bdd(mgr, ans);
+}
+
+END_NAMESPACE_YM_BDD
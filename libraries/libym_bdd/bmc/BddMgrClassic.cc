@@ -182,6 +182,31 @@ BddMgrClassic::BddMgrClassic(const string& name) :
   assert_cond(mCs1Table, __FILE__, __LINE__);
   mCs2Table = new CompTbl2(this, "cs2_table");
   assert_cond(mCs2Table, __FILE__, __LINE__);
+
+  mZUnionTable = new CompTbl2(this, "zunion_table");
+  assert_cond(mZUnionTable, __FILE__, __LINE__);
+  mZIntTable = new CompTbl2(this, "zint_table");
+  assert_cond(mZIntTable, __FILE__, __LINE__);
+  mZDiffTable = new CompTbl2(this, "zdiff_table");
+  assert_cond(mZDiffTable, __FILE__, __LINE__);
+  mZProdTable = new CompTbl2(this, "zprod_table");
+  assert_cond(mZProdTable, __FILE__, __LINE__);
+  mZQuotTable = new CompTbl2(this, "zquot_table");
+  assert_cond(mZQuotTable, __FILE__, __LINE__);
+  mZSub0Table = new CompTbl2(this, "zsub0_table");
+  assert_cond(mZSub0Table, __FILE__, __LINE__);
+  mZSub1Table = new CompTbl2(this, "zsub1_table");
+  assert_cond(mZSub1Table, __FILE__, __LINE__);
+  mZChgTable = new CompTbl2(this, "zchg_table");
+  assert_cond(mZChgTable, __FILE__, __LINE__);
+  mB2ZTable = new CompTbl2(this, "b2z_table");
+  assert_cond(mB2ZTable, __FILE__, __LINE__);
+  mZ2BTable = new CompTbl2(this, "z2b_table");
+  assert_cond(mZ2BTable, __FILE__, __LINE__);
+  mZIsopTable = new CompTbl2(this, "zisop_table");
+  assert_cond(mZIsopTable, __FILE__, __LINE__);
+  mZCovTable = new CompTbl2(this, "zcov_table");
+  assert_cond(mZCovTable, __FILE__, __LINE__);
 }
 
 // デストラクタ
@@ -470,6 +495,13 @@ BddMgrClassic::disable_DVO()
 {
 }
 
+// 変数順の最適化(sifting)を行う．
+// BddMgrClassic は変数順が固定なので何もしない．
+void
+BddMgrClassic::reorder()
+{
+}
+
 // 節点テーブルを次に拡大する時の基準値を計算する．
 void
 BddMgrClassic::set_next_limit_size()
@@ -726,25 +758,69 @@ BddMgrClassic::new_node(Var* var,
   e1 = addpol(e1, ans_pol);
   e0 = addpol(e0, ans_pol);
 
-  Node* temp;
-  size_t pos;
+  Node* temp = find_node(var, e0, e1);
+  if ( !temp ) {
+    // メモリアロケーションに失敗した
+    return kEdgeInvalid;
+  }
+  return combine(temp, ans_pol);
+}
+
+// ZDD 用の節点を作る．
+// 1枝が空集合を指す場合には0枝自身を返す．
+// 否定属性は0枝側にしか作用しないので0枝を肯定にする．
+tBddEdge
+BddMgrClassic::new_znode(Var* var,
+			 tBddEdge e0,
+			 tBddEdge e1)
+{
+  if ( check_error(e0) || check_error(e1) ) {
+    return kEdgeError;
+  }
+  if ( check_overflow(e0) || check_overflow(e1) ) {
+    return kEdgeInvalid;
+  }
+  if ( check_zero(e1) ) {
+    return e0;
+  }
+
+  // 否定枝に関する正規化ルール
+  tPol ans_pol = get_pol(e0);
+  e0 = addpol(e0, ans_pol);
+
+  Node* temp = find_node(var, e0, e1);
+  if ( !temp ) {
+    // メモリアロケーションに失敗した
+    return kEdgeInvalid;
+  }
+  return combine(temp, ans_pol);
+}
+
+// 正規化済みの枝を持つ節点を節点テーブルから探す．
+// なければ新たに作る．
+BmcNode*
+BddMgrClassic::find_node(Var* var,
+			 tBddEdge e0,
+			 tBddEdge e1)
+{
   // 節点テーブルを探す．
   tVarId index = var->varid();
-  pos = hash_func3(e0, e1, index);
-  for (temp = mNodeTable[pos & mTableSize_1]; temp; temp = temp->mLink) {
+  size_t pos = hash_func3(e0, e1, index);
+  for (Node* temp = mNodeTable[pos & mTableSize_1]; temp;
+       temp = temp->mLink) {
     if ( temp->edge0() == e0 && temp->edge1() == e1 &&
 	 temp->var() == var ) {
       // 同一の節点がすでに登録されている
-      goto already_exist;
+      return temp;
     }
   }
   
   // 節点テーブルには登録されていなかったので新しい節点を取ってきて
   // 内容を設定する．
-  temp = alloc_node();
+  Node* temp = alloc_node();
   if ( !temp ) {
     // メモリアロケーションに失敗した
-    return kEdgeInvalid;
+    return NULL;
   }
   temp->mEdge0 = e0;
   temp->mEdge1 = e1;
@@ -761,12 +837,7 @@ BddMgrClassic::new_node(Var* var,
     temp->mLink = entry;
     entry = temp;
   }
-
- already_exist:
-
-  tBddEdge ans = combine(temp, ans_pol);
-
-  return ans;
+  return temp;
 }
 
 // e の参照回数を増やす．
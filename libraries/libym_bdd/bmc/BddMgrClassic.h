@@ -109,6 +109,11 @@ public:
   void
   disable_DVO();
 
+  // 変数順の最適化(sifting)を行う．
+  virtual
+  void
+  reorder();
+
 
   //////////////////////////////////////////////////////////////////////
   // BDD 生成用関数
@@ -258,6 +263,88 @@ public:
   tBddEdge
   SCC(tBddEdge e);
 
+
+  //////////////////////////////////////////////////////////////////////
+  // ZDD 関係の演算
+  //////////////////////////////////////////////////////////////////////
+
+  // varid のみからなる集合を唯一の要素とする集合族を作る．
+  virtual
+  tBddEdge
+  zdd_single(tVarId varid);
+
+  // 集合族の和を計算する．
+  virtual
+  tBddEdge
+  zdd_union(tBddEdge e1,
+	    tBddEdge e2);
+
+  // 集合族の共通部分を計算する．
+  virtual
+  tBddEdge
+  zdd_intersect(tBddEdge e1,
+		tBddEdge e2);
+
+  // 集合族の差を計算する．
+  virtual
+  tBddEdge
+  zdd_diff(tBddEdge e1,
+	   tBddEdge e2);
+
+  // 集合族の積を計算する．
+  virtual
+  tBddEdge
+  zdd_product(tBddEdge e1,
+	      tBddEdge e2);
+
+  // 集合族の商を計算する．
+  virtual
+  tBddEdge
+  zdd_quotient(tBddEdge e1,
+	       tBddEdge e2);
+
+  // varid を含まない集合のみを取り出す．
+  virtual
+  tBddEdge
+  zdd_subset0(tBddEdge e,
+	      tVarId varid);
+
+  // varid を含む集合のみを取り出して varid を取り除く．
+  virtual
+  tBddEdge
+  zdd_subset1(tBddEdge e,
+	      tVarId varid);
+
+  // 各集合の varid の有無を反転させる．
+  virtual
+  tBddEdge
+  zdd_change(tBddEdge e,
+	     tVarId varid);
+
+  // 集合族の要素数を数える．
+  virtual
+  mpz_class
+  zdd_count(tBddEdge e);
+
+  // BDD の表す関数の 1 となる最小項の集合族を作る．
+  virtual
+  tBddEdge
+  bdd_to_zdd(tBddEdge e,
+	     tBddEdge s);
+
+  // ZDD の表す集合族を特性関数とする BDD を作る．
+  virtual
+  tBddEdge
+  zdd_to_bdd(tBddEdge e,
+	     tBddEdge s);
+
+  // 非冗長積和形を ZDD で求める．
+  virtual
+  tBddEdge
+  zdd_isop(tBddEdge l,
+	   tBddEdge u,
+	   tBddEdge& cover);
+
   
   //////////////////////////////////////////////////////////////////////
   // BDD の構造に関係したメソッド
@@ -545,6 +632,21 @@ public:
 	   tBddEdge l,
 	   tBddEdge h);
 
+  // ZDD 用の節点を作る．
+  // 1枝が空集合を指す場合には0枝自身を返す．
+  tBddEdge
+  new_znode(Var* var,
+	    tBddEdge l,
+	    tBddEdge h);
+
+  // 正規化済みの枝を持つ節点を節点テーブルから探す．
+  // なければ新たに作る．
+  // メモリの確保に失敗したら NULL を返す．
+  Node*
+  find_node(Var* var,
+	    tBddEdge l,
+	    tBddEdge h);
+
   
   //////////////////////////////////////////////////////////////////////
   // 上記の XXX_op() の内部で用いられる再帰関数
@@ -638,6 +740,89 @@ public:
   scc_step(tBddEdge e,
 	   tBddEdge s);
 
+  // zdd_union の下請関数
+  tBddEdge
+  zunion_step(tBddEdge f,
+	      tBddEdge g);
+
+  // zdd_intersect の下請関数
+  tBddEdge
+  zint_step(tBddEdge f,
+	    tBddEdge g);
+
+  // zdd_diff の下請関数
+  tBddEdge
+  zdiff_step(tBddEdge f,
+	     tBddEdge g);
+
+  // zdd_product の下請関数
+  tBddEdge
+  zprod_step(tBddEdge f,
+	     tBddEdge g);
+
+  // zdd_quotient の下請関数
+  tBddEdge
+  zquot_step(tBddEdge f,
+	     tBddEdge g);
+
+  // zdd_subset0 の下請関数
+  tBddEdge
+  zsub0_step(tBddEdge f,
+	     Var* var);
+
+  // zdd_subset1 の下請関数
+  tBddEdge
+  zsub1_step(tBddEdge f,
+	     Var* var);
+
+  // zdd_change の下請関数
+  tBddEdge
+  zchg_step(tBddEdge f,
+	    Var* var);
+
+  // zdd_count の下請関数
+  static
+  mpz_class
+  zcount_step(tBddEdge e,
+	      hash_map<tBddEdge, mpz_class>& mc_map);
+
+  // bdd_to_zdd の下請関数
+  tBddEdge
+  b2z_step(tBddEdge f,
+	   tBddEdge s);
+
+  // zdd_to_bdd の下請関数
+  tBddEdge
+  z2b_step(tBddEdge f,
+	   tBddEdge s);
+
+  // zdd_isop の下請関数
+  tBddEdge
+  zisop_step(tBddEdge l,
+	     tBddEdge u,
+	     tBddEdge& cov);
+
+  // ZDD の根の変数に関して枝を分解する．
+  // f の根の変数が var でなければ f0 = f, f1 = 空集合 となる．
+  static
+  void
+  zsplit(tBddEdge f,
+	 Var* var,
+	 tBddEdge& f0,
+	 tBddEdge& f1);
+
+  // ZDD の根のレベルを得る．
+  // 終端の場合には kLevelMax を返す．
+  static
+  tLevel
+  zlevel(tBddEdge e);
+
+  // 空集合を要素として含むかどうかを has_empty に合わせる．
+  static
+  tBddEdge
+  zset_empty(tBddEdge e,
+	     bool has_empty);
+
   // size() の中で用いられる関数
   void
   count1(tBddEdge e);
@@ -882,7 +1067,7 @@ public:
 	tBddEdge& g_1);
 
 
-private:
+protected:
   //////////////////////////////////////////////////////////////////////
   // デバッグ用の名前
   //////////////////////////////////////////////////////////////////////
@@ -994,6 +1179,19 @@ private:
   CompTbl3* mCs1Table;
   CompTbl2* mCs2Table;
 
+  CompTbl2* mZUnionTable;
+  CompTbl2* mZIntTable;
+  CompTbl2* mZDiffTable;
+  CompTbl2* mZProdTable;
+  CompTbl2* mZQuotTable;
+  CompTbl2* mZSub0Table;
+  CompTbl2* mZSub1Table;
+  CompTbl2* mZChgTable;
+  CompTbl2* mB2ZTable;
+  CompTbl2* mZ2BTable;
+  CompTbl2* mZIsopTable;
+  CompTbl2* mZCovTable;
+
   
   //////////////////////////////////////////////////////////////////////
   // メモリブロック管理用のメンバ
@@ -1166,6 +1364,48 @@ BddMgrClassic::split(tBddEdge f,
   return var;
 }
 
+// ZDD の根のレベルを得る．
+inline
+tLevel
+BddMgrClassic::zlevel(tBddEdge e)
+{
+  Node* vp = get_node(e);
+  return vp ? vp->level() : kLevelMax;
+}
+
+// ZDD の根の変数に関して枝を分解する．
+// ZDD の否定属性は0枝側にのみ作用する．
+inline
+void
+BddMgrClassic::zsplit(tBddEdge f,
+		      Var* var,
+		      tBddEdge& f0,
+		      tBddEdge& f1)
+{
+  Node* vp = get_node(f);
+  if ( vp && vp->var() == var ) {
+    f0 = vp->edge0(get_pol(f));
+    f1 = vp->edge1();
+  }
+  else {
+    f0 = f;
+    f1 = kEdge0;
+  }
+}
+
+// 空集合を要素として含むかどうかを has_empty に合わせる．
+// 正規化により，肯定の枝は必ず空集合を含んでいる．
+inline
+tBddEdge
+BddMgrClassic::zset_empty(tBddEdge e,
+			  bool has_empty)
+{
+  if ( check_invalid(e) ) {
+    return e;
+  }
+  return has_empty ? (e & ~1UL) : (e | 1UL);
+}
+
 // 節点テーブルの拡張を制御するパラメータを得る．
 inline
 double
@@ -22,6 +22,7 @@ BEGIN_NAMESPACE_YM_BDD
 class BmcVar
 {
   friend class BddMgrClassic;
+  friend class BddMgrParallel;
 public:
 
   // 変数番号を得る．
@@ -84,6 +85,7 @@ private:
 class BmcNode
 {
   friend class BddMgrClassic;
+  friend class BddMgrParallel;
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -367,10 +367,8 @@ BddMgrClassic::andexist_step(tBddEdge f,
       }
     }
     else {
-      f_0 = f_vp->edge0(f_pol);
-      f_1 = f_vp->edge1(f_pol);
-      g_0 = g_vp->edge0(g_pol);
-      g_1 = g_vp->edge1(g_pol);
+      split1(level, f_level, f, f_vp, f_pol, f_0, f_1);
+      split1(level, g_level, g, g_vp, g_pol, g_0, g_1);
       tBddEdge r_0 = andexist_step(f_0, g_0);
       tBddEdge r_1 = andexist_step(f_1, g_1);
       result = new_node(var, r_0, r_1);
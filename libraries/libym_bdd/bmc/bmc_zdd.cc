@@ -0,0 +1,752 @@
+
+/// @file libym_bdd/bmc/bmc_zdd.cc
+/// @brief ZDD の演算を行う関数の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#if HAVE_CONFIG_H
+#include <ymconfig.h>
+#endif
+
+#include "BddMgrClassic.h"
+#include "BmcCompTbl.h"
+
+
+//////////////////////////////////////////////////////////////////////
+// ZDD の節点は BDD と同じ節点テーブルに置かれる．
+// 終端の 1 は空集合のみを要素とする集合族 {∅} を，終端の 0 は
+// 空の集合族を表す．
+// 枝の否定属性は「空集合を要素として含むかどうか」の反転を表す．
+// 空集合の有無は0枝を辿った先で決まるので，節点の0枝は必ず肯定にする．
+// このため肯定の枝は必ず空集合を含み，否定の枝は含まないことになる．
+//////////////////////////////////////////////////////////////////////
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+// varid のみからなる集合を唯一の要素とする集合族を作る．
+tBddEdge
+BddMgrClassic::zdd_single(tVarId varid)
+{
+  Var* var = var_of(varid);
+  if ( !var ) {
+    var = alloc_var(varid);
+    if ( !var ) {
+      return kEdgeOverflow;
+    }
+  }
+  return new_znode(var, kEdge0, kEdge1);
+}
+
+// 集合族の和を計算する．
+tBddEdge
+BddMgrClassic::zdd_union(tBddEdge e1,
+			 tBddEdge e2)
+{
+  return zunion_step(e1, e2);
+}
+
+// 集合族の共通部分を計算する．
+tBddEdge
+BddMgrClassic::zdd_intersect(tBddEdge e1,
+			     tBddEdge e2)
+{
+  return zint_step(e1, e2);
+}
+
+// 集合族の差を計算する．
+tBddEdge
+BddMgrClassic::zdd_diff(tBddEdge e1,
+			tBddEdge e2)
+{
+  return zdiff_step(e1, e2);
+}
+
+// 集合族の積を計算する．
+tBddEdge
+BddMgrClassic::zdd_product(tBddEdge e1,
+			   tBddEdge e2)
+{
+  return zprod_step(e1, e2);
+}
+
+// 集合族の商を計算する．
+// 空の集合族での割り算はエラーとする．
+tBddEdge
+BddMgrClassic::zdd_quotient(tBddEdge e1,
+			    tBddEdge e2)
+{
+  if ( check_zero(e2) ) {
+    return kEdgeError;
+  }
+  return zquot_step(e1, e2);
+}
+
+// varid を含まない集合のみを取り出す．
+tBddEdge
+BddMgrClassic::zdd_subset0(tBddEdge e,
+			   tVarId varid)
+{
+  if ( check_invalid(e) ) {
+    return e;
+  }
+  Var* var = var_of(varid);
+  if ( !var ) {
+    // どの集合も varid を含んでいない．
+    return e;
+  }
+  return zsub0_step(e, var);
+}
+
+// varid を含む集合のみを取り出して varid を取り除く．
+tBddEdge
+BddMgrClassic::zdd_subset1(tBddEdge e,
+			   tVarId varid)
+{
+  if ( check_invalid(e) ) {
+    return e;
+  }
+  Var* var = var_of(varid);
+  if ( !var ) {
+    // どの集合も varid を含んでいない．
+    return kEdge0;
+  }
+  return zsub1_step(e, var);
+}
+
+// 各集合の varid の有無を反転させる．
+tBddEdge
+BddMgrClassic::zdd_change(tBddEdge e,
+			  tVarId varid)
+{
+  if ( check_invalid(e) ) {
+    return e;
+  }
+  Var* var = var_of(varid);
+  if ( !var ) {
+    var = alloc_var(varid);
+    if ( !var ) {
+      return kEdgeOverflow;
+    }
+  }
+  return zchg_step(e, var);
+}
+
+// 集合族の要素数を数える．
+mpz_class
+BddMgrClassic::zdd_count(tBddEdge e)
+{
+  if ( check_invalid(e) ) {
+    return 0;
+  }
+  hash_map<tBddEdge, mpz_class> mc_map;
+  return zcount_step(e, mc_map);
+}
+
+// BDD の表す関数の 1 となる最小項の集合族を作る．
+// s に含まれていない変数も e のサポートに含まれていれば考慮する．
+tBddEdge
+BddMgrClassic::bdd_to_zdd(tBddEdge e,
+			  tBddEdge s)
+{
+  if ( check_error(e) || check_error(s) ) {
+    return kEdgeError;
+  }
+  if ( check_overflow(e) || check_overflow(s) ) {
+    return kEdgeOverflow;
+  }
+  return b2z_step(e, s);
+}
+
+// ZDD の表す集合族を特性関数とする BDD を作る．
+tBddEdge
+BddMgrClassic::zdd_to_bdd(tBddEdge e,
+			  tBddEdge s)
+{
+  if ( check_error(e) || check_error(s) ) {
+    return kEdgeError;
+  }
+  if ( check_overflow(e) || check_overflow(s) ) {
+    return kEdgeOverflow;
+  }
+  return z2b_step(e, s);
+}
+
+// 非冗長積和形を ZDD で求める．
+tBddEdge
+BddMgrClassic::zdd_isop(tBddEdge l,
+			tBddEdge u,
+			tBddEdge& cover)
+{
+  if ( check_error(l) || check_error(u) ) {
+    cover = kEdgeError;
+    return kEdgeError;
+  }
+  if ( check_overflow(l) || check_overflow(u) ) {
+    cover = kEdgeOverflow;
+    return kEdgeOverflow;
+  }
+  tBddEdge ans = zisop_step(l, u, cover);
+  mZIsopTable->clear();
+  mZCovTable->clear();
+  return ans;
+}
+
+// zdd_union の下請関数
+// 空集合の有無は最後に合わせるので肯定の枝同士で計算する．
+tBddEdge
+BddMgrClassic::zunion_step(tBddEdge f,
+			   tBddEdge g)
+{
+  if ( check_error(f) || check_error(g) ) {
+    return kEdgeError;
+  }
+  if ( check_overflow(f) || check_overflow(g) ) {
+    return kEdgeOverflow;
+  }
+  if ( check_zero(f) ) {
+    return g;
+  }
+  if ( check_zero(g) || f == g ) {
+    return f;
+  }
+
+  bool has_empty = get_pol(f) == kPolPosi || get_pol(g) == kPolPosi;
+  f = addpol(f, get_pol(f));
+  g = addpol(g, get_pol(g));
+
+  tBddEdge result;
+  if ( check_one(f) ) {
+    result = g;
+  }
+  else if ( check_one(g) || f == g ) {
+    result = f;
+  }
+  else {
+    // 対称演算なので正規化する．
+    if ( f > g ) {
+      tBddEdge tmp = f;
+      f = g;
+      g = tmp;
+    }
+    result = mZUnionTable->get(f, g);
+    if ( result == kEdgeInvalid ) {
+      Node* f_vp = get_node(f);
+      Node* g_vp = get_node(g);
+      Var* var = f_vp->var();
+      if ( g_vp->level() < f_vp->level() ) {
+	var = g_vp->var();
+      }
+      tBddEdge f_0, f_1;
+      tBddEdge g_0, g_1;
+      zsplit(f, var, f_0, f_1);
+      zsplit(g, var, g_0, g_1);
+      tBddEdge r_0 = zunion_step(f_0, g_0);
+      tBddEdge r_1 = zunion_step(f_1, g_1);
+      result = new_znode(var, r_0, r_1);
+      mZUnionTable->put(f, g, result);
+    }
+  }
+  return zset_empty(result, has_empty);
+}
+
+// zdd_intersect の下請関数
+tBddEdge
+BddMgrClassic::zint_step(tBddEdge f,
+			 tBddEdge g)
+{
+  if ( check_error(f) || check_error(g) ) {
+    return kEdgeError;
+  }
+  if ( check_overflow(f) || check_overflow(g) ) {
+    return kEdgeOverflow;
+  }
+  if ( check_zero(f) || check_zero(g) ) {
+    return kEdge0;
+  }
+  if ( f == g ) {
+    return f;
+  }
+
+  bool has_empty = get_pol(f) == kPolPosi && get_pol(g) == kPolPosi;
+  f = addpol(f, get_pol(f));
+  g = addpol(g, get_pol(g));
+
+  tBddEdge result;
+  if ( check_one(f) || check_one(g) ) {
+    result = kEdge1;
+  }
+  else if ( f == g ) {
+    result = f;
+  }
+  else {
+    if ( f > g ) {
+      tBddEdge tmp = f;
+      f = g;
+      g = tmp;
+    }
+    result = mZIntTable->get(f, g);
+    if ( result == kEdgeInvalid ) {
+      Node* f_vp = get_node(f);
+      Node* g_vp = get_node(g);
+      tLevel f_level = f_vp->level();
+      tLevel g_level = g_vp->level();
+      if ( f_level < g_level ) {
+	// f の根の変数を含む集合は g にはない．
+	result = zint_step(f_vp->edge0(), g);
+      }
+      else if ( f_level > g_level ) {
+	result = zint_step(f, g_vp->edge0());
+      }
+      else {
+	tBddEdge r_0 = zint_step(f_vp->edge0(), g_vp->edge0());
+	tBddEdge r_1 = zint_step(f_vp->edge1(), g_vp->edge1());
+	result = new_znode(f_vp->var(), r_0, r_1);
+      }
+      mZIntTable->put(f, g, result);
+    }
+  }
+  return zset_empty(result, has_empty);
+}
+
+// zdd_diff の下請関数
+tBddEdge
+BddMgrClassic::zdiff_step(tBddEdge f,
+			  tBddEdge g)
+{
+  if ( check_error(f) || check_error(g) ) {
+    return kEdgeError;
+  }
+  if ( check_overflow(f) || check_overflow(g) ) {
+    return kEdgeOverflow;
+  }
+  if ( check_zero(f) || f == g ) {
+    return kEdge0;
+  }
+  if ( check_zero(g) ) {
+    return f;
+  }
+
+  bool has_empty = get_pol(f) == kPolPosi && get_pol(g) == kPolNega;
+  f = addpol(f, get_pol(f));
+  g = addpol(g, get_pol(g));
+
+  tBddEdge result;
+  if ( check_one(f) || f == g ) {
+    result = kEdge0;
+  }
+  else if ( check_one(g) ) {
+    result = f;
+  }
+  else {
+    result = mZDiffTable->get(f, g);
+    if ( result == kEdgeInvalid ) {
+      Node* f_vp = get_node(f);
+      Node* g_vp = get_node(g);
+      tLevel f_level = f_vp->level();
+      tLevel g_level = g_vp->level();
+      if ( f_level < g_level ) {
+	// f の根の変数を含む集合はそのまま残る．
+	tBddEdge r_0 = zdiff_step(f_vp->edge0(), g);
+	result = new_znode(f_vp->var(), r_0, f_vp->edge1());
+      }
+      else if ( f_level > g_level ) {
+	result = zdiff_step(f, g_vp->edge0());
+      }
+      else {
+	tBddEdge r_0 = zdiff_step(f_vp->edge0(), g_vp->edge0());
+	tBddEdge r_1 = zdiff_step(f_vp->edge1(), g_vp->edge1());
+	result = new_znode(f_vp->var(), r_0, r_1);
+      }
+      mZDiffTable->put(f, g, result);
+    }
+  }
+  return zset_empty(result, has_empty);
+}
+
+// zdd_product の下請関数
+// f = v・f1 + f0, g = v・g1 + g0 とすると
+// f・g = v・(f1・g1 + f1・g0 + f0・g1) + f0・g0
+tBddEdge
+BddMgrClassic::zprod_step(tBddEdge f,
+			  tBddEdge g)
+{
+  if ( check_error(f) || check_error(g) ) {
+    return kEdgeError;
+  }
+  if ( check_overflow(f) || check_overflow(g) ) {
+    return kEdgeOverflow;
+  }
+  if ( check_zero(f) || check_zero(g) ) {
+    return kEdge0;
+  }
+  if ( check_one(f) ) {
+    return g;
+  }
+  if ( check_one(g) ) {
+    return f;
+  }
+
+  if ( f > g ) {
+    tBddEdge tmp = f;
+    f = g;
+    g = tmp;
+  }
+  tBddEdge result = mZProdTable->get(f, g);
+  if ( result == kEdgeInvalid ) {
+    Node* f_vp = get_node(f);
+    Node* g_vp = get_node(g);
+    Var* var = f_vp->var();
+    if ( g_vp->level() < f_vp->level() ) {
+      var = g_vp->var();
+    }
+    tBddEdge f_0, f_1;
+    tBddEdge g_0, g_1;
+    zsplit(f, var, f_0, f_1);
+    zsplit(g, var, g_0, g_1);
+    tBddEdge r_11 = zprod_step(f_1, g_1);
+    tBddEdge r_10 = zprod_step(f_1, g_0);
+    tBddEdge r_01 = zprod_step(f_0, g_1);
+    tBddEdge r_1 = zunion_step(zunion_step(r_11, r_10), r_01);
+    tBddEdge r_0 = zprod_step(f_0, g_0);
+    result = new_znode(var, r_0, r_1);
+    mZProdTable->put(f, g, result);
+  }
+  return result;
+}
+
+// zdd_quotient の下請関数
+// g の根の変数 v で分解して
+// f / g = (f1 / g1) ∩ (f0 / g0) を求める．
+// ただし g0 が空の時は f1 / g1 となる．
+tBddEdge
+BddMgrClassic::zquot_step(tBddEdge f,
+			  tBddEdge g)
+{
+  if ( check_error(f) || check_error(g) ) {
+    return kEdgeError;
+  }
+  if ( check_overflow(f) || check_overflow(g) ) {
+    return kEdgeOverflow;
+  }
+  if ( check_one(g) ) {
+    return f;
+  }
+  if ( f == g ) {
+    return kEdge1;
+  }
+  if ( check_leaf(f) ) {
+    // g は空でも {∅} でもないので f の要素を割り切れない．
+    return kEdge0;
+  }
+
+  tBddEdge result = mZQuotTable->get(f, g);
+  if ( result == kEdgeInvalid ) {
+    Var* var = get_node(g)->var();
+    if ( zlevel(f) > var->level() ) {
+      // f の要素は v を含まない．
+      result = kEdge0;
+    }
+    else {
+      tBddEdge g_0, g_1;
+      zsplit(g, var, g_0, g_1);
+      tBddEdge f_1 = zsub1_step(f, var);
+      result = zquot_step(f_1, g_1);
+      if ( !check_zero(result) && !check_zero(g_0) ) {
+	tBddEdge f_0 = zsub0_step(f, var);
+	result = zint_step(result, zquot_step(f_0, g_0));
+      }
+    }
+    mZQuotTable->put(f, g, result);
+  }
+  return result;
+}
+
+// zdd_subset0 の下請関数
+// 空集合の有無は変わらないので肯定の枝で計算する．
+tBddEdge
+BddMgrClassic::zsub0_step(tBddEdge f,
+			  Var* var)
+{
+  if ( check_invalid(f) ) {
+    return f;
+  }
+  tLevel f_level = zlevel(f);
+  if ( f_level > var->level() ) {
+    return f;
+  }
+  Node* f_vp = get_node(f);
+  tPol f_pol = get_pol(f);
+  if ( f_level == var->level() ) {
+    return f_vp->edge0(f_pol);
+  }
+
+  f = addpol(f, f_pol);
+  tBddEdge key = new_znode(var, kEdge0, kEdge1);
+  tBddEdge result = mZSub0Table->get(f, key);
+  if ( result == kEdgeInvalid ) {
+    tBddEdge r_0 = zsub0_step(f_vp->edge0(), var);
+    tBddEdge r_1 = zsub0_step(f_vp->edge1(), var);
+    result = new_znode(f_vp->var(), r_0, r_1);
+    mZSub0Table->put(f, key, result);
+  }
+  return addpol_ifvalid(result, f_pol);
+}
+
+// zdd_subset1 の下請関数
+// 結果に空集合の有無は関係しないので肯定の枝で計算する．
+tBddEdge
+BddMgrClassic::zsub1_step(tBddEdge f,
+			  Var* var)
+{
+  if ( check_invalid(f) ) {
+    return f;
+  }
+  tLevel f_level = zlevel(f);
+  if ( f_level > var->level() ) {
+    return kEdge0;
+  }
+  Node* f_vp = get_node(f);
+  if ( f_level == var->level() ) {
+    return f_vp->edge1();
+  }
+
+  f = addpol(f, get_pol(f));
+  tBddEdge key = new_znode(var, kEdge0, kEdge1);
+  tBddEdge result = mZSub1Table->get(f, key);
+  if ( result == kEdgeInvalid ) {
+    tBddEdge r_0 = zsub1_step(f_vp->edge0(), var);
+    tBddEdge r_1 = zsub1_step(f_vp->edge1(), var);
+    result = new_znode(f_vp->var(), r_0, r_1);
+    mZSub1Table->put(f, key, result);
+  }
+  return result;
+}
+
+// zdd_change の下請関数
+tBddEdge
+BddMgrClassic::zchg_step(tBddEdge f,
+			 Var* var)
+{
+  if ( check_invalid(f) ) {
+    return f;
+  }
+  tLevel f_level = zlevel(f);
+  if ( f_level > var->level() ) {
+    return new_znode(var, kEdge0, f);
+  }
+  Node* f_vp = get_node(f);
+  if ( f_level == var->level() ) {
+    return new_znode(var, f_vp->edge1(), f_vp->edge0(get_pol(f)));
+  }
+
+  tBddEdge key = new_znode(var, kEdge0, kEdge1);
+  tBddEdge result = mZChgTable->get(f, key);
+  if ( result == kEdgeInvalid ) {
+    tBddEdge r_0 = zchg_step(f_vp->edge0(get_pol(f)), var);
+    tBddEdge r_1 = zchg_step(f_vp->edge1(), var);
+    result = new_znode(f_vp->var(), r_0, r_1);
+    mZChgTable->put(f, key, result);
+  }
+  return result;
+}
+
+// zdd_count の下請関数
+// 肯定の枝は空集合を含むので否定の枝の時は 1 を引く．
+mpz_class
+BddMgrClassic::zcount_step(tBddEdge e,
+			   hash_map<tBddEdge, mpz_class>& mc_map)
+{
+  if ( check_zero(e) ) {
+    return 0;
+  }
+  if ( check_one(e) ) {
+    return 1;
+  }
+
+  tPol pol = get_pol(e);
+  tBddEdge e_p = addpol(e, pol);
+  mpz_class ans;
+  hash_map<tBddEdge, mpz_class>::iterator p = mc_map.find(e_p);
+  if ( p == mc_map.end() ) {
+    Node* vp = get_node(e_p);
+    ans = zcount_step(vp->edge0(), mc_map) + zcount_step(vp->edge1(), mc_map);
+    mc_map.insert(make_pair(e_p, ans));
+  }
+  else {
+    ans = p->second;
+  }
+  if ( pol == kPolNega ) {
+    ans -= 1;
+  }
+  return ans;
+}
+
+// bdd_to_zdd の下請関数
+tBddEdge
+BddMgrClassic::b2z_step(tBddEdge f,
+			tBddEdge s)
+{
+  if ( check_invalid(f) ) {
+    return f;
+  }
+  if ( check_zero(f) ) {
+    return kEdge0;
+  }
+  if ( check_one(s) && check_one(f) ) {
+    return kEdge1;
+  }
+
+  tBddEdge result = mB2ZTable->get(f, s);
+  if ( result == kEdgeInvalid ) {
+    Node* f_vp = get_node(f);
+    Node* s_vp = get_node(s);
+    tLevel f_level = f_vp ? f_vp->level() : kLevelMax;
+    tLevel s_level = s_vp ? s_vp->level() : kLevelMax;
+    Var* var;
+    tBddEdge f_0, f_1;
+    if ( f_level <= s_level ) {
+      var = f_vp->var();
+      tPol f_pol = get_pol(f);
+      f_0 = f_vp->edge0(f_pol);
+      f_1 = f_vp->edge1(f_pol);
+    }
+    else {
+      // var はどちらの値でもよい．
+      var = s_vp->var();
+      f_0 = f_1 = f;
+    }
+    tBddEdge s_next = s;
+    if ( s_level == var->level() ) {
+      s_next = s_vp->edge1(get_pol(s));
+    }
+    tBddEdge r_0 = b2z_step(f_0, s_next);
+    tBddEdge r_1 = b2z_step(f_1, s_next);
+    result = new_znode(var, r_0, r_1);
+    mB2ZTable->put(f, s, result);
+  }
+  return result;
+}
+
+// zdd_to_bdd の下請関数
+tBddEdge
+BddMgrClassic::z2b_step(tBddEdge f,
+			tBddEdge s)
+{
+  if ( check_invalid(f) ) {
+    return f;
+  }
+  if ( check_zero(f) ) {
+    return kEdge0;
+  }
+  if ( check_one(s) && check_one(f) ) {
+    return kEdge1;
+  }
+
+  tBddEdge result = mZ2BTable->get(f, s);
+  if ( result == kEdgeInvalid ) {
+    Node* s_vp = get_node(s);
+    tLevel f_level = zlevel(f);
+    tLevel s_level = s_vp ? s_vp->level() : kLevelMax;
+    Var* var = ( f_level <= s_level ) ? get_node(f)->var() : s_vp->var();
+    tBddEdge f_0, f_1;
+    // var が f の根の変数でなければ f_1 は空となる．
+    zsplit(f, var, f_0, f_1);
+    tBddEdge s_next = s;
+    if ( s_level == var->level() ) {
+      s_next = s_vp->edge1(get_pol(s));
+    }
+    tBddEdge r_0 = z2b_step(f_0, s_next);
+    tBddEdge r_1 = z2b_step(f_1, s_next);
+    result = new_node(var, r_0, r_1);
+    mZ2BTable->put(f, s, result);
+  }
+  return result;
+}
+
+// zdd_isop の下請関数
+// 処理の内容は isop_step() と同一だが，カバーを ZDD で作る．
+tBddEdge
+BddMgrClassic::zisop_step(tBddEdge l,
+			  tBddEdge u,
+			  tBddEdge& cov)
+{
+  if ( check_zero(l) ) {
+    // 0 がもっとも簡単な答え
+    cov = kEdge0;
+    return kEdge0;
+  }
+
+  if ( check_one(u) ) {
+    // 1 がもっとも簡単な答え
+    // 空のキューブ一つからなるカバーとなる．
+    cov = kEdge1;
+    return kEdge1;
+  }
+
+  // 演算結果テーブルを探す．
+  // 二つのテーブルの片方だけ消されていることもある．
+  tBddEdge result = mZIsopTable->get(l, u);
+  if ( result != kEdgeInvalid ) {
+    cov = mZCovTable->get(l, u);
+    if ( cov != kEdgeInvalid ) {
+      return result;
+    }
+  }
+
+  tBddEdge l_0, l_1;
+  tBddEdge u_0, u_1;
+  Var* var = split(l, u, l_0, l_1, u_0, u_1);
+  tBddEdge var_edge = new_node(var, kEdge0, kEdge1);
+  tVarId varid = var->varid();
+
+  // リテラルを表す ZDD の変数
+  Var* pvar = var_of(varid * 2);
+  if ( !pvar ) {
+    pvar = alloc_var(varid * 2);
+  }
+  Var* nvar = var_of(varid * 2 + 1);
+  if ( !nvar ) {
+    nvar = alloc_var(varid * 2 + 1);
+  }
+  if ( !pvar || !nvar ) {
+    cov = kEdgeOverflow;
+    return kEdgeOverflow;
+  }
+
+  tBddEdge z_0 = and_op(l_0, negate(u_1));
+  tBddEdge p_0;
+  tBddEdge c_0 = zisop_step(z_0, u_0, p_0);
+  tBddEdge cc_0 = and_op(c_0, negate(var_edge));
+
+  tBddEdge z_1 = and_op(l_1, negate(u_0));
+  tBddEdge p_1;
+  tBddEdge c_1 = zisop_step(z_1, u_1, p_1);
+  tBddEdge cc_1 = and_op(c_1, var_edge);
+
+  tBddEdge h_01 = and_op(l_0, negate(c_0));
+  tBddEdge h_02 = and_op(l_1, negate(c_1));
+  tBddEdge h_0  = or_op(h_01, h_02);
+  tBddEdge h_1  = and_op(u_0, u_1);
+  tBddEdge p_2;
+  tBddEdge r_0 = zisop_step(h_0, h_1, p_2);
+
+  result = or_op(or_op(cc_0, cc_1), r_0);
+
+  // p_0, p_1, p_2 は var よりも下の変数しか含まないので
+  // 節点を二つ作るだけでリテラルを付加した和が得られる．
+  tBddEdge n_0 = new_znode(nvar, p_2, p_0);
+  cov = new_znode(pvar, n_0, p_1);
+
+  mZIsopTable->put(l, u, result);
+  mZCovTable->put(l, u, cov);
+
+  return result;
+}
+
+END_NAMESPACE_YM_BDD
@@ -51,6 +51,8 @@ const double DEFAULT_NT_LOAD_LIMIT = 2.0;
 const double DEFAULT_RT_LOAD_LIMIT = 0.8;
 const size_t DEFAULT_MEM_LIMIT     = 400 * M_unit;
 const size_t DEFAULT_DZONE         =  10 * M_unit;
+const size_t DEFAULT_REORDER_LIMIT =   4 * K_unit;
+const double DEFAULT_MAX_GROWTH    = 1.2;
 
 // 節点テーブルの初期サイズ
 const size_t INIT_SIZE = 1 * K_unit;
@@ -61,15 +63,6 @@ const size_t NODE_UNIT = 1 * K_unit;
 // 変数テーブルの初期サイズ
 const size_t VARTABLE_INIT_SIZE = 1 * K_unit;
 
-// 節点テーブルのハッシュ関数
-inline
-size_t
-hash_func2(int id1,
-	   int id2)
-{
-  return size_t(id1 + (id2 >> 2));
-}
-
 // 節点テーブルのハッシュ関数
 inline
 size_t
@@ -117,6 +110,12 @@ BddMgrModern::BddMgrModern(bool reorder,
   mDangerousZone = DEFAULT_DZONE;
   mGcEnable = 0;
 
+  // 動的変数順変更用の変数を初期化
+  mDvoEnable = false;
+  mInReorder = false;
+  mNextReorder = DEFAULT_REORDER_LIMIT;
+  mMaxGrowth = DEFAULT_MAX_GROWTH;
+
   // メモリ管理用のメンバを初期化
   mFreeTop = NULL;
   mFreeNum = 0;
@@ -472,15 +471,20 @@ BddMgrModern::is_reorderable() const
 }
   
 // 動的変数順変更を許可する．
+// 変数ごとに節点テーブルを持たない場合には何もしない．
 void
 BddMgrModern::enable_DVO()
 {
+  if ( is_reorderable() ) {
+    mDvoEnable = true;
+  }
 }
 
 // 動的変数順変更を禁止する．
 void
 BddMgrModern::disable_DVO()
 {
+  mDvoEnable = false;
 }
 
 // 節点テーブルを次に拡大する時の基準値を計算する．
@@ -764,7 +768,7 @@ BddMgrModern::new_node(Var* var,
   size_t pos;
   // 節点テーブルを探す．
   if ( is_reorderable() ) {
-    pos = hash_func2(e0, e1);
+    pos = BmmVar::node_hash(e0, e1);
     for (temp = var->mNodeTable[pos & var->mTableSize_1]; temp;
 	 temp = temp->mLink) {
       if ( temp->edge0() == e0 && temp->edge1() == e1 ) {
@@ -838,6 +842,12 @@ BddMgrModern::dec_rootref(tBddEdge e)
        mGarbageNum > size_t(double(mNodeNum) * mGcThreshold)) {
     gc(false);
   }
+
+  // ノード数が増えすぎていたら変数順を変更する．
+  // gc() と同じく演算の途中ではないこの場所で起動する．
+  if ( mDvoEnable && !mInReorder && live_num() > mNextReorder ) {
+    reorder();
+  }
 }
 
 // mVarTable 中のマークを消す．
@@ -1049,8 +1059,10 @@ BddMgrModern::dealloc_nodechunk(Node* chunk)
 void*
 BddMgrModern::allocate(size_t size)
 {
-  if ( mUsedMem + size > mMemLimit ) {
+  if ( !mInReorder && mUsedMem + size > mMemLimit ) {
     // メモリ制限をオーバーしたので 0 を返す．
+    // ただし，reorder() の途中で失敗すると元に戻せないので
+    // その間は制限を適用しない．
     return 0;
   }
   mUsedMem += size;
@@ -114,6 +114,11 @@ public:
   void
   disable_DVO();
 
+  // 変数順の最適化(sifting)を行う．
+  virtual
+  void
+  reorder();
+
 
   //////////////////////////////////////////////////////////////////////
   // BDD 生成用関数
@@ -750,6 +755,35 @@ public:
   reg_var(Var* var);
 
   
+  //////////////////////////////////////////////////////////////////////
+  // 変数順の変更用の関数
+  //////////////////////////////////////////////////////////////////////
+
+  // 生きている(参照されている)ノード数を得る．
+  size_t
+  live_num() const;
+
+  // level と level + 1 の変数を入れ替える．
+  void
+  swap_level(tLevel level);
+
+  // level と level + 1 の変数がすべての関数に対して対称の時 true を返す．
+  // gc() の直後などゴミのない状態で呼ぶ必要がある．
+  bool
+  check_adjacent_symmetry(tLevel level);
+
+  // ブロック(対称な変数のグループ)の idx 番目と idx + 1 番目を入れ替える．
+  void
+  exchange_block(vector<tVarSize>& block_list,
+		 ymuint idx);
+
+  // ブロックの idx 番目を sifting する．
+  // 最終的な位置を返す．
+  ymuint
+  sift_block(vector<tVarSize>& block_list,
+	     ymuint idx);
+
+  
   //////////////////////////////////////////////////////////////////////
   // メモリ管理用の関数
   //////////////////////////////////////////////////////////////////////
@@ -1012,6 +1046,23 @@ private:
   
   // ノード数がこの数を越えたら mGcEnable は常に true だと思う
   size_t mDangerousZone;
+
+  
+  //////////////////////////////////////////////////////////////////////
+  // 動的変数順変更用の制御用変数
+  //////////////////////////////////////////////////////////////////////
+
+  // 動的変数順変更が許可されている時 true
+  bool mDvoEnable;
+
+  // reorder() の実行中に true となるフラグ
+  bool mInReorder;
+
+  // 生きているノード数がこの数を越えたら reorder() を起動する．
+  size_t mNextReorder;
+
+  // sifting 中のノード数の増加をこの比率までに制限する．
+  double mMaxGrowth;
   
   // GC 前に sweep 処理を行うオブジェクトを管理するマネージャ
   EventBindMgr mSweepMgr;
@@ -209,8 +209,8 @@ BmmCompTbl1::clear()
   Cell* end = cell + mTableSize;
   for ( ; cell != end; cell ++) {
     cell->mKey1 = kEdgeInvalid;
-    mUsedNum --;
   }
+  mUsedNum = 0;
 }
 
 
@@ -308,8 +308,8 @@ BmmCompTbl2::clear()
   Cell* end = cell + mTableSize;
   for ( ; cell != end; cell ++) {
     cell->mKey1 = kEdgeInvalid;
-    mUsedNum --;
   }
+  mUsedNum = 0;
 }
 
 
@@ -409,8 +409,8 @@ BmmCompTbl3::clear()
   Cell* end = cell + mTableSize;
   for ( ; cell != end; cell ++) {
     cell->mKey1 = kEdgeInvalid;
-    mUsedNum --;
   }
+  mUsedNum = 0;
 }
 
 
@@ -516,8 +516,8 @@ BmmIsopTbl::clear()
     cell->mKey1 = kEdgeInvalid;
     delete cell->mAnsCov;
     cell->mAnsCov = 0;
-    mUsedNum --;
   }
+  mUsedNum = 0;
 }
 
 END_NAMESPACE_YM_BDD
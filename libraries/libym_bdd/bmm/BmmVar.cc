@@ -42,22 +42,6 @@ const size_t NODE_UNIT = 1 * K_unit;
 // 変数テーブルの初期サイズ
 const size_t VARTABLE_INIT_SIZE = 1 * K_unit;
 
-// 節点テーブルのハッシュ関数
-inline
-size_t
-hash_func2(int id1, int id2)
-{
-  return size_t(id1 + (id2 >> 2));
-}
-
-// 節点テーブルのハッシュ関数
-inline
-size_t
-hash_func3(int id1, int id2, int id3)
-{
-  return size_t(id1 + (id2 >> 2) + (id3 << 3) - id3);
-}
-
 END_NONAMESPACE
 
 //////////////////////////////////////////////////////////////////////
@@ -177,7 +161,7 @@ BmmVar::resize(size_t new_size)
       Node* temp;
       for (temp = *tbl; temp; temp = next) {
 	next = temp->mLink;
-	size_t pos = hash_func2(temp->edge0(), temp->edge1());
+	size_t pos = node_hash(temp->edge0(), temp->edge1());
 	Node*& entry = mNodeTable[pos & mTableSize_1];
 	temp->mLink = entry;
 	entry = temp;
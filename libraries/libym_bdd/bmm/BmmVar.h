@@ -42,6 +42,14 @@ public:
     return mLevel;
   }
 
+  // 変数ごとの節点テーブルのハッシュ関数
+  // 節点の登録，検索，テーブルの拡張は全てこれを用いること．
+  static
+  size_t node_hash(int id1, int id2)
+  {
+    return size_t(id1 + (id2 >> 2));
+  }
+
 private:
   // コンストラクタ
   BmmVar(BddMgrModern* mgr, tVarId id);
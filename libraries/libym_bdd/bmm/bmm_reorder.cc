@@ -0,0 +1,287 @@
+
+/// @file libym_bdd/bmm/bmm_reorder.cc
+/// @brief 動的変数順変更(sifting)の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#if HAVE_CONFIG_H
+#include <ymconfig.h>
+#endif
+
+#include "BddMgrModern.h"
+#include "BmmCompTbl.h"
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+BEGIN_NONAMESPACE
+
+// 生きているノード数がこの値以下になったら次の reorder() の基準値とする．
+const size_t REORDER_LIMIT_MIN = 4 * 1024;
+
+// ブロックの大きさを比較するための関数オブジェクト
+struct BlockLt
+{
+  bool
+  operator()(const pair<size_t, BmmVar*>& a,
+	     const pair<size_t, BmmVar*>& b) const
+  {
+    return a.first > b.first;
+  }
+};
+
+END_NONAMESPACE
+
+
+// 変数順の最適化を行う．
+// 隣接する対称変数はまとめて一つのブロックとして sifting する
+// (group sifting)．
+void
+BddMgrModern::reorder()
+{
+  if ( !is_reorderable() || mInReorder || mVarNum < 2 ) {
+    return;
+  }
+
+  mInReorder = true;
+
+  // ゴミを取り除いて各レベルのノード数を正確にしておく．
+  gc(false);
+
+  // 演算結果テーブルは節点の削除によって無効になる可能性があるので
+  // 全てクリアしておく．
+  for (CompTbl* tbl = mTblTop; tbl; tbl = tbl->mNext) {
+    tbl->clear();
+  }
+
+  size_t orig_num = live_num();
+  logstream() << "BddMgrModern::reorder() begin...." << endl
+	      << "  " << orig_num << " nodes" << endl;
+
+  // 対称な変数のブロックを作る．
+  vector<tVarSize> block_list;
+  for (tLevel level = 0; level < mVarNum; ) {
+    tVarSize size = 1;
+    while ( level + size < mVarNum &&
+	    check_adjacent_symmetry(level + size - 1) ) {
+      ++ size;
+    }
+    block_list.push_back(size);
+    level += size;
+  }
+
+  // ノード数の多いブロックから順に sifting を行う．
+  // ブロックは先頭の変数で識別する．
+  vector<pair<size_t, Var*> > order;
+  order.reserve(block_list.size());
+  for (tLevel level = 0, idx = 0; idx < block_list.size(); ++ idx) {
+    size_t n = 0;
+    for (tVarSize i = 0; i < block_list[idx]; ++ i) {
+      n += mVarTable[level + i]->mNodeNum;
+    }
+    order.push_back(make_pair(n, mVarTable[level]));
+    level += block_list[idx];
+  }
+  sort(order.begin(), order.end(), BlockLt());
+
+  for (vector<pair<size_t, Var*> >::iterator p = order.begin();
+       p != order.end(); ++ p) {
+    Var* top = p->second;
+    ymuint idx = 0;
+    for (tLevel level = 0; mVarTable[level] != top; ++ idx) {
+      level += block_list[idx];
+    }
+    sift_block(block_list, idx);
+  }
+
+  // 入れ替えの途中で参照されなくなったノードを回収する．
+  gc(false);
+
+  size_t new_num = live_num();
+  mNextReorder = new_num * 2;
+  if ( mNextReorder < REORDER_LIMIT_MIN ) {
+    mNextReorder = REORDER_LIMIT_MIN;
+  }
+  mInReorder = false;
+
+  logstream() << "BddMgrModern::reorder() end." << endl
+	      << "  " << orig_num << " -> " << new_num << " nodes" << endl;
+}
+
+// 生きている(参照されている)ノード数を得る．
+size_t
+BddMgrModern::live_num() const
+{
+  return mNodeNum - mGarbageNum;
+}
+
+// ブロックの idx 番目を sifting する．
+// 最終的な位置を返す．
+ymuint
+BddMgrModern::sift_block(vector<tVarSize>& block_list,
+			 ymuint idx)
+{
+  ymuint nb = block_list.size();
+  size_t best_num = live_num();
+  ymuint best_idx = idx;
+  ymuint cur = idx;
+
+  // 近い方の端から先に動かす．
+  bool down_first = (idx >= nb / 2);
+  for (ymuint phase = 0; phase < 2; ++ phase) {
+    bool down = (phase == 0) ? down_first : !down_first;
+    if ( down ) {
+      while ( cur + 1 < nb ) {
+	exchange_block(block_list, cur);
+	++ cur;
+	size_t n = live_num();
+	if ( n < best_num ) {
+	  best_num = n;
+	  best_idx = cur;
+	}
+	else if ( n > best_num * mMaxGrowth ) {
+	  break;
+	}
+      }
+    }
+    else {
+      while ( cur > 0 ) {
+	exchange_block(block_list, cur - 1);
+	-- cur;
+	size_t n = live_num();
+	if ( n < best_num ) {
+	  best_num = n;
+	  best_idx = cur;
+	}
+	else if ( n > best_num * mMaxGrowth ) {
+	  break;
+	}
+      }
+    }
+  }
+
+  // 最良の位置に戻す．
+  while ( cur < best_idx ) {
+    exchange_block(block_list, cur);
+    ++ cur;
+  }
+  while ( cur > best_idx ) {
+    exchange_block(block_list, cur - 1);
+    -- cur;
+  }
+  return cur;
+}
+
+// ブロック(対称な変数のグループ)の idx 番目と idx + 1 番目を入れ替える．
+// 下のブロックの変数を一つずつ上のブロックの上まで移動させる．
+void
+BddMgrModern::exchange_block(vector<tVarSize>& block_list,
+			     ymuint idx)
+{
+  tLevel top = 0;
+  for (ymuint i = 0; i < idx; ++ i) {
+    top += block_list[i];
+  }
+  tVarSize size1 = block_list[idx];
+  tVarSize size2 = block_list[idx + 1];
+  for (tVarSize i = 0; i < size2; ++ i) {
+    for (tVarSize j = size1; j > 0; -- j) {
+      swap_level(top + i + j - 1);
+    }
+  }
+  block_list[idx] = size2;
+  block_list[idx + 1] = size1;
+}
+
+// level と level + 1 の変数を入れ替える．
+// x を level の変数，y を level + 1 の変数とすると，
+// y の節点を子供に持つ x の節点 f を f00, f01, f10, f11 から
+// y の節点として作り直す．
+// f のアドレスはそのままなので f を指している枝は変更する必要がない．
+void
+BddMgrModern::swap_level(tLevel level)
+{
+  Var* x = mVarTable[level];
+  Var* y = mVarTable[level + 1];
+
+  // 参照されていないノードは入れ替えの対象から外しておく．
+  x->sweep();
+  y->sweep();
+
+  // x の節点のうち y の節点を子供に持つものを取り出す．
+  Node* swap_list = NULL;
+  Node** ptr = x->mNodeTable;
+  Node** end = ptr + x->mTableSize;
+  for ( ; ptr != end; ++ ptr) {
+    Node** prev = ptr;
+    Node* temp;
+    while ( (temp = *prev) ) {
+      Node* vp0 = get_node(temp->edge0());
+      Node* vp1 = get_node(temp->edge1());
+      if ( (vp0 && vp0->var() == y) || (vp1 && vp1->var() == y) ) {
+	*prev = temp->mLink;
+	temp->mLink = swap_list;
+	swap_list = temp;
+	-- x->mNodeNum;
+      }
+      else {
+	prev = &(temp->mLink);
+      }
+    }
+  }
+
+  // レベルを入れ替える．
+  mVarTable[level] = y;
+  y->mLevel = level;
+  mVarTable[level + 1] = x;
+  x->mLevel = level + 1;
+
+  // 取り出した節点を y の節点として作り直す．
+  Node* next;
+  for (Node* f = swap_list; f; f = next) {
+    next = f->mLink;
+
+    tBddEdge e0 = f->edge0();
+    tBddEdge e1 = f->edge1();
+    Node* vp0 = get_node(e0);
+    Node* vp1 = get_node(e1);
+    tBddEdge f00 = e0;
+    tBddEdge f01 = e0;
+    if ( vp0 && vp0->var() == y ) {
+      tPol pol0 = get_pol(e0);
+      f00 = vp0->edge0(pol0);
+      f01 = vp0->edge1(pol0);
+    }
+    // 1枝は正規化により常に肯定枝
+    tBddEdge f10 = e1;
+    tBddEdge f11 = e1;
+    if ( vp1 && vp1->var() == y ) {
+      f10 = vp1->edge0();
+      f11 = vp1->edge1();
+    }
+
+    tBddEdge g0 = new_node(x, f00, f10);
+    assert_cond(!check_invalid(g0), __FILE__, __LINE__);
+    activate(g0);
+    tBddEdge g1 = new_node(x, f01, f11);
+    assert_cond(!check_invalid(g1), __FILE__, __LINE__);
+    activate(g1);
+    assert_cond(get_pol(g1) == kPolPosi, __FILE__, __LINE__);
+
+    // f が持っていた子供への参照を外す．
+    deactivate(e0);
+    deactivate(e1);
+
+    f->mEdge0 = g0;
+    f->mEdge1 = g1;
+    f->mVar = y;
+    y->reg_node(BmmVar::node_hash(g0, g1), f);
+  }
+}
+
+END_NAMESPACE_YM_BDD
@@ -189,4 +189,72 @@ BddMgrModern::check_symmetry(tBddEdge e,
   return ans == kEdge1;
 }
 
+// level と level + 1 の変数がすべての関数に対して対称の時 true を返す．
+// 個々の関数を調べる代わりに隣接する2つのレベルの節点の構造を見る．
+// - level の節点 f の4つのコファクターが f01 == f10 (正の対称) または
+//   f00 == f11 (負の対称) をすべての節点で満たす．
+// - level + 1 の節点は level の節点からのみ参照されている．
+// ゴミの節点を含んでいると正しく判定できないので gc() の直後に呼ぶ必要がある．
+bool
+BddMgrModern::check_adjacent_symmetry(tLevel level)
+{
+  Var* x = mVarTable[level];
+  Var* y = mVarTable[level + 1];
+
+  bool xsymy = true;
+  bool xsymyp = true;
+  size_t arc_count = 0;
+  Node** ptr = x->mNodeTable;
+  Node** end = ptr + x->mTableSize;
+  for ( ; ptr != end; ++ ptr) {
+    for (Node* f = *ptr; f; f = f->mLink) {
+      if ( f->noref() ) {
+	continue;
+      }
+      tBddEdge e0 = f->edge0();
+      tBddEdge e1 = f->edge1();
+      Node* vp0 = get_node(e0);
+      Node* vp1 = get_node(e1);
+      tBddEdge f00 = e0;
+      tBddEdge f01 = e0;
+      if ( vp0 && vp0->var() == y ) {
+	tPol pol0 = get_pol(e0);
+	f00 = vp0->edge0(pol0);
+	f01 = vp0->edge1(pol0);
+	++ arc_count;
+      }
+      tBddEdge f10 = e1;
+      tBddEdge f11 = e1;
+      if ( vp1 && vp1->var() == y ) {
+	f10 = vp1->edge0();
+	f11 = vp1->edge1();
+	++ arc_count;
+      }
+      xsymy = xsymy && (f01 == f10);
+      xsymyp = xsymyp && (f00 == f11);
+      if ( !xsymy && !xsymyp ) {
+	return false;
+      }
+    }
+  }
+  if ( arc_count == 0 ) {
+    return false;
+  }
+
+  // y の節点の参照回数の総和が x からの枝の数と一致するか調べる．
+  size_t total_ref = 0;
+  ptr = y->mNodeTable;
+  end = ptr + y->mTableSize;
+  for ( ; ptr != end; ++ ptr) {
+    for (Node* f = *ptr; f; f = f->mLink) {
+      if ( f->linkdelta() == 0 ) {
+	// 参照回数がオーバーフローしている．
+	return false;
+      }
+      total_ref += f->refcount();
+    }
+  }
+  return total_ref == arc_count;
+}
+
 END_NAMESPACE_YM_BDD
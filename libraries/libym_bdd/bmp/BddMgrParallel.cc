@@ -0,0 +1,453 @@
+
+/// @file libym_bdd/bmp/BddMgrParallel.cc
+/// @brief BddMgrParallel の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#if HAVE_CONFIG_H
+#include <ymconfig.h>
+#endif
+
+#include "BddMgrParallel.h"
+#include "BmpCompTbl.h"
+
+#include <sched.h>
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+BEGIN_NONAMESPACE
+
+// スレッドごとのタスクキューの大きさ
+const ymuint kTaskArraySize = 1024;
+
+// 一度にワーカーに渡す節点数
+const size_t kNodeBatch = 256;
+
+// 節点テーブルのハッシュ関数
+// BddMgrClassic.cc のものと同一でなければならない．
+inline
+size_t
+hash_func3(ympuint id1,
+	   ympuint id2,
+	   ympuint id3)
+{
+  return static_cast<size_t>(id1 + (id2 >> 2) + (id3 << 3) - id3);
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// BddMgrParallel
+//////////////////////////////////////////////////////////////////////
+
+// コンストラクタ
+BddMgrParallel::BddMgrParallel(const string& name,
+			       ymuint thread_num) :
+  BddMgrClassic(name)
+{
+  mThreadNum = thread_num;
+  if ( mThreadNum == 0 ) {
+    mThreadNum = 1;
+  }
+
+  // スレッド数が多いほど深いところまでタスクを作る．
+  ymuint lg = 0;
+  while ( (1U << lg) < mThreadNum ) {
+    ++ lg;
+  }
+  mSpawnDepth = lg * 2 + 8;
+
+  mCompTbl = new BmpCompTbl(this, "parallel_table");
+  assert_cond(mCompTbl, __FILE__, __LINE__);
+
+  pthread_mutex_init(&mAllocLock, NULL);
+  pthread_mutex_init(&mPoolLock, NULL);
+  pthread_cond_init(&mStartCond, NULL);
+  pthread_cond_init(&mDoneCond, NULL);
+  mGeneration = 0;
+  mIdleNum = 0;
+  mOpDone = true;
+  mQuit = false;
+
+  mWorkerArray = new Worker[mThreadNum];
+  for (ymuint i = 0; i < mThreadNum; ++ i) {
+    Worker& w = mWorkerArray[i];
+    w.mMgr = this;
+    w.mId = i;
+    pthread_mutex_init(&w.mLock, NULL);
+    w.mTaskArray = new Task[kTaskArraySize];
+    w.mTop = 0;
+    w.mBottom = 0;
+    w.mFreeTop = NULL;
+    w.mFreeNum = 0;
+    w.mRand = i * 2654435761U + 1;
+  }
+
+  // 0 番目はメインスレッドが用いる．
+  for (ymuint i = 1; i < mThreadNum; ++ i) {
+    Worker& w = mWorkerArray[i];
+    if ( pthread_create(&w.mThread, NULL, thread_main, &w) != 0 ) {
+      // スレッドが作れなかったらそこまでのスレッドで演算を行う．
+      logstream() << "BddMgrParallel: only " << i
+		  << " threads are available." << endl;
+      for (ymuint j = i; j < mThreadNum; ++ j) {
+	pthread_mutex_destroy(&mWorkerArray[j].mLock);
+	delete [] mWorkerArray[j].mTaskArray;
+      }
+      mThreadNum = i;
+      break;
+    }
+  }
+}
+
+// デストラクタ
+BddMgrParallel::~BddMgrParallel()
+{
+  pthread_mutex_lock(&mPoolLock);
+  mQuit = true;
+  pthread_cond_broadcast(&mStartCond);
+  pthread_mutex_unlock(&mPoolLock);
+
+  for (ymuint i = 1; i < mThreadNum; ++ i) {
+    pthread_join(mWorkerArray[i].mThread, NULL);
+  }
+  for (ymuint i = 0; i < mThreadNum; ++ i) {
+    Worker& w = mWorkerArray[i];
+    pthread_mutex_destroy(&w.mLock);
+    delete [] w.mTaskArray;
+  }
+  delete [] mWorkerArray;
+
+  pthread_cond_destroy(&mDoneCond);
+  pthread_cond_destroy(&mStartCond);
+  pthread_mutex_destroy(&mPoolLock);
+  pthread_mutex_destroy(&mAllocLock);
+
+  // mCompTbl は BddMgrClassic のデストラクタで削除される．
+}
+
+// 全てのスレッドを起こして演算を行う．
+tBddEdge
+BddMgrParallel::run(ymuint32 op,
+		    tBddEdge e1,
+		    tBddEdge e2,
+		    tBddEdge e3)
+{
+  if ( mThreadNum > 1 ) {
+    pthread_mutex_lock(&mPoolLock);
+    mOpDone = false;
+    mIdleNum = 0;
+    ++ mGeneration;
+    pthread_cond_broadcast(&mStartCond);
+    pthread_mutex_unlock(&mPoolLock);
+  }
+
+  tBddEdge ans = execute(mWorkerArray[0], op, e1, e2, e3, 0);
+
+  if ( mThreadNum > 1 ) {
+    // 根のタスクが終わった時点で全てのタスクは終わっている．
+    __sync_synchronize();
+    mOpDone = true;
+    pthread_mutex_lock(&mPoolLock);
+    while ( mIdleNum < mThreadNum - 1 ) {
+      pthread_cond_wait(&mDoneCond, &mPoolLock);
+    }
+    pthread_mutex_unlock(&mPoolLock);
+  }
+
+  finish_op();
+
+  return ans;
+}
+
+// 演算の後始末を行う．
+// ここはメインスレッドしか動いていない．
+void
+BddMgrParallel::finish_op()
+{
+  // ワーカーが抱えている空き節点をフリーリストに戻す．
+  for (ymuint i = 0; i < mThreadNum; ++ i) {
+    Worker& w = mWorkerArray[i];
+    Node* next;
+    for (Node* temp = w.mFreeTop; temp; temp = next) {
+      next = temp->mLink;
+      temp->mLink = mFreeTop;
+      mFreeTop = temp;
+      ++ mFreeNum;
+      -- mNodeNum;
+      -- mGarbageNum;
+    }
+    w.mFreeTop = NULL;
+    w.mFreeNum = 0;
+  }
+
+  // 演算中は節点テーブルを拡張できないのでここで行う．
+  while ( mNodeNum > mNextLimit ) {
+    if ( !resize(mTableSize << 1) ) {
+      break;
+    }
+  }
+
+  mCompTbl->adjust(mNodeNum);
+}
+
+// 演算を実行する．
+tBddEdge
+BddMgrParallel::execute(Worker& w,
+			ymuint32 op,
+			tBddEdge e1,
+			tBddEdge e2,
+			tBddEdge e3,
+			ymuint depth)
+{
+  switch ( op ) {
+  case kOpAnd: return and_step(w, e1, e2, depth);
+  case kOpXor: return xor_step(w, e1, e2, depth);
+  case kOpIte: return ite_step(w, e1, e2, e3, depth);
+  case kOpSm:  return esmooth_step(w, e1, e2, depth);
+  case kOpAe:  return andexist_step(w, e1, e2, e3, depth);
+  default: break;
+  }
+  assert_not_reached(__FILE__, __LINE__);
+  return kEdgeError;
+}
+
+// タスクを自分のキューに積む．
+int
+BddMgrParallel::spawn(Worker& w,
+		      ymuint32 op,
+		      tBddEdge e1,
+		      tBddEdge e2,
+		      tBddEdge e3,
+		      ymuint depth)
+{
+  if ( mThreadNum == 1 ) {
+    return -1;
+  }
+
+  pthread_mutex_lock(&w.mLock);
+  ymuint pos = w.mBottom;
+  if ( pos == kTaskArraySize ) {
+    pthread_mutex_unlock(&w.mLock);
+    return -1;
+  }
+  Task& task = w.mTaskArray[pos];
+  task.mOp = op;
+  task.mArg1 = e1;
+  task.mArg2 = e2;
+  task.mArg3 = e3;
+  task.mDepth = depth;
+  task.mResult = kEdgeInvalid;
+  task.mState = 0;
+  w.mBottom = pos + 1;
+  pthread_mutex_unlock(&w.mLock);
+
+  return static_cast<int>(pos);
+}
+
+// spawn() で積んだタスクの結果を得る．
+tBddEdge
+BddMgrParallel::sync(Worker& w,
+		     int slot)
+{
+  ymuint pos = static_cast<ymuint>(slot);
+  Task& task = w.mTaskArray[pos];
+
+  pthread_mutex_lock(&w.mLock);
+  if ( w.mTop <= pos ) {
+    // 盗まれていなかったので自分で実行する．
+    w.mBottom = pos;
+    pthread_mutex_unlock(&w.mLock);
+    return execute(w, task.mOp, task.mArg1, task.mArg2, task.mArg3,
+		   task.mDepth);
+  }
+  pthread_mutex_unlock(&w.mLock);
+
+  // 盗まれたタスクが終わるまで他のタスクを手伝う．
+  while ( task.mState != 2 ) {
+    if ( !steal(w) ) {
+      sched_yield();
+    }
+  }
+  __sync_synchronize();
+  tBddEdge ans = task.mResult;
+
+  // pos より下のタスクも全て盗まれているはず．
+  pthread_mutex_lock(&w.mLock);
+  w.mTop = pos;
+  w.mBottom = pos;
+  pthread_mutex_unlock(&w.mLock);
+
+  return ans;
+}
+
+// 他のスレッドのタスクを盗んで実行する．
+bool
+BddMgrParallel::steal(Worker& w)
+{
+  w.mRand = w.mRand * 1103515245U + 12345U;
+  ymuint start = (w.mRand >> 16) % mThreadNum;
+  for (ymuint i = 0; i < mThreadNum; ++ i) {
+    Worker& victim = mWorkerArray[(start + i) % mThreadNum];
+    if ( &victim == &w || victim.mTop >= victim.mBottom ) {
+      continue;
+    }
+    pthread_mutex_lock(&victim.mLock);
+    if ( victim.mTop < victim.mBottom ) {
+      Task& task = victim.mTaskArray[victim.mTop];
+      ++ victim.mTop;
+      task.mState = 1;
+      pthread_mutex_unlock(&victim.mLock);
+
+      // 持ち主は mState が 2 になるまでこのタスクを書き換えない．
+      tBddEdge ans = execute(w, task.mOp, task.mArg1, task.mArg2, task.mArg3,
+			     task.mDepth);
+      task.mResult = ans;
+      __sync_synchronize();
+      task.mState = 2;
+      return true;
+    }
+    pthread_mutex_unlock(&victim.mLock);
+  }
+  return false;
+}
+
+// ワーカースレッドの本体
+void
+BddMgrParallel::worker_loop(Worker& w)
+{
+  ymuint32 generation = 0;
+  for ( ; ; ) {
+    pthread_mutex_lock(&mPoolLock);
+    while ( mGeneration == generation && !mQuit ) {
+      pthread_cond_wait(&mStartCond, &mPoolLock);
+    }
+    if ( mQuit ) {
+      pthread_mutex_unlock(&mPoolLock);
+      break;
+    }
+    generation = mGeneration;
+    pthread_mutex_unlock(&mPoolLock);
+
+    while ( !mOpDone ) {
+      if ( !steal(w) ) {
+	sched_yield();
+      }
+    }
+
+    pthread_mutex_lock(&mPoolLock);
+    ++ mIdleNum;
+    if ( mIdleNum == mThreadNum - 1 ) {
+      pthread_cond_signal(&mDoneCond);
+    }
+    pthread_mutex_unlock(&mPoolLock);
+  }
+}
+
+// pthread_create() に渡す関数
+void*
+BddMgrParallel::thread_main(void* arg)
+{
+  Worker* w = static_cast<Worker*>(arg);
+  w->mMgr->worker_loop(*w);
+  return NULL;
+}
+
+// new_node() のスレッドセーフ版
+// 節点テーブルのチェインの先頭を CAS で書き換えて登録する．
+// 書き換えに失敗したら先頭から探し直す．
+tBddEdge
+BddMgrParallel::new_node_mt(Worker& w,
+			    Var* var,
+			    tBddEdge e0,
+			    tBddEdge e1)
+{
+  if ( e0 == e1 ) {
+    return e0;
+  }
+
+  if ( check_error(e0) || check_error(e1) ) {
+    return kEdgeError;
+  }
+  if ( check_overflow(e0) || check_overflow(e1) ) {
+    return kEdgeInvalid;
+  }
+
+  // 否定枝に関する正規化ルール
+  tPol ans_pol = get_pol(e1);
+  e1 = addpol(e1, ans_pol);
+  e0 = addpol(e0, ans_pol);
+
+  size_t pos = hash_func3(e0, e1, var->varid());
+  Node* volatile* entry = &mNodeTable[pos & mTableSize_1];
+  Node* temp = NULL;
+  for ( ; ; ) {
+    Node* head = *entry;
+    for (Node* node = head; node; node = node->mLink) {
+      if ( node->edge0() == e0 && node->edge1() == e1 &&
+	   node->var() == var ) {
+	// 同一の節点がすでに登録されている
+	if ( temp ) {
+	  temp->mLink = w.mFreeTop;
+	  w.mFreeTop = temp;
+	  ++ w.mFreeNum;
+	}
+	return combine(node, ans_pol);
+      }
+    }
+
+    if ( !temp ) {
+      temp = alloc_node_mt(w);
+      if ( !temp ) {
+	// メモリアロケーションに失敗した
+	return kEdgeInvalid;
+      }
+      temp->mEdge0 = e0;
+      temp->mEdge1 = e1;
+      temp->mVar = var;
+      temp->mRefMark = 0UL;  // mark = none, link = 0
+    }
+    temp->mLink = head;
+    if ( __sync_bool_compare_and_swap(entry, head, temp) ) {
+      return combine(temp, ans_pol);
+    }
+  }
+}
+
+// alloc_node() のスレッドセーフ版
+// まとめて確保した節点をワーカーごとに持たせておく．
+BmcNode*
+BddMgrParallel::alloc_node_mt(Worker& w)
+{
+  if ( !w.mFreeTop ) {
+    pthread_mutex_lock(&mAllocLock);
+    for (size_t i = 0; i < kNodeBatch; ++ i) {
+      Node* temp = alloc_node();
+      if ( !temp ) {
+	break;
+      }
+      // 使われずに返された場合に GC で回収されるようにしておく．
+      temp->mRefMark = 0UL;
+      temp->mLink = w.mFreeTop;
+      w.mFreeTop = temp;
+      ++ w.mFreeNum;
+    }
+    pthread_mutex_unlock(&mAllocLock);
+    if ( !w.mFreeTop ) {
+      return NULL;
+    }
+  }
+  Node* temp = w.mFreeTop;
+  w.mFreeTop = temp->mLink;
+  -- w.mFreeNum;
+  return temp;
+}
+
+END_NAMESPACE_YM_BDD
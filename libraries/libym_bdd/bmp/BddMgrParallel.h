@@ -0,0 +1,328 @@
+#ifndef LIBYM_BDD_BMP_BDDMGRPARALLEL_H
+#define LIBYM_BDD_BMP_BDDMGRPARALLEL_H
+
+/// @file libym_bdd/bmp/BddMgrParallel.h
+/// @brief BddMgrParallel のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "bmc/BddMgrClassic.h"
+
+#include <pthread.h>
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+class BmpCompTbl;
+
+//////////////////////////////////////////////////////////////////////
+// 複数のスレッドで演算を行う BddMgr
+//
+// 節点の構造や変数順は BddMgrClassic と同一で，
+// and_op(), xor_op(), ite_op(), esmooth(), and_exist() の
+// 再帰呼び出しをタスクとして複数のスレッドに分散させる．
+// - 節点テーブルへの登録はチェインの先頭を CAS で書き換える．
+// - 演算結果テーブルは損失を許すロックフリーのテーブル(BmpCompTbl)
+// - タスクはスレッドごとの両端キューに積まれ，暇なスレッドが
+//   他のスレッドのキューの古い方から盗んで実行する(work stealing)．
+// 演算中は参照回数の操作も GC も行われないので，それらは
+// 従来どおり単一のスレッドから行われる．
+// BDD は正準形なので結果は BddMgrClassic と同一になる．
+//////////////////////////////////////////////////////////////////////
+class BddMgrParallel :
+  public BddMgrClassic
+{
+public:
+
+  // コンストラクタ
+  // thread_num はメインスレッドを含めたスレッド数
+  BddMgrParallel(const string& name,
+		 ymuint thread_num);
+
+  // デストラクタ
+  virtual
+  ~BddMgrParallel();
+
+
+  //////////////////////////////////////////////////////////////////////
+  // 並列化された論理演算
+  // or_op() は and_op() を呼び出すので再定義の必要はない．
+  //////////////////////////////////////////////////////////////////////
+
+  // src1 & src2 を計算する．
+  virtual
+  tBddEdge
+  and_op(tBddEdge e1,
+	 tBddEdge e2);
+
+  // src1 ^ src2 を計算する．
+  virtual
+  tBddEdge
+  xor_op(tBddEdge e1,
+	 tBddEdge e2);
+
+  // if-then-else 演算を計算する．
+  virtual
+  tBddEdge
+  ite_op(tBddEdge e1,
+	 tBddEdge e2,
+	 tBddEdge e3);
+
+  // smoothing(elimination)
+  // svars に含まれる変数を消去する．
+  virtual
+  tBddEdge
+  esmooth(tBddEdge e1,
+	  tBddEdge e2);
+
+  // src1 と src2 の論理積を計算して src3 の変数を消去する．
+  virtual
+  tBddEdge
+  and_exist(tBddEdge e1,
+	    tBddEdge e2,
+	    tBddEdge e3);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 演算の種類
+  enum {
+    kOpAnd = 1,
+    kOpXor = 2,
+    kOpIte = 3,
+    kOpSm  = 4,
+    kOpAe  = 5
+  };
+
+  // タスク
+  struct Task
+  {
+    // 演算の種類
+    ymuint32 mOp;
+
+    // 引数
+    tBddEdge mArg1;
+    tBddEdge mArg2;
+    tBddEdge mArg3;
+
+    // 再帰の深さ
+    ymuint mDepth;
+
+    // 結果
+    tBddEdge mResult;
+
+    // 状態
+    // 0: 未着手，1: 他のスレッドが実行中，2: 完了
+    volatile ymuint32 mState;
+  };
+
+  // スレッドごとの作業領域
+  struct Worker
+  {
+    // 親のマネージャ
+    BddMgrParallel* mMgr;
+
+    // スレッド番号
+    ymuint mId;
+
+    // スレッド
+    pthread_t mThread;
+
+    // mTaskArray, mTop, mBottom を保護する mutex
+    pthread_mutex_t mLock;
+
+    // タスクの両端キュー
+    // mTop から盗まれ，mBottom に積まれる．
+    Task* mTaskArray;
+
+    // 盗まれる側の位置
+    volatile ymuint mTop;
+
+    // 積まれる側の位置
+    volatile ymuint mBottom;
+
+    // このスレッド専用の空き節点のリスト
+    Node* mFreeTop;
+
+    // mFreeTop の節点数
+    size_t mFreeNum;
+
+    // 盗む相手を選ぶための乱数の種
+    ymuint32 mRand;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // タスクの管理を行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  // 全てのスレッドを起こして演算を行う．
+  tBddEdge
+  run(ymuint32 op,
+      tBddEdge e1,
+      tBddEdge e2,
+      tBddEdge e3);
+
+  // 演算の後始末を行う．
+  void
+  finish_op();
+
+  // 演算を実行する．
+  tBddEdge
+  execute(Worker& w,
+	  ymuint32 op,
+	  tBddEdge e1,
+	  tBddEdge e2,
+	  tBddEdge e3,
+	  ymuint depth);
+
+  // タスクを自分のキューに積む．
+  // キューがあふれていたら -1 を返す．
+  int
+  spawn(Worker& w,
+	ymuint32 op,
+	tBddEdge e1,
+	tBddEdge e2,
+	tBddEdge e3,
+	ymuint depth);
+
+  // spawn() で積んだタスクの結果を得る．
+  // 盗まれていなければ自分で実行する．
+  tBddEdge
+  sync(Worker& w,
+       int slot);
+
+  // 他のスレッドのタスクを盗んで実行する．
+  // 盗めなかったら false を返す．
+  bool
+  steal(Worker& w);
+
+  // ワーカースレッドの本体
+  void
+  worker_loop(Worker& w);
+
+  // pthread_create() に渡す関数
+  static
+  void*
+  thread_main(void* arg);
+
+
+  //////////////////////////////////////////////////////////////////////
+  // 演算の本体
+  //////////////////////////////////////////////////////////////////////
+
+  tBddEdge
+  and_step(Worker& w,
+	   tBddEdge f,
+	   tBddEdge g,
+	   ymuint depth);
+
+  tBddEdge
+  or_step(Worker& w,
+	  tBddEdge f,
+	  tBddEdge g,
+	  ymuint depth);
+
+  tBddEdge
+  xor_step(Worker& w,
+	   tBddEdge f,
+	   tBddEdge g,
+	   ymuint depth);
+
+  tBddEdge
+  ite_step(Worker& w,
+	   tBddEdge f,
+	   tBddEdge g,
+	   tBddEdge h,
+	   ymuint depth);
+
+  tBddEdge
+  esmooth_step(Worker& w,
+	       tBddEdge e,
+	       tBddEdge s,
+	       ymuint depth);
+
+  tBddEdge
+  andexist_step(Worker& w,
+		tBddEdge f,
+		tBddEdge g,
+		tBddEdge s,
+		ymuint depth);
+
+  // 消去する変数に印を付ける．
+  void
+  mark_smooth_vars(tBddEdge s);
+
+
+  //////////////////////////////////////////////////////////////////////
+  // 節点の管理を行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  // new_node() のスレッドセーフ版
+  tBddEdge
+  new_node_mt(Worker& w,
+	      Var* var,
+	      tBddEdge e0,
+	      tBddEdge e1);
+
+  // alloc_node() のスレッドセーフ版
+  Node*
+  alloc_node_mt(Worker& w);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // スレッド数
+  ymuint mThreadNum;
+
+  // ワーカーの配列
+  // 0 番目はメインスレッド用
+  Worker* mWorkerArray;
+
+  // この深さまではタスクを生成する．
+  ymuint mSpawnDepth;
+
+  // 全ての演算で共通の演算結果テーブル
+  BmpCompTbl* mCompTbl;
+
+  // alloc_node() を保護する mutex
+  pthread_mutex_t mAllocLock;
+
+  // 以下のメンバを保護する mutex
+  pthread_mutex_t mPoolLock;
+
+  // 演算の開始を知らせる条件変数
+  pthread_cond_t mStartCond;
+
+  // ワーカースレッドの終了を知らせる条件変数
+  pthread_cond_t mDoneCond;
+
+  // 演算の通し番号
+  ymuint32 mGeneration;
+
+  // 演算を終えたワーカースレッド数
+  ymuint mIdleNum;
+
+  // 演算が終了したことを表すフラグ
+  volatile bool mOpDone;
+
+  // スレッドを終了させるフラグ
+  bool mQuit;
+
+};
+
+END_NAMESPACE_YM_BDD
+
+#endif // LIBYM_BDD_BMP_BDDMGRPARALLEL_H
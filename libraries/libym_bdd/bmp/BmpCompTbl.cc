@@ -0,0 +1,130 @@
+
+/// @file libym_bdd/bmp/BmpCompTbl.cc
+/// @brief BmpCompTbl の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#if HAVE_CONFIG_H
+#include <ymconfig.h>
+#endif
+
+#include "BmpCompTbl.h"
+
+
+BEGIN_NONAMESPACE
+
+const size_t kInitSize = (1UL << 16);
+const size_t kMaxSize = (1UL << 24);
+
+END_NONAMESPACE
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+//////////////////////////////////////////////////////////////////////
+// BmpCompTbl
+//////////////////////////////////////////////////////////////////////
+
+// コンストラクタ
+BmpCompTbl::BmpCompTbl(BddMgrClassic* mgr,
+		       const char* name) :
+  BmcCompTbl(mgr, name),
+  mTable(NULL)
+{
+  mMaxSize = kMaxSize;
+  resize(kInitSize);
+}
+
+// デストラクタ
+BmpCompTbl::~BmpCompTbl()
+{
+  deallocate((void*)mTable, mTableSize * sizeof(Cell));
+}
+
+// 節点数に応じてテーブルサイズを調整する．
+// 衝突したセルは上書きされるだけなので節点数と同程度の大きさがあればよい．
+void
+BmpCompTbl::adjust(size_t node_num)
+{
+  size_t new_size = mTableSize;
+  while ( new_size < node_num && new_size < mMaxSize ) {
+    new_size <<= 1;
+  }
+  if ( new_size != mTableSize ) {
+    resize(new_size);
+  }
+}
+
+// テーブルサイズを変更する．
+void
+BmpCompTbl::resize(size_t new_size)
+{
+  // ログの出力
+  logstream() << "BmpCompTbl[" << mName << "]::resize(" << new_size << ")"
+	      << endl;
+
+  Cell* new_table = (Cell*)allocate(new_size * sizeof(Cell));
+  if ( !new_table ) {
+    // メモリが足りない時は今のテーブルを使い続ける．
+    return;
+  }
+  if ( mTable ) {
+    deallocate((void*)mTable, mTableSize * sizeof(Cell));
+  }
+  mTable = new_table;
+  mTableSize = new_size;
+  mTableSize_1 = mTableSize - 1;
+  update_next_limit();
+
+  // 損失を許すテーブルなので昔の内容は引き継がない．
+  Cell* cell = mTable;
+  Cell* end = cell + mTableSize;
+  for ( ; cell != end; ++ cell) {
+    cell->mStamp = 0;
+    cell->mOp = 0;
+    cell->mKey1 = kEdgeInvalid;
+  }
+  mUsedNum = 0;
+}
+
+// BddMgr::GC()に対応する．
+// 具体的には GC で削除されるノードに関連したセルをクリアする．
+void
+BmpCompTbl::sweep()
+{
+  // ログを出力
+  logstream() << "BmpCompTbl[" << mName << "]::sweep()" << endl;
+
+  // 削除されるノードに関連したセルをクリアする．
+  Cell* cell = mTable;
+  Cell* end = cell + mTableSize;
+  for ( ; cell != end; ++ cell) {
+    if ( cell->mKey1 != kEdgeInvalid &&
+	 (check_noref(cell->mKey1) ||
+	  check_noref(cell->mKey2) ||
+	  check_noref(cell->mKey3) ||
+	  check_noref(cell->mAns)) ) {
+      cell->mKey1 = kEdgeInvalid;
+      -- mUsedNum;
+    }
+  }
+}
+
+// クリアする．
+void
+BmpCompTbl::clear()
+{
+  Cell* cell = mTable;
+  Cell* end = cell + mTableSize;
+  for ( ; cell != end; ++ cell) {
+    cell->mKey1 = kEdgeInvalid;
+  }
+  mUsedNum = 0;
+}
+
+END_NAMESPACE_YM_BDD
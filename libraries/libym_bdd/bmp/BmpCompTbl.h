@@ -0,0 +1,192 @@
+#ifndef LIBYM_BDD_BMP_BMPCOMPTBL_H
+#define LIBYM_BDD_BMP_BMPCOMPTBL_H
+
+/// @file libym_bdd/bmp/BmpCompTbl.h
+/// @brief BmpCompTbl のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "bmc/BmcCompTbl.h"
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+//////////////////////////////////////////////////////////////////////
+// 複数のスレッドから同時にアクセスできる演算結果テーブル
+//
+// 各セルはバージョン番号(mStamp)を持ち，書き込み中は奇数になる．
+// - put() はバージョン番号を CAS で奇数にできた時だけ書き込む．
+//   他のスレッドが書き込み中の場合には何もしない(結果は失われる)．
+// - get() は読み出しの前後でバージョン番号を比べ，
+//   書き込みと重なった場合にはミスとして扱う．
+// ロックを一切用いないかわりに，登録した結果が失われることがある．
+// 演算の種類もキーに含めるので，一つのテーブルを全ての演算で共有する．
+// テーブルサイズの変更や sweep() は並列演算を行っていない時にしか
+// 呼ばれない．
+//////////////////////////////////////////////////////////////////////
+class BmpCompTbl :
+  public BmcCompTbl
+{
+  friend class BddMgrParallel;
+
+  struct Cell {
+    // バージョン番号
+    volatile ymuint32 mStamp;
+    // 演算の種類
+    ymuint32 mOp;
+    tBddEdge mKey1;
+    tBddEdge mKey2;
+    tBddEdge mKey3;
+    tBddEdge mAns;
+  };
+
+public:
+
+  // op, id1, id2, id3 をキーとして検索を行なう．
+  // 見つからなかった場合には kEdgeInvalid を返す．
+  tBddEdge
+  get(ymuint32 op,
+      tBddEdge id1,
+      tBddEdge id2,
+      tBddEdge id3 = kEdgeInvalid);
+
+  // 結果を登録する．
+  void
+  put(ymuint32 op,
+      tBddEdge id1,
+      tBddEdge id2,
+      tBddEdge id3,
+      tBddEdge ans);
+
+
+private:
+
+  // コンストラクタ
+  BmpCompTbl(BddMgrClassic* mgr,
+	     const char* name = 0);
+
+  // デストラクタ
+  virtual
+  ~BmpCompTbl();
+
+  // ハッシュ関数
+  size_t
+  hash_func(ymuint32 op,
+	    tBddEdge id1,
+	    tBddEdge id2,
+	    tBddEdge id3);
+
+  // 節点数に応じてテーブルサイズを調整する．
+  // 並列演算を行っていない時にしか呼んではいけない．
+  void
+  adjust(size_t node_num);
+
+  // テーブルサイズを変更する．
+  // 内容は捨てられる．
+  void
+  resize(size_t new_size);
+
+  // ガーベージコレクションが起きた時の処理を行なう．
+  virtual
+  void
+  sweep();
+
+  // 内容をクリアする．
+  virtual
+  void
+  clear();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  Cell* mTable;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// ハッシュ関数
+inline
+size_t
+BmpCompTbl::hash_func(ymuint32 op,
+		      tBddEdge id1,
+		      tBddEdge id2,
+		      tBddEdge id3)
+{
+  size_t h = id1 + (id2 >> 2) + (id3 << 3) - id3 + op * 0x9e3779b1UL;
+  return (h ^ (h >> 12)) & mTableSize_1;
+}
+
+// op, id1, id2, id3 をキーとして検索を行なう．
+inline
+tBddEdge
+BmpCompTbl::get(ymuint32 op,
+		tBddEdge id1,
+		tBddEdge id2,
+		tBddEdge id3)
+{
+  Cell* cell = mTable + hash_func(op, id1, id2, id3);
+  ymuint32 stamp = cell->mStamp;
+  if ( stamp & 1U ) {
+    // 書き込み中
+    return kEdgeInvalid;
+  }
+  __sync_synchronize();
+  bool hit = ( cell->mOp == op &&
+	       cell->mKey1 == id1 &&
+	       cell->mKey2 == id2 &&
+	       cell->mKey3 == id3 );
+  tBddEdge ans = cell->mAns;
+  __sync_synchronize();
+  if ( !hit || cell->mStamp != stamp ) {
+    return kEdgeInvalid;
+  }
+  return ans;
+}
+
+// 結果を登録する．
+inline
+void
+BmpCompTbl::put(ymuint32 op,
+		tBddEdge id1,
+		tBddEdge id2,
+		tBddEdge id3,
+		tBddEdge ans)
+{
+  if ( check_invalid(ans) ) {
+    // オーバーフローした結果は登録しない．
+    return;
+  }
+  Cell* cell = mTable + hash_func(op, id1, id2, id3);
+  ymuint32 stamp = cell->mStamp;
+  if ( (stamp & 1U) ||
+       !__sync_bool_compare_and_swap(&cell->mStamp, stamp, stamp + 1) ) {
+    // 他のスレッドが書き込んでいる．
+    return;
+  }
+  if ( cell->mKey1 == kEdgeInvalid ) {
+    __sync_fetch_and_add(&mUsedNum, 1);
+  }
+  cell->mOp = op;
+  cell->mKey1 = id1;
+  cell->mKey2 = id2;
+  cell->mKey3 = id3;
+  cell->mAns = ans;
+  __sync_synchronize();
+  cell->mStamp = stamp + 2;
+}
+
+END_NAMESPACE_YM_BDD
+
+#endif // LIBYM_BDD_BMP_BMPCOMPTBL_H
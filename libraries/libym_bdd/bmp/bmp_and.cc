@@ -0,0 +1,188 @@
+
+/// @file libym_bdd/bmp/bmp_and.cc
+/// @brief 並列版の AND/XOR 演算を行う関数の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#if HAVE_CONFIG_H
+#include <ymconfig.h>
+#endif
+
+#include "BddMgrParallel.h"
+#include "BmpCompTbl.h"
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+// 2つのBDDのANDを計算するapply演算
+// or_op() もこれを呼び出す．
+tBddEdge
+BddMgrParallel::and_op(tBddEdge f,
+		       tBddEdge g)
+{
+  return run(kOpAnd, f, g, kEdgeInvalid);
+}
+
+// 2つのBDDのXORを計算するapply演算
+tBddEdge
+BddMgrParallel::xor_op(tBddEdge f,
+		       tBddEdge g)
+{
+  return run(kOpXor, f, g, kEdgeInvalid);
+}
+
+// and_op() の本体
+// 処理の内容は BddMgrClassic::and_op() と同一
+tBddEdge
+BddMgrParallel::and_step(Worker& w,
+			 tBddEdge f,
+			 tBddEdge g,
+			 ymuint depth)
+{
+  // エラー状態のチェック
+  if ( check_error(f) || check_error(g) ) {
+    // どちらかがエラー
+    return kEdgeError;
+  }
+  if ( check_overflow(f) || check_overflow(g) ) {
+    // どちらかがオーバーフロー
+    return kEdgeOverflow;
+  }
+
+  // 特別な場合の処理
+  if ( check_zero(f) || check_zero(g) || check_reverse(f, g) ) {
+    return kEdge0;
+  }
+  if ( check_one(f) ) {
+    return g;
+  }
+  if ( check_one(g) || f == g ) {
+    return f;
+  }
+  // この時点で f,g は終端ではない．
+
+  // 演算結果テーブルが当たりやすくなるように順序を正規化する
+  if ( f > g ) {
+    tBddEdge tmp = f;
+    f = g;
+    g = tmp;
+  }
+
+  tBddEdge result = mCompTbl->get(kOpAnd, f, g);
+  if ( result == kEdgeInvalid ) {
+    tBddEdge f_0, f_1;
+    tBddEdge g_0, g_1;
+    Var* var = split(f, g, f_0, f_1, g_0, g_1);
+    // 1枝側の計算は他のスレッドに任せられるようにしておく．
+    int slot = -1;
+    if ( depth < mSpawnDepth ) {
+      slot = spawn(w, kOpAnd, f_1, g_1, kEdgeInvalid, depth + 1);
+    }
+    tBddEdge r_0 = and_step(w, f_0, g_0, depth + 1);
+    tBddEdge r_1 = ( slot >= 0 ) ? sync(w, slot)
+                                 : and_step(w, f_1, g_1, depth + 1);
+    result = new_node_mt(w, var, r_0, r_1);
+    mCompTbl->put(kOpAnd, f, g, kEdgeInvalid, result);
+  }
+
+  return result;
+}
+
+// or_op() の本体
+tBddEdge
+BddMgrParallel::or_step(Worker& w,
+			tBddEdge f,
+			tBddEdge g,
+			ymuint depth)
+{
+  // エラー状態のチェック
+  if ( check_error(f) || check_error(g) ) {
+    // どちらかがエラー
+    return kEdgeError;
+  }
+  if ( check_overflow(f) || check_overflow(g) ) {
+    // どちらかがオーバーフロー
+    return kEdgeOverflow;
+  }
+  tBddEdge ans = and_step(w, negate(f), negate(g), depth);
+  return negate_ifvalid(ans);
+}
+
+// xor_op() の本体
+// 処理の内容は BddMgrClassic::xor_op() と同一
+tBddEdge
+BddMgrParallel::xor_step(Worker& w,
+			 tBddEdge f,
+			 tBddEdge g,
+			 ymuint depth)
+{
+  // エラー状態のチェック
+  if ( check_error(f) || check_error(g) ) {
+    // どちらかがエラー
+    return kEdgeError;
+  }
+  if ( check_overflow(f) || check_overflow(g) ) {
+    // どちらかがオーバーフロー
+    return kEdgeOverflow;
+  }
+
+  // 特別な場合の処理
+  if ( check_zero(f) ) {
+    return g;
+  }
+  if ( check_zero(g) ) {
+    return f;
+  }
+  if ( check_one(f) ) {
+    return negate(g);
+  }
+  if ( check_one(g) ) {
+    return negate(f);
+  }
+  if ( f == g ) {
+    return kEdge0;
+  }
+  if ( check_reverse(f, g) ) {
+    return kEdge1;
+  }
+  // この時点で f, g は終端ではない．
+
+  // 極性情報は落してしまう．
+  tPol f_pol = get_pol(f);
+  tPol g_pol = get_pol(g);
+  f = addpol(f, f_pol);
+  g = addpol(g, g_pol);
+  tPol ans_pol = f_pol * g_pol;
+
+  // 対称演算なので正規化する．
+  if ( f > g ) {
+    tBddEdge tmp = f;
+    f = g;
+    g = tmp;
+  }
+
+  tBddEdge result = mCompTbl->get(kOpXor, f, g);
+  if ( result == kEdgeInvalid ) {
+    tBddEdge f_0, f_1;
+    tBddEdge g_0, g_1;
+    Var* var = split(f, g, f_0, f_1, g_0, g_1);
+    int slot = -1;
+    if ( depth < mSpawnDepth ) {
+      slot = spawn(w, kOpXor, f_1, g_1, kEdgeInvalid, depth + 1);
+    }
+    tBddEdge r_0 = xor_step(w, f_0, g_0, depth + 1);
+    tBddEdge r_1 = ( slot >= 0 ) ? sync(w, slot)
+                                 : xor_step(w, f_1, g_1, depth + 1);
+    result = new_node_mt(w, var, r_0, r_1);
+    mCompTbl->put(kOpXor, f, g, kEdgeInvalid, result);
+  }
+
+  return addpol_ifvalid(result, ans_pol);
+}
+
+END_NAMESPACE_YM_BDD
@@ -0,0 +1,148 @@
+
+/// @file libym_bdd/bmp/bmp_ite.cc
+/// @brief 並列版の ITE 演算を行う関数の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#if HAVE_CONFIG_H
+#include <ymconfig.h>
+#endif
+
+#include "BddMgrParallel.h"
+#include "BmpCompTbl.h"
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+// if-then-else 演算を計算する．
+tBddEdge
+BddMgrParallel::ite_op(tBddEdge f,
+		       tBddEdge g,
+		       tBddEdge h)
+{
+  return run(kOpIte, f, g, h);
+}
+
+// ite_op() の本体
+// 処理の内容は BddMgrClassic::ite_op() と同一
+tBddEdge
+BddMgrParallel::ite_step(Worker& w,
+			 tBddEdge f,
+			 tBddEdge g,
+			 tBddEdge h,
+			 ymuint depth)
+{
+  if ( check_error(f) || check_error(g) || check_error(h) ) {
+    return kEdgeError;
+  }
+  if ( check_overflow(f) || check_overflow(g) || check_overflow(h) ) {
+    return kEdgeOverflow;
+  }
+  if ( check_one(f) ) {
+    return g;
+  }
+  if ( check_zero(f) ) {
+    return h;
+  }
+  if ( g == h ) {
+    return g;
+  }
+  if ( check_reverse(g, h) ) {
+    return xor_step(w, f, h, depth);
+  }
+  if ( check_one(g) || f == g ) {
+    // f | h
+    return or_step(w, f, h, depth);
+  }
+  if ( check_zero(g) || check_reverse(f, g) ) {
+    // ~f & h
+    return and_step(w, negate(f), h, depth);
+  }
+  if ( check_one(h) || check_reverse(f, h) ) {
+    // ~f | g
+    return or_step(w, negate(f), g, depth);
+  }
+  if ( check_zero(h) || f == h ) {
+    // f & g
+    return and_step(w, f, g, depth);
+  }
+  // この時点で f, g, h は終端ではない．
+
+  // 演算結果テーブルが当たりやすくなるように順序を正規化する．
+  if ( g > h ) {
+    tBddEdge tmp = g;
+    g = h;
+    h = tmp;
+    // then と else を入れ替えたんだから条件も反転しなければならない．
+    f = negate(f);
+  }
+
+  // さらに g に否定属性を付けないように正規化する．
+  tPol ans_pol = get_pol(g);
+  g = addpol(g, ans_pol);
+  h = addpol(h, ans_pol);
+
+  Node* f_vp = get_node(f);
+  Node* g_vp = get_node(g);
+  Node* h_vp = get_node(h);
+  Var* f_var = f_vp->var();
+  Var* g_var = g_vp->var();
+  Var* h_var = h_vp->var();
+  tLevel f_level = f_var->level();
+  tLevel g_level = g_var->level();
+  tLevel h_level = h_var->level();
+
+  tBddEdge result;
+
+  tPol f_pol = get_pol(f);
+  if ( check_zero(f_vp->edge0(f_pol)) &&
+       check_one(f_vp->edge1(f_pol)) &&
+       f_level < g_level && f_level < h_level ) {
+    result = new_node_mt(w, f_var, h, g);
+  }
+  else if ( check_one(f_vp->edge0(f_pol)) &&
+	    check_zero(f_vp->edge1(f_pol)) &&
+	    f_level < g_level && f_level < h_level ) {
+    result = new_node_mt(w, f_var, g, h);
+  }
+  else {
+    result = mCompTbl->get(kOpIte, f, g, h);
+    if ( result == kEdgeInvalid ) {
+      tPol g_pol = get_pol(g);
+      tPol h_pol = get_pol(h);
+      tLevel top = f_level;
+      Var* var = f_var;
+      if ( top > g_level) {
+	top = g_level;
+	var = g_var;
+      }
+      if ( top > h_level ) {
+	top = h_level;
+	var = h_var;
+      }
+      tBddEdge f_0, f_1;
+      tBddEdge g_0, g_1;
+      tBddEdge h_0, h_1;
+      split1(top, f_level, f, f_vp, f_pol, f_0, f_1);
+      split1(top, g_level, g, g_vp, g_pol, g_0, g_1);
+      split1(top, h_level, h, h_vp, h_pol, h_0, h_1);
+      int slot = -1;
+      if ( depth < mSpawnDepth ) {
+	slot = spawn(w, kOpIte, f_1, g_1, h_1, depth + 1);
+      }
+      tBddEdge r_0 = ite_step(w, f_0, g_0, h_0, depth + 1);
+      tBddEdge r_1 = ( slot >= 0 ) ? sync(w, slot)
+	                           : ite_step(w, f_1, g_1, h_1, depth + 1);
+      result = new_node_mt(w, var, r_0, r_1);
+      mCompTbl->put(kOpIte, f, g, h, result);
+    }
+  }
+  return addpol_ifvalid(result, ans_pol);
+}
+
+END_NAMESPACE_YM_BDD
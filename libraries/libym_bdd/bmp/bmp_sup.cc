@@ -0,0 +1,225 @@
+
+/// @file libym_bdd/bmp/bmp_sup.cc
+/// @brief 並列版の smoothing 演算を行う関数の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#if HAVE_CONFIG_H
+#include <ymconfig.h>
+#endif
+
+#include "BddMgrParallel.h"
+#include "BmpCompTbl.h"
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+// existential quntification(smoothing)
+// svars に含まれる変数を消去する．
+// 消去する変数の集合 e2 も演算結果テーブルのキーに含めるので
+// 演算ごとにテーブルをクリアする必要はない．
+tBddEdge
+BddMgrParallel::esmooth(tBddEdge e1,
+			tBddEdge e2)
+{
+  if ( check_error(e1) || check_error(e2) ) {
+    return kEdgeError;
+  }
+  if ( check_overflow(e1) || check_overflow(e2) ) {
+    return kEdgeOverflow;
+  }
+
+  mark_smooth_vars(e2);
+  tBddEdge ans = run(kOpSm, e1, e2, kEdgeInvalid);
+  clear_varmark();
+  return ans;
+}
+
+// src1 と src2 との論理積を計算しつつスムージングを行う．
+tBddEdge
+BddMgrParallel::and_exist(tBddEdge e1,
+			  tBddEdge e2,
+			  tBddEdge e3)
+{
+  if ( check_error(e1) || check_error(e2) || check_error(e3) ) {
+    return kEdgeError;
+  }
+  if ( check_overflow(e1) || check_overflow(e2) || check_overflow(e3) ) {
+    return kEdgeOverflow;
+  }
+
+  mark_smooth_vars(e3);
+  tBddEdge ans = run(kOpAe, e1, e2, e3);
+  clear_varmark();
+  return ans;
+}
+
+// 消去する変数に印を付ける．
+// 演算中の各スレッドは mMark と mLastLevel を読むだけ．
+void
+BddMgrParallel::mark_smooth_vars(tBddEdge s)
+{
+  clear_varmark();
+  mLastLevel = 0;
+  Node* vp = get_node(s);
+  while ( vp != 0 ) {
+    Var* v = vp->var();
+    mLastLevel = v->level();
+    v->mMark = 1;
+    vp = get_node(vp->edge1());
+  }
+}
+
+// esmooth() の本体
+// s は消去する変数のキューブ
+tBddEdge
+BddMgrParallel::esmooth_step(Worker& w,
+			     tBddEdge e,
+			     tBddEdge s,
+			     ymuint depth)
+{
+  if ( check_leaf(e) ) {
+    return e;
+  }
+
+  Node* vp = get_node(e);
+  Var* var = vp->var();
+  tLevel level = var->level();
+  if ( level > mLastLevel ) {
+    return e;
+  }
+
+  tBddEdge result = mCompTbl->get(kOpSm, e, s);
+  if ( result == kEdgeInvalid ) {
+    tPol pol = get_pol(e);
+    tBddEdge e0 = vp->edge0(pol);
+    tBddEdge e1 = vp->edge1(pol);
+    if ( var->mMark ) {
+      // 消去対象の変数だった．
+      tBddEdge tmp = or_step(w, e0, e1, depth);
+      result = esmooth_step(w, tmp, s, depth);
+    }
+    else {
+      int slot = -1;
+      if ( depth < mSpawnDepth ) {
+	slot = spawn(w, kOpSm, e1, s, kEdgeInvalid, depth + 1);
+      }
+      tBddEdge r_0 = esmooth_step(w, e0, s, depth + 1);
+      tBddEdge r_1 = ( slot >= 0 ) ? sync(w, slot)
+	                           : esmooth_step(w, e1, s, depth + 1);
+      result = new_node_mt(w, var, r_0, r_1);
+    }
+    mCompTbl->put(kOpSm, e, s, kEdgeInvalid, result);
+  }
+
+  return result;
+}
+
+// and_exist() の本体
+// s は消去する変数のキューブ
+tBddEdge
+BddMgrParallel::andexist_step(Worker& w,
+			      tBddEdge f,
+			      tBddEdge g,
+			      tBddEdge s,
+			      ymuint depth)
+{
+  if ( check_error(f) || check_error(g) ) {
+    return kEdgeError;
+  }
+  if ( check_overflow(f) || check_overflow(g) ) {
+    return kEdgeOverflow;
+  }
+  if ( check_zero(f) || check_zero(g) ) {
+    return kEdge0;
+  }
+  if ( check_one(f) && check_one(g) ) {
+    return kEdge1;
+  }
+  if ( check_one(f) ) {
+    return esmooth_step(w, g, s, depth);
+  }
+  if ( check_one(g) ) {
+    return esmooth_step(w, f, s, depth);
+  }
+
+  if ( f > g ) {
+    tBddEdge tmp = f;
+    f = g;
+    g = tmp;
+  }
+
+  Node* f_vp = get_node(f);
+  Node* g_vp = get_node(g);
+  tPol f_pol = get_pol(f);
+  tPol g_pol = get_pol(g);
+  Var* f_var = f_vp->var();
+  Var* g_var = g_vp->var();
+  tLevel f_level = f_var->level();
+  tLevel g_level = g_var->level();
+  tLevel level = f_level;
+  Var* var = f_var;
+  if ( level > g_level ) {
+    level = g_level;
+    var = g_var;
+  }
+  if ( level > mLastLevel ) {
+    return and_step(w, f, g, depth);
+  }
+
+  tBddEdge result = mCompTbl->get(kOpAe, f, g, s);
+  if ( result == kEdgeInvalid ) {
+    tBddEdge f_0, f_1;
+    tBddEdge g_0, g_1;
+    if ( var->mMark ) {
+      if ( f_level > level ) {
+	g_0 = g_vp->edge0(g_pol);
+	g_1 = g_vp->edge1(g_pol);
+	tBddEdge tmp = or_step(w, g_0, g_1, depth);
+	result = andexist_step(w, f, tmp, s, depth);
+      }
+      else if ( g_level > level ) {
+	f_0 = f_vp->edge0(f_pol);
+	f_1 = f_vp->edge1(f_pol);
+	tBddEdge tmp = or_step(w, f_0, f_1, depth);
+	result = andexist_step(w, tmp, g, s, depth);
+      }
+      else {
+	f_0 = f_vp->edge0(f_pol);
+	f_1 = f_vp->edge1(f_pol);
+	g_0 = g_vp->edge0(g_pol);
+	g_1 = g_vp->edge1(g_pol);
+	int slot = -1;
+	if ( depth < mSpawnDepth ) {
+	  slot = spawn(w, kOpAe, f_1, g_1, s, depth + 1);
+	}
+	tBddEdge tmp1 = andexist_step(w, f_0, g_0, s, depth + 1);
+	tBddEdge tmp2 = ( slot >= 0 ) ? sync(w, slot)
+	                              : andexist_step(w, f_1, g_1, s, depth + 1);
+	result = or_step(w, tmp1, tmp2, depth);
+      }
+    }
+    else {
+      split1(level, f_level, f, f_vp, f_pol, f_0, f_1);
+      split1(level, g_level, g, g_vp, g_pol, g_0, g_1);
+      int slot = -1;
+      if ( depth < mSpawnDepth ) {
+	slot = spawn(w, kOpAe, f_1, g_1, s, depth + 1);
+      }
+      tBddEdge r_0 = andexist_step(w, f_0, g_0, s, depth + 1);
+      tBddEdge r_1 = ( slot >= 0 ) ? sync(w, slot)
+	                           : andexist_step(w, f_1, g_1, s, depth + 1);
+      result = new_node_mt(w, var, r_0, r_1);
+    }
+    mCompTbl->put(kOpAe, f, g, s, result);
+  }
+
+  return result;
+}
+
+END_NAMESPACE_YM_BDD
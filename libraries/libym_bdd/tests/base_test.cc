@@ -15,6 +15,8 @@
 
 #include <ym_bdd/BmcFactory.h>
 #include <ym_bdd/BmmFactory.h>
+#include <ym_bdd/BmpFactory.h>
+#include <ym_bdd/Zdd.h>
 
 #include "bddtest.h"
 
@@ -313,6 +315,51 @@ test_and_exist(BddMgrRef mgr)
     return false;
   }
 
+  // ランダムに作った関数で (f & g).esmooth(s) と比較する．
+  // 最上位の変数が f と g で異なる場合も含まれる．
+  const ymuint nv = 10;
+  const ymuint nf = 64;
+  const ymuint ncase = 2000;
+  BddVector flist;
+  for (ymuint i = 0; i < nv; ++ i) {
+    flist.push_back(mgr.make_posiliteral(i));
+  }
+  ymuint32 seed = 1;
+  while ( flist.size() < nf ) {
+    seed = seed * 1103515245U + 12345U;
+    ymuint r = seed >> 8;
+    const Bdd& a = flist[r % flist.size()];
+    const Bdd& b = flist[(r >> 8) % flist.size()];
+    switch ( (r >> 16) % 3 ) {
+    case 0: flist.push_back(a & ~b); break;
+    case 1: flist.push_back(a | b); break;
+    case 2: flist.push_back(a ^ b); break;
+    }
+  }
+  for (ymuint c = 0; c < ncase; ++ c) {
+    seed = seed * 1103515245U + 12345U;
+    ymuint r = seed >> 8;
+    const Bdd& f = flist[r % nf];
+    const Bdd& g = flist[(r >> 6) % nf];
+    VarList svl;
+    ymuint ns = (r >> 12) % 3 + 1;
+    for (ymuint i = 0; i < ns; ++ i) {
+      svl.push_back((r >> (14 + i * 3)) % nv);
+    }
+    BddVarSet svars(mgr, svl);
+    Bdd ans1 = and_exist(f, g, svars);
+    Bdd ans2 = (f & g).esmooth(svars);
+    if ( ans1 != ans2 ) {
+      cout << "ERROR[test_and_exist]: case " << c << endl;
+      f.display(cout);
+      g.display(cout);
+      svars.function().display(cout);
+      ans1.display(cout);
+      ans2.display(cout);
+      return false;
+    }
+  }
+
   return true;
 }
 
@@ -542,6 +589,432 @@ test_dump(BddMgrRef mgr)
   return true;
 }
 
+// bin_dump/bin_restore のテスト
+bool
+test_bin_dump(BddMgrRef mgr)
+{
+  BddVector src(5);
+  src[0] = str2bdd(mgr, "0 & 2 | 1 & 3 | ~1 & ~3");
+  src[1] = ~src[0];
+  src[2] = str2bdd(mgr, "0 ^ 4 ^ 5 | 6 & 7 & ~8");
+  src[3] = mgr.make_zero();
+  src[4] = mgr.make_one();
+  const char* fn = "/tmp/magus_bdd_base_test.bin";
+  for (int compress = 0; compress < 2; ++ compress) {
+    {
+      ofstream ofs(fn, ios::out | ios::binary);
+      if ( !ofs ) {
+	cout << "cannot open output file: " << fn << endl;
+	return false;
+      }
+      bin_dump(src, ofs, compress != 0);
+    }
+    BddVector dst1;
+    {
+      ifstream ifs(fn, ios::in | ios::binary);
+      if ( !ifs ) {
+	cout << "cannont open input file: " << fn << endl;
+	return false;
+      }
+      mgr.bin_restore(ifs, dst1);
+    }
+    // ファイル名を指定した場合は mmap で読み込む．
+    BddVector dst2;
+    mgr.bin_restore(string(fn), dst2);
+    if ( dst1 != src || dst2 != src ) {
+      cout << "ERROR[test_bin_dump]: compress = " << compress << endl;
+      return false;
+    }
+  }
+  {
+    ofstream ofs(fn, ios::out | ios::binary);
+    src[2].bin_dump(ofs);
+  }
+  ifstream ifs(fn, ios::in | ios::binary);
+  Bdd bdd = mgr.bin_restore(ifs);
+  if ( bdd != src[2] ) {
+    cout << "ERROR[test_bin_dump]: single BDD" << endl;
+    return false;
+  }
+  return true;
+}
+
+// reorder のテスト
+// 変数順を変えても関数は変わらず，ノード数も増えないことを確かめる．
+bool
+test_reorder(BddMgrRef mgr)
+{
+  const char* str_list[] = {
+    "0 & 5 | 1 & 6 | 2 & 7 | 3 & 8 | 4 & 9",
+    "0 & 2 | ~0 & 1 & ~2",
+    "(0 ^ 1 ^ 2) & 3 | 4 & 6",
+    NULL
+  };
+  BddVector bdd_list;
+  for (ymuint i = 0; str_list[i]; ++ i) {
+    bdd_list.push_back(str2bdd(mgr, str_list[i]));
+  }
+  size_t size0 = size(bdd_list);
+
+  mgr.reorder();
+
+  size_t size1 = size(bdd_list);
+  if ( size1 > size0 ) {
+    cout << "ERROR[test_reorder]: size increased "
+	 << size0 << " -> " << size1 << endl;
+    return false;
+  }
+  for (ymuint i = 0; str_list[i]; ++ i) {
+    Bdd bdd = str2bdd(mgr, str_list[i]);
+    if ( bdd != bdd_list[i] ) {
+      cout << "ERROR[test_reorder]: " << str_list[i] << endl;
+      bdd.display(cout);
+      bdd_list[i].display(cout);
+      return false;
+    }
+  }
+  return true;
+}
+
+// 自動的な動的変数順変更のテスト
+// 悪い変数順では 2^(n+1) - 2 個のノードを要する関数を作り，
+// 途中で自動的に変数順が変更されることと，明示的な reorder() で
+// 最適な 2n 個まで減ることを確かめる．
+bool
+test_dvo(BddMgrRef mgr)
+{
+  const ymuint n = 12;
+  const tVarId base = 20;
+  for (ymuint i = 0; i < n * 2; ++ i) {
+    mgr.new_var(base + i);
+  }
+
+  mgr.enable_DVO();
+  Bdd bdd = mgr.make_zero();
+  for (ymuint i = 0; i < n; ++ i) {
+    Bdd x = mgr.make_posiliteral(base + i);
+    Bdd y = mgr.make_posiliteral(base + i + n);
+    bdd |= x & y;
+  }
+  mgr.disable_DVO();
+  if ( bdd.size() >= (1U << (n + 1)) - 2 ) {
+    cout << "ERROR[test_dvo]: not reordered, size = " << bdd.size() << endl;
+    return false;
+  }
+
+  mgr.reorder();
+  if ( bdd.size() != n * 2 ) {
+    cout << "ERROR[test_dvo]: size = " << bdd.size() << endl;
+    return false;
+  }
+
+  Bdd bdd2 = mgr.make_zero();
+  for (ymuint i = 0; i < n; ++ i) {
+    Bdd x = mgr.make_posiliteral(base + i);
+    Bdd y = mgr.make_posiliteral(base + i + n);
+    bdd2 |= x & y;
+  }
+  if ( bdd != bdd2 ) {
+    cout << "ERROR[test_dvo]: function changed" << endl;
+    return false;
+  }
+  return true;
+}
+
+// BddMgrParallel のテスト
+// 同じ演算の列を BddMgrClassic と BddMgrParallel で行い，
+// 結果の BDD の構造が一致することを確かめる．
+bool
+test_parallel(BddMgrRef pmgr)
+{
+  BddMgrRef cmgr(BmcFactory("reference mgr"));
+
+  const ymuint nv = 16;
+  const ymuint nf = 32;
+  const ymuint nstep = 400;
+  BddVector plist;
+  BddVector clist;
+  for (ymuint i = 0; i < nv; ++ i) {
+    plist.push_back(pmgr.make_posiliteral(i));
+    clist.push_back(cmgr.make_posiliteral(i));
+  }
+
+  ymuint32 seed = 1;
+  for (ymuint step = 0; step < nstep; ++ step) {
+    ymuint r[4];
+    for (ymuint j = 0; j < 4; ++ j) {
+      seed = seed * 1103515245U + 12345U;
+      r[j] = (seed >> 8);
+    }
+    ymuint n = plist.size();
+    ymuint a = r[1] % n;
+    ymuint b = r[2] % n;
+    ymuint c = r[3] % n;
+    VarList vl;
+    vl.push_back(r[2] % nv);
+    vl.push_back(r[3] % nv);
+    Bdd pans;
+    Bdd cans;
+    switch ( r[0] % 6 ) {
+    case 0:
+      pans = plist[a] & plist[b];
+      cans = clist[a] & clist[b];
+      break;
+    case 1:
+      pans = plist[a] | ~plist[b];
+      cans = clist[a] | ~clist[b];
+      break;
+    case 2:
+      pans = plist[a] ^ plist[b];
+      cans = clist[a] ^ clist[b];
+      break;
+    case 3:
+      pans = ite_op(plist[a], plist[b], plist[c]);
+      cans = ite_op(clist[a], clist[b], clist[c]);
+      break;
+    case 4:
+      pans = plist[a].esmooth(BddVarSet(pmgr, vl));
+      cans = clist[a].esmooth(BddVarSet(cmgr, vl));
+      break;
+    case 5:
+      pans = and_exist(plist[a], plist[b], BddVarSet(pmgr, vl));
+      cans = and_exist(clist[a], clist[b], BddVarSet(cmgr, vl));
+      break;
+    }
+    ostringstream pbuf;
+    ostringstream cbuf;
+    pans.dump(pbuf);
+    cans.dump(cbuf);
+    if ( pbuf.str() != cbuf.str() ) {
+      cout << "ERROR[test_parallel]: step " << step << endl;
+      pans.display(cout);
+      cans.display(cout);
+      return false;
+    }
+    if ( plist.size() < nv + nf ) {
+      plist.push_back(pans);
+      clist.push_back(cans);
+    }
+    else {
+      ymuint pos = nv + r[3] % nf;
+      plist[pos] = pans;
+      clist[pos] = cans;
+    }
+  }
+  return true;
+}
+
+// 集合族をビットベクタで表したものから BDD(特性関数)を作る．
+// 変数は 0 から 5 までの 6 個で，要素となる集合もビットベクタで表す．
+Bdd
+zdd_test_func(BddMgrRef mgr,
+	      ymuint64 family)
+{
+  Bdd ans = mgr.make_zero();
+  for (ymuint s = 0; s < 64; ++ s) {
+    if ( (family >> s) & 1 ) {
+      Bdd cube = mgr.make_one();
+      for (ymuint i = 0; i < 6; ++ i) {
+	if ( (s >> i) & 1 ) {
+	  cube &= mgr.make_posiliteral(i);
+	}
+	else {
+	  cube &= mgr.make_negaliteral(i);
+	}
+      }
+      ans |= cube;
+    }
+  }
+  return ans;
+}
+
+// 積 { a ∪ b } をビットベクタ上で計算する．
+ymuint64
+zdd_test_product(ymuint64 f,
+		 ymuint64 g)
+{
+  ymuint64 ans = 0;
+  for (ymuint a = 0; a < 64; ++ a) {
+    if ( ((f >> a) & 1) == 0 ) continue;
+    for (ymuint b = 0; b < 64; ++ b) {
+      if ( (g >> b) & 1 ) {
+	ans |= (1ULL << (a | b));
+      }
+    }
+  }
+  return ans;
+}
+
+// 商 { q | ∀g ∈ G, q ∩ g = ∅, q ∪ g ∈ F } をビットベクタ上で計算する．
+ymuint64
+zdd_test_quotient(ymuint64 f,
+		  ymuint64 g)
+{
+  ymuint64 ans = 0;
+  for (ymuint q = 0; q < 64; ++ q) {
+    bool ok = true;
+    for (ymuint b = 0; b < 64 && ok; ++ b) {
+      if ( (g >> b) & 1 ) {
+	if ( (q & b) != 0 || ((f >> (q | b)) & 1) == 0 ) {
+	  ok = false;
+	}
+      }
+    }
+    if ( ok ) {
+      ans |= (1ULL << q);
+    }
+  }
+  return ans;
+}
+
+// ビットベクタ中の 1 の数を数える．
+ymuint
+zdd_test_count(ymuint64 f)
+{
+  ymuint n = 0;
+  for ( ; f; f &= (f - 1)) {
+    ++ n;
+  }
+  return n;
+}
+
+// ZDD の演算のテスト
+// ビットベクタで表した集合族の演算結果と比較する．
+bool
+test_zdd(BddMgrRef mgr)
+{
+  const ymuint nv = 6;
+  VarList vl;
+  for (ymuint i = 0; i < nv; ++ i) {
+    vl.push_back(i);
+  }
+  BddVarSet vars(mgr, vl);
+
+  if ( !Zdd::make_empty(mgr).is_empty() ||
+       !Zdd::make_base(mgr).is_base() ||
+       Zdd(mgr, 0).count() != 1 ) {
+    cout << "ERROR[test_zdd]: constant" << endl;
+    return false;
+  }
+
+  ymuint64 seed = 1;
+  for (ymuint step = 0; step < 200; ++ step) {
+    ymuint64 r[2];
+    for (ymuint j = 0; j < 2; ++ j) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      r[j] = seed;
+    }
+    // 積と商のテスト用に要素数の少ない集合族も作る．
+    ymuint64 f = r[0];
+    ymuint64 g = (step & 1) ? r[1] : (r[1] & (r[1] >> 13) & (r[1] >> 29));
+    Bdd fbdd = zdd_test_func(mgr, f);
+    Bdd gbdd = zdd_test_func(mgr, g);
+    Zdd fz(fbdd, vars);
+    Zdd gz(gbdd, vars);
+
+    if ( fz.to_bdd(vars) != fbdd ) {
+      cout << "ERROR[test_zdd]: to_bdd, step " << step << endl;
+      return false;
+    }
+    if ( fz.count() != zdd_test_count(f) ) {
+      cout << "ERROR[test_zdd]: count, step " << step << endl;
+      return false;
+    }
+    if ( (fz | gz) != Zdd(zdd_test_func(mgr, f | g), vars) ||
+	 (fz & gz) != Zdd(zdd_test_func(mgr, f & g), vars) ||
+	 (fz - gz) != Zdd(zdd_test_func(mgr, f & ~g), vars) ) {
+      cout << "ERROR[test_zdd]: set operation, step " << step << endl;
+      return false;
+    }
+    if ( (fz * gz) != Zdd(zdd_test_func(mgr, zdd_test_product(f, g)), vars) ) {
+      cout << "ERROR[test_zdd]: product, step " << step << endl;
+      return false;
+    }
+    if ( g != 0 ) {
+      ymuint64 q = zdd_test_quotient(f, g);
+      ymuint64 rem = f & ~zdd_test_product(q, g);
+      if ( (fz / gz) != Zdd(zdd_test_func(mgr, q), vars) ||
+	   (fz % gz) != Zdd(zdd_test_func(mgr, rem), vars) ) {
+	cout << "ERROR[test_zdd]: quotient, step " << step << endl;
+	return false;
+      }
+    }
+
+    tVarId v = step % nv;
+    ymuint64 f0 = 0;
+    ymuint64 f1 = 0;
+    ymuint64 fc = 0;
+    for (ymuint s = 0; s < 64; ++ s) {
+      if ( ((f >> s) & 1) == 0 ) continue;
+      ymuint t = s & ~(1U << v);
+      if ( (s >> v) & 1 ) {
+	f1 |= (1ULL << t);
+      }
+      else {
+	f0 |= (1ULL << s);
+      }
+      fc |= (1ULL << (s ^ (1U << v)));
+    }
+    if ( fz.subset0(v) != Zdd(zdd_test_func(mgr, f0), vars) ||
+	 fz.subset1(v) != Zdd(zdd_test_func(mgr, f1), vars) ||
+	 fz.change(v) != Zdd(zdd_test_func(mgr, fc), vars) ) {
+      cout << "ERROR[test_zdd]: subset/change, step " << step << endl;
+      return false;
+    }
+
+    // isop のテスト
+    // キューブの数と各キューブが含まれていることを LogExpr 版と比較する．
+    Bdd lower = fbdd & gbdd;
+    Bdd upper = fbdd | gbdd;
+    LogExpr expr;
+    Bdd ebdd = isop(lower, upper, expr);
+    Zdd cover;
+    Bdd zbdd = isop(lower, upper, cover);
+    if ( zbdd != ebdd ) {
+      cout << "ERROR[test_zdd]: isop, step " << step << endl;
+      return false;
+    }
+    vector<LogExpr> cubes;
+    if ( expr.is_or() ) {
+      for (size_t i = 0; i < expr.child_num(); ++ i) {
+	cubes.push_back(expr.child(i));
+      }
+    }
+    else if ( !expr.is_zero() ) {
+      cubes.push_back(expr);
+    }
+    if ( cover.count() != cubes.size() ) {
+      cout << "ERROR[test_zdd]: isop cover size, step " << step << endl;
+      return false;
+    }
+    for (vector<LogExpr>::iterator p = cubes.begin(); p != cubes.end(); ++ p) {
+      LogExpr cube = *p;
+      vector<LogExpr> lits;
+      if ( cube.is_and() ) {
+	for (size_t i = 0; i < cube.child_num(); ++ i) {
+	  lits.push_back(cube.child(i));
+	}
+      }
+      else if ( cube.is_literal() ) {
+	lits.push_back(cube);
+      }
+      Zdd zcube = Zdd::make_base(mgr);
+      for (vector<LogExpr>::iterator q = lits.begin(); q != lits.end(); ++ q) {
+	tVarId zv = q->varid() * 2;
+	if ( q->is_negaliteral() ) {
+	  ++ zv;
+	}
+	zcube *= Zdd(mgr, zv);
+      }
+      if ( (zcube & cover) != zcube ) {
+	cout << "ERROR[test_zdd]: isop cover, step " << step << endl;
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
 bool
 test(BddMgrRef mgr)
 {
@@ -564,7 +1037,9 @@ test(BddMgrRef mgr)
     test_scc(mgr) &&
     test_minterm_count(mgr) &&
     test_symmetry(mgr) &&
-    test_dump(mgr)
+    test_dump(mgr) &&
+    test_bin_dump(mgr) &&
+    test_reorder(mgr)
     ;
 }
 
@@ -580,12 +1055,16 @@ main(int argc,
   using nsYm::nsBdd::BddMgrRef;
   using nsYm::nsBdd::BmmFactory;
   using nsYm::nsBdd::BmcFactory;
+  using nsYm::nsBdd::BmpFactory;
 
   try {
     BddMgrRef mgr1(BmcFactory("classic mgr"));
     if ( !test(mgr1) ) {
       return 1;
     }
+    if ( !test_zdd(mgr1) ) {
+      return 7;
+    }
     BddMgrRef mgr2(BmmFactory(false, "fixed order mgr"));
     if ( !test(mgr2) ) {
       return 2;
@@ -594,6 +1073,19 @@ main(int argc,
     if ( !test(mgr3) ) {
       return 3;
     }
+    if ( !test_dvo(mgr3) ) {
+      return 4;
+    }
+    BddMgrRef mgr4(BmpFactory(4, "parallel mgr"));
+    if ( !test(mgr4) ) {
+      return 5;
+    }
+    if ( !test_parallel(mgr4) ) {
+      return 6;
+    }
+    if ( !test_zdd(mgr4) ) {
+      return 8;
+    }
   }
   catch ( AssertError a ) {
     cerr << a << endl;
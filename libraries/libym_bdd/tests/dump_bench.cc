@@ -0,0 +1,180 @@
+
+/// @file libym_bdd/tests/dump_bench.cc
+/// @brief dump/restore と bin_dump/bin_restore の速度比較
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#if HAVE_CONFIG_H
+#include <ymconfig.h>
+#endif
+
+#include <ym_bdd/BmcFactory.h>
+#include <ym_utils/StopWatch.h>
+
+#include "bddtest.h"
+
+#include <sys/stat.h>
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+BEGIN_NONAMESPACE
+
+// ファイルの大きさを返す．
+size_t
+file_size(const char* filename)
+{
+  struct stat sbuf;
+  if ( stat(filename, &sbuf) < 0 ) {
+    return 0;
+  }
+  return sbuf.st_size;
+}
+
+// 結果を出力する．
+void
+print_result(const char* title,
+	     const char* filename,
+	     const USTime& dump_time,
+	     const USTime& restore_time)
+{
+  cout << title << endl
+       << "  size:    " << file_size(filename) << " bytes" << endl
+       << "  dump:    " << dump_time << endl
+       << "  restore: " << restore_time << endl;
+}
+
+END_NONAMESPACE
+
+// (x_0 & x_n) | (x_1 & x_(n+1)) | ... を悪い変数順で作る．
+// 節点数は 2^(n+1) 程度になる．
+Bdd
+make_bench_bdd(BddMgrRef mgr,
+	       ymuint n)
+{
+  Bdd ans = mgr.make_zero();
+  for (ymuint i = 0; i < n; ++ i) {
+    ans |= mgr.make_posiliteral(i) & mgr.make_posiliteral(i + n);
+  }
+  return ans;
+}
+
+// テキスト形式の dump/restore の時間を測る．
+bool
+bench_text(const Bdd& bdd,
+	   const char* filename)
+{
+  StopWatch dump_timer;
+  dump_timer.start();
+  {
+    ofstream ofs(filename);
+    if ( !ofs ) {
+      cerr << filename << ": cannot open" << endl;
+      return false;
+    }
+    bdd.dump(ofs);
+  }
+  dump_timer.stop();
+
+  BddMgrRef mgr(BmcFactory("restore manager"));
+  StopWatch restore_timer;
+  restore_timer.start();
+  Bdd bdd2;
+  {
+    ifstream ifs(filename);
+    bdd2 = mgr.restore(ifs);
+  }
+  restore_timer.stop();
+  if ( bdd2.size() != bdd.size() ) {
+    cerr << "ERROR: restored BDD differs" << endl;
+    return false;
+  }
+  print_result("text", filename, dump_timer.time(), restore_timer.time());
+  return true;
+}
+
+// バイナリ形式の bin_dump/bin_restore の時間を測る．
+// use_mmap が true の時はファイル名を指定して読み込む．
+bool
+bench_bin(const Bdd& bdd,
+	  const char* filename,
+	  bool compress,
+	  bool use_mmap)
+{
+  StopWatch dump_timer;
+  dump_timer.start();
+  {
+    ofstream ofs(filename, ios::out | ios::binary);
+    if ( !ofs ) {
+      cerr << filename << ": cannot open" << endl;
+      return false;
+    }
+    bdd.bin_dump(ofs, compress);
+  }
+  dump_timer.stop();
+
+  BddMgrRef mgr(BmcFactory("restore manager"));
+  StopWatch restore_timer;
+  restore_timer.start();
+  Bdd bdd2;
+  if ( use_mmap ) {
+    BddVector tmp;
+    mgr.bin_restore(string(filename), tmp);
+    if ( tmp.size() == 1 ) {
+      bdd2 = tmp[0];
+    }
+  }
+  else {
+    ifstream ifs(filename, ios::in | ios::binary);
+    bdd2 = mgr.bin_restore(ifs);
+  }
+  restore_timer.stop();
+  if ( bdd2.size() != bdd.size() ) {
+    cerr << "ERROR: restored BDD differs" << endl;
+    return false;
+  }
+  const char* title = NULL;
+  if ( compress ) {
+    title = use_mmap ? "binary(compressed, file)" : "binary(compressed)";
+  }
+  else {
+    title = use_mmap ? "binary(mmap)" : "binary";
+  }
+  print_result(title, filename, dump_timer.time(), restore_timer.time());
+  return true;
+}
+
+END_NAMESPACE_YM_BDD
+
+
+int
+main(int argc,
+     char** argv)
+{
+  using namespace std;
+  using namespace nsYm::nsBdd;
+
+  ymuint n = 16;
+  if ( argc > 1 ) {
+    n = atoi(argv[1]);
+  }
+  const char* filename = "/tmp/magus_bdd_dump_bench";
+
+  BddMgrRef mgr(BmcFactory("bench manager"));
+  Bdd bdd = make_bench_bdd(mgr, n);
+  cout << "n = " << n << ", " << bdd.size() << " nodes" << endl;
+
+  if ( !bench_text(bdd, filename) ||
+       !bench_bin(bdd, filename, false, false) ||
+       !bench_bin(bdd, filename, false, true) ||
+       !bench_bin(bdd, filename, true, false) ||
+       !bench_bin(bdd, filename, true, true) ) {
+    return 1;
+  }
+  return 0;
+}
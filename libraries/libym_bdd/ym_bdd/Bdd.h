@@ -181,6 +181,7 @@ class Bdd
 {
   friend class BddMgrRef;
   friend class DgMgr;
+  friend class Zdd;
 
 public:
 
@@ -484,6 +485,14 @@ public:
   void
   dump(ostream& s) const;
 
+  /// @brief 内容をバイナリ形式でダンプする．
+  /// @param[in] s 出力ストリーム
+  /// @param[in] compress true の時には圧縮する．
+  /// @note s はバイナリモードで開いておくこと．
+  void
+  bin_dump(ostream& s,
+	   bool compress = false) const;
+
   /// @brief BDD が使っているノード数を数える．
   /// @return BDD が使っているノード数
   size_t
@@ -648,6 +657,12 @@ public:
        const Bdd& upper,
        LogExpr& cover);
 
+  friend
+  Bdd
+  isop(const Bdd& lower,
+       const Bdd& upper,
+       Zdd& cover);
+
   friend
   LogExpr
   prime_cover(const Bdd& lower,
@@ -678,6 +693,18 @@ public:
   dump(const BddList& array,
        ostream& s);
 
+  friend
+  void
+  bin_dump(const BddVector& array,
+	   ostream& s,
+	   bool compress);
+
+  friend
+  void
+  bin_dump(const BddList& array,
+	   ostream& s,
+	   bool compress);
+
   friend
   size_t
   size(const BddVector& array);
@@ -886,6 +913,7 @@ class BddMgrRef
 {
   friend class Bdd;
   friend class DgMgr;
+  friend class Zdd;
 public:
   //////////////////////////////////////////////////////////////////////
   // コンストラクタとデストラクタ
@@ -1131,6 +1159,34 @@ public:
   restore(istream& s,
 	  BddList& array);
 
+  /// @brief バイナリ形式で保存されたBDDを読み込む．
+  /// @param[in] s 入力ストリーム
+  /// @return 生成された BDD
+  Bdd
+  bin_restore(istream& s);
+
+  /// @brief バイナリ形式で保存されたBDDをベクタに読み込む．
+  /// @param[in] s 入力ストリーム
+  /// @param[out] array 生成された BDD を格納するベクタ
+  void
+  bin_restore(istream& s,
+	      BddVector& array);
+
+  /// @brief バイナリ形式で保存されたBDDをリストに読み込む．
+  /// @param[in] s 入力ストリーム
+  /// @param[out] array 生成された BDD を格納するリスト
+  void
+  bin_restore(istream& s,
+	      BddList& array);
+
+  /// @brief バイナリ形式で保存されたBDDをファイルから読み込む．
+  /// @param[in] filename ファイル名
+  /// @param[out] array 生成された BDD を格納するベクタ
+  /// @note 圧縮されていなければファイルを mmap して読み込む．
+  void
+  bin_restore(const string& filename,
+	      BddVector& array);
+
   /// @}
   //////////////////////////////////////////////////////////////////////
 
@@ -1178,6 +1234,12 @@ public:
   void
   disable_DVO();
 
+  /// @brief 変数順の最適化(sifting)を明示的に行う．
+  /// @note BddMgr の実装によっては動的変数順の変更をサポートして
+  /// いない場合がある
+  void
+  reorder();
+
   /// @}
   //////////////////////////////////////////////////////////////////////
 
@@ -1398,6 +1460,18 @@ void
 dump(const BddList& array,
      ostream& s);
 
+// BDDの配列の内容をバイナリ形式で書き出す
+void
+bin_dump(const BddVector& array,
+	 ostream& s,
+	 bool compress = false);
+
+// BDDの配列の内容をバイナリ形式で書き出す
+void
+bin_dump(const BddList& array,
+	 ostream& s,
+	 bool compress = false);
+
 // BDDの配列のノード数を数える
 size_t
 size(const BddVector& array);
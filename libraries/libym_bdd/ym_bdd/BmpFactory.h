@@ -0,0 +1,63 @@
+#ifndef YM_BDD_BMPFACTORY_H
+#define YM_BDD_BMPFACTORY_H
+
+/// @file ym_bdd/BmpFactory.h
+/// @brief BmpFactory のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_bdd/Bdd.h"
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+//////////////////////////////////////////////////////////////////////
+/// @class BmpFactory BmpFactory.h <ym_bdd/BmpFactory.h>
+/// @brief BddMgrParallel を生成するクラス
+/// @note BddMgrParallel は AND/XOR/ITE/smoothing 演算を複数の
+/// スレッドで行う．変数順は固定で，結果は BmcFactory で生成した
+/// マネージャと同一になる．
+//////////////////////////////////////////////////////////////////////
+class BmpFactory :
+  public BddMgrFactory
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] thread_num 演算に用いるスレッド数
+  /// ( 0 の時は利用可能なプロセッサ数)
+  /// @param[in] name マネージャに付ける名前（オプショナル）
+  explicit
+  BmpFactory(ymuint thread_num = 0,
+	     const string& name = string());
+
+  /// @brief デストラクタ
+  virtual
+  ~BmpFactory();
+
+  /// @brief BddMgrParallel を生成する．
+  virtual
+  BddMgr*
+  operator()() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // スレッド数
+  ymuint mThreadNum;
+
+  const string mName;
+
+};
+
+END_NAMESPACE_YM_BDD
+
+#endif // YM_BDD_BMPFACTORY_H
@@ -0,0 +1,363 @@
+#ifndef YM_BDD_ZDD_H
+#define YM_BDD_ZDD_H
+
+/// @file ym_bdd/Zdd.h
+/// @brief Zdd のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_bdd/Bdd.h"
+#include "ym_bdd/BddVarSet.h"
+
+
+BEGIN_NAMESPACE_YM_BDD
+
+//////////////////////////////////////////////////////////////////////
+/// @class Zdd Zdd.h <ym_bdd/Zdd.h>
+/// @ingroup Bdd
+/// @brief ZDD (Zero-suppressed BDD) で集合族を表すクラス
+///
+/// 節点は BDD と同じ BddMgr の節点テーブルに置かれ，
+/// ガーベージコレクションや演算結果テーブルも BDD と共有する．
+/// 否定枝は空集合を要素として含むかどうかの反転を表す．
+/// 現在 ZDD を扱えるのは BmcFactory と BmpFactory で作った
+/// マネージャのみで，それ以外ではエラーとなる．
+/// @sa Bdd
+//////////////////////////////////////////////////////////////////////
+class Zdd
+{
+public:
+
+  /// @brief デフォルトのコンストラクタ
+  /// @note デフォルトの BDD マネージャの空の集合族となる．
+  Zdd();
+
+  /// @brief コピーコンストラクタ
+  /// @param[in] src コピー元のオブジェクト
+  Zdd(const Zdd& src);
+
+  /// @brief 代入演算子
+  /// @param[in] src コピー元のオブジェクト
+  /// @return 自分自身
+  const Zdd&
+  operator=(const Zdd& src);
+
+  /// @brief 変数一つからなる集合のみを要素とする集合族を作るコンストラクタ
+  /// @param[in] mgr BDD マネージャ
+  /// @param[in] varid 変数番号
+  Zdd(BddMgrRef mgr,
+      tVarId varid);
+
+  /// @brief BDD からの変換用コンストラクタ
+  /// @param[in] f 論理関数
+  /// @param[in] vars 全体の変数集合
+  /// @note f が 1 となる最小項を 1 の変数の集合と見なした集合族となる．
+  /// vars に含まれていない変数も f のサポートに含まれていれば考慮される．
+  Zdd(const Bdd& f,
+      const BddVarSet& vars);
+
+  /// @brief デストラクタ
+  ~Zdd();
+
+  /// @brief 空の集合族を作る．
+  /// @param[in] mgr BDD マネージャ
+  static
+  Zdd
+  make_empty(BddMgrRef mgr);
+
+  /// @brief 空集合のみを要素とする集合族を作る．
+  /// @param[in] mgr BDD マネージャ
+  static
+  Zdd
+  make_base(BddMgrRef mgr);
+
+
+  //////////////////////////////////////////////////////////////////////
+  /// @name 特別な値を持つときのチェック
+  /// @{
+
+  /// @brief 空の集合族の時 true を返す．
+  bool
+  is_empty() const;
+
+  /// @brief 空集合のみを要素とする集合族の時 true を返す．
+  bool
+  is_base() const;
+
+  /// @brief オーバーフローの時 true を返す．
+  bool
+  is_overflow() const;
+
+  /// @brief エラーの時 true を返す．
+  bool
+  is_error() const;
+
+  /// @brief オーバーフローかエラーの時 true を返す．
+  bool
+  is_invalid() const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+  //////////////////////////////////////////////////////////////////////
+  /// @name 集合演算＋代入演算子
+  /// @{
+
+  /// @brief 和集合を計算して代入する．
+  const Zdd&
+  operator|=(const Zdd& src);
+
+  /// @brief 共通部分を計算して代入する．
+  const Zdd&
+  operator&=(const Zdd& src);
+
+  /// @brief 差集合を計算して代入する．
+  const Zdd&
+  operator-=(const Zdd& src);
+
+  /// @brief 積 { a ∪ b | a ∈ this, b ∈ src } を計算して代入する．
+  const Zdd&
+  operator*=(const Zdd& src);
+
+  /// @brief 商(weak division)を計算して代入する．
+  const Zdd&
+  operator/=(const Zdd& src);
+
+  /// @brief 剰余 this - src * (this / src) を計算して代入する．
+  const Zdd&
+  operator%=(const Zdd& src);
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+  //////////////////////////////////////////////////////////////////////
+  /// @name 変数に関する演算
+  /// @{
+
+  /// @brief varid を含まない集合のみを取り出す．
+  Zdd
+  subset0(tVarId varid) const;
+
+  /// @brief varid を含む集合のみを取り出して varid を取り除く．
+  Zdd
+  subset1(tVarId varid) const;
+
+  /// @brief 各集合の varid の有無を反転させる．
+  Zdd
+  change(tVarId varid) const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+
+  //////////////////////////////////////////////////////////////////////
+  /// @name その他の関数
+  /// @{
+
+  /// @brief 要素数を数える．
+  mpz_class
+  count() const;
+
+  /// @brief ZDD の節点数を数える．
+  size_t
+  size() const;
+
+  /// @brief 集合族を特性関数とする BDD を作る．
+  /// @param[in] vars 全体の変数集合
+  Bdd
+  to_bdd(const BddVarSet& vars) const;
+
+  /// @brief 親の BDD マネージャを返す．
+  BddMgrRef
+  mgr() const;
+
+  /// @brief 等価比較
+  bool
+  operator==(const Zdd& src) const;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+  friend
+  Bdd
+  isop(const Bdd& lower,
+       const Bdd& upper,
+       Zdd& cover);
+
+
+private:
+
+  /// @brief ZDD の根の枝を持つ Bdd を指定するコンストラクタ
+  explicit
+  Zdd(const Bdd& body);
+
+  // 根の枝を取り出す．
+  tBddEdge
+  root() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 本体
+  // 参照回数やマネージャの管理は Bdd に任せる．
+  Bdd mBody;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// Zdd 関係の non-member 関数の宣言
+//////////////////////////////////////////////////////////////////////
+
+/// @relates Zdd
+/// @brief 和集合
+Zdd
+operator|(const Zdd& src1,
+	  const Zdd& src2);
+
+/// @relates Zdd
+/// @brief 共通部分
+Zdd
+operator&(const Zdd& src1,
+	  const Zdd& src2);
+
+/// @relates Zdd
+/// @brief 差集合
+Zdd
+operator-(const Zdd& src1,
+	  const Zdd& src2);
+
+/// @relates Zdd
+/// @brief 積
+Zdd
+operator*(const Zdd& src1,
+	  const Zdd& src2);
+
+/// @relates Zdd
+/// @brief 商
+Zdd
+operator/(const Zdd& src1,
+	  const Zdd& src2);
+
+/// @relates Zdd
+/// @brief 剰余
+Zdd
+operator%(const Zdd& src1,
+	  const Zdd& src2);
+
+/// @relates Zdd
+/// @brief 非等価比較
+bool
+operator!=(const Zdd& src1,
+	   const Zdd& src2);
+
+/// @relates Zdd
+/// @brief 非冗長積和形を ZDD で求める．
+/// @param[in] lower 不完全指定論理関数の下限
+/// @param[in] upper 不完全指定論理関数の上限
+/// @param[out] cover 結果の積和形を表すキューブの集合族
+/// @return cover の表す論理関数
+/// @note 変数 x の肯定リテラルは 2x，否定リテラルは 2x + 1 を
+/// ZDD の変数として表す．
+Bdd
+isop(const Bdd& lower,
+     const Bdd& upper,
+     Zdd& cover);
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// 根の枝を取り出す．
+inline
+tBddEdge
+Zdd::root() const
+{
+  return mBody.root();
+}
+
+// 空の集合族の時 true を返す．
+inline
+bool
+Zdd::is_empty() const
+{
+  return check_zero(root());
+}
+
+// 空集合のみを要素とする集合族の時 true を返す．
+inline
+bool
+Zdd::is_base() const
+{
+  return check_one(root());
+}
+
+// オーバーフローの時 true を返す．
+inline
+bool
+Zdd::is_overflow() const
+{
+  return check_overflow(root());
+}
+
+// エラーの時 true を返す．
+inline
+bool
+Zdd::is_error() const
+{
+  return check_error(root());
+}
+
+// オーバーフローかエラーの時 true を返す．
+inline
+bool
+Zdd::is_invalid() const
+{
+  return check_invalid(root());
+}
+
+// 親の BDD マネージャを返す．
+inline
+BddMgrRef
+Zdd::mgr() const
+{
+  return mBody.mgr();
+}
+
+// 等価比較
+inline
+bool
+Zdd::operator==(const Zdd& src) const
+{
+  return mBody == src.mBody;
+}
+
+// 非等価比較
+inline
+bool
+operator!=(const Zdd& src1,
+	   const Zdd& src2)
+{
+  return !src1.operator==(src2);
+}
+
+END_NAMESPACE_YM_BDD
+
+BEGIN_NAMESPACE_YM
+
+using nsBdd::Zdd;
+
+END_NAMESPACE_YM
+
+#endif // YM_BDD_ZDD_H
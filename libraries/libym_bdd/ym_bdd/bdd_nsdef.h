@@ -54,6 +54,7 @@ class BddMgr;
 class BddMgrFactory;
 class BddVarSet;
 class BddLitSet;
+class Zdd;
 
 
 //////////////////////////////////////////////////////////////////////
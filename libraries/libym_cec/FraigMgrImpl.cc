@@ -32,6 +32,12 @@ BEGIN_NONAMESPACE
 
 const ymuint debug = DEBUG_FLAG;
 
+// 反例のまわりで作る距離1のパタン数 ( < 32 )
+const ymuint kDist1Num = 15;
+
+// この数の反例がたまったら全ノードのパタンを計算する．
+const ymuint kCexNum = 64;
+
 // boolean(inv) から tPol を得る．
 inline
 tPol
@@ -191,9 +197,13 @@ FraigMgrImpl::FraigMgrImpl(ymuint pat_size,
   mPatSize(pat_size * 2),
   mPatInit(pat_size),
   mPatUsed(pat_size),
+  mPatEnd(pat_size),
   mSolver(NULL),
   mSimCount(0),
   mSimTime(0.0),
+  mCexNum(0),
+  mCexPruneNum(0),
+  mSplitNum(0),
   mOutP(sat_log),
   mLogLevel(0),
   mLogStream(new ofstream("/dev/null")),
@@ -212,6 +222,14 @@ FraigMgrImpl::FraigMgrImpl(ymuint pat_size,
   else if ( sat_type == "minisat" ) {
     mSolver = SatSolverFactory::gen_minisat();
   }
+  else if ( sat_type == "portfolio" || sat_type == "portfolio-det" ) {
+    // sat_opt はスレッド数
+    int n = atoi(sat_opt.c_str());
+    if ( n <= 0 ) {
+      n = 4;
+    }
+    mSolver = SatSolverFactory::gen_portfolio(n, sat_type == "portfolio-det");
+  }
   else {
     // default fall-back
     mSolver = SatSolverFactory::gen_solver(sat_opt);
@@ -254,6 +272,11 @@ FraigMgrImpl::make_input()
     tmp[i] = mRandGen.int32();
   }
   node->set_pat(0, mPatUsed, tmp);
+  // バッファ中の反例の分も乱数にしておく．
+  for (ymuint i = mPatUsed; i < mPatEnd; ++ i) {
+    node->mPat[i] = mRandGen.int32();
+  }
+  node->mPatNum = mPatEnd;
   return FraigHandle(node, false);
 }
   
@@ -263,6 +286,11 @@ FraigHandle
 FraigMgrImpl::make_and(FraigHandle handle1,
 		       FraigHandle handle2)
 {
+  if ( mPatEnd - mPatUsed >= kCexNum ) {
+    // たまった反例のパタンを全ノードで計算する．
+    flush_cex();
+  }
+
   // trivial な場合の処理
   if ( handle1.is_zero() || handle2.is_zero() ) {
     return make_zero();
@@ -313,6 +341,7 @@ FraigMgrImpl::make_and(FraigHandle handle1,
   FraigNode* node = new_node();
   node->set_fanin(handle1, handle2);
   node->calc_pat(0, mPatUsed);
+  node->mPatNum = mPatUsed;
 
   // 構造ハッシュ表に登録する．
   mHashTable1.add_elem(pos1, node, node->mLink1);
@@ -330,126 +359,302 @@ FraigMgrImpl::make_and(FraigHandle handle1,
   mSolver->add_clause( lit1, ~lito);
   mSolver->add_clause( lit2, ~lito);
   
-  // パタンハッシュで等しいノードがないか調べる．
+  // 定数の可能性があるか調べる．
+  // バッファ中の反例で 0 と 1 の両方の値を取っていれば調べる必要はない．
   bool inv0 = node->pat_hash_inv();
-  for ( ; ; ) {
-    bool rehash = false;
-    FraigNode* node2;
-    bool inv2;
-    if ( !node->check_1mark() ) {
-      // 定数0の可能性があるか調べる．
-      Bool3 stat = check_const(node, false);
-      if ( stat == kB3True ) {
-	node->set_rep(NULL, false);
-	return make_zero();
-      }
-      if ( stat == kB3False ) {
-	add_pat(node);
-	assert_cond(node->check_1mark(), __FILE__, __LINE__);
-	continue;
-      }
+  bool aborted = false;
+  if ( !node->check_1mark() && !check_cex_value(node, true) ) {
+    // 定数0の可能性があるか調べる．
+    Bool3 stat = check_const(node, false);
+    if ( stat == kB3True ) {
+      node->set_rep(NULL, false);
+      return make_zero();
+    }
+    if ( stat == kB3False ) {
+      add_cex(node, NULL);
+    }
+    else {
+      aborted = true;
+    }
+  }
+  else if ( !node->check_0mark() && !check_cex_value(node, false) ) {
+    // 定数1の可能性があるか調べる．
+    Bool3 stat = check_const(node, true);
+    if ( stat == kB3True ) {
+      node->set_rep(NULL, true);
+      return make_one();
+    }
+    if ( stat == kB3False ) {
+      add_cex(node, NULL);
+    }
+    else {
+      aborted = true;
+    }
+  }
+
+  // パタンハッシュで等しいパタンを持つ等価候補グループを探す．
+  FraigNode* rep = NULL;
+  for (FraigNode* node1 = mHashTable2.elem(node->pat_hash());
+       node1; node1 = node1->mLink2) {
+    bool inv = node1->pat_hash_inv() ^ inv0;
+    if ( compare_pat(node1, node, inv) ) {
+      rep = node1;
       break;
     }
-    else if ( !node->check_0mark() ) {
-      // 定数1の可能性があるか調べる．
-      Bool3 stat = check_const(node, true);
+  }
+
+  if ( rep != NULL && !aborted ) {
+    // グループ中のノードと等価かどうか調べる．
+    for (FraigNode* node1 = rep; node1; node1 = node1->mEqLink) {
+      bool inv = node1->pat_hash_inv() ^ inv0;
+      if ( check_cex_diff(node1, node, inv) ) {
+	// バッファ中の反例で区別できるので SAT を使う必要はない．
+	++ mCexPruneNum;
+	continue;
+      }
+      Bool3 stat = check_equiv(node1, node, inv);
       if ( stat == kB3True ) {
-	node->set_rep(NULL, true);
-	return make_one();
+	node->set_rep(node1, inv);
+	return FraigHandle(node1, inv);
       }
       if ( stat == kB3False ) {
-	add_pat(node);
-	assert_cond(node->check_0mark(), __FILE__, __LINE__);
-	continue;
+	add_cex(node, node1);
       }
-      break;
     }
-    ymuint pos2 = node->pat_hash();
-    for (FraigNode* node1 = mHashTable2.elem(pos2);
-	 node1; node1 = node1->mLink2) {
-      bool inv = node1->pat_hash_inv() ^ inv0;
-      if ( compare_pat(node1, node, inv) ) {
-	// node1 と node が等価かどうか調べる．
-	Bool3 stat = check_equiv(node1, node, inv);
-	if ( stat == kB3True ) {
-	  node->set_rep(node1, inv);
-	  return FraigHandle(node1, inv);
-	}
-	if ( stat == kB3False ) {
-	  // 反例をパタンに加えて再ハッシュする．
-	  rehash = true;
-	  node2 = node1;
-	  inv2 = inv;
-	  break;
-	}
+  }
+
+  // 等価候補グループに登録する．
+  if ( rep != NULL ) {
+    if ( rep->mEqLink == NULL ) {
+      mEqClassList.push_back(rep);
+    }
+    rep->add_eqnode(node);
+  }
+  else {
+    add_class(node);
+  }
+  
+  return FraigHandle(node, false);
+}
+
+// @brief 直前の SAT の反例をバッファに加える．
+// @param[in] node 検証対象のノード
+// @param[in] node1 node と比較したノード (定数の時は NULL)
+// @note 反例1つにつき1ワードのパタンを外部入力に加える．
+// @note AND ノードのパタンは必要になるまで計算しない．
+void
+FraigMgrImpl::add_cex(FraigNode* node,
+		      FraigNode* node1)
+{
+  if ( mPatSize <= mPatEnd ) {
+    resize_pat(mPatSize * 2);
+  }
+
+  // 先頭のビットが反例そのもので，続く kDist1Num ビットは入力を
+  // 1つだけ反転させた距離1のパタン，残りのビットは反例の値を
+  // ランダムに反転させたもの．
+  ymuint pos = mPatEnd;
+  for (vector<FraigNode*>::iterator p = mInputNodes.begin();
+       p != mInputNodes.end(); ++ p) {
+    FraigNode* node2 = *p;
+    ymuint32 pat = 0U;
+    if ( mModel[node2->var_id()] == kB3True ) {
+      pat = ~0U;
+    }
+    for (ymuint b = kDist1Num + 1; b < 32; ++ b) {
+      if ( (mRandGen.int32() % 100) <= 3 ) {
+	pat ^= (1U << b);
       }
     }
+    node2->mPat[pos] = pat;
+    node2->mPatNum = pos + 1;
+  }
 
-    if ( rehash ) {
-      add_pat(node);
-      assert_cond(!compare_pat(node2, node, inv2), __FILE__, __LINE__);
+  // 反転させる入力は node と node1 から
+  // ランダムにファンインをたどって選ぶ．
+  for (ymuint i = 0; i < kDist1Num; ++ i) {
+    FraigNode* node2 = ( node1 != NULL && (i & 1U) ) ? node1 : node;
+    while ( node2->is_and() ) {
+      node2 = node2->fanin(mRandGen.int32() & 1U);
     }
-    else {
-      break;
+    node2->mPat[pos] ^= (1U << (i + 1));
+  }
+
+  ++ mPatEnd;
+  ++ mCexNum;
+}
+
+// @brief バッファ中の反例のパタンを全ノードで計算する．
+// @note 等価候補グループの分割とパタンハッシュの再構築も行う．
+void
+FraigMgrImpl::flush_cex()
+{
+  StopWatch sw;
+  sw.start();
+
+  ymuint start = mPatUsed;
+  ymuint end = mPatEnd;
+  ymuint n = mAllNodes.size();
+  for (ymuint i = 0; i < n; ++ i) {
+    FraigNode* node = mAllNodes[i];
+    if ( node->mPatNum < end ) {
+      node->sim_pat(node->mPatNum, end);
+      node->mPatNum = end;
+    }
+    node->calc_hash(start, end);
+  }
+  mPatUsed = end;
+
+  // 要素数が2以上の等価候補グループだけを分割する．
+  vector<FraigNode*> old_list;
+  old_list.swap(mEqClassList);
+  for (vector<FraigNode*>::iterator p = old_list.begin();
+       p != old_list.end(); ++ p) {
+    split_class(*p, start, end);
+  }
+
+  // ハッシュ値が変わったので代表ノードだけでハッシュ表を作り直す．
+  mHashTable2.clear();
+  for (ymuint i = 0; i < n; ++ i) {
+    FraigNode* node = mAllNodes[i];
+    if ( node->mEqTail != NULL ) {
+      mHashTable2.add_elem(node->pat_hash(), node, node->mLink2);
+    }
+  }
+
+  ++ mSimCount;
+  mSimTime += sw.time().usr_time();
+}
+
+// @brief バッファ中の反例のパタンを node について計算する．
+// @note 必要なファンインのパタンも計算する．
+void
+FraigMgrImpl::sync_pat(FraigNode* node)
+{
+  if ( node->mPatNum == mPatEnd ) {
+    return;
+  }
+
+  // 深い回路で再帰呼び出しを避けるため自前のスタックを用いる．
+  vector<FraigNode*> node_stack;
+  node_stack.push_back(node);
+  while ( !node_stack.empty() ) {
+    FraigNode* node1 = node_stack.back();
+    if ( node1->mPatNum == mPatEnd ) {
+      node_stack.pop_back();
+      continue;
+    }
+    FraigNode* inode0 = node1->fanin0();
+    if ( inode0->mPatNum < mPatEnd ) {
+      node_stack.push_back(inode0);
+      continue;
+    }
+    FraigNode* inode1 = node1->fanin1();
+    if ( inode1->mPatNum < mPatEnd ) {
+      node_stack.push_back(inode1);
+      continue;
+    }
+    node1->sim_pat(node1->mPatNum, mPatEnd);
+    node1->mPatNum = mPatEnd;
+    node_stack.pop_back();
+  }
+}
+
+// @brief バッファ中の反例のパタンで node が val の値を取るか調べる．
+bool
+FraigMgrImpl::check_cex_value(FraigNode* node,
+			      bool val)
+{
+  if ( mPatUsed == mPatEnd ) {
+    return false;
+  }
+  sync_pat(node);
+  ymuint32 pat0 = val ? 0U : ~0U;
+  for (ymuint i = mPatUsed; i < mPatEnd; ++ i) {
+    if ( node->mPat[i] != pat0 ) {
+      return true;
     }
   }
-    
-  // パタンハッシュ表に登録する．
+  return false;
+}
+
+// @brief バッファ中の反例のパタンで2つのノードが区別できるか調べる．
+// @param[in] node1, node2 対象のノード
+// @param[in] inv false で同相，true で逆相を表す．
+bool
+FraigMgrImpl::check_cex_diff(FraigNode* node1,
+			     FraigNode* node2,
+			     bool inv)
+{
+  if ( mPatUsed == mPatEnd ) {
+    return false;
+  }
+  sync_pat(node1);
+  sync_pat(node2);
+  return !compare_pat(node1, node2, inv, mPatUsed, mPatEnd);
+}
+
+// @brief node を代表とする等価候補グループを作る．
+void
+FraigMgrImpl::add_class(FraigNode* node)
+{
+  node->mEqTail = node;
+  node->mEqLink = NULL;
   if ( mHashTable2.need_expand() ) {
     // 再ハッシュする．
-    ymuint n = node_num() - 1; // ！-1 するのは node を除外するため！
+    ymuint n = node_num();
     for (ymuint i = 0; i < n; ++ i) {
       FraigNode* node1 = mAllNodes[i];
-      ymuint pos2 = node1->pat_hash();
-      mHashTable2.add_elem(pos2, node1, node1->mLink2);
+      if ( node1 != node && node1->mEqTail != NULL ) {
+	mHashTable2.add_elem(node1->pat_hash(), node1, node1->mLink2);
+      }
     }
   }
-  ymuint pos2 = node->pat_hash();
-  mHashTable2.add_elem(pos2, node, node->mLink2);
-  
-  return FraigHandle(node, false);
+  mHashTable2.add_elem(node->pat_hash(), node, node->mLink2);
 }
 
-// @breif 直前の SAT の反例を加えて再ハッシュする．
+// @brief 等価候補グループを新しいパタンで分割する．
+// @param[in] rep グループの代表ノード
+// @param[in] start, end 新しいパタンの範囲
+// @note 古いパタンは全て等しいので新しいパタンだけ比べればよい．
+// @note 要素数が2以上のグループの代表は mEqClassList に入れる．
 void
-FraigMgrImpl::add_pat(FraigNode* node)
+FraigMgrImpl::split_class(FraigNode* rep,
+			  ymuint start,
+			  ymuint end)
 {
-  if ( mPatSize <= mPatUsed ) {
-    resize_pat(mPatSize * 2);
-  }
-  mHashTable2.clear();
-	
-  // 反例をパタンに加える．
-  vector<ymuint32> tmp(1);
-  ymuint nn = node_num();
-  for (ymuint i = 0; i < nn; ++ i) {
-    FraigNode* node1 = mAllNodes[i];
-    if ( node1->is_input() ) {
-      ymuint32 pat = 0U;
-      if ( mModel[node1->var_id()] == kB3True ) {
-	pat = ~0U;
+  FraigNode* rest = rep;
+  while ( rest != NULL ) {
+    // 先頭のノードと等しいものだけを残す．
+    FraigNode* head = rest;
+    bool inv0 = head->pat_hash_inv();
+    FraigNode* tail = head;
+    FraigNode* rest_top = NULL;
+    FraigNode** rest_tail = &rest_top;
+    FraigNode* next = NULL;
+    for (FraigNode* node = head->mEqLink; node; node = next) {
+      next = node->mEqLink;
+      bool inv = node->pat_hash_inv() ^ inv0;
+      if ( compare_pat(head, node, inv, start, end) ) {
+	tail->mEqLink = node;
+	tail = node;
       }
       else {
-	pat = 0U;
-      }
-      for (ymuint b = 1; b < 32; ++ b) {
-	if ( (mRandGen.int32() % 100) <= 3 ) {
-	  pat ^= (1U << b);
-	}
+	*rest_tail = node;
+	rest_tail = &node->mEqLink;
       }
-      tmp[0] = pat;
-      node1->set_pat(mPatUsed, mPatUsed + 1, tmp);
     }
-    else {
-      node1->calc_pat(mPatUsed, mPatUsed + 1);
+    tail->mEqLink = NULL;
+    *rest_tail = NULL;
+    head->mEqTail = tail;
+    if ( head != rep ) {
+      ++ mSplitNum;
     }
-    
-    if ( node1 != node ) {
-      ymuint pos2 = node1->pat_hash();
-      mHashTable2.add_elem(pos2, node1, node1->mLink2);
+    if ( head->mEqLink != NULL ) {
+      mEqClassList.push_back(head);
     }
+    rest = rest_top;
   }
-  ++ mPatUsed;
 }
 
 // @brief 2つのハンドルが等価かどうか調べる．
@@ -540,7 +745,7 @@ FraigMgrImpl::resize_pat(ymuint size)
     FraigNode* node = mAllNodes[i];
     ymuint32* old_array = node->mPat;
     node->mPat = new ymuint32[size];
-    for (ymuint j = 0; j < mPatUsed; ++ j) {
+    for (ymuint j = 0; j < node->mPatNum; ++ j) {
       node->mPat[j] = old_array[j];
     }
     delete [] old_array;
@@ -554,18 +759,31 @@ FraigMgrImpl::compare_pat(FraigNode* node1,
 			  FraigNode* node2,
 			  bool inv)
 {
-  ymuint32* src1 = node1->mPat;
-  ymuint32* src2 = node2->mPat;
-  ymuint32* end = src1 + mPatUsed;
+  return compare_pat(node1, node2, inv, 0, mPatUsed);
+}
+
+// @brief シミュレーションパタンの一部が等しいか調べる．
+// @param[in] start 開始位置
+// @param[in] end 終了位置
+bool
+FraigMgrImpl::compare_pat(FraigNode* node1,
+			  FraigNode* node2,
+			  bool inv,
+			  ymuint start,
+			  ymuint end)
+{
+  ymuint32* src1 = node1->mPat + start;
+  ymuint32* src2 = node2->mPat + start;
+  ymuint32* src_end = node1->mPat + end;
   if ( inv ) {
-    for ( ; src1 != end; ++ src1, ++ src2) {
+    for ( ; src1 != src_end; ++ src1, ++ src2) {
       if ( *src1 != ~*src2 ) {
 	return false;
       }
     }
   }
   else {
-    for ( ; src1 != end; ++ src1, ++ src2) {
+    for ( ; src1 != src_end; ++ src1, ++ src2) {
       if ( *src1 != *src2 ) {
 	return false;
       }
@@ -868,7 +1086,10 @@ FraigMgrImpl::dump_stats(ostream& s) const
   s << "=====<< AigMgr Statistics >> =====" << endl;
   s << "simulation:" << endl
     << " total " << mSimCount << " loops" << endl
-    << " total " << mSimTime << " sec." << endl;
+    << " total " << mSimTime << " sec." << endl
+    << " total " << mCexNum << " counter examples" << endl
+    << " total " << mCexPruneNum << " SAT calls pruned" << endl
+    << " total " << mSplitNum << " class splits" << endl;
   s << "----------------------------------" << endl;
   s << "check_const:" << endl;
   mCheckConstInfo.dump(s);
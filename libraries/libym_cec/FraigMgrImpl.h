@@ -140,9 +140,56 @@ private:
 	      FraigNode* node2,
 	      bool inv);
 
-  /// @breif 直前の SAT の反例を加えて再ハッシュする．
+  /// @brief シミュレーションパタンの一部が等しいか調べる．
+  /// @param[in] start 開始位置
+  /// @param[in] end 終了位置
+  bool
+  compare_pat(FraigNode* node1,
+	      FraigNode* node2,
+	      bool inv,
+	      ymuint start,
+	      ymuint end);
+
+  /// @brief 直前の SAT の反例をバッファに加える．
+  /// @param[in] node 検証対象のノード
+  /// @param[in] node1 node と比較したノード (定数の時は NULL)
+  void
+  add_cex(FraigNode* node,
+	  FraigNode* node1);
+
+  /// @brief バッファ中の反例のパタンを全ノードで計算する．
+  /// @note 等価候補グループの分割とパタンハッシュの再構築も行う．
   void
-  add_pat(FraigNode* node);
+  flush_cex();
+
+  /// @brief バッファ中の反例のパタンを node について計算する．
+  void
+  sync_pat(FraigNode* node);
+
+  /// @brief バッファ中の反例のパタンで node が val の値を取るか調べる．
+  bool
+  check_cex_value(FraigNode* node,
+		  bool val);
+
+  /// @brief バッファ中の反例のパタンで2つのノードが区別できるか調べる．
+  /// @param[in] node1, node2 対象のノード
+  /// @param[in] inv false で同相，true で逆相を表す．
+  bool
+  check_cex_diff(FraigNode* node1,
+		 FraigNode* node2,
+		 bool inv);
+
+  /// @brief node を代表とする等価候補グループを作る．
+  void
+  add_class(FraigNode* node);
+
+  /// @brief 等価候補グループを新しいパタンで分割する．
+  /// @param[in] rep グループの代表ノード
+  /// @param[in] start, end 新しいパタンの範囲
+  void
+  split_class(FraigNode* rep,
+	      ymuint start,
+	      ymuint end);
   
   /// @brief ノードが定数と等価かどうか調べる．
   /// @param[in] node 対象のノード
@@ -268,9 +315,15 @@ private:
   
   // 使用しているパタン数
   ymuint32 mPatUsed;
+
+  // バッファ中の反例を含めたパタン数
+  ymuint32 mPatEnd;
   
-  // パタンハッシュ
+  // 等価候補グループの代表のパタンハッシュ
   FraigHash mHashTable2;
+
+  // 要素数が2以上の等価候補グループの代表のリスト
+  vector<FraigNode*> mEqClassList;
   
   // 乱数発生器
   RandGen mRandGen;
@@ -286,6 +339,15 @@ private:
   
   // シミュレーションに要した時間
   double mSimTime;
+
+  // 反例の数
+  ymuint32 mCexNum;
+
+  // バッファ中の反例で SAT を省略した回数
+  ymuint32 mCexPruneNum;
+
+  // 等価候補グループの分割回数
+  ymuint32 mSplitNum;
   
   // check_const の統計情報
   SatStat mCheckConstInfo;
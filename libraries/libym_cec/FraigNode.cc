@@ -126,6 +126,7 @@ ymuint32 FraigNode::mPrimes[] = {
 FraigNode::FraigNode() :
   mFlags(0),
   mPat(NULL),
+  mPatNum(0),
   mHash(0),
   mRepNode(this),
   mEqLink(NULL),
@@ -195,8 +196,8 @@ FraigNode::calc_hash(ymuint start,
 
   ymuint32* src = mPat + start;
   ymuint32* src_end = mPat + end;
-  ymuint32* prime = mPrimes + start;
   ymuint32* prime_end = mPrimes + 1023;
+  ymuint32* prime = ( start < 1023 ) ? mPrimes + start : prime_end;
   if ( pat_hash_inv() ) {
     for ( ; src != src_end; ++ src) {
       ymuint32 pat = *src;
@@ -207,9 +208,9 @@ FraigNode::calc_hash(ymuint start,
       if ( pat != ~0U ) {
 	set_0mark();
       }
-    }
-    if ( prime != prime_end ) {
-      ++ prime;
+      if ( prime != prime_end ) {
+	++ prime;
+      }
     }
   }
   else {
@@ -136,6 +136,15 @@ public:
   calc_pat(ymuint start,
 	   ymuint end);
 
+  /// @brief パタンだけを計算する．
+  /// @param[in] start 開始位置
+  /// @param[in] end 終了位置
+  /// @note ANDノード用
+  /// @note ハッシュ値と 0/1 マークは更新しない．
+  void
+  sim_pat(ymuint start,
+	  ymuint end);
+
   /// @brief 0 の値を取るとき true を返す．
   bool
   check_0mark() const;
@@ -237,6 +246,9 @@ private:
   
   // シミュレーションパタン
   ymuint32* mPat;
+
+  // 計算済みのパタン数
+  ymuint32 mPatNum;
   
   // mPat のハッシュ値
   ymuint32 mHash;
@@ -523,7 +535,6 @@ FraigNode::add_eqnode(FraigNode* node)
 {
   mEqTail->mEqLink = node;
   mEqTail = node;
-  node->mRepNode = this;
   node->mEqLink = NULL;
 }
 
@@ -564,6 +575,17 @@ inline
 void
 FraigNode::calc_pat(ymuint start,
 		    ymuint end)
+{
+  sim_pat(start, end);
+  calc_hash(start, end);
+}
+
+// @brief パタンだけを計算する．
+// @note ハッシュ値と 0/1 マークは更新しない．
+inline
+void
+FraigNode::sim_pat(ymuint start,
+		   ymuint end)
 {
   ymuint32* dst = mPat + start;
   ymuint32* dst_end = mPat + end;
@@ -593,7 +615,6 @@ FraigNode::calc_pat(ymuint start,
       }
     }
   }
-  calc_hash(start, end);
 }
 
 END_NAMESPACE_YM_CEC
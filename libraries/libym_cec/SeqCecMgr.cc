@@ -0,0 +1,622 @@
+
+/// @file libym_cec/SeqCecMgr.cc
+/// @brief SeqCecMgr の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "SeqCecMgr.h"
+#include "FraigMgr.h"
+#include "ym_aig/AigNode.h"
+
+
+BEGIN_NAMESPACE_YM_CEC
+
+BEGIN_NONAMESPACE
+
+// 対応関係の候補を作るためのシミュレーションの時刻数
+const ymuint kSimCycles = 64;
+
+// AIG のハンドルを FraigMgr のハンドルに変換する．
+inline
+FraigHandle
+conv_handle(AigHandle handle,
+	    FraigMgr& fraig_mgr,
+	    const vector<FraigHandle>& map)
+{
+  if ( handle.is_zero() ) {
+    return fraig_mgr.make_zero();
+  }
+  if ( handle.is_one() ) {
+    return fraig_mgr.make_one();
+  }
+  FraigHandle h = map[handle.node_id()];
+  return handle.inv() ? ~h : h;
+}
+
+// AIG のハンドルのシミュレーション値を得る．
+inline
+ymuint32
+handle_val(AigHandle handle,
+	   const vector<ymuint32>& val)
+{
+  if ( handle.is_zero() ) {
+    return 0U;
+  }
+  if ( handle.is_one() ) {
+    return ~0U;
+  }
+  ymuint32 v = val[handle.node_id()];
+  return handle.inv() ? ~v : v;
+}
+
+// シグネチャの比較用の関数オブジェクト
+struct SigLt
+{
+  SigLt(const vector<vector<ymuint32> >& sig) :
+    mSig(sig)
+  {
+  }
+
+  bool
+  operator()(ymuint32 a,
+	     ymuint32 b) const
+  {
+    if ( mSig[a] != mSig[b] ) {
+      return mSig[a] < mSig[b];
+    }
+    return a < b;
+  }
+
+  const vector<vector<ymuint32> >& mSig;
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス SeqCecMgr
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] src_network1, src_network2 検証対象のネットワーク
+// @param[in] iassoc 対応する2つのネットワークの入力のペアのリスト
+// @param[in] oassoc 対応する2つのネットワークの出力のペアのリスト
+SeqCecMgr::SeqCecMgr(const BNetwork& src_network1,
+		     const BNetwork& src_network2,
+		     const vector<pair<ymuint32, ymuint32> >& iassoc,
+		     const vector<pair<ymuint32, ymuint32> >& oassoc) :
+  mSatOut(NULL),
+  mSigSize(1),
+  mMaxDepth(8),
+  mLogLevel(0),
+  mLogStream(NULL)
+{
+  vector<AigHandle> aig_array1(src_network1.max_node_id());
+  vector<AigHandle> aig_array2(src_network2.max_node_id());
+
+  // 外部入力は2つのネットワークで共通
+  mInputNum = iassoc.size();
+  for (vector<pair<ymuint32, ymuint32> >::const_iterator p = iassoc.begin();
+       p != iassoc.end(); ++ p) {
+    AigHandle anode = mAigMgr.make_input();
+    aig_array1[p->first] = anode;
+    aig_array2[p->second] = anode;
+  }
+
+  // latch は現状態を表す入力にする．
+  // 初期値が不定の latch は2つのネットワークの間で対応がとれないので
+  // 0 とみなす．
+  for (ymuint i = 0; i < 2; ++ i) {
+    const BNetwork& network = (i == 0) ? src_network1 : src_network2;
+    vector<AigHandle>& aig_array = (i == 0) ? aig_array1 : aig_array2;
+    for (BNodeList::const_iterator p = network.latch_nodes_begin();
+	 p != network.latch_nodes_end(); ++ p) {
+      BNode* bnode = *p;
+      aig_array[bnode->id()] = mAigMgr.make_input();
+      mInitVal.push_back(bnode->reset_value() == 1 ? 1 : 0);
+    }
+  }
+  mLatchNum = mInitVal.size();
+
+  make_logic(src_network1, aig_array1);
+  make_logic(src_network2, aig_array2);
+
+  // latch の次状態関数
+  for (ymuint i = 0; i < 2; ++ i) {
+    const BNetwork& network = (i == 0) ? src_network1 : src_network2;
+    vector<AigHandle>& aig_array = (i == 0) ? aig_array1 : aig_array2;
+    for (BNodeList::const_iterator p = network.latch_nodes_begin();
+	 p != network.latch_nodes_end(); ++ p) {
+      BNode* bnode = *p;
+      mNextHandles.push_back(aig_array[bnode->fanin(0)->id()]);
+    }
+  }
+
+  // 比較する出力
+  for (vector<pair<ymuint32, ymuint32> >::const_iterator p = oassoc.begin();
+       p != oassoc.end(); ++ p) {
+    BNode* onode1 = src_network1.node(p->first);
+    BNode* onode2 = src_network2.node(p->second);
+    mOutputPairs.push_back(make_pair(aig_array1[onode1->fanin(0)->id()],
+				     aig_array2[onode2->fanin(0)->id()]));
+  }
+}
+
+// @brief デストラクタ
+SeqCecMgr::~SeqCecMgr()
+{
+}
+
+// @brief SAT ソルバの設定を行う．
+// @param[in] sat_type SAT-solver の種類を表す文字列
+// @param[in] sat_opt SAT-solver に渡すオプション文字列
+// @param[in] sat_out ログの出力用ストリーム
+void
+SeqCecMgr::set_sat(const string& sat_type,
+		   const string& sat_opt,
+		   ostream* sat_out)
+{
+  mSatType = sat_type;
+  mSatOpt = sat_opt;
+  mSatOut = sat_out;
+}
+
+// @brief FraigMgr のシグネチャのサイズを設定する．
+void
+SeqCecMgr::set_sigsize(ymuint sigsize)
+{
+  mSigSize = sigsize;
+}
+
+// @brief BMC と k-induction の最大の深さを設定する．
+void
+SeqCecMgr::set_max_depth(ymuint depth)
+{
+  mMaxDepth = depth;
+}
+
+// @brief ログレベルを設定する．
+void
+SeqCecMgr::set_loglevel(int level)
+{
+  mLogLevel = level;
+}
+
+// @brief ログ出力用ストリームを設定する．
+void
+SeqCecMgr::set_logstream(ostream* out)
+{
+  mLogStream = out;
+}
+
+// @brief 検証を行う．
+// @param[out] stats 出力ごとの結果を格納する配列
+void
+SeqCecMgr::check(vector<Bool3>& stats)
+{
+  ymuint no = mOutputPairs.size();
+  stats.clear();
+  stats.resize(no, kB3X);
+
+  // latch の対応関係を求める．
+  find_candidates();
+  ymuint ncand = 0;
+  for (vector<vector<ymuint32> >::iterator p = mClassList.begin();
+       p != mClassList.end(); ++ p) {
+    ncand += p->size() - 1;
+  }
+  check_base();
+  ymuint niter = refine_by_induction();
+  ymuint nproved = 0;
+  for (vector<vector<ymuint32> >::iterator p = mClassList.begin();
+       p != mClassList.end(); ++ p) {
+    nproved += p->size() - 1;
+  }
+  if ( mLogLevel > 0 && mLogStream ) {
+    *mLogStream << "latch correspondence: " << ncand << " candidates, "
+		<< nproved << " proved after "
+		<< niter << " iterations" << endl;
+  }
+
+  // 対応関係を仮定して出力を比べる．
+  vector<ymuint32> remain_list;
+  {
+    FraigMgr* fraig_mgr = new_fraig_mgr();
+    vector<FraigHandle> latch_handles;
+    make_free_state(*fraig_mgr, latch_handles);
+    vector<FraigHandle> next_handles;
+    vector<FraigHandle> output_handles;
+    make_frame(*fraig_mgr, latch_handles, next_handles, output_handles);
+    for (ymuint i = 0; i < no; ++ i) {
+      FraigHandle h1 = output_handles[i * 2 + 0];
+      FraigHandle h2 = output_handles[i * 2 + 1];
+      if ( fraig_mgr->check_equiv(h1, h2) == kB3True ) {
+	stats[i] = kB3True;
+      }
+      else {
+	remain_list.push_back(i);
+      }
+    }
+    delete fraig_mgr;
+  }
+  if ( mLogLevel > 0 && mLogStream ) {
+    *mLogStream << "outputs: " << (no - remain_list.size())
+		<< " proved by latch correspondence" << endl;
+  }
+
+  // 残りの出力を BMC と k-induction で調べる．
+  // BMC はリセット状態から，k-induction は対応関係を仮定した
+  // 自由な状態から展開する．どちらも1時刻ずつ展開を延ばしていく．
+  FraigMgr* bmc_mgr = new_fraig_mgr();
+  vector<FraigHandle> bmc_latches;
+  make_init_state(*bmc_mgr, bmc_latches);
+
+  FraigMgr* ind_mgr = new_fraig_mgr();
+  vector<FraigHandle> ind_latches;
+  make_free_state(*ind_mgr, ind_latches);
+
+  // 出力ごとに以前の時刻で出力が異なる条件の OR
+  vector<FraigHandle> diff_before(no, ind_mgr->make_zero());
+
+  for (ymuint k = 0; k <= mMaxDepth && !remain_list.empty(); ++ k) {
+    vector<FraigHandle> next_handles;
+    vector<FraigHandle> output_handles;
+
+    // BMC: 時刻 k で出力が異なりうるか調べる．
+    make_frame(*bmc_mgr, bmc_latches, next_handles, output_handles);
+    bmc_latches.swap(next_handles);
+    vector<ymuint32> tmp_list;
+    for (vector<ymuint32>::iterator p = remain_list.begin();
+	 p != remain_list.end(); ++ p) {
+      ymuint i = *p;
+      FraigHandle h1 = output_handles[i * 2 + 0];
+      FraigHandle h2 = output_handles[i * 2 + 1];
+      Bool3 stat = bmc_mgr->check_equiv(h1, h2);
+      if ( stat == kB3True ) {
+	tmp_list.push_back(i);
+      }
+      else {
+	// kB3False なら反例が見つかった．
+	stats[i] = stat;
+	if ( mLogLevel > 0 && mLogStream && stat == kB3False ) {
+	  *mLogStream << "output#" << i << ": counter example at frame "
+		      << k << endl;
+	}
+      }
+    }
+    remain_list.swap(tmp_list);
+
+    // k-induction: 時刻 0 から k - 1 まで出力が等しければ
+    // 時刻 k でも等しいか調べる．
+    // k = 0 の場合は上で調べた対応関係による証明と同じなので省く．
+    make_frame(*ind_mgr, ind_latches, next_handles, output_handles);
+    ind_latches.swap(next_handles);
+    tmp_list.clear();
+    for (vector<ymuint32>::iterator p = remain_list.begin();
+	 p != remain_list.end(); ++ p) {
+      ymuint i = *p;
+      FraigHandle h1 = output_handles[i * 2 + 0];
+      FraigHandle h2 = output_handles[i * 2 + 1];
+      FraigHandle diff = ind_mgr->make_xor(h1, h2);
+      if ( k > 0 &&
+	   ind_mgr->check_equiv(ind_mgr->make_or(diff_before[i], ~diff),
+				ind_mgr->make_one()) == kB3True ) {
+	stats[i] = kB3True;
+	if ( mLogLevel > 0 && mLogStream ) {
+	  *mLogStream << "output#" << i << ": proved by "
+		      << k << "-induction" << endl;
+	}
+      }
+      else {
+	diff_before[i] = ind_mgr->make_or(diff_before[i], diff);
+	tmp_list.push_back(i);
+      }
+    }
+    remain_list.swap(tmp_list);
+  }
+
+  if ( mLogLevel > 1 && mLogStream ) {
+    bmc_mgr->dump_stats(*mLogStream);
+    ind_mgr->dump_stats(*mLogStream);
+  }
+  delete bmc_mgr;
+  delete ind_mgr;
+}
+
+// @brief ネットワークの組み合わせ回路部分を AIG にする．
+// @param[in] network 対象のネットワーク
+// @param[in] aig_array ノード番号をキーにして AIG を格納する配列
+// @note 外部入力と latch の AIG はあらかじめ aig_array に入れておく．
+void
+SeqCecMgr::make_logic(const BNetwork& network,
+		      vector<AigHandle>& aig_array)
+{
+  BNodeVector node_list;
+  network.tsort(node_list);
+  ymuint nv = network.logic_node_num();
+  for (ymuint j = 0; j < nv; ++ j) {
+    BNode* bnode = node_list[j];
+    ymuint ni = bnode->ni();
+    vector<AigHandle> ianodes(ni);
+    for (ymuint pos = 0; pos < ni; ++ pos) {
+      ianodes[pos] = aig_array[bnode->fanin(pos)->id()];
+    }
+    aig_array[bnode->id()] = mAigMgr.make_logic(bnode->func(), ianodes);
+  }
+}
+
+// @brief シミュレーションで latch の対応関係の候補を作る．
+void
+SeqCecMgr::find_candidates()
+{
+  // 各 latch の時刻ごとの値を並べたものをシグネチャとする．
+  // 0 番めは定数0
+  vector<vector<ymuint32> > sig(mLatchNum + 1);
+  vector<ymuint32> cur_state(mLatchNum);
+  for (ymuint i = 0; i < mLatchNum; ++ i) {
+    cur_state[i] = mInitVal[i] ? ~0U : 0U;
+  }
+  ymuint nn = mAigMgr.node_num();
+  vector<ymuint32> val(nn);
+  for (ymuint t = 0; t < kSimCycles; ++ t) {
+    sig[0].push_back(0U);
+    for (ymuint i = 0; i < mLatchNum; ++ i) {
+      sig[i + 1].push_back(cur_state[i]);
+    }
+    for (ymuint i = 0; i < nn; ++ i) {
+      AigNode* node = mAigMgr.node(i);
+      if ( node->is_input() ) {
+	ymuint iid = node->input_id();
+	if ( iid < mInputNum ) {
+	  val[i] = mRandGen.int32();
+	}
+	else {
+	  val[i] = cur_state[iid - mInputNum];
+	}
+      }
+      else {
+	ymuint32 val0 = val[node->fanin0()->node_id()];
+	if ( node->fanin0_inv() ) {
+	  val0 = ~val0;
+	}
+	ymuint32 val1 = val[node->fanin1()->node_id()];
+	if ( node->fanin1_inv() ) {
+	  val1 = ~val1;
+	}
+	val[i] = val0 & val1;
+      }
+    }
+    for (ymuint i = 0; i < mLatchNum; ++ i) {
+      cur_state[i] = handle_val(mNextHandles[i], val);
+    }
+  }
+
+  // 最初の値の最下位ビットが 0 になるように正規化する．
+  mPhase.clear();
+  mPhase.resize(mLatchNum + 1, 0);
+  for (ymuint i = 0; i <= mLatchNum; ++ i) {
+    if ( sig[i][0] & 1U ) {
+      mPhase[i] = 1;
+      for (ymuint t = 0; t < kSimCycles; ++ t) {
+	sig[i][t] = ~sig[i][t];
+      }
+    }
+  }
+
+  // シグネチャの等しいものをまとめる．
+  vector<ymuint32> order(mLatchNum + 1);
+  for (ymuint i = 0; i <= mLatchNum; ++ i) {
+    order[i] = i;
+  }
+  sort(order.begin(), order.end(), SigLt(sig));
+  mClassList.clear();
+  for (ymuint b = 0; b <= mLatchNum; ) {
+    ymuint e = b + 1;
+    for ( ; e <= mLatchNum && sig[order[e]] == sig[order[b]]; ++ e) ;
+    if ( e - b > 1 ) {
+      mClassList.push_back(vector<ymuint32>(order.begin() + b,
+					    order.begin() + e));
+    }
+    b = e;
+  }
+}
+
+// @brief 初期状態で成り立たない対応関係を取り除く．
+void
+SeqCecMgr::check_base()
+{
+  // 正規化した初期値で分ける．
+  vector<vector<ymuint32> > new_list;
+  for (vector<vector<ymuint32> >::iterator p = mClassList.begin();
+       p != mClassList.end(); ++ p) {
+    vector<ymuint32> group[2];
+    for (vector<ymuint32>::iterator q = p->begin(); q != p->end(); ++ q) {
+      ymuint id = *q;
+      int v = (id == 0) ? 0 : mInitVal[id - 1];
+      group[v ^ mPhase[id]].push_back(id);
+    }
+    for (ymuint i = 0; i < 2; ++ i) {
+      if ( group[i].size() > 1 ) {
+	new_list.push_back(group[i]);
+      }
+    }
+  }
+  mClassList.swap(new_list);
+}
+
+// @brief 帰納法で成り立たない対応関係を取り除く．
+// @return 繰り返しの回数を返す．
+ymuint
+SeqCecMgr::refine_by_induction()
+{
+  // 現状態で対応関係が成り立つと仮定して次状態でも成り立つかを調べる．
+  // 成り立たないものがあればグループを分割して繰り返す．
+  ymuint niter = 0;
+  for (bool changed = true; changed; ) {
+    changed = false;
+    ++ niter;
+
+    FraigMgr* fraig_mgr = new_fraig_mgr();
+    vector<FraigHandle> latch_handles;
+    make_free_state(*fraig_mgr, latch_handles);
+    vector<FraigHandle> next_handles;
+    vector<FraigHandle> output_handles;
+    make_frame(*fraig_mgr, latch_handles, next_handles, output_handles);
+
+    // 信号の番号をキーにして次状態のハンドルを(正規化して)得る．
+    vector<FraigHandle> next_sig(mLatchNum + 1);
+    next_sig[0] = fraig_mgr->make_zero();
+    for (ymuint i = 0; i < mLatchNum; ++ i) {
+      FraigHandle h = next_handles[i];
+      next_sig[i + 1] = mPhase[i + 1] ? ~h : h;
+    }
+
+    vector<vector<ymuint32> > new_list;
+    for (vector<vector<ymuint32> >::iterator p = mClassList.begin();
+	 p != mClassList.end(); ++ p) {
+      // 各グループの代表と等しいものをまとめる．
+      vector<vector<ymuint32> > group_list;
+      for (vector<ymuint32>::iterator q = p->begin(); q != p->end(); ++ q) {
+	ymuint id = *q;
+	bool found = false;
+	for (vector<vector<ymuint32> >::iterator r = group_list.begin();
+	     r != group_list.end(); ++ r) {
+	  ymuint rep = (*r)[0];
+	  if ( fraig_mgr->check_equiv(next_sig[rep], next_sig[id]) == kB3True ) {
+	    r->push_back(id);
+	    found = true;
+	    break;
+	  }
+	}
+	if ( !found ) {
+	  group_list.push_back(vector<ymuint32>(1, id));
+	}
+      }
+      if ( group_list.size() > 1 ) {
+	changed = true;
+      }
+      for (vector<vector<ymuint32> >::iterator r = group_list.begin();
+	   r != group_list.end(); ++ r) {
+	if ( r->size() > 1 ) {
+	  new_list.push_back(*r);
+	}
+      }
+    }
+    mClassList.swap(new_list);
+    delete fraig_mgr;
+  }
+  return niter;
+}
+
+// @brief FraigMgr を作る．
+FraigMgr*
+SeqCecMgr::new_fraig_mgr()
+{
+  FraigMgr* fraig_mgr = new FraigMgr(mSigSize, mSatType, mSatOpt, mSatOut);
+  return fraig_mgr;
+}
+
+// @brief リセット状態の latch のハンドルを作る．
+void
+SeqCecMgr::make_init_state(FraigMgr& fraig_mgr,
+			   vector<FraigHandle>& latch_handles)
+{
+  latch_handles.resize(mLatchNum);
+  for (ymuint i = 0; i < mLatchNum; ++ i) {
+    if ( mInitVal[i] ) {
+      latch_handles[i] = fraig_mgr.make_one();
+    }
+    else {
+      latch_handles[i] = fraig_mgr.make_zero();
+    }
+  }
+}
+
+// @brief 対応関係を仮定した自由な状態の latch のハンドルを作る．
+void
+SeqCecMgr::make_free_state(FraigMgr& fraig_mgr,
+			   vector<FraigHandle>& latch_handles)
+{
+  // 信号の番号をキーにした(正規化した)ハンドル
+  vector<FraigHandle> sig_handles(mLatchNum + 1);
+  vector<bool> done(mLatchNum + 1, false);
+  sig_handles[0] = fraig_mgr.make_zero();
+  done[0] = true;
+  for (vector<vector<ymuint32> >::iterator p = mClassList.begin();
+       p != mClassList.end(); ++ p) {
+    ymuint rep = (*p)[0];
+    if ( !done[rep] ) {
+      sig_handles[rep] = fraig_mgr.make_input();
+      done[rep] = true;
+    }
+    for (vector<ymuint32>::iterator q = p->begin() + 1; q != p->end(); ++ q) {
+      sig_handles[*q] = sig_handles[rep];
+      done[*q] = true;
+    }
+  }
+  latch_handles.resize(mLatchNum);
+  for (ymuint i = 0; i < mLatchNum; ++ i) {
+    ymuint id = i + 1;
+    if ( !done[id] ) {
+      latch_handles[i] = fraig_mgr.make_input();
+    }
+    else {
+      FraigHandle h = sig_handles[id];
+      latch_handles[i] = mPhase[id] ? ~h : h;
+    }
+  }
+}
+
+// @brief 1時刻分の回路を展開する．
+// @param[in] fraig_mgr 展開先の FraigMgr
+// @param[in] latch_handles 現時刻の latch のハンドル
+// @param[out] next_handles 次時刻の latch のハンドル
+// @param[out] output_handles 出力のハンドル (2つのネットワークの交互)
+// @note 外部入力はこの時刻用に新しく作る．
+void
+SeqCecMgr::make_frame(FraigMgr& fraig_mgr,
+		      const vector<FraigHandle>& latch_handles,
+		      vector<FraigHandle>& next_handles,
+		      vector<FraigHandle>& output_handles)
+{
+  // AIG のノードは入力からのトポロジカル順に並んでいる．
+  ymuint nn = mAigMgr.node_num();
+  vector<FraigHandle> map(nn);
+  for (ymuint i = 0; i < nn; ++ i) {
+    AigNode* node = mAigMgr.node(i);
+    if ( node->is_input() ) {
+      ymuint iid = node->input_id();
+      if ( iid < mInputNum ) {
+	map[i] = fraig_mgr.make_input();
+      }
+      else {
+	map[i] = latch_handles[iid - mInputNum];
+      }
+    }
+    else {
+      FraigHandle h0 = conv_handle(node->fanin0_handle(), fraig_mgr, map);
+      FraigHandle h1 = conv_handle(node->fanin1_handle(), fraig_mgr, map);
+      map[i] = fraig_mgr.make_and(h0, h1);
+    }
+  }
+
+  next_handles.resize(mLatchNum);
+  for (ymuint i = 0; i < mLatchNum; ++ i) {
+    next_handles[i] = conv_handle(mNextHandles[i], fraig_mgr, map);
+  }
+  ymuint no = mOutputPairs.size();
+  output_handles.resize(no * 2);
+  for (ymuint i = 0; i < no; ++ i) {
+    output_handles[i * 2 + 0] = conv_handle(mOutputPairs[i].first,
+					    fraig_mgr, map);
+    output_handles[i * 2 + 1] = conv_handle(mOutputPairs[i].second,
+					    fraig_mgr, map);
+  }
+}
+
+END_NAMESPACE_YM_CEC
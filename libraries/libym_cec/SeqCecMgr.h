@@ -0,0 +1,203 @@
+#ifndef LIBYM_CEC_SEQCECMGR_H
+#define LIBYM_CEC_SEQCECMGR_H
+
+/// @file libym_cec/SeqCecMgr.h
+/// @brief SeqCecMgr のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_cec/cec_nsdef.h"
+#include "ym_aig/AigMgr.h"
+#include "ym_aig/AigHandle.h"
+#include "ym_utils/RandGen.h"
+#include "FraigHandle.h"
+
+
+BEGIN_NAMESPACE_YM_CEC
+
+class FraigMgr;
+
+//////////////////////////////////////////////////////////////////////
+/// @class SeqCecMgr SeqCecMgr.h "SeqCecMgr.h"
+/// @brief 順序回路の等価検証を行うクラス
+///
+/// 2つのネットワークの積機械の1時刻分を AIG で表し，
+/// - リセット状態からのランダムシミュレーションで latch の対応関係の
+///   候補を作り，
+/// - van Eijk の方法(帰納法)で成り立つ対応関係だけを残し，
+/// - 対応関係を仮定しても等価にならない出力は BMC と k-induction
+///   で調べる．
+/// 各時刻の展開は FraigMgr 上で行う．
+//////////////////////////////////////////////////////////////////////
+class SeqCecMgr
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] src_network1, src_network2 検証対象のネットワーク
+  /// @param[in] iassoc 対応する2つのネットワークの入力のペアのリスト
+  /// @param[in] oassoc 対応する2つのネットワークの出力のペアのリスト
+  SeqCecMgr(const BNetwork& src_network1,
+	    const BNetwork& src_network2,
+	    const vector<pair<ymuint32, ymuint32> >& iassoc,
+	    const vector<pair<ymuint32, ymuint32> >& oassoc);
+
+  /// @brief デストラクタ
+  ~SeqCecMgr();
+
+
+public:
+
+  /// @brief SAT ソルバの設定を行う．
+  /// @param[in] sat_type SAT-solver の種類を表す文字列
+  /// @param[in] sat_opt SAT-solver に渡すオプション文字列
+  /// @param[in] sat_out ログの出力用ストリーム
+  void
+  set_sat(const string& sat_type,
+	  const string& sat_opt,
+	  ostream* sat_out);
+
+  /// @brief FraigMgr のシグネチャのサイズを設定する．
+  void
+  set_sigsize(ymuint sigsize);
+
+  /// @brief BMC と k-induction の最大の深さを設定する．
+  void
+  set_max_depth(ymuint depth);
+
+  /// @brief ログレベルを設定する．
+  void
+  set_loglevel(int level);
+
+  /// @brief ログ出力用ストリームを設定する．
+  void
+  set_logstream(ostream* out);
+
+  /// @brief 検証を行う．
+  /// @param[out] stats 出力ごとの結果を格納する配列
+  /// @note 結果はリセット状態から到達可能な全ての状態で等価なら
+  /// kB3True，BMC で反例が見つかったら kB3False，わからなければ kB3X
+  void
+  check(vector<Bool3>& stats);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 下請け関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ネットワークの組み合わせ回路部分を AIG にする．
+  /// @param[in] network 対象のネットワーク
+  /// @param[in] aig_array ノード番号をキーにして AIG を格納する配列
+  /// @note 外部入力と latch の AIG はあらかじめ aig_array に入れておく．
+  void
+  make_logic(const BNetwork& network,
+	     vector<AigHandle>& aig_array);
+
+  /// @brief シミュレーションで latch の対応関係の候補を作る．
+  void
+  find_candidates();
+
+  /// @brief 初期状態で成り立たない対応関係を取り除く．
+  void
+  check_base();
+
+  /// @brief 帰納法で成り立たない対応関係を取り除く．
+  /// @return 繰り返しの回数を返す．
+  ymuint
+  refine_by_induction();
+
+  /// @brief FraigMgr を作る．
+  FraigMgr*
+  new_fraig_mgr();
+
+  /// @brief リセット状態の latch のハンドルを作る．
+  void
+  make_init_state(FraigMgr& fraig_mgr,
+		  vector<FraigHandle>& latch_handles);
+
+  /// @brief 対応関係を仮定した自由な状態の latch のハンドルを作る．
+  void
+  make_free_state(FraigMgr& fraig_mgr,
+		  vector<FraigHandle>& latch_handles);
+
+  /// @brief 1時刻分の回路を展開する．
+  /// @param[in] fraig_mgr 展開先の FraigMgr
+  /// @param[in] latch_handles 現時刻の latch のハンドル
+  /// @param[out] next_handles 次時刻の latch のハンドル
+  /// @param[out] output_handles 出力のハンドル (2つのネットワークの交互)
+  /// @note 外部入力はこの時刻用に新しく作る．
+  void
+  make_frame(FraigMgr& fraig_mgr,
+	     const vector<FraigHandle>& latch_handles,
+	     vector<FraigHandle>& next_handles,
+	     vector<FraigHandle>& output_handles);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 積機械の1時刻分を表す AIG
+  // 入力は外部入力，ネットワーク1の latch，ネットワーク2の latch の順
+  AigMgr mAigMgr;
+
+  // 外部入力の数
+  ymuint32 mInputNum;
+
+  // latch の数 (2つのネットワークの合計)
+  ymuint32 mLatchNum;
+
+  // latch の次状態関数
+  vector<AigHandle> mNextHandles;
+
+  // 比較する出力のペア
+  vector<pair<AigHandle, AigHandle> > mOutputPairs;
+
+  // latch の初期値 (不定の場合は 0)
+  vector<int> mInitVal;
+
+  // 対応関係を表す信号の番号は 0 が定数0，i + 1 が i 番めの latch
+
+  // シミュレーション値の正規化用の極性
+  vector<ymuint8> mPhase;
+
+  // 対応関係のグループのリスト
+  // 各グループは番号の昇順に並んでいて先頭が代表となる．
+  vector<vector<ymuint32> > mClassList;
+
+  // SAT ソルバの種類
+  string mSatType;
+
+  // SAT ソルバのオプション
+  string mSatOpt;
+
+  // SAT ソルバのログ出力用のストリーム
+  ostream* mSatOut;
+
+  // FraigMgr のシグネチャのサイズ
+  ymuint32 mSigSize;
+
+  // BMC と k-induction の最大の深さ
+  ymuint32 mMaxDepth;
+
+  // 乱数発生器
+  RandGen mRandGen;
+
+  // ログレベル
+  int mLogLevel;
+
+  // ログ出力用のストリーム
+  ostream* mLogStream;
+
+};
+
+END_NAMESPACE_YM_CEC
+
+#endif // LIBYM_CEC_SEQCECMGR_H
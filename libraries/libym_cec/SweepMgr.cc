@@ -0,0 +1,774 @@
+
+/// @file libym_cec/SweepMgr.cc
+/// @brief SweepMgr の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "SweepMgr.h"
+#include "ym_aig/AigNode.h"
+#include "ym_utils/StopWatch.h"
+
+
+BEGIN_NAMESPACE_YM_CEC
+
+BEGIN_NONAMESPACE
+
+// 最初に行うランダムシミュレーションのワード数
+const ymuint kInitPatNum = 64;
+
+// 1回に配るジョブ数 (スレッドあたり)
+const ymuint kJobNum = 16;
+
+// 1つの反例から作るパタン数 (32 の約数)
+const ymuint kCexBits = 8;
+
+// SAT ソルバの変数がこの数を超えたら作り直す．
+// 充足可能な時の SAT の手間は変数の数に比例するので大きくしすぎない．
+// 等価なノードは代表ノードに置き換えて CNF を作るので作り直しても
+// 証明済みの情報は失われない．
+const ymuint kRecycleVarNum = 5000;
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス SweepMgr
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] aig_mgr 対象の AIG
+// @param[in] sat_type SAT-solver の種類を表す文字列
+// @param[in] sat_opt SAT-solver に渡すオプション文字列
+// @param[in] thread_num SAT ソルバのスレッド数
+SweepMgr::SweepMgr(const AigMgr& aig_mgr,
+		   const string& sat_type,
+		   const string& sat_opt,
+		   ymuint thread_num) :
+  mAigMgr(aig_mgr),
+  mSatType(sat_type),
+  mSatOpt(sat_opt),
+  mThreadNum(thread_num),
+  mNextJob(0),
+  mJobEnd(0),
+  mGeneration(0),
+  mDoneNum(0),
+  mQuit(false),
+  mSimCount(0),
+  mSimTime(0.0),
+  mProvedNum(0),
+  mCexNum(0),
+  mAbortNum(0),
+  mSweepTime(0.0),
+  mLogLevel(0),
+  mLogStream(NULL)
+{
+  if ( mThreadNum == 0 ) {
+    mThreadNum = 1;
+  }
+
+  // ノード番号 0 は定数0
+  mNodeNum = aig_mgr.node_num() + 1;
+  mFanin0.resize(mNodeNum, 0);
+  mFanin1.resize(mNodeNum, 0);
+  mInputId.resize(mNodeNum, 0);
+  for (ymuint i = 1; i < mNodeNum; ++ i) {
+    AigNode* node = aig_mgr.node(i - 1);
+    if ( node->is_input() ) {
+      mInputId[i] = node->input_id() + 1;
+    }
+    else {
+      mFanin0[i] = (node->fanin0()->node_id() + 1) * 2 + node->fanin0_inv();
+      mFanin1[i] = (node->fanin1()->node_id() + 1) * 2 + node->fanin1_inv();
+    }
+  }
+  mPhase.resize(mNodeNum, 0);
+  mClassId.resize(mNodeNum, -1);
+  mRepLit.resize(mNodeNum);
+  for (ymuint i = 0; i < mNodeNum; ++ i) {
+    mRepLit[i] = i * 2;
+  }
+  mAborted.resize(mNodeNum, false);
+
+  pthread_mutex_init(&mMutex, NULL);
+  pthread_cond_init(&mJobCond, NULL);
+  pthread_cond_init(&mDoneCond, NULL);
+
+  for (ymuint i = 0; i < mThreadNum; ++ i) {
+    mWorkerList.push_back(new_worker());
+  }
+  if ( mThreadNum > 1 ) {
+    for (ymuint i = 0; i < mThreadNum; ++ i) {
+      Worker* w = mWorkerList[i];
+      pthread_create(&w->mThread, NULL, thread_main, w);
+    }
+  }
+}
+
+// @brief デストラクタ
+SweepMgr::~SweepMgr()
+{
+  if ( mThreadNum > 1 ) {
+    pthread_mutex_lock(&mMutex);
+    mQuit = true;
+    pthread_cond_broadcast(&mJobCond);
+    pthread_mutex_unlock(&mMutex);
+    for (ymuint i = 0; i < mThreadNum; ++ i) {
+      pthread_join(mWorkerList[i]->mThread, NULL);
+    }
+  }
+  for (ymuint i = 0; i < mThreadNum; ++ i) {
+    Worker* w = mWorkerList[i];
+    delete w->mSolver;
+    delete w;
+  }
+  pthread_cond_destroy(&mDoneCond);
+  pthread_cond_destroy(&mJobCond);
+  pthread_mutex_destroy(&mMutex);
+}
+
+// @brief ログレベルを設定する．
+void
+SweepMgr::set_loglevel(int level)
+{
+  mLogLevel = level;
+}
+
+// @brief ログ出力用ストリームを設定する．
+void
+SweepMgr::set_logstream(ostream* out)
+{
+  mLogStream = out;
+}
+
+// @brief 内部ノードの等価性を調べて代表ノードにまとめる．
+void
+SweepMgr::sweep()
+{
+  StopWatch sw;
+  sw.start();
+
+  // 最初は全ノードを1つのグループにしてランダムパタンで分割する．
+  mClassList.clear();
+  mClassList.push_back(vector<ymuint32>(mNodeNum));
+  for (ymuint i = 0; i < mNodeNum; ++ i) {
+    mClassList[0][i] = i;
+    mClassId[i] = 0;
+  }
+  ymuint ni = mAigMgr.input_num();
+  vector<ymuint32> ipat(ni);
+  for (ymuint w = 0; w < kInitPatNum; ++ w) {
+    for (ymuint i = 0; i < ni; ++ i) {
+      ipat[i] = mRandGen.int32();
+    }
+    refine(ipat);
+  }
+  if ( mLogLevel > 0 && mLogStream ) {
+    ymuint nc = 0;
+    ymuint ncand = 0;
+    for (vector<vector<ymuint32> >::iterator p = mClassList.begin();
+	 p != mClassList.end(); ++ p) {
+      if ( !p->empty() ) {
+	++ nc;
+	ncand += p->size() - 1;
+      }
+    }
+    *mLogStream << "sweep: " << nc << " classes, "
+		<< ncand << " candidates" << endl;
+  }
+
+  // 候補のノードをトポロジカル順に代表ノードと比べる．
+  // 反例で代表ノードから分離されたノードは新しい代表ノードと
+  // 比べるためにもう一度キューに入れる．
+  // その時に代表ノードが変わっていなければ打ち切る．
+  vector<pair<ymuint32, ymuint32> > retry_list;
+  ymuint chunk_size = mThreadNum * kJobNum;
+  ymuint cursor = 1;
+  for ( ; ; ) {
+    mJobList.clear();
+    vector<pair<ymuint32, ymuint32> > tmp_list;
+    tmp_list.swap(retry_list);
+    for (vector<pair<ymuint32, ymuint32> >::iterator p = tmp_list.begin();
+	 p != tmp_list.end(); ++ p) {
+      ymuint id = p->first;
+      ymint c = mClassId[id];
+      if ( c < 0 || mClassList[c][0] == id ) {
+	continue;
+      }
+      if ( mClassList[c][0] == p->second ) {
+	// 反例で分離できなかった．
+	mAborted[id] = true;
+	++ mAbortNum;
+	continue;
+      }
+      Job job;
+      job.mNode1 = mClassList[c][0];
+      job.mNode2 = id;
+      job.mInv = (mPhase[job.mNode1] != mPhase[id]);
+      mJobList.push_back(job);
+    }
+    for ( ; mJobList.size() < chunk_size && cursor < mNodeNum; ++ cursor) {
+      ymuint id = cursor;
+      ymint c = mClassId[id];
+      if ( c < 0 || mClassList[c][0] == id ) {
+	continue;
+      }
+      Job job;
+      job.mNode1 = mClassList[c][0];
+      job.mNode2 = id;
+      job.mInv = (mPhase[job.mNode1] != mPhase[id]);
+      mJobList.push_back(job);
+    }
+    if ( mJobList.empty() ) {
+      break;
+    }
+
+    run_jobs(0, mJobList.size());
+
+    // 結果を反映させる．
+    vector<Job*> cex_list;
+    for (vector<Job>::iterator p = mJobList.begin();
+	 p != mJobList.end(); ++ p) {
+      Job& job = *p;
+      ymuint id = job.mNode2;
+      if ( job.mResult == kB3True ) {
+	mRepLit[id] = job.mNode1 * 2 + (job.mInv ? 1 : 0);
+	mProvedList.push_back(id);
+	++ mProvedNum;
+      }
+      else if ( job.mResult == kB3False ) {
+	cex_list.push_back(&job);
+	retry_list.push_back(make_pair(id, job.mNode1));
+	++ mCexNum;
+      }
+      else {
+	mAborted[id] = true;
+	++ mAbortNum;
+      }
+    }
+
+    // 反例ごとに kCexBits ビットのパタンを作ってシミュレーションする．
+    // 先頭のビットが反例そのもので，残りのビットは反例の TFI に
+    // 含まれる入力を1つだけ反転させた距離1のパタン．
+    ymuint ncex = cex_list.size();
+    for (ymuint b = 0; b < ncex; b += 32 / kCexBits) {
+      for (ymuint i = 0; i < ni; ++ i) {
+	ipat[i] = mRandGen.int32();
+      }
+      for (ymuint k = 0; k < 32 / kCexBits && b + k < ncex; ++ k) {
+	const vector<ymuint8>& cex = cex_list[b + k]->mCex;
+	ymuint32 mask = (~0U >> (32 - kCexBits)) << (k * kCexBits);
+	vector<ymuint32> cone_inputs;
+	for (ymuint i = 0; i < ni; ++ i) {
+	  ymuint8 val = cex[i];
+	  if ( val != 2 ) {
+	    if ( val == 1 ) {
+	      ipat[i] |= mask;
+	    }
+	    else {
+	      ipat[i] &= ~mask;
+	    }
+	    cone_inputs.push_back(i);
+	  }
+	}
+	ymuint nci = cone_inputs.size();
+	if ( nci > 0 ) {
+	  for (ymuint j = 1; j < kCexBits; ++ j) {
+	    ymuint i = cone_inputs[mRandGen.int32() % nci];
+	    ipat[i] ^= (1U << (k * kCexBits + j));
+	  }
+	}
+      }
+      refine(ipat);
+    }
+  }
+
+  sw.stop();
+  mSweepTime = sw.time().usr_time();
+
+  if ( mLogLevel > 0 && mLogStream ) {
+    *mLogStream << "sweep: " << mProvedNum << " proved, "
+		<< mCexNum << " disproved, "
+		<< mAbortNum << " aborted, "
+		<< mSweepTime << " sec." << endl;
+  }
+}
+
+// @brief 2つのハンドルが等価かどうか調べる．
+// @param[in] comp_pairs 比較対象のハンドルのペアのリスト
+// @param[out] stats 結果を格納する配列
+// @note sweep() の後で呼び出す．
+void
+SweepMgr::check_equiv(const vector<pair<AigHandle, AigHandle> >& comp_pairs,
+		      vector<Bool3>& stats)
+{
+  ymuint n = comp_pairs.size();
+  stats.clear();
+  stats.resize(n, kB3X);
+
+  // 代表ノードが同じものとシミュレーションで区別できるものは
+  // SAT を使わずに決まる．
+  mJobList.clear();
+  vector<ymuint32> pos_list;
+  for (ymuint i = 0; i < n; ++ i) {
+    ymuint id1;
+    bool inv1;
+    resolve(comp_pairs[i].first, id1, inv1);
+    ymuint id2;
+    bool inv2;
+    resolve(comp_pairs[i].second, id2, inv2);
+    if ( id1 == id2 ) {
+      stats[i] = (inv1 == inv2) ? kB3True : kB3False;
+      continue;
+    }
+    ymint c = mClassId[id1];
+    if ( c < 0 || c != mClassId[id2] ||
+	 (mPhase[id1] ^ inv1) != (mPhase[id2] ^ inv2) ) {
+      stats[i] = kB3False;
+      continue;
+    }
+    Job job;
+    job.mNode1 = id1;
+    job.mNode2 = id2;
+    job.mInv = (inv1 != inv2);
+    mJobList.push_back(job);
+    pos_list.push_back(i);
+  }
+
+  run_jobs(0, mJobList.size());
+
+  for (ymuint i = 0; i < mJobList.size(); ++ i) {
+    stats[pos_list[i]] = mJobList[i].mResult;
+  }
+}
+
+// @brief 内部の統計情報を出力する．
+void
+SweepMgr::dump_stats(ostream& s) const
+{
+  s << "=====<< SweepMgr Statistics >> =====" << endl;
+  s << "simulation:" << endl
+    << " total " << mSimCount << " words" << endl
+    << " total " << mSimTime << " sec." << endl;
+  s << "----------------------------------" << endl;
+  s << "sweep:" << endl
+    << " total " << mProvedNum << " proved" << endl
+    << " total " << mCexNum << " counter examples" << endl
+    << " total " << mAbortNum << " aborted" << endl
+    << " total " << mSweepTime << " sec." << endl;
+  s << "----------------------------------" << endl;
+  for (ymuint i = 0; i < mThreadNum; ++ i) {
+    Worker* w = mWorkerList[i];
+    SatStats stats;
+    w->mSolver->get_stats(stats);
+    s << "sat stat#" << i << ":" << endl
+      << "  SAT calls         : " << w->mSatCount << endl
+      << "  SAT time          : " << w->mSatTime << endl
+      << "  recycles          : " << w->mRecycleCount << endl
+      << "  variables         : " << w->mSolver->variable_num() << endl
+      << "  conflicts         : " << stats.mConflictNum << endl
+      << "  decisions         : " << stats.mDecisionNum << endl
+      << "  propagations      : " << stats.mPropagationNum << endl;
+  }
+}
+
+// @brief 入力のパタンを与えて全ノードのシミュレーションを行い
+// 等価候補グループを分割する．
+// @param[in] ipat 入力のパタン
+void
+SweepMgr::refine(const vector<ymuint32>& ipat)
+{
+  StopWatch sw;
+  sw.start();
+
+  vector<ymuint32> val(mNodeNum);
+  val[0] = 0U;
+  for (ymuint i = 1; i < mNodeNum; ++ i) {
+    if ( mInputId[i] ) {
+      val[i] = ipat[mInputId[i] - 1];
+    }
+    else {
+      ymuint32 lit0 = mFanin0[i];
+      ymuint32 val0 = val[lit0 >> 1];
+      if ( lit0 & 1U ) {
+	val0 = ~val0;
+      }
+      ymuint32 lit1 = mFanin1[i];
+      ymuint32 val1 = val[lit1 >> 1];
+      if ( lit1 & 1U ) {
+	val1 = ~val1;
+      }
+      val[i] = val0 & val1;
+    }
+  }
+
+  // 最初のパタンの最下位ビットが 0 になるように正規化する．
+  if ( mSimCount == 0 ) {
+    for (ymuint i = 0; i < mNodeNum; ++ i) {
+      mPhase[i] = val[i] & 1U;
+    }
+  }
+  for (ymuint i = 0; i < mNodeNum; ++ i) {
+    if ( mPhase[i] ) {
+      val[i] = ~val[i];
+    }
+  }
+
+  // 等価候補グループを分割する．
+  // 分割されなかったグループはそのままにしておき，分割されたグループは
+  // 最初の部分をもとの位置に，残りを末尾に置く．
+  // 要素数が2以上の部分がなくなったグループは空にする．
+  vector<pair<ymuint32, ymuint32> > tmp;
+  ymuint nc = mClassList.size();
+  for (ymuint c = 0; c < nc; ++ c) {
+    vector<ymuint32>& elem_list = mClassList[c];
+    ymuint n = elem_list.size();
+    if ( n == 0 ) {
+      continue;
+    }
+    ymuint32 val0 = val[elem_list[0]];
+    ymuint i = 1;
+    for ( ; i < n && val[elem_list[i]] == val0; ++ i) ;
+    if ( i == n ) {
+      // 分割されなかった．
+      continue;
+    }
+
+    // 値でソートすると値ごとにノード番号の昇順に並ぶ．
+    tmp.clear();
+    tmp.reserve(n);
+    for (i = 0; i < n; ++ i) {
+      ymuint id = elem_list[i];
+      tmp.push_back(make_pair(val[id], id));
+    }
+    sort(tmp.begin(), tmp.end());
+    elem_list.clear();
+    bool first = true;
+    for (ymuint b = 0; b < n; ) {
+      ymuint e = b + 1;
+      for ( ; e < n && tmp[e].first == tmp[b].first; ++ e) ;
+      if ( e - b == 1 ) {
+	mClassId[tmp[b].second] = -1;
+      }
+      else {
+	ymint c1 = c;
+	if ( first ) {
+	  first = false;
+	}
+	else {
+	  c1 = mClassList.size();
+	  mClassList.push_back(vector<ymuint32>());
+	}
+	// mClassList.push_back() で elem_list が無効になるので
+	// 添字でアクセスする．
+	vector<ymuint32>& new_class = mClassList[c1];
+	new_class.reserve(e - b);
+	for (ymuint j = b; j < e; ++ j) {
+	  new_class.push_back(tmp[j].second);
+	  mClassId[tmp[j].second] = c1;
+	}
+      }
+      b = e;
+    }
+  }
+
+  ++ mSimCount;
+  sw.stop();
+  mSimTime += sw.time().usr_time();
+}
+
+// @brief mJobList[begin:end) をスレッドで処理する．
+void
+SweepMgr::run_jobs(ymuint begin,
+		   ymuint end)
+{
+  mNextJob = begin;
+  mJobEnd = end;
+  if ( mThreadNum == 1 ) {
+    do_jobs(mWorkerList[0]);
+    return;
+  }
+
+  pthread_mutex_lock(&mMutex);
+  mDoneNum = 0;
+  ++ mGeneration;
+  pthread_cond_broadcast(&mJobCond);
+  while ( mDoneNum < mThreadNum ) {
+    pthread_cond_wait(&mDoneCond, &mMutex);
+  }
+  pthread_mutex_unlock(&mMutex);
+}
+
+// @brief ハンドルに対応するノード番号と極性を得る．
+// @note 等価と証明されたノードは代表ノードに置き換える．
+void
+SweepMgr::resolve(AigHandle handle,
+		  ymuint& id,
+		  bool& inv) const
+{
+  if ( handle.is_const() ) {
+    id = 0;
+    inv = handle.is_one();
+    return;
+  }
+  // 代表ノードは等価候補グループの先頭なので他のノードに
+  // 置き換えられることはない．
+  ymuint32 lit = mRepLit[handle.node_id() + 1];
+  id = lit >> 1;
+  inv = static_cast<bool>(lit & 1U) ^ handle.inv();
+}
+
+// @brief Worker を作る．
+SweepMgr::Worker*
+SweepMgr::new_worker()
+{
+  Worker* w = new Worker;
+  w->mMgr = this;
+  w->mSolver = NULL;
+  w->mLitMap.resize(mNodeNum, kLiteralX);
+  w->mSatCount = 0;
+  w->mSatTime = 0.0;
+  w->mRecycleCount = 0;
+  new_solver(w);
+  return w;
+}
+
+// @brief Worker の SAT ソルバを作り直す．
+void
+SweepMgr::new_solver(Worker* w)
+{
+  if ( w->mSolver ) {
+    delete w->mSolver;
+    ++ w->mRecycleCount;
+  }
+  if ( mSatType == "minisat" ) {
+    w->mSolver = SatSolverFactory::gen_minisat();
+  }
+  else {
+    // 複数のスレッドで使うのでログ付きのソルバやポートフォリオは
+    // 使わない．
+    w->mSolver = SatSolverFactory::gen_solver(mSatOpt);
+  }
+  for (vector<ymuint32>::iterator p = w->mLitList.begin();
+       p != w->mLitList.end(); ++ p) {
+    w->mLitMap[*p] = kLiteralX;
+  }
+  w->mLitList.clear();
+
+  tVarId const_var = w->mSolver->new_var();
+  Literal const_lit(const_var, kPolPosi);
+  w->mSolver->add_clause(~const_lit);
+  w->mLitMap[0] = const_lit;
+  w->mLitList.push_back(0);
+
+  // これから作る CNF は代表ノードを用いるので反映済みとしてよい．
+  w->mProvedNum = mProvedList.size();
+}
+
+// @brief スレッドの本体
+void*
+SweepMgr::thread_main(void* arg)
+{
+  Worker* w = reinterpret_cast<Worker*>(arg);
+  w->mMgr->worker_loop(w);
+  return NULL;
+}
+
+// @brief Worker の処理
+void
+SweepMgr::worker_loop(Worker* w)
+{
+  ymuint32 generation = 0;
+  for ( ; ; ) {
+    pthread_mutex_lock(&mMutex);
+    while ( !mQuit && mGeneration == generation ) {
+      pthread_cond_wait(&mJobCond, &mMutex);
+    }
+    if ( mQuit ) {
+      pthread_mutex_unlock(&mMutex);
+      break;
+    }
+    generation = mGeneration;
+    pthread_mutex_unlock(&mMutex);
+
+    do_jobs(w);
+
+    pthread_mutex_lock(&mMutex);
+    ++ mDoneNum;
+    if ( mDoneNum == mThreadNum ) {
+      pthread_cond_signal(&mDoneCond);
+    }
+    pthread_mutex_unlock(&mMutex);
+  }
+}
+
+// @brief 現在のジョブを処理する．
+void
+SweepMgr::do_jobs(Worker* w)
+{
+  apply_proved(w);
+  for ( ; ; ) {
+    ymuint pos = __sync_fetch_and_add(&mNextJob, 1);
+    if ( pos >= mJobEnd ) {
+      break;
+    }
+    do_job(w, mJobList[pos]);
+  }
+}
+
+// @brief ジョブを1つ処理する．
+void
+SweepMgr::do_job(Worker* w,
+		 Job& job)
+{
+  if ( w->mSolver->variable_num() > kRecycleVarNum ) {
+    new_solver(w);
+  }
+
+  Literal lit1 = node_literal(w, job.mNode1);
+  Literal lit2 = node_literal(w, job.mNode2);
+  if ( job.mInv ) {
+    lit2 = ~lit2;
+  }
+
+  StopWatch sw;
+  sw.start();
+  vector<Literal> assumptions(2);
+  assumptions[0] = lit1;
+  assumptions[1] = ~lit2;
+  Bool3 ans = w->mSolver->solve(assumptions, w->mModel);
+  ++ w->mSatCount;
+  if ( ans == kB3False ) {
+    assumptions[0] = ~lit1;
+    assumptions[1] = lit2;
+    ans = w->mSolver->solve(assumptions, w->mModel);
+    ++ w->mSatCount;
+  }
+  sw.stop();
+  w->mSatTime += sw.time().usr_time();
+
+  if ( ans == kB3False ) {
+    job.mResult = kB3True;
+  }
+  else if ( ans == kB3True ) {
+    job.mResult = kB3False;
+    // 反例を記録する．CNF を作っていない入力の値は 2 にしておく．
+    ymuint ni = mAigMgr.input_num();
+    job.mCex.resize(ni);
+    for (ymuint i = 0; i < ni; ++ i) {
+      ymuint id = mAigMgr.input_node(i)->node_id() + 1;
+      Literal lit = w->mLitMap[id];
+      if ( lit == kLiteralX ) {
+	job.mCex[i] = 2;
+      }
+      else {
+	bool val = (w->mModel[lit.varid()] == kB3True);
+	if ( lit.pol() == kPolNega ) {
+	  val = !val;
+	}
+	job.mCex[i] = val ? 1 : 0;
+      }
+    }
+  }
+  else {
+    job.mResult = kB3X;
+  }
+}
+
+// @brief 等価と証明されたノードの情報を CNF に反映させる．
+void
+SweepMgr::apply_proved(Worker* w)
+{
+  ymuint n = mProvedList.size();
+  for (ymuint i = w->mProvedNum; i < n; ++ i) {
+    ymuint id = mProvedList[i];
+    Literal lit = w->mLitMap[id];
+    if ( lit == kLiteralX ) {
+      // これから作る CNF では代表ノードのリテラルが使われる．
+      continue;
+    }
+    ymuint32 rep = mRepLit[id];
+    Literal rlit = node_literal(w, rep >> 1);
+    if ( rep & 1U ) {
+      rlit = ~rlit;
+    }
+    w->mSolver->add_clause(~lit, rlit);
+    w->mSolver->add_clause(lit, ~rlit);
+  }
+  w->mProvedNum = n;
+}
+
+// @brief ノードの CNF の変数を得る．
+// @note 必要なら TFI の CNF を作る．
+Literal
+SweepMgr::node_literal(Worker* w,
+		       ymuint id)
+{
+  vector<Literal>& lit_map = w->mLitMap;
+  if ( lit_map[id] != kLiteralX ) {
+    return lit_map[id];
+  }
+
+  // 深い回路で再帰呼び出しを避けるため自前のスタックを用いる．
+  vector<ymuint32> node_stack;
+  node_stack.push_back(id);
+  while ( !node_stack.empty() ) {
+    ymuint id1 = node_stack.back();
+    if ( lit_map[id1] != kLiteralX ) {
+      node_stack.pop_back();
+      continue;
+    }
+    ymuint32 rep = mRepLit[id1];
+    if ( (rep >> 1) != id1 ) {
+      // 等価と証明されたノードは代表ノードのリテラルを使う．
+      ymuint rep_id = rep >> 1;
+      if ( lit_map[rep_id] == kLiteralX ) {
+	node_stack.push_back(rep_id);
+	continue;
+      }
+      Literal lit = lit_map[rep_id];
+      lit_map[id1] = (rep & 1U) ? ~lit : lit;
+      w->mLitList.push_back(id1);
+      node_stack.pop_back();
+      continue;
+    }
+    if ( mInputId[id1] ) {
+      lit_map[id1] = Literal(w->mSolver->new_var(), kPolPosi);
+      w->mLitList.push_back(id1);
+      node_stack.pop_back();
+      continue;
+    }
+    ymuint32 flit0 = mFanin0[id1];
+    if ( lit_map[flit0 >> 1] == kLiteralX ) {
+      node_stack.push_back(flit0 >> 1);
+      continue;
+    }
+    ymuint32 flit1 = mFanin1[id1];
+    if ( lit_map[flit1 >> 1] == kLiteralX ) {
+      node_stack.push_back(flit1 >> 1);
+      continue;
+    }
+    Literal lit0 = lit_map[flit0 >> 1];
+    if ( flit0 & 1U ) {
+      lit0 = ~lit0;
+    }
+    Literal lit1 = lit_map[flit1 >> 1];
+    if ( flit1 & 1U ) {
+      lit1 = ~lit1;
+    }
+    Literal olit(w->mSolver->new_var(), kPolPosi);
+    w->mSolver->add_clause(~olit, lit0);
+    w->mSolver->add_clause(~olit, lit1);
+    w->mSolver->add_clause(olit, ~lit0, ~lit1);
+    lit_map[id1] = olit;
+    w->mLitList.push_back(id1);
+    node_stack.pop_back();
+  }
+  return lit_map[id];
+}
+
+END_NAMESPACE_YM_CEC
@@ -0,0 +1,326 @@
+#ifndef LIBYM_CEC_SWEEPMGR_H
+#define LIBYM_CEC_SWEEPMGR_H
+
+/// @file libym_cec/SweepMgr.h
+/// @brief SweepMgr のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_cec/cec_nsdef.h"
+#include "ym_aig/AigMgr.h"
+#include "ym_aig/AigHandle.h"
+#include "ym_utils/RandGen.h"
+#include "ym_sat/SatSolver.h"
+#include <pthread.h>
+
+
+BEGIN_NAMESPACE_YM_CEC
+
+//////////////////////////////////////////////////////////////////////
+/// @class SweepMgr SweepMgr.h "SweepMgr.h"
+/// @brief 出来上がった AIG に対して SAT sweeping を行うクラス
+///
+/// FraigMgr がノードを作るたびに等価性を調べるのに対して，こちらは
+/// miter 全体の AIG を対象に
+/// - ランダムシミュレーションで等価候補グループを一度だけ作り，
+/// - 候補のペアをトポロジカル順に複数のスレッドの SAT ソルバで調べ，
+/// - 等価と証明されたノードは代表ノードにまとめ，
+/// - 反例はシミュレーションしてグループを分割する．
+/// 各スレッドは自分専用の SatSolver を持ち，必要になったノードの
+/// CNF だけを作る．等価と証明されたノードはその後作る CNF では代表
+/// ノードの変数で置き換えられる．
+//////////////////////////////////////////////////////////////////////
+class SweepMgr
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] aig_mgr 対象の AIG
+  /// @param[in] sat_type SAT-solver の種類を表す文字列
+  /// @param[in] sat_opt SAT-solver に渡すオプション文字列
+  /// @param[in] thread_num SAT ソルバのスレッド数
+  /// @note aig_mgr はこのオブジェクトよりも長く存在しなければならない．
+  SweepMgr(const AigMgr& aig_mgr,
+	   const string& sat_type,
+	   const string& sat_opt,
+	   ymuint thread_num);
+
+  /// @brief デストラクタ
+  ~SweepMgr();
+
+
+public:
+
+  /// @brief ログレベルを設定する．
+  void
+  set_loglevel(int level);
+
+  /// @brief ログ出力用ストリームを設定する．
+  void
+  set_logstream(ostream* out);
+
+  /// @brief 内部ノードの等価性を調べて代表ノードにまとめる．
+  void
+  sweep();
+
+  /// @brief 2つのハンドルが等価かどうか調べる．
+  /// @param[in] comp_pairs 比較対象のハンドルのペアのリスト
+  /// @param[out] stats 結果を格納する配列
+  /// @note sweep() の後で呼び出す．
+  void
+  check_equiv(const vector<pair<AigHandle, AigHandle> >& comp_pairs,
+	      vector<Bool3>& stats);
+
+  /// @brief 内部の統計情報を出力する．
+  void
+  dump_stats(ostream& s) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // SAT で調べるノードのペア
+  // ノード番号は AIG のノード番号 + 1 で，0 は定数0を表す．
+  struct Job
+  {
+    // コンストラクタ
+    Job() :
+      mNode1(0),
+      mNode2(0),
+      mInv(false),
+      mResult(kB3X)
+    {
+    }
+
+    // 比較するノード(代表ノード)
+    ymuint32 mNode1;
+
+    // 比較されるノード
+    ymuint32 mNode2;
+
+    // 極性 (true で逆相)
+    bool mInv;
+
+    // 結果
+    Bool3 mResult;
+
+    // 反例 (入力の値)
+    vector<ymuint8> mCex;
+
+  };
+
+  // SAT ソルバを持つスレッド
+  struct Worker
+  {
+    // 親のマネージャ
+    SweepMgr* mMgr;
+
+    // スレッド
+    pthread_t mThread;
+
+    // SAT ソルバ
+    SatSolver* mSolver;
+
+    // ノード番号をキーにして CNF のリテラルを格納する配列
+    // まだ CNF を作っていないノードの値は kLiteralX
+    // 等価と証明されたノードは代表ノードのリテラルになる．
+    vector<Literal> mLitMap;
+
+    // mLitMap に登録されたノード番号のリスト
+    vector<ymuint32> mLitList;
+
+    // mProvedList 中で反映済みの要素数
+    ymuint32 mProvedNum;
+
+    // SAT の結果のモデル
+    vector<Bool3> mModel;
+
+    // SAT を呼んだ回数
+    ymuint32 mSatCount;
+
+    // SAT にかかった時間
+    double mSatTime;
+
+    // SAT ソルバを作り直した回数
+    ymuint32 mRecycleCount;
+
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 下請け関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 入力のパタンを与えて全ノードのシミュレーションを行い
+  /// 等価候補グループを分割する．
+  /// @param[in] ipat 入力のパタン
+  void
+  refine(const vector<ymuint32>& ipat);
+
+  /// @brief mJobList[begin:end) をスレッドで処理する．
+  void
+  run_jobs(ymuint begin,
+	   ymuint end);
+
+  /// @brief ハンドルに対応するノード番号と極性を得る．
+  /// @note 等価と証明されたノードは代表ノードに置き換える．
+  void
+  resolve(AigHandle handle,
+	  ymuint& id,
+	  bool& inv) const;
+
+  /// @brief Worker を作る．
+  Worker*
+  new_worker();
+
+  /// @brief Worker の SAT ソルバを作り直す．
+  void
+  new_solver(Worker* w);
+
+  /// @brief スレッドの本体
+  static
+  void*
+  thread_main(void* arg);
+
+  /// @brief Worker の処理
+  void
+  worker_loop(Worker* w);
+
+  /// @brief 現在のジョブを処理する．
+  void
+  do_jobs(Worker* w);
+
+  /// @brief ジョブを1つ処理する．
+  void
+  do_job(Worker* w,
+	 Job& job);
+
+  /// @brief 等価と証明されたノードの情報を CNF に反映させる．
+  void
+  apply_proved(Worker* w);
+
+  /// @brief ノードの CNF の変数を得る．
+  /// @note 必要なら TFI の CNF を作る．
+  Literal
+  node_literal(Worker* w,
+	       ymuint id);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象の AIG
+  const AigMgr& mAigMgr;
+
+  // ノード数 (定数0を含む)
+  ymuint32 mNodeNum;
+
+  // ファンインのリテラル (ノード番号 * 2 + 極性)
+  // 入力ノードの場合は使わない．
+  vector<ymuint32> mFanin0;
+  vector<ymuint32> mFanin1;
+
+  // 入力ノードの場合に入力番号 + 1 を，それ以外は 0 を入れる配列
+  vector<ymuint32> mInputId;
+
+  // 最初のパタンの最下位ビットの値 (シミュレーション値の正規化に使う)
+  vector<ymuint8> mPhase;
+
+  // ノードの等価候補グループ番号 (要素数が1の時は -1)
+  vector<ymint32> mClassId;
+
+  // 等価候補グループのリスト
+  // 各グループはノード番号の昇順に並んでいて先頭が代表となる．
+  vector<vector<ymuint32> > mClassList;
+
+  // 等価と証明されたノードの代表ノードのリテラル
+  // 証明されていないノードは自分自身
+  vector<ymuint32> mRepLit;
+
+  // SAT が失敗したノードの印
+  vector<bool> mAborted;
+
+  // 等価と証明されたノード番号のリスト
+  vector<ymuint32> mProvedList;
+
+  // ジョブのリスト
+  vector<Job> mJobList;
+
+  // SAT ソルバの種類
+  string mSatType;
+
+  // SAT ソルバのオプション
+  string mSatOpt;
+
+  // スレッド数
+  ymuint32 mThreadNum;
+
+  // Worker のリスト
+  vector<Worker*> mWorkerList;
+
+  // 次に処理するジョブの番号
+  volatile ymuint32 mNextJob;
+
+  // 処理するジョブの終わり
+  ymuint32 mJobEnd;
+
+  // ジョブを配った回数
+  ymuint32 mGeneration;
+
+  // 処理を終えたスレッド数
+  ymuint32 mDoneNum;
+
+  // スレッドを終了させる時に true にする．
+  bool mQuit;
+
+  // 排他制御用の mutex
+  pthread_mutex_t mMutex;
+
+  // ジョブを配ったことを知らせる条件変数
+  pthread_cond_t mJobCond;
+
+  // ジョブが終わったことを知らせる条件変数
+  pthread_cond_t mDoneCond;
+
+  // 乱数発生器
+  RandGen mRandGen;
+
+  // シミュレーションの回数
+  ymuint32 mSimCount;
+
+  // シミュレーションの時間
+  double mSimTime;
+
+  // 等価と証明されたペア数
+  ymuint32 mProvedNum;
+
+  // 反例の数
+  ymuint32 mCexNum;
+
+  // アボートしたペア数
+  ymuint32 mAbortNum;
+
+  // sweep() の時間
+  double mSweepTime;
+
+  // ログレベル
+  int mLogLevel;
+
+  // ログ出力用のストリーム
+  ostream* mLogStream;
+
+};
+
+END_NAMESPACE_YM_CEC
+
+#endif // LIBYM_CEC_SWEEPMGR_H
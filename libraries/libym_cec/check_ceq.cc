@@ -13,6 +13,8 @@
 #include "ym_aig/AigMgr.h"
 #include "ym_aig/AigNode.h"
 #include "FraigMgr.h"
+#include "SweepMgr.h"
+#include "SeqCecMgr.h"
 
 
 BEGIN_NAMESPACE_YM_CEC
@@ -207,4 +209,65 @@ check_ceq(const BNetwork& src_network1,
   }
 }
 
+// @brief SAT sweeping を用いて組み合わせ回路の等価検証を行う．
+void
+sweep_ceq(const BNetwork& src_network1,
+	  const BNetwork& src_network2,
+	  const vector<pair<ymuint32, ymuint32> >& iassoc,
+	  const vector<pair<ymuint32, ymuint32> >& oassoc,
+	  ymint log_level,
+	  ostream* log_out,
+	  const string& sat_type,
+	  const string& sat_option,
+	  ymuint thread_num,
+	  vector<Bool3>& stats)
+{
+  // 2つのネットワークの出力の miter 構造を AigMgr に設定する．
+  AigMgr aig_mgr;
+  vector<pair<AigHandle, AigHandle> > comp_pairs;
+  make_miter(aig_mgr, src_network1, src_network2,
+	     iassoc, oassoc,
+	     comp_pairs);
+
+  SweepMgr sweep_mgr(aig_mgr, sat_type, sat_option, thread_num);
+
+  // オプションを設定する．
+  sweep_mgr.set_loglevel(log_level);
+  sweep_mgr.set_logstream(log_out);
+
+  sweep_mgr.sweep();
+  sweep_mgr.check_equiv(comp_pairs, stats);
+
+  if ( log_level > 1 ) {
+    sweep_mgr.dump_stats(*log_out);
+  }
+}
+
+// @brief 順序回路の等価検証を行う．
+void
+check_sceq(const BNetwork& src_network1,
+	   const BNetwork& src_network2,
+	   const vector<pair<ymuint32, ymuint32> >& iassoc,
+	   const vector<pair<ymuint32, ymuint32> >& oassoc,
+	   ymint log_level,
+	   ostream* log_out,
+	   const string& sat_type,
+	   const string& sat_option,
+	   ostream* sat_out,
+	   ymuint sigsize,
+	   ymuint max_depth,
+	   vector<Bool3>& stats)
+{
+  SeqCecMgr seq_mgr(src_network1, src_network2, iassoc, oassoc);
+
+  // オプションを設定する．
+  seq_mgr.set_sat(sat_type, sat_option, sat_out);
+  seq_mgr.set_sigsize(sigsize);
+  seq_mgr.set_max_depth(max_depth);
+  seq_mgr.set_loglevel(log_level);
+  seq_mgr.set_logstream(log_out);
+
+  seq_mgr.check(stats);
+}
+
 END_NAMESPACE_YM_CEC
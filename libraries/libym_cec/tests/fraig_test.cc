@@ -0,0 +1,170 @@
+
+/// @file libym_cec/tests/fraig_test.cc
+/// @brief FraigMgr のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "FraigMgr.h"
+#include "ym_bnet/BNetwork.h"
+#include "ym_bnet/BNetBlifReader.h"
+#include "ym_bnet/BNetDecomp.h"
+#include "ym_utils/StopWatch.h"
+
+
+BEGIN_NAMESPACE_YM_CEC
+
+BEGIN_NONAMESPACE
+
+// ネットワークの組み合わせ回路部分を FraigMgr 上に作る．
+// inputs は外部入力，latch の順に並んでいる．
+// outputs には外部出力，latch の入力の順に追加する．
+void
+make_fraig(const BNetwork& network,
+	   FraigMgr& fraig_mgr,
+	   const vector<FraigHandle>& inputs,
+	   vector<FraigHandle>& outputs)
+{
+  vector<FraigHandle> node_map(network.max_node_id());
+  ymuint pos = 0;
+  for (BNodeList::const_iterator p = network.inputs_begin();
+       p != network.inputs_end(); ++ p, ++ pos) {
+    node_map[(*p)->id()] = inputs[pos];
+  }
+  for (BNodeList::const_iterator p = network.latch_nodes_begin();
+       p != network.latch_nodes_end(); ++ p, ++ pos) {
+    node_map[(*p)->id()] = inputs[pos];
+  }
+
+  BNodeVector node_list;
+  network.tsort(node_list);
+  for (BNodeVector::const_iterator p = node_list.begin();
+       p != node_list.end(); ++ p) {
+    BNode* node = *p;
+    ymuint ni = node->ni();
+    vector<FraigHandle> fanins(ni);
+    for (ymuint i = 0; i < ni; ++ i) {
+      fanins[i] = node_map[node->fanin(i)->id()];
+    }
+    node_map[node->id()] = fraig_mgr.make_logic(node->func(), fanins);
+  }
+
+  for (BNodeList::const_iterator p = network.outputs_begin();
+       p != network.outputs_end(); ++ p) {
+    outputs.push_back(node_map[(*p)->fanin(0)->id()]);
+  }
+  for (BNodeList::const_iterator p = network.latch_nodes_begin();
+       p != network.latch_nodes_end(); ++ p) {
+    outputs.push_back(node_map[(*p)->fanin(0)->id()]);
+  }
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM_CEC
+
+
+// blif ファイルの回路とそれを2入力ノードに分解した回路のミタを
+// FraigMgr で検証する．
+// -r で指定した数だけ独立な入力を持つミタを並べる．
+// blif ファイルを2つ指定した時は2つめの回路を分解したものと比較し，
+// 出力ごとの結果を "output#<番号>: T|F|X" の形で書く．
+// この場合は等価でない出力があってもエラーにしない．
+int
+main(int argc,
+     char** argv)
+{
+  using namespace std;
+  using namespace nsYm;
+  using namespace nsYm::nsCec;
+
+  ymuint ncopy = 1;
+  int base = 1;
+  if ( argc >= 3 && string(argv[1]) == "-r" ) {
+    ncopy = atoi(argv[2]);
+    base = 3;
+  }
+  if ( base + 1 != argc && base + 2 != argc ) {
+    cerr << "USAGE : " << argv[0]
+	 << " [-r <copies>] blif-file [blif-file2]" << endl;
+    return 2;
+  }
+  bool compare2 = (base + 2 == argc);
+
+  BNetwork network1;
+  BNetBlifReader reader;
+  if ( !reader.read(argv[base], network1) ) {
+    cerr << "Error in reading " << argv[base] << endl;
+    return 1;
+  }
+  BNetwork network2;
+  if ( compare2 ) {
+    if ( !reader.read(argv[base + 1], network2) ) {
+      cerr << "Error in reading " << argv[base + 1] << endl;
+      return 1;
+    }
+    if ( network1.input_num() != network2.input_num() ||
+	 network1.latch_node_num() != network2.latch_node_num() ||
+	 network1.output_num() != network2.output_num() ) {
+      cerr << "Error: # of inputs/outputs mismatch" << endl;
+      return 1;
+    }
+  }
+  else {
+    network2 = network1;
+  }
+  BNetDecomp decomp;
+  decomp(network2, 2);
+
+  StopWatch timer;
+  timer.start();
+
+  FraigMgr fraig_mgr(1);
+  ymuint ni = network1.input_num() + network1.latch_node_num();
+  vector<FraigHandle> outputs1;
+  vector<FraigHandle> outputs2;
+  for (ymuint c = 0; c < ncopy; ++ c) {
+    vector<FraigHandle> inputs(ni);
+    for (ymuint i = 0; i < ni; ++ i) {
+      inputs[i] = fraig_mgr.make_input();
+    }
+    make_fraig(network1, fraig_mgr, inputs, outputs1);
+    make_fraig(network2, fraig_mgr, inputs, outputs2);
+  }
+
+  ymuint no = outputs1.size();
+  ymuint neq = 0;
+  vector<Bool3> stats(no);
+  for (ymuint i = 0; i < no; ++ i) {
+    stats[i] = fraig_mgr.check_equiv(outputs1[i], outputs2[i]);
+    if ( stats[i] == kB3True ) {
+      ++ neq;
+    }
+  }
+  timer.stop();
+
+  cout << "outputs: " << no << ", equivalent: " << neq << endl;
+  if ( compare2 ) {
+    for (ymuint i = 0; i < no; ++ i) {
+      cout << "output#" << i << ": ";
+      switch ( stats[i] ) {
+      case kB3True:  cout << "T"; break;
+      case kB3False: cout << "F"; break;
+      case kB3X:     cout << "X"; break;
+      }
+      cout << endl;
+    }
+  }
+  cerr << "nodes: " << fraig_mgr.node_num()
+       << ", time: " << timer.time() << endl;
+  fraig_mgr.dump_stats(cerr);
+
+  if ( !compare2 && neq != no ) {
+    return 1;
+  }
+  return 0;
+}
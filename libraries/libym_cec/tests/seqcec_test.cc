@@ -0,0 +1,100 @@
+
+/// @file libym_cec/tests/seqcec_test.cc
+/// @brief 順序回路の等価検証のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_cec/cec_nsdef.h"
+#include "ym_bnet/BNetwork.h"
+#include "ym_bnet/BNetBlifReader.h"
+#include "ym_bnet/BNetDecomp.h"
+
+
+// 2つの blif ファイルの回路を check_sceq で比較し，
+// 出力ごとの結果を "output#<番号>: T|F|X" の形で標準出力に書く．
+// check_sceq のログ(反例の見つかった時刻を含む)は標準エラーに書く．
+// blif ファイルが1つの時はそれを2入力ノードに分解した回路と比較する．
+// 入力と出力は並んでいる順に対応させる．
+// -d で BMC と k-induction の最大の深さを指定する．
+int
+main(int argc,
+     char** argv)
+{
+  using namespace std;
+  using namespace nsYm;
+
+  ymuint max_depth = 8;
+  int base = 1;
+  if ( argc >= 3 && string(argv[1]) == "-d" ) {
+    max_depth = atoi(argv[2]);
+    base = 3;
+  }
+  if ( base + 1 != argc && base + 2 != argc ) {
+    cerr << "USAGE : " << argv[0]
+	 << " [-d <max_depth>] blif-file [blif-file2]" << endl;
+    return 2;
+  }
+
+  BNetwork network1;
+  BNetBlifReader reader;
+  if ( !reader.read(argv[base], network1) ) {
+    cerr << "Error in reading " << argv[base] << endl;
+    return 1;
+  }
+  BNetwork network2;
+  if ( base + 2 == argc ) {
+    if ( !reader.read(argv[base + 1], network2) ) {
+      cerr << "Error in reading " << argv[base + 1] << endl;
+      return 1;
+    }
+  }
+  else {
+    network2 = network1;
+    BNetDecomp decomp;
+    decomp(network2, 2);
+  }
+
+  if ( network1.input_num() != network2.input_num() ||
+       network1.output_num() != network2.output_num() ) {
+    cerr << "Error: # of inputs/outputs mismatch" << endl;
+    return 1;
+  }
+
+  vector<pair<ymuint32, ymuint32> > iassoc;
+  for (BNodeList::const_iterator p1 = network1.inputs_begin(),
+	 p2 = network2.inputs_begin();
+       p1 != network1.inputs_end(); ++ p1, ++ p2) {
+    iassoc.push_back(make_pair((*p1)->id(), (*p2)->id()));
+  }
+  vector<pair<ymuint32, ymuint32> > oassoc;
+  for (BNodeList::const_iterator p1 = network1.outputs_begin(),
+	 p2 = network2.outputs_begin();
+       p1 != network1.outputs_end(); ++ p1, ++ p2) {
+    oassoc.push_back(make_pair((*p1)->id(), (*p2)->id()));
+  }
+
+  vector<Bool3> stats;
+  check_sceq(network1, network2, iassoc, oassoc,
+	     1, &cerr,
+	     string(), string(), NULL,
+	     1, max_depth,
+	     stats);
+
+  ymuint no = stats.size();
+  for (ymuint i = 0; i < no; ++ i) {
+    cout << "output#" << i << ": ";
+    switch ( stats[i] ) {
+    case kB3True:  cout << "T"; break;
+    case kB3False: cout << "F"; break;
+    case kB3X:     cout << "X"; break;
+    }
+    cout << endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,236 @@
+
+/// @file libym_cec/tests/sweep_test.cc
+/// @brief SweepMgr のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "SweepMgr.h"
+#include "FraigMgr.h"
+#include "ym_aig/AigMgr.h"
+#include "ym_bnet/BNetwork.h"
+#include "ym_bnet/BNetBlifReader.h"
+#include "ym_bnet/BNetDecomp.h"
+#include "ym_utils/StopWatch.h"
+
+
+BEGIN_NAMESPACE_YM_CEC
+
+BEGIN_NONAMESPACE
+
+// ネットワークの組み合わせ回路部分を作る．
+// inputs は外部入力，latch の順に並んでいる．
+// outputs には外部出力，latch の入力の順に追加する．
+template <typename Mgr,
+	  typename Handle>
+void
+make_logic(const BNetwork& network,
+	   Mgr& mgr,
+	   const vector<Handle>& inputs,
+	   vector<Handle>& outputs)
+{
+  vector<Handle> node_map(network.max_node_id());
+  ymuint pos = 0;
+  for (BNodeList::const_iterator p = network.inputs_begin();
+       p != network.inputs_end(); ++ p, ++ pos) {
+    node_map[(*p)->id()] = inputs[pos];
+  }
+  for (BNodeList::const_iterator p = network.latch_nodes_begin();
+       p != network.latch_nodes_end(); ++ p, ++ pos) {
+    node_map[(*p)->id()] = inputs[pos];
+  }
+
+  BNodeVector node_list;
+  network.tsort(node_list);
+  for (BNodeVector::const_iterator p = node_list.begin();
+       p != node_list.end(); ++ p) {
+    BNode* node = *p;
+    ymuint ni = node->ni();
+    vector<Handle> fanins(ni);
+    for (ymuint i = 0; i < ni; ++ i) {
+      fanins[i] = node_map[node->fanin(i)->id()];
+    }
+    node_map[node->id()] = mgr.make_logic(node->func(), fanins);
+  }
+
+  for (BNodeList::const_iterator p = network.outputs_begin();
+       p != network.outputs_end(); ++ p) {
+    outputs.push_back(node_map[(*p)->fanin(0)->id()]);
+  }
+  for (BNodeList::const_iterator p = network.latch_nodes_begin();
+       p != network.latch_nodes_end(); ++ p) {
+    outputs.push_back(node_map[(*p)->fanin(0)->id()]);
+  }
+}
+
+// 2つのネットワークのミタを ncopy 個作る．
+template <typename Mgr,
+	  typename Handle>
+void
+make_miter(const BNetwork& network1,
+	   const BNetwork& network2,
+	   ymuint ncopy,
+	   Mgr& mgr,
+	   vector<Handle>& outputs1,
+	   vector<Handle>& outputs2)
+{
+  ymuint ni = network1.input_num() + network1.latch_node_num();
+  for (ymuint c = 0; c < ncopy; ++ c) {
+    vector<Handle> inputs(ni);
+    for (ymuint i = 0; i < ni; ++ i) {
+      inputs[i] = mgr.make_input();
+    }
+    make_logic(network1, mgr, inputs, outputs1);
+    make_logic(network2, mgr, inputs, outputs2);
+  }
+}
+
+END_NONAMESPACE
+
+
+// blif ファイルの回路とそれを2入力ノードに分解した回路のミタを
+// SweepMgr で検証し，FraigMgr の結果と比較する．
+// -r で指定した数だけ独立な入力を持つミタを並べる．
+// -t で SweepMgr のスレッド数を指定する．
+// -s を指定すると FraigMgr との比較は行わない．
+// blif ファイルを2つ指定した時は2つめの回路を分解したものと比較し，
+// 出力ごとの結果を "output#<番号>: T|F|X" の形で書く．
+// この場合は等価でない出力があってもエラーにしない．
+int
+sweep_test(int argc,
+	   char** argv)
+{
+  ymuint ncopy = 1;
+  ymuint thread_num = 1;
+  bool sweep_only = false;
+  int base = 1;
+  for ( ; base < argc && argv[base][0] == '-'; ++ base) {
+    string opt = argv[base];
+    if ( opt == "-s" ) {
+      sweep_only = true;
+    }
+    else if ( opt == "-r" && base + 1 < argc ) {
+      ++ base;
+      ncopy = atoi(argv[base]);
+    }
+    else if ( opt == "-t" && base + 1 < argc ) {
+      ++ base;
+      thread_num = atoi(argv[base]);
+    }
+    else {
+      break;
+    }
+  }
+  if ( base + 1 != argc && base + 2 != argc ) {
+    cerr << "USAGE : " << argv[0]
+	 << " [-r <copies>] [-t <threads>] [-s] blif-file [blif-file2]"
+	 << endl;
+    return 2;
+  }
+  bool compare2 = (base + 2 == argc);
+
+  BNetwork network1;
+  BNetBlifReader reader;
+  if ( !reader.read(argv[base], network1) ) {
+    cerr << "Error in reading " << argv[base] << endl;
+    return 1;
+  }
+  BNetwork network2;
+  if ( compare2 ) {
+    if ( !reader.read(argv[base + 1], network2) ) {
+      cerr << "Error in reading " << argv[base + 1] << endl;
+      return 1;
+    }
+    if ( network1.input_num() != network2.input_num() ||
+	 network1.latch_node_num() != network2.latch_node_num() ||
+	 network1.output_num() != network2.output_num() ) {
+      cerr << "Error: # of inputs/outputs mismatch" << endl;
+      return 1;
+    }
+  }
+  else {
+    network2 = network1;
+  }
+  BNetDecomp decomp;
+  decomp(network2, 2);
+
+  StopWatch timer;
+  timer.start();
+
+  AigMgr aig_mgr;
+  vector<AigHandle> outputs1;
+  vector<AigHandle> outputs2;
+  make_miter(network1, network2, ncopy, aig_mgr, outputs1, outputs2);
+
+  SweepMgr sweep_mgr(aig_mgr, string(), string(), thread_num);
+  sweep_mgr.sweep();
+  ymuint no = outputs1.size();
+  vector<pair<AigHandle, AigHandle> > comp_pairs(no);
+  for (ymuint i = 0; i < no; ++ i) {
+    comp_pairs[i] = make_pair(outputs1[i], outputs2[i]);
+  }
+  vector<Bool3> stats;
+  sweep_mgr.check_equiv(comp_pairs, stats);
+  timer.stop();
+
+  ymuint neq = 0;
+  for (ymuint i = 0; i < no; ++ i) {
+    if ( stats[i] == kB3True ) {
+      ++ neq;
+    }
+  }
+  cout << "outputs: " << no << ", equivalent: " << neq << endl;
+  if ( compare2 ) {
+    for (ymuint i = 0; i < no; ++ i) {
+      cout << "output#" << i << ": ";
+      switch ( stats[i] ) {
+      case kB3True:  cout << "T"; break;
+      case kB3False: cout << "F"; break;
+      case kB3X:     cout << "X"; break;
+      }
+      cout << endl;
+    }
+  }
+  cerr << "nodes: " << aig_mgr.node_num()
+       << ", sweep time: " << timer.time() << endl;
+  sweep_mgr.dump_stats(cerr);
+
+  ymuint nerr = 0;
+  if ( !sweep_only ) {
+    timer.reset();
+    timer.start();
+
+    FraigMgr fraig_mgr(1);
+    vector<FraigHandle> foutputs1;
+    vector<FraigHandle> foutputs2;
+    make_miter(network1, network2, ncopy, fraig_mgr, foutputs1, foutputs2);
+    for (ymuint i = 0; i < no; ++ i) {
+      Bool3 stat = fraig_mgr.check_equiv(foutputs1[i], foutputs2[i]);
+      if ( stat != stats[i] ) {
+	cerr << "Error: output#" << i << " differs from FraigMgr" << endl;
+	++ nerr;
+      }
+    }
+    timer.stop();
+    cerr << "FraigMgr time: " << timer.time() << endl;
+  }
+
+  if ( nerr > 0 || (!compare2 && neq != no) ) {
+    return 1;
+  }
+  return 0;
+}
+
+END_NAMESPACE_YM_CEC
+
+
+int
+main(int argc,
+     char** argv)
+{
+  return nsYm::nsCec::sweep_test(argc, argv);
+}
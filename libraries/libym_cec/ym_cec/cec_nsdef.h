@@ -42,11 +42,47 @@ check_ceq(const BNetwork& src_network1,
 	  ymuint sigsize,
 	  vector<Bool3>& stats);
 
+/// @brief SAT sweeping を用いて組み合わせ回路の等価検証を行う関数
+/// @note miter 全体の AIG を作ってから等価なノードを thread_num 個の
+/// スレッドの SAT ソルバで調べる．
+void
+sweep_ceq(const BNetwork& src_network1,
+	  const BNetwork& src_network2,
+	  const vector<pair<ymuint32, ymuint32> >& iassoc,
+	  const vector<pair<ymuint32, ymuint32> >& oassoc,
+	  ymint log_level,
+	  ostream* log_out,
+	  const string& sat_type,
+	  const string& sat_option,
+	  ymuint thread_num,
+	  vector<Bool3>& stats);
+
+/// @brief 順序回路の等価検証を行う関数
+/// @note latch の対応関係を帰納法で求めてから，それで証明できない
+/// 出力を深さ max_depth までの BMC と k-induction で調べる．
+/// 結果はリセット状態から到達可能な状態で等価なら kB3True，
+/// 反例が見つかったら kB3False，わからなければ kB3X となる．
+void
+check_sceq(const BNetwork& src_network1,
+	   const BNetwork& src_network2,
+	   const vector<pair<ymuint32, ymuint32> >& iassoc,
+	   const vector<pair<ymuint32, ymuint32> >& oassoc,
+	   ymint log_level,
+	   ostream* log_out,
+	   const string& sat_type,
+	   const string& sat_option,
+	   ostream* sat_out,
+	   ymuint sigsize,
+	   ymuint max_depth,
+	   vector<Bool3>& stats);
+
 END_NAMESPACE_YM_CEC
 
 BEGIN_NAMESPACE_YM
 
 using nsCec::check_ceq;
+using nsCec::sweep_ceq;
+using nsCec::check_sceq;
 
 END_NAMESPACE_YM
 
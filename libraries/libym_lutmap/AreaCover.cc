@@ -35,6 +35,8 @@ AreaCover::~AreaCover()
 //  - 1: weighted フロー, resub なし
 //  - 2: fanout フロー, resub あり
 //  - 3: weighted フロー, resub あり
+// @param[in] cut_num 各ノードで保持するカット数
+// (0 の時は全てのカットを列挙する)
 // @param[out] mapnetwork マッピング結果
 // @param[out] lut_num LUT数
 // @param[out] depth 段数
@@ -42,6 +44,7 @@ void
 AreaCover::operator()(const SbjGraph& sbjgraph,
 		      ymuint limit,
 		      ymuint mode,
+		      ymuint cut_num,
 		      LnGraph& mapnetwork,
 		      ymuint& lut_num,
 		      ymuint& depth)
@@ -49,7 +52,12 @@ AreaCover::operator()(const SbjGraph& sbjgraph,
   mMode = mode;
 
   // カットを列挙する．
-  mCutHolder.enum_cut(sbjgraph, limit);
+  if ( cut_num > 0 ) {
+    mCutHolder.enum_cut(sbjgraph, limit, cut_num, false);
+  }
+  else {
+    mCutHolder.enum_cut(sbjgraph, limit);
+  }
 
   // 最良カットを記録する．
   MapRecord maprec;
@@ -178,6 +186,8 @@ AreaCover::calc_weight(const SbjNode* node,
 //  - 1: weighted フロー, resub なし
 //  - 2: fanout フロー, resub あり
 //  - 3: weighted フロー, resub あり
+// @param[in] cut_num 各ノードで保持するカット数
+// (0 の時は全てのカットを列挙する)
 // @param[out] mapnetwork マッピング結果
 // @param[out] lut_num LUT数
 // @param[out] depth 段数
@@ -185,13 +195,14 @@ void
 area_map(const SbjGraph& sbjgraph,
 	 ymuint limit,
 	 ymuint mode,
+	 ymuint cut_num,
 	 LnGraph& mapnetwork,
 	 ymuint& lut_num,
 	 ymuint& depth)
 {
   AreaCover area_cover;
 
-  area_cover(sbjgraph, limit, mode, mapnetwork, lut_num, depth);
+  area_cover(sbjgraph, limit, mode, cut_num, mapnetwork, lut_num, depth);
 }
 
 END_NAMESPACE_YM_LUTMAP
@@ -87,6 +87,29 @@ Cut::expr() const
   return calc_expr_for_node(root(), logmap);
 }
 
+// @brief ノードの出力の真理値表を得る．
+// @param[in] node 論理ノード
+// @param[in] tv0, tv1 ファンインの真理値表
+ymuint64
+Cut::node_tv(const SbjNode* node,
+	     ymuint64 tv0,
+	     ymuint64 tv1)
+{
+  ymuint fcode = node->fcode();
+  if ( fcode & 1U ) {
+    tv0 = ~tv0;
+  }
+  if ( fcode & 2U ) {
+    tv1 = ~tv1;
+  }
+  if ( fcode & 4U ) {
+    return tv0 ^ tv1;
+  }
+  else {
+    return tv0 & tv1;
+  }
+}
+
 // デバッグ用の表示関数
 void
 Cut::dump(ostream& s) const
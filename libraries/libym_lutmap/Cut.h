@@ -52,6 +52,13 @@ public:
   const SbjNode*
   input(ymuint pos) const;
 
+  /// @brief 内容を表す真理値表を得る．
+  /// @note ビット p は i 番目の入力が p の i ビット目の値を
+  /// とる時の値を表す．
+  /// @note ni() が 6 以下の時のみ意味を持つ．
+  ymuint64
+  tv() const;
+
   /// @brief 内容を表す論理式を得る．
   LogExpr
   expr() const;
@@ -62,6 +69,35 @@ public:
   dump(ostream& s) const;
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 6入力までの真理値表を扱う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief pos 番目の入力を表す真理値表を得る．
+  /// @param[in] pos 入力番号 ( 0 <= pos < 6 )
+  static
+  ymuint64
+  var_tv(ymuint pos);
+
+  /// @brief ノードの出力の真理値表を得る．
+  /// @param[in] node 論理ノード
+  /// @param[in] tv0, tv1 ファンインの真理値表
+  static
+  ymuint64
+  node_tv(const SbjNode* node,
+	  ymuint64 tv0,
+	  ymuint64 tv1);
+
+  /// @brief 真理値表が pos 番目の入力に依存していない時 true を返す．
+  /// @param[in] tv 真理値表
+  /// @param[in] pos 入力番号 ( 0 <= pos < 6 )
+  static
+  bool
+  check_vacuous(ymuint64 tv,
+		ymuint pos);
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
@@ -76,6 +112,9 @@ private:
   // 入力数
   ymuint32 mNi;
 
+  // 真理値表
+  ymuint64 mTv;
+
   // 入力のノード配列
   const SbjNode* mInputs[1];
 
@@ -225,6 +264,40 @@ Cut::input(ymuint pos) const
   return mInputs[pos];
 }
 
+// @brief 内容を表す真理値表を得る．
+inline
+ymuint64
+Cut::tv() const
+{
+  return mTv;
+}
+
+// @brief pos 番目の入力を表す真理値表を得る．
+inline
+ymuint64
+Cut::var_tv(ymuint pos)
+{
+  static const ymuint64 kVarTv[] = {
+    0xAAAAAAAAAAAAAAAAULL,
+    0xCCCCCCCCCCCCCCCCULL,
+    0xF0F0F0F0F0F0F0F0ULL,
+    0xFF00FF00FF00FF00ULL,
+    0xFFFF0000FFFF0000ULL,
+    0xFFFFFFFF00000000ULL
+  };
+  return kVarTv[pos];
+}
+
+// @brief 真理値表が pos 番目の入力に依存していない時 true を返す．
+inline
+bool
+Cut::check_vacuous(ymuint64 tv,
+		   ymuint pos)
+{
+  ymuint64 mask = var_tv(pos);
+  return ((tv & mask) >> (1U << pos)) == (tv & ~mask);
+}
+
 // @brief コンストラクタ
 inline
 CutListIterator::CutListIterator() :
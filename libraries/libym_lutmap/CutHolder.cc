@@ -53,6 +53,10 @@ CutHolder::all_init(const SbjGraph& sbjgraph,
   ymuint n = sbjgraph.max_node_id();
   mLimit = limit;
   mCutList = new CutList[n];
+  mTvArray.clear();
+  mTvArray.resize(n);
+  mTvMark.clear();
+  mTvMark.resize(n, false);
 }
 
 void
@@ -71,13 +75,26 @@ CutHolder::found(const SbjNode* root,
 		 ymuint ni,
 		 const SbjNode* inputs[])
 {
-  Cut* cut = alloc_cut(ni);
-  cut->mRoot = root;
-  cut->mNi = ni;
-  for (ymuint i = 0; i < ni; ++ i) {
-    cut->mInputs[i] = inputs[i];
+  ymuint64 tv = 0;
+  if ( ni <= 6 ) {
+    tv = calc_tv(root, ni, inputs);
+    for (ymuint i = 0; i < ni; ++ i) {
+      if ( Cut::check_vacuous(tv, i) ) {
+	// 依存していない入力を持つカットは使わない．
+	return;
+      }
+    }
   }
-  mCutList[root->id()].push_back(cut);
+  add_cut(root, ni, inputs, tv);
+}
+
+void
+CutHolder::found(const SbjNode* root,
+		 ymuint ni,
+		 const SbjNode* inputs[],
+		 ymuint64 tv)
+{
+  add_cut(root, ni, inputs, tv);
 }
 
 void
@@ -94,6 +111,70 @@ CutHolder::all_end(const SbjGraph& sbjgraph,
 {
 }
 
+// カットを登録する．
+void
+CutHolder::add_cut(const SbjNode* root,
+		   ymuint ni,
+		   const SbjNode* inputs[],
+		   ymuint64 tv)
+{
+  Cut* cut = alloc_cut(ni);
+  cut->mRoot = root;
+  cut->mNi = ni;
+  cut->mTv = tv;
+  for (ymuint i = 0; i < ni; ++ i) {
+    cut->mInputs[i] = inputs[i];
+  }
+  mCutList[root->id()].push_back(cut);
+}
+
+// カットの真理値表を計算する．
+ymuint64
+CutHolder::calc_tv(const SbjNode* root,
+		   ymuint ni,
+		   const SbjNode* inputs[])
+{
+  for (ymuint i = 0; i < ni; ++ i) {
+    const SbjNode* node = inputs[i];
+    ymuint id = node->id();
+    mTvArray[id] = Cut::var_tv(i);
+    mTvMark[id] = true;
+    mTvList.push_back(node);
+  }
+
+  ymuint64 tv = calc_tv_sub(root);
+
+  for (vector<const SbjNode*>::iterator p = mTvList.begin();
+       p != mTvList.end(); ++ p) {
+    mTvMark[(*p)->id()] = false;
+  }
+  mTvList.clear();
+
+  return tv;
+}
+
+// calc_tv() の下請け関数
+ymuint64
+CutHolder::calc_tv_sub(const SbjNode* node)
+{
+  if ( node == NULL ) {
+    return 0;
+  }
+  ymuint id = node->id();
+  if ( mTvMark[id] ) {
+    return mTvArray[id];
+  }
+  assert_cond( node->is_logic(), __FILE__, __LINE__);
+
+  ymuint64 tv0 = calc_tv_sub(node->fanin(0));
+  ymuint64 tv1 = calc_tv_sub(node->fanin(1));
+  ymuint64 tv = Cut::node_tv(node, tv0, tv1);
+  mTvArray[id] = tv;
+  mTvMark[id] = true;
+  mTvList.push_back(node);
+  return tv;
+}
+
 // カットの領域を確保する．
 Cut*
 CutHolder::alloc_cut(ymuint ni)
@@ -87,6 +87,18 @@ private:
 	ymuint ni,
 	const SbjNode* inputs[]);
 
+  /// @brief 真理値表つきの cut が一つ見つかったときに呼ばれる関数
+  /// @param[in] root 根のノード
+  /// @param[in] ni 入力数
+  /// @param[in] inputs 入力ノードの配列
+  /// @param[in] tv 真理値表 ( ni <= 6 )
+  virtual
+  void
+  found(const SbjNode* root,
+	ymuint ni,
+	const SbjNode* inputs[],
+	ymuint64 tv);
+
   /// @brief node を根とするカットを列挙し終わった直後に呼ばれる関数
   /// @param[in] node 根のノード
   /// @param[in] cur_pos node の処理順
@@ -110,6 +122,23 @@ private:
 
 private:
 
+  // カットを登録する．
+  void
+  add_cut(const SbjNode* root,
+	  ymuint ni,
+	  const SbjNode* inputs[],
+	  ymuint64 tv);
+
+  // カットの真理値表を計算する．
+  ymuint64
+  calc_tv(const SbjNode* root,
+	  ymuint ni,
+	  const SbjNode* inputs[]);
+
+  // calc_tv() の下請け関数
+  ymuint64
+  calc_tv_sub(const SbjNode* node);
+
   // カットの領域を確保する．
   Cut*
   alloc_cut(ymuint ni);
@@ -126,6 +155,15 @@ private:
   // 各ノードのカットのリスト
   CutList* mCutList;
 
+  // calc_tv() で用いる各ノードの真理値表
+  vector<ymuint64> mTvArray;
+
+  // calc_tv() で真理値表を計算済みの印
+  vector<bool> mTvMark;
+
+  // calc_tv() で印をつけたノードのリスト
+  vector<const SbjNode*> mTvList;
+
   static
   const ymuint kPageSize = 8192;
 
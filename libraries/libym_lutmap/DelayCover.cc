@@ -37,6 +37,8 @@ DelayCover::~DelayCover()
 //  - 1: weighted フロー, resub なし
 //  - 2: fanout フロー, resub あり
 //  - 3: weighted フロー, resub あり
+// @param[in] cut_num 各ノードで保持するカット数
+// (0 の時は全てのカットを列挙する)
 // @param[out] mapnetwork マッピング結果
 // @param[out] lut_num LUT数
 // @param[out] depth 段数
@@ -45,6 +47,7 @@ DelayCover::operator()(const SbjGraph& sbjgraph,
 		       ymuint limit,
 		       ymuint slack,
 		       ymuint mode,
+		       ymuint cut_num,
 		       LnGraph& mapnetwork,
 		       ymuint& lut_num,
 		       ymuint& depth)
@@ -52,7 +55,12 @@ DelayCover::operator()(const SbjGraph& sbjgraph,
   mMode = mode;
 
   // カットを列挙する．
-  mCutHolder.enum_cut(sbjgraph, limit);
+  if ( cut_num > 0 ) {
+    mCutHolder.enum_cut(sbjgraph, limit, cut_num, true);
+  }
+  else {
+    mCutHolder.enum_cut(sbjgraph, limit);
+  }
 
   // 最良カットを記録する．
   MapRecord maprec;
@@ -309,6 +317,8 @@ DelayCover::select(const SbjNode* node,
 //  - 1: weighted フロー, resub なし
 //  - 2: fanout フロー, resub あり
 //  - 3: weighted フロー, resub あり
+// @param[in] cut_num 各ノードで保持するカット数
+// (0 の時は全てのカットを列挙する)
 // @param[out] mapnetwork マッピング結果
 // @param[out] lut_num LUT数
 // @param[out] depth 段数
@@ -317,13 +327,15 @@ delay_map(const SbjGraph& sbjgraph,
 	  ymuint limit,
 	  ymuint slack,
 	  ymuint mode,
+	  ymuint cut_num,
 	  LnGraph& mapnetwork,
 	  ymuint& lut_num,
 	  ymuint& depth)
 {
   DelayCover delay_cover;
 
-  delay_cover(sbjgraph, limit, slack, mode, mapnetwork, lut_num, depth);
+  delay_cover(sbjgraph, limit, slack, mode, cut_num,
+	      mapnetwork, lut_num, depth);
 }
 
 END_NAMESPACE_YM_LUTMAP
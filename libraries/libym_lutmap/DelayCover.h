@@ -46,6 +46,8 @@ public:
   ///  - 1: weighted フロー, resub なし
   ///  - 2: fanout フロー, resub あり
   ///  - 3: weighted フロー, resub あり
+  /// @param[in] cut_num 各ノードで保持するカット数
+  /// (0 の時は全てのカットを列挙する)
   /// @param[out] mapnetwork マッピング結果
   /// @param[out] lut_num LUT数
   /// @param[out] depth 段数
@@ -54,6 +56,7 @@ public:
 	     ymuint limit,
 	     ymuint slack,
 	     ymuint mode,
+	     ymuint cut_num,
 	     LnGraph& mapnetwork,
 	     ymuint& lut_num,
 	     ymuint& depth);
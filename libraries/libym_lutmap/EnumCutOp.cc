@@ -11,6 +11,7 @@
 
 #include "EnumCutOp.h"
 #include "EnumCut.h"
+#include "EnumPriCut.h"
 #include "ym_sbj/SbjGraph.h"
 
 //#define DEBUG_ENUM_RECUR
@@ -45,6 +46,23 @@ EnumCutOp::enum_cut(const SbjGraph& sbjgraph,
   return ec(sbjgraph, limit, this);
 }
 
+// @brief 各ノードで上位 cut_num 個のカットのみを列挙する．
+// @param[in] sbjgraph 対象のサブジェクトグラフ
+// @param[in] limit 入力数の制限
+// @param[in] cut_num 各ノードで保持するカット数
+// @param[in] delay_mode true の時は段数を，false の時は
+// area flow を優先してカットを選ぶ．
+// @return 全 cut 数を返す．
+ymuint
+EnumCutOp::enum_cut(const SbjGraph& sbjgraph,
+		    ymuint limit,
+		    ymuint cut_num,
+		    bool delay_mode)
+{
+  EnumPriCut ec;
+  return ec(sbjgraph, limit, cut_num, delay_mode, this);
+}
+
 // @brief 処理の最初に呼ばれる関数
 // @param[in] sbjgraph 対象のサブジェクトグラフ
 // @param[in] limit カットサイズ
@@ -85,6 +103,21 @@ EnumCutOp::found(const SbjNode* root,
 {
 }
 
+// @brief 真理値表つきの cut が一つ見つかったときに呼ばれる関数
+// @param[in] root 根のノード
+// @param[in] ni 入力数
+// @param[in] inputs 入力ノードの配列
+// @param[in] tv 真理値表 ( ni <= 6 )
+// @note デフォルトの実装では真理値表なしの found() を呼ぶ．
+void
+EnumCutOp::found(const SbjNode* root,
+		 ymuint ni,
+		 const SbjNode* inputs[],
+		 ymuint64 tv)
+{
+  found(root, ni, inputs);
+}
+
 // @brief node を根とするカットを列挙し終わった直後に呼ばれる関数
 // @param[in] node 根のノード
 // @param[in] cur_pos node の処理順
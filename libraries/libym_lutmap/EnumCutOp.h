@@ -18,6 +18,7 @@
 BEGIN_NAMESPACE_YM_LUTMAP
 
 class EnumCut;
+class EnumPriCut;
 
 //////////////////////////////////////////////////////////////////////
 /// @class EnumCutOp
@@ -27,6 +28,7 @@ class EnumCut;
 class EnumCutOp
 {
   friend class EnumCut;
+  friend class EnumPriCut;
 
 protected:
 
@@ -50,6 +52,20 @@ public:
   enum_cut(const SbjGraph& sbjgraph,
 	   ymuint limit);
 
+  /// @brief 各ノードで上位 cut_num 個のカットのみを列挙する．
+  /// @param[in] sbjgraph 対象のサブジェクトグラフ
+  /// @param[in] limit 入力数の制限
+  /// @param[in] cut_num 各ノードで保持するカット数
+  /// @param[in] delay_mode true の時は段数を，false の時は
+  /// area flow を優先してカットを選ぶ．
+  /// @return 全 cut 数を返す．
+  /// @note 内部で下の仮想関数が呼び出される．
+  ymuint
+  enum_cut(const SbjGraph& sbjgraph,
+	   ymuint limit,
+	   ymuint cut_num,
+	   bool delay_mode);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -93,6 +109,19 @@ private:
 	ymuint ni,
 	const SbjNode* inputs[]);
 
+  /// @brief 真理値表つきの cut が一つ見つかったときに呼ばれる関数
+  /// @param[in] root 根のノード
+  /// @param[in] ni 入力数
+  /// @param[in] inputs 入力ノードの配列
+  /// @param[in] tv 真理値表 ( ni <= 6 )
+  /// @note デフォルトの実装では真理値表なしの found() を呼ぶ．
+  virtual
+  void
+  found(const SbjNode* root,
+	ymuint ni,
+	const SbjNode* inputs[],
+	ymuint64 tv);
+
   /// @brief node を根とするカットを列挙し終わった直後に呼ばれる関数
   /// @param[in] node 根のノード
   /// @param[in] cur_pos node の処理順
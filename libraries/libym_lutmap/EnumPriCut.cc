@@ -0,0 +1,473 @@
+
+/// @file libym_lutmap/EnumPriCut.cc
+/// @brief EnumPriCut の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "EnumPriCut.h"
+#include "Cut.h"
+#include "ym_sbj/SbjGraph.h"
+
+
+BEGIN_NAMESPACE_YM_LUTMAP
+
+BEGIN_NONAMESPACE
+
+// ノードのシグネチャを返す．
+inline
+ymuint64
+node_sig(const SbjNode* node)
+{
+  return 1UL << (node->id() % 64);
+}
+
+// 1 のビット数を数える．
+inline
+ymuint
+count_ones(ymuint64 sig)
+{
+  ymuint n = 0;
+  for ( ; sig; sig &= sig - 1) {
+    ++ n;
+  }
+  return n;
+}
+
+// pos 番目と pos + 1 番目の入力を入れ替えた真理値表を返す．
+inline
+ymuint64
+swap_var(ymuint64 tv,
+	 ymuint pos)
+{
+  ymuint64 m0 = Cut::var_tv(pos);
+  ymuint64 m1 = Cut::var_tv(pos + 1);
+  ymuint64 m10 = m0 & ~m1;
+  ymuint64 m01 = ~m0 & m1;
+  ymuint s = 1U << pos;
+  return (tv & ~(m10 | m01)) | ((tv & m10) << s) | ((tv & m01) >> s);
+}
+
+// i 番目の入力を pos_list[i] 番目の入力に移した真理値表を返す．
+// pos_list は昇順に並んでいる．
+inline
+ymuint64
+stretch_tv(ymuint64 tv,
+	   ymuint ni,
+	   const vector<ymuint32>& pos_list)
+{
+  for (ymuint i = ni; i -- > 0; ) {
+    for (ymuint pos = i; pos < pos_list[i]; ++ pos) {
+      tv = swap_var(tv, pos);
+    }
+  }
+  return tv;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス EnumPriCut
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+EnumPriCut::EnumPriCut()
+{
+}
+
+// @brief デストラクタ
+EnumPriCut::~EnumPriCut()
+{
+}
+
+// @brief 各ノードで入力数が limit 以下の上位 cut_num 個のカットを列挙する．
+// @param[in] sbjgraph 対象のサブジェクトグラフ
+// @param[in] limit 入力数の制限
+// @param[in] cut_num 各ノードで保持するカット数
+// @param[in] delay_mode true の時は段数を，false の時は
+// area flow を優先してカットを選ぶ．
+// @param[in] op カットが列挙される時に呼ばれるクラス
+// @return 全 cut 数を返す．
+ymuint
+EnumPriCut::operator()(const SbjGraph& sbjgraph,
+		       ymuint limit,
+		       ymuint cut_num,
+		       bool delay_mode,
+		       EnumCutOp* op)
+{
+  mLimit = limit;
+  mCutNum = cut_num;
+  mDelayMode = delay_mode;
+  mUseTv = (limit <= 6);
+  mPosList0.resize(limit);
+  mPosList1.resize(limit);
+
+  ymuint n = sbjgraph.max_node_id();
+  mNodeInfo.clear();
+  mNodeInfo.resize(n);
+
+  op->all_init(sbjgraph, limit);
+
+  // 外部入力と DFF は自明なカットのみを持つ．
+  ymuint nc_all = 0;
+  ymuint cur_pos = 0;
+  const SbjNodeList& input_list = sbjgraph.input_list();
+  for (SbjNodeList::const_iterator p = input_list.begin();
+       p != input_list.end(); ++ p) {
+    const SbjNode* node = *p;
+    op->node_init(node, cur_pos);
+    op->found(node);
+    ++ nc_all;
+    op->node_end(node, cur_pos, 1);
+    ++ cur_pos;
+  }
+  const SbjNodeList& dff_list = sbjgraph.dff_list();
+  for (SbjNodeList::const_iterator p = dff_list.begin();
+       p != dff_list.end(); ++ p) {
+    const SbjNode* node = *p;
+    op->node_init(node, cur_pos);
+    op->found(node);
+    ++ nc_all;
+    op->node_end(node, cur_pos, 1);
+    ++ cur_pos;
+  }
+
+  // 各ノードのカットを参照する論理ノードの数を数える．
+  // 0 になったらそのノードのカットは不要になる．
+  vector<const SbjNode*> node_list;
+  sbjgraph.sort(node_list);
+  vector<ymuint32> ref_count(n, 0);
+  for (vector<const SbjNode*>::const_iterator p = node_list.begin();
+       p != node_list.end(); ++ p) {
+    const SbjNode* node = *p;
+    ++ ref_count[node->fanin(0)->id()];
+    ++ ref_count[node->fanin(1)->id()];
+  }
+
+  // 入力側から内部ノードのカットを作る．
+  for (vector<const SbjNode*>::const_iterator p = node_list.begin();
+       p != node_list.end(); ++ p) {
+    const SbjNode* node = *p;
+    assert_cond( node->is_logic(), __FILE__, __LINE__);
+
+    op->node_init(node, cur_pos);
+
+    make_cuts(node);
+
+    // 自明なカット
+    op->found(node);
+    ymuint nc_cur = 1;
+
+    NodeInfo& node_info = mNodeInfo[node->id()];
+    ymuint nc = node_info.mCutList.size();
+    for (ymuint k = 0; k < nc; ++ k) {
+      const PriCut& cut = node_info.mCutList[k];
+      if ( mUseTv ) {
+	op->found(node, cut.mNi, &node_info.mLeafList[k * mLimit], cut.mTv);
+      }
+      else {
+	op->found(node, cut.mNi, &node_info.mLeafList[k * mLimit]);
+      }
+      ++ nc_cur;
+    }
+    nc_all += nc_cur;
+
+    op->node_end(node, cur_pos, nc_cur);
+    ++ cur_pos;
+
+    // 不要になったカットを削除する．
+    for (ymuint i = 0; i < 2; ++ i) {
+      const SbjNode* inode = node->fanin(i);
+      ymuint id = inode->id();
+      -- ref_count[id];
+      if ( ref_count[id] == 0 ) {
+	vector<PriCut>().swap(mNodeInfo[id].mCutList);
+	vector<const SbjNode*>().swap(mNodeInfo[id].mLeafList);
+      }
+    }
+  }
+
+  op->all_end(sbjgraph, limit);
+
+  mNodeInfo.clear();
+
+  return nc_all;
+}
+
+// @brief node のカットを作る．
+void
+EnumPriCut::make_cuts(const SbjNode* node)
+{
+  get_fanin_cuts(node->fanin(0), mCutList0, mLeafList0);
+  get_fanin_cuts(node->fanin(1), mCutList1, mLeafList1);
+
+  // 2つのファンインのカットの組み合わせを候補とする．
+  mCandList.clear();
+  mCandLeafList.clear();
+  ymuint n0 = mCutList0.size();
+  ymuint n1 = mCutList1.size();
+  for (ymuint i0 = 0; i0 < n0; ++ i0) {
+    for (ymuint i1 = 0; i1 < n1; ++ i1) {
+      merge(node,
+	    mCutList0[i0], &mLeafList0[i0 * mLimit],
+	    mCutList1[i1], &mLeafList1[i1 * mLimit]);
+    }
+  }
+
+  // 残った候補のコストを計算して良い順に並べる．
+  mOrder.clear();
+  ymuint nc = mCandList.size();
+  for (ymuint k = 0; k < nc; ++ k) {
+    PriCut& cut = mCandList[k];
+    if ( !cut.mDead ) {
+      calc_cost(node, cut, &mCandLeafList[k * mLimit]);
+      mOrder.push_back(k);
+    }
+  }
+  sort(mOrder.begin(), mOrder.end(), CutLt(mCandList, mDelayMode));
+
+  // 上位 mCutNum 個を残す．
+  ymuint n = mOrder.size();
+  if ( n > mCutNum ) {
+    n = mCutNum;
+  }
+  assert_cond( n > 0, __FILE__, __LINE__);
+  NodeInfo& node_info = mNodeInfo[node->id()];
+  node_info.mCutList.resize(n);
+  node_info.mLeafList.resize(n * mLimit);
+  node_info.mDepth = UINT_MAX;
+  node_info.mAreaFlow = DBL_MAX;
+  for (ymuint k = 0; k < n; ++ k) {
+    ymuint src = mOrder[k];
+    const PriCut& cut = mCandList[src];
+    node_info.mCutList[k] = cut;
+    for (ymuint i = 0; i < cut.mNi; ++ i) {
+      node_info.mLeafList[k * mLimit + i] = mCandLeafList[src * mLimit + i];
+    }
+    if ( node_info.mDepth > cut.mDepth ) {
+      node_info.mDepth = cut.mDepth;
+    }
+    if ( node_info.mAreaFlow > cut.mAreaFlow ) {
+      node_info.mAreaFlow = cut.mAreaFlow;
+    }
+  }
+}
+
+// @brief ファンインのカット(自明なカットを含む)を得る．
+// @param[in] node ファンインのノード
+// @param[out] cut_list カットのリスト
+// @param[out] leaf_list 葉のリスト
+// @note 自明なカットの葉は leaf_list の最後に置く．
+void
+EnumPriCut::get_fanin_cuts(const SbjNode* node,
+			   vector<PriCut>& cut_list,
+			   vector<const SbjNode*>& leaf_list)
+{
+  const NodeInfo& node_info = mNodeInfo[node->id()];
+  cut_list = node_info.mCutList;
+  leaf_list = node_info.mLeafList;
+
+  PriCut cut;
+  cut.mSig = node_sig(node);
+  cut.mNi = 1;
+  cut.mTv = Cut::var_tv(0);
+  cut.mDepth = 0;
+  cut.mAreaFlow = 0.0;
+  cut.mDead = false;
+  ymuint base = cut_list.size() * mLimit;
+  cut_list.push_back(cut);
+  leaf_list.resize(base + mLimit);
+  leaf_list[base] = node;
+}
+
+// @brief 2つのカットを併合して候補に加える．
+void
+EnumPriCut::merge(const SbjNode* node,
+		  const PriCut& cut0,
+		  const SbjNode* const * leaves0,
+		  const PriCut& cut1,
+		  const SbjNode* const * leaves1)
+{
+  ymuint64 sig = cut0.mSig | cut1.mSig;
+  if ( count_ones(sig) > mLimit ) {
+    // 確実に入力数の制限を越える．
+    return;
+  }
+
+  // 葉のノード番号の昇順を保って併合する．
+  ymuint base = mCandList.size() * mLimit;
+  mCandLeafList.resize(base + mLimit);
+  const SbjNode** leaves = &mCandLeafList[base];
+  ymuint ni0 = cut0.mNi;
+  ymuint ni1 = cut1.mNi;
+  ymuint i0 = 0;
+  ymuint i1 = 0;
+  ymuint ni = 0;
+  while ( i0 < ni0 || i1 < ni1 ) {
+    if ( ni == mLimit ) {
+      mCandLeafList.resize(base);
+      return;
+    }
+    if ( i1 == ni1 ) {
+      leaves[ni] = leaves0[i0];
+      mPosList0[i0] = ni;
+      ++ i0;
+    }
+    else if ( i0 == ni0 ) {
+      leaves[ni] = leaves1[i1];
+      mPosList1[i1] = ni;
+      ++ i1;
+    }
+    else {
+      ymuint id0 = leaves0[i0]->id();
+      ymuint id1 = leaves1[i1]->id();
+      if ( id0 < id1 ) {
+	leaves[ni] = leaves0[i0];
+	mPosList0[i0] = ni;
+	++ i0;
+      }
+      else if ( id0 > id1 ) {
+	leaves[ni] = leaves1[i1];
+	mPosList1[i1] = ni;
+	++ i1;
+      }
+      else {
+	leaves[ni] = leaves0[i0];
+	mPosList0[i0] = ni;
+	mPosList1[i1] = ni;
+	++ i0;
+	++ i1;
+      }
+    }
+    ++ ni;
+  }
+  if ( ni < 2 ) {
+    // 入力数が1のカットは使わない．
+    mCandLeafList.resize(base);
+    return;
+  }
+
+  ymuint64 tv = 0;
+  if ( mUseTv ) {
+    // 併合後の葉の上での真理値表を計算する．
+    ymuint64 tv0 = stretch_tv(cut0.mTv, ni0, mPosList0);
+    ymuint64 tv1 = stretch_tv(cut1.mTv, ni1, mPosList1);
+    tv = Cut::node_tv(node, tv0, tv1);
+    for (ymuint i = 0; i < ni; ++ i) {
+      if ( Cut::check_vacuous(tv, i) ) {
+	// 依存していない入力を持つカットは使わない．
+	mCandLeafList.resize(base);
+	return;
+      }
+    }
+  }
+
+  // 他のカットとの包含関係を調べる．
+  ymuint nc = mCandList.size();
+  for (ymuint k = 0; k < nc; ++ k) {
+    PriCut& cut = mCandList[k];
+    if ( cut.mDead ) {
+      continue;
+    }
+    const SbjNode* const * leaves2 = &mCandLeafList[k * mLimit];
+    if ( (cut.mSig & ~sig) == 0 && cut.mNi <= ni &&
+	 check_contain(leaves2, cut.mNi, leaves, ni) ) {
+      // 新しいカットは既存のカットを包含しているので要らない．
+      mCandLeafList.resize(base);
+      return;
+    }
+    if ( (sig & ~cut.mSig) == 0 && ni < cut.mNi &&
+	 check_contain(leaves, ni, leaves2, cut.mNi) ) {
+      // 既存のカットは新しいカットを包含している．
+      cut.mDead = true;
+    }
+  }
+
+  PriCut cut;
+  cut.mSig = sig;
+  cut.mNi = ni;
+  cut.mTv = tv;
+  cut.mDepth = 0;
+  cut.mAreaFlow = 0.0;
+  cut.mDead = false;
+  mCandList.push_back(cut);
+}
+
+// @brief 候補のカットのコストを計算する．
+void
+EnumPriCut::calc_cost(const SbjNode* node,
+		      PriCut& cut,
+		      const SbjNode* const * leaves)
+{
+  ymuint depth = 0;
+  double area_flow = 1.0;
+  for (ymuint i = 0; i < cut.mNi; ++ i) {
+    const NodeInfo& leaf_info = mNodeInfo[leaves[i]->id()];
+    if ( depth < leaf_info.mDepth ) {
+      depth = leaf_info.mDepth;
+    }
+    area_flow += leaf_info.mAreaFlow;
+  }
+  ymuint nfo = node->fanout_num();
+  if ( nfo > 1 ) {
+    area_flow /= nfo;
+  }
+  cut.mDepth = depth + 1;
+  cut.mAreaFlow = area_flow;
+}
+
+// @brief leaves1 が leaves2 に含まれていたら true を返す．
+bool
+EnumPriCut::check_contain(const SbjNode* const * leaves1,
+			  ymuint n1,
+			  const SbjNode* const * leaves2,
+			  ymuint n2)
+{
+  // どちらもノード番号の昇順に並んでいる．
+  ymuint i2 = 0;
+  for (ymuint i1 = 0; i1 < n1; ++ i1) {
+    ymuint id1 = leaves1[i1]->id();
+    for ( ; i2 < n2 && leaves2[i2]->id() < id1; ++ i2) ;
+    if ( i2 == n2 || leaves2[i2]->id() != id1 ) {
+      return false;
+    }
+    ++ i2;
+  }
+  return true;
+}
+
+// カットの比較関数
+bool
+EnumPriCut::CutLt::operator()(ymuint a,
+			      ymuint b) const
+{
+  const PriCut& cut_a = mCutList[a];
+  const PriCut& cut_b = mCutList[b];
+  if ( mDelayMode ) {
+    if ( cut_a.mDepth != cut_b.mDepth ) {
+      return cut_a.mDepth < cut_b.mDepth;
+    }
+    if ( cut_a.mAreaFlow != cut_b.mAreaFlow ) {
+      return cut_a.mAreaFlow < cut_b.mAreaFlow;
+    }
+  }
+  else {
+    if ( cut_a.mAreaFlow != cut_b.mAreaFlow ) {
+      return cut_a.mAreaFlow < cut_b.mAreaFlow;
+    }
+    if ( cut_a.mDepth != cut_b.mDepth ) {
+      return cut_a.mDepth < cut_b.mDepth;
+    }
+  }
+  if ( cut_a.mNi != cut_b.mNi ) {
+    return cut_a.mNi < cut_b.mNi;
+  }
+  return a < b;
+}
+
+END_NAMESPACE_YM_LUTMAP
@@ -0,0 +1,227 @@
+#ifndef LIBYM_LUTMAP_ENUMPRICUT_H
+#define LIBYM_LUTMAP_ENUMPRICUT_H
+
+/// @file libym_lutmap/EnumPriCut.h
+/// @brief EnumPriCut のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_lutmap/lutmap_nsdef.h"
+#include "ym_sbj/SbjGraph.h"
+#include "EnumCutOp.h"
+
+
+BEGIN_NAMESPACE_YM_LUTMAP
+
+//////////////////////////////////////////////////////////////////////
+/// @class EnumPriCut EnumPriCut.h "EnumPriCut.h"
+/// @brief priority cut の列挙用のクラス
+///
+/// EnumCut が全てのカットを列挙するのに対して，こちらは
+/// 各ノードごとにコストの良い順に cut_num 個のカットのみを保持する．
+/// ノードのカットは入力側から順に2つのファンインのカットを併合して作る．
+/// その際，他のカットを包含するカットは取り除く．
+/// 入力数の制限が 6 以下の時は併合と同時に真理値表も計算し，
+/// 依存していない入力を持つカットを取り除く．
+//////////////////////////////////////////////////////////////////////
+class EnumPriCut
+{
+public:
+
+  /// @brief コンストラクタ
+  EnumPriCut();
+
+  /// @brief デストラクタ
+  ~EnumPriCut();
+
+  /// @brief 各ノードで入力数が limit 以下の上位 cut_num 個のカットを列挙する．
+  /// @param[in] sbjgraph 対象のサブジェクトグラフ
+  /// @param[in] limit 入力数の制限
+  /// @param[in] cut_num 各ノードで保持するカット数
+  /// @param[in] delay_mode true の時は段数を，false の時は
+  /// area flow を優先してカットを選ぶ．
+  /// @param[in] op カットが列挙される時に呼ばれるクラス
+  /// @return 全 cut 数を返す．
+  ymuint
+  operator()(const SbjGraph& sbjgraph,
+	     ymuint limit,
+	     ymuint cut_num,
+	     bool delay_mode,
+	     EnumCutOp* op);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // カットの情報
+  // 葉のノードは別の配列にノード番号の昇順に格納する．
+  struct PriCut
+  {
+    // 葉のノード番号から作ったシグネチャ
+    ymuint64 mSig;
+
+    // 葉の数
+    ymuint32 mNi;
+
+    // 真理値表 (mLimit <= 6 の時のみ意味を持つ)
+    ymuint64 mTv;
+
+    // 段数
+    ymuint32 mDepth;
+
+    // area flow
+    double mAreaFlow;
+
+    // 取り除かれた時に true にする．
+    bool mDead;
+
+  };
+
+  // 各ノードごとの作業領域
+  struct NodeInfo
+  {
+    // コンストラクタ
+    NodeInfo() :
+      mDepth(0),
+      mAreaFlow(0.0)
+    {
+    }
+
+    // カットのリスト (良い順)
+    vector<PriCut> mCutList;
+
+    // カットの葉 (k 番めのカットの葉は mLimit * k から始まる)
+    vector<const SbjNode*> mLeafList;
+
+    // 最良の段数
+    ymuint32 mDepth;
+
+    // 最良の area flow
+    double mAreaFlow;
+
+  };
+
+  // カットの比較用の関数オブジェクト
+  struct CutLt
+  {
+    CutLt(const vector<PriCut>& cut_list,
+	  bool delay_mode) :
+      mCutList(cut_list),
+      mDelayMode(delay_mode)
+    {
+    }
+
+    bool
+    operator()(ymuint a,
+	       ymuint b) const;
+
+    const vector<PriCut>& mCutList;
+
+    bool mDelayMode;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // プライベートメンバ関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief node のカットを作る．
+  void
+  make_cuts(const SbjNode* node);
+
+  /// @brief ファンインのカット(自明なカットを含む)を得る．
+  /// @param[in] node ファンインのノード
+  /// @param[out] cut_list カットのリスト
+  /// @param[out] leaf_list 葉のリスト
+  /// @note 自明なカットの葉は leaf_list の最後に置く．
+  void
+  get_fanin_cuts(const SbjNode* node,
+		 vector<PriCut>& cut_list,
+		 vector<const SbjNode*>& leaf_list);
+
+  /// @brief 2つのカットを併合して候補に加える．
+  /// @param[in] node 根のノード
+  /// @param[in] cut0, leaves0 ファンイン0 のカット
+  /// @param[in] cut1, leaves1 ファンイン1 のカット
+  void
+  merge(const SbjNode* node,
+	const PriCut& cut0,
+	const SbjNode* const * leaves0,
+	const PriCut& cut1,
+	const SbjNode* const * leaves1);
+
+  /// @brief 候補のカットのコストを計算する．
+  void
+  calc_cost(const SbjNode* node,
+	    PriCut& cut,
+	    const SbjNode* const * leaves);
+
+  /// @brief leaves1 が leaves2 に含まれていたら true を返す．
+  static
+  bool
+  check_contain(const SbjNode* const * leaves1,
+		ymuint n1,
+		const SbjNode* const * leaves2,
+		ymuint n2);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 入力数の最大値
+  ymuint32 mLimit;
+
+  // 各ノードで保持するカット数
+  ymuint32 mCutNum;
+
+  // 段数優先の時 true にするフラグ
+  bool mDelayMode;
+
+  // 真理値表を計算する時 true にするフラグ
+  bool mUseTv;
+
+  // 各ノードごとの作業領域
+  vector<NodeInfo> mNodeInfo;
+
+  // ファンイン0 のカットのリスト
+  vector<PriCut> mCutList0;
+
+  // ファンイン0 のカットの葉のリスト
+  vector<const SbjNode*> mLeafList0;
+
+  // ファンイン1 のカットのリスト
+  vector<PriCut> mCutList1;
+
+  // ファンイン1 のカットの葉のリスト
+  vector<const SbjNode*> mLeafList1;
+
+  // ファンイン0 のカットの葉の併合後の位置
+  vector<ymuint32> mPosList0;
+
+  // ファンイン1 のカットの葉の併合後の位置
+  vector<ymuint32> mPosList1;
+
+  // 候補のカットのリスト
+  vector<PriCut> mCandList;
+
+  // 候補のカットの葉のリスト
+  vector<const SbjNode*> mCandLeafList;
+
+  // 候補のカットの番号を並べ替えるための配列
+  vector<ymuint32> mOrder;
+
+};
+
+END_NAMESPACE_YM_LUTMAP
+
+#endif // LIBYM_LUTMAP_ENUMPRICUT_H
@@ -459,6 +459,23 @@ LnGraph::new_lut(const vector<LnNode*>& inodes,
   return node;
 }
 
+// @brief 6入力以下の LUTノードを作る．
+// @param[in] inodes 入力ノードのベクタ
+// @param[in] tv 真理値表を表すビットベクタ
+LnNode*
+LnGraph::new_lut(const vector<LnNode*>& inodes,
+		 ymuint64 tv)
+{
+  ymuint ni = inodes.size();
+  assert_cond(ni <= 6, __FILE__, __LINE__);
+  ymuint np = 1U << ni;
+  vector<int> tv_vec(np);
+  for (ymuint p = 0; p < np; ++ p) {
+    tv_vec[p] = (tv >> p) & 1U;
+  }
+  return new_lut(inodes, tv_vec);
+}
+
 // @brief DFFノードを作る．
 // @return 作成したノードを返す．
 LnNode*
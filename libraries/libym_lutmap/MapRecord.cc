@@ -74,6 +74,7 @@ MapRecord::gen_mapgraph(const SbjGraph& sbjgraph,
 			ymuint& depth)
 {
   mapgraph.clear();
+  mLutHash.clear();
 
   mapgraph.set_name(sbjgraph.name());
 
@@ -330,24 +331,76 @@ MapRecord::back_trace(const SbjNode* node,
     }
   }
 
-  ymuint np = 1 << ni;
-  vector<int> tv(np);
-  LogExpr expr = cut->expr();
-  if ( inv ) {
-    expr = ~expr;
+  if ( ni <= 6 ) {
+    // カットの真理値表をそのまま用いる．
+    ymuint64 tv = cut->tv();
+    if ( inv ) {
+      tv = ~tv;
+    }
+    mapnode = find_lut(tv, mapnetwork);
   }
+  else {
+    ymuint np = 1 << ni;
+    vector<int> tv(np);
+    LogExpr expr = cut->expr();
+    if ( inv ) {
+      expr = ~expr;
+    }
 
-  // 論理式から真理値表を作る．
-  make_tv(ni, expr, tv);
+    // 論理式から真理値表を作る．
+    make_tv(ni, expr, tv);
 
-  // 新しいノードを作り mNodeMap に登録する．
-  mapnode = mapnetwork.new_lut(mTmpFanins, tv);
+    // 新しいノードを作る．
+    mapnode = mapnetwork.new_lut(mTmpFanins, tv);
+  }
+
+  // mNodeMap に登録する．
   node_info.mMapNode[idx] = mapnode;
   node_info.mDepth = idepth + 1;
 
   return mapnode;
 }
 
+// mTmpFanins を入力とする6入力以下の LUT を作る．
+// 同じ入力と真理値表を持つ LUT が既にあればそれを返す．
+LnNode*
+MapRecord::find_lut(ymuint64 tv,
+		    LnGraph& mapnetwork)
+{
+  ymuint ni = mTmpFanins.size();
+  if ( ni < 6 ) {
+    // 使われないビットを落としておく．
+    tv &= (1ULL << (1U << ni)) - 1ULL;
+  }
+
+  ymuint key = static_cast<ymuint>(tv ^ (tv >> 32));
+  for (ymuint i = 0; i < ni; ++ i) {
+    key = key * 1021 + mTmpFanins[i]->id();
+  }
+  vector<pair<ymuint64, LnNode*> >& lut_list = mLutHash[key];
+  for (vector<pair<ymuint64, LnNode*> >::iterator p = lut_list.begin();
+       p != lut_list.end(); ++ p) {
+    LnNode* node = p->second;
+    if ( p->first != tv || node->fanin_num() != ni ) {
+      continue;
+    }
+    bool found = true;
+    for (ymuint i = 0; i < ni; ++ i) {
+      if ( node->fanin(i) != mTmpFanins[i] ) {
+	found = false;
+	break;
+      }
+    }
+    if ( found ) {
+      return node;
+    }
+  }
+
+  LnNode* node = mapnetwork.new_lut(mTmpFanins, tv);
+  lut_list.push_back(make_pair(tv, node));
+  return node;
+}
+
 // @brief マッピング結果の LUT 数を見積もる．
 int
 MapRecord::estimate(const SbjGraph& sbjgraph)
@@ -94,6 +94,12 @@ private:
 	     bool inv,
 	     LnGraph& mapnetwork);
 
+  // mTmpFanins を入力とする6入力以下の LUT を作る．
+  // 同じ入力と真理値表を持つ LUT が既にあればそれを返す．
+  LnNode*
+  find_lut(ymuint64 tv,
+	   LnGraph& mapnetwork);
+
   // estimate() で用いるバックトレース
   int
   back_trace2(const SbjNode* node,
@@ -155,6 +161,10 @@ private:
   // back_trace 中に用いる作業領域
   vector<LnNode*> mTmpFanins;
 
+  // 入力と真理値表が同一の LUT を共有するためのハッシュ表
+  // キーは入力と真理値表から作ったハッシュ値
+  hash_map<ymuint, vector<pair<ymuint64, LnNode*> > > mLutHash;
+
 };
 
 END_NAMESPACE_YM_LUTMAP
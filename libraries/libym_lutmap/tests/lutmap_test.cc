@@ -0,0 +1,247 @@
+
+/// @file libym_lutmap/tests/lutmap_test.cc
+/// @brief LUT マッピングのテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_lutmap/lutmap_nsdef.h"
+#include "ym_lutmap/LnGraph.h"
+#include "ym_bnet/BNetwork.h"
+#include "ym_bnet/BNetBlifReader.h"
+#include "ym_bnet/BNetDecomp.h"
+#include "ym_bnet/BNet2Sbj.h"
+#include "ym_sbj/SbjGraph.h"
+#include "ym_lexp/LogExpr.h"
+#include "ym_utils/RandGen.h"
+
+
+BEGIN_NAMESPACE_YM_LUTMAP
+
+BEGIN_NONAMESPACE
+
+// 全数シミュレーションを行う入力数の上限
+const ymuint kExhaustMax = 16;
+
+// ランダムシミュレーションのワード数
+const ymuint kRandomWords = 64;
+
+// 元のネットワークを 64 パタン分シミュレーションする．
+// ipat は外部入力の順に並んでいる．
+// 外部出力の順に値を opat に格納する．
+void
+sim_bnet(const BNetwork& network,
+	 const vector<ymulong>& ipat,
+	 vector<ymulong>& opat)
+{
+  vector<ymulong> vals(network.max_node_id());
+  ymuint pos = 0;
+  for (BNodeList::const_iterator p = network.inputs_begin();
+       p != network.inputs_end(); ++ p, ++ pos) {
+    vals[(*p)->id()] = ipat[pos];
+  }
+
+  BNodeVector node_list;
+  network.tsort(node_list);
+  vector<ymulong> tmp;
+  for (BNodeVector::const_iterator p = node_list.begin();
+       p != node_list.end(); ++ p) {
+    BNode* node = *p;
+    ymuint ni = node->ni();
+    tmp.resize(ni);
+    for (ymuint i = 0; i < ni; ++ i) {
+      tmp[i] = vals[node->fanin(i)->id()];
+    }
+    vals[node->id()] = node->func().eval(tmp);
+  }
+
+  opat.clear();
+  for (BNodeList::const_iterator p = network.outputs_begin();
+       p != network.outputs_end(); ++ p) {
+    opat.push_back(vals[(*p)->fanin(0)->id()]);
+  }
+}
+
+// LUT ネットワークを 64 パタン分シミュレーションする．
+// 入力ノードの subid() で ipat の値を参照する．
+// 外部出力の順に値を opat に格納する．
+void
+sim_lngraph(const LnGraph& lngraph,
+	    const vector<ymulong>& ipat,
+	    vector<ymulong>& opat)
+{
+  vector<ymulong> vals(lngraph.max_node_id(), 0UL);
+  const LnNodeList& input_list = lngraph.input_list();
+  for (LnNodeList::const_iterator p = input_list.begin();
+       p != input_list.end(); ++ p) {
+    const LnNode* node = *p;
+    vals[node->id()] = ipat[node->subid()];
+  }
+
+  vector<LnNode*> node_list;
+  lngraph.sort(node_list);
+  vector<int> tv;
+  for (vector<LnNode*>::const_iterator p = node_list.begin();
+       p != node_list.end(); ++ p) {
+    const LnNode* node = *p;
+    ymuint ni = node->fanin_num();
+    node->tv(tv);
+    // 真理値ベクタのインデックスのビット i が i 番めの入力に対応する．
+    ymulong val = 0UL;
+    for (ymuint b = 0; b < 64; ++ b) {
+      ymuint idx = 0;
+      for (ymuint i = 0; i < ni; ++ i) {
+	if ( (vals[node->fanin(i)->id()] >> b) & 1UL ) {
+	  idx |= (1U << i);
+	}
+      }
+      if ( tv[idx] ) {
+	val |= (1UL << b);
+      }
+    }
+    vals[node->id()] = val;
+  }
+
+  opat.clear();
+  const LnNodeList& output_list = lngraph.output_list();
+  for (LnNodeList::const_iterator p = output_list.begin();
+       p != output_list.end(); ++ p) {
+    const LnNode* inode = (*p)->fanin(0);
+    opat.push_back(inode ? vals[inode->id()] : 0UL);
+  }
+}
+
+END_NONAMESPACE
+
+
+// blif ファイルの回路を LUT にマッピングし，
+// 元の回路とシミュレーションで比較する．
+// 入力数が kExhaustMax 以下なら全数，それ以外はランダムパタンを用いる．
+// -k で LUT の入力数，-c でカットの保持数(0 で全列挙)を指定する．
+// -d を指定すると delay_map を用いる．
+int
+lutmap_test(int argc,
+	    char** argv)
+{
+  ymuint limit = 6;
+  ymuint cut_num = 0;
+  bool delay = false;
+  int base = 1;
+  for ( ; base < argc && argv[base][0] == '-'; ++ base) {
+    string opt = argv[base];
+    if ( opt == "-d" ) {
+      delay = true;
+    }
+    else if ( opt == "-k" && base + 1 < argc ) {
+      ++ base;
+      limit = atoi(argv[base]);
+    }
+    else if ( opt == "-c" && base + 1 < argc ) {
+      ++ base;
+      cut_num = atoi(argv[base]);
+    }
+    else {
+      break;
+    }
+  }
+  if ( base + 1 != argc ) {
+    cerr << "USAGE : " << argv[0]
+	 << " [-k <limit>] [-c <cut_num>] [-d] blif-file" << endl;
+    return 2;
+  }
+
+  BNetwork network;
+  BNetBlifReader reader;
+  if ( !reader.read(argv[base], network) ) {
+    cerr << "Error in reading " << argv[base] << endl;
+    return 1;
+  }
+  if ( network.latch_node_num() > 0 ) {
+    cerr << argv[base] << " is not a combinational circuit" << endl;
+    return 2;
+  }
+
+  BNetwork network2 = network;
+  BNetDecomp decomp;
+  decomp(network2, 2, false);
+  SbjGraph sbjgraph;
+  BNet2Sbj conv;
+  if ( !conv(network2, sbjgraph, cerr) ) {
+    return 1;
+  }
+
+  LnGraph lngraph;
+  ymuint lut_num;
+  ymuint depth;
+  if ( delay ) {
+    delay_map(sbjgraph, limit, 0, 0, cut_num, lngraph, lut_num, depth);
+  }
+  else {
+    area_map(sbjgraph, limit, 0, cut_num, lngraph, lut_num, depth);
+  }
+  cout << "luts: " << lut_num << ", depth: " << depth << endl;
+
+  ymuint ni = network.input_num();
+  ymuint no = network.output_num();
+  if ( lngraph.input_num() != ni || lngraph.output_num() != no ) {
+    cerr << "Error: # of inputs/outputs mismatch" << endl;
+    return 1;
+  }
+
+  bool exhaust = (ni <= kExhaustMax);
+  ymuint nw = kRandomWords;
+  if ( exhaust ) {
+    nw = (ni > 6) ? (1U << (ni - 6)) : 1;
+  }
+  RandGen randgen;
+  vector<ymulong> ipat(ni);
+  vector<ymulong> opat1;
+  vector<ymulong> opat2;
+  ymuint nerr = 0;
+  for (ymuint w = 0; w < nw; ++ w) {
+    for (ymuint i = 0; i < ni; ++ i) {
+      ymulong pat = 0UL;
+      if ( exhaust ) {
+	// パタン番号 w * 64 + b のビット i を入力 i に割り当てる．
+	for (ymuint b = 0; b < 64; ++ b) {
+	  ymuint64 p = (static_cast<ymuint64>(w) << 6) + b;
+	  if ( (p >> i) & 1U ) {
+	    pat |= (1UL << b);
+	  }
+	}
+      }
+      else {
+	pat = (static_cast<ymulong>(randgen.int32()) << 32) |
+	  randgen.int32();
+      }
+      ipat[i] = pat;
+    }
+    sim_bnet(network, ipat, opat1);
+    sim_lngraph(lngraph, ipat, opat2);
+    for (ymuint o = 0; o < no; ++ o) {
+      if ( opat1[o] != opat2[o] ) {
+	cerr << "Error: output#" << o << " mismatch" << endl;
+	++ nerr;
+      }
+    }
+  }
+
+  if ( nerr > 0 ) {
+    return 1;
+  }
+  return 0;
+}
+
+END_NAMESPACE_YM_LUTMAP
+
+
+int
+main(int argc,
+     char** argv)
+{
+  return nsYm::nsLutmap::lutmap_test(argc, argv);
+}
@@ -605,6 +605,15 @@ public:
   new_lut(const vector<LnNode*>& inodes,
 	  const vector<int>& tv);
 
+  /// @brief 6入力以下の LUTノードを作る．
+  /// @param[in] inodes 入力ノードのベクタ
+  /// @param[in] tv 真理値表を表すビットベクタ
+  /// @return 作成したノードを返す．
+  /// @note tv のビット p が真理値ベクタの p 番めの要素になる．
+  LnNode*
+  new_lut(const vector<LnNode*>& inodes,
+	  ymuint64 tv);
+
   /// @brief DFFノードを作る．
   /// @return 作成したノードを返す．
   LnNode*
@@ -111,6 +111,18 @@ public:
   Literal
   get(ymuint pos) const;
 
+  /// @brief pos 番目の要素を設定する．
+  /// @note 割り当ての順番を保つ必要があるので，レベル0で
+  /// 要素を詰め直す時以外には用いないこと．
+  void
+  set(ymuint pos,
+      Literal lit);
+
+  /// @brief 要素数を size に減らす．
+  /// @note 読み出し位置も size となる．レベル0でのみ用いる．
+  void
+  shrink(ymuint size);
+
 
 public:
   //////////////////////////////////////////////////////////////////////
@@ -219,6 +231,24 @@ AssignList::get(ymuint pos) const
   return mList[pos];
 }
 
+// @brief pos 番目の要素を設定する．
+inline
+void
+AssignList::set(ymuint pos,
+		Literal lit)
+{
+  mList[pos] = lit;
+}
+
+// @brief 要素数を size に減らす．
+inline
+void
+AssignList::shrink(ymuint size)
+{
+  mTail = size;
+  mHead = size;
+}
+
 // @brief 現在のレベルを返す．
 inline
 int
@@ -0,0 +1,170 @@
+#ifndef LIBYM_SAT_BOUNDEDQUEUE_H
+#define LIBYM_SAT_BOUNDEDQUEUE_H
+
+/// @file libym_sat/BoundedQueue.h
+/// @brief BoundedQueue のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_sat/sat_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+/// @class BoundedQueue BoundedQueue.h "BoundedQueue.h"
+/// @brief 最近の値の移動平均を求めるための固定長のキュー
+///
+/// glucose 方式のリスタートで，最近の学習節の LBD の平均や
+/// 矛盾時の割り当て数の平均を求めるのに用いる．
+/// 要素数が上限に達したら古いものから捨てる．
+//////////////////////////////////////////////////////////////////////
+class BoundedQueue
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] size 要素数の上限
+  explicit
+  BoundedQueue(ymuint size = 0);
+
+  /// @brief デストラクタ
+  ~BoundedQueue();
+
+
+public:
+
+  /// @brief 要素数の上限を設定する．
+  /// @note 内容はクリアされる．
+  void
+  set_size(ymuint size);
+
+  /// @brief 値を追加する．
+  void
+  push(ymuint32 val);
+
+  /// @brief 内容をクリアする．
+  void
+  clear();
+
+  /// @brief 要素数が上限に達していたら true を返す．
+  bool
+  full() const;
+
+  /// @brief 平均値を返す．
+  double
+  avg() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 要素数の上限
+  ymuint32 mSize;
+
+  // 要素数
+  ymuint32 mNum;
+
+  // 次に書き込む位置
+  ymuint32 mPos;
+
+  // 要素の総和
+  ymuint64 mSum;
+
+  // 要素の配列
+  ymuint32* mArray;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+inline
+BoundedQueue::BoundedQueue(ymuint size) :
+  mSize(0),
+  mArray(NULL)
+{
+  set_size(size);
+}
+
+// @brief デストラクタ
+inline
+BoundedQueue::~BoundedQueue()
+{
+  delete [] mArray;
+}
+
+// @brief 要素数の上限を設定する．
+inline
+void
+BoundedQueue::set_size(ymuint size)
+{
+  if ( mSize != size ) {
+    delete [] mArray;
+    mSize = size;
+    mArray = (size > 0) ? new ymuint32[size] : NULL;
+  }
+  clear();
+}
+
+// @brief 値を追加する．
+inline
+void
+BoundedQueue::push(ymuint32 val)
+{
+  if ( mNum == mSize ) {
+    mSum -= mArray[mPos];
+  }
+  else {
+    ++ mNum;
+  }
+  mArray[mPos] = val;
+  mSum += val;
+  ++ mPos;
+  if ( mPos == mSize ) {
+    mPos = 0;
+  }
+}
+
+// @brief 内容をクリアする．
+inline
+void
+BoundedQueue::clear()
+{
+  mNum = 0;
+  mPos = 0;
+  mSum = 0;
+}
+
+// @brief 要素数が上限に達していたら true を返す．
+inline
+bool
+BoundedQueue::full() const
+{
+  return mNum == mSize;
+}
+
+// @brief 平均値を返す．
+inline
+double
+BoundedQueue::avg() const
+{
+  if ( mNum == 0 ) {
+    return 0.0;
+  }
+  return static_cast<double>(mSum) / mNum;
+}
+
+END_NAMESPACE_YM_SAT
+
+#endif // LIBYM_SAT_BOUNDEDQUEUE_H
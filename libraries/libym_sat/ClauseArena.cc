@@ -0,0 +1,133 @@
+
+/// @file libym_sat/ClauseArena.cc
+/// @brief ClauseArena の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ClauseArena.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// mSizeLearnt 中の移動済みフラグ
+const ymuint32 kRelocBit = 2U;
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス ClauseArena
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+ClauseArena::ClauseArena() :
+  mSize(0),
+  mNum(1),
+  mWasted(0),
+  mArray(NULL)
+{
+}
+
+// @brief デストラクタ
+ClauseArena::~ClauseArena()
+{
+  delete [] mArray;
+}
+
+// @brief 新しい節を生成する．
+// @param[in] lits リテラルのリスト
+// @param[in] learnt 学習節の場合 true
+// @return 節の位置を返す．
+ymuint32
+ClauseArena::new_clause(const vector<Literal>& lits,
+			bool learnt)
+{
+  ymuint32 units = clause_units(lits.size());
+  if ( mNum + units > mSize ) {
+    expand(mNum + units);
+  }
+  ymuint32 cref = mNum;
+  mNum += units;
+  new (mArray + cref) SatClause(lits, learnt);
+  return cref;
+}
+
+// @brief 節を削除する．
+// @param[in] cref 節の位置
+void
+ClauseArena::delete_clause(ymuint32 cref)
+{
+  mWasted += clause_units(clause(cref).size());
+}
+
+// @brief 節を別の ClauseArena に移す．
+// @param[in] cref 節の位置
+// @param[in] to 移動先の ClauseArena
+// @return 移動先での位置を返す．
+// @note 一度移した節に対して再び呼ばれた場合には同じ値を返す．
+ymuint32
+ClauseArena::reloc(ymuint32 cref,
+		   ClauseArena& to)
+{
+  SatClause& c = clause(cref);
+  if ( c.mSizeLearnt & kRelocBit ) {
+    // 移動済みの節では先頭のリテラルの位置に移動先が入っている．
+    return c.mLits[0].index();
+  }
+  ymuint32 units = clause_units(c.size());
+  if ( to.mNum + units > to.mSize ) {
+    to.expand(to.mNum + units);
+  }
+  ymuint32 new_cref = to.mNum;
+  to.mNum += units;
+  for (ymuint32 i = 0; i < units; ++ i) {
+    to.mArray[new_cref + i] = mArray[cref + i];
+  }
+  c.mSizeLearnt |= kRelocBit;
+  c.mLits[0] = Literal::index2literal(new_cref);
+  return new_cref;
+}
+
+// @brief from の内容を移す．
+// @note from は空になる．
+void
+ClauseArena::move(ClauseArena& from)
+{
+  delete [] mArray;
+  mSize = from.mSize;
+  mNum = from.mNum;
+  mWasted = from.mWasted;
+  mArray = from.mArray;
+  from.mSize = 0;
+  from.mNum = 1;
+  from.mWasted = 0;
+  from.mArray = NULL;
+}
+
+// @brief 配列を拡張する．
+void
+ClauseArena::expand(ymuint32 req_size)
+{
+  ymuint32 old_size = mSize;
+  ymuint64* old_array = mArray;
+  if ( mSize == 0 ) {
+    mSize = 4096;
+  }
+  while ( mSize < req_size ) {
+    mSize <<= 1;
+  }
+  mArray = new ymuint64[mSize];
+  for (ymuint32 i = 0; i < mNum && i < old_size; ++ i) {
+    mArray[i] = old_array[i];
+  }
+  delete [] old_array;
+}
+
+END_NAMESPACE_YM_SAT
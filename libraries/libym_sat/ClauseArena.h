@@ -0,0 +1,162 @@
+#ifndef LIBYM_SAT_CLAUSEARENA_H
+#define LIBYM_SAT_CLAUSEARENA_H
+
+/// @file libym_sat/ClauseArena.h
+/// @brief ClauseArena のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_sat/sat_nsdef.h"
+#include "SatClause.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+/// @class ClauseArena ClauseArena.h "ClauseArena.h"
+/// @brief SatClause を連続した領域に確保するためのクラス
+///
+/// 節を一つずつ new すると節がメモリ上に散らばってしまい，
+/// implication() 中のキャッシュミスの原因となる．
+/// そこで 8 バイトを単位とする一つの配列の上に節を詰めて置き，
+/// 節は配列上の位置(32ビット)で参照する．
+/// 位置 0 は空の SatReason と区別するために使わない．
+/// 配列を拡張すると SatClause のアドレスが変わるので，
+/// new_clause() をまたいで SatClause& を保持してはいけない．
+/// 削除された節の領域は wasted() として数えておき，
+/// SatSolverImpl が適当な時期に reloc() を用いて新しい ClauseArena に
+/// 生きている節を移す．
+//////////////////////////////////////////////////////////////////////
+class ClauseArena
+{
+public:
+
+  /// @brief コンストラクタ
+  ClauseArena();
+
+  /// @brief デストラクタ
+  ~ClauseArena();
+
+
+public:
+
+  /// @brief 新しい節を生成する．
+  /// @param[in] lits リテラルのリスト
+  /// @param[in] learnt 学習節の場合 true
+  /// @return 節の位置を返す．
+  ymuint32
+  new_clause(const vector<Literal>& lits,
+	     bool learnt);
+
+  /// @brief 節を削除する．
+  /// @param[in] cref 節の位置
+  /// @note 実際には使われていない領域として数えるだけ
+  void
+  delete_clause(ymuint32 cref);
+
+  /// @brief 節を取り出す．
+  /// @param[in] cref 節の位置
+  SatClause&
+  clause(ymuint32 cref) const;
+
+  /// @brief 節を別の ClauseArena に移す．
+  /// @param[in] cref 節の位置
+  /// @param[in] to 移動先の ClauseArena
+  /// @return 移動先での位置を返す．
+  /// @note 一度移した節に対して再び呼ばれた場合には同じ値を返す．
+  ymuint32
+  reloc(ymuint32 cref,
+	ClauseArena& to);
+
+  /// @brief from の内容を移す．
+  /// @note from は空になる．
+  void
+  move(ClauseArena& from);
+
+  /// @brief 使用中の領域の大きさ(8バイト単位)を返す．
+  ymuint32
+  size() const;
+
+  /// @brief 削除された節の領域の大きさ(8バイト単位)を返す．
+  ymuint32
+  wasted() const;
+
+
+private:
+
+  /// @brief リテラル数 n の節に必要な領域の大きさ(8バイト単位)を返す．
+  static
+  ymuint32
+  clause_units(ymuint n);
+
+  /// @brief 配列を拡張する．
+  void
+  expand(ymuint32 req_size);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 配列のサイズ
+  ymuint32 mSize;
+
+  // 使用中の領域の大きさ
+  ymuint32 mNum;
+
+  // 削除された節の領域の大きさ
+  ymuint32 mWasted;
+
+  // 配列
+  // SatClause が double を持つので 8 バイト単位で確保する．
+  ymuint64* mArray;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 節を取り出す．
+inline
+SatClause&
+ClauseArena::clause(ymuint32 cref) const
+{
+  return *reinterpret_cast<SatClause*>(mArray + cref);
+}
+
+// @brief 使用中の領域の大きさ(8バイト単位)を返す．
+inline
+ymuint32
+ClauseArena::size() const
+{
+  return mNum;
+}
+
+// @brief 削除された節の領域の大きさ(8バイト単位)を返す．
+inline
+ymuint32
+ClauseArena::wasted() const
+{
+  return mWasted;
+}
+
+// @brief リテラル数 n の節に必要な領域の大きさ(8バイト単位)を返す．
+inline
+ymuint32
+ClauseArena::clause_units(ymuint n)
+{
+  ymuint size = sizeof(SatClause) + sizeof(Literal) * (n - 1);
+  return (size + sizeof(ymuint64) - 1) / sizeof(ymuint64);
+}
+
+END_NAMESPACE_YM_SAT
+
+#endif // LIBYM_SAT_CLAUSEARENA_H
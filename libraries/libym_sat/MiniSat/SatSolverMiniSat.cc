@@ -14,13 +14,27 @@
 
 BEGIN_NAMESPACE_YM_SAT
 
+BEGIN_NONAMESPACE
+
+// Literal を MiniSat の Lit に変換する．
+inline
+Lit
+to_lit(Literal l)
+{
+  return Lit(l.varid(), l.pol() == kPolNega);
+}
+
+END_NONAMESPACE
+
 
 //////////////////////////////////////////////////////////////////////
 // SatSolverMiniSat
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-SatSolverMiniSat::SatSolverMiniSat()
+SatSolverMiniSat::SatSolverMiniSat() :
+  mGroupLit(1, kLiteralX),
+  mLiveGroupNum(0)
 {
 }
 
@@ -50,14 +64,117 @@ SatSolverMiniSat::new_var()
 void
 SatSolverMiniSat::add_clause(const vector<Literal>& lits)
 {
+  if ( !mScopeStack.empty() ) {
+    // スコープの中では現在のスコープの節グループに追加する．
+    add_group_clause(mScopeStack.back(), lits);
+    return;
+  }
+
   vec<Lit> tmp;
   for (vector<Literal>::const_iterator p = lits.begin();
        p != lits.end(); ++ p) {
-    Literal l = *p;
-    Lit lit(l.varid(), l.pol() == kPolNega);
-    tmp.push(lit);
+    tmp.push(to_lit(*p));
+  }
+  mSolver.addClause(tmp);
+}
+
+// @brief 節グループを作る．
+// @return グループ番号を返す．
+ymuint
+SatSolverMiniSat::new_group()
+{
+  ymuint group;
+  if ( mFreeGroupList.empty() ) {
+    group = mGroupLit.size();
+    mGroupLit.push_back(kLiteralX);
+  }
+  else {
+    group = mFreeGroupList.back();
+    mFreeGroupList.pop_back();
+  }
+  mGroupLit[group] = Literal(mSolver.newVar(), kPolPosi);
+  ++ mLiveGroupNum;
+  return group;
+}
+
+// @brief 節グループに節を追加する．
+// @param[in] group グループ番号
+// @param[in] lits リテラルのベクタ
+void
+SatSolverMiniSat::add_group_clause(ymuint group,
+				   const vector<Literal>& lits)
+{
+  if ( group >= mGroupLit.size() || mGroupLit[group] == kLiteralX ) {
+    cout << "Error![SatSolverMiniSat]: group(" << group
+	 << "): illegal group" << endl;
+    return;
+  }
+
+  vec<Lit> tmp;
+  for (vector<Literal>::const_iterator p = lits.begin();
+       p != lits.end(); ++ p) {
+    tmp.push(to_lit(*p));
+  }
+  tmp.push(to_lit(~mGroupLit[group]));
+  mSolver.addClause(tmp);
+}
+
+// @brief 節グループを解放する．
+// @param[in] group グループ番号
+void
+SatSolverMiniSat::release_group(ymuint group)
+{
+  if ( group >= mGroupLit.size() || mGroupLit[group] == kLiteralX ) {
+    cout << "Error![SatSolverMiniSat]: group(" << group
+	 << "): illegal group" << endl;
+    return;
   }
+
+  // 活性化変数を false に固定する．
+  // 充足された節は MiniSat の simplifyDB() で削除される．
+  vec<Lit> tmp;
+  tmp.push(to_lit(~mGroupLit[group]));
   mSolver.addClause(tmp);
+
+  mGroupLit[group] = kLiteralX;
+  mFreeGroupList.push_back(group);
+  -- mLiveGroupNum;
+}
+
+// @brief 新しいスコープを始める．
+void
+SatSolverMiniSat::push()
+{
+  mScopeStack.push_back(new_group());
+}
+
+// @brief 直前の push() 以降に追加された節を取り除く．
+void
+SatSolverMiniSat::pop()
+{
+  if ( mScopeStack.empty() ) {
+    cout << "Error![SatSolverMiniSat]: pop() without push()" << endl;
+    return;
+  }
+  ymuint group = mScopeStack.back();
+  mScopeStack.pop_back();
+  release_group(group);
+}
+
+// @brief 現在のスコープの深さを返す．
+ymuint
+SatSolverMiniSat::scope_level() const
+{
+  return mScopeStack.size();
+}
+
+// @brief 変数を凍結する．
+// @param[in] var 変数番号
+// @param[in] frozen 凍結する時 true，凍結を解く時 false
+void
+SatSolverMiniSat::set_frozen(tVarId var,
+			     bool frozen)
+{
 }
 
 // @brief SAT 問題を解く．
@@ -72,11 +189,18 @@ SatSolverMiniSat::solve(const vector<Literal>& assumptions,
 			vector<Bool3>& model)
 {
   vec<Lit> tmp;
+  // 生きている節グループの活性化リテラルを assumption に加える．
+  if ( mLiveGroupNum > 0 ) {
+    for (vector<Literal>::const_iterator p = mGroupLit.begin();
+	 p != mGroupLit.end(); ++ p) {
+      if ( *p != kLiteralX ) {
+	tmp.push(to_lit(*p));
+      }
+    }
+  }
   for (vector<Literal>::const_iterator p = assumptions.begin();
        p != assumptions.end(); ++ p) {
-    Literal l = *p;
-    Lit lit(l.varid(), l.pol() == kPolNega);
-    tmp.push(lit);
+    tmp.push(to_lit(*p));
   }
   bool ans = mSolver.solve(tmp);
   if ( ans ) {
@@ -125,6 +249,11 @@ SatSolverMiniSat::get_stats(SatStats& stats) const
   stats.mPropagationNum = mSolver.stats.propagations;
   stats.mConflictLimit = 0;
   stats.mLearntLimit = 0;
+  stats.mElimVarNum = 0;
+  stats.mSubsumedNum = 0;
+  stats.mStrengthenedNum = 0;
+  stats.mProbedUnitNum = 0;
+  stats.mSimpTime = USTime();
 }
 
 // @brief 変数の数を得る．
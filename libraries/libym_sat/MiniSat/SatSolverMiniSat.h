@@ -58,6 +58,51 @@ public:
   void
   add_clause(const vector<Literal>& lits);
 
+  /// @brief 節グループを作る．
+  /// @return グループ番号を返す．
+  virtual
+  ymuint
+  new_group();
+
+  /// @brief 節グループに節を追加する．
+  /// @param[in] group グループ番号
+  /// @param[in] lits リテラルのベクタ
+  virtual
+  void
+  add_group_clause(ymuint group,
+		   const vector<Literal>& lits);
+
+  /// @brief 節グループを解放する．
+  /// @param[in] group グループ番号
+  /// @note MiniSat 版では活性化変数の再利用は行わない．
+  virtual
+  void
+  release_group(ymuint group);
+
+  /// @brief 新しいスコープを始める．
+  virtual
+  void
+  push();
+
+  /// @brief 直前の push() 以降に追加された節を取り除く．
+  virtual
+  void
+  pop();
+
+  /// @brief 現在のスコープの深さを返す．
+  virtual
+  ymuint
+  scope_level() const;
+
+  /// @brief 変数を凍結する．
+  /// @param[in] var 変数番号
+  /// @param[in] frozen 凍結する時 true，凍結を解く時 false
+  /// @note MiniSat 版では前処理を行わないので何もしない．
+  virtual
+  void
+  set_frozen(tVarId var,
+	     bool frozen = true);
+
   /// @brief SAT 問題を解く．
   /// @param[in] assumptions あらかじめ仮定する変数の値割り当てリスト
   /// @param[out] model 充足するときの値の割り当てを格納する配列．
@@ -116,6 +161,20 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   Solver mSolver;
+
+  // 節グループの活性化リテラルの配列
+  // グループ番号をインデックスとする．
+  // 0 番目と解放されたグループは kLiteralX となる．
+  vector<Literal> mGroupLit;
+
+  // 生きている節グループの数
+  ymuint32 mLiveGroupNum;
+
+  // 再利用可能なグループ番号のリスト
+  vector<ymuint> mFreeGroupList;
+
+  // push() で作られた節グループのスタック
+  vector<ymuint> mScopeStack;
   
 };
 
@@ -91,6 +91,10 @@ protected:
   SatReason
   reason(tVarId varid) const;
 
+  // 割り当て理由の節を得る．
+  SatClause&
+  clause(SatReason r) const;
+
   // 変数のアクティビティを増加させる．
   void
   bump_var_activity(tVarId varid);
@@ -121,9 +125,12 @@ public:
   
   /// @brief SatAnalyzerの派生クラスを生成する．
   /// @param[in] option どのクラスを生成するかを決めるオプション文字列
+  /// @param[in] minimize 学習節の再帰的な最小化を行う時 true にする．
+  /// @note minimize は SaUIP1 の場合のみ意味を持つ．
   static
   SatAnalyzer*
-  gen_analyzer(const string& option = string());
+  gen_analyzer(const string& option = string(),
+	       bool minimize = false);
   
 };
 
@@ -181,6 +188,14 @@ SatAnalyzer::reason(tVarId varid) const
   return mSolver->reason(varid);
 }
 
+// 割り当て理由の節を得る．
+inline
+SatClause&
+SatAnalyzer::clause(SatReason r) const
+{
+  return mSolver->clause(r);
+}
+
 // 変数のアクティビティを増加させる．
 inline
 void
@@ -26,8 +26,9 @@ SatClause::SatClause(const vector<Literal>& lits,
 		     bool learnt)
 {
   size_t n = lits.size();
-  mSizeLearnt = (n << 1) | static_cast<ymuint>(learnt);
+  mSizeLearnt = (n << 2) | static_cast<ymuint>(learnt);
   mActivity = 0.0;
+  mLbdUsed = 0U;
   for (size_t i = 0; i < n; ++ i) {
     mLits[i] = lits[i];
   }
@@ -81,7 +82,8 @@ operator<<(ostream& s,
     s << r.literal();
   }
   else {
-    s << r.clause();
+    // 節の中身は ClauseArena がないとわからないので位置を出力する．
+    s << "C#" << r.clause_ref();
   }
   return s;
 }
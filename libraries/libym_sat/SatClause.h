@@ -23,16 +23,21 @@ BEGIN_NAMESPACE_YM_SAT
 /// 中身は本当に Literal の配列．しかも，クラスのインスタンスと別に配列
 /// 領域を確保するのはポインタ参照が一回増えて嫌なので，見かけはサイズ1
 /// の配列 mLits[1] を定義しておいて，実際には要素数分の領域を確保した
-/// メモリブロックを SatClause* として扱う．
-/// このために「ポインタ付き new」演算子を用いている．
-/// 詳しくは SatSolverImpl::new_clause() を参照
+/// メモリブロックを SatClause として扱う．
+/// このメモリブロックは ClauseArena の連続した領域上に「ポインタ付き
+/// new」演算子を用いて作られる．詳しくは ClauseArena::new_clause() を参照
 /// SatClause はそれ以外の情報として，制約節か学習節かを区別する1ビット
-/// (サイズと合わせて1ワード)のフラグ，activity を表す double 変数を
-/// 持つ．
+/// と ClauseArena のガーベージコレクション用の1ビット
+/// (サイズと合わせて1ワード)のフラグ，activity を表す double 変数，
+/// 学習節の LBD (literal block distance) と最後の reduceDB() 以降に
+/// 矛盾の解析に使われたかを表すフラグを持つ．
+/// サイズと先頭のリテラルが同じキャッシュラインに乗るように
+/// activity を先頭に置いている．
 //////////////////////////////////////////////////////////////////////
 class SatClause
 {
   friend class SatSolverImpl;
+  friend class ClauseArena;
 private:
 
   /// @brief コンストラクタ
@@ -77,6 +82,25 @@ public:
   /// @brief 学習節の場合にアクティビティを返す．
   double
   activity() const;
+
+  /// @brief 学習節の場合に LBD を返す．
+  ymuint
+  lbd() const;
+
+  /// @brief 最後の reduceDB() 以降に矛盾の解析に使われていたら true を返す．
+  bool
+  is_used() const;
+
+
+private:
+
+  /// @brief LBD を設定する．
+  void
+  set_lbd(ymuint lbd);
+
+  /// @brief 使われたかどうかのフラグを設定する．
+  void
+  set_used(bool used);
   
 
 private:
@@ -84,12 +108,15 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // サイズと learnt フラグをパックしたもの
-  ymuint32 mSizeLearnt;
-
   // activity
   double mActivity;
-  
+
+  // LBD と使用フラグをパックしたもの
+  ymuint32 mLbdUsed;
+
+  // サイズと learnt フラグと移動済みフラグをパックしたもの
+  ymuint32 mSizeLearnt;
+
   // リテラルの配列
   // 実際にはこの後にリテラル数分の領域を確保する．
   Literal mLits[1];
@@ -112,7 +139,7 @@ inline
 ymuint
 SatClause::size() const
 {
-  return (mSizeLearnt >> 1);
+  return (mSizeLearnt >> 2);
 }
 
 // @brief リテラルのアクセス
@@ -163,6 +190,38 @@ SatClause::activity() const
   return mActivity;
 }
 
+// @brief 学習節の場合に LBD を返す．
+inline
+ymuint
+SatClause::lbd() const
+{
+  return mLbdUsed >> 1;
+}
+
+// @brief 最後の reduceDB() 以降に矛盾の解析に使われていたら true を返す．
+inline
+bool
+SatClause::is_used() const
+{
+  return static_cast<bool>(mLbdUsed & 1U);
+}
+
+// @brief LBD を設定する．
+inline
+void
+SatClause::set_lbd(ymuint lbd)
+{
+  mLbdUsed = (lbd << 1) | (mLbdUsed & 1U);
+}
+
+// @brief 使われたかどうかのフラグを設定する．
+inline
+void
+SatClause::set_used(bool used)
+{
+  mLbdUsed = (mLbdUsed & ~1U) | static_cast<ymuint32>(used);
+}
+
 END_NAMESPACE_YM_SAT
 
 #endif // LIBYM_SAT_SATCLAUSE_H
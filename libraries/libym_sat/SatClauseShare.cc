@@ -0,0 +1,257 @@
+
+/// @file libym_sat/SatClauseShare.cc
+/// @brief SatClauseShare の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "SatClauseShare.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// リングバッファのサイズ(ワード数)
+// 2のべき乗でなければならない．
+const ymuint64 kRingSize = 1 << 16;
+
+// リングバッファの位置のマスク
+const ymuint64 kRingMask = kRingSize - 1;
+
+// 共有する学習節のリテラル数の最大値
+// これより長い節は書き込まない．
+const ymuint kMaxLitNum = 32;
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// SatClauseShare
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] n ソルバの数
+// @param[in] deterministic 決定的モードの時 true にする．
+SatClauseShare::SatClauseShare(ymuint n,
+			       bool deterministic) :
+  mNum(n),
+  mDeterministic(deterministic),
+  mDone(false),
+  mWinner(-1),
+  mArrived(0),
+  mFinished(0),
+  mGeneration(0),
+  mLastDone(false)
+{
+  mRingArray = new Ring[n];
+  for (ymuint i = 0; i < n; ++ i) {
+    Ring& r = mRingArray[i];
+    r.mBuf = new ymuint32[kRingSize];
+    r.mHead = 0;
+    r.mTail = new ymuint64[n];
+    for (ymuint j = 0; j < n; ++ j) {
+      r.mTail[j] = 0;
+    }
+  }
+  pthread_mutex_init(&mLock, NULL);
+  pthread_cond_init(&mCond, NULL);
+}
+
+// @brief デストラクタ
+SatClauseShare::~SatClauseShare()
+{
+  pthread_cond_destroy(&mCond);
+  pthread_mutex_destroy(&mLock);
+  for (ymuint i = 0; i < mNum; ++ i) {
+    Ring& r = mRingArray[i];
+    delete [] r.mBuf;
+    delete [] r.mTail;
+  }
+  delete [] mRingArray;
+}
+
+// @brief 学習節を書き込む．
+// @param[in] id 書き込むソルバの番号
+// @param[in] lits 学習節のリテラルのリスト
+// @param[in] lbd 学習節の LBD
+void
+SatClauseShare::put(ymuint id,
+		    const vector<Literal>& lits,
+		    ymuint lbd)
+{
+  ymuint n = lits.size();
+  if ( n == 0 || n > kMaxLitNum ) {
+    return;
+  }
+
+  // 書き込むのは自分だけなので mHead はここでは変化しない．
+  Ring& r = mRingArray[id];
+  ymuint64 pos = r.mHead;
+  r.mBuf[pos & kRingMask] = n;
+  r.mBuf[(pos + 1) & kRingMask] = lbd;
+  for (ymuint i = 0; i < n; ++ i) {
+    r.mBuf[(pos + 2 + i) & kRingMask] = lits[i].index();
+  }
+  // 内容を書き終えてから書き込み位置を進める．
+  __sync_synchronize();
+  r.mHead = pos + n + 2;
+}
+
+// @brief 他のソルバの学習節を一つ読み出す．
+// @param[in] id 読み出すソルバの番号
+// @param[out] lits 学習節のリテラルのリスト
+// @param[out] lbd 学習節の LBD
+// @retval true 読み出した．
+// @retval false 新しい学習節がなかった．
+bool
+SatClauseShare::get(ymuint id,
+		    vector<Literal>& lits,
+		    ymuint& lbd)
+{
+  for (ymuint src = 0; src < mNum; ++ src) {
+    if ( src == id ) {
+      continue;
+    }
+    Ring& r = mRingArray[src];
+    for ( ; ; ) {
+      ymuint64 head = r.mHead;
+      __sync_synchronize();
+      ymuint64& tail = r.mTail[id];
+      if ( tail == head ) {
+	break;
+      }
+      if ( head - tail > kRingSize - (kMaxLitNum + 2) ) {
+	// 追い越されたので読み飛ばす．
+	tail = head;
+	break;
+      }
+      ymuint n = r.mBuf[tail & kRingMask];
+      if ( n == 0 || n > kMaxLitNum ) {
+	// 書き換えられている最中の領域を読んだ．
+	tail = head;
+	break;
+      }
+      lbd = r.mBuf[(tail + 1) & kRingMask];
+      lits.resize(n);
+      for (ymuint i = 0; i < n; ++ i) {
+	ymuint32 index = r.mBuf[(tail + 2 + i) & kRingMask];
+	lits[i] = Literal::index2literal(index);
+      }
+      // 読んでいる間に上書きされていないか確かめる．
+      // 書き込み側は mHead を進める前に最大で kMaxLitNum + 2 ワード
+      // 先まで書いている可能性がある．
+      __sync_synchronize();
+      ymuint64 head2 = r.mHead;
+      if ( head2 - tail > kRingSize - (kMaxLitNum + 2) ) {
+	tail = head2;
+	continue;
+      }
+      tail += n + 2;
+      return true;
+    }
+  }
+  return false;
+}
+
+// @brief solve() を始める前の初期化を行う．
+void
+SatClauseShare::start()
+{
+  mDone = false;
+  mWinner = -1;
+  mArrived = 0;
+  mFinished = 0;
+  mLastDone = false;
+}
+
+// @brief 学習節を取り込む前の同期を行う．
+// @param[in] id ソルバの番号
+// @retval true 探索を続ける．
+// @retval false 他のソルバが答えを出したので探索を打ち切る．
+bool
+SatClauseShare::sync(ymuint id)
+{
+  if ( !mDeterministic ) {
+    return !mDone;
+  }
+
+  pthread_mutex_lock(&mLock);
+  barrier();
+  // mDone そのものは他のソルバの終了によって変化するので
+  // 同期が解けた時点の値を用いる．
+  bool ans = !mLastDone;
+  pthread_mutex_unlock(&mLock);
+  return ans;
+}
+
+// @brief 学習節を取り込んだ後の同期を行う．
+// @param[in] id ソルバの番号
+void
+SatClauseShare::end_sync(ymuint id)
+{
+  if ( !mDeterministic ) {
+    return;
+  }
+
+  pthread_mutex_lock(&mLock);
+  barrier();
+  pthread_mutex_unlock(&mLock);
+}
+
+// @brief ソルバの solve() が終わったことを知らせる．
+// @param[in] id ソルバの番号
+// @param[in] answered 答え(kB3True/kB3False)を出した時 true
+void
+SatClauseShare::finish(ymuint id,
+		       bool answered)
+{
+  pthread_mutex_lock(&mLock);
+  ++ mFinished;
+  if ( answered ) {
+    int id1 = static_cast<int>(id);
+    if ( mWinner == -1 || (mDeterministic && id1 < mWinner) ) {
+      mWinner = id1;
+    }
+    __sync_synchronize();
+    mDone = true;
+  }
+  // 終了したソルバを待っているものがいるかもしれない．
+  if ( mArrived > 0 && mArrived + mFinished >= mNum ) {
+    release();
+  }
+  pthread_mutex_unlock(&mLock);
+}
+
+// 全てのソルバが到達するまで待つ．
+// solve() を終えたソルバは到達したものとみなす．
+void
+SatClauseShare::barrier()
+{
+  ymuint64 gen = mGeneration;
+  ++ mArrived;
+  if ( mArrived + mFinished >= mNum ) {
+    release();
+  }
+  else {
+    while ( gen == mGeneration ) {
+      pthread_cond_wait(&mCond, &mLock);
+    }
+  }
+}
+
+// 待っているソルバを全て再開させる．
+void
+SatClauseShare::release()
+{
+  mArrived = 0;
+  mLastDone = mDone;
+  ++ mGeneration;
+  pthread_cond_broadcast(&mCond);
+}
+
+END_NAMESPACE_YM_SAT
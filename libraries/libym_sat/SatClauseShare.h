@@ -0,0 +1,228 @@
+#ifndef LIBYM_SAT_SATCLAUSESHARE_H
+#define LIBYM_SAT_SATCLAUSESHARE_H
+
+/// @file libym_sat/SatClauseShare.h
+/// @brief SatClauseShare のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_sat/sat_nsdef.h"
+#include "ym_lexp/Literal.h"
+
+#include <pthread.h>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+/// @class SatClauseShare SatClauseShare.h "SatClauseShare.h"
+/// @brief ポートフォリオ中のソルバ間で学習節を交換するためのクラス
+///
+/// ソルバごとに一つのリングバッファを持つ．
+/// - 書き込むのは持ち主のソルバだけで，書き込み位置は単調に増加する．
+/// - 他のソルバはそれぞれ自分の読み出し位置を持っていて，ロックを
+///   取らずに読み出す．読んでいる間に上書きされたことがわかったら
+///   その節を捨てて書き込み位置まで読み飛ばす．
+/// 決定的モードでは sync() と end_sync() の間だけで読み出しを行い，
+/// その間は誰も書き込まないので交換される節の集合がスレッドの
+/// 実行速度によらずに決まる．
+//////////////////////////////////////////////////////////////////////
+class SatClauseShare
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] n ソルバの数
+  /// @param[in] deterministic 決定的モードの時 true にする．
+  SatClauseShare(ymuint n,
+		 bool deterministic);
+
+  /// @brief デストラクタ
+  ~SatClauseShare();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 学習節の受け渡しを行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 決定的モードの時 true を返す．
+  bool
+  deterministic() const;
+
+  /// @brief 学習節を書き込む．
+  /// @param[in] id 書き込むソルバの番号
+  /// @param[in] lits 学習節のリテラルのリスト
+  /// @param[in] lbd 学習節の LBD
+  void
+  put(ymuint id,
+      const vector<Literal>& lits,
+      ymuint lbd);
+
+  /// @brief 他のソルバの学習節を一つ読み出す．
+  /// @param[in] id 読み出すソルバの番号
+  /// @param[out] lits 学習節のリテラルのリスト
+  /// @param[out] lbd 学習節の LBD
+  /// @retval true 読み出した．
+  /// @retval false 新しい学習節がなかった．
+  bool
+  get(ymuint id,
+      vector<Literal>& lits,
+      ymuint& lbd);
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // solve() の制御を行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief solve() を始める前の初期化を行う．
+  void
+  start();
+
+  /// @brief いずれかのソルバが答えを出していたら true を返す．
+  /// @note 決定的モードではこの値を探索の制御に用いてはいけない．
+  bool
+  done() const;
+
+  /// @brief 学習節を取り込む前の同期を行う．
+  /// @param[in] id ソルバの番号
+  /// @retval true 探索を続ける．
+  /// @retval false 他のソルバが答えを出したので探索を打ち切る．
+  /// @note 決定的モードでは全てのソルバがここに到達するまで待つ．
+  bool
+  sync(ymuint id);
+
+  /// @brief 学習節を取り込んだ後の同期を行う．
+  /// @param[in] id ソルバの番号
+  /// @note 決定的モードでは全てのソルバがここに到達するまで待つ．
+  void
+  end_sync(ymuint id);
+
+  /// @brief ソルバの solve() が終わったことを知らせる．
+  /// @param[in] id ソルバの番号
+  /// @param[in] answered 答え(kB3True/kB3False)を出した時 true
+  void
+  finish(ymuint id,
+	 bool answered);
+
+  /// @brief 答えを出したソルバの番号を返す．
+  /// @note 答えを出したソルバがない時は -1 を返す．
+  /// @note 決定的モードでは同時に答えを出したものの中で番号最小のもの
+  int
+  winner() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // ソルバごとのリングバッファ
+  // 各節は [リテラル数, LBD, リテラルのインデックス...] の形で置かれる．
+  struct Ring
+  {
+    // バッファ本体
+    ymuint32* mBuf;
+
+    // 書き込み位置(バッファサイズで割った余りが実際の位置)
+    volatile ymuint64 mHead;
+
+    // 他のソルバの読み出し位置の配列
+    ymuint64* mTail;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  // 全てのソルバが到達するまで待つ．
+  // mutex を取った状態で呼ぶこと．
+  void
+  barrier();
+
+  // 待っているソルバを全て再開させる．
+  // mutex を取った状態で呼ぶこと．
+  void
+  release();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ソルバの数
+  ymuint32 mNum;
+
+  // 決定的モードの時 true となるフラグ
+  bool mDeterministic;
+
+  // リングバッファの配列
+  Ring* mRingArray;
+
+  // 答えが出た時に true となるフラグ
+  volatile bool mDone;
+
+  // 答えを出したソルバの番号
+  int mWinner;
+
+  // 同期用の mutex
+  pthread_mutex_t mLock;
+
+  // 同期用の条件変数
+  pthread_cond_t mCond;
+
+  // 同期点に到達したソルバの数
+  ymuint32 mArrived;
+
+  // solve() を終えたソルバの数
+  ymuint32 mFinished;
+
+  // 同期の世代
+  ymuint64 mGeneration;
+
+  // 直前の同期が解けた時点の mDone の値
+  bool mLastDone;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 決定的モードの時 true を返す．
+inline
+bool
+SatClauseShare::deterministic() const
+{
+  return mDeterministic;
+}
+
+// @brief いずれかのソルバが答えを出していたら true を返す．
+inline
+bool
+SatClauseShare::done() const
+{
+  return mDone;
+}
+
+// @brief 答えを出したソルバの番号を返す．
+inline
+int
+SatClauseShare::winner() const
+{
+  return mWinner;
+}
+
+END_NAMESPACE_YM_SAT
+
+#endif // LIBYM_SAT_SATCLAUSESHARE_H
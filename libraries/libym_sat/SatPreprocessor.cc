@@ -0,0 +1,523 @@
+
+/// @file libym_sat/SatPreprocessor.cc
+/// @brief SatPreprocessor の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "SatPreprocessor.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// これより長い節は包含のチェックに用いない．
+const ymuint kSubsumeLimit = 1000;
+
+// resolvent の長さの上限
+const ymuint kMaxResolventSize = 20;
+
+// 正負の出現回数の積の上限
+// これを越える変数は除去を試みない．
+const ymuint64 kMaxPairNum = 100000;
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス SatPreprocessor
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+SatPreprocessor::SatPreprocessor(ymuint var_num) :
+  mVarNum(var_num),
+  mSane(true),
+  mOccList(var_num * 2),
+  mVal(var_num, kB3X),
+  mFrozen(var_num, false),
+  mElim(var_num, false),
+  mUnitHead(0),
+  mStamp(var_num * 2, 0),
+  mStampVal(0),
+  mSubsumedNum(0),
+  mStrengthenedNum(0)
+{
+}
+
+// @brief デストラクタ
+SatPreprocessor::~SatPreprocessor()
+{
+  for (vector<Clause*>::iterator p = mClauseList.begin();
+       p != mClauseList.end(); ++ p) {
+    delete *p;
+  }
+}
+
+// @brief 変数を凍結する．
+void
+SatPreprocessor::set_frozen(tVarId var)
+{
+  mFrozen[var] = true;
+}
+
+// @brief 節を追加する．
+void
+SatPreprocessor::add_clause(const vector<Literal>& lits)
+{
+  if ( mSane ) {
+    mSane = reg_clause(lits);
+  }
+}
+
+// @brief 前処理を行う．
+bool
+SatPreprocessor::run()
+{
+  if ( !mSane ) {
+    return false;
+  }
+
+  // まず全ての節で包含のチェックを行う．
+  ymuint n = mClauseList.size();
+  for (ymuint id = 0; id < n; ++ id) {
+    put_queue(id);
+  }
+  if ( !backward_subsumption() ) {
+    mSane = false;
+    return false;
+  }
+
+  // 正負の出現回数の積の小さい変数から順に除去を試みる．
+  vector<pair<ymuint64, tVarId> > cand_list;
+  cand_list.reserve(mVarNum);
+  for (tVarId var = 0; var < mVarNum; ++ var) {
+    if ( mFrozen[var] || mVal[var] != kB3X ) {
+      continue;
+    }
+    ymuint64 n0 = mOccList[Literal(var, kPolPosi).index()].size();
+    ymuint64 n1 = mOccList[Literal(var, kPolNega).index()].size();
+    if ( n0 + n1 > 0 ) {
+      cand_list.push_back(make_pair(n0 * n1, var));
+    }
+  }
+  sort(cand_list.begin(), cand_list.end());
+  for (vector<pair<ymuint64, tVarId> >::iterator p = cand_list.begin();
+       p != cand_list.end(); ++ p) {
+    if ( !eliminate_var(p->second) ) {
+      mSane = false;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// 節を登録する．
+bool
+SatPreprocessor::reg_clause(const vector<Literal>& lits)
+{
+  ymuint n = lits.size();
+  if ( n == 0 ) {
+    return false;
+  }
+  if ( n == 1 ) {
+    return assign(lits[0]);
+  }
+
+  ymuint id = mClauseList.size();
+  Clause* clause = new Clause;
+  clause->mLits = lits;
+  clause->mSig = signature(lits);
+  clause->mDeleted = false;
+  clause->mQueued = false;
+  mClauseList.push_back(clause);
+  for (ymuint i = 0; i < n; ++ i) {
+    mOccList[lits[i].index()].push_back(id);
+  }
+  return true;
+}
+
+// 節を削除する．
+// 出現リストからは get_occ_list() の時に取り除かれる．
+void
+SatPreprocessor::delete_clause(ymuint id)
+{
+  Clause* clause = mClauseList[id];
+  clause->mDeleted = true;
+  vector<Literal> dummy;
+  clause->mLits.swap(dummy);
+}
+
+// 節からリテラルを取り除く．
+bool
+SatPreprocessor::strengthen(ymuint id,
+			    Literal lit)
+{
+  Clause* clause = mClauseList[id];
+  vector<Literal>& lits = clause->mLits;
+  ymuint n = lits.size();
+  ymuint wpos = 0;
+  for (ymuint rpos = 0; rpos < n; ++ rpos) {
+    Literal l = lits[rpos];
+    if ( l != lit ) {
+      lits[wpos] = l;
+      ++ wpos;
+    }
+  }
+  lits.erase(lits.begin() + wpos, lits.end());
+
+  if ( wpos == 1 ) {
+    Literal unit = lits[0];
+    delete_clause(id);
+    return assign(unit);
+  }
+  clause->mSig = signature(lits);
+  put_queue(id);
+  return true;
+}
+
+// 単位節の割り当てを行う．
+bool
+SatPreprocessor::assign(Literal lit)
+{
+  tVarId var = lit.varid();
+  Bool3 val = (lit.pol() == kPolPosi) ? kB3True : kB3False;
+  if ( mVal[var] != kB3X ) {
+    return mVal[var] == val;
+  }
+  mVal[var] = val;
+  mUnitList.push_back(lit);
+  return true;
+}
+
+// 単位節の割り当てを伝搬させる．
+bool
+SatPreprocessor::propagate()
+{
+  while ( mUnitHead < mUnitList.size() ) {
+    Literal lit = mUnitList[mUnitHead];
+    ++ mUnitHead;
+
+    // lit を含む節は充足している．
+    // 出現リストには自己包含で lit がなくなった節も含まれている．
+    vector<ymuint>& occ1 = mOccList[lit.index()];
+    for (vector<ymuint>::iterator p = occ1.begin(); p != occ1.end(); ++ p) {
+      Clause* clause = mClauseList[*p];
+      if ( !clause->mDeleted && has_lit(*clause, lit) ) {
+	delete_clause(*p);
+      }
+    }
+    vector<ymuint>().swap(occ1);
+
+    // ~lit を含む節からは ~lit を取り除く．
+    Literal nlit = ~lit;
+    vector<ymuint> occ2;
+    occ2.swap(mOccList[nlit.index()]);
+    for (vector<ymuint>::iterator p = occ2.begin(); p != occ2.end(); ++ p) {
+      Clause* clause = mClauseList[*p];
+      if ( !clause->mDeleted && has_lit(*clause, nlit) ) {
+	if ( !strengthen(*p, nlit) ) {
+	  return false;
+	}
+      }
+    }
+  }
+  return true;
+}
+
+// キューに入っている節で包含のチェックを行う．
+bool
+SatPreprocessor::backward_subsumption()
+{
+  for ( ; ; ) {
+    while ( !mQueue.empty() ) {
+      ymuint id = mQueue.back();
+      mQueue.pop_back();
+      Clause* clause = mClauseList[id];
+      clause->mQueued = false;
+      if ( clause->mDeleted || clause->mLits.size() > kSubsumeLimit ) {
+	continue;
+      }
+
+      // 出現回数の最も少ない変数を選ぶ．
+      const vector<Literal>& lits = clause->mLits;
+      ymuint n = lits.size();
+      Literal best = lits[0];
+      ymuint min_num = mOccList[best.index()].size() +
+	mOccList[(~best).index()].size();
+      for (ymuint i = 1; i < n; ++ i) {
+	Literal l = lits[i];
+	ymuint num = mOccList[l.index()].size() +
+	  mOccList[(~l).index()].size();
+	if ( min_num > num ) {
+	  min_num = num;
+	  best = l;
+	}
+      }
+
+      for (ymuint b = 0; b < 2; ++ b) {
+	Literal l = (b == 0) ? best : ~best;
+	// strengthen() は出現リストを変更しないので
+	// 参照のままで大丈夫
+	const vector<ymuint>& occ = mOccList[l.index()];
+	for (ymuint i = 0; i < occ.size(); ++ i) {
+	  ymuint id2 = occ[i];
+	  if ( id2 == id ) {
+	    continue;
+	  }
+	  Clause* clause2 = mClauseList[id2];
+	  if ( clause2->mDeleted ||
+	       clause2->mLits.size() < n ||
+	       (clause->mSig & ~clause2->mSig) != 0 ) {
+	    continue;
+	  }
+	  Literal flip;
+	  if ( !subsumes(*clause, *clause2, flip) ) {
+	    continue;
+	  }
+	  if ( flip == kLiteralX ) {
+	    delete_clause(id2);
+	    ++ mSubsumedNum;
+	  }
+	  else {
+	    ++ mStrengthenedNum;
+	    if ( !strengthen(id2, ~flip) ) {
+	      return false;
+	    }
+	  }
+	}
+      }
+    }
+
+    if ( mUnitHead == mUnitList.size() ) {
+      break;
+    }
+    if ( !propagate() ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 節が lit を含んでいたら true を返す．
+bool
+SatPreprocessor::has_lit(const Clause& clause,
+			 Literal lit)
+{
+  const vector<Literal>& lits = clause.mLits;
+  for (vector<Literal>::const_iterator p = lits.begin();
+       p != lits.end(); ++ p) {
+    if ( *p == lit ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// 包含チェックのキューに節を入れる．
+void
+SatPreprocessor::put_queue(ymuint id)
+{
+  Clause* clause = mClauseList[id];
+  if ( !clause->mQueued && !clause->mDeleted ) {
+    clause->mQueued = true;
+    mQueue.push_back(id);
+  }
+}
+
+// c1 が c2 を包含しているか調べる．
+bool
+SatPreprocessor::subsumes(const Clause& c1,
+			  const Clause& c2,
+			  Literal& flip)
+{
+  new_stamp();
+  const vector<Literal>& lits2 = c2.mLits;
+  for (vector<Literal>::const_iterator p = lits2.begin();
+       p != lits2.end(); ++ p) {
+    mStamp[p->index()] = mStampVal;
+  }
+
+  flip = kLiteralX;
+  const vector<Literal>& lits1 = c1.mLits;
+  for (vector<Literal>::const_iterator p = lits1.begin();
+       p != lits1.end(); ++ p) {
+    Literal l = *p;
+    if ( mStamp[l.index()] == mStampVal ) {
+      continue;
+    }
+    if ( flip == kLiteralX && mStamp[(~l).index()] == mStampVal ) {
+      flip = l;
+      continue;
+    }
+    return false;
+  }
+  return true;
+}
+
+// 変数の除去を試みる．
+bool
+SatPreprocessor::eliminate_var(tVarId var)
+{
+  if ( mVal[var] != kB3X || mFrozen[var] || mElim[var] ) {
+    return true;
+  }
+
+  Literal plit(var, kPolPosi);
+  Literal nlit(var, kPolNega);
+  get_occ_list(plit, mPosList);
+  get_occ_list(nlit, mNegList);
+  ymuint np = mPosList.size();
+  ymuint nn = mNegList.size();
+  if ( np + nn == 0 ) {
+    // もう節に現れない．
+    return true;
+  }
+  if ( static_cast<ymuint64>(np) * nn > kMaxPairNum ) {
+    return true;
+  }
+
+  // resolvent を作ってみて節数が増えないか調べる．
+  mResolventList.clear();
+  ymuint limit = np + nn;
+  vector<Literal> tmp_lits;
+  for (ymuint i = 0; i < np; ++ i) {
+    const vector<Literal>& lits1 = mClauseList[mPosList[i]]->mLits;
+    for (ymuint j = 0; j < nn; ++ j) {
+      const vector<Literal>& lits2 = mClauseList[mNegList[j]]->mLits;
+      if ( !merge(lits1, lits2, var, tmp_lits) ) {
+	continue;
+      }
+      if ( tmp_lits.size() > kMaxResolventSize ||
+	   mResolventList.size() == limit ) {
+	return true;
+      }
+      mResolventList.push_back(tmp_lits);
+    }
+  }
+
+  // 削除する節を記録しておく．
+  ElimRecord rec;
+  rec.mVar = var;
+  rec.mBegin = mElimLits.size();
+  for (ymuint b = 0; b < 2; ++ b) {
+    Literal pivot = (b == 0) ? plit : nlit;
+    const vector<ymuint>& id_list = (b == 0) ? mPosList : mNegList;
+    for (vector<ymuint>::const_iterator p = id_list.begin();
+	 p != id_list.end(); ++ p) {
+      const vector<Literal>& lits = mClauseList[*p]->mLits;
+      mElimLits.push_back(pivot);
+      for (vector<Literal>::const_iterator q = lits.begin();
+	   q != lits.end(); ++ q) {
+	if ( *q != pivot ) {
+	  mElimLits.push_back(*q);
+	}
+      }
+      mElimLits.push_back(kLiteralX);
+      delete_clause(*p);
+    }
+  }
+  rec.mEnd = mElimLits.size();
+  mElimRecordList.push_back(rec);
+  mElim[var] = true;
+  vector<ymuint>().swap(mOccList[plit.index()]);
+  vector<ymuint>().swap(mOccList[nlit.index()]);
+
+  // resolvent を追加する．
+  for (vector<vector<Literal> >::iterator p = mResolventList.begin();
+       p != mResolventList.end(); ++ p) {
+    ymuint id = mClauseList.size();
+    if ( !reg_clause(*p) ) {
+      return false;
+    }
+    if ( mClauseList.size() > id ) {
+      put_queue(id);
+    }
+  }
+  return backward_subsumption();
+}
+
+// c1 と c2 の var に関する resolvent を作る．
+bool
+SatPreprocessor::merge(const vector<Literal>& c1,
+		       const vector<Literal>& c2,
+		       tVarId var,
+		       vector<Literal>& resolvent)
+{
+  resolvent.clear();
+  new_stamp();
+  for (vector<Literal>::const_iterator p = c1.begin();
+       p != c1.end(); ++ p) {
+    Literal l = *p;
+    if ( l.varid() != var ) {
+      resolvent.push_back(l);
+      mStamp[l.index()] = mStampVal;
+    }
+  }
+  for (vector<Literal>::const_iterator p = c2.begin();
+       p != c2.end(); ++ p) {
+    Literal l = *p;
+    if ( l.varid() == var ) {
+      continue;
+    }
+    if ( mStamp[(~l).index()] == mStampVal ) {
+      return false;
+    }
+    if ( mStamp[l.index()] != mStampVal ) {
+      resolvent.push_back(l);
+    }
+  }
+  return true;
+}
+
+// lit を含む節のリストを作る．
+// ついでに出現リストから不要な要素を取り除く．
+void
+SatPreprocessor::get_occ_list(Literal lit,
+			      vector<ymuint>& id_list)
+{
+  id_list.clear();
+  vector<ymuint>& occ = mOccList[lit.index()];
+  ymuint wpos = 0;
+  for (ymuint rpos = 0; rpos < occ.size(); ++ rpos) {
+    ymuint id = occ[rpos];
+    Clause* clause = mClauseList[id];
+    if ( !clause->mDeleted && has_lit(*clause, lit) ) {
+      occ[wpos] = id;
+      ++ wpos;
+      id_list.push_back(id);
+    }
+  }
+  occ.erase(occ.begin() + wpos, occ.end());
+}
+
+// リテラルの印の世代を進める．
+void
+SatPreprocessor::new_stamp()
+{
+  ++ mStampVal;
+  if ( mStampVal == 0 ) {
+    // 一周したのでクリアする．
+    fill(mStamp.begin(), mStamp.end(), 0);
+    mStampVal = 1;
+  }
+}
+
+// リテラルのシグネチャを計算する．
+ymuint64
+SatPreprocessor::signature(const vector<Literal>& lits)
+{
+  ymuint64 sig = 0;
+  for (vector<Literal>::const_iterator p = lits.begin();
+       p != lits.end(); ++ p) {
+    sig |= (1ULL << (p->varid() % 64));
+  }
+  return sig;
+}
+
+END_NAMESPACE_YM_SAT
@@ -0,0 +1,361 @@
+#ifndef LIBYM_SAT_SATPREPROCESSOR_H
+#define LIBYM_SAT_SATPREPROCESSOR_H
+
+/// @file libym_sat/SatPreprocessor.h
+/// @brief SatPreprocessor のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_sat/sat_nsdef.h"
+#include "ym_sat/Bool3.h"
+#include "ym_lexp/Literal.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+/// @class SatPreprocessor SatPreprocessor.h "SatPreprocessor.h"
+/// @brief SatELite 風の CNF の前処理を行うクラス
+///
+/// 以下の処理を行う．
+/// - 単位節の伝搬
+/// - 包含(subsumption)による節の削除
+/// - 自己包含(self-subsuming resolution)によるリテラルの削除
+/// - 節数が増えない範囲での変数除去(bounded variable elimination)
+///
+/// SatSolverImpl が制約節をいったんここに移して run() を呼び，
+/// 結果の節を取り出して自分の節データベースを作り直す．
+/// 除去された変数の節は elim_lits() と elim_record_list() に記録され，
+/// モデルの拡張や変数の復活に用いられる．
+/// 凍結(frozen)された変数は除去されない．
+//////////////////////////////////////////////////////////////////////
+class SatPreprocessor
+{
+public:
+
+  /// @brief 変数除去の記録
+  /// 変数 mVar を除去した時に削除した節が elim_lits() 上の
+  /// [mBegin, mEnd) に置かれる．
+  /// 各節は除去した変数のリテラルを先頭に置き，kLiteralX で区切られている．
+  struct ElimRecord
+  {
+    /// @brief 除去された変数
+    tVarId mVar;
+
+    /// @brief 開始位置
+    ymuint32 mBegin;
+
+    /// @brief 終了位置
+    ymuint32 mEnd;
+  };
+
+
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] var_num 変数の数
+  explicit
+  SatPreprocessor(ymuint var_num);
+
+  /// @brief デストラクタ
+  ~SatPreprocessor();
+
+
+public:
+
+  /// @brief 変数を凍結する．
+  void
+  set_frozen(tVarId var);
+
+  /// @brief 節を追加する．
+  /// @param[in] lits リテラルのベクタ
+  /// @note lits には重複したリテラルや相補なリテラルは含まれていないこと．
+  void
+  add_clause(const vector<Literal>& lits);
+
+  /// @brief 前処理を行う．
+  /// @retval true 処理が終わった．
+  /// @retval false 充足不能であることがわかった．
+  bool
+  run();
+
+  /// @brief 残った節の数を返す．
+  /// @note 削除された節も含む．
+  ymuint
+  clause_num() const;
+
+  /// @brief 節が削除されていたら true を返す．
+  /// @param[in] id 節番号 ( 0 <= id < clause_num() )
+  bool
+  is_deleted(ymuint id) const;
+
+  /// @brief 節のリテラルのリストを返す．
+  /// @param[in] id 節番号 ( 0 <= id < clause_num() )
+  const vector<Literal>&
+  clause(ymuint id) const;
+
+  /// @brief 単位節のリストを返す．
+  const vector<Literal>&
+  unit_list() const;
+
+  /// @brief 除去された変数の節のリテラルの配列を返す．
+  const vector<Literal>&
+  elim_lits() const;
+
+  /// @brief 変数除去の記録のリストを返す．
+  const vector<ElimRecord>&
+  elim_record_list() const;
+
+  /// @brief 包含により削除された節の数を返す．
+  ymuint64
+  subsumed_num() const;
+
+  /// @brief 自己包含により削除されたリテラルの数を返す．
+  ymuint64
+  strengthened_num() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 節
+  struct Clause
+  {
+    // リテラルのリスト
+    vector<Literal> mLits;
+
+    // 変数のシグネチャ
+    ymuint64 mSig;
+
+    // 削除された時に true となるフラグ
+    bool mDeleted;
+
+    // 包含チェックのキューに入っている時に true となるフラグ
+    bool mQueued;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  // 節を登録する．
+  // 単位節の場合には節を作らずに値の割り当てを行う．
+  // 矛盾が起きたら false を返す．
+  bool
+  reg_clause(const vector<Literal>& lits);
+
+  // 節を削除する．
+  void
+  delete_clause(ymuint id);
+
+  // 節からリテラルを取り除く．
+  // 矛盾が起きたら false を返す．
+  bool
+  strengthen(ymuint id,
+	     Literal lit);
+
+  // 単位節の割り当てを行う．
+  // 矛盾が起きたら false を返す．
+  bool
+  assign(Literal lit);
+
+  // 単位節の割り当てを伝搬させる．
+  // 矛盾が起きたら false を返す．
+  bool
+  propagate();
+
+  // キューに入っている節で包含のチェックを行う．
+  // 新たにできた単位節の伝搬も行う．
+  // 矛盾が起きたら false を返す．
+  bool
+  backward_subsumption();
+
+  // 節が lit を含んでいたら true を返す．
+  static
+  bool
+  has_lit(const Clause& clause,
+	  Literal lit);
+
+  // 包含チェックのキューに節を入れる．
+  void
+  put_queue(ymuint id);
+
+  // c1 が c2 を包含しているか調べる．
+  // 包含していたら true を返し，flip に kLiteralX を入れる．
+  // リテラルを一つ反転させれば包含している場合には true を返し，
+  // flip にそのリテラル(c1 側)を入れる．
+  bool
+  subsumes(const Clause& c1,
+	   const Clause& c2,
+	   Literal& flip);
+
+  // 変数の除去を試みる．
+  // 矛盾が起きたら false を返す．
+  bool
+  eliminate_var(tVarId var);
+
+  // c1 と c2 の var に関する resolvent を作る．
+  // トートロジーになる場合には false を返す．
+  bool
+  merge(const vector<Literal>& c1,
+	const vector<Literal>& c2,
+	tVarId var,
+	vector<Literal>& resolvent);
+
+  // lit を含む節のリストを作る．
+  void
+  get_occ_list(Literal lit,
+	       vector<ymuint>& id_list);
+
+  // リテラルの印の世代を進める．
+  void
+  new_stamp();
+
+  // リテラルのシグネチャを計算する．
+  static
+  ymuint64
+  signature(const vector<Literal>& lits);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 変数の数
+  ymuint32 mVarNum;
+
+  // 矛盾が起きていない時に true となるフラグ
+  bool mSane;
+
+  // 節の配列
+  vector<Clause*> mClauseList;
+
+  // リテラルごとの出現リスト
+  // 削除された節や自己包含でリテラルがなくなった節も含まれる．
+  vector<vector<ymuint> > mOccList;
+
+  // 変数の値
+  vector<Bool3> mVal;
+
+  // 凍結された変数の印
+  vector<bool> mFrozen;
+
+  // 除去された変数の印
+  vector<bool> mElim;
+
+  // 単位節のリスト
+  vector<Literal> mUnitList;
+
+  // propagate() で次に処理する mUnitList の位置
+  ymuint32 mUnitHead;
+
+  // 包含チェックのキュー
+  vector<ymuint> mQueue;
+
+  // eliminate_var() で用いる作業領域
+  vector<ymuint> mPosList;
+  vector<ymuint> mNegList;
+  vector<vector<Literal> > mResolventList;
+
+  // 除去された変数の節のリテラルの配列
+  vector<Literal> mElimLits;
+
+  // 変数除去の記録のリスト
+  vector<ElimRecord> mElimRecordList;
+
+  // リテラルの印の配列
+  vector<ymuint32> mStamp;
+
+  // 現在の印の値
+  ymuint32 mStampVal;
+
+  // 包含により削除された節の数
+  ymuint64 mSubsumedNum;
+
+  // 自己包含により削除されたリテラルの数
+  ymuint64 mStrengthenedNum;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 残った節の数を返す．
+inline
+ymuint
+SatPreprocessor::clause_num() const
+{
+  return mClauseList.size();
+}
+
+// @brief 節が削除されていたら true を返す．
+inline
+bool
+SatPreprocessor::is_deleted(ymuint id) const
+{
+  return mClauseList[id]->mDeleted;
+}
+
+// @brief 節のリテラルのリストを返す．
+inline
+const vector<Literal>&
+SatPreprocessor::clause(ymuint id) const
+{
+  return mClauseList[id]->mLits;
+}
+
+// @brief 単位節のリストを返す．
+inline
+const vector<Literal>&
+SatPreprocessor::unit_list() const
+{
+  return mUnitList;
+}
+
+// @brief 除去された変数の節のリテラルの配列を返す．
+inline
+const vector<Literal>&
+SatPreprocessor::elim_lits() const
+{
+  return mElimLits;
+}
+
+// @brief 変数除去の記録のリストを返す．
+inline
+const vector<SatPreprocessor::ElimRecord>&
+SatPreprocessor::elim_record_list() const
+{
+  return mElimRecordList;
+}
+
+// @brief 包含により削除された節の数を返す．
+inline
+ymuint64
+SatPreprocessor::subsumed_num() const
+{
+  return mSubsumedNum;
+}
+
+// @brief 自己包含により削除されたリテラルの数を返す．
+inline
+ymuint64
+SatPreprocessor::strengthened_num() const
+{
+  return mStrengthenedNum;
+}
+
+END_NAMESPACE_YM_SAT
+
+#endif // LIBYM_SAT_SATPREPROCESSOR_H
@@ -18,8 +18,6 @@
 
 BEGIN_NAMESPACE_YM_SAT
 
-class SatClause;
-
 //////////////////////////////////////////////////////////////////////
 /// @class SatReason SatReason.h "SatReason.h"
 /// @brief 含意の原因を表すクラス
@@ -34,22 +32,32 @@ class SatClause;
 /// ただし，もともとの節が (a + b) の形なら節の代わりに ~a というリテラ
 /// ルを用いて原因を表すこともできる．そこで MiniSat では GClause
 /// という節とリテラルの両方を一般化したクラスを用いている．
-/// ここではそれに倣い，SatClause へのポインタと Literal を排他的に
-/// 表現するクラスを作った．
+/// ここではそれに倣い，SatClause と Literal を排他的に表現するクラスを
+/// 作った．
+/// 節はポインタではなく ClauseArena 上の位置(32ビット)で表すので，
+/// 中身の SatClause は SatSolverImpl::clause() で取り出す．
+/// 2リテラル節は watcher list にしか現れないので，学習節かどうかの
+/// 区別をリテラルと一緒に持っておく．
 //////////////////////////////////////////////////////////////////////
 class SatReason
 {
 public:
 
   /// @brief コンストラクタ
-  /// @param[in] clause 節へのポインタ
+  /// @note 空の SatReason となる．
+  SatReason();
+
+  /// @brief コンストラクタ
+  /// @param[in] cref 節の ClauseArena 上の位置
   explicit
-  SatReason(SatClause* clause = NULL);
+  SatReason(ymuint32 cref);
 
   /// @brief コンストラクタ
   /// @param[in] lit リテラル
+  /// @param[in] learnt 2リテラルの学習節を表す時 true にする．
   explicit
-  SatReason(Literal lit);
+  SatReason(Literal lit,
+	    bool learnt = false);
 
 
 public:
@@ -58,9 +66,9 @@ public:
   bool
   is_clause() const;
 
-  /// @brief 節を取り出す．
-  SatClause&
-  clause() const;
+  /// @brief 節の ClauseArena 上の位置を取り出す．
+  ymuint32
+  clause_ref() const;
 
   /// @brief 内容がリテラルの時 true を返す．
   bool
@@ -70,6 +78,10 @@ public:
   Literal
   literal() const;
 
+  /// @brief 内容が2リテラルの学習節を表すリテラルの時 true を返す．
+  bool
+  is_learnt_bin() const;
+
 
   //////////////////////////////////////////////////////////////////////
   // friend 関数の定義
@@ -86,8 +98,8 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // SatClause か Literal を保持する
-  ympuint mBody;
+  // 節の位置か Literal を保持する
+  ymuint32 mBody;
   
 };
 
@@ -120,19 +132,28 @@ const SatReason kNullSatReason = SatReason();
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-// @param[in] clause 節へのポインタ
 inline
-SatReason::SatReason(SatClause* clause)
+SatReason::SatReason()
 {
-  mBody = reinterpret_cast<ympuint>(clause);
+  mBody = 0U;
+}
+
+// @brief コンストラクタ
+// @param[in] cref 節の ClauseArena 上の位置
+inline
+SatReason::SatReason(ymuint32 cref)
+{
+  mBody = cref << 1;
 }
 
 // @brief コンストラクタ
 // @param[in] lit リテラル
+// @param[in] learnt 2リテラルの学習節を表す時 true にする．
 inline
-SatReason::SatReason(Literal lit)
+SatReason::SatReason(Literal lit,
+		     bool learnt)
 {
-  mBody = (lit.index() << 1) | 1UL;
+  mBody = (lit.index() << 2) | (learnt ? 2U : 0U) | 1U;
 }
 
 // @brief 内容が節の時 true を返す．
@@ -143,12 +164,12 @@ SatReason::is_clause() const
   return !is_literal();
 }
 
-// @brief 節を取り出す．
+// @brief 節の ClauseArena 上の位置を取り出す．
 inline
-SatClause&
-SatReason::clause() const
+ymuint32
+SatReason::clause_ref() const
 {
-  return *reinterpret_cast<SatClause*>(mBody);
+  return mBody >> 1;
 }
 
 // @brief 内容がリテラルの時 true を返す．
@@ -156,7 +177,7 @@ inline
 bool
 SatReason::is_literal() const
 {
-  return static_cast<bool>(mBody & 1UL);
+  return static_cast<bool>(mBody & 1U);
 }
 
 // @brief リテラルを取り出す．
@@ -164,7 +185,15 @@ inline
 Literal
 SatReason::literal() const
 {
-  return Literal::index2literal(mBody >> 1);
+  return Literal::index2literal(mBody >> 2);
+}
+
+// @brief 内容が2リテラルの学習節を表すリテラルの時 true を返す．
+inline
+bool
+SatReason::is_learnt_bin() const
+{
+  return (mBody & 3U) == 3U;
 }
 
 // @brief 等価比較演算子
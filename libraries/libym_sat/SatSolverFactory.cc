@@ -11,18 +11,107 @@
 
 #include "SatSolverImpl.h"
 #include "SatSolverImplR.h"
+#include "SatSolverPortfolio.h"
 #include "MiniSat/SatSolverMiniSat.h"
 #include "SatAnalyzer.h"
 
 
 BEGIN_NAMESPACE_YM_SAT
 
+BEGIN_NONAMESPACE
+
+// オプション文字列を解釈する．
+// オプション文字列は空白かカンマで区切られた以下のキーワードの並び
+// - uip1, simple : 解析器の種類 (SaFactory::gen_analyzer() に渡す)
+// - geometric, luby, glucose : リスタートの方式
+// - lbd : 学習節を LBD に基づいて階層的に管理する．
+// - phase : 変数の最後の値を次の割り当てに用いる．
+// - minimize : 学習節の再帰的な最小化を行う．
+// - modern : "luby lbd phase minimize" と同じ
+// - simp : solve() の前に前処理を行う．
+// 知らないキーワードは無視する．
+void
+parse_option(const string& option,
+	     Params& params,
+	     string& sa_option,
+	     bool& minimize)
+{
+  params = kDefaultParams;
+  sa_option = string();
+  minimize = false;
+
+  string::size_type pos = 0;
+  string::size_type n = option.size();
+  while ( pos < n ) {
+    string::size_type end = option.find_first_of(", \t", pos);
+    if ( end == string::npos ) {
+      end = n;
+    }
+    string word = option.substr(pos, end - pos);
+    pos = end + 1;
+
+    if ( word == "uip1" || word == "simple" ) {
+      sa_option = word;
+    }
+    else if ( word == "geometric" ) {
+      params.mRestart = kSatRestartGeometric;
+    }
+    else if ( word == "luby" ) {
+      params.mRestart = kSatRestartLuby;
+    }
+    else if ( word == "glucose" ) {
+      params.mRestart = kSatRestartGlucose;
+    }
+    else if ( word == "lbd" ) {
+      params.mLbdReduce = true;
+    }
+    else if ( word == "phase" ) {
+      params.mPhaseCache = true;
+    }
+    else if ( word == "minimize" ) {
+      minimize = true;
+    }
+    else if ( word == "modern" ) {
+      params.mRestart = kSatRestartLuby;
+      params.mLbdReduce = true;
+      params.mPhaseCache = true;
+      minimize = true;
+    }
+    else if ( word == "simp" ) {
+      params.mPreprocess = true;
+    }
+  }
+}
+
+// ポートフォリオの各ソルバのオプション文字列
+// ソルバの数がこれより多い時は先頭から繰り返し使い，
+// 変数の decay 値を少しずつ変えて多様性を持たせる．
+const char* kPortfolioOption[] = {
+  "modern",
+  "glucose lbd phase minimize",
+  "",
+  "luby phase",
+  "modern simp",
+  "glucose lbd minimize",
+  "geometric lbd phase minimize",
+  "luby lbd"
+};
+
+const ymuint kPortfolioOptionNum =
+  sizeof(kPortfolioOption) / sizeof(const char*);
+
+END_NONAMESPACE
+
 // 普通の SatSolver を生成する．
 SatSolver*
 SatSolverFactory::gen_solver(const string& option)
 {
-  SatAnalyzer* analyzer = SaFactory::gen_analyzer(option);
-  return new SatSolverImpl(analyzer);
+  Params params;
+  string sa_option;
+  bool minimize;
+  parse_option(option, params, sa_option, minimize);
+  SatAnalyzer* analyzer = SaFactory::gen_analyzer(sa_option, minimize);
+  return new SatSolverImpl(analyzer, params);
 }
 
 // ログ記録機能付き SatSolver を生成する．
@@ -30,8 +119,34 @@ SatSolver*
 SatSolverFactory::gen_recsolver(ostream& out,
 				const string& option)
 {
-  SatAnalyzer* analyzer = SaFactory::gen_analyzer(option);
-  return new SatSolverImplR(out, analyzer);
+  Params params;
+  string sa_option;
+  bool minimize;
+  parse_option(option, params, sa_option, minimize);
+  SatAnalyzer* analyzer = SaFactory::gen_analyzer(sa_option, minimize);
+  return new SatSolverImplR(out, analyzer, params);
+}
+
+// 複数のソルバを並列に走らせる SatSolver を生成する．
+SatSolver*
+SatSolverFactory::gen_portfolio(ymuint n,
+				bool deterministic)
+{
+  if ( n == 0 ) {
+    n = 1;
+  }
+  vector<SatSolverImpl*> solver_list(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    Params params;
+    string sa_option;
+    bool minimize;
+    parse_option(kPortfolioOption[i % kPortfolioOptionNum],
+		 params, sa_option, minimize);
+    params.mVarDecay -= 0.01 * (i / kPortfolioOptionNum);
+    SatAnalyzer* analyzer = SaFactory::gen_analyzer(sa_option, minimize);
+    solver_list[i] = new SatSolverImpl(analyzer, params);
+  }
+  return new SatSolverPortfolio(solver_list, deterministic);
 }
 
 // MiniSat 版 SatSolver を生成する．
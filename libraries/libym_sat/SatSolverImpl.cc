@@ -12,6 +12,7 @@
 #include "SatSolverImpl.h"
 #include "SatAnalyzer.h"
 #include "SatClause.h"
+#include "SatClauseShare.h"
 
 
 BEGIN_NAMESPACE_YM_SAT
@@ -41,6 +42,60 @@ const ymuint debug_all         = 0xffffffff;
 //const ymuint debug = debug_all;
 const ymuint debug = debug_none;
 
+// この値以下の LBD を持つ学習節は削除しない．
+const ymuint kCoreLbd = 2;
+
+// この値以下の LBD を持つ学習節は使われている限り削除しない．
+const ymuint kTier2Lbd = 6;
+
+// glucose 方式のリスタートで用いる LBD のキューの長さ
+const ymuint kLbdQueueSize = 50;
+
+// glucose 方式のリスタートで用いる割り当て数のキューの長さ
+const ymuint kTrailQueueSize = 5000;
+
+// glucose 方式のリスタートの閾値
+// 最近の LBD の平均にこの値をかけたものが全体の平均を上回ったら
+// リスタートする．
+const double kGlucoseK = 0.8;
+
+// glucose 方式のリスタートの抑制の閾値
+// 割り当て数が最近の平均のこの値倍を越えたらリスタートを抑制する．
+const double kGlucoseR = 1.4;
+
+// 他のソルバと学習節を交換する間隔(コンフリクト数)
+const ymuint64 kShareInterval = 1000;
+
+// この値以下のリテラル数の学習節を他のソルバに渡す．
+const ymuint kShareSize = 8;
+
+// この値以下の LBD を持つ学習節を他のソルバに渡す．
+const ymuint kShareLbd = 2;
+
+// Luby 数列の x 番目の要素を y を底として計算する．
+double
+luby(double y,
+     ymuint x)
+{
+  // x を含む部分列の大きさとその要素の最大値の指数を求める．
+  ymuint size = 1;
+  ymuint seq = 0;
+  while ( size < x + 1 ) {
+    ++ seq;
+    size = size * 2 + 1;
+  }
+  while ( size - 1 != x ) {
+    size = (size - 1) >> 1;
+    -- seq;
+    x = x % size;
+  }
+  double ans = 1.0;
+  for (ymuint i = 0; i < seq; ++ i) {
+    ans *= y;
+  }
+  return ans;
+}
+
 END_NONAMESPACE
 
 
@@ -53,11 +108,10 @@ Params kDefaultParams(0.95, 0.02, 0.999);
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-SatSolverImpl::SatSolverImpl(SatAnalyzer* analyzer) :
+SatSolverImpl::SatSolverImpl(SatAnalyzer* analyzer,
+			     const Params& params) :
   mAnalyzer(analyzer),
   mSane(true),
-  mAlloc(4096),
-  mWatcherAlloc(sizeof(Watcher), 1024),
   mVarNum(0),
   mOldVarNum(0),
   mVarSize(0),
@@ -66,6 +120,9 @@ SatSolverImpl::SatSolverImpl(SatAnalyzer* analyzer) :
   mReason(NULL),
   mHeapPos(NULL),
   mActivity(NULL),
+  mPhase(NULL),
+  mLbdStamp(NULL),
+  mLbdStampVal(0),
   mWatcherList(NULL),
   mHeap(NULL),
   mHeapNum(0),
@@ -74,7 +131,7 @@ SatSolverImpl::SatSolverImpl(SatAnalyzer* analyzer) :
   mVarDecay(1.0),
   mClauseBump(1.0),
   mClauseDecay(1.0),
-  mParams(kDefaultParams),
+  mParams(params),
   mConflictNum(0),
   mDecisionNum(0),
   mPropagationNum(0),
@@ -84,7 +141,26 @@ SatSolverImpl::SatSolverImpl(SatAnalyzer* analyzer) :
   mLearntLitNum(0),
   mConflictLimit(0),
   mLearntLimit(0),
-  mMaxConflict(1024 * 10)
+  mNextReduce(0),
+  mReduceInterval(0),
+  mLbdQueue(kLbdQueueSize),
+  mTrailQueue(kTrailQueueSize),
+  mLbdSum(0.0),
+  mLbdNum(0),
+  mMaxConflict(1024 * 10),
+  mGroupLit(1, kLiteralX),
+  mLiveGroupNum(0),
+  mSimpAssignNum(0),
+  mSimpPropLimit(0),
+  mNewClauseNum(0),
+  mElimVarNum(0),
+  mSubsumedNum(0),
+  mStrengthenedNum(0),
+  mProbedUnitNum(0),
+  mShare(NULL),
+  mShareId(0),
+  mNextShare(0),
+  mShareStop(false)
 {
   mAnalyzer->set_solver(this);
 
@@ -104,6 +180,8 @@ SatSolverImpl::~SatSolverImpl()
   delete [] mReason;
   delete [] mHeapPos;
   delete [] mActivity;
+  delete [] mPhase;
+  delete [] mLbdStamp;
   delete [] mWatcherList;
   delete [] mHeap;
 }
@@ -144,6 +222,8 @@ SatSolverImpl::expand_var()
   SatReason* old_reason = mReason;
   ymint32* old_heap_pos = mHeapPos;
   double* old_activity = mActivity;
+  tPol* old_phase = mPhase;
+  ymuint64* old_lbd_stamp = mLbdStamp;
   WatcherList* old_watcher_list = mWatcherList;
   ymuint32* old_heap = mHeap;
   if ( mVarSize == 0 ) {
@@ -157,6 +237,9 @@ SatSolverImpl::expand_var()
   mReason = new SatReason[mVarSize];
   mHeapPos = new ymint32[mVarSize];
   mActivity = new double[mVarSize];
+  mPhase = new tPol[mVarSize];
+  // decision level は変数の数を越えない．
+  mLbdStamp = new ymuint64[mVarSize + 1];
   mWatcherList = new WatcherList[mVarSize * 2];
   mHeap = new ymuint32[mVarSize];
   for (ymuint i = 0; i < mOldVarNum; ++ i) {
@@ -165,6 +248,10 @@ SatSolverImpl::expand_var()
     mReason[i] = old_reason[i];
     mHeapPos[i] = old_heap_pos[i];
     mActivity[i] = old_activity[i];
+    mPhase[i] = old_phase[i];
+  }
+  for (ymuint i = 0; i <= mVarSize; ++ i) {
+    mLbdStamp[i] = 0;
   }
   ymuint n2 = mOldVarNum * 2;
   for (ymuint i = 0; i < n2; ++ i) {
@@ -179,6 +266,8 @@ SatSolverImpl::expand_var()
     delete [] old_reason;
     delete [] old_heap_pos;
     delete [] old_activity;
+    delete [] old_phase;
+    delete [] old_lbd_stamp;
     delete [] old_watcher_list;
     delete [] old_heap;
   }
@@ -190,6 +279,121 @@ SatSolverImpl::expand_var()
 // @param[in] lits リテラルのベクタ
 void
 SatSolverImpl::add_clause(const vector<Literal>& lits)
+{
+  if ( !mScopeStack.empty() ) {
+    // スコープの中では現在のスコープの節グループに追加する．
+    SatSolverImpl::add_group_clause(mScopeStack.back(), lits);
+  }
+  else {
+    add_clause_sub(lits);
+  }
+}
+
+// @brief 節グループを作る．
+// @return グループ番号を返す．
+ymuint
+SatSolverImpl::new_group()
+{
+  // 活性化変数は解放済みのものがあれば再利用する．
+  // ログ記録用の派生クラスで new_var() が記録されないように
+  // 明示的に SatSolverImpl::new_var() を呼ぶ．
+  tVarId var;
+  if ( mFreeVarList.empty() ) {
+    var = SatSolverImpl::new_var();
+  }
+  else {
+    var = mFreeVarList.back();
+    mFreeVarList.pop_back();
+  }
+
+  ymuint group;
+  if ( mFreeGroupList.empty() ) {
+    group = mGroupLit.size();
+    mGroupLit.push_back(kLiteralX);
+  }
+  else {
+    group = mFreeGroupList.back();
+    mFreeGroupList.pop_back();
+  }
+  mGroupLit[group] = Literal(var, kPolPosi);
+  ++ mLiveGroupNum;
+
+  return group;
+}
+
+// @brief 節グループに節を追加する．
+// @param[in] group グループ番号
+// @param[in] lits リテラルのベクタ
+void
+SatSolverImpl::add_group_clause(ymuint group,
+				const vector<Literal>& lits)
+{
+  if ( group >= mGroupLit.size() || mGroupLit[group] == kLiteralX ) {
+    cout << "Error![SatSolverImpl]: group(" << group << "): illegal group"
+	 << endl;
+    return;
+  }
+
+  // 活性化リテラルの否定を加えて普通の節として追加する．
+  mGcTmp = lits;
+  mGcTmp.push_back(~mGroupLit[group]);
+  add_clause_sub(mGcTmp);
+}
+
+// @brief 節グループを解放する．
+// @param[in] group グループ番号
+void
+SatSolverImpl::release_group(ymuint group)
+{
+  if ( decision_level() != 0 ) {
+    // エラー
+    cout << "Error![SatSolverImpl]: decision_level() != 0" << endl;
+    return;
+  }
+
+  if ( group >= mGroupLit.size() || mGroupLit[group] == kLiteralX ) {
+    cout << "Error![SatSolverImpl]: group(" << group << "): illegal group"
+	 << endl;
+    return;
+  }
+
+  Literal alit = mGroupLit[group];
+  mGroupLit[group] = kLiteralX;
+  mFreeGroupList.push_back(group);
+  -- mLiveGroupNum;
+
+  // 活性化変数を false に固定すればこのグループの節は全て充足される．
+  // 実際の節の削除と活性化変数の再利用は simplifyDB() で行う．
+  alloc_var();
+  if ( mSane ) {
+    check_and_assign(~alit);
+  }
+  mReleasedVarList.push_back(alit.varid());
+}
+
+// @brief 新しいスコープを始める．
+void
+SatSolverImpl::push()
+{
+  mScopeStack.push_back(SatSolverImpl::new_group());
+}
+
+// @brief 直前の push() 以降に追加された節を取り除く．
+void
+SatSolverImpl::pop()
+{
+  if ( mScopeStack.empty() ) {
+    cout << "Error![SatSolverImpl]: pop() without push()" << endl;
+    return;
+  }
+  ymuint group = mScopeStack.back();
+  mScopeStack.pop_back();
+  SatSolverImpl::release_group(group);
+}
+
+// 節を追加する本体の関数
+void
+SatSolverImpl::add_clause_sub(const vector<Literal>& lits)
 {
   if ( decision_level() != 0 ) {
     // エラー
@@ -202,15 +406,32 @@ SatSolverImpl::add_clause(const vector<Literal>& lits)
     return;
   }
 
+  alloc_var();
+
+  if ( !mElimLits.empty() ) {
+    // 前処理で除去された変数が含まれていたら復活させる．
+    // reintroduce_var() は add_clause_sub() を呼ぶので
+    // mAcTmp を使う前に行う必要がある．
+    for (vector<Literal>::const_iterator p = lits.begin();
+	 p != lits.end(); ++ p) {
+      tVarId var = p->varid();
+      if ( var < mVarNum && is_eliminated(var) ) {
+	reintroduce_var(var);
+      }
+    }
+    if ( !mSane ) {
+      return;
+    }
+  }
+
   // operator<(Literal, Literal) を使ったソート
   mAcTmp = lits;
   sort(mAcTmp.begin(), mAcTmp.end());
-
-  alloc_var();
   
   // - 重複したリテラルの除去
   // - false literal の除去
   // - true literal を持つかどうかのチェック
+  // - 相補なリテラルを持つかどうかのチェック
   vector<Literal>::iterator wp = mAcTmp.begin();
   for (vector<Literal>::const_iterator rp = mAcTmp.begin();
        rp != mAcTmp.end(); ++ rp) {
@@ -219,6 +440,11 @@ SatSolverImpl::add_clause(const vector<Literal>& lits)
       // 重複している．
       continue;
     }
+    if ( wp != mAcTmp.begin() && *(wp - 1) == ~l ) {
+      // ソートされているので相補なリテラルは隣り合う．
+      // トートロジーなので追加しない．
+      return;
+    }
     Bool3 v = eval(l);
     if ( v == kB3False ) {
       // false literal は追加しない．
@@ -269,27 +495,30 @@ SatSolverImpl::add_clause(const vector<Literal>& lits)
   }
   
   Literal l1 = mAcTmp[1];
+  ++ mNewClauseNum;
   
   if ( n == 2 ) {
     // watcher-list の設定
-    add_watcher(~l0, SatReason(l1));
-    add_watcher(~l1, SatReason(l0));
+    add_watcher(~l0, SatReason(l1), l1);
+    add_watcher(~l1, SatReason(l0), l0);
     ++ mConstrBinNum;
   }
   else {
     // 節の生成
-    SatClause* clause = new_clause(mAcTmp);
-    mConstrClause.push_back(clause);
+    SatReason cref = new_clause(mAcTmp);
+    mConstrClause.push_back(cref);
 
     // watcher-list の設定
-    add_watcher(~l0, SatReason(clause));
-    add_watcher(~l1, SatReason(clause));
+    add_watcher(~l0, cref, l1);
+    add_watcher(~l1, cref, l0);
   }
 }
 
 // 学習節を追加する．
+// lbd は LBD を使わない設定の時には 0 でよい．
 void
-SatSolverImpl::add_learnt_clause(const vector<Literal>& lits)
+SatSolverImpl::add_learnt_clause(const vector<Literal>& lits,
+				 ymuint lbd)
 {
   ymuint n = lits.size();
   mLearntLitNum += n;
@@ -322,22 +551,22 @@ SatSolverImpl::add_learnt_clause(const vector<Literal>& lits)
   SatReason reason;
   Literal l1 = lits[1];
   if ( n == 2 ) {
-    reason = SatReason(l1);
+    reason = SatReason(l1, true);
 
     // watcher-list の設定
-    add_watcher(~l0, SatReason(l1));
-    add_watcher(~l1, SatReason(l0));
+    add_watcher(~l0, SatReason(l1, true), l1);
+    add_watcher(~l1, SatReason(l0, true), l0);
     ++ mLearntBinNum;
   }
   else {
     // 節の生成
-    SatClause* clause = new_clause(lits, true);
-    mLearntClause.push_back(clause);
-    reason = SatReason(clause);
+    reason = new_clause(lits, true);
+    clause(reason).set_lbd(lbd);
+    mLearntClause.push_back(reason);
     
     // watcher-list の設定
-    add_watcher(~l0, reason);
-    add_watcher(~l1, reason);
+    add_watcher(~l0, reason, l1);
+    add_watcher(~l1, reason, l0);
   }
   
   // learnt clause の場合には必ず unit clause になっているはず．
@@ -353,9 +582,10 @@ SatSolverImpl::add_learnt_clause(const vector<Literal>& lits)
 // Watcher を追加する．
 void
 SatSolverImpl::add_watcher(Literal watch_lit,
-			   SatReason reason)
+			   SatReason reason,
+			   Literal blocker)
 {
-  watcher_list(watch_lit).add(Watcher(reason));
+  watcher_list(watch_lit).add(Watcher(reason, blocker));
 }
 
 
@@ -381,9 +611,9 @@ SatSolverImpl::solve(const vector<Literal>& assumptions,
     }
     cout << endl;
     cout << " Clauses:" << endl;
-    for (vector<SatClause*>::const_iterator p = mConstrClause.begin();
+    for (vector<SatReason>::const_iterator p = mConstrClause.begin();
 	 p != mConstrClause.end(); ++ p) {
-      cout << "  " << *(*p) << endl;
+      cout << "  " << clause(*p) << endl;
     }
   }
 
@@ -394,12 +624,47 @@ SatSolverImpl::solve(const vector<Literal>& assumptions,
   }
   
   alloc_var();
+
+  if ( !mShareUnitList.empty() ) {
+    // 前回取り込んだ単位節をレベル0で割り当てる．
+    for (vector<Literal>::iterator p = mShareUnitList.begin();
+	 p != mShareUnitList.end(); ++ p) {
+      if ( !check_and_assign(*p) ) {
+	mSane = false;
+	break;
+      }
+    }
+    mShareUnitList.clear();
+  }
   
   simplifyDB();
   if ( !mSane ) {
     return kB3False;
   }
 
+  // 生きている節グループの活性化リテラルを assumption の先頭に加える．
+  vector<Literal> group_assumptions;
+  if ( mLiveGroupNum > 0 ) {
+    group_assumptions.reserve(mLiveGroupNum + assumptions.size());
+    for (vector<Literal>::const_iterator p = mGroupLit.begin();
+	 p != mGroupLit.end(); ++ p) {
+      if ( *p != kLiteralX ) {
+	group_assumptions.push_back(*p);
+      }
+    }
+    group_assumptions.insert(group_assumptions.end(),
+			     assumptions.begin(), assumptions.end());
+  }
+  const vector<Literal>& assumptions1 =
+    (mLiveGroupNum > 0) ? group_assumptions : assumptions;
+
+  if ( mParams.mPreprocess ) {
+    preprocess(assumptions1);
+    if ( !mSane ) {
+      return kB3False;
+    }
+  }
+
   double confl_limit = 100;
   double learnt_limit = mConstrClause.size() / 3;
   mVarDecay = mParams.mVarDecay;
@@ -408,8 +673,8 @@ SatSolverImpl::solve(const vector<Literal>& assumptions,
   assert_cond(decision_level() == 0, __FILE__, __LINE__);
 
   // assumption の割り当てを行う．
-  for (vector<Literal>::const_iterator p = assumptions.begin();
-       p != assumptions.end(); ++ p) {
+  for (vector<Literal>::const_iterator p = assumptions1.begin();
+       p != assumptions1.end(); ++ p) {
     Literal lit = *p;
 
     mAssignList.set_marker();
@@ -440,11 +705,51 @@ SatSolverImpl::solve(const vector<Literal>& assumptions,
     cout << "RootLevel = " << mRootLevel << endl;
   }
 
+  if ( mParams.mLbdReduce && mReduceInterval == 0 ) {
+    mReduceInterval = 2000;
+    mNextReduce = mConflictNum + mReduceInterval;
+  }
+
+  // この solve() を始めた時のコンフリクト数
+  ymuint64 conflict_base = mConflictNum;
+
+  mNextShare = mConflictNum + kShareInterval;
+  mShareStop = false;
+
+  // luby と glucose の場合の solve() 全体でのコンフリクト数の上限
+  // geometric の場合と同じになるように confl_limit の列の総和とする．
+  ymuint64 total_limit = 0;
+  if ( mParams.mRestart != kSatRestartGeometric ) {
+    for (double l = confl_limit; ; l *= 1.5) {
+      ymuint64 l1 = static_cast<ymuint64>(l);
+      if ( l1 >= mMaxConflict ) {
+	total_limit += mMaxConflict;
+	break;
+      }
+      total_limit += l1;
+    }
+  }
+
   Bool3 stat = kB3X;
-  for ( ; ; ) {
-    mConflictLimit = static_cast<ymuint64>(confl_limit);
-    if ( mConflictLimit > mMaxConflict ) {
-      mConflictLimit = mMaxConflict;
+  for (ymuint restart = 0; ; ++ restart) {
+    if ( mParams.mRestart == kSatRestartGeometric ) {
+      mConflictLimit = static_cast<ymuint64>(confl_limit);
+      if ( mConflictLimit > mMaxConflict ) {
+	mConflictLimit = mMaxConflict;
+      }
+    }
+    else {
+      ymuint64 n_confl = mConflictNum - conflict_base;
+      if ( n_confl >= total_limit ) {
+	break;
+      }
+      mConflictLimit = total_limit - n_confl;
+      if ( mParams.mRestart == kSatRestartLuby ) {
+	ymuint64 limit = static_cast<ymuint64>(luby(2.0, restart) * 100);
+	if ( mConflictLimit > limit ) {
+	  mConflictLimit = limit;
+	}
+      }
     }
     mLearntLimit = static_cast<ymuint64>(learnt_limit);
     SatStats stats;
@@ -456,10 +761,11 @@ SatSolverImpl::solve(const vector<Literal>& assumptions,
     }
     ++ mRestart;
     stat = search();
-    if ( stat != kB3X ) {
+    if ( stat != kB3X || mShareStop ) {
       break;
     }
-    if ( mConflictLimit == mMaxConflict ) {
+    if ( mParams.mRestart == kSatRestartGeometric &&
+	 mConflictLimit == mMaxConflict ) {
       break;
     }
     decay_var_activity2();
@@ -471,9 +777,13 @@ SatSolverImpl::solve(const vector<Literal>& assumptions,
     model.resize(mVarNum);
     for (ymuint i = 0; i < mVarNum; ++ i) {
       Bool3 val = eval(i);
-      assert_cond(val != kB3X, __FILE__, __LINE__);
+      // 前処理で除去された変数は値を持たない．
+      assert_cond(val != kB3X || is_eliminated(i), __FILE__, __LINE__);
       model[i] = val;
     }
+    if ( mElimVarNum > 0 ) {
+      extend_model(model);
+    }
   }
   backtrack(0);
 
@@ -521,6 +831,11 @@ SatSolverImpl::get_stats(SatStats& stats) const
   stats.mConflictLimit = mConflictLimit;
   stats.mLearntLimit = mLearntLimit;
   stats.mTime = mTimer.time();
+  stats.mElimVarNum = mElimVarNum;
+  stats.mSubsumedNum = mSubsumedNum;
+  stats.mStrengthenedNum = mStrengthenedNum;
+  stats.mProbedUnitNum = mProbedUnitNum;
+  stats.mSimpTime = mSimpTimer.time();
 }
 
 // @brief solve() 中のリスタートのたびに呼び出されるメッセージハンドラの登録
@@ -548,12 +863,29 @@ SatSolverImpl::search()
 	// トップレベルで矛盾が起きたら充足不可能
 	return kB3False;
       }
+      if ( mShare != NULL && !mShare->deterministic() && mShare->done() ) {
+	// 他のソルバが答えを出した．
+	mShareStop = true;
+	backtrack(mRootLevel);
+	return kB3X;
+      }
       if ( n_confl > mConflictLimit ) {
 	// 矛盾の回数が制限値を越えた．
 	backtrack(mRootLevel);
 	return kB3X;
       }
 
+      if ( mParams.mRestart == kSatRestartGlucose ) {
+	// 割り当て数が最近の平均よりもかなり多い時は充足解に
+	// 近づいている可能性があるのでリスタートを抑制する．
+	ymuint n_assign = mAssignList.size();
+	mTrailQueue.push(n_assign);
+	if ( mConflictNum > 10000 && mLbdQueue.full() &&
+	     n_assign > kGlucoseR * mTrailQueue.avg() ) {
+	  mLbdQueue.clear();
+	}
+      }
+
       // 今の矛盾の解消に必要な条件を「学習」する．
       vector<Literal> learnt;
       int bt_level = mAnalyzer->analyze(conflict, learnt);
@@ -571,6 +903,13 @@ SatSolverImpl::search()
 	cout << endl;
       }
 
+      // LBD はバックトラックする前に計算しておく．
+      ymuint lbd = 0;
+      if ( mParams.mLbdReduce || mParams.mRestart == kSatRestartGlucose ||
+	   mShare != NULL ) {
+	lbd = calc_lbd(learnt);
+      }
+
       // バックトラック
       if ( bt_level < mRootLevel ) {
 	bt_level = mRootLevel;
@@ -578,16 +917,53 @@ SatSolverImpl::search()
       backtrack(bt_level);
 
       // 学習節の生成
-      add_learnt_clause(learnt);
+      add_learnt_clause(learnt, lbd);
+
+      // 短い学習節は他のソルバにも渡す．
+      if ( mShare != NULL &&
+	   (learnt.size() <= kShareSize || lbd <= kShareLbd) ) {
+	mShare->put(mShareId, learnt, lbd);
+      }
+
+      if ( mParams.mRestart == kSatRestartGlucose ) {
+	mLbdQueue.push(lbd);
+	mLbdSum += lbd;
+	++ mLbdNum;
+      }
 
       decay_var_activity();
       decay_clause_activity();
     }
     else {
+      if ( mShare != NULL && mConflictNum >= mNextShare ) {
+	// 基底レベルに戻って他のソルバの学習節を取り込む．
+	mNextShare = mConflictNum + kShareInterval;
+	backtrack(mRootLevel);
+	if ( !mShare->sync(mShareId) ) {
+	  mShareStop = true;
+	  return kB3X;
+	}
+	bool stat = import_clauses();
+	mShare->end_sync(mShareId);
+	if ( !stat ) {
+	  return kB3False;
+	}
+	continue;
+      }
+      if ( mParams.mRestart == kSatRestartGlucose &&
+	   check_glucose_restart() ) {
+	backtrack(mRootLevel);
+	return kB3X;
+      }
       if ( decision_level() == 0 ) {
 	simplifyDB();
       }
-      if ( mLearntClause.size() > mLearntLimit ) {
+      if ( mParams.mLbdReduce ) {
+	if ( mConflictNum >= mNextReduce ) {
+	  reduceDB_lbd();
+	}
+      }
+      else if ( mLearntClause.size() > mLearntLimit ) {
 	reduceDB();
       }
 
@@ -637,17 +1013,24 @@ SatSolverImpl::implication()
       wlist.set_elem(wpos, w);
       ++ rpos;
       ++ wpos;
-      if ( w.is_literal() ) {
-	Literal l0 = w.literal();
-	Bool3 val0 = eval(l0);
-	if ( val0 == kB3X ) {
+      // blocker が真ならば節は充足しているので中身を見る必要はない．
+      Literal bl = w.blocker();
+      Bool3 valb = eval(bl);
+      if ( valb == kB3True ) {
+	continue;
+      }
+      SatReason r = w.reason();
+      if ( r.is_literal() ) {
+	// 2リテラル節の場合は blocker が残りのリテラルになっている．
+	Literal l0 = bl;
+	if ( valb == kB3X ) {
 	  if ( debug & debug_assign ) {
 	    cout << "\tassign " << l0 << " @" << decision_level()
 		 << " from " << l << endl;
 	  }
 	  assign(l0, SatReason(nl));
 	}
-	else if ( val0 == kB3False ) {
+	else {
 	  // 矛盾がおこった．
 	  if ( debug & debug_assign ) {
 	    cout << "\t--> conflict with previous assignment" << endl
@@ -656,14 +1039,15 @@ SatSolverImpl::implication()
 	  }
 	  // ループを抜けるためにキューの末尾まで先頭を動かす．
 	  mAssignList.skip_all();
-	  mTmpBinClause->mLits[0] = l0;
-	  mTmpBinClause->mLits[1] = nl;
-	  conflict = SatReason(mTmpBinClause);
+	  SatClause& tmp = clause(mTmpBinClause);
+	  tmp.lit0() = l0;
+	  tmp.lit1() = nl;
+	  conflict = mTmpBinClause;
 	  break;
 	}
       }
       else {
-	SatClause& c = w.clause();
+	SatClause& c = clause(r);
 	Literal l0 = c.lit0();
 	if ( l0 == nl ) {
 	  // nl を 2番めのリテラルにする．
@@ -681,61 +1065,65 @@ SatSolverImpl::implication()
 	}
 
 	Bool3 val0 = eval(l0);
-	if ( val0 != kB3True ) {
-	  if ( debug & debug_implication ) {
-	    cout << "\t\texamining watcher clause " << c << endl;
-	  }
+	if ( val0 == kB3True ) {
+	  // l0 を次からの blocker にする．
+	  wlist.set_elem(wpos - 1, Watcher(r, l0));
+	  continue;
+	}
 
-	  // nl の替わりのリテラルを見つける．
-	  // この時，替わりのリテラルが未定かすでに充足しているかどうか
-	  // は問題でない．
-	  bool found = false;
-	  int n = c.size();
-	  for (int i = 2; i < n; ++ i) {
-	    Literal l2 = c.lit(i);
-	    if ( eval(l2) != kB3False ) {
-	      c.lit(i) = nl;
-	      c.lit1() = l2;
-	      if ( debug & debug_implication ) {
-		cout << "\t\t\tsecond watching literal becomes "
-		     << l2 << endl;
-	      }
-	      // l の watcher list からは取り除く
-	      -- wpos;
-	      // ~tmp の watcher list に追加する．
-	      watcher_list(~l2).add(w);
-	      found = true;
-	      break;
+	if ( debug & debug_implication ) {
+	  cout << "\t\texamining watcher clause " << c << endl;
+	}
+
+	// nl の替わりのリテラルを見つける．
+	// この時，替わりのリテラルが未定かすでに充足しているかどうか
+	// は問題でない．
+	bool found = false;
+	int n = c.size();
+	for (int i = 2; i < n; ++ i) {
+	  Literal l2 = c.lit(i);
+	  if ( eval(l2) != kB3False ) {
+	    c.lit(i) = nl;
+	    c.lit1() = l2;
+	    if ( debug & debug_implication ) {
+	      cout << "\t\t\tsecond watching literal becomes "
+		   << l2 << endl;
 	    }
+	    // l の watcher list からは取り除く
+	    -- wpos;
+	    // ~tmp の watcher list に追加する．
+	    watcher_list(~l2).add(Watcher(r, l0));
+	    found = true;
+	    break;
 	  }
-	  if ( found ) {
-	    continue;
-	  }
+	}
+	if ( found ) {
+	  continue;
+	}
 
-	  if ( debug & debug_implication ) {
-	    cout << "\t\tno other watching literals" << endl;
-	  }
+	if ( debug & debug_implication ) {
+	  cout << "\t\tno other watching literals" << endl;
+	}
 	
-	  // 見付からなかったので l0 に従った割り当てを行う．
-	  if ( val0 == kB3X ) {
-	    if ( debug & debug_assign ) {
-	      cout << "\tassign " << l0 << " @" << decision_level()
-		   << " from " << w << endl;
-	    }
-	    assign(l0, w);
+	// 見付からなかったので l0 に従った割り当てを行う．
+	if ( val0 == kB3X ) {
+	  if ( debug & debug_assign ) {
+	    cout << "\tassign " << l0 << " @" << decision_level()
+		 << " from " << c << endl;
 	  }
-	  else {
-	    // 矛盾がおこった．
-	    if ( debug & debug_assign ) {
-	      cout << "\t--> conflict with previous assignment" << endl
-		   << "\t    " << ~l0 << " was assigned at level "
-		   << decision_level(l0.varid()) << endl;
-	    }
-	    // ループを抜けるためにキューの末尾まで先頭を動かす．
-	    mAssignList.skip_all();
-	    conflict = w;
-	    break;
+	  assign(l0, r);
+	}
+	else {
+	  // 矛盾がおこった．
+	  if ( debug & debug_assign ) {
+	    cout << "\t--> conflict with previous assignment" << endl
+		 << "\t    " << ~l0 << " was assigned at level "
+		 << decision_level(l0.varid()) << endl;
 	  }
+	  // ループを抜けるためにキューの末尾まで先頭を動かす．
+	  mAssignList.skip_all();
+	  conflict = r;
+	  break;
 	}
       }
     }
@@ -766,6 +1154,9 @@ SatSolverImpl::backtrack(int level)
       Literal p = mAssignList.get_prev();
       tVarId varid = p.varid();
       mVal[varid] = kB3X;
+      if ( mParams.mPhaseCache ) {
+	mPhase[varid] = p.pol();
+      }
       heap_push(varid);
       if ( debug & debug_assign ) {
 	cout << "\tdeassign " << p << endl;
@@ -793,15 +1184,28 @@ SatSolverImpl::next_decision()
 #endif
   while ( !heap_empty() ) {
     tVarId var = heap_pop_top();
-    if ( eval(var) == kB3X ) {
+    if ( eval(var) == kB3X && !is_eliminated(var) ) {
       //tPol pol = (mRandGen.int32() & 1) ? kPolPosi : kPolNega;
-      tPol pol = kPolNega;
+      tPol pol = mParams.mPhaseCache ? mPhase[var] : kPolNega;
       return Literal(var, pol);
     }
   }
   return kLiteralX;
 }
 
+// glucose 方式のリスタートを行うべきか調べる．
+// 最近の学習節の LBD の平均が全体の平均よりも悪い時にリスタートする．
+bool
+SatSolverImpl::check_glucose_restart()
+{
+  if ( mLbdQueue.full() &&
+       mLbdQueue.avg() * kGlucoseK > mLbdSum / mLbdNum ) {
+    mLbdQueue.clear();
+    return true;
+  }
+  return false;
+}
+
 // CNF を簡単化する．
 void
 SatSolverImpl::simplifyDB()
@@ -816,6 +1220,157 @@ SatSolverImpl::simplifyDB()
     return;
   }
 
+  if ( mAssignList.size() == mSimpAssignNum && mReleasedVarList.empty() ) {
+    // 前回から何も変わっていない．
+    return;
+  }
+  if ( mPropagationNum < mSimpPropLimit ) {
+    // 前回からあまり時間が経っていない．
+    return;
+  }
+
+  // レベル0の割り当て理由は矛盾の解析に使われないのでクリアしておく．
+  // こうしておけば割り当て理由になっている節も削除できる．
+  ymuint n = mAssignList.size();
+  for (ymuint i = 0; i < n; ++ i) {
+    mReason[mAssignList.get(i).varid()] = kNullSatReason;
+  }
+
+  remove_satisfied(mLearntClause);
+  remove_satisfied(mConstrClause);
+  if ( !mReleasedVarList.empty() ) {
+    remove_released_bin();
+    recycle_released_var();
+  }
+
+  mSimpAssignNum = mAssignList.size();
+  mSimpPropLimit = mPropagationNum + mConstrLitNum + mLearntLitNum;
+
+  if ( mArena.wasted() * 2 > mArena.size() ) {
+    garbage_collect();
+  }
+}
+
+// レベル0で充足している節を削除する．
+void
+SatSolverImpl::remove_satisfied(vector<SatReason>& clause_list)
+{
+  vector<SatReason>::iterator wpos = clause_list.begin();
+  for (vector<SatReason>::iterator rpos = clause_list.begin();
+       rpos != clause_list.end(); ++ rpos) {
+    SatReason cref = *rpos;
+    if ( is_satisfied(clause(cref)) ) {
+      delete_clause(cref);
+    }
+    else {
+      *wpos = cref;
+      ++ wpos;
+    }
+  }
+  clause_list.erase(wpos, clause_list.end());
+}
+
+// 解放された節グループの二項節を削除する．
+// 二項節は watcher list にしか現れないので全ての watcher list を走査する．
+void
+SatSolverImpl::remove_released_bin()
+{
+  mReleasedMark.clear();
+  mReleasedMark.resize(mVarNum, false);
+  for (vector<tVarId>::iterator p = mReleasedVarList.begin();
+       p != mReleasedVarList.end(); ++ p) {
+    mReleasedMark[*p] = true;
+  }
+
+  ymuint n2 = mOldVarNum * 2;
+  for (ymuint i = 0; i < n2; ++ i) {
+    Literal watch_lit = Literal::index2literal(i);
+    bool watch_released = mReleasedMark[watch_lit.varid()];
+    WatcherList& wlist = mWatcherList[i];
+    ymuint n = wlist.num();
+    ymuint wpos = 0;
+    for (ymuint rpos = 0; rpos < n; ++ rpos) {
+      Watcher w = wlist.elem(rpos);
+      SatReason r = w.reason();
+      if ( r.is_literal() &&
+	   ( watch_released || mReleasedMark[r.literal().varid()] ) ) {
+	// 一つの二項節は二つの watcher list に現れるので
+	// 片方でだけ数える．
+	if ( ~watch_lit < r.literal() ) {
+	  if ( r.is_learnt_bin() ) {
+	    -- mLearntBinNum;
+	    mLearntLitNum -= 2;
+	  }
+	  else {
+	    -- mConstrBinNum;
+	    mConstrLitNum -= 2;
+	  }
+	}
+	continue;
+      }
+      wlist.set_elem(wpos, w);
+      ++ wpos;
+    }
+    wlist.erase(wpos);
+  }
+}
+
+// 解放された活性化変数を再利用できるようにする．
+// この時点で活性化変数を含む節は全て削除されているので，
+// レベル0の割り当てを取り消せば新しい変数と同じになる．
+// ただし，前処理で除去された変数の節に現れる活性化変数は
+// 変数の復活の時に必要なので再利用しない．
+void
+SatSolverImpl::recycle_released_var()
+{
+  if ( !mElimLits.empty() ) {
+    vector<tVarId>::iterator wpos = mReleasedVarList.begin();
+    for (vector<tVarId>::iterator rpos = mReleasedVarList.begin();
+	 rpos != mReleasedVarList.end(); ++ rpos) {
+      tVarId var = *rpos;
+      if ( mElimLitsMark[var] ) {
+	mReleasedMark[var] = false;
+      }
+      else {
+	*wpos = var;
+	++ wpos;
+      }
+    }
+    mReleasedVarList.erase(wpos, mReleasedVarList.end());
+  }
+
+  ymuint n = mAssignList.size();
+  ymuint wpos = 0;
+  for (ymuint rpos = 0; rpos < n; ++ rpos) {
+    Literal l = mAssignList.get(rpos);
+    tVarId var = l.varid();
+    if ( mReleasedMark[var] ) {
+      mVal[var] = kB3X;
+      mPhase[var] = kPolNega;
+      heap_push(var);
+      continue;
+    }
+    mAssignList.set(wpos, l);
+    ++ wpos;
+  }
+  mAssignList.shrink(wpos);
+
+  mFreeVarList.insert(mFreeVarList.end(),
+		      mReleasedVarList.begin(), mReleasedVarList.end());
+  mReleasedVarList.clear();
+}
+
+// 節がレベル0で充足していたら true を返す．
+bool
+SatSolverImpl::is_satisfied(const SatClause& clause) const
+{
+  ymuint n = clause.size();
+  for (ymuint i = 0; i < n; ++ i) {
+    if ( eval(clause.lit(i)) == kB3True ) {
+      return true;
+    }
+  }
+  return false;
 }
 
 BEGIN_NONAMESPACE
@@ -823,12 +1378,27 @@ BEGIN_NONAMESPACE
 class SatClauseLess
 {
 public:
+
+  // コンストラクタ
+  SatClauseLess(const ClauseArena& arena) :
+    mArena(arena)
+  {
+  }
+
   bool
-  operator()(SatClause* a,
-	     SatClause* b)
+  operator()(SatReason a_ref,
+	     SatReason b_ref)
   {
-    return a->size() > 2 && (b->size() == 2 || a->activity() < b->activity() );
+    SatClause& a = mArena.clause(a_ref.clause_ref());
+    SatClause& b = mArena.clause(b_ref.clause_ref());
+    return a.size() > 2 && (b.size() == 2 || a.activity() < b.activity() );
   }
+
+private:
+
+  // 節を取り出すための ClauseArena
+  const ClauseArena& mArena;
+
 };
 END_NONAMESPACE
 
@@ -842,72 +1412,242 @@ SatSolverImpl::reduceDB()
   // 足切りのための制限値
   double abs_limit = mClauseBump / n;
 
-  sort(mLearntClause.begin(), mLearntClause.end(), SatClauseLess());
+  sort(mLearntClause.begin(), mLearntClause.end(), SatClauseLess(mArena));
 
-  vector<SatClause*>::iterator wpos = mLearntClause.begin();
+  vector<SatReason>::iterator wpos = mLearntClause.begin();
   for (ymuint i = 0; i < n2; ++ i) {
-    SatClause* clause = mLearntClause[i];
-    if ( clause->size() > 2 && !is_locked(clause) ) {
-      delete_clause(clause);
+    SatReason cref = mLearntClause[i];
+    if ( clause(cref).size() > 2 && !is_locked(cref) ) {
+      delete_clause(cref);
     }
     else {
-      *wpos = clause;
+      *wpos = cref;
       ++ wpos;
     }
   }
   for (ymuint i = n2; i < n; ++ i) {
-    SatClause* clause = mLearntClause[i];
-    if ( clause->size() > 2 && !is_locked(clause) &&
-	 clause->activity() < abs_limit ) {
-      delete_clause(clause);
+    SatReason cref = mLearntClause[i];
+    SatClause& c = clause(cref);
+    if ( c.size() > 2 && !is_locked(cref) &&
+	 c.activity() < abs_limit ) {
+      delete_clause(cref);
     }
     else {
-      *wpos = clause;
+      *wpos = cref;
       ++ wpos;
     }
   }
   if ( wpos != mLearntClause.end() ) {
     mLearntClause.erase(wpos, mLearntClause.end());
   }
+
+  // 削除された節の領域が半分を超えたら回収する．
+  if ( mArena.wasted() * 2 > mArena.size() ) {
+    garbage_collect();
+  }
+}
+
+BEGIN_NONAMESPACE
+// reduceDB_lbd で用いる SatClause の比較関数
+// LBD の大きいもの，LBD が同じならアクティビティの低いものを前に置く．
+class SatClauseLbdLess
+{
+public:
+
+  // コンストラクタ
+  SatClauseLbdLess(const ClauseArena& arena) :
+    mArena(arena)
+  {
+  }
+
+  bool
+  operator()(SatReason a_ref,
+	     SatReason b_ref)
+  {
+    SatClause& a = mArena.clause(a_ref.clause_ref());
+    SatClause& b = mArena.clause(b_ref.clause_ref());
+    if ( a.lbd() != b.lbd() ) {
+      return a.lbd() > b.lbd();
+    }
+    return a.activity() < b.activity();
+  }
+
+private:
+
+  // 節を取り出すための ClauseArena
+  const ClauseArena& mArena;
+
+};
+END_NONAMESPACE
+
+// LBD に基づいて使われていない学習節を削除する．
+// 学習節を以下の3つの階層に分けて管理する．
+// - LBD が kCoreLbd 以下の節は削除しない．
+// - LBD が kTier2Lbd 以下の節は前回から使われていれば残す．
+// - それ以外の節は LBD の悪いものから半分を削除する．
+void
+SatSolverImpl::reduceDB_lbd()
+{
+  mReduceInterval += 300;
+  mNextReduce = mConflictNum + mReduceInterval;
+
+  vector<SatReason> local_list;
+  local_list.reserve(mLearntClause.size());
+  vector<SatReason>::iterator wpos = mLearntClause.begin();
+  for (vector<SatReason>::iterator p = mLearntClause.begin();
+       p != mLearntClause.end(); ++ p) {
+    SatReason cref = *p;
+    SatClause& c = clause(cref);
+    ymuint lbd = c.lbd();
+    bool keep = (lbd <= kCoreLbd) || (lbd <= kTier2Lbd && c.is_used());
+    c.set_used(false);
+    if ( keep ) {
+      *wpos = cref;
+      ++ wpos;
+    }
+    else {
+      local_list.push_back(cref);
+    }
+  }
+  mLearntClause.erase(wpos, mLearntClause.end());
+
+  sort(local_list.begin(), local_list.end(), SatClauseLbdLess(mArena));
+
+  ymuint n = local_list.size();
+  ymuint n2 = n / 2;
+  for (ymuint i = 0; i < n; ++ i) {
+    SatReason cref = local_list[i];
+    if ( i < n2 && !is_locked(cref) ) {
+      delete_clause(cref);
+    }
+    else {
+      mLearntClause.push_back(cref);
+    }
+  }
+
+  // 削除された節の領域が半分を超えたら回収する．
+  if ( mArena.wasted() * 2 > mArena.size() ) {
+    garbage_collect();
+  }
+}
+
+// リテラルのリストの LBD を計算する．
+// LBD はリテラルの decision level の種類の数
+ymuint
+SatSolverImpl::calc_lbd(const vector<Literal>& lits)
+{
+  ++ mLbdStampVal;
+  ymuint lbd = 0;
+  for (vector<Literal>::const_iterator p = lits.begin();
+       p != lits.end(); ++ p) {
+    int level = decision_level(p->varid());
+    if ( mLbdStamp[level] != mLbdStampVal ) {
+      mLbdStamp[level] = mLbdStampVal;
+      ++ lbd;
+    }
+  }
+  return lbd;
+}
+
+// 節の LBD を計算する．
+ymuint
+SatSolverImpl::calc_lbd(const SatClause& clause)
+{
+  ++ mLbdStampVal;
+  ymuint lbd = 0;
+  ymuint n = clause.size();
+  for (ymuint i = 0; i < n; ++ i) {
+    int level = decision_level(clause.lit(i).varid());
+    if ( mLbdStamp[level] != mLbdStampVal ) {
+      mLbdStamp[level] = mLbdStampVal;
+      ++ lbd;
+    }
+  }
+  return lbd;
 }
 
 // 新しい節を生成する．
-SatClause*
+SatReason
 SatSolverImpl::new_clause(const vector<Literal>& lits,
 			  bool learnt)
 {
-  ymuint n = lits.size();
-  ymuint size = sizeof(SatClause) + sizeof(Literal) * (n - 1);
-  void* tmp = mAlloc.get_memory(size);
-  return new (tmp) SatClause(lits, learnt);
+  return SatReason(mArena.new_clause(lits, learnt));
 }
 
 // 節を捨てる．
 void
-SatSolverImpl::delete_clause(SatClause* clause)
+SatSolverImpl::delete_clause(SatReason cref)
 {
+  SatClause& c = clause(cref);
   // 0 番目と 1 番目のリテラルに関係する watch list を更新
   for (ymuint i = 0; i < 2; ++ i) {
-    Literal l = ~clause->lit(i);
+    Literal l = ~c.lit(i);
     WatcherList& wlist = watcher_list(l);
     ymuint n = wlist.num();
     ymuint rpos = 0;
     ymuint wpos = 0;
     for ( ; rpos < n; ++ rpos) {
       Watcher w = wlist.elem(rpos);
-      if ( w != SatReason(clause) ) {
+      if ( w.reason() != cref ) {
 	wlist.set_elem(wpos, w);
 	++ wpos;
       }
     }
     wlist.erase(wpos);
   }
-  if ( clause->is_learnt() ) {
-    mLearntLitNum -= clause->size();
+  if ( c.is_learnt() ) {
+    mLearntLitNum -= c.size();
   }
   else {
-    mConstrLitNum -= clause->size();
+    mConstrLitNum -= c.size();
+  }
+  mArena.delete_clause(cref.clause_ref());
+}
+
+// 削除された節の領域を回収する．
+// 生きている節を新しい ClauseArena に詰め直して，
+// 節を参照しているところを全て書き換える．
+void
+SatSolverImpl::garbage_collect()
+{
+  ClauseArena to;
+
+  // 節のリストの順に移すことで生成順の並びを保つ．
+  mTmpBinClause = SatReason(mArena.reloc(mTmpBinClause.clause_ref(), to));
+  for (vector<SatReason>::iterator p = mConstrClause.begin();
+       p != mConstrClause.end(); ++ p) {
+    *p = SatReason(mArena.reloc(p->clause_ref(), to));
   }
+  for (vector<SatReason>::iterator p = mLearntClause.begin();
+       p != mLearntClause.end(); ++ p) {
+    *p = SatReason(mArena.reloc(p->clause_ref(), to));
+  }
+
+  // watcher list
+  ymuint n2 = mOldVarNum * 2;
+  for (ymuint i = 0; i < n2; ++ i) {
+    WatcherList& wlist = mWatcherList[i];
+    ymuint n = wlist.num();
+    for (ymuint pos = 0; pos < n; ++ pos) {
+      Watcher w = wlist.elem(pos);
+      SatReason r = w.reason();
+      if ( r.is_clause() ) {
+	SatReason r1(mArena.reloc(r.clause_ref(), to));
+	wlist.set_elem(pos, Watcher(r1, w.blocker()));
+      }
+    }
+  }
+
+  // 割り当て理由
+  // 割り当てられていない変数の mReason は使われないので無視する．
+  for (ymuint i = 0; i < mOldVarNum; ++ i) {
+    SatReason r = mReason[i];
+    if ( mVal[i] != kB3X && r.is_clause() && r != kNullSatReason ) {
+      mReason[i] = SatReason(mArena.reloc(r.clause_ref(), to));
+    }
+  }
+
+  mArena.move(to);
 }
 
 // 変数のアクティビティを増加させる．
@@ -948,15 +1688,24 @@ SatSolverImpl::decay_var_activity2()
 }
 
 // 学習節のアクティビティを増加させる．
+// LBD を使う時には LBD も更新する．
 void
 SatSolverImpl::bump_clause_activity(SatClause* clause)
 {
+  clause->set_used(true);
+  if ( mParams.mLbdReduce && clause->lbd() > kCoreLbd ) {
+    ymuint lbd = calc_lbd(*clause);
+    if ( lbd < clause->lbd() ) {
+      clause->set_lbd(lbd);
+    }
+  }
+
   clause->mActivity += mClauseBump;
   if ( clause->mActivity > 1e+100 ) {
-    for (vector<SatClause*>::iterator p = mLearntClause.begin();
+    for (vector<SatReason>::iterator p = mLearntClause.begin();
 	 p != mLearntClause.end(); ++ p) {
-      SatClause* clause1 = *p;
-      clause1->mActivity *= 1e-100;
+      SatClause& clause1 = this->clause(*p);
+      clause1.mActivity *= 1e-100;
     }
     mClauseBump *= 1e-100;
   }
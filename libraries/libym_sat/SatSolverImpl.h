@@ -12,18 +12,35 @@
 
 
 #include "ym_sat/SatSolver.h"
-#include "ym_utils/Alloc.h"
 #include "ym_utils/RandGen.h"
 #include "ym_utils/StopWatch.h"
 #include "SatClause.h"
 #include "SatReason.h"
+#include "ClauseArena.h"
 #include "AssignList.h"
 #include "Watcher.h"
+#include "BoundedQueue.h"
+#include "SatPreprocessor.h"
 
 
 BEGIN_NAMESPACE_YM_SAT
 
 class SatAnalyzer;
+class SatClauseShare;
+
+//////////////////////////////////////////////////////////////////////
+/// @brief リスタートの方式を表す列挙型
+//////////////////////////////////////////////////////////////////////
+enum tSatRestart {
+  /// @brief コンフリクト数の制限を 1.5 倍ずつ増やしてゆく．
+  kSatRestartGeometric,
+  /// @brief コンフリクト数の制限を Luby 数列に従って決める．
+  kSatRestartLuby,
+  /// @brief 最近の学習節の LBD の平均が全体の平均より悪くなったら
+  /// リスタートする．(glucose 方式)
+  kSatRestartGlucose
+};
+
 
 //////////////////////////////////////////////////////////////////////
 /// @class Params SatSolverImpl.h "SatSolverImpl.h"
@@ -39,27 +56,57 @@ struct Params
 
   /// @brief 学習節の decay 値
   double mClauseDecay;
+
+  /// @brief リスタートの方式
+  tSatRestart mRestart;
+
+  /// @brief 学習節を LBD に基づいて階層的に管理する時 true にする．
+  bool mLbdReduce;
+
+  /// @brief 変数の最後の値を覚えておいて次の割り当てに用いる時
+  /// true にする．
+  bool mPhaseCache;
+
+  /// @brief solve() の前に SatPreprocessor による前処理を行う時
+  /// true にする．
+  bool mPreprocess;
   
   /// @brief コンストラクタ
   Params() :
     mVarDecay(1.0),
     mVarFreq(0.0),
-    mClauseDecay(1.0)
+    mClauseDecay(1.0),
+    mRestart(kSatRestartGeometric),
+    mLbdReduce(false),
+    mPhaseCache(false),
+    mPreprocess(false)
   {
   }
 
   /// @brief 値を指定したコンストラクタ
   Params(double var_decay,
 	 double var_freq,
-	 double clause_decay) :
+	 double clause_decay,
+	 tSatRestart restart = kSatRestartGeometric,
+	 bool lbd_reduce = false,
+	 bool phase_cache = false,
+	 bool preprocess = false) :
     mVarDecay(var_decay),
     mVarFreq(var_freq),
-    mClauseDecay(clause_decay)
+    mClauseDecay(clause_decay),
+    mRestart(restart),
+    mLbdReduce(lbd_reduce),
+    mPhaseCache(phase_cache),
+    mPreprocess(preprocess)
   {
   }
   
 };
 
+/// @brief SatSolverImpl のデフォルトのパラメータ
+extern
+const Params kDefaultParams;
+
 
 //////////////////////////////////////////////////////////////////////
 /// @class SatSolverImpl SatSolverImpl.h "SatSolverImpl.h"
@@ -74,7 +121,9 @@ public:
 
   /// @brief コンストラクタ
   /// @param[in] analyzer 解析器のポインタ
-  SatSolverImpl(SatAnalyzer* analyzer);
+  /// @param[in] params 制御用パラメータ
+  SatSolverImpl(SatAnalyzer* analyzer,
+		const Params& params = kDefaultParams);
 
   /// @brief デストラクタ
   virtual
@@ -104,6 +153,49 @@ public:
   void
   add_clause(const vector<Literal>& lits);
 
+  /// @brief 節グループを作る．
+  /// @return グループ番号を返す．
+  virtual
+  ymuint
+  new_group();
+
+  /// @brief 節グループに節を追加する．
+  /// @param[in] group グループ番号
+  /// @param[in] lits リテラルのベクタ
+  virtual
+  void
+  add_group_clause(ymuint group,
+		   const vector<Literal>& lits);
+
+  /// @brief 節グループを解放する．
+  /// @param[in] group グループ番号
+  virtual
+  void
+  release_group(ymuint group);
+
+  /// @brief 新しいスコープを始める．
+  virtual
+  void
+  push();
+
+  /// @brief 直前の push() 以降に追加された節を取り除く．
+  virtual
+  void
+  pop();
+
+  /// @brief 現在のスコープの深さを返す．
+  virtual
+  ymuint
+  scope_level() const;
+
+  /// @brief 変数を凍結する．
+  /// @param[in] var 変数番号
+  /// @param[in] frozen 凍結する時 true，凍結を解く時 false
+  virtual
+  void
+  set_frozen(tVarId var,
+	     bool frozen = true);
+
   /// @brief SAT 問題を解く．
   /// @param[in] assumptions あらかじめ仮定する変数の値割り当てリスト
   /// @param[out] model 充足するときの値の割り当てを格納する配列．
@@ -155,12 +247,31 @@ public:
   void
   timer_on(bool enable);
 
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // SatSolverPortfolio から用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 学習節を交換する共有バッファを設定する．
+  /// @param[in] share 共有バッファ
+  /// @param[in] id 共有バッファ上での自分の番号
+  /// @note 実装は SatSolverImpl_share.cc にある．
+  void
+  set_share(SatClauseShare* share,
+	    ymuint id);
+
   
 private:
   //////////////////////////////////////////////////////////////////////
   // 実装用のプライベート関数
   //////////////////////////////////////////////////////////////////////
 
+  // 節を追加する本体の関数
+  // add_clause() と add_group_clause() から呼ばれる．
+  void
+  add_clause_sub(const vector<Literal>& lits);
+
   // 探索を行う本体の関数
   Bool3
   search();
@@ -178,6 +289,10 @@ private:
   Literal
   next_decision();
 
+  // glucose 方式のリスタートを行うべきか調べる．
+  bool
+  check_glucose_restart();
+
   // 値の割当てか可能かチェックする．
   // 矛盾が起きたら false を返す．
   bool
@@ -194,22 +309,94 @@ private:
   void
   simplifyDB();
 
+  // レベル0で充足している節を削除する．
+  void
+  remove_satisfied(vector<SatReason>& clause_list);
+
+  // 解放された節グループの二項節を削除する．
+  void
+  remove_released_bin();
+
+  // 解放された活性化変数を再利用できるようにする．
+  void
+  recycle_released_var();
+
+  // 節がレベル0で充足していたら true を返す．
+  bool
+  is_satisfied(const SatClause& clause) const;
+
+  // 前処理を行う．
+  // 実装は SatSolverImpl_elim.cc にある．
+  void
+  preprocess(const vector<Literal>& assumptions);
+
+  // 前処理の対象となる制約節を pre に移して節データベースを空にする．
+  void
+  move_clauses(SatPreprocessor& pre);
+
+  // failed literal probing を行う．
+  void
+  probe();
+
+  // 除去された変数を復活させる．
+  void
+  reintroduce_var(tVarId var);
+
+  // 変数が除去されていたら true を返す．
+  bool
+  is_eliminated(tVarId var) const;
+
+  // 除去された変数の値を決めてモデルを完成させる．
+  void
+  extend_model(vector<Bool3>& model) const;
+
+  // 他のソルバの学習節を取り込む．
+  // 実装は SatSolverImpl_share.cc にある．
+  bool
+  import_clauses();
+
+  // 他のソルバの学習節を一つ取り込む．
+  bool
+  import_clause(vector<Literal>& lits,
+		ymuint lbd);
+
   // 使われていない学習節を削除する．
   void
   reduceDB();
 
+  // LBD に基づいて使われていない学習節を削除する．
+  void
+  reduceDB_lbd();
+
   // 学習節を追加する．
   void
-  add_learnt_clause(const vector<Literal>& lits);
+  add_learnt_clause(const vector<Literal>& lits,
+		    ymuint lbd);
+
+  // リテラルのリストの LBD を計算する．
+  ymuint
+  calc_lbd(const vector<Literal>& lits);
+
+  // 節の LBD を計算する．
+  ymuint
+  calc_lbd(const SatClause& clause);
 
   // 新しい節を生成する．
-  SatClause*
+  SatReason
   new_clause(const vector<Literal>& lits,
 	     bool learnt = false);
 
   // 節を削除する．
   void
-  delete_clause(SatClause* clause);
+  delete_clause(SatReason cref);
+
+  // 節を取り出す．
+  SatClause&
+  clause(SatReason cref) const;
+
+  // 削除された節の領域を回収する．
+  void
+  garbage_collect();
     
   // watcher list を得る．
   WatcherList&
@@ -218,7 +405,8 @@ private:
   // Watcher を追加する．
   void
   add_watcher(Literal watch_lit,
-	      SatReason reason);
+	      SatReason reason,
+	      Literal blocker);
   
   // 変数の評価を行う．
   Bool3
@@ -242,7 +430,7 @@ private:
   
   // 学習節が使われているか調べる．
   bool
-  is_locked(SatClause* clause) const;
+  is_locked(SatReason cref) const;
 
   // 変数のアクティビティを増加させる．
   void
@@ -346,17 +534,14 @@ private:
   // 正常の時に true となっているフラグ
   bool mSane;
 
-  // SatClause のメモリ領域確保用のアロケータ
-  SimpleAlloc mAlloc;
-
-  // Watcher 用のアロケータ
-  UnitAlloc mWatcherAlloc;
+  // SatClause のメモリ領域
+  ClauseArena mArena;
 
   // 制約節の配列
-  vector<SatClause*> mConstrClause;
+  vector<SatReason> mConstrClause;
 
   // 学習節の配列
-  vector<SatClause*> mLearntClause;
+  vector<SatReason> mLearntClause;
   
   // 変数の数
   ymuint32 mVarNum;
@@ -382,6 +567,16 @@ private:
   // アクティビティ
   double* mActivity;
 
+  // 最後に割り当てられていた極性の配列
+  tPol* mPhase;
+
+  // LBD 計算用に decision level ごとに付けるスタンプの配列
+  // サイズは mVarSize + 1
+  ymuint64* mLbdStamp;
+
+  // 現在の LBD 計算用のスタンプ
+  ymuint64 mLbdStampVal;
+
   // watcher list
   WatcherList* mWatcherList;
   
@@ -393,7 +588,7 @@ private:
   ymuint32 mHeapNum;
   
   // 矛盾の解析時にテンポラリに使用される節
-  SatClause* mTmpBinClause;
+  SatReason mTmpBinClause;
   
   // search 開始時の decision level
   int mRootLevel;
@@ -454,6 +649,24 @@ private:
 
   // 学習節の制限
   ymuint64 mLearntLimit;
+
+  // LBD による学習節の削除を次に行うコンフリクト数
+  ymuint64 mNextReduce;
+
+  // LBD による学習節の削除の間隔
+  ymuint64 mReduceInterval;
+
+  // 最近の学習節の LBD のキュー (glucose 方式のリスタート用)
+  BoundedQueue mLbdQueue;
+
+  // 最近の矛盾時の割り当て数のキュー (glucose 方式のリスタート用)
+  BoundedQueue mTrailQueue;
+
+  // 学習節の LBD の総和 (glucose 方式のリスタート用)
+  double mLbdSum;
+
+  // LBD を数えた学習節の数 (glucose 方式のリスタート用)
+  ymuint64 mLbdNum;
   
   // mConflistLimit の最大値
   ymuint64 mMaxConflict;
@@ -464,6 +677,98 @@ private:
   // add_clause 用の作業領域
   vector<Literal> mAcTmp;
 
+  // add_group_clause 用の作業領域
+  vector<Literal> mGcTmp;
+
+  // 節グループの活性化リテラルの配列
+  // グループ番号をインデックスとする．
+  // 0 番目と解放されたグループは kLiteralX となる．
+  vector<Literal> mGroupLit;
+
+  // 生きている節グループの数
+  ymuint32 mLiveGroupNum;
+
+  // 再利用可能なグループ番号のリスト
+  vector<ymuint> mFreeGroupList;
+
+  // 解放されたが節の削除が済んでいない活性化変数のリスト
+  vector<tVarId> mReleasedVarList;
+
+  // 再利用可能な活性化変数のリスト
+  vector<tVarId> mFreeVarList;
+
+  // push() で作られた節グループのスタック
+  vector<ymuint> mScopeStack;
+
+  // 前回 simplifyDB() で節を削除した時のレベル0の割り当て数
+  ymuint32 mSimpAssignNum;
+
+  // simplifyDB() で次に節の削除を行ってもよい implication 数
+  // 節の削除が頻繁に起こり過ぎないようにするためのもの
+  ymuint64 mSimpPropLimit;
+
+  // remove_released_bin() で用いる作業領域
+  // 解放された活性化変数に印を付ける．
+  vector<bool> mReleasedMark;
+
+  // 凍結された変数の印
+  vector<bool> mFrozen;
+
+  // 除去された変数の印
+  vector<bool> mElimMark;
+
+  // 除去された変数の節のリテラルの配列
+  // 形式は SatPreprocessor::elim_lits() と同じ
+  vector<Literal> mElimLits;
+
+  // 変数除去の記録のリスト
+  vector<SatPreprocessor::ElimRecord> mElimRecordList;
+
+  // mElimLits に現れる変数の印
+  // 解放された活性化変数でもこの印のあるものは再利用しない．
+  vector<bool> mElimLitsMark;
+
+  // 変数番号をキーにして mElimRecordList 上の最新の記録の位置を入れる配列
+  // mElimMark が false の変数の値は意味を持たない．
+  vector<ymuint32> mElimRecordPos;
+
+  // 前回の前処理以降に追加された制約節の数
+  ymuint64 mNewClauseNum;
+
+  // 除去された変数の数(復活させたものは除く)
+  ymuint64 mElimVarNum;
+
+  // 包含により削除された節の数
+  ymuint64 mSubsumedNum;
+
+  // 自己包含により削除されたリテラルの数
+  ymuint64 mStrengthenedNum;
+
+  // failed literal probing で見つかった単位節の数
+  ymuint64 mProbedUnitNum;
+
+  // 前処理の時間計測器
+  StopWatch mSimpTimer;
+
+  // 学習節を交換する共有バッファ
+  SatClauseShare* mShare;
+
+  // 共有バッファ上での自分の番号
+  ymuint32 mShareId;
+
+  // 次に学習節の交換を行うコンフリクト数
+  ymuint64 mNextShare;
+
+  // 他のソルバが答えを出したので探索を打ち切った時に true となるフラグ
+  bool mShareStop;
+
+  // 取り込んだが基底レベルでしか割り当てられなかった単位節のリスト
+  // 次の solve() の始めにレベル0で割り当てる．
+  vector<Literal> mShareUnitList;
+
+  // 学習節の交換で用いる作業領域
+  vector<Literal> mShareTmp;
+
 };
 
 
@@ -479,6 +784,14 @@ SatSolverImpl::variable_num() const
   return mVarNum;
 }
 
+// @brief 現在のスコープの深さを返す．
+inline
+ymuint
+SatSolverImpl::scope_level() const
+{
+  return mScopeStack.size();
+}
+
 // @brief 制約節の数を得る．
 inline
 ymuint
@@ -504,6 +817,14 @@ SatSolverImpl::watcher_list(Literal lit)
   return mWatcherList[index];
 }
 
+// 節を取り出す．
+inline
+SatClause&
+SatSolverImpl::clause(SatReason cref) const
+{
+  return mArena.clause(cref.clause_ref());
+}
+
 // 変数の評価を行う．
 inline
 Bool3
@@ -579,14 +900,22 @@ SatSolverImpl::reason(tVarId varid) const
 // @brief clase が含意の理由になっているか調べる．
 inline
 bool
-SatSolverImpl::is_locked(SatClause* clause) const
+SatSolverImpl::is_locked(SatReason cref) const
 {
   // 直感的には分かりにくいが，SatClause の最初のリテラルは
   // 残りのリテラルによって含意されていることになっている．
   // そこで最初のリテラルの変数の割り当て理由が自分自身か
   // どうかを調べれば clause が割り当て理由として用いられて
   // いるかわかる．
-  return reason(clause->lit0().varid()) == SatReason(clause);
+  return reason(clause(cref).lit0().varid()) == cref;
+}
+
+// 変数が除去されていたら true を返す．
+inline
+bool
+SatSolverImpl::is_eliminated(tVarId var) const
+{
+  return mElimMark[var];
 }
 
 // @brief 時間計測機能を制御する
@@ -609,9 +938,14 @@ SatSolverImpl::alloc_var()
     for (ymuint i = mOldVarNum; i < mVarNum; ++ i) {
       mVal[i] = kB3X;
       mActivity[i] = 0.0;
+      mPhase[i] = kPolNega;
       heap_add_var(i);
     }
     mOldVarNum = mVarNum;
+    mFrozen.resize(mVarNum, false);
+    mElimMark.resize(mVarNum, false);
+    mElimLitsMark.resize(mVarNum, false);
+    mElimRecordPos.resize(mVarNum, 0);
   }
 }
 
@@ -20,8 +20,9 @@ BEGIN_NAMESPACE_YM_SAT
 
 // @brief コンストラクタ
 SatSolverImplR::SatSolverImplR(ostream& out,
-			       SatAnalyzer* analyzer) :
-  SatSolverImpl(analyzer),
+			       SatAnalyzer* analyzer,
+			       const Params& params) :
+  SatSolverImpl(analyzer, params),
   mOut(out)
 {
 }
@@ -51,22 +52,78 @@ void
 SatSolverImplR::add_clause(const vector<Literal>& lits)
 {
   mOut << "A";
-  for (vector<Literal>::const_iterator p = lits.begin();
-       p != lits.end(); ++ p) {
-    Literal l = *p;
-    mOut << " " << l.varid();
-    if ( l.pol() == kPolPosi ) {
-      mOut << "P";
-    }
-    else {
-      mOut << "N";
-    }
-  }
+  put_lits(lits);
   mOut << endl;
 
   SatSolverImpl::add_clause(lits);
 }
 
+// @brief 節グループを作る．
+// @return グループ番号を返す．
+ymuint
+SatSolverImplR::new_group()
+{
+  ymuint group = SatSolverImpl::new_group();
+
+  mOut << "G" << endl
+       << "# group = " << group << endl;
+  return group;
+}
+
+// @brief 節グループに節を追加する．
+// @param[in] group グループ番号
+// @param[in] lits リテラルのベクタ
+void
+SatSolverImplR::add_group_clause(ymuint group,
+				 const vector<Literal>& lits)
+{
+  mOut << "B " << group;
+  put_lits(lits);
+  mOut << endl;
+
+  SatSolverImpl::add_group_clause(group, lits);
+}
+
+// @brief 節グループを解放する．
+// @param[in] group グループ番号
+void
+SatSolverImplR::release_group(ymuint group)
+{
+  mOut << "R " << group << endl;
+
+  SatSolverImpl::release_group(group);
+}
+
+// @brief 新しいスコープを始める．
+void
+SatSolverImplR::push()
+{
+  mOut << "P" << endl;
+
+  SatSolverImpl::push();
+}
+
+// @brief 直前の push() 以降に追加された節を取り除く．
+void
+SatSolverImplR::pop()
+{
+  mOut << "Q" << endl;
+
+  SatSolverImpl::pop();
+}
+
+// @brief 変数を凍結する．
+// @param[in] var 変数番号
+// @param[in] frozen 凍結する時 true，凍結を解く時 false
+void
+SatSolverImplR::set_frozen(tVarId var,
+			   bool frozen)
+{
+  mOut << "F " << var << " " << (frozen ? 1 : 0) << endl;
+
+  SatSolverImpl::set_frozen(var, frozen);
+}
+
 // @brief SAT 問題を解く．
 // @param[in] assumptions あらかじめ仮定する変数の値割り当てリスト
 // @param[out] model 充足するときの値の割り当てを格納する配列．
@@ -79,8 +136,22 @@ SatSolverImplR::solve(const vector<Literal>& assumptions,
 		      vector<Bool3>& model)
 {
   mOut << "S";
-  for (vector<Literal>::const_iterator p = assumptions.begin();
-       p != assumptions.end(); ++ p) {
+  put_lits(assumptions);
+  mOut << endl;
+
+  Bool3 ans = SatSolverImpl::solve(assumptions, model);
+
+  mOut << "# " << ans << endl;
+
+  return ans;
+}
+
+// リテラルのリストを出力する．
+void
+SatSolverImplR::put_lits(const vector<Literal>& lits)
+{
+  for (vector<Literal>::const_iterator p = lits.begin();
+       p != lits.end(); ++ p) {
     Literal l = *p;
     mOut << " " << l.varid();
     if ( l.pol() == kPolPosi ) {
@@ -90,13 +161,6 @@ SatSolverImplR::solve(const vector<Literal>& assumptions,
       mOut << "N";
     }
   }
-  mOut << endl;
-
-  Bool3 ans = SatSolverImpl::solve(assumptions, model);
-
-  mOut << "# " << ans << endl;
-
-  return ans;
 }
 
 END_NAMESPACE_YM_SAT
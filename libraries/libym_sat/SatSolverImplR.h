@@ -28,8 +28,10 @@ public:
   /// @brief コンストラクタ
   /// @param[in] out 出力ストリーム
   /// @param[in] analyzer 解析器のポインタ
+  /// @param[in] params 制御用パラメータ
   SatSolverImplR(ostream& out,
-		 SatAnalyzer* analyer);
+		 SatAnalyzer* analyer,
+		 const Params& params = kDefaultParams);
 
   /// @brief デストラクタ
   virtual
@@ -54,6 +56,44 @@ public:
   void
   add_clause(const vector<Literal>& lits);
 
+  /// @brief 節グループを作る．
+  /// @return グループ番号を返す．
+  virtual
+  ymuint
+  new_group();
+
+  /// @brief 節グループに節を追加する．
+  /// @param[in] group グループ番号
+  /// @param[in] lits リテラルのベクタ
+  virtual
+  void
+  add_group_clause(ymuint group,
+		   const vector<Literal>& lits);
+
+  /// @brief 節グループを解放する．
+  /// @param[in] group グループ番号
+  virtual
+  void
+  release_group(ymuint group);
+
+  /// @brief 新しいスコープを始める．
+  virtual
+  void
+  push();
+
+  /// @brief 直前の push() 以降に追加された節を取り除く．
+  virtual
+  void
+  pop();
+
+  /// @brief 変数を凍結する．
+  /// @param[in] var 変数番号
+  /// @param[in] frozen 凍結する時 true，凍結を解く時 false
+  virtual
+  void
+  set_frozen(tVarId var,
+	     bool frozen = true);
+
   /// @brief SAT 問題を解く．
   /// @param[in] assumptions あらかじめ仮定する変数の値割り当てリスト
   /// @param[out] model 充足するときの値の割り当てを格納する配列．
@@ -67,6 +107,16 @@ public:
 	vector<Bool3>& model);
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  // リテラルのリストを出力する．
+  void
+  put_lits(const vector<Literal>& lits);
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
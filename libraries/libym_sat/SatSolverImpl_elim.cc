@@ -0,0 +1,400 @@
+
+/// @file libym_sat/SatSolverImpl_elim.cc
+/// @brief SatSolverImpl の前処理関係の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "SatSolverImpl.h"
+#include "SatPreprocessor.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+BEGIN_NONAMESPACE
+
+// failed literal probing で用いる implication 数の上限
+// 制約節の総リテラル数のこの値倍とする．
+const ymuint64 kProbeFactor = 10;
+
+// モデル上でのリテラルの値が true なら true を返す．
+inline
+bool
+is_true(const vector<Bool3>& model,
+	Literal lit)
+{
+  Bool3 val = model[lit.varid()];
+  if ( lit.pol() == kPolPosi ) {
+    return val == kB3True;
+  }
+  else {
+    return val == kB3False;
+  }
+}
+
+END_NONAMESPACE
+
+
+// @brief 変数を凍結する．
+// @param[in] var 変数番号
+// @param[in] frozen 凍結する時 true，凍結を解く時 false
+void
+SatSolverImpl::set_frozen(tVarId var,
+			  bool frozen)
+{
+  alloc_var();
+  if ( var >= mVarNum ) {
+    cout << "Error![SatSolverImpl]: var(" << var << "): out of range"
+	 << endl;
+    return;
+  }
+  if ( frozen && is_eliminated(var) ) {
+    reintroduce_var(var);
+  }
+  mFrozen[var] = frozen;
+}
+
+// 前処理を行う．
+// assumptions には節グループの活性化リテラルも含まれている．
+void
+SatSolverImpl::preprocess(const vector<Literal>& assumptions)
+{
+  // assumption に除去された変数が含まれていたら復活させる．
+  for (vector<Literal>::const_iterator p = assumptions.begin();
+       p != assumptions.end(); ++ p) {
+    tVarId var = p->varid();
+    if ( var < mVarNum && is_eliminated(var) ) {
+      reintroduce_var(var);
+    }
+  }
+  if ( !mSane ) {
+    return;
+  }
+
+  // 前回から追加された節が少ない時は行わない．
+  if ( mNewClauseNum == 0 || mNewClauseNum * 2 < clause_num() ) {
+    return;
+  }
+
+  mSimpTimer.start();
+
+  SatPreprocessor pre(mVarNum);
+  for (ymuint var = 0; var < mVarNum; ++ var) {
+    if ( mFrozen[var] ) {
+      pre.set_frozen(var);
+    }
+  }
+  for (vector<Literal>::const_iterator p = assumptions.begin();
+       p != assumptions.end(); ++ p) {
+    pre.set_frozen(p->varid());
+  }
+
+  move_clauses(pre);
+
+  if ( !pre.run() ) {
+    mSane = false;
+    mSimpTimer.stop();
+    return;
+  }
+
+  // 結果の節で節データベースを作り直す．
+  const vector<Literal>& unit_list = pre.unit_list();
+  for (vector<Literal>::const_iterator p = unit_list.begin();
+       p != unit_list.end(); ++ p) {
+    if ( !check_and_assign(*p) ) {
+      mSane = false;
+      mSimpTimer.stop();
+      return;
+    }
+  }
+  ymuint nc = pre.clause_num();
+  for (ymuint id = 0; id < nc && mSane; ++ id) {
+    if ( !pre.is_deleted(id) ) {
+      add_clause_sub(pre.clause(id));
+    }
+  }
+  if ( mSane && implication() != kNullSatReason ) {
+    mSane = false;
+  }
+  if ( !mSane ) {
+    mSimpTimer.stop();
+    return;
+  }
+
+  // 変数除去の記録を移す．
+  ymuint32 offset = mElimLits.size();
+  const vector<Literal>& elim_lits = pre.elim_lits();
+  for (vector<Literal>::const_iterator p = elim_lits.begin();
+       p != elim_lits.end(); ++ p) {
+    Literal l = *p;
+    mElimLits.push_back(l);
+    if ( l != kLiteralX ) {
+      mElimLitsMark[l.varid()] = true;
+    }
+  }
+  const vector<SatPreprocessor::ElimRecord>& rec_list =
+    pre.elim_record_list();
+  for (vector<SatPreprocessor::ElimRecord>::const_iterator p = rec_list.begin();
+       p != rec_list.end(); ++ p) {
+    SatPreprocessor::ElimRecord rec = *p;
+    rec.mBegin += offset;
+    rec.mEnd += offset;
+    mElimRecordPos[rec.mVar] = mElimRecordList.size();
+    mElimRecordList.push_back(rec);
+    mElimMark[rec.mVar] = true;
+    ++ mElimVarNum;
+  }
+
+  mSubsumedNum += pre.subsumed_num();
+  mStrengthenedNum += pre.strengthened_num();
+  mNewClauseNum = 0;
+
+  probe();
+
+  mSimpTimer.stop();
+}
+
+// 前処理の対象となる制約節を pre に移して節データベースを空にする．
+// 学習節は捨てる．
+void
+SatSolverImpl::move_clauses(SatPreprocessor& pre)
+{
+  vector<Literal> tmp_lits;
+
+  for (vector<SatReason>::iterator p = mConstrClause.begin();
+       p != mConstrClause.end(); ++ p) {
+    SatReason cref = *p;
+    SatClause& c = clause(cref);
+    if ( !is_satisfied(c) ) {
+      tmp_lits.clear();
+      ymuint n = c.size();
+      for (ymuint i = 0; i < n; ++ i) {
+	Literal l = c.lit(i);
+	if ( eval(l) == kB3X ) {
+	  tmp_lits.push_back(l);
+	}
+      }
+      pre.add_clause(tmp_lits);
+    }
+    mArena.delete_clause(cref.clause_ref());
+  }
+  mConstrClause.clear();
+
+  for (vector<SatReason>::iterator p = mLearntClause.begin();
+       p != mLearntClause.end(); ++ p) {
+    mArena.delete_clause(p->clause_ref());
+  }
+  mLearntClause.clear();
+
+  // 二項節は watcher list にしか現れない．
+  // 一つの二項節は二つの watcher list に現れるので片方でだけ取り出す．
+  ymuint n2 = mOldVarNum * 2;
+  for (ymuint i = 0; i < n2; ++ i) {
+    Literal l0 = ~Literal::index2literal(i);
+    WatcherList& wlist = mWatcherList[i];
+    ymuint n = wlist.num();
+    for (ymuint pos = 0; pos < n; ++ pos) {
+      SatReason r = wlist.elem(pos).reason();
+      if ( !r.is_literal() || r.is_learnt_bin() ) {
+	continue;
+      }
+      Literal l1 = r.literal();
+      if ( !(l0 < l1) ) {
+	continue;
+      }
+      if ( eval(l0) == kB3True || eval(l1) == kB3True ) {
+	continue;
+      }
+      tmp_lits.clear();
+      if ( eval(l0) == kB3X ) {
+	tmp_lits.push_back(l0);
+      }
+      if ( eval(l1) == kB3X ) {
+	tmp_lits.push_back(l1);
+      }
+      pre.add_clause(tmp_lits);
+    }
+    wlist.erase(0);
+  }
+
+  mConstrBinNum = 0;
+  mConstrLitNum = 0;
+  mLearntBinNum = 0;
+  mLearntLitNum = 0;
+
+  // レベル0の割り当て理由は削除した節を指しているかもしれない．
+  ymuint na = mAssignList.size();
+  for (ymuint i = 0; i < na; ++ i) {
+    mReason[mAssignList.get(i).varid()] = kNullSatReason;
+  }
+
+  garbage_collect();
+}
+
+// failed literal probing を行う．
+// 各変数について正負それぞれの値を仮に割り当てて implication を行い，
+// - 矛盾が起きたら逆の値をレベル0で割り当てる．
+// - どちらの値でも含意されるリテラルをレベル0で割り当てる．
+void
+SatSolverImpl::probe()
+{
+  // バックトラックで phase が書き換えられないようにする．
+  bool old_phase_cache = mParams.mPhaseCache;
+  mParams.mPhaseCache = false;
+
+  ymuint64 limit = mPropagationNum + mConstrLitNum * kProbeFactor;
+  vector<bool> mark(mVarNum * 2, false);
+  vector<Literal> implied;
+  vector<Literal> unit_list;
+  for (tVarId var = 0; var < mVarNum && mSane; ++ var) {
+    if ( mPropagationNum > limit ) {
+      break;
+    }
+    if ( eval(var) != kB3X || is_eliminated(var) ) {
+      continue;
+    }
+
+    // 二項節の watcher を持たないリテラルを割り当てても
+    // レベル1では何も含意されない．
+    bool has_bin[2] = { false, false };
+    for (ymuint b = 0; b < 2; ++ b) {
+      Literal lit(var, (b == 0) ? kPolPosi : kPolNega);
+      WatcherList& wlist = watcher_list(lit);
+      ymuint n = wlist.num();
+      for (ymuint pos = 0; pos < n; ++ pos) {
+	if ( wlist.elem(pos).reason().is_literal() ) {
+	  has_bin[b] = true;
+	  break;
+	}
+      }
+    }
+    if ( !has_bin[0] && !has_bin[1] ) {
+      continue;
+    }
+
+    implied.clear();
+    unit_list.clear();
+    bool failed = false;
+    for (ymuint b = 0; b < 2 && !failed; ++ b) {
+      if ( !has_bin[b] ) {
+	continue;
+      }
+      Literal lit(var, (b == 0) ? kPolPosi : kPolNega);
+      ymuint base = mAssignList.size();
+      mAssignList.set_marker();
+      assign(lit);
+      if ( implication() != kNullSatReason ) {
+	// lit は割り当てられない．
+	unit_list.clear();
+	unit_list.push_back(~lit);
+	failed = true;
+      }
+      else {
+	ymuint na = mAssignList.size();
+	for (ymuint i = base + 1; i < na; ++ i) {
+	  Literal l = mAssignList.get(i);
+	  if ( b == 0 ) {
+	    mark[l.index()] = true;
+	    implied.push_back(l);
+	  }
+	  else if ( mark[l.index()] ) {
+	    unit_list.push_back(l);
+	  }
+	}
+      }
+      backtrack(0);
+    }
+    for (vector<Literal>::iterator p = implied.begin();
+	 p != implied.end(); ++ p) {
+      mark[p->index()] = false;
+    }
+
+    if ( unit_list.empty() ) {
+      continue;
+    }
+    for (vector<Literal>::iterator p = unit_list.begin();
+	 p != unit_list.end(); ++ p) {
+      ++ mProbedUnitNum;
+      if ( !check_and_assign(*p) ) {
+	mSane = false;
+	break;
+      }
+    }
+    if ( mSane && implication() != kNullSatReason ) {
+      mSane = false;
+    }
+  }
+
+  mParams.mPhaseCache = old_phase_cache;
+}
+
+// 除去された変数を復活させる．
+// 除去した時に削除した節を追加し直す．
+// それらの節に除去された変数が含まれていたら add_clause_sub() の中で
+// 再帰的に復活させる．
+void
+SatSolverImpl::reintroduce_var(tVarId var)
+{
+  mElimMark[var] = false;
+  -- mElimVarNum;
+  heap_push(var);
+
+  const SatPreprocessor::ElimRecord& rec =
+    mElimRecordList[mElimRecordPos[var]];
+  ymuint32 begin = rec.mBegin;
+  ymuint32 end = rec.mEnd;
+  vector<Literal> tmp_lits;
+  for (ymuint32 pos = begin; pos < end && mSane; ++ pos) {
+    Literal l = mElimLits[pos];
+    if ( l == kLiteralX ) {
+      add_clause_sub(tmp_lits);
+      tmp_lits.clear();
+    }
+    else {
+      tmp_lits.push_back(l);
+    }
+  }
+}
+
+// 除去された変数の値を決めてモデルを完成させる．
+// 除去した順と逆の順に，除去した時に削除した節を全て充足するように
+// 値を決める．
+void
+SatSolverImpl::extend_model(vector<Bool3>& model) const
+{
+  for (ymuint i = mElimRecordList.size(); i -- > 0; ) {
+    const SatPreprocessor::ElimRecord& rec = mElimRecordList[i];
+    tVarId var = rec.mVar;
+    if ( !is_eliminated(var) || mElimRecordPos[var] != i ) {
+      // 復活させた変数の古い記録
+      continue;
+    }
+
+    // まず false にしておいて，正のリテラルを含む節で
+    // 他のリテラルが全て false のものがあれば true にする．
+    Bool3 val = kB3False;
+    ymuint32 pos = rec.mBegin;
+    while ( pos < rec.mEnd ) {
+      Literal pivot = mElimLits[pos];
+      ++ pos;
+      bool sat = false;
+      for ( ; mElimLits[pos] != kLiteralX; ++ pos) {
+	if ( is_true(model, mElimLits[pos]) ) {
+	  sat = true;
+	}
+      }
+      ++ pos;
+      if ( !sat && pivot.pol() == kPolPosi ) {
+	val = kB3True;
+	break;
+      }
+    }
+    model[var] = val;
+  }
+}
+
+END_NAMESPACE_YM_SAT
@@ -0,0 +1,155 @@
+
+/// @file libym_sat/SatSolverImpl_share.cc
+/// @brief SatSolverImpl の学習節の交換関係の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "SatSolverImpl.h"
+#include "SatClauseShare.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+// @brief 学習節を交換する共有バッファを設定する．
+// @param[in] share 共有バッファ
+// @param[in] id 共有バッファ上での自分の番号
+void
+SatSolverImpl::set_share(SatClauseShare* share,
+			 ymuint id)
+{
+  mShare = share;
+  mShareId = id;
+}
+
+// 他のソルバの学習節を取り込む．
+// 基底レベルで呼ばれなければならない．
+// 基底レベルの割り当てで矛盾が起きたら false を返す．
+bool
+SatSolverImpl::import_clauses()
+{
+  assert_cond(decision_level() == mRootLevel, __FILE__, __LINE__);
+
+  ymuint lbd;
+  while ( mShare->get(mShareId, mShareTmp, lbd) ) {
+    if ( !import_clause(mShareTmp, lbd) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 他のソルバの学習節を一つ取り込む．
+// 学習節は元の CNF の論理的帰結なのでそのまま学習節として加えられるが，
+// 基底レベルでは割り当て済みのリテラルがあるので
+// add_learnt_clause() と違って監視するリテラルを選ぶ必要がある．
+// 基底レベルの割り当てで矛盾が起きたら false を返す．
+bool
+SatSolverImpl::import_clause(vector<Literal>& lits,
+			     ymuint lbd)
+{
+  // レベル0で偽のリテラルを取り除く．
+  // 知らない変数や前処理で除去された変数を含む節と
+  // レベル0で充足している節は捨てる．
+  ymuint wpos = 0;
+  for (ymuint rpos = 0; rpos < lits.size(); ++ rpos) {
+    Literal l = lits[rpos];
+    tVarId var = l.varid();
+    if ( var >= mVarNum || is_eliminated(var) ) {
+      return true;
+    }
+    Bool3 val = eval(l);
+    if ( val != kB3X && decision_level(var) == 0 ) {
+      if ( val == kB3True ) {
+	return true;
+      }
+      continue;
+    }
+    lits[wpos] = l;
+    ++ wpos;
+  }
+  ymuint n = wpos;
+  lits.erase(lits.begin() + n, lits.end());
+
+  if ( n == 0 ) {
+    // レベル0で矛盾している．
+    mSane = false;
+    return false;
+  }
+
+  // 監視するリテラルを先頭の二つに持ってくる．
+  // 未割り当てか真のリテラルを優先し，
+  // 偽のリテラルの中では decision level の高いものを優先する．
+  int top = decision_level() + 1;
+  for (ymuint i = 0; i < 2 && i < n; ++ i) {
+    ymuint best = i;
+    int best_score = -1;
+    for (ymuint j = i; j < n; ++ j) {
+      Literal l = lits[j];
+      int score = top;
+      if ( eval(l) == kB3False ) {
+	score = decision_level(l.varid());
+      }
+      if ( score > best_score ) {
+	best = j;
+	best_score = score;
+      }
+    }
+    Literal tmp = lits[i];
+    lits[i] = lits[best];
+    lits[best] = tmp;
+  }
+
+  Literal l0 = lits[0];
+  Bool3 val0 = eval(l0);
+  if ( val0 == kB3False ) {
+    // 基底レベルの割り当てだけで矛盾している．
+    return false;
+  }
+
+  if ( n == 1 ) {
+    // 単位節はレベル0で割り当てるべきだが，基底レベルがレベル0で
+    // ない時は今は基底レベルで割り当てておき，次の solve() で
+    // 改めてレベル0で割り当てる．
+    if ( val0 == kB3X ) {
+      assign(l0);
+    }
+    if ( mRootLevel > 0 ) {
+      mShareUnitList.push_back(l0);
+    }
+    return true;
+  }
+
+  mLearntLitNum += n;
+
+  SatReason reason;
+  Literal l1 = lits[1];
+  if ( n == 2 ) {
+    reason = SatReason(l1, true);
+
+    add_watcher(~l0, SatReason(l1, true), l1);
+    add_watcher(~l1, SatReason(l0, true), l0);
+    ++ mLearntBinNum;
+  }
+  else {
+    reason = new_clause(lits, true);
+    clause(reason).set_lbd(lbd);
+    mLearntClause.push_back(reason);
+
+    add_watcher(~l0, reason, l1);
+    add_watcher(~l1, reason, l0);
+  }
+
+  if ( val0 == kB3X && eval(l1) == kB3False ) {
+    // 単位節になっている．
+    assign(l0, reason);
+  }
+
+  return true;
+}
+
+END_NAMESPACE_YM_SAT
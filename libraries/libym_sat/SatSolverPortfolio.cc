@@ -0,0 +1,359 @@
+
+/// @file libym_sat/SatSolverPortfolio.cc
+/// @brief SatSolverPortfolio の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "SatSolverPortfolio.h"
+#include "SatSolverImpl.h"
+#include "SatClauseShare.h"
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+//////////////////////////////////////////////////////////////////////
+// SatSolverPortfolio
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] solver_list ソルバのリスト
+// @param[in] deterministic 決定的モードの時 true にする．
+SatSolverPortfolio::SatSolverPortfolio(const vector<SatSolverImpl*>& solver_list,
+				       bool deterministic) :
+  mSolverList(solver_list),
+  mShare(NULL),
+  mLastWinner(0),
+  mGroupLit(1, kLiteralX),
+  mLiveGroupNum(0)
+{
+  ymuint n = mSolverList.size();
+  if ( n > 1 ) {
+    mShare = new SatClauseShare(n, deterministic);
+    for (ymuint i = 0; i < n; ++ i) {
+      mSolverList[i]->set_share(mShare, i);
+    }
+  }
+}
+
+// @brief デストラクタ
+SatSolverPortfolio::~SatSolverPortfolio()
+{
+  for (vector<SatSolverImpl*>::iterator p = mSolverList.begin();
+       p != mSolverList.end(); ++ p) {
+    delete *p;
+  }
+  delete mShare;
+}
+
+// @brief 正しい状態のときに true を返す．
+// @note 交換される学習節は全て元の CNF の論理的帰結なので
+// どれか一つでも矛盾していれば全体が矛盾している．
+bool
+SatSolverPortfolio::sane() const
+{
+  for (vector<SatSolverImpl*>::const_iterator p = mSolverList.begin();
+       p != mSolverList.end(); ++ p) {
+    if ( !(*p)->sane() ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// @brief 変数を追加する．
+// @return 新しい変数番号を返す．
+// @note 変数番号は 0 から始まる．
+tVarId
+SatSolverPortfolio::new_var()
+{
+  tVarId var = mSolverList[0]->new_var();
+  ymuint n = mSolverList.size();
+  for (ymuint i = 1; i < n; ++ i) {
+    tVarId var1 = mSolverList[i]->new_var();
+    assert_cond(var1 == var, __FILE__, __LINE__);
+  }
+  return var;
+}
+
+// @brief 節を追加する．
+// @param[in] lits リテラルのベクタ
+void
+SatSolverPortfolio::add_clause(const vector<Literal>& lits)
+{
+  if ( !mScopeStack.empty() ) {
+    // スコープの中では現在のスコープの節グループに追加する．
+    add_group_clause(mScopeStack.back(), lits);
+    return;
+  }
+
+  for (vector<SatSolverImpl*>::iterator p = mSolverList.begin();
+       p != mSolverList.end(); ++ p) {
+    (*p)->add_clause(lits);
+  }
+}
+
+// @brief 節グループを作る．
+// @return グループ番号を返す．
+ymuint
+SatSolverPortfolio::new_group()
+{
+  ymuint group;
+  if ( mFreeGroupList.empty() ) {
+    group = mGroupLit.size();
+    mGroupLit.push_back(kLiteralX);
+  }
+  else {
+    group = mFreeGroupList.back();
+    mFreeGroupList.pop_back();
+  }
+  mGroupLit[group] = Literal(new_var(), kPolPosi);
+  ++ mLiveGroupNum;
+  return group;
+}
+
+// @brief 節グループに節を追加する．
+// @param[in] group グループ番号
+// @param[in] lits リテラルのベクタ
+void
+SatSolverPortfolio::add_group_clause(ymuint group,
+				     const vector<Literal>& lits)
+{
+  if ( group >= mGroupLit.size() || mGroupLit[group] == kLiteralX ) {
+    cout << "Error![SatSolverPortfolio]: group(" << group
+	 << "): illegal group" << endl;
+    return;
+  }
+
+  vector<Literal> tmp(lits);
+  tmp.push_back(~mGroupLit[group]);
+  for (vector<SatSolverImpl*>::iterator p = mSolverList.begin();
+       p != mSolverList.end(); ++ p) {
+    (*p)->add_clause(tmp);
+  }
+}
+
+// @brief 節グループを解放する．
+// @param[in] group グループ番号
+void
+SatSolverPortfolio::release_group(ymuint group)
+{
+  if ( group >= mGroupLit.size() || mGroupLit[group] == kLiteralX ) {
+    cout << "Error![SatSolverPortfolio]: group(" << group
+	 << "): illegal group" << endl;
+    return;
+  }
+
+  // 活性化変数を false に固定する．
+  // 充足された節は各ソルバの simplifyDB() で削除される．
+  vector<Literal> tmp(1, ~mGroupLit[group]);
+  for (vector<SatSolverImpl*>::iterator p = mSolverList.begin();
+       p != mSolverList.end(); ++ p) {
+    (*p)->add_clause(tmp);
+  }
+
+  mGroupLit[group] = kLiteralX;
+  mFreeGroupList.push_back(group);
+  -- mLiveGroupNum;
+}
+
+// @brief 新しいスコープを始める．
+void
+SatSolverPortfolio::push()
+{
+  mScopeStack.push_back(new_group());
+}
+
+// @brief 直前の push() 以降に追加された節を取り除く．
+void
+SatSolverPortfolio::pop()
+{
+  if ( mScopeStack.empty() ) {
+    cout << "Error![SatSolverPortfolio]: pop() without push()" << endl;
+    return;
+  }
+  ymuint group = mScopeStack.back();
+  mScopeStack.pop_back();
+  release_group(group);
+}
+
+// @brief 現在のスコープの深さを返す．
+ymuint
+SatSolverPortfolio::scope_level() const
+{
+  return mScopeStack.size();
+}
+
+// @brief 変数を凍結する．
+// @param[in] var 変数番号
+// @param[in] frozen 凍結する時 true，凍結を解く時 false
+void
+SatSolverPortfolio::set_frozen(tVarId var,
+			       bool frozen)
+{
+  for (vector<SatSolverImpl*>::iterator p = mSolverList.begin();
+       p != mSolverList.end(); ++ p) {
+    (*p)->set_frozen(var, frozen);
+  }
+}
+
+// @brief SAT 問題を解く．
+// @param[in] assumptions あらかじめ仮定する変数の値割り当てリスト
+// @param[out] model 充足するときの値の割り当てを格納する配列．
+// @retval kB3True 充足した．
+// @retval kB3False 充足不能が判明した．
+// @retval kB3X わからなかった．
+// @note i 番めの変数の割り当て結果は model[i] に入る．
+Bool3
+SatSolverPortfolio::solve(const vector<Literal>& assumptions,
+			  vector<Bool3>& model)
+{
+  // 生きている節グループの活性化リテラルを assumption に加える．
+  vector<Literal> assumptions1;
+  assumptions1.reserve(mLiveGroupNum + assumptions.size());
+  if ( mLiveGroupNum > 0 ) {
+    for (vector<Literal>::const_iterator p = mGroupLit.begin();
+	 p != mGroupLit.end(); ++ p) {
+      if ( *p != kLiteralX ) {
+	assumptions1.push_back(*p);
+      }
+    }
+  }
+  assumptions1.insert(assumptions1.end(),
+		      assumptions.begin(), assumptions.end());
+
+  ymuint n = mSolverList.size();
+  if ( n == 1 ) {
+    mLastWinner = 0;
+    return mSolverList[0]->solve(assumptions1, model);
+  }
+
+  mShare->start();
+
+  vector<Task> task_array(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    Task& task = task_array[i];
+    task.mMgr = this;
+    task.mId = i;
+    task.mStarted = false;
+    task.mAssumptions = &assumptions1;
+    task.mAns = kB3X;
+  }
+
+  // 0 番目はメインスレッドで動かす．
+  for (ymuint i = 1; i < n; ++ i) {
+    Task& task = task_array[i];
+    if ( pthread_create(&task.mThread, NULL, thread_main, &task) == 0 ) {
+      task.mStarted = true;
+    }
+    else {
+      // スレッドが作れなかったソルバは終了したものとみなす．
+      mShare->finish(i, false);
+    }
+  }
+  run(task_array[0]);
+  for (ymuint i = 1; i < n; ++ i) {
+    Task& task = task_array[i];
+    if ( task.mStarted ) {
+      pthread_join(task.mThread, NULL);
+    }
+  }
+
+  int winner = mShare->winner();
+  if ( winner == -1 ) {
+    return kB3X;
+  }
+  mLastWinner = winner;
+  Task& task = task_array[winner];
+  if ( task.mAns == kB3True ) {
+    model.swap(task.mModel);
+  }
+  return task.mAns;
+}
+
+// 一つのソルバで solve() を行う．
+void
+SatSolverPortfolio::run(Task& task)
+{
+  SatSolverImpl* solver = mSolverList[task.mId];
+  task.mAns = solver->solve(*task.mAssumptions, task.mModel);
+  mShare->finish(task.mId, task.mAns != kB3X);
+}
+
+// スレッドの本体
+void*
+SatSolverPortfolio::thread_main(void* arg)
+{
+  Task* task = static_cast<Task*>(arg);
+  task->mMgr->run(*task);
+  return NULL;
+}
+
+// @brief 現在の内部状態を得る．
+// @param[out] stats 状態を格納する構造体
+void
+SatSolverPortfolio::get_stats(SatStats& stats) const
+{
+  mSolverList[mLastWinner]->get_stats(stats);
+}
+
+// @brief 変数の数を得る．
+ymuint
+SatSolverPortfolio::variable_num() const
+{
+  return mSolverList[0]->variable_num();
+}
+
+// @brief 制約節の数を得る．
+ymuint
+SatSolverPortfolio::clause_num() const
+{
+  return mSolverList[0]->clause_num();
+}
+
+// @brief 制約節のリテラルの総数を得る．
+ymuint
+SatSolverPortfolio::literal_num() const
+{
+  return mSolverList[0]->literal_num();
+}
+
+// @brief conflict_limit の最大値
+// @param[in] val 設定する値
+// @return 以前の設定値を返す．
+ymuint64
+SatSolverPortfolio::set_max_conflict(ymuint64 val)
+{
+  ymuint64 old_val = 0;
+  for (ymuint i = 0; i < mSolverList.size(); ++ i) {
+    ymuint64 old_val1 = mSolverList[i]->set_max_conflict(val);
+    if ( i == 0 ) {
+      old_val = old_val1;
+    }
+  }
+  return old_val;
+}
+
+// @brief solve() 中のリスタートのたびに呼び出されるメッセージハンドラの登録
+// @param[in] msg_handler 登録するメッセージハンドラ
+void
+SatSolverPortfolio::reg_msg_handler(SatMsgHandler* msg_handler)
+{
+  mSolverList[0]->reg_msg_handler(msg_handler);
+}
+
+// @brief 時間計測機能を制御する
+void
+SatSolverPortfolio::timer_on(bool enable)
+{
+  for (vector<SatSolverImpl*>::iterator p = mSolverList.begin();
+       p != mSolverList.end(); ++ p) {
+    (*p)->timer_on(enable);
+  }
+}
+
+END_NAMESPACE_YM_SAT
@@ -0,0 +1,255 @@
+#ifndef LIBYM_SAT_SATSOLVERPORTFOLIO_H
+#define LIBYM_SAT_SATSOLVERPORTFOLIO_H
+
+/// @file libym_sat/SatSolverPortfolio.h
+/// @brief SatSolverPortfolio のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ym_sat/SatSolver.h"
+
+#include <pthread.h>
+
+
+BEGIN_NAMESPACE_YM_SAT
+
+class SatSolverImpl;
+class SatClauseShare;
+
+//////////////////////////////////////////////////////////////////////
+/// @class SatSolverPortfolio SatSolverPortfolio.h "SatSolverPortfolio.h"
+/// @brief 設定の異なる複数の SatSolverImpl を並列に走らせる SatSolver
+///
+/// 変数や節の追加は全てのソルバに対して同じ順序で行うので
+/// 変数番号は全てのソルバで共通になる．
+/// 節グループは各ソルバの機能を使わずにここで活性化変数を作って
+/// 実現する．(ソルバごとに活性化変数の再利用のされ方が異なると
+/// 変数番号がずれてしまうため)
+/// solve() では 0 番目のソルバをメインスレッドで，残りをそれぞれ
+/// 別のスレッドで動かし，最初に答えを出したソルバの結果を返す．
+/// 短い学習節や LBD の小さい学習節は SatClauseShare を通して
+/// 他のソルバに渡される．
+//////////////////////////////////////////////////////////////////////
+class SatSolverPortfolio :
+  public SatSolver
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] solver_list ソルバのリスト
+  /// @param[in] deterministic 決定的モードの時 true にする．
+  /// @note solver_list の要素の所有権はこのオブジェクトに移る．
+  SatSolverPortfolio(const vector<SatSolverImpl*>& solver_list,
+		     bool deterministic);
+
+  /// @brief デストラクタ
+  virtual
+  ~SatSolverPortfolio();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // SatSolver で定義されている仮想関数
+  //////////////////////////////////////////////////////////////////////
+  
+  /// @brief 正しい状態のときに true を返す．
+  virtual
+  bool
+  sane() const;
+
+  /// @brief 変数を追加する．
+  /// @return 新しい変数番号を返す．
+  /// @note 変数番号は 0 から始まる．
+  virtual
+  tVarId
+  new_var();
+
+  /// @brief 節を追加する．
+  /// @param[in] lits リテラルのベクタ
+  virtual
+  void
+  add_clause(const vector<Literal>& lits);
+
+  /// @brief 節グループを作る．
+  /// @return グループ番号を返す．
+  virtual
+  ymuint
+  new_group();
+
+  /// @brief 節グループに節を追加する．
+  /// @param[in] group グループ番号
+  /// @param[in] lits リテラルのベクタ
+  virtual
+  void
+  add_group_clause(ymuint group,
+		   const vector<Literal>& lits);
+
+  /// @brief 節グループを解放する．
+  /// @param[in] group グループ番号
+  /// @note ポートフォリオ版では活性化変数の再利用は行わない．
+  virtual
+  void
+  release_group(ymuint group);
+
+  /// @brief 新しいスコープを始める．
+  virtual
+  void
+  push();
+
+  /// @brief 直前の push() 以降に追加された節を取り除く．
+  virtual
+  void
+  pop();
+
+  /// @brief 現在のスコープの深さを返す．
+  virtual
+  ymuint
+  scope_level() const;
+
+  /// @brief 変数を凍結する．
+  /// @param[in] var 変数番号
+  /// @param[in] frozen 凍結する時 true，凍結を解く時 false
+  virtual
+  void
+  set_frozen(tVarId var,
+	     bool frozen = true);
+
+  /// @brief SAT 問題を解く．
+  /// @param[in] assumptions あらかじめ仮定する変数の値割り当てリスト
+  /// @param[out] model 充足するときの値の割り当てを格納する配列．
+  /// @retval kB3True 充足した．
+  /// @retval kB3False 充足不能が判明した．
+  /// @retval kB3X わからなかった．
+  /// @note i 番めの変数の割り当て結果は model[i] に入る．
+  virtual
+  Bool3
+  solve(const vector<Literal>& assumptions,
+	vector<Bool3>& model);
+
+  /// @brief 現在の内部状態を得る．
+  /// @param[out] stats 状態を格納する構造体
+  /// @note 直前の solve() で答えを出したソルバの状態を返す．
+  virtual
+  void
+  get_stats(SatStats& stats) const;
+
+  /// @brief 変数の数を得る．
+  virtual
+  ymuint
+  variable_num() const;
+
+  /// @brief 制約節の数を得る．
+  virtual
+  ymuint
+  clause_num() const;
+
+  /// @brief 制約節のリテラルの総数を得る．
+  virtual
+  ymuint
+  literal_num() const;
+
+  /// @brief conflict_limit の最大値
+  /// @param[in] val 設定する値
+  /// @return 以前の設定値を返す．
+  virtual
+  ymuint64
+  set_max_conflict(ymuint64 val);
+
+  /// @brief solve() 中のリスタートのたびに呼び出されるメッセージハンドラの登録
+  /// @param[in] msg_handler 登録するメッセージハンドラ
+  /// @note メインスレッドで動く 0 番目のソルバにだけ登録する．
+  virtual
+  void
+  reg_msg_handler(SatMsgHandler* msg_handler);
+
+  /// @brief 時間計測機能を制御する
+  virtual
+  void
+  timer_on(bool enable);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 各スレッドの仕事
+  struct Task
+  {
+    // 親のポートフォリオ
+    SatSolverPortfolio* mMgr;
+
+    // ソルバの番号
+    ymuint32 mId;
+
+    // スレッド
+    pthread_t mThread;
+
+    // スレッドが生成された時 true となるフラグ
+    bool mStarted;
+
+    // 仮定のリスト
+    const vector<Literal>* mAssumptions;
+
+    // 結果
+    Bool3 mAns;
+
+    // モデル
+    vector<Bool3> mModel;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  // 一つのソルバで solve() を行う．
+  void
+  run(Task& task);
+
+  // スレッドの本体
+  static
+  void*
+  thread_main(void* arg);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ソルバのリスト
+  vector<SatSolverImpl*> mSolverList;
+
+  // 学習節の共有バッファ
+  // ソルバが一つの時は NULL
+  SatClauseShare* mShare;
+
+  // 直前の solve() で答えを出したソルバの番号
+  ymuint32 mLastWinner;
+
+  // 節グループの活性化リテラルの配列
+  // グループ番号をインデックスとする．
+  // 0 番目と解放されたグループは kLiteralX となる．
+  vector<Literal> mGroupLit;
+
+  // 生きている節グループの数
+  ymuint32 mLiveGroupNum;
+
+  // 再利用可能なグループ番号のリスト
+  vector<ymuint> mFreeGroupList;
+
+  // push() で作られた節グループのスタック
+  vector<ymuint> mScopeStack;
+
+};
+
+END_NAMESPACE_YM_SAT
+
+#endif // LIBYM_SAT_SATSOLVERPORTFOLIO_H
@@ -18,7 +18,7 @@
 BEGIN_NAMESPACE_YM_SAT
 
 //////////////////////////////////////////////////////////////////////
-/// @class Watcher ImplInk.h "Watcher.h"
+/// @class Watcher Watcher.h "Watcher.h"
 /// @brief watch literal に関連付けられた節のリストを表すクラス
 ///
 /// (a1 + a2 + a3 + ... an) という節があるとする．
@@ -26,9 +26,14 @@ BEGIN_NAMESPACE_YM_SAT
 /// の割り当てが起こったときに，この節の watch literal の更新を行う
 /// 必要がある．
 /// そのような節のリストを作るためのクラス
+///
+/// 節の中身を参照しなくても済む場合が多いように，節に含まれる
+/// watch literal 以外のリテラルを一つ blocker として持っておく．
+/// blocker が真ならば節は充足しているので何もしなくてよい．
+/// 2リテラル節の場合には節を作らずにもう一方のリテラルを SatReason
+/// として持ち，blocker もそのリテラルとなる．
 //////////////////////////////////////////////////////////////////////
-class Watcher :
-  public SatReason
+class Watcher
 {
 public:
 
@@ -37,9 +42,37 @@ public:
 
   /// @brief コンストラクタ
   /// @param[in] src もととなる SatReason
-  explicit
-  Watcher(SatReason src);
-  
+  /// @param[in] blocker 節に含まれるリテラル
+  Watcher(SatReason src,
+	  Literal blocker);
+
+
+public:
+
+  /// @brief もととなる SatReason を返す．
+  SatReason
+  reason() const;
+
+  /// @brief blocker を返す．
+  Literal
+  blocker() const;
+
+  /// @brief blocker を設定する．
+  void
+  set_blocker(Literal blocker);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // もととなる SatReason
+  SatReason mReason;
+
+  // blocker
+  Literal mBlocker;
+
 };
 
 
@@ -123,10 +156,37 @@ Watcher::Watcher()
 
 // @brief コンストラクタ
 // @param[in] src もととなる SatReason
+// @param[in] blocker 節に含まれるリテラル
+inline
+Watcher::Watcher(SatReason src,
+		 Literal blocker) :
+  mReason(src),
+  mBlocker(blocker)
+{
+}
+
+// @brief もととなる SatReason を返す．
 inline
-Watcher::Watcher(SatReason src) :
-  SatReason(src)
+SatReason
+Watcher::reason() const
+{
+  return mReason;
+}
+
+// @brief blocker を返す．
+inline
+Literal
+Watcher::blocker() const
+{
+  return mBlocker;
+}
+
+// @brief blocker を設定する．
+inline
+void
+Watcher::set_blocker(Literal blocker)
 {
+  mBlocker = blocker;
 }
 
 // @brief コンストラクタ
@@ -228,4 +288,4 @@ WatcherList::expand(ymuint req_size)
 
 END_NAMESPACE_YM_SAT
 
-#endif // LIBYM_SAT_SATREASON_H
+#endif // LIBYM_SAT_WATCHER_H
@@ -99,10 +99,10 @@ SaBase::check_recur(tVarId varid,
   }
 
   if ( r.is_clause() ) {
-    SatClause& clause = r.clause();
-    size_t n = clause.size();
+    SatClause& rclause = clause(r);
+    size_t n = rclause.size();
     for (size_t i = 1; i < n; ++ i) {
-      Literal q = clause.lit(i);
+      Literal q = rclause.lit(i);
       tVarId var1 = q.varid();
       if ( !get_mark(var1) && decision_level(var1) > 0 ) {
 	set_mark(var1, true);
@@ -17,17 +17,19 @@ BEGIN_NAMESPACE_YM_SAT
 
 // @brief SatAnalyzerの派生クラスを生成する．
 // @param[in] option どのクラスを生成するかを決めるオプション文字列
+// @param[in] minimize 学習節の再帰的な最小化を行う時 true にする．
 SatAnalyzer*
-SaFactory::gen_analyzer(const string& option)
+SaFactory::gen_analyzer(const string& option,
+			bool minimize)
 {
   if ( option == "uip1" ) {
-    return new SaUIP1;
+    return new SaUIP1(minimize);
   }
   if ( option == "simple" ) {
     return new SaSimple;
   }
   // default fall-back
-  return new SaUIP1;
+  return new SaUIP1(minimize);
 }
 
 END_NAMESPACE_YM_SAT
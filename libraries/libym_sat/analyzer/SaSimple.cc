@@ -46,7 +46,7 @@ SaSimple::capture(SatReason creason,
   size_t last = last_assign();
   for ( ; ; ) {
     if ( creason.is_clause() ) {
-      SatClause& cclause = creason.clause();
+      SatClause& cclause = clause(creason);
 
       // cclause が学習節なら activity をあげる．
       if ( cclause.is_learnt() ) {
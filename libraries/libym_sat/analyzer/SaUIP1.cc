@@ -17,7 +17,9 @@
 BEGIN_NAMESPACE_YM_SAT
 
 // @brief コンストラクタ
-SaUIP1::SaUIP1()
+// @param[in] minimize 学習節の再帰的な最小化を行う時 true にする．
+SaUIP1::SaUIP1(bool minimize) :
+  mMinimize(minimize)
 {
 }
 
@@ -32,7 +34,12 @@ SaUIP1::analyze(SatReason creason,
 		vector<Literal>& learnt)
 {
   capture(creason, learnt);
-  simplify(learnt);
+  if ( mMinimize ) {
+    minimize(learnt);
+  }
+  else {
+    simplify(learnt);
+  }
   clear_marks();
   return reorder(learnt);
 }
@@ -53,7 +60,7 @@ SaUIP1::capture(SatReason creason,
   size_t last = last_assign();
   for ( ; ; ) {
     if ( creason.is_clause() ) {
-      SatClause& cclause = creason.clause();
+      SatClause& cclause = clause(creason);
 
       // cclause が学習節なら activity をあげる．
       if ( cclause.is_learnt() ) {
@@ -123,4 +130,93 @@ SaUIP1::capture(SatReason creason,
   }
 }
 
+// learnt から他のリテラルによって含意されるリテラルを取り除く．
+// SaBase::simplify() と異なり，含意されていることがわかった変数の
+// マークは clear_marks() まで残すので同じ変数を二度調べることはない．
+// また，learnt[0] (UIP) は必ず残す．
+void
+SaUIP1::minimize(vector<Literal>& learnt)
+{
+  size_t nl = learnt.size();
+  // learnt に含まれているリテラルのレベルのビットマップ
+  // ただし 32 のモジュロをとっている．
+  ymuint32 lmask = 0U;
+  for (size_t i = 1; i < nl; ++ i) {
+    Literal p = learnt[i];
+    lmask |= (1U << (decision_level(p.varid()) & 31));
+  }
+  size_t wpos = 1;
+  for (size_t i = 1; i < nl; ++ i) {
+    Literal p = learnt[i];
+    if ( reason(p.varid()) == kNullSatReason || !is_redundant(p, lmask) ) {
+      learnt[wpos] = p;
+      ++ wpos;
+    }
+  }
+  if ( wpos < nl ) {
+    learnt.erase(learnt.begin() + wpos, learnt.end());
+  }
+}
+
+// lit が learnt に含まれる他のリテラルによって含意されている時
+// true を返す．
+// lit の割り当て理由を再帰的にたどって，マークの付いていない決定割り当て
+// か lmask に含まれないレベルの割り当てに到達したら false を返す．
+bool
+SaUIP1::is_redundant(Literal lit,
+		     ymuint32 lmask)
+{
+  mStack.clear();
+  mStack.push_back(lit);
+  mMarkList.clear();
+  while ( !mStack.empty() ) {
+    Literal p = mStack.back();
+    mStack.pop_back();
+    SatReason r = reason(p.varid());
+    bool ok = true;
+    if ( r.is_clause() ) {
+      // 理由の節の先頭のリテラルは p 自身なので飛ばす．
+      SatClause& rclause = clause(r);
+      size_t n = rclause.size();
+      for (size_t i = 1; i < n && ok; ++ i) {
+	ok = push_reason(rclause.lit(i), lmask);
+      }
+    }
+    else {
+      ok = push_reason(r.literal(), lmask);
+    }
+    if ( !ok ) {
+      // 今回付けたマークを元に戻す．
+      for (vector<tVarId>::iterator p = mMarkList.begin();
+	   p != mMarkList.end(); ++ p) {
+	set_mark(*p, false);
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+// is_redundant() のサブルーティン
+// q がまだ調べていない含意された割り当てならマークを付けてスタックに積む．
+// q が決定割り当てか lmask に含まれないレベルの割り当てなら false を返す．
+bool
+SaUIP1::push_reason(Literal q,
+		    ymuint32 lmask)
+{
+  tVarId var = q.varid();
+  int level = decision_level(var);
+  if ( get_mark(var) || level == 0 ) {
+    return true;
+  }
+  if ( reason(var) == kNullSatReason ||
+       ((1U << (level & 31)) & lmask) == 0U ) {
+    return false;
+  }
+  set_mark_and_putq(var);
+  mStack.push_back(q);
+  mMarkList.push_back(var);
+  return true;
+}
+
 END_NAMESPACE_YM_SAT
@@ -26,7 +26,9 @@ class SaUIP1 :
 public:
 
   /// @brief コンストラクタ
-  SaUIP1();
+  /// @param[in] minimize 学習節の再帰的な最小化を行う時 true にする．
+  explicit
+  SaUIP1(bool minimize = false);
   
   /// @brief デストラクタ
   virtual
@@ -50,6 +52,39 @@ protected:
   void
   capture(SatReason creason,
 	  vector<Literal>& learnt);
+
+
+private:
+
+  // learnt から他のリテラルによって含意されるリテラルを取り除く．
+  void
+  minimize(vector<Literal>& learnt);
+
+  // lit が learnt に含まれる他のリテラルによって含意されている時
+  // true を返す．
+  bool
+  is_redundant(Literal lit,
+	       ymuint32 lmask);
+
+  // is_redundant() のサブルーティン
+  bool
+  push_reason(Literal q,
+	      ymuint32 lmask);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // minimize() を行う時 true にするフラグ
+  bool mMinimize;
+
+  // is_redundant() で用いるスタック
+  vector<Literal> mStack;
+
+  // is_redundant() でマークを付けた変数のリスト
+  vector<tVarId> mMarkList;
   
 };
 
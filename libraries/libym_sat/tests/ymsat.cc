@@ -352,8 +352,9 @@ main(int argc,
   using namespace std;
   using namespace nsYm;
   
-  if ( argc != 2 ) {
-    cerr << "USAGE : " << argv[0] << " cnf-file" << endl;
+  // 2番目の引数は SatSolverFactory::gen_solver() に渡すオプション文字列
+  if ( argc != 2 && argc != 3 ) {
+    cerr << "USAGE : " << argv[0] << " cnf-file [option]" << endl;
     return 2;
   }
   
@@ -370,7 +371,11 @@ main(int argc,
 #else
     istream& s1 = s;
 #endif
-    SatSolver* solver = SatSolverFactory::gen_solver();
+    string option;
+    if ( argc == 3 ) {
+      option = argv[2];
+    }
+    SatSolver* solver = SatSolverFactory::gen_solver(option);
     
     DimacsParser parser;
     SatDimacsHandler handler(solver);
@@ -408,7 +413,21 @@ main(int argc,
 	 << "propagations      : " << stats.mPropagationNum << endl
 	 << "conflict literals : " << stats.mLearntLitNum << endl
 	 << "CPU time          : " << stats.mTime << endl;
-    
+    // implication() の性能を比較するための指標
+    double usr_time = stats.mTime.usr_time();
+    if ( usr_time > 0.0 ) {
+      cout << "propagations/sec  : "
+	   << static_cast<ymuint64>(stats.mPropagationNum / usr_time) << endl;
+    }
+    if ( stats.mElimVarNum > 0 || stats.mSubsumedNum > 0 ||
+	 stats.mStrengthenedNum > 0 || stats.mProbedUnitNum > 0 ) {
+      cout << "eliminated vars   : " << stats.mElimVarNum << endl
+	   << "subsumed clauses  : " << stats.mSubsumedNum << endl
+	   << "strengthened lits : " << stats.mStrengthenedNum << endl
+	   << "probed units      : " << stats.mProbedUnitNum << endl
+	   << "simplify time     : " << stats.mSimpTime << endl;
+    }
+
     if ( ans == kB3True ) {
       handler.verify(model);
     }
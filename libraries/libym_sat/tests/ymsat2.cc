@@ -95,6 +95,30 @@ skip_until(istream& s,
   }
 }
 
+// 符号なし整数を読み込む．
+ymuint
+read_num(istream& s)
+{
+  int c = s.get();
+  while ( c == ' ' || c == '\t' ) {
+    c = s.get();
+  }
+  if ( c < '0' || c > '9' ) {
+    cerr << "illegal input" << endl;
+    exit(255);
+  }
+  ymuint num = c - '0';
+  while ( s ) {
+    int c = s.peek();
+    if ( c < '0' || c > '9' ) {
+      break;
+    }
+    s.get();
+    num = num * 10 + (c - '0');
+  }
+  return num;
+}
+
 // リテラルのリストを読み込む．
 void
 read_lits(istream& s,
@@ -216,6 +240,8 @@ main(int argc,
     StopWatch sw;
     sw.start();
 
+    // ログ中のグループ番号から実際のグループ番号への対応表
+    hash_map<ymuint, ymuint> group_map;
     while ( s1 ) {
       int c = s1.get();
       if ( c == '\n' ) continue;
@@ -241,6 +267,39 @@ main(int argc,
 	}
 	solver->add_clause(lits);
       }
+      else if ( c == 'G' ) {
+	skip_until(s1, '\n');
+	// ログ中のグループ番号は次のコメント行に書かれている．
+	skip_until(s1, '=');
+	ymuint id = read_num(s1);
+	skip_until(s1, '\n');
+	group_map[id] = solver->new_group();
+      }
+      else if ( c == 'B' ) {
+	ymuint id = read_num(s1);
+	vector<Literal> lits;
+	read_lits(s1, lits);
+	solver->add_group_clause(group_map[id], lits);
+      }
+      else if ( c == 'R' ) {
+	ymuint id = read_num(s1);
+	skip_until(s1, '\n');
+	solver->release_group(group_map[id]);
+      }
+      else if ( c == 'F' ) {
+	ymuint id = read_num(s1);
+	ymuint frozen = read_num(s1);
+	skip_until(s1, '\n');
+	solver->set_frozen(id, frozen != 0);
+      }
+      else if ( c == 'P' ) {
+	skip_until(s1, '\n');
+	solver->push();
+      }
+      else if ( c == 'Q' ) {
+	skip_until(s1, '\n');
+	solver->pop();
+      }
       else if ( c == 'S' ) {
 	vector<Literal> lits;
 	read_lits(s1, lits);
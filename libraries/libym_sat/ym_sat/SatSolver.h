@@ -63,6 +63,21 @@ struct SatStats
   /// @brief 計算時間
   USTime mTime;
 
+  /// @brief 前処理で除去された変数の数
+  ymuint64 mElimVarNum;
+
+  /// @brief 前処理で包含により削除された節の数
+  ymuint64 mSubsumedNum;
+
+  /// @brief 前処理で自己包含により削除されたリテラルの数
+  ymuint64 mStrengthenedNum;
+
+  /// @brief 前処理の failed literal probing で見つかった単位節の数
+  ymuint64 mProbedUnitNum;
+
+  /// @brief 前処理の計算時間
+  USTime mSimpTime;
+
 };
 
 
@@ -140,6 +155,78 @@ public:
   add_clause(Literal lit1,
 	     Literal lit2,
 	     Literal lit3);
+
+
+  //////////////////////////////////////////////////////////////////////
+  /// @name 節グループとスコープ
+  /// @{
+  ///
+  /// 節グループは後で取り除くことのできる節の集まりである．
+  /// 内部的にはグループごとに活性化変数 a を用意して節 C を C + ~a
+  /// の形で追加し，solve() の時に生きているグループの a を assumption
+  /// として加えている．
+  /// release_group() で解放されたグループの節とそれから導かれた
+  /// 学習節は次の solve() の時に物理的に削除され，活性化変数は
+  /// 新しいグループ用に再利用される．
+  /// push() と pop() はこの節グループを用いたスコープで，
+  /// push() 以降に add_clause() で追加された節は対応する pop() で
+  /// 取り除かれる．new_var() で作られた変数はそのまま残る．
+  /// @note 活性化変数も new_var() と同じ番号の空間から割り当てられるので
+  /// variable_num() や solve() の model には活性化変数も含まれる．
+
+  /// @brief 節グループを作る．
+  /// @return グループ番号を返す．
+  /// @note グループ番号は 1 から始まる．解放されたグループの番号は
+  /// 再利用される．
+  virtual
+  ymuint
+  new_group() = 0;
+
+  /// @brief 節グループに節を追加する．
+  /// @param[in] group グループ番号
+  /// @param[in] lits リテラルのベクタ
+  virtual
+  void
+  add_group_clause(ymuint group,
+		   const vector<Literal>& lits) = 0;
+
+  /// @brief 節グループを解放する．
+  /// @param[in] group グループ番号
+  /// @note 以降，group に属する節は制約として扱われない．
+  virtual
+  void
+  release_group(ymuint group) = 0;
+
+  /// @brief 新しいスコープを始める．
+  virtual
+  void
+  push() = 0;
+
+  /// @brief 直前の push() 以降に追加された節を取り除く．
+  virtual
+  void
+  pop() = 0;
+
+  /// @brief 現在のスコープの深さを返す．
+  virtual
+  ymuint
+  scope_level() const = 0;
+
+  /// @}
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 変数を凍結する．
+  /// @param[in] var 変数番号
+  /// @param[in] frozen 凍結する時 true，凍結を解く時 false
+  /// @note 凍結された変数は前処理(オプション simp)で除去されない．
+  /// 除去された変数が後から節や assumption に現れた場合には自動的に
+  /// 復活させるので，凍結しなくても結果は正しいが，後で使う変数を
+  /// 凍結しておけば除去と復活の無駄が省ける．
+  virtual
+  void
+  set_frozen(tVarId var,
+	     bool frozen = true) = 0;
+
   
   /// @brief SAT 問題を解く．
   /// @param[out] model 充足するときの値の割り当てを格納する配列．
@@ -217,6 +304,17 @@ public:
 
   /// @brief 通常の SatSolver を生成する．
   /// @param[in] option ソルバ生成時に渡すオプション文字列
+  /// @note option は空白かカンマで区切られた以下のキーワードの並び
+  /// - uip1, simple : 矛盾の解析方法 (デフォルトは uip1)
+  /// - geometric, luby, glucose : リスタートの方式 (デフォルトは geometric)
+  /// - lbd : 学習節を LBD に基づいて階層的に管理する．
+  /// - phase : 変数の最後の値を次の割り当てに用いる．
+  /// - minimize : 学習節の再帰的な最小化を行う．
+  /// - modern : "luby lbd phase minimize" と同じ
+  /// - simp : solve() の前に SatELite 風の前処理(包含，自己包含，
+  ///   変数除去，failed literal probing)を行う．
+  /// luby と glucose の場合，solve() 一回あたりのコンフリクト数の上限は
+  /// set_max_conflict() の値に達するまで geometric の列を足した値となる．
   static
   SatSolver*
   gen_solver(const string& option = string());
@@ -224,11 +322,28 @@ public:
   /// @brief ログ記録機能付き SatSolver を生成する．
   /// @param[in] out ログの出力先のストリーム
   /// @param[in] option ソルバ生成時に渡すオプション文字列
+  /// @note option の形式は gen_solver() と同じ
   static
   SatSolver*
   gen_recsolver(ostream& out,
 		const string& option = string());
   
+  /// @brief 複数のソルバを並列に走らせる SatSolver を生成する．
+  /// @param[in] n ソルバ(スレッド)の数
+  /// @param[in] deterministic 決定的モードの時 true にする．
+  /// @note 設定の異なる n 個のソルバを別々のスレッドで動かし，
+  /// 最初に答えを出したものの結果を返す．
+  /// 短い学習節と LBD の小さい学習節はソルバ間で共有される．
+  /// @note 決定的モードでは一定のコンフリクト数ごとに全てのソルバが
+  /// 同期して学習節を交換するので，スレッドの実行速度によらず
+  /// 同じ結果(モデルや統計情報も含めて)が得られる．
+  /// その代わり一番遅いソルバに合わせて待つことになる．
+  /// @note get_stats() は直前の solve() で答えを出したソルバの値を返す．
+  static
+  SatSolver*
+  gen_portfolio(ymuint n,
+		bool deterministic = false);
+
   /// @brief MiniSat 版 SatSolver を生成する．
   static
   SatSolver*
@@ -91,6 +91,10 @@ public:
   void
   after_update_faults();
 
+  /// @brief 故障シミュレーションに用いるスレッド数を設定する．
+  void
+  set_fsim_thread_num(ymuint num);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
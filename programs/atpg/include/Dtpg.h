@@ -16,6 +16,7 @@
 #include "dtpgcl_nsdef.h"
 #include "dtpgsat_nsdef.h"
 #include "TvBuff.h"
+#include <pthread.h>
 
 
 BEGIN_NAMESPACE_YM_ATPG
@@ -69,6 +70,36 @@ public:
   /// @brief 計算時間を得る．
   USTime
   time() const;
+
+  /// @brief SAT モードで生成した SAT ソルバの数を得る．
+  ymuint
+  solver_count() const;
+
+  /// @brief SAT モードで CNF の生成に要した時間を得る．
+  USTime
+  cnf_time() const;
+
+  /// @brief SAT モードで SAT ソルバの実行に要した時間を得る．
+  USTime
+  sat_time() const;
+
+  /// @brief 動的圧縮で追加の対象として検出した故障数を得る．
+  ymuint
+  compacted_faults() const;
+
+  /// @brief 前処理で検出不能と判定した故障数を得る．
+  ymuint
+  learned_untestable_faults() const;
+
+  /// @brief 前処理に要した時間を得る．
+  USTime
+  learning_time() const;
+
+  /// @brief 前処理で省いたパタン生成の時間の見積もりを得る．
+  /// @note 本体のパタン生成の1回あたりの平均時間に前処理で
+  /// 検出不能と判定した故障数をかけたもの．
+  USTime
+  saved_time() const;
   
   
 private:
@@ -96,6 +127,27 @@ private:
   
   // 計算時間
   USTime mTime;
+
+  // SAT ソルバの生成回数
+  ymuint mSolverNum;
+
+  // CNF の生成時間
+  USTime mCnfTime;
+
+  // SAT ソルバの実行時間
+  USTime mSatTime;
+
+  // 動的圧縮で検出した故障数
+  ymuint mCompNum;
+
+  // 前処理で検出不能と判定した故障数
+  ymuint mLearnUntestNum;
+
+  // 前処理の時間
+  USTime mLearnTime;
+
+  // 前処理で省いた時間の見積もり
+  USTime mSavedTime;
   
 };
 
@@ -204,6 +256,26 @@ public:
   void
   set_sat_mode(int mode);
 
+  /// @brief FFR ごとに SAT ソルバを使い回すかどうかを指定する．
+  void
+  set_sat_incremental(bool flag);
+
+  /// @brief SAT モードでパタン生成を行うスレッド数を設定する．
+  /// @param[in] num スレッド数 (0 は 1 とみなす)
+  /// @note 2 以上の時は num 個のワーカースレッドがそれぞれ DtpgSat を
+  /// 持って故障を取り出してパタン生成を行い，呼び出し元のスレッドが
+  /// 結果を受け取って故障シミュレーションと故障の状態の更新を行う．
+  /// 構造的手法のパタン生成では用いられない．
+  void
+  set_thread_num(ymuint num);
+
+  /// @brief 検出不能故障の前処理を行うかどうかを指定する．
+  /// @param[in] flag true の時，パタン生成の前に静的学習と正常回路の
+  /// SAT で故障の活性化と FFR 内の伝搬の条件が矛盾する故障を
+  /// 検出不能とする．
+  void
+  set_learning(bool flag);
+
   
 public:
   //////////////////////////////////////////////////////////////////////
@@ -214,12 +286,37 @@ public:
   void
   set_scoping(bool flag);
 
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 生成したパタンに関する制御
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 生成したパタンの X を残すかどうかを指定する．
+  /// @param[in] flag true の時は X を乱数で埋めずに残す．
+  /// @note X を残したパタンは MinPat で併合できる．
+  /// 故障シミュレーションでは X は 0 とみなされる．
+  void
+  set_keep_x(bool flag);
+
+  /// @brief 動的圧縮の制御を行う．
+  /// @param[in] limit 一つのパタンにつき追加の対象とする故障数の上限
+  /// @note limit が 0 の時は動的圧縮を行わない．
+  /// パタンが見つかったら X の入力を SAT で割り当てて他の未検出の
+  /// 故障も検出するように拡張してから X を埋める．
+  void
+  set_compaction(ymuint limit);
+
   
 private:
   //////////////////////////////////////////////////////////////////////
   // 下請け関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 検出不能故障の前処理を行う．
+  void
+  learn_untest();
+
   /// @brief 未検出の故障に対してテストパタン生成を行う．
   /// @param[in] sim_mode シミュレーションモード
   void
@@ -237,6 +334,83 @@ private:
   /// @return パタンを返す．
   TestVector*
   dtpg_sub(SaFault* f);
+
+  /// @brief パタン生成の結果を処理する．
+  /// @param[in] f 対象の故障
+  /// @param[in] stat パタン生成の結果
+  /// @return stat が kDetect の時は mTmpTv をもとにしたパタンを返す．
+  TestVector*
+  after_dtpg(SaFault* f,
+	     tStat stat);
+
+  /// @brief 生成したパタンをシミュレーションモードに従って登録する．
+  void
+  put_pat(TestVector* tv,
+	  tSimMode sim_mode);
+
+  /// @brief mTmpTv を拡張して f 以外の未検出の故障も検出するようにする．
+  /// @param[in] f 最初の対象の故障
+  /// @note 検出した故障は mDetFaults に追加する．
+  void
+  compact(SaFault* f);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // マルチスレッドでのパタン生成に関する関数
+  //////////////////////////////////////////////////////////////////////
+
+  // スレッドごとの作業領域
+  struct Worker
+  {
+    // 親の Dtpg
+    Dtpg* mDtpg;
+
+    // スレッド
+    pthread_t mThread;
+
+    // パタン生成器
+    DtpgSat* mDtpgSat;
+
+    // 生成したパタン
+    TestVector* mTv;
+
+    // 結果を受け渡す故障
+    SaFault* mFault;
+
+    // 結果
+    tStat mStat;
+
+    // 結果が受け取られていない時 true にするフラグ
+    bool mFull;
+
+    // 起動回数
+    ymuint mDtpgNum;
+
+    // バックトラック数
+    ymuint mBtNum;
+  };
+
+  /// @brief ワーカースレッドを用いてパタン生成を行う．
+  /// @param[in] sim_mode シミュレーションモード
+  void
+  dtpg_mt(tSimMode sim_mode);
+
+  /// @brief ワーカーの本体
+  void
+  worker_main(Worker& w);
+
+  /// @brief スレッドの本体
+  static
+  void*
+  thread_main(void* arg);
+
+  /// @brief 処理する故障の範囲を取り出す．
+  /// @param[out] begin, end 範囲
+  /// @retval false 全ての故障を取り出し終えた．
+  bool
+  get_fault_range(ymuint& begin,
+		  ymuint& end);
   
   /// @brief f に対するテストパタン生成を行う．
   /// @return パタンを返す．
@@ -254,6 +428,25 @@ private:
 
   // スコーピングフラグ
   bool mScoping;
+
+  // X を残すフラグ
+  bool mKeepX;
+
+  // 動的圧縮で追加の対象とする故障数の上限
+  ymuint mCompLimit;
+
+  // 動的圧縮で次に調べる remain_list() の位置
+  ymuint mCompPos;
+
+  // パタン生成の対象とする remain_list() の先頭位置
+  // 支配関係で外されていた故障が戻された時はその故障だけを対象にする．
+  ymuint mFirstPos;
+
+  // SAT モードのスレッド数
+  ymuint mThreadNum;
+
+  // 検出不能故障の前処理を行うフラグ
+  bool mLearning;
   
   // 構造に基づいてテストパタン生成を行うクラス
   DtpgCl* mDtpgCl;
@@ -273,9 +466,34 @@ private:
   // テストベクタを格納する作業領域
   TestVector* mTmpTv;
 
+  // 動的圧縮で用いる作業領域
+  TestVector* mCompTv;
+
   // 検出された故障を貯めておくバッファ
   vector<SaFault*> mDetFaults;
 
+  // ワーカーの配列
+  vector<Worker*> mWorkerArray;
+
+  // mCurFaults を取り出す単位の区切りの位置
+  // 最後の要素は mCurFaults.size()
+  vector<ymuint> mGroupArray;
+
+  // 次に取り出す mGroupArray の位置
+  ymuint mNextGroup;
+
+  // 実行中のワーカー数
+  ymuint mActiveNum;
+
+  // ワーカーとの受け渡しに用いる排他制御
+  pthread_mutex_t mMutex;
+
+  // ワーカーが結果を置いたことを知らせる条件変数
+  pthread_cond_t mResultCond;
+
+  // 結果を受け取ったことを知らせる条件変数
+  pthread_cond_t mSlotCond;
+
   // パタン生成用の乱数生成器
   RandGen mPatGen;
 
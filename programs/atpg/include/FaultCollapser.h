@@ -0,0 +1,135 @@
+#ifndef MAIN_FAULTCOLLAPSER_H
+#define MAIN_FAULTCOLLAPSER_H
+
+/// @file include/FaultCollapser.h
+/// @brief FaultCollapser のヘッダファイル
+///
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id: FaultCollapser.h 2203 2009-04-16 05:04:40Z matsunaga $
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "AtpgFunctor.h"
+#include "dtpgsat_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_ATPG
+
+//////////////////////////////////////////////////////////////////////
+/// @class FaultCollapserStats FaultCollapser.h "FaultCollapser.h"
+/// @brief FaultCollapser の statistics data を表すクラス
+//////////////////////////////////////////////////////////////////////
+class FaultCollapserStats
+{
+  friend class FaultCollapser;
+
+public:
+
+  /// @brief コンストラクタ
+  FaultCollapserStats();
+
+  /// @brief デストラクタ
+  ~FaultCollapserStats();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 情報を取得する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 対象から外した故障数を得る．
+  ymuint
+  collapsed_faults() const;
+
+  /// @brief 支配関係を調べた回数を得る．
+  ymuint
+  check_count() const;
+
+  /// @brief 計算時間を得る．
+  USTime
+  time() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象から外した故障数
+  ymuint mCollapsedNum;
+
+  // 支配関係を調べた回数
+  ymuint mCheckNum;
+
+  // 計算時間
+  USTime mTime;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class FaultCollapser FaultCollapser.h "FaultCollapser.h"
+/// @brief 機能的に等価な故障を対象から外すクラス
+/// @note ランダムパタンの故障シミュレーションで検出パタンの等しい
+/// 故障をまとめ，SAT で支配関係を確かめてから FaultMgr に登録する．
+//////////////////////////////////////////////////////////////////////
+class FaultCollapser :
+  public AtpgFunctor
+{
+public:
+
+  /// @brief コンストラクタ
+  FaultCollapser(AtpgMgr* mgr);
+
+  /// @brief デストラクタ
+  virtual
+  ~FaultCollapser();
+
+
+public:
+
+  /// @brief 等価な故障を対象から外す．
+  /// @param[in] round_num 故障シミュレーションの回数
+  /// @note 1回あたり kPvBitLen 個のランダムパタンを用いる．
+  /// 縮退故障のみが対象となる．
+  void
+  operator()(ymuint round_num = 8);
+
+  /// @brief 直前の実行結果を得る．
+  const FaultCollapserStats&
+  stats() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 下請け関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 検出パタンの等しい故障のグループを処理する．
+  /// @param[in] group 故障のグループ
+  void
+  collapse_group(vector<SaFault*>& group);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // パタン生成用の乱数生成器
+  RandGen mPatGen;
+
+  // 支配関係を調べるクラス
+  DtpgSat* mDtpgSat;
+
+  // 実行結果
+  FaultCollapserStats mStats;
+
+};
+
+END_NAMESPACE_YM_ATPG
+
+#endif // MAIN_FAULTCOLLAPSER_H
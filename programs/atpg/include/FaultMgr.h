@@ -39,6 +39,10 @@ public:
   //////////////////////////////////////////////////////////////////////
   // read-only のメソッド
   //////////////////////////////////////////////////////////////////////
+
+  /// @brief 故障モデルを得る．
+  FaultModel
+  model() const;
   
   /// @brief 全ての故障のリストを得る．
   const vector<SaFault*>&
@@ -80,6 +84,19 @@ public:
   ymuint
   untest_num() const;
 
+  /// @brief 支配関係で対象から外されている代表故障のリストを得る．
+  const vector<SaFault*>&
+  collapsed_list() const;
+
+  /// @brief 支配関係で対象から外されている代表故障数を得る．
+  ymuint
+  collapsed_num() const;
+
+  /// @brief 直前の update() で未検出リストに戻された故障数を得る．
+  /// @note 支配する故障が全て検出不能かアボートとなった時に戻される．
+  ymuint
+  released_num() const;
+
   
 public:
   //////////////////////////////////////////////////////////////////////
@@ -93,6 +110,12 @@ public:
   /// @brief network の全ての単一縮退故障を設定する．
   void
   set_ssa_fault(const TgNetwork& network);
+
+  /// @brief network の全ての遷移故障を設定する．
+  /// @note 2時刻め(キャプチャ)の値を1時刻め(ローンチ)の値から
+  /// 求める launch-on-capture 方式を仮定する．
+  void
+  set_tdf_fault(const TgNetwork& network);
   
   /// @brief 出力の故障を追加する．
   /// @param[in] node 対象のノード
@@ -118,6 +141,22 @@ public:
   void
   set_status(SaFault* fault,
 	     FaultStatus stat);
+
+  /// @brief ゲートの支配関係を用いて故障を対象から外す．
+  /// @note 縮退故障のみが対象となる．
+  void
+  collapse();
+
+  /// @brief 支配関係を登録する．
+  /// @param[in] f1 支配する故障
+  /// @param[in] f2 支配される故障
+  /// @return 登録できた時に true を返す．
+  /// @note f2 を検出するパタンは必ず f1 も検出することを仮定する．
+  /// f1 は次の update() で未検出リストから外され，f2 の検出結果で
+  /// 状態が決まる．支配関係が循環する場合は登録しない．
+  bool
+  add_dominance(SaFault* f1,
+		SaFault* f2);
   
   /// @brief 故障リストをスキャンして未検出リストを更新する．
   void
@@ -128,6 +167,10 @@ private:
   //////////////////////////////////////////////////////////////////////
   // 下請け関数
   //////////////////////////////////////////////////////////////////////
+
+  /// @brief mModel の故障を全て生成して代表故障を登録する．
+  void
+  make_faults(const TgNetwork& network);
   
   /// @brief node に関する故障を登録する．
   void
@@ -144,6 +187,16 @@ private:
 	    ymuint pos,
 	    int val);
   
+  /// @brief 支配関係で対象から外した故障の状態を決める．
+  /// @note 未検出リストに戻した故障は mRemainList の末尾に追加する．
+  void
+  resolve_collapsed();
+
+  /// @brief f2 から支配関係をたどって f1 に到達できる時 true を返す．
+  bool
+  reach_proxy(SaFault* f2,
+	      SaFault* f1);
+  
   /// @brief 出力の故障を取り出す．
   /// @param[in] node 対象のノード
   /// @param[in] val 縮退している値
@@ -206,6 +259,9 @@ private:
   
   // 関連付けられているネットワーク
   const TgNetwork* mNetwork;
+
+  // 故障モデル
+  FaultModel mModel;
   
   // ノードごとの故障の情報
   vector<Fnode> mFnodeArray;
@@ -224,6 +280,12 @@ private:
 
   // 検出不能故障を保持しておくリスト
   vector<SaFault*> mUntestList;
+
+  // 支配関係で対象から外した故障を保持しておくリスト
+  vector<SaFault*> mCollapsedList;
+
+  // 直前の update() で未検出リストに戻した故障数
+  ymuint mReleasedNum;
   
   // 故障リストに変化があったことを記録するフラグ
   bool mChanged;
@@ -235,6 +297,14 @@ private:
 // インライン関数の定義
 //////////////////////////////////////////////////////////////////////
 
+// @brief 故障モデルを得る．
+inline
+FaultModel
+FaultMgr::model() const
+{
+  return mModel;
+}
+
 // @brief 全ての故障のリストを得る．
 inline
 const vector<SaFault*>&
@@ -315,6 +385,30 @@ FaultMgr::untest_num() const
   return mUntestList.size();
 }
 
+// @brief 支配関係で対象から外されている代表故障のリストを得る．
+inline
+const vector<SaFault*>&
+FaultMgr::collapsed_list() const
+{
+  return mCollapsedList;
+}
+
+// @brief 支配関係で対象から外されている代表故障数を得る．
+inline
+ymuint
+FaultMgr::collapsed_num() const
+{
+  return mCollapsedList.size();
+}
+
+// @brief 直前の update() で未検出リストに戻された故障数を得る．
+inline
+ymuint
+FaultMgr::released_num() const
+{
+  return mReleasedNum;
+}
+
 // @brief 出力の故障を追加する．
 inline
 SaFault*
@@ -1,7 +1,7 @@
 #ifndef MAIN_MINPAT_H
 #define MAIN_MINPAT_H
 
-/// @file src/main/MinPat.h
+/// @file include/MinPat.h
 /// @brief MinPat のヘッダファイル
 ///
 /// @author Yusuke Matsunaga (松永 裕介)
@@ -17,6 +17,18 @@
 
 BEGIN_NAMESPACE_YM_ATPG
 
+/// @brief 逆順の故障シミュレーションで不要なパタンを取り除く．
+const ymuint kMinPatReverse = 1U;
+
+/// @brief ランダムな順序の故障シミュレーションで不要なパタンを取り除く．
+const ymuint kMinPatRandom  = 2U;
+
+/// @brief X を含む両立するパタンを併合する．
+const ymuint kMinPatMerge   = 4U;
+
+/// @brief 全ての手法を用いる．
+const ymuint kMinPatAll     = kMinPatReverse | kMinPatRandom | kMinPatMerge;
+
 //////////////////////////////////////////////////////////////////////
 /// @class MinPatStats MinPat.h "MinPat.h"
 /// @brief MinPat の statistics data を表すクラス
@@ -89,19 +101,57 @@ public:
 public:
   
   /// @brief テストベクタの最小化を行う．
-  /// @param[in] mode 最小化モード
+  /// @param[in] mode 最小化モード (kMinPatReverse などの論理和)
+  /// @param[in] rand_iter ランダムな順序の故障シミュレーションの回数
+  /// @note 検出済みの代表故障が全て検出されるように _tv_list() を
+  /// 置き換える．
   void
-  operator()(ymuint mode);
+  operator()(ymuint mode,
+	     ymuint rand_iter = 10);
   
   /// @brief 直前の実行結果を得る．
   const MinPatStats&
   stats() const;
 
   
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 下請け関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 3値の故障シミュレーションで不要なパタンを取り除く．
+  /// @param[inout] tv_list 対象のパタンのリスト
+  /// @note 後ろのパタンから順にシミュレーションを行う．
+  void
+  drop_by_fsim3(vector<TestVector*>& tv_list);
+
+  /// @brief 両立するパタンを併合する．
+  /// @param[inout] tv_list 対象のパタンのリスト
+  void
+  merge(vector<TestVector*>& tv_list);
+
+  /// @brief 故障シミュレーションで不要なパタンを取り除く．
+  /// @param[inout] tv_list 対象のパタンのリスト
+  /// @note 前から順に，最初に検出したパタンに故障を割り当てて，
+  /// 一つも故障が割り当てられなかったパタンを取り除く．
+  void
+  drop_by_fsim(vector<TestVector*>& tv_list);
+
+  /// @brief 対象の故障の状態を未検出に戻す．
+  void
+  reset_faults();
+
+  
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
+
+  // 対象の故障のリスト
+  vector<SaFault*> mFaultList;
+
+  // X を埋めたり順序を入れ替えるための乱数生成器
+  RandGen mRandGen;
   
   // 実行結果
   MinPatStats mStats;
@@ -2,9 +2,9 @@
 #define PACKEDVAL_H
 
 /// @file PackedVal.h
-/// @brief 1ワードにパックしたビットベクタ型の定義ファイル
+/// @brief 複数ワードにパックしたビットベクタ型の定義ファイル
 /// @author Yusuke Matsunaga (松永 裕介)
-/// 
+///
 /// $Id: PackedVal.h 2043 2009-02-21 07:08:48Z matsunaga $
 ///
 /// Copyright (C) 2005-2010 Yusuke Matsunaga
@@ -13,21 +13,182 @@
 #include "atpg_nsdef.h"
 
 
+/// @brief PackedVal を構成するワード数
+/// @note configure の --with-pv-words で指定する．
+/// 1, 2, 4, 8 のいずれかでなければならない．
+#ifndef ATPG_PV_WORD_NUM
+#define ATPG_PV_WORD_NUM 4
+#endif
+
+#if ATPG_PV_WORD_NUM != 1 && ATPG_PV_WORD_NUM != 2 && \
+    ATPG_PV_WORD_NUM != 4 && ATPG_PV_WORD_NUM != 8
+#error "ATPG_PV_WORD_NUM must be 1, 2, 4 or 8"
+#endif
+
+// gcc のベクタ拡張が使える時はそれを用いる．
+// 実際に使われる命令(SSE2/AVX2/AVX-512)はコンパイラの -m オプション
+// (configure の --enable-simd) で決まる．
+// new で確保した領域に置かれても良いようにアラインメントは
+// ワード単位に緩めてある．
+#if defined(__GNUC__) && ATPG_PV_WORD_NUM > 1
+#define ATPG_PV_USE_VECTOR 1
+#else
+#define ATPG_PV_USE_VECTOR 0
+#endif
+
+
 BEGIN_NAMESPACE_YM_ATPG
 
 //////////////////////////////////////////////////////////////////////
-/// @brief 1ワードのビットベクタを表す型
+/// @brief PackedVal を構成する1ワードの型
 //////////////////////////////////////////////////////////////////////
-typedef ymulong PackedVal;
+typedef ymulong PvWord;
 
-/// @brief 全てのビットが0の定数
-const PackedVal kPvAll0 = 0UL;
+/// @brief PvWord のビット長
+const ymuint kPvWordBitLen = SIZEOF_UNSIGNED_LONG * 8;
 
-/// @brief 全てのビットが1の定数
-const PackedVal kPvAll1 = ~0UL;
+/// @brief PackedVal のワード数
+const ymuint kPvWordNum = ATPG_PV_WORD_NUM;
 
 /// @brief PackedVal のビット長
-const size_t kPvBitLen = SIZEOF_UNSIGNED_LONG * 8;
+const ymuint kPvBitLen = kPvWordBitLen * kPvWordNum;
+
+
+#if ATPG_PV_USE_VECTOR
+/// @brief PackedVal の内部表現に用いるベクタ型
+typedef PvWord PvVec
+__attribute__((vector_size(ATPG_PV_WORD_NUM * SIZEOF_UNSIGNED_LONG),
+	       aligned(SIZEOF_UNSIGNED_LONG)));
+#endif
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class PackedVal PackedVal.h "PackedVal.h"
+/// @brief kPvBitLen ビットのビットベクタを表すクラス
+/// @note 並列シミュレーションの1ビットが1パタン(もしくは1故障)に対応する．
+//////////////////////////////////////////////////////////////////////
+class PackedVal
+{
+public:
+
+  /// @brief 空のコンストラクタ
+  /// @note 内容は不定
+  PackedVal();
+
+  /// @brief 全てのワードを word にするコンストラクタ
+  explicit
+  PackedVal(PvWord word);
+
+
+public:
+
+  /// @brief pos 番めのワードを得る．
+  PvWord
+  word(ymuint pos) const;
+
+  /// @brief pos 番めのワードを設定する．
+  void
+  set_word(ymuint pos,
+	   PvWord word);
+
+  /// @brief pos 番めのビットが 1 の時 true を返す．
+  bool
+  bit(ymuint pos) const;
+
+  /// @brief pos 番めのビットを 1 にする．
+  void
+  set_bit(ymuint pos);
+
+  /// @brief 1 のビットを含む時 true を返す．
+  bool
+  any() const;
+
+
+public:
+
+  /// @brief 否定演算子
+  PackedVal
+  operator~() const;
+
+  /// @brief AND代入演算子
+  const PackedVal&
+  operator&=(const PackedVal& opr);
+
+  /// @brief OR代入演算子
+  const PackedVal&
+  operator|=(const PackedVal& opr);
+
+  /// @brief XOR代入演算子
+  const PackedVal&
+  operator^=(const PackedVal& opr);
+
+  /// @brief 等価比較演算子
+  bool
+  operator==(const PackedVal& opr) const;
+
+  /// @brief 非等価比較演算子
+  bool
+  operator!=(const PackedVal& opr) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  union {
+#if ATPG_PV_USE_VECTOR
+    // ベクタ型としての本体
+    PvVec mVec;
+#endif
+    // ワードの配列としての本体
+    PvWord mWord[kPvWordNum];
+  };
+
+};
+
+/// @relates PackedVal
+/// @brief AND 演算子
+PackedVal
+operator&(const PackedVal& opr1,
+	  const PackedVal& opr2);
+
+/// @relates PackedVal
+/// @brief OR 演算子
+PackedVal
+operator|(const PackedVal& opr1,
+	  const PackedVal& opr2);
+
+/// @relates PackedVal
+/// @brief XOR 演算子
+PackedVal
+operator^(const PackedVal& opr1,
+	  const PackedVal& opr2);
+
+/// @relates PackedVal
+/// @brief pos 番めのビットだけが 1 のビットベクタを返す．
+PackedVal
+pv_bit(ymuint pos);
+
+/// @relates PackedVal
+/// @brief 最下位の 1 のビットの位置を返す．
+/// @note val は 0 であってはならない．
+ymuint
+first_one(const PackedVal& val);
+
+
+/// @relates PackedVal
+/// @brief 内容を上位のワードから順に出力する．
+ostream&
+operator<<(ostream& s,
+	   const PackedVal& val);
+
+
+/// @brief 全てのビットが0の定数
+const PackedVal kPvAll0(0UL);
+
+/// @brief 全てのビットが1の定数
+const PackedVal kPvAll1(~0UL);
 
 
 /// @brief word 中の1のビット数を数える．
@@ -35,7 +196,7 @@ const size_t kPvBitLen = SIZEOF_UNSIGNED_LONG * 8;
 /// @return word 中の1のビット数
 inline
 size_t
-count_ones(PackedVal word)
+count_ones(PvWord word)
 {
 #if SIZEOF_UNSIGNED_LONG == 4
   const size_t mask1   = 0x55555555;
@@ -75,11 +236,245 @@ count_ones(PackedVal word)
     }
     word >>= 1;
   }
-  return word;
+  return c;
 #endif
 #endif
 }
 
+/// @brief val 中の1のビット数を数える．
+/// @param[in] val 対象のビットベクタ
+/// @return val 中の1のビット数
+inline
+size_t
+count_ones(const PackedVal& val)
+{
+  size_t c = 0;
+  for (ymuint i = 0; i < kPvWordNum; ++ i) {
+    c += count_ones(val.word(i));
+  }
+  return c;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 空のコンストラクタ
+inline
+PackedVal::PackedVal()
+{
+}
+
+// @brief 全てのワードを word にするコンストラクタ
+inline
+PackedVal::PackedVal(PvWord word)
+{
+  for (ymuint i = 0; i < kPvWordNum; ++ i) {
+    mWord[i] = word;
+  }
+}
+
+// @brief pos 番めのワードを得る．
+inline
+PvWord
+PackedVal::word(ymuint pos) const
+{
+  return mWord[pos];
+}
+
+// @brief pos 番めのワードを設定する．
+inline
+void
+PackedVal::set_word(ymuint pos,
+		    PvWord word)
+{
+  mWord[pos] = word;
+}
+
+// @brief pos 番めのビットが 1 の時 true を返す．
+inline
+bool
+PackedVal::bit(ymuint pos) const
+{
+  return (mWord[pos / kPvWordBitLen] >> (pos % kPvWordBitLen)) & 1UL;
+}
+
+// @brief pos 番めのビットを 1 にする．
+inline
+void
+PackedVal::set_bit(ymuint pos)
+{
+  mWord[pos / kPvWordBitLen] |= (1UL << (pos % kPvWordBitLen));
+}
+
+// @brief 1 のビットを含む時 true を返す．
+inline
+bool
+PackedVal::any() const
+{
+  PvWord tmp = mWord[0];
+  for (ymuint i = 1; i < kPvWordNum; ++ i) {
+    tmp |= mWord[i];
+  }
+  return tmp != 0UL;
+}
+
+// @brief 否定演算子
+inline
+PackedVal
+PackedVal::operator~() const
+{
+  PackedVal ans;
+#if ATPG_PV_USE_VECTOR
+  ans.mVec = ~mVec;
+#else
+  for (ymuint i = 0; i < kPvWordNum; ++ i) {
+    ans.mWord[i] = ~mWord[i];
+  }
+#endif
+  return ans;
+}
+
+// @brief AND代入演算子
+inline
+const PackedVal&
+PackedVal::operator&=(const PackedVal& opr)
+{
+#if ATPG_PV_USE_VECTOR
+  mVec &= opr.mVec;
+#else
+  for (ymuint i = 0; i < kPvWordNum; ++ i) {
+    mWord[i] &= opr.mWord[i];
+  }
+#endif
+  return *this;
+}
+
+// @brief OR代入演算子
+inline
+const PackedVal&
+PackedVal::operator|=(const PackedVal& opr)
+{
+#if ATPG_PV_USE_VECTOR
+  mVec |= opr.mVec;
+#else
+  for (ymuint i = 0; i < kPvWordNum; ++ i) {
+    mWord[i] |= opr.mWord[i];
+  }
+#endif
+  return *this;
+}
+
+// @brief XOR代入演算子
+inline
+const PackedVal&
+PackedVal::operator^=(const PackedVal& opr)
+{
+#if ATPG_PV_USE_VECTOR
+  mVec ^= opr.mVec;
+#else
+  for (ymuint i = 0; i < kPvWordNum; ++ i) {
+    mWord[i] ^= opr.mWord[i];
+  }
+#endif
+  return *this;
+}
+
+// @brief 等価比較演算子
+inline
+bool
+PackedVal::operator==(const PackedVal& opr) const
+{
+  PackedVal tmp(*this);
+  tmp ^= opr;
+  return !tmp.any();
+}
+
+// @brief 非等価比較演算子
+inline
+bool
+PackedVal::operator!=(const PackedVal& opr) const
+{
+  return !operator==(opr);
+}
+
+// @relates PackedVal
+// @brief AND 演算子
+inline
+PackedVal
+operator&(const PackedVal& opr1,
+	  const PackedVal& opr2)
+{
+  return PackedVal(opr1).operator&=(opr2);
+}
+
+// @relates PackedVal
+// @brief OR 演算子
+inline
+PackedVal
+operator|(const PackedVal& opr1,
+	  const PackedVal& opr2)
+{
+  return PackedVal(opr1).operator|=(opr2);
+}
+
+// @relates PackedVal
+// @brief XOR 演算子
+inline
+PackedVal
+operator^(const PackedVal& opr1,
+	  const PackedVal& opr2)
+{
+  return PackedVal(opr1).operator^=(opr2);
+}
+
+// @relates PackedVal
+// @brief pos 番めのビットだけが 1 のビットベクタを返す．
+inline
+PackedVal
+pv_bit(ymuint pos)
+{
+  PackedVal ans(0UL);
+  ans.set_bit(pos);
+  return ans;
+}
+
+// @relates PackedVal
+// @brief 最下位の 1 のビットの位置を返す．
+// @note val は 0 であってはならない．
+inline
+ymuint
+first_one(const PackedVal& val)
+{
+  for (ymuint i = 0; i < kPvWordNum; ++ i) {
+    PvWord w = val.word(i);
+    if ( w != 0UL ) {
+      ymuint pos = i * kPvWordBitLen;
+      for ( ; (w & 1UL) == 0UL; ++ pos, w >>= 1) ;
+      return pos;
+    }
+  }
+  assert_not_reached(__FILE__, __LINE__);
+  return 0;
+}
+
+// @relates PackedVal
+// @brief 内容を上位のワードから順に出力する．
+inline
+ostream&
+operator<<(ostream& s,
+	   const PackedVal& val)
+{
+  for (ymuint i = kPvWordNum; i -- > 0; ) {
+    s << val.word(i);
+    if ( i > 0 ) {
+      s << "_";
+    }
+  }
+  return s;
+}
+
 END_NAMESPACE_YM_ATPG
 
 #endif // PACKEDVAL_H
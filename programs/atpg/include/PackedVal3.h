@@ -31,12 +31,12 @@ public:
   /// @brief コンストラクタ
   /// @param[in] pat0 0 を表すビットベクタ
   /// @param[in] pat1 1 を表すビットベクタ
-  PackedVal3(PackedVal pat0,
-	     PackedVal pat1);
+  PackedVal3(const PackedVal& pat0,
+	     const PackedVal& pat1);
   
   /// @brief PackedVal からのキャスト演算子
   explicit
-  PackedVal3(PackedVal pat);
+  PackedVal3(const PackedVal& pat);
   
   /// @brief デストラクタ
   ~PackedVal3();
@@ -48,17 +48,17 @@ public:
   /// @param[in] pat0 0 を表すビットベクタ
   /// @param[in] pat1 1 を表すビットベクタ
   void
-  set(PackedVal pat0,
-      PackedVal pat1);
+  set(const PackedVal& pat0,
+      const PackedVal& pat1);
 
   /// @brief 2値の値からセットする．
   void
-  set(PackedVal pat);
+  set(const PackedVal& pat);
   
   /// @brief マスク付きでセットする．
   void
   set_with_mask(const PackedVal3& src,
-		PackedVal mask);
+		const PackedVal& mask);
   
   /// @brief 0 を表すビットベクタを取り出す．
   PackedVal
@@ -163,7 +163,7 @@ operator^(const PackedVal3& opr1,
 /// @param[in] opr1, opr2, opr3 オペランド
 /// @note if ( opr1 ) then opr2 else opr3 の計算を行う．
 PackedVal3
-ite(PackedVal opr1,
+ite(const PackedVal& opr1,
     const PackedVal3& opr2,
     const PackedVal3& opr3);
 
@@ -183,8 +183,8 @@ PackedVal3::PackedVal3()
 // @param[in] pat0 0 を表すビットベクタ
 // @param[in] pat1 1 を表すビットベクタ
 inline
-PackedVal3::PackedVal3(PackedVal pat0,
-		       PackedVal pat1) :
+PackedVal3::PackedVal3(const PackedVal& pat0,
+		       const PackedVal& pat1) :
   mPat0(pat0),
   mPat1(pat1)
 {
@@ -192,7 +192,7 @@ PackedVal3::PackedVal3(PackedVal pat0,
   
 // @brief PackedVal からのキャスト演算子
 inline
-PackedVal3::PackedVal3(PackedVal pat) :
+PackedVal3::PackedVal3(const PackedVal& pat) :
   mPat0(~pat),
   mPat1(pat)
 {
@@ -209,8 +209,8 @@ PackedVal3::~PackedVal3()
 // @param[in] pat1 1 を表すビットベクタ
 inline
 void
-PackedVal3::set(PackedVal pat0,
-		PackedVal pat1)
+PackedVal3::set(const PackedVal& pat0,
+		const PackedVal& pat1)
 {
   mPat0 = pat0;
   mPat1 = pat1;
@@ -219,7 +219,7 @@ PackedVal3::set(PackedVal pat0,
 // @brief 2値の値からセットする．
 inline
 void
-PackedVal3::set(PackedVal pat)
+PackedVal3::set(const PackedVal& pat)
 {
   mPat0 = ~pat;
   mPat1 = pat;
@@ -229,7 +229,7 @@ PackedVal3::set(PackedVal pat)
 inline
 void
 PackedVal3::set_with_mask(const PackedVal3& src,
-			  PackedVal mask)
+			  const PackedVal& mask)
 {
   mPat0 &= ~mask;
   mPat0 |= src.mPat0 & mask;
@@ -411,7 +411,7 @@ operator^(const PackedVal3& opr1,
 // @note if ( opr1 ) then opr2 else opr3 の計算を行う．
 inline
 PackedVal3
-ite(PackedVal opr1,
+ite(const PackedVal& opr1,
     const PackedVal3& opr2,
     const PackedVal3& opr3)
 {
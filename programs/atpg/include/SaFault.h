@@ -36,6 +36,17 @@ enum FaultStatus {
 };
 
 
+//////////////////////////////////////////////////////////////////////
+/// @brief 故障モデル
+//////////////////////////////////////////////////////////////////////
+enum FaultModel {
+  /// @brief 単一縮退故障
+  kFmStuckAt,
+  /// @brief 遷移故障 (launch-on-capture)
+  kFmTransition
+};
+
+
 //////////////////////////////////////////////////////////////////////
 /// @class Finfo Finfo.h "Finfo.h"
 /// @brief 等価故障グループに共通の情報を表すクラス
@@ -76,6 +87,11 @@ public:
   FaultStatus
   status() const;
 
+  /// @brief 検出を代わりに調べる故障のリストを返す．
+  /// @note 支配関係で対象から外されていない時は空となる．
+  const vector<SaFault*>&
+  proxy_list() const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -104,6 +120,10 @@ private:
   
   // 状態
   FaultStatus mStatus;
+
+  // この故障が支配する故障のリスト
+  // どれか一つが検出されればこの故障も検出される．
+  vector<SaFault*> mProxyList;
   
 };
 
@@ -111,6 +131,9 @@ private:
 //////////////////////////////////////////////////////////////////////
 /// @class SaFault SaFault.h "SaFault.h"
 /// @brief 単一縮退故障を表すクラス
+/// @note 遷移故障も同じクラスで表す．遷移故障の場合，故障値は
+/// 2時刻めに故障箇所が留まっている値を表す．
+/// つまり 0 が slow-to-rise, 1 が slow-to-fall となる．
 //////////////////////////////////////////////////////////////////////
 class SaFault
 {
@@ -123,10 +146,12 @@ private:
   /// @param[in] output 入力の故障のとき false, 出力の故障のとき true を与える．
   /// @param[in] pos 故障位置
   /// @param[in] val 故障値 0 か非0 で 0/1 を区別する．
+  /// @param[in] model 故障モデル
   SaFault(const TgNode* node,
 	  bool output,
 	  ymuint pos,
-	  int val);
+	  int val,
+	  FaultModel model = kFmStuckAt);
 
   /// @brief デストラクタ
   ~SaFault();
@@ -165,6 +190,10 @@ public:
   /// @brief 故障値を3値型で返す．
   Val3
   val3() const;
+
+  /// @brief 故障モデルを返す．
+  FaultModel
+  model() const;
   
   /// @brief 故障の内容を表す文字列を返す．
   string
@@ -186,6 +215,10 @@ public:
   /// @param[in] pos 位置番号 ( 0 <= pos < pat_num() )
   TestVector*
   pat(ymuint pos = 0) const;
+
+  /// @brief 支配関係で対象から外されている時 true を返す．
+  bool
+  is_collapsed() const;
   
   
 private:
@@ -196,7 +229,7 @@ private:
   // 対象のノード
   const TgNode* mNode;
 
-  // 故障位置と故障値をパックしたもの
+  // 故障位置と故障値と故障モデルをパックしたもの
   ymuint32 mPosVal;
 
   // 等価故障グループに共通の情報
@@ -287,6 +320,14 @@ Finfo::status() const
   return mStatus;
 }
 
+// @brief 検出を代わりに調べる故障のリストを返す．
+inline
+const vector<SaFault*>&
+Finfo::proxy_list() const
+{
+  return mProxyList;
+}
+
 // @brief 対象のゲートを返す．
 inline
 const TgNode*
@@ -341,6 +382,14 @@ SaFault::val3() const
   }
 }
 
+// @brief 故障モデルを返す．
+inline
+FaultModel
+SaFault::model() const
+{
+  return ((mPosVal >> 2) & 1UL) ? kFmTransition : kFmStuckAt;
+}
+
 // @brief 代表故障を返す．
 inline
 SaFault*
@@ -374,6 +423,14 @@ SaFault::pat(ymuint pos) const
   return mFinfo->pat(pos);
 }
 
+// @brief 支配関係で対象から外されている時 true を返す．
+inline
+bool
+SaFault::is_collapsed() const
+{
+  return !mFinfo->proxy_list().empty();
+}
+
 END_NAMESPACE_YM_ATPG
 
 #endif // ATPG_SAFAULT_H
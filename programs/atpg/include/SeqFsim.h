@@ -0,0 +1,146 @@
+#ifndef MAIN_SEQFSIM_H
+#define MAIN_SEQFSIM_H
+
+/// @file include/SeqFsim.h
+/// @brief SeqFsim のヘッダファイル
+///
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id: SeqFsim.h 2203 2009-04-16 05:04:40Z matsunaga $
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "AtpgFunctor.h"
+
+
+BEGIN_NAMESPACE_YM_ATPG
+
+//////////////////////////////////////////////////////////////////////
+/// @class SeqFsimStats SeqFsim.h "SeqFsim.h"
+/// @brief SeqFsim の statistics data を表すクラス
+//////////////////////////////////////////////////////////////////////
+class SeqFsimStats
+{
+  friend class SeqFsim;
+
+public:
+
+  /// @brief コンストラクタ
+  SeqFsimStats();
+
+  /// @brief デストラクタ
+  ~SeqFsimStats();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 情報を取得する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 検出した故障数を得る．
+  ymuint
+  detected_faults() const;
+
+  /// @brief テスト系列の長さ(時刻数)を得る．
+  ymuint
+  frame_num() const;
+
+  /// @brief 最後に故障を検出した時刻を得る．
+  /// @note 故障を検出しなかった時は 0 を返す．
+  /// @note 時刻は 1 から数える．
+  ymuint
+  last_effective_frame() const;
+
+  /// @brief 計算時間を得る．
+  USTime
+  time() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 検出した故障数
+  ymuint mDetectNum;
+
+  // テスト系列の長さ
+  ymuint mFrameNum;
+
+  // 最後に故障を検出した時刻
+  ymuint mLastFrame;
+
+  // 計算時間
+  USTime mTime;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class SeqFsim SeqFsim.h "SeqFsim.h"
+/// @brief テスト系列を読み込んで順序回路の故障シミュレーションを行うクラス
+/// @note テスト系列は1行に1時刻分の外部入力の値を 0, 1, X の並びで
+/// 書いたもの．X は 0 とみなす．空行と '#' で始まる行は読み飛ばす．
+/// 最初のテストベクタより前に "init" に続けて FF の数の値を書くと
+/// FF の初期状態になる．省略した時は全て 0 とする．
+//////////////////////////////////////////////////////////////////////
+class SeqFsim :
+  public AtpgFunctor
+{
+public:
+
+  /// @brief コンストラクタ
+  SeqFsim(AtpgMgr* mgr);
+
+  /// @brief デストラクタ
+  virtual
+  ~SeqFsim();
+
+
+public:
+
+  /// @brief テスト系列を読み込んで故障シミュレーションを行う．
+  /// @param[in] s テスト系列を読み込むストリーム
+  /// @param[in] err_out エラーメッセージを出力するストリーム
+  /// @return 読み込みに失敗した時には false を返す．
+  /// @note 縮退故障のみが対象となる．
+  bool
+  operator()(istream& s,
+	     ostream& err_out);
+
+  /// @brief 直前の実行結果を得る．
+  const SeqFsimStats&
+  stats() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 下請け関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief テスト系列を読み込む．
+  /// @param[in] s 入力ストリーム
+  /// @param[in] err_out エラーメッセージを出力するストリーム
+  /// @param[out] tv_list 読み込んだテスト系列
+  /// @return 読み込みに失敗した時には false を返す．
+  bool
+  read(istream& s,
+       ostream& err_out,
+       vector<TestVector*>& tv_list);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 実行結果
+  SeqFsimStats mStats;
+
+};
+
+END_NAMESPACE_YM_ATPG
+
+#endif // MAIN_SEQFSIM_H
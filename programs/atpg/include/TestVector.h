@@ -24,6 +24,10 @@ class SaFault;
 //////////////////////////////////////////////////////////////////////
 /// @class TestVector TestVector.h "TestVector.h"
 /// @brief テストベクタを表すクラス
+///
+/// 遷移故障(launch-on-capture)用のベクタは1時刻めの ni() 個の値の
+/// 後ろに2時刻めの外部入力の値を pi2_num() 個持つ．
+/// x_num() や dump_bin() などのベクタ全体に対する操作はこれらも含む．
 //////////////////////////////////////////////////////////////////////
 class TestVector
 {
@@ -39,6 +43,26 @@ public:
   Val3
   val3(ymuint pos) const;
 
+  /// @brief 2時刻めの外部入力の値の数を得る．
+  /// @note 縮退故障用のベクタでは 0 となる．
+  ymuint
+  pi2_num() const;
+
+  /// @brief 2時刻めの pos 番めの外部入力の値を得る．
+  /// @note pi2_num() が 0 の時は1時刻めの値(val3(pos))を返す．
+  Val3
+  pi2_val3(ymuint pos) const;
+
+  /// @brief X の数を得る．
+  ymuint
+  x_num() const;
+
+  /// @brief 他のテストベクタと両立する時 true を返す．
+  /// @param[in] tv 比較対象のテストベクタ
+  /// @note 両立するとは 0 と 1 がぶつかる入力がないこと．
+  bool
+  is_compatible(const TestVector& tv) const;
+
   /// @brief このパタンで検出した故障のリストを返す．
   const list<SaFault*>&
   det_faults() const;
@@ -68,6 +92,12 @@ public:
   set_val(ymuint pos,
 	  Val3 val);
 
+  /// @breif 2時刻めの pos 番めの外部入力の値を設定する．
+  /// @note pi2_num() が 0 の時は何もしない．
+  void
+  set_pi2_val(ymuint pos,
+	      Val3 val);
+
   /// @brief HEX文字列から内容を設定する．
   /// @param[in] hex_string HEX 文字列
   /// @return hex_string に不適切な文字が含まれていたら false を返す．
@@ -87,6 +117,11 @@ public:
   /// @note X の部分はコピーしない．
   void
   copy(const TestVector& src);
+
+  /// @brief X の部分を乱数で埋める．
+  /// @param[in] randgen 乱数生成器
+  void
+  fix_x_from_random(RandGen& randgen);
   
   /// @brief このパタンで検出した故障を追加する．
   void
@@ -95,6 +130,10 @@ public:
 
 private:
 
+  /// @brief 2時刻めの外部入力も含めた値の数を返す．
+  ymuint
+  bit_num() const;
+
   /// @brief ブロック数を返す．
   static
   ymuint
@@ -154,12 +193,16 @@ private:
 
   // 入力数
   ymuint mNi;
+
+  // 2時刻めの外部入力の値の数
+  // mNi 番め以降に格納される．
+  ymuint mPi2Num;
   
   // このパタンで検出した故障のリスト
   list<SaFault*> mDetFaults;
   
   // ベクタ本体(ただしサイズは可変)
-  PackedVal mPat[1];
+  PvWord mPat[1];
 
   
 private:
@@ -169,7 +212,7 @@ private:
 
   // 1ワードあたりのHEX文字数
   static
-  const ymuint HPW = kPvBitLen / 4;
+  const ymuint HPW = kPvWordBitLen / 4;
   
 };
 
@@ -210,6 +253,36 @@ TestVector::val3(ymuint pos) const
   return static_cast<Val3>(v1 + v1 + v0);
 }
 
+// @brief 2時刻めの外部入力の値の数を得る．
+inline
+ymuint
+TestVector::pi2_num() const
+{
+  return mPi2Num;
+}
+
+// @brief 2時刻めの pos 番めの外部入力の値を得る．
+inline
+Val3
+TestVector::pi2_val3(ymuint pos) const
+{
+  if ( mPi2Num == 0 ) {
+    return val3(pos);
+  }
+  return val3(mNi + pos);
+}
+
+// @breif 2時刻めの pos 番めの外部入力の値を設定する．
+inline
+void
+TestVector::set_pi2_val(ymuint pos,
+			Val3 val)
+{
+  if ( mPi2Num > 0 ) {
+    set_val(mNi + pos, val);
+  }
+}
+
 // @breif pos 番めの値を設定する．
 inline
 void
@@ -219,7 +292,7 @@ TestVector::set_val(ymuint pos,
   ymuint shift = shift_num(pos);
   ymuint block0 = block_idx(pos);
   ymuint block1 = block0 + 1;
-  PackedVal mask = 1UL << shift;
+  PvWord mask = 1UL << shift;
   if ( val == kVal0 ) {
     mPat[block0] |= mask;
     mPat[block1] &= ~mask;
@@ -250,12 +323,20 @@ TestVector::add_fault(SaFault* fault)
   mDetFaults.push_back(fault);
 }
 
+// @brief 2時刻めの外部入力も含めた値の数を返す．
+inline
+ymuint
+TestVector::bit_num() const
+{
+  return mNi + mPi2Num;
+}
+
 // @brief ブロック数を返す．
 inline
 ymuint
 TestVector::block_num(ymuint ni)
 {
-  return ((ni + kPvBitLen - 1) / kPvBitLen) * 2;
+  return ((ni + kPvWordBitLen - 1) / kPvWordBitLen) * 2;
 }
 
 // @brief HEX文字列の長さを返す．
@@ -271,7 +352,7 @@ inline
 ymuint
 TestVector::block_idx(ymuint ipos)
 {
-  return (ipos / kPvBitLen) * 2;
+  return (ipos / kPvWordBitLen) * 2;
 }
 
 // 入力位置からシフト量を得る．
@@ -279,7 +360,7 @@ inline
 ymuint
 TestVector::shift_num(ymuint ipos)
 {
-  return (kPvBitLen - 1 - ipos) % kPvBitLen;
+  return (kPvWordBitLen - 1 - ipos) % kPvWordBitLen;
 }
 
 // @brief 内容を出力する．
@@ -40,9 +40,17 @@ public:
 
   /// @brief 初期化する．
   /// @param[in] ni 入力数
+  /// @param[in] npi 外部入力数(2時刻めの外部入力の値の数)
   /// @note 副作用で clear() が呼ばれる．
   void
-  init(size_t ni);
+  init(size_t ni,
+       size_t npi);
+
+  /// @brief 遷移故障用のベクタを生成するかどうかを設定する．
+  /// @note true の時は new_vector() が2時刻めの外部入力の値を持つ
+  /// ベクタを返す．
+  void
+  set_tdf_mode(bool tdf_mode);
   
   /// @brief 新しいパタンを生成する．
   /// @return 生成されたパタンを返す．
@@ -77,6 +85,12 @@ private:
   
   // テストベクタの入力数
   size_t mNi;
+
+  // 外部入力数
+  size_t mNpi;
+
+  // 遷移故障用のベクタを生成する時 true にするフラグ
+  bool mTdfMode;
   
   // 未使用のテストベクタをつないでおくリスト
   list<TestVector*> mAvail;
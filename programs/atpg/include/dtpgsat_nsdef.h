@@ -30,12 +30,14 @@ END_NAMESPACE_YM_ATPG
 BEGIN_NAMESPACE_YM_ATPG_DTPGSAT
 
 class DtpgSat;
+class UntestChecker;
 
 END_NAMESPACE_YM_ATPG_DTPGSAT
 
 BEGIN_NAMESPACE_YM_ATPG
 
 using nsDtpgSat::DtpgSat;
+using nsDtpgSat::UntestChecker;
 
 END_NAMESPACE_YM_ATPG
 
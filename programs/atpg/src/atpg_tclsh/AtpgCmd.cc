@@ -209,7 +209,9 @@ AtpgCmd::after_update_faults()
   size_t n_rep = rep_list.size();
   size_t n_remain = remain_list.size();
   size_t n_untest = untest_list.size();
-  size_t n_det = n_rep - n_remain - n_untest;
+  // collapse() で取り除かれた故障はまだ検出されていない．
+  size_t n_collapsed = fault_mgr.collapsed_num();
+  size_t n_det = n_rep - n_remain - n_untest - n_collapsed;
 
   TclObj varname = "::atpg::info";
   int varflag = 0;
@@ -218,6 +220,7 @@ AtpgCmd::after_update_faults()
   set_var(varname, "det_fault_num", n_det, varflag);
   set_var(varname, "remain_fault_num", n_remain, varflag);
   set_var(varname, "untestt_fault_num", n_untest, varflag);
+  set_var(varname, "collapsed_fault_num", n_collapsed, varflag);
 #if 0
   {
     TclObjVector tmp_list;
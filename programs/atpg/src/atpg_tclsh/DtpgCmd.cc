@@ -32,14 +32,26 @@ DtpgCmd::DtpgCmd(AtpgMgr* mgr) :
 			 "SATREC mode");
   mPoptMiniSat = new TclPopt(this, "minisat",
 			     "MINISAT mode");
+  mPoptIncr = new TclPopt(this, "incremental",
+			  "reuse one SAT solver per FFR");
   mPoptFsim = new TclPoptStr(this, "fsim",
 			     "specify FSIM mode (none, single, ppsfp)");
   mPoptDyn = new TclPoptStr(this, "dyn",
 			    "specify DYN mode (none, once, always)");
   mPoptScope = new TclPopt(this, "scoping",
 			   "do scoping");
+  mPoptKeepX = new TclPopt(this, "keep_x",
+			   "keep don't-care values in generated patterns");
+  mPoptCompaction = new TclPoptInt(this, "compaction",
+				   "specify number of secondary target faults per pattern");
+  mPoptSatThreads = new TclPoptInt(this, "sat_threads",
+				   "specify number of threads for SAT-based pattern generation");
+  mPoptLearning = new TclPopt(this, "learning",
+			      "identify untestable faults by learning before DTPG");
   mPoptBacktrack = new TclPoptInt(this, "backtrack",
 				  "specify backtrack limit");
+  mPoptThreads = new TclPoptInt(this, "threads",
+				"specify number of threads for fault simulation");
   mPoptPrintStats = new TclPopt(this, "print_stats",
 				"print statistics");
   new_popt_group(mPoptSat, mPoptMiniSat, mPoptSatRec);
@@ -85,6 +97,18 @@ DtpgCmd::cmd_proc(TclObjVector& objv)
     mDtpg.set_sat_mode(2);
   }
   
+  // incremental mode の設定
+  if ( mPoptIncr->is_specified() ) {
+    if ( !mPoptSatRec->is_specified() && !mPoptMiniSat->is_specified() ) {
+      mDtpg.set_sat(true);
+      mDtpg.set_sat_mode(0);
+    }
+    mDtpg.set_sat_incremental(true);
+  }
+  else {
+    mDtpg.set_sat_incremental(false);
+  }
+  
   // fsim_mode の設定
   tSimMode fsim_mode = kSimPpsfp;
   if ( mPoptFsim->is_specified() ) {
@@ -127,6 +151,38 @@ DtpgCmd::cmd_proc(TclObjVector& objv)
   // scoping option の設定
   bool scoping = mPoptScope->is_specified();
   mDtpg.set_scoping(scoping);
+
+  // keep_x option の設定
+  bool keep_x = mPoptKeepX->is_specified();
+  mDtpg.set_keep_x(keep_x);
+
+  // compaction option の設定
+  ymuint comp_limit = 0;
+  if ( mPoptCompaction->is_specified() ) {
+    int val = mPoptCompaction->val();
+    if ( val < 0 ) {
+      print_usage();
+      return TCL_ERROR;
+    }
+    comp_limit = val;
+  }
+  mDtpg.set_compaction(comp_limit);
+
+  // SAT モードのスレッド数の設定
+  ymuint sat_thread_num = 1;
+  if ( mPoptSatThreads->is_specified() ) {
+    int val = mPoptSatThreads->val();
+    if ( val <= 0 ) {
+      print_usage();
+      return TCL_ERROR;
+    }
+    sat_thread_num = val;
+  }
+  mDtpg.set_thread_num(sat_thread_num);
+
+  // learning option の設定
+  bool learning = mPoptLearning->is_specified();
+  mDtpg.set_learning(learning);
   
   // backtrack limit の設定
   if ( mPoptBacktrack->is_specified() ) {
@@ -137,6 +193,16 @@ DtpgCmd::cmd_proc(TclObjVector& objv)
     mDtpg.set_default_backtrack_limit();
   }
   
+  // 故障シミュレーションのスレッド数の設定
+  if ( mPoptThreads->is_specified() ) {
+    int thread_num = mPoptThreads->val();
+    if ( thread_num <= 0 ) {
+      print_usage();
+      return TCL_ERROR;
+    }
+    mgr().set_fsim_thread_num(thread_num);
+  }
+  
   bool print_stats = mPoptPrintStats->is_specified();
   
   // GO!
@@ -159,6 +225,16 @@ DtpgCmd::cmd_proc(TclObjVector& objv)
 	 << ": # of dtpg runs" << endl
 	 << setw(10) << stats.backtrack_count()
 	 << ": # of total backtracks" << endl
+	 << setw(10) << stats.solver_count()
+	 << ": # of SAT solvers" << endl
+	 << setw(10) << stats.compacted_faults()
+	 << ": # of faults detected by compaction" << endl
+	 << setw(10) << stats.learned_untestable_faults()
+	 << ": # of untestable faults found by learning" << endl
+	 << "LEARN: " << stats.learning_time() << endl
+	 << "SAVED: " << stats.saved_time() << endl
+	 << "CNF: " << stats.cnf_time() << endl
+	 << "SAT: " << stats.sat_time() << endl
 	 << stats.time() << endl;
   }
   
@@ -58,6 +58,9 @@ private:
   // minisat モードオプションの解析様オブジェクト
   TclPopt* mPoptMiniSat;
   
+  // incremental モードオプションの解析用オブジェクト
+  TclPopt* mPoptIncr;
+  
   // fsim モードオプションの解析用オブジェクト
   TclPoptStr* mPoptFsim;
 
@@ -67,9 +70,24 @@ private:
   // scoping オプションの解析用オブジェクト
   TclPopt* mPoptScope;
 
+  // keep_x オプションの解析用オブジェクト
+  TclPopt* mPoptKeepX;
+
+  // compaction オプションの解析用オブジェクト
+  TclPoptInt* mPoptCompaction;
+
+  // sat_threads オプションの解析用オブジェクト
+  TclPoptInt* mPoptSatThreads;
+
+  // learning オプションの解析用オブジェクト
+  TclPopt* mPoptLearning;
+
   // backtrack limit オプションの解析用オブジェクト
   TclPoptInt* mPoptBacktrack;
   
+  // threads オプションの解析用オブジェクト
+  TclPoptInt* mPoptThreads;
+
   // print_stats オプションの解析用オブジェクト
   TclPopt* mPoptPrintStats;
   
@@ -12,6 +12,8 @@
 #include "FaultCmd.h"
 #include "AtpgMgr.h"
 #include "FaultMgr.h"
+#include "FaultCollapser.h"
+#include <ym_tclpp/TclPopt.h>
 
 
 BEGIN_NAMESPACE_YM_ATPG
@@ -24,6 +26,10 @@ BEGIN_NAMESPACE_YM_ATPG
 SetFault::SetFault(AtpgMgr* mgr) :
   AtpgCmd(mgr)
 {
+  mPoptTransition = new TclPopt(this, "transition",
+				"set transition-delay faults (launch-on-capture)");
+  mPoptCollapse = new TclPopt(this, "collapse",
+			      "collapse faults by dominance and functional equivalence");
 }
   
 // コマンド処理関数
@@ -39,9 +45,23 @@ SetFault::cmd_proc(TclObjVector& objv)
   
   TgNetwork& network = _network();
   FaultMgr& fault_mgr = _fault_mgr();
-  fault_mgr.set_ssa_fault(network);
+  if ( mPoptTransition->is_specified() ) {
+    fault_mgr.set_tdf_fault(network);
+  }
+  else {
+    fault_mgr.set_ssa_fault(network);
+  }
 
   after_update_faults();
+
+  if ( mPoptCollapse->is_specified() ) {
+    // 構造的な支配関係で外してから残りの等価な故障を調べる．
+    fault_mgr.collapse();
+    after_update_faults();
+    FaultCollapser collapser(&mgr());
+    collapser();
+    after_update_faults();
+  }
   
   return TCL_OK;
 }
@@ -35,6 +35,18 @@ protected:
   int
   cmd_proc(TclObjVector& objv);
 
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // transition オプションの解析用オブジェクト
+  TclPopt* mPoptTransition;
+
+  // collapse オプションの解析用オブジェクト
+  TclPopt* mPoptCollapse;
+
 };
 
 END_NAMESPACE_YM_ATPG
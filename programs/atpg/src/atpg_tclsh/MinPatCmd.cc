@@ -0,0 +1,112 @@
+
+/// @file src/atpg_tclsh/MinPatCmd.cc
+/// @brief テストパタンの圧縮を行うコマンド
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "MinPatCmd.h"
+#include "AtpgMgr.h"
+#include "TestVector.h"
+#include <ym_tclpp/TclPopt.h>
+
+
+BEGIN_NAMESPACE_YM_ATPG
+
+//////////////////////////////////////////////////////////////////////
+// テストパタンの圧縮を行うコマンド
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MinPatCmd::MinPatCmd(AtpgMgr* mgr) :
+  AtpgCmd(mgr),
+  mMinPat(mgr)
+{
+  mPoptReverse = new TclPopt(this, "reverse",
+			     "do reverse order fault simulation");
+  mPoptRandom = new TclPoptInt(this, "random",
+			       "do random order fault simulation <int> times");
+  mPoptMerge = new TclPopt(this, "merge",
+			   "merge compatible patterns"
+			   " (needs X values kept by 'dtpg -keep_x')");
+  mPoptPrintStats = new TclPopt(this, "print_stats",
+				"print statistics");
+}
+
+// @brief デストラクタ
+MinPatCmd::~MinPatCmd()
+{
+}
+
+// コマンド処理関数
+int
+MinPatCmd::cmd_proc(TclObjVector& objv)
+{
+  size_t objc = objv.size();
+  if ( objc != 1 ) {
+    print_usage();
+    return TCL_ERROR;
+  }
+
+  ymuint mode = 0;
+  ymuint rand_iter = 10;
+
+  if ( mPoptReverse->is_specified() ) {
+    mode |= kMinPatReverse;
+  }
+
+  if ( mPoptRandom->is_specified() ) {
+    int val = mPoptRandom->val();
+    if ( val < 0 ) {
+      print_usage();
+      return TCL_ERROR;
+    }
+    mode |= kMinPatRandom;
+    rand_iter = val;
+  }
+
+  if ( mPoptMerge->is_specified() ) {
+    mode |= kMinPatMerge;
+    // X を含まないパタンどうしは併合できない．
+    const vector<TestVector*>& tv_list = mgr()._tv_list();
+    bool has_x = false;
+    for (vector<TestVector*>::const_iterator p = tv_list.begin();
+	 p != tv_list.end(); ++ p) {
+      if ( (*p)->x_num() > 0 ) {
+	has_x = true;
+	break;
+      }
+    }
+    if ( !has_x ) {
+      cerr << "Warning: no pattern has X values, -merge has no effect."
+	   << " Use 'dtpg -keep_x' to keep them." << endl;
+    }
+  }
+
+  // 何も指定されていなければ全部行う．
+  if ( mode == 0 ) {
+    mode = kMinPatAll;
+  }
+  
+  bool print_stats = mPoptPrintStats->is_specified();
+  
+  mMinPat(mode, rand_iter);
+
+  if ( print_stats ) {
+    const MinPatStats& stats = mMinPat.stats();
+    cout << "********** minpat **********" << endl
+	 << setw(10) << stats.original_patterns()
+	 << ": # of original patterns" << endl
+	 << setw(10) << stats.minimized_patterns()
+	 << ": # of minimized patterns" << endl
+	 << stats.time() << endl;
+  }
+  
+  return TCL_OK;
+}
+
+END_NAMESPACE_YM_ATPG
@@ -0,0 +1,68 @@
+#ifndef SRC_ATPG_TCLSH_MINPATCMD_H
+#define SRC_ATPG_TCLSH_MINPATCMD_H
+
+/// @file src/atpg_tclsh/MinPatCmd.h
+/// @brief MinPatCmd のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "AtpgCmd.h"
+#include "MinPat.h"
+
+
+BEGIN_NAMESPACE_YM_ATPG
+
+//////////////////////////////////////////////////////////////////////
+// テストパタンの圧縮を行うコマンド
+//////////////////////////////////////////////////////////////////////
+class MinPatCmd :
+  public AtpgCmd
+{
+public:
+
+  /// @brief コンストラクタ
+  MinPatCmd(AtpgMgr* mgr);
+
+  /// @brief デストラクタ
+  virtual
+  ~MinPatCmd();
+
+
+protected:
+  
+  // コマンド処理関数
+  virtual
+  int
+  cmd_proc(TclObjVector& objv);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+  
+  // reverse オプションの解析用オブジェクト
+  TclPopt* mPoptReverse;
+
+  // random オプションの解析用オブジェクト
+  TclPoptInt* mPoptRandom;
+
+  // merge オプションの解析用オブジェクト
+  TclPopt* mPoptMerge;
+
+  // print_stats オプションの解析用オブジェクト
+  TclPopt* mPoptPrintStats;
+  
+  // パタン圧縮を行うクラス
+  MinPat mMinPat;
+  
+};
+
+END_NAMESPACE_YM_ATPG
+
+#endif // SRC_ATPG_TCLSH_MINPATCMD_H
@@ -52,11 +52,21 @@ PrintStatsCmd::cmd_proc(TclObjVector& objv)
 
   FaultMgr& fmgr = _fault_mgr();
   size_t num = mgr()._tv_list().size();
+
+  // 故障検出率とテスト生成効率
+  ymuint all_num = fmgr.all_rep_num();
+  double coverage = 0.0;
+  double efficiency = 0.0;
+  if ( all_num > 0 ) {
+    coverage = fmgr.det_num() * 100.0 / all_num;
+    efficiency = (fmgr.det_num() + fmgr.untest_num()) * 100.0 / all_num;
+  }
   
   fprintf(stdout, "#A: # of total faults       = %7d\n", fmgr.all_rep_num());
   fprintf(stdout, "#B: # of detected faults    = %7d\n", fmgr.det_num());
   fprintf(stdout, "#C: # of redundant faults   = %7d\n", fmgr.untest_num());
-  fprintf(stdout, "#D: # of undetected faults  = %7d\n", fmgr.remain_num());
+  fprintf(stdout, "#D: # of undetected faults  = %7d\n",
+	  fmgr.remain_num() + fmgr.collapsed_num());
   fprintf(stdout, "#E: # of generated patterns = %7d\n", num);
   fprintf(stdout, "#F:   Total CPU time        = %7.2fu %7.2fs\n",
 	  lap.usr_time(), lap.sys_time());
@@ -68,6 +78,11 @@ PrintStatsCmd::cmd_proc(TclObjVector& objv)
 	  f_time.usr_time());
   fprintf(stdout, "#J:    (sat  time           = %7.2f)\n",
 	  s_time.usr_time());
+  fprintf(stdout, "#K: fault model             = %s\n",
+	  fmgr.model() == kFmTransition ? "transition" : "stuck-at");
+  fprintf(stdout, "#L: fault coverage          = %7.2f%%\n", coverage);
+  fprintf(stdout, "#M: ATPG efficiency         = %7.2f%%\n", efficiency);
+  fprintf(stdout, "#N: # of collapsed faults   = %7d\n", fmgr.collapsed_num());
   
   return TCL_OK;
 }
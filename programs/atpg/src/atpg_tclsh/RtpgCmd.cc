@@ -34,6 +34,8 @@ RtpgCmd::RtpgCmd(AtpgMgr* mgr) :
 			      "sepcify the random seed");
   mPoptFile = new TclPoptStr(this, "file",
 			     "specify the file name containg patterns");
+  mPoptThreads = new TclPoptInt(this, "threads",
+				"specify number of threads for fault simulation");
   mPoptPrintStats = new TclPopt(this, "print_stats",
 				"print statistics");
 }
@@ -79,6 +81,16 @@ RtpgCmd::cmd_proc(TclObjVector& objv)
     // 未実装
   }
   
+  // 故障シミュレーションのスレッド数の設定
+  if ( mPoptThreads->is_specified() ) {
+    int thread_num = mPoptThreads->val();
+    if ( thread_num <= 0 ) {
+      print_usage();
+      return TCL_ERROR;
+    }
+    mgr().set_fsim_thread_num(thread_num);
+  }
+  
   bool print_stats = mPoptPrintStats->is_specified();
   
   if ( n_flag ) {
@@ -61,6 +61,9 @@ private:
   // file オプションの解析用オブジェクト
   TclPoptStr* mPoptFile;
 
+  // threads オプションの解析用オブジェクト
+  TclPoptInt* mPoptThreads;
+
   // print_stats オプションの解析用オブジェクト
   TclPopt* mPoptPrintStats;
   
@@ -0,0 +1,106 @@
+
+/// @file src/atpg_tclsh/SeqFsimCmd.cc
+/// @brief SeqFsimCmd の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id: SeqFsimCmd.cc 2203 2009-04-16 05:04:40Z matsunaga $
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "SeqFsimCmd.h"
+#include "AtpgMgr.h"
+#include <ym_tclpp/TclPopt.h>
+
+
+BEGIN_NAMESPACE_YM_ATPG
+
+//////////////////////////////////////////////////////////////////////
+// テスト系列の順序回路の故障シミュレーションを行うコマンド
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+SeqFsimCmd::SeqFsimCmd(AtpgMgr* mgr) :
+  AtpgCmd(mgr),
+  mSeqFsim(mgr)
+{
+  mPoptThreads = new TclPoptInt(this, "threads",
+				"specify number of threads for fault simulation");
+  mPoptPrintStats = new TclPopt(this, "print_stats",
+				"print statistics");
+  set_usage_string("filename");
+}
+
+// @brief デストラクタ
+SeqFsimCmd::~SeqFsimCmd()
+{
+}
+
+// コマンド処理関数
+int
+SeqFsimCmd::cmd_proc(TclObjVector& objv)
+{
+  size_t objc = objv.size();
+
+  // このコマンドはテスト系列のファイル名を引数としてとる．
+  if ( objc != 2 ) {
+    print_usage();
+    return TCL_ERROR;
+  }
+
+  string filename = objv[1];
+  // ファイル名の展開を行う．
+  string ex_filename;
+  bool stat1 = tilde_subst(filename, ex_filename);
+  if ( !stat1 ) {
+    // ファイル名の文字列に誤りがあった．
+    return TCL_ERROR;
+  }
+
+  // 故障シミュレーションのスレッド数の設定
+  if ( mPoptThreads->is_specified() ) {
+    int thread_num = mPoptThreads->val();
+    if ( thread_num <= 0 ) {
+      print_usage();
+      return TCL_ERROR;
+    }
+    mgr().set_fsim_thread_num(thread_num);
+  }
+  
+  bool print_stats = mPoptPrintStats->is_specified();
+
+  ifstream is(ex_filename.c_str());
+  if ( !is ) {
+    TclObj emsg;
+    emsg << ex_filename << ": No such file.";
+    set_result(emsg);
+    return TCL_ERROR;
+  }
+
+  ostringstream err_out;
+  bool stat = mSeqFsim(is, err_out);
+  if ( !stat ) {
+    TclObj emsg = err_out.str();
+    set_result(emsg);
+    return TCL_ERROR;
+  }
+  
+  after_update_faults();
+
+  if ( print_stats ) {
+    const SeqFsimStats& stats = mSeqFsim.stats();
+    cout << "********** seqfsim **********" << endl
+	 << setw(10) << stats.detected_faults()
+	 << ": # of detected faults" << endl
+	 << setw(10) << stats.frame_num()
+	 << ": # of simulated frames" << endl
+	 << setw(10) << stats.last_effective_frame()
+	 << ": last frame detecting faults" << endl
+	 << stats.time() << endl;
+  }
+  
+  return TCL_OK;
+}
+
+END_NAMESPACE_YM_ATPG
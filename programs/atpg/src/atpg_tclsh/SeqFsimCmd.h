@@ -0,0 +1,62 @@
+#ifndef SRC_ATPG_TCLSH_SEQFSIMCMD_H
+#define SRC_ATPG_TCLSH_SEQFSIMCMD_H
+
+/// @file src/atpg_tclsh/SeqFsimCmd.h
+/// @brief SeqFsimCmd のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id: SeqFsimCmd.h 2128 2009-03-12 07:25:33Z matsunaga $
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "AtpgCmd.h"
+#include "SeqFsim.h"
+
+
+BEGIN_NAMESPACE_YM_ATPG
+
+//////////////////////////////////////////////////////////////////////
+// テスト系列の順序回路の故障シミュレーションを行うコマンド
+//////////////////////////////////////////////////////////////////////
+class SeqFsimCmd :
+  public AtpgCmd
+{
+public:
+
+  /// @brief コンストラクタ
+  SeqFsimCmd(AtpgMgr* mgr);
+
+  /// @brief デストラクタ
+  virtual
+  ~SeqFsimCmd();
+
+
+protected:
+  
+  // コマンド処理関数
+  virtual
+  int
+  cmd_proc(TclObjVector& objv);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // threads オプションの解析用オブジェクト
+  TclPoptInt* mPoptThreads;
+
+  // print_stats オプションの解析用オブジェクト
+  TclPopt* mPoptPrintStats;
+  
+  // 故障シミュレーションを行うクラス
+  SeqFsim mSeqFsim;
+  
+};
+
+END_NAMESPACE_YM_ATPG
+
+#endif // SRC_ATPG_TCLSH_SEQFSIMCMD_H
@@ -16,6 +16,8 @@
 #include "NtwkIoCmd.h"
 #include "FaultCmd.h"
 #include "RtpgCmd.h"
+#include "SeqFsimCmd.h"
+#include "MinPatCmd.h"
 #include "RfsimCmd.h"
 #include "DtpgCmd.h"
 #include "PrintFaultCmd.h"
@@ -50,7 +52,9 @@ atpg_init(Tcl_Interp* interp)
   TclCmdBinder1<PrintPatCmd, AtpgMgr*>::reg(interp, mgr, "::atpg::print_pat");
   TclCmdBinder1<RtpgCmd, AtpgMgr*>::reg(interp, mgr, "::atpg::rtpg");
   TclCmdBinder1<RfsimCmd, AtpgMgr*>::reg(interp, mgr, "::atpg::rfsim");
+  TclCmdBinder1<SeqFsimCmd, AtpgMgr*>::reg(interp, mgr, "::atpg::seqfsim");
   TclCmdBinder1<DtpgCmd, AtpgMgr*>::reg(interp, mgr, "::atpg::dtpg");
+  TclCmdBinder1<MinPatCmd, AtpgMgr*>::reg(interp, mgr, "::atpg::minpat");
 
   
   //////////////////////////////////////////////////////////////////////
@@ -68,7 +72,9 @@ atpg_init(Tcl_Interp* interp)
       << "proc complete(print_pat) { t s e l p m } { return \"\" }" << endl
       << "proc complete(rtpg) { t s e l p m } { return \"\" }" << endl
       << "proc complete(rfsim) { t s e l p m } { return \"\" }" << endl
+      << "proc complete(seqfsim) { t s e l p m } { return \"\" }" << endl
       << "proc complete(dtpg) { t s e l p m } { return \"\" }" << endl
+      << "proc complete(minpat) { t s e l p m } { return \"\" }" << endl
       << "}" << endl
       << "}" << endl;
   string str = buf.str();
@@ -28,6 +28,8 @@ FaultMgr::FaultMgr() :
   mFinfoAlloc(sizeof(Finfo), 1024),
   mIfaultsAlloc(4096),
   mNetwork(NULL),
+  mModel(kFmStuckAt),
+  mReleasedNum(0),
   mChanged(false)
 {
 }
@@ -45,12 +47,15 @@ FaultMgr::clear()
   mFinfoAlloc.destroy();
   mIfaultsAlloc.destroy();
   mNetwork = NULL;
+  mModel = kFmStuckAt;
   mFnodeArray.clear();
   mAllList.clear();
   mAllRepList.clear();
   mDetList.clear();
   mRemainList.clear();
   mUntestList.clear();
+  mCollapsedList.clear();
+  mReleasedNum = 0;
   mChanged = true;
 }
 
@@ -94,6 +99,24 @@ FaultMgr::set_ssa_fault(const TgNetwork& network)
 {
   clear();
 
+  mModel = kFmStuckAt;
+  make_faults(network);
+}
+
+// @brief FaultMgr に全ての遷移故障を設定する．
+void
+FaultMgr::set_tdf_fault(const TgNetwork& network)
+{
+  clear();
+
+  mModel = kFmTransition;
+  make_faults(network);
+}
+
+// @brief mModel の故障を全て生成して代表故障を登録する．
+void
+FaultMgr::make_faults(const TgNetwork& network)
+{
   mNetwork = &network;
   
   ymuint ni = network.input_num2();
@@ -180,6 +203,30 @@ FaultMgr::reg_faults(const TgNode* node)
   
   tTgGateType type = node->type();
   ymuint ni = node->ni();
+
+  if ( mModel == kFmTransition ) {
+    // 遷移故障は1時刻めの値も条件に含むので，ゲートの制御値による
+    // 等価関係は成り立たない．buf と not の入出力のみ等価となる．
+    switch ( type ) {
+    case kTgBuff:
+      add_ifault(node, 0, 0, f0);
+      add_ifault(node, 0, 1, f1);
+      break;
+
+    case kTgNot:
+      add_ifault(node, 0, 0, f1);
+      add_ifault(node, 0, 1, f0);
+      break;
+
+    default:
+      for (ymuint j = 0; j < ni; ++ j) {
+	add_ifault(node, j, 0);
+	add_ifault(node, j, 1);
+      }
+      break;
+    }
+    return;
+  }
   switch ( type ) {
   case kTgUndef:
   case kTgInput:
@@ -272,7 +319,7 @@ FaultMgr::new_fault(const TgNode* node,
 		    int val)
 {
   void* p = mFaultAlloc.get_memory(sizeof(SaFault));
-  SaFault* f = new (p) SaFault(node, is_output, pos, val);
+  SaFault* f = new (p) SaFault(node, is_output, pos, val, mModel);
   return f;
 }
 
@@ -345,15 +392,170 @@ FaultMgr::set_status(SaFault* fault,
   mChanged = true;
 }
 
+// @brief ゲートの支配関係を用いて故障を対象から外す．
+// @note 縮退故障のみが対象となる．
+// AND/NAND/OR/NOR ゲートの入力の非制御値の故障を検出するパタンは
+// 出力の故障も検出するので，出力の故障を入力の故障の検出結果で
+// 判定する．FFR 内ではこの関係が入力側に連鎖するので，結果として
+// FFR の根と境界(チェックポイント)の故障だけが対象に残る．
+void
+FaultMgr::collapse()
+{
+  if ( mModel != kFmStuckAt || mNetwork == NULL ) {
+    return;
+  }
+  
+  ymuint nl = mNetwork->logic_num();
+  for (ymuint i = 0; i < nl; ++ i) {
+    const TgNode* node = mNetwork->logic(i);
+    ymuint ni = node->ni();
+    if ( ni < 2 ) {
+      continue;
+    }
+    int ival = 0;
+    int oval = 0;
+    switch ( node->type() ) {
+    case kTgAnd:  ival = 1; oval = 1; break;
+    case kTgNand: ival = 1; oval = 0; break;
+    case kTgOr:   ival = 0; oval = 0; break;
+    case kTgNor:  ival = 0; oval = 1; break;
+    default: continue;
+    }
+    SaFault* f1 = find_ofault(node, oval);
+    for (ymuint j = 0; j < ni; ++ j) {
+      add_dominance(f1, find_ifault(node, j, ival));
+    }
+  }
+  update();
+}
+
+// @brief 支配関係を登録する．
+// @param[in] f1 支配する故障
+// @param[in] f2 支配される故障
+// @return 登録できた時に true を返す．
+bool
+FaultMgr::add_dominance(SaFault* f1,
+			SaFault* f2)
+{
+  f1 = f1->rep();
+  f2 = f2->rep();
+  if ( f1->status() != kFsUndetected || f2->status() != kFsUndetected ) {
+    return false;
+  }
+  if ( reach_proxy(f2, f1) ) {
+    return false;
+  }
+  Finfo* finfo = f1->mFinfo;
+  if ( finfo->mProxyList.empty() ) {
+    mCollapsedList.push_back(f1);
+  }
+  finfo->mProxyList.push_back(f2);
+  mChanged = true;
+  return true;
+}
+
+// @brief f2 から支配関係をたどって f1 に到達できる時 true を返す．
+bool
+FaultMgr::reach_proxy(SaFault* f2,
+		      SaFault* f1)
+{
+  hash_set<ympuint> mark;
+  vector<SaFault*> queue;
+  queue.push_back(f2);
+  mark.insert(reinterpret_cast<ympuint>(f2));
+  while ( !queue.empty() ) {
+    SaFault* f = queue.back();
+    queue.pop_back();
+    if ( f == f1 ) {
+      return true;
+    }
+    const vector<SaFault*>& plist = f->mFinfo->mProxyList;
+    for (vector<SaFault*>::const_iterator p = plist.begin();
+	 p != plist.end(); ++ p) {
+      SaFault* f3 = *p;
+      if ( mark.insert(reinterpret_cast<ympuint>(f3)).second ) {
+	queue.push_back(f3);
+      }
+    }
+  }
+  return false;
+}
+
+// @brief 支配関係で対象から外した故障の状態を決める．
+// @note 支配される故障のどれかが検出されれば検出済みとし，
+// 全て検出不能かアボートとなったら未検出リストに戻す．
+// 支配される故障が対象から外されている場合もあるので，
+// 変化がなくなるまで繰り返す．
+void
+FaultMgr::resolve_collapsed()
+{
+  for (bool changed = true; changed; ) {
+    changed = false;
+    ymuint n = mCollapsedList.size();
+    ymuint wpos = 0;
+    for (ymuint rpos = 0; rpos < n; ++ rpos) {
+      SaFault* f = mCollapsedList[rpos];
+      Finfo* finfo = f->mFinfo;
+      FaultStatus stat = finfo->mStatus;
+      if ( stat == kFsUndetected || stat == kFsAbort ) {
+	bool pending = false;
+	const vector<SaFault*>& plist = finfo->mProxyList;
+	for (vector<SaFault*>::const_iterator p = plist.begin();
+	     p != plist.end(); ++ p) {
+	  FaultStatus stat2 = (*p)->status();
+	  if ( stat2 == kFsDetected ) {
+	    stat = kFsDetected;
+	    break;
+	  }
+	  if ( stat2 == kFsUndetected ) {
+	    pending = true;
+	  }
+	}
+	if ( stat != kFsDetected ) {
+	  if ( pending ) {
+	    mCollapsedList[wpos] = f;
+	    ++ wpos;
+	    continue;
+	  }
+	  finfo->mStatus = kFsUndetected;
+	  finfo->mProxyList.clear();
+	  mRemainList.push_back(f);
+	  ++ mReleasedNum;
+	  changed = true;
+	  continue;
+	}
+	finfo->mStatus = kFsDetected;
+      }
+      finfo->mProxyList.clear();
+      if ( stat == kFsDetected ) {
+	mDetList.push_back(f);
+      }
+      else {
+	mUntestList.push_back(f);
+      }
+      changed = true;
+    }
+    mCollapsedList.erase(mCollapsedList.begin() + wpos, mCollapsedList.end());
+  }
+}
+
 // @brief 故障リストをスキャンして未検出リストを更新する．
+// @note アボートした故障は未検出に戻すが，支配関係の判定で
+// 区別する必要があるので戻すのは最後に行う．
 void
 FaultMgr::update()
 {
+  mReleasedNum = 0;
   if ( mChanged ) {
+    vector<SaFault*> abort_list;
     ymuint n = mRemainList.size();
     ymuint wpos = 0;
     for (ymuint rpos = 0; rpos < n; ++ rpos) {
       SaFault* f = mRemainList[rpos];
+      if ( f->is_collapsed() ) {
+	// mCollapsedList で扱う．
+	continue;
+      }
       switch ( f->status() ) {
       case kFsUndetected:
 	if ( wpos != rpos ) {
@@ -371,7 +573,7 @@ FaultMgr::update()
 	break;
 
       case kFsAbort:
-	set_status(f, kFsUndetected);
+	abort_list.push_back(f);
 	if ( wpos != rpos ) {
 	  mRemainList[wpos] = f;
 	}
@@ -382,6 +584,13 @@ FaultMgr::update()
     if ( wpos < n ) {
       mRemainList.erase(mRemainList.begin() + wpos, mRemainList.end());
     }
+    if ( !mCollapsedList.empty() ) {
+      resolve_collapsed();
+    }
+    for (vector<SaFault*>::iterator p = abort_list.begin();
+	 p != abort_list.end(); ++ p) {
+      (*p)->mFinfo->mStatus = kFsUndetected;
+    }
     mChanged = false;
   }
 }
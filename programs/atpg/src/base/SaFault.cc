@@ -31,10 +31,12 @@ BEGIN_NAMESPACE_YM_ATPG
 // @param[in] output 入力の故障のとき false, 出力の故障のとき true を与える．
 // @param[in] pos 故障位置
 // @param[in] val 故障値 0 か非0 で 0/1 を区別する．
+// @param[in] model 故障モデル
 SaFault::SaFault(const TgNode* node,
 		 bool output,
 		 ymuint pos,
-		 int val) :
+		 int val,
+		 FaultModel model) :
   mNode(node),
   mPosVal(0UL),
   mFinfo(NULL)
@@ -45,6 +47,9 @@ SaFault::SaFault(const TgNode* node,
   if ( output ) {
     mPosVal |= 2U;
   }
+  if ( model == kFmTransition ) {
+    mPosVal |= 4U;
+  }
   mPosVal |= (pos << 3);
 }
 
@@ -78,7 +83,15 @@ SaFault::str() const
     ans << "O";
   }
   ans << ":";
-  if ( val() ) {
+  if ( model() == kFmTransition ) {
+    if ( val() ) {
+      ans << "STF";
+    }
+    else {
+      ans << "STR";
+    }
+  }
+  else if ( val() ) {
     ans <<"SA1";
   }
   else {
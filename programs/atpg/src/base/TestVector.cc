@@ -21,7 +21,8 @@ BEGIN_NAMESPACE_YM_ATPG
 // @brief コンストラクタ
 // @param[in] 入力数を指定する．
 TestVector::TestVector(ymuint ni) :
-  mNi(ni)
+  mNi(ni),
+  mPi2Num(0)
 {
 }
 
@@ -34,12 +35,12 @@ TestVector::~TestVector()
 void
 TestVector::init()
 {
-  ymuint nb = block_num(ni());
+  ymuint nb = block_num(bit_num());
   for (ymuint i = 0; i < nb; i += 2) {
     ymuint i0 = i;
     ymuint i1 = i + 1;
-    mPat[i0] = kPvAll0;
-    mPat[i1] = kPvAll0;
+    mPat[i0] = 0UL;
+    mPat[i1] = 0UL;
   }
 }
 
@@ -52,33 +53,33 @@ bool
 TestVector::set_from_hex(const string& hex_string)
 {
   // よく問題になるが，ここでは最下位ビット側から入力する．
-  ymuint nl = hex_length(ni());
+  ymuint nl = hex_length(bit_num());
   ymuint sft = 0;
   ymuint blk = 0;
-  PackedVal pat = kPvAll0;
+  PvWord pat = 0UL;
   for (ymuint i = 0; i < nl; ++ i) {
     char c = (i < hex_string.size()) ? hex_string[i] : '0';
-    PackedVal pat1 = kPvAll0;
+    PvWord pat1 = 0UL;
     if ( '0' <= c && c <= '9' ) {
-      pat1 = static_cast<PackedVal>(c - '0');
+      pat1 = static_cast<PvWord>(c - '0');
     }
     else if ( 'a' <= c && c <= 'f' ) {
-      pat1 = static_cast<PackedVal>(c - 'a' + 10);
+      pat1 = static_cast<PvWord>(c - 'a' + 10);
     }
     else if ( 'A' <= c && c <= 'F' ) {
-      pat1 = static_cast<PackedVal>(c - 'A' + 10);
+      pat1 = static_cast<PvWord>(c - 'A' + 10);
     }
     else {
       return false;
     }
     pat |= (pat1 << sft);
     sft += 4;
-    if ( sft == kPvBitLen ) {
+    if ( sft == kPvWordBitLen ) {
       mPat[blk] = ~pat;
       mPat[blk + 1] = pat;
       sft = 0;
       blk += 2;
-      pat = kPvAll0;
+      pat = 0UL;
     }
   }
   if ( sft != 0 ) {
@@ -94,9 +95,9 @@ TestVector::set_from_hex(const string& hex_string)
 void
 TestVector::set_from_random(RandGen& randgen)
 {
-  ymuint nb = block_num(ni());
+  ymuint nb = block_num(bit_num());
   for (ymuint i = 0; i < nb; i += 2) {
-    PackedVal v = randgen.ulong();
+    PvWord v = randgen.ulong();
     mPat[i] = ~v;
     mPat[i + 1] = v;
   }
@@ -108,11 +109,11 @@ TestVector::set_from_random(RandGen& randgen)
 void
 TestVector::copy(const TestVector& src)
 {
-  ymuint nb = block_num(ni());
+  ymuint nb = block_num(bit_num());
   for (ymuint i = 0; i < nb; i += 2) {
     ymuint i0 = i;
     ymuint i1 = i + 1;
-    PackedVal mask = src.mPat[i0] | src.mPat[i1];
+    PvWord mask = src.mPat[i0] | src.mPat[i1];
     mPat[i0] &= ~mask;
     mPat[i0] |= src.mPat[i0];
     mPat[i1] &= ~mask;
@@ -120,12 +121,57 @@ TestVector::copy(const TestVector& src)
   }
 }
 
+// @brief X の部分を乱数で埋める．
+// @param[in] randgen 乱数生成器
+void
+TestVector::fix_x_from_random(RandGen& randgen)
+{
+  ymuint nb = block_num(bit_num());
+  for (ymuint i = 0; i < nb; i += 2) {
+    ymuint i0 = i;
+    ymuint i1 = i + 1;
+    PvWord xmask = ~(mPat[i0] | mPat[i1]);
+    PvWord v = randgen.ulong() & xmask;
+    mPat[i0] |= xmask & ~v;
+    mPat[i1] |= v;
+  }
+}
+
+// @brief X の数を得る．
+ymuint
+TestVector::x_num() const
+{
+  ymuint n = 0;
+  for (ymuint i = 0; i < bit_num(); ++ i) {
+    if ( val3(i) == kValX ) {
+      ++ n;
+    }
+  }
+  return n;
+}
+
+// @brief 他のテストベクタと両立する時 true を返す．
+// @param[in] tv 比較対象のテストベクタ
+bool
+TestVector::is_compatible(const TestVector& tv) const
+{
+  ymuint nb = block_num(bit_num());
+  for (ymuint i = 0; i < nb; i += 2) {
+    ymuint i0 = i;
+    ymuint i1 = i + 1;
+    if ( (mPat[i0] & tv.mPat[i1]) | (mPat[i1] & tv.mPat[i0]) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
 // @brief 内容を BIN 形式で出力する．
 void
 TestVector::dump_bin(ostream& s) const
 {
   // よく問題になるが，ここでは最下位ビット側から出力する．
-  for (ymuint i = 0; i < ni(); ++ i) {
+  for (ymuint i = 0; i < bit_num(); ++ i) {
     switch ( val3(i) ) {
     case kVal0: s << '0'; break;
     case kVal1: s << '1'; break;
@@ -143,7 +189,7 @@ TestVector::dump_hex(ostream& s) const
   ymuint tmp = 0U;
   ymuint bit = 1U;
   for (ymuint i = 0; ; ++ i) {
-    if ( i < ni() ) {
+    if ( i < bit_num() ) {
       if ( val3(i) == kVal1 ) {
 	// 面倒くさいので kValX は kVal0 と同じとみなす．
 	tmp += bit;
@@ -172,7 +218,7 @@ TestVector::dump_hex(ostream& s) const
 void
 TestVector::dump(FILE* fp) const
 {
-  for (ymuint i = 0; i < ni(); ++ i) {
+  for (ymuint i = 0; i < bit_num(); ++ i) {
     putc((val3(i) == kVal1 ? '1' : '0'), fp);
   }
   putc('\n', fp);
@@ -21,7 +21,9 @@ BEGIN_NAMESPACE_YM_ATPG
 // @brief コンストラクタ
 TvMgr::TvMgr() :
   mAlloc(4096),
-  mNi(0)
+  mNi(0),
+  mNpi(0),
+  mTdfMode(false)
 {
 }
 
@@ -38,14 +40,17 @@ TvMgr::clear()
   if ( mNi > 0 ) {
     mAlloc.destroy();
     mNi = 0;
+    mNpi = 0;
     mAvail.clear();
   }
 }
 
 // @brief 内容を初期化する．
 // @param[in] ni 入力数
+// @param[in] npi 外部入力数(2時刻めの外部入力の値の数)
 void
-TvMgr::init(size_t ni)
+TvMgr::init(size_t ni,
+	    size_t npi)
 {
   clear();
   
@@ -54,6 +59,14 @@ TvMgr::init(size_t ni)
     // 0 だとヤバい
     mNi = 1;
   }
+  mNpi = npi;
+}
+
+// @brief 遷移故障用のベクタを生成するかどうかを設定する．
+void
+TvMgr::set_tdf_mode(bool tdf_mode)
+{
+  mTdfMode = tdf_mode;
 }
 
 // @brief 新しいパタンを生成する．
@@ -65,17 +78,20 @@ TvMgr::new_vector()
   if ( !mAvail.empty() ) {
     TestVector* tv = mAvail.back();
     mAvail.pop_back();
+    tv->mPi2Num = mTdfMode ? mNpi : 0;
     return tv;
   }
   
-  size_t nb = TestVector::block_num(mNi);
-  size_t size = sizeof(TestVector) + kPvBitLen * (nb - 1);
+  // 2時刻めの外部入力の分の領域はモードによらず確保しておく．
+  size_t nb = TestVector::block_num(mNi + mNpi);
+  size_t size = sizeof(TestVector) + sizeof(PvWord) * (nb - 1);
   void* p = mAlloc.get_memory(size);
   TestVector* tv = new (p) TestVector(mNi);
+  tv->mPi2Num = mTdfMode ? mNpi : 0;
 
   // X に初期化しておく．
   for (size_t i = 0; i < nb; ++ i) {
-    tv->mPat[i] = kPvAll0;
+    tv->mPat[i] = 0UL;
   }
 
   return tv;
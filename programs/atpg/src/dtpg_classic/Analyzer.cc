@@ -102,7 +102,7 @@ Analyzer::run(Network& network,
   // の候補を求める．
   RandGen randgen;
   ymuint naig = mAigMgr->node_num();
-  vector<PackedVal> val_array(naig);
+  vector<PvWord> val_array(naig);
   vector<bool> c0_cands(naig, false);
   vector<bool> c1_cands(naig, false);
   vector<list<AigNode*> > eq_cands(naig);
@@ -111,18 +111,18 @@ Analyzer::run(Network& network,
   for ( ; ; ) {
     for (ymuint i = 0; i < naig; ++ i) {
       AigNode* anode = mAigMgr->node(i);
-      PackedVal val;
+      PvWord val;
       if ( anode->is_input() ) {
 	val = randgen.ulong();
       }
       else {
 	AigNode* inode0 = anode->fanin0();
-	PackedVal val0 = val_array[inode0->node_id()];
+	PvWord val0 = val_array[inode0->node_id()];
 	if ( anode->fanin_inv0() ) {
 	  val0 = ~val0;
 	}
 	AigNode* inode1 = anode->fanin1();
-	PackedVal val1 = val_array[inode1->node_id()];
+	PvWord val1 = val_array[inode1->node_id()];
 	if ( anode->fanin_inv1() ) {
 	  val1 = ~val1;
 	}
@@ -135,11 +135,11 @@ Analyzer::run(Network& network,
       hash_map<ymulong, AigNode*> sigmap;
       for (ymuint i = 0; i < naig; ++ i) {
 	AigNode* node = mAigMgr->node(i);
-	PackedVal val = val_array[node->node_id()];
-	if ( val == kPvAll0 ) {
+	PvWord val = val_array[node->node_id()];
+	if ( val == 0UL ) {
 	  c0_cands[node->node_id()] = true;
 	}
-	else if ( val == kPvAll1 ) {
+	else if ( val == ~0UL ) {
 	  c1_cands[node->node_id()] = true;
 	}
 	else {
@@ -159,12 +159,12 @@ Analyzer::run(Network& network,
       bool update = false;
       for (ymuint i = 0; i < naig; ++ i) {
 	AigNode* node = mAigMgr->node(i);
-	PackedVal val = val_array[node->node_id()];
-	if ( c0_cands[node->node_id()] && val != kPvAll0 ) {
+	PvWord val = val_array[node->node_id()];
+	if ( c0_cands[node->node_id()] && val != 0UL ) {
 	  c0_cands[node->node_id()] = false;
 	  update = true;
 	}
-	if ( c1_cands[node->node_id()] && val != kPvAll1 ) {
+	if ( c1_cands[node->node_id()] && val != ~0UL ) {
 	  c1_cands[node->node_id()] = false;
 	  update = true;
 	}
@@ -180,7 +180,7 @@ Analyzer::run(Network& network,
 	    list<AigNode*>::iterator cur = p;
 	    ++ p;
 	    AigNode* node1 = *p;
-	    PackedVal val1 = val_array[node1->node_id()];
+	    PvWord val1 = val_array[node1->node_id()];
 	    hash_map<ymulong, AigNode*>::iterator q = sigmap.find(val1);
 	    if ( q == sigmap.end() ) {
 	      sigmap.insert(val1, node1);
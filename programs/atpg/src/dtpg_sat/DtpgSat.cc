@@ -21,13 +21,19 @@ BEGIN_NAMESPACE_YM_ATPG_DTPGSAT
 
 // @brief コンストラクタ
 DtpgSat::DtpgSat() :
-  mMode(0)
+  mMode(0),
+  mIncremental(false),
+  mSolver(NULL),
+  mNetwork(NULL),
+  mRoot(NULL),
+  mSolverNum(0)
 {
 }
 
 // @brief デストラクタ
 DtpgSat::~DtpgSat()
 {
+  clear();
 }
 
 
@@ -261,35 +267,619 @@ make_cnf(SatSolver& solver,
 END_NONAMESPACE
 
 
+// @brief ノードの入出力の関係を表す CNF クローズを生成する．
+// @param[in] solver SAT ソルバ
+// @param[in] network 対象の回路
+// @param[in] node 対象のノード
+// @param[in] output 出力リテラル
+// @param[in] inputs 入力リテラル
+void
+make_node_cnf(SatSolver& solver,
+	      const TgNetwork& network,
+	      const TgNode* node,
+	      Literal output,
+	      const vector<Literal>& inputs)
+{
+  if ( node->is_cplx_logic() ) {
+    LogExpr lexp = network.get_lexp(node);
+    make_cnf(solver, lexp, output, inputs);
+  }
+  else {
+    make_cnf(solver, node->type(), output, inputs);
+  }
+}
+
+
+BEGIN_NONAMESPACE
+
+/// @brief node の TFO を求める．
+/// @param[in] node 起点のノード
+/// @param[out] mark TFO のノードに true をつける配列
+/// @param[out] queue TFO のノードを入れるリスト
+void
+get_tfo(const TgNode* node,
+	vector<bool>& mark,
+	vector<const TgNode*>& queue)
+{
+  mark[node->gid()] = true;
+  queue.push_back(node);
+  for (ymuint rpos = 0; rpos < queue.size(); ++ rpos) {
+    const TgNode* node1 = queue[rpos];
+    ymuint nfo = node1->fanout_num();
+    for (ymuint i = 0; i < nfo; ++ i) {
+      const TgNode* onode = node1->fanout(i);
+      if ( !mark[onode->gid()] ) {
+	mark[onode->gid()] = true;
+	queue.push_back(onode);
+      }
+    }
+  }
+}
+
+/// @brief 故障回路の CNF を生成する．
+/// @param[in] solver SAT ソルバ
+/// @param[in] network 対象の回路
+/// @param[in] f 対象の故障
+/// @param[in] gvar 正常回路の変数番号の配列
+/// @param[in] mark 故障の TFO のノードに true がついた配列
+/// @param[in] tfo 故障の TFO のノードのリスト
+/// @param[in] detect true の時は検出する条件，false の時は検出しない条件を加える．
+/// @return 検出する条件が恒偽となる時は節を加えずに false を返す．
+bool
+make_fault_cnf(SatSolver& solver,
+	       const TgNetwork& network,
+	       SaFault* f,
+	       const vector<tVarId>& gvar,
+	       const vector<bool>& mark,
+	       const vector<const TgNode*>& tfo,
+	       bool detect)
+{
+  ymuint n = network.node_num();
+  vector<tVarId> fvar(n);
+  for (vector<const TgNode*>::const_iterator p = tfo.begin();
+       p != tfo.end(); ++ p) {
+    fvar[(*p)->gid()] = solver.new_var();
+  }
+  
+  vector<Literal> odiff;
+  for (vector<const TgNode*>::const_iterator p = tfo.begin();
+       p != tfo.end(); ++ p) {
+    const TgNode* node = *p;
+    Literal output(fvar[node->gid()], kPolPosi);
+    if ( p == tfo.begin() && f->is_output_fault() ) {
+      // 出力の故障は故障値に固定する．
+      solver.add_clause(f->val() ? output : ~output);
+    }
+    else {
+      ymuint ni = node->ni();
+      vector<Literal> inputs(ni);
+      for (ymuint j = 0; j < ni; ++ j) {
+	const TgNode* inode = node->fanin(j);
+	if ( p == tfo.begin() && j == f->pos() ) {
+	  // 入力の故障は故障値に固定した変数を用いる．
+	  Literal flit(solver.new_var(), kPolPosi);
+	  solver.add_clause(f->val() ? flit : ~flit);
+	  inputs[j] = flit;
+	}
+	else if ( mark[inode->gid()] ) {
+	  inputs[j] = Literal(fvar[inode->gid()], kPolPosi);
+	}
+	else {
+	  inputs[j] = Literal(gvar[inode->gid()], kPolPosi);
+	}
+      }
+      make_node_cnf(solver, network, node, output, inputs);
+    }
+    if ( !node->is_output() ) {
+      continue;
+    }
+    Literal glit(gvar[node->gid()], kPolPosi);
+    if ( detect ) {
+      Literal dlit(solver.new_var(), kPolPosi);
+      solver.add_clause(~dlit,  glit,  output);
+      solver.add_clause(~dlit, ~glit, ~output);
+      odiff.push_back(dlit);
+    }
+    else {
+      solver.add_clause(~glit,  output);
+      solver.add_clause( glit, ~output);
+    }
+  }
+  if ( detect ) {
+    if ( odiff.empty() ) {
+      return false;
+    }
+    solver.add_clause(odiff);
+  }
+  return true;
+}
+
+END_NONAMESPACE
+
+
 // 故障 f に対するテストパタン生成を行う．
 tStat
 DtpgSat::run(const TgNetwork& network,
 	     SaFault* f,
 	     TestVector* tv)
 {
+  if ( mIncremental && f->model() == kFmStuckAt ) {
+    return run_ffr(network, f, tv);
+  }
+  else {
+    return run_single(network, f, NULL, tv);
+  }
+}
+
+// @brief 既存のパタンを拡張して故障を検出するパタンを求める．
+tStat
+DtpgSat::run_with_cube(const TgNetwork& network,
+		       SaFault* f,
+		       const TestVector* cube,
+		       TestVector* tv)
+{
+  // run_single() は変数番号の割り当て表を作り直すので，
+  // 使い回している SAT ソルバのものを退避しておく．
+  vector<Var> var_map;
+  var_map.swap(mVarMap);
+  tStat ans = run_single(network, f, cube, tv);
+  mVarMap.swap(var_map);
+  return ans;
+}
+
+// @brief f2 を検出するパタンが必ず f1 も検出するか調べる．
+// @note 正常回路は二つの故障の TFO の TFI だけを作り，
+// 故障回路はそれぞれの TFO について別の変数で作る．
+Bool3
+DtpgSat::check_dominance(const TgNetwork& network,
+			 SaFault* f1,
+			 SaFault* f2)
+{
+  if ( f1->model() != kFmStuckAt || f2->model() != kFmStuckAt ) {
+    return kB3X;
+  }
+
+  mCnfTimer.start();
+
   ymuint n = network.node_num();
-  ymuint nl = network.logic_num();
-  ymuint npo = network.output_num2();
-  
+  vector<bool> mark1(n, false);
+  vector<const TgNode*> tfo1;
+  get_tfo(f1->node(), mark1, tfo1);
+  vector<bool> mark2(n, false);
+  vector<const TgNode*> tfo2;
+  get_tfo(f2->node(), mark2, tfo2);
+
+  // 二つの TFO の TFI にマークをつける．
+  vector<bool> gmark(n, false);
+  vector<const TgNode*> queue;
+  queue.reserve(tfo1.size() + tfo2.size());
+  for (ymuint i = 0; i < 2; ++ i) {
+    const vector<const TgNode*>& tfo = (i == 0) ? tfo1 : tfo2;
+    for (vector<const TgNode*>::const_iterator p = tfo.begin();
+	 p != tfo.end(); ++ p) {
+      const TgNode* node = *p;
+      if ( !gmark[node->gid()] ) {
+	gmark[node->gid()] = true;
+	queue.push_back(node);
+      }
+    }
+  }
+  for (ymuint rpos = 0; rpos < queue.size(); ++ rpos) {
+    const TgNode* node = queue[rpos];
+    ymuint ni = node->ni();
+    for (ymuint i = 0; i < ni; ++ i) {
+      const TgNode* inode = node->fanin(i);
+      if ( !gmark[inode->gid()] ) {
+	gmark[inode->gid()] = true;
+	queue.push_back(inode);
+      }
+    }
+  }
+
+  SatSolver* solver_p = new_solver();
+  SatSolver& solver = *solver_p;
+
+  // 正常回路の CNF を生成
+  vector<tVarId> gvar(n);
+  for (vector<const TgNode*>::iterator p = queue.begin();
+       p != queue.end(); ++ p) {
+    gvar[(*p)->gid()] = solver.new_var();
+  }
+  for (vector<const TgNode*>::iterator p = queue.begin();
+       p != queue.end(); ++ p) {
+    const TgNode* node = *p;
+    if ( node->is_input() ) {
+      continue;
+    }
+    ymuint ni = node->ni();
+    vector<Literal> inputs(ni);
+    for (ymuint j = 0; j < ni; ++ j) {
+      inputs[j] = Literal(gvar[node->fanin(j)->gid()], kPolPosi);
+    }
+    Literal output(gvar[node->gid()], kPolPosi);
+    make_node_cnf(solver, network, node, output, inputs);
+  }
+
+  // f2 を検出して f1 を検出しない条件を加える．
+  bool ok = make_fault_cnf(solver, network, f2, gvar, mark2, tfo2, true);
+  if ( ok ) {
+    make_fault_cnf(solver, network, f1, gvar, mark1, tfo1, false);
+  }
+
+  ++ mSolverNum;
+  mCnfTimer.stop();
+
+  Bool3 ans = kB3X;
+  if ( ok ) {
+    mSatTimer.start();
+    vector<Bool3> model;
+    Bool3 stat = solver.solve(model);
+    mSatTimer.stop();
+    if ( stat == kB3False ) {
+      ans = kB3True;
+    }
+    else if ( stat == kB3True ) {
+      ans = kB3False;
+    }
+    solver_p->get_stats(mStats);
+  }
+
+  delete solver_p;
+
+  return ans;
+}
+
+// @brief 故障ごとに SAT ソルバを作ってテストパタン生成を行う．
+tStat
+DtpgSat::run_single(const TgNetwork& network,
+		    SaFault* f,
+		    const TestVector* cube,
+		    TestVector* tv)
+{
+  mCnfTimer.start();
+
   const TgNode* fnode = f->node();
   const TgNode* fsrc = fnode;
   if ( f->is_input_fault() ) {
     ymuint ipos = f->pos();
     fsrc = fnode->fanin(ipos);
   }
-  
+
+  // fnode の TFO とその TFI にマークをつける．
+  vector<const TgNode*> queue;
+  mark_cone(network, fnode, queue);
+
+  // 以降は kTFO か kTFI マークのついたノードのみを対象とする．
+
+  SatSolver* solver_p = new_solver();
+  SatSolver& solver = *solver_p;
+
+  // 変数の生成 (glit, flit, dlit の3つを作る)
+  // ちょっと分かりにくいが fsrc は普通のゲートにも
+  // ファンアウトしているので kTFO マークは付かない．
+  // ただし故障ゲートにファンアウトしているブランチの値
+  // は故障値なので mFid を持つ．
+  ymuint n = network.node_num();
+  for (ymuint i = 0; i < n; ++ i) {
+    const TgNode* node = network.node(i);
+    Var& var = mVarMap[node->gid()];
+    if ( var.mMark != kNone ) {
+      var.mGid = solver.new_var();
+      if ( node == fsrc || var.mMark == kTFO ) {
+	var.mFid = solver.new_var();
+	var.mDid = solver.new_var();
+      }
+    }
+  }
+
+  // 正常回路の CNF を生成
+  make_good_cnf(network, solver);
+
+  // 故障回路の CNF を生成
+  if ( f->is_input_fault() ) {
+    ymuint ipos = f->pos();
+    ymuint ni = fnode->ni();
+    vector<Literal> inputs(ni);
+    for (ymuint i = 0; i < ni; ++ i) {
+      const TgNode* inode = fnode->fanin(i);
+      if ( i == ipos ) {
+	inputs[i] = Literal(fvar(inode), kPolPosi);
+      }
+      else {
+	inputs[i] = Literal(gvar(inode), kPolPosi);
+      }
+    }
+    Literal output(fvar(fnode), kPolPosi);
+    make_node_cnf(solver, network, fnode, output, inputs);
+    Literal dlit(dvar(fnode), kPolPosi);
+    Literal glit(gvar(fnode), kPolPosi);
+    solver.add_clause(~glit, ~output, ~dlit);
+    solver.add_clause(~glit,  output,  dlit);
+    solver.add_clause( glit, ~output,  dlit);
+    solver.add_clause( glit,  output, ~dlit);
+  }
+
+  // mark の付いていないノードは正常回路，付いているノードは故障回路
+  // を用いて CNF を作る．
+  make_tfo_cnf(network, solver, queue, false);
+
+  vector<Literal> assumptions(2);
+  if ( f->val() ) {
+    assumptions[0] = Literal(gvar(fsrc), kPolNega);
+    assumptions[1] = Literal(fvar(fsrc), kPolPosi);
+  }
+  else {
+    assumptions[0] = Literal(gvar(fsrc), kPolPosi);
+    assumptions[1] = Literal(fvar(fsrc), kPolNega);
+  }
+
+  if ( f->model() == kFmTransition ) {
+    // 上の CNF を2時刻めとみなして1時刻めの CNF を追加する．
+    // 1時刻めの故障箇所の値は故障値と等しくなければならない．
+    make_prev_cnf(network, solver, fsrc);
+    if ( f->val() ) {
+      assumptions.push_back(Literal(pvar(fsrc), kPolPosi));
+    }
+    else {
+      assumptions.push_back(Literal(pvar(fsrc), kPolNega));
+    }
+  }
+
+  bool tdf = (f->model() == kFmTransition);
+  if ( cube ) {
+    // cube で値の決まっている入力を固定する．
+    // 変数の対応は get_pat() と同じ．
+    // 変数を持たない入力は f の検出に関係しない．
+    ymuint npi = network.input_num2();
+    for (ymuint i = 0; i < npi; ++ i) {
+      Val3 val = cube->val3(i);
+      ymuint idx;
+      if ( val != kValX && input_var(network.input(i), tdf, idx) ) {
+	tPol pol = (val == kVal1) ? kPolPosi : kPolNega;
+	assumptions.push_back(Literal(idx, pol));
+      }
+    }
+    if ( tdf ) {
+      ymuint ni1 = network.input_num1();
+      for (ymuint i = 0; i < ni1; ++ i) {
+	Val3 val = cube->pi2_val3(i);
+	ymuint idx;
+	if ( val != kValX && input_var(network.input(i), false, idx) ) {
+	  tPol pol = (val == kVal1) ? kPolPosi : kPolNega;
+	  assumptions.push_back(Literal(idx, pol));
+	}
+      }
+    }
+  }
+
+  ++ mSolverNum;
+  mCnfTimer.stop();
+
+  mSatTimer.start();
+  vector<Bool3> model;
+  Bool3 stat = solver.solve(assumptions, model);
+  mSatTimer.stop();
+
+  tStat ans = kAbort;
+  if ( stat == kB3True ) {
+    get_pat(network, tdf, model, tv);
+    ans = kDetect;
+  }
+  else if ( stat == kB3False ) {
+    ans = kUntest;
+  }
+
+  solver_p->get_stats(mStats);
+
+  delete solver_p;
+
+  return ans;
+}
+
+// @brief FFR ごとの SAT ソルバを使い回してテストパタン生成を行う．
+// @note FFR の根を root とすると root の TFO の故障回路は FFR 内の
+// どの故障でも同じ形をしているので，root の故障値 fvar(root) を
+// 自由変数とした CNF を一度だけ作っておく．
+// 故障ごとに異なるのは故障箇所から root までの経路上の故障値だけ
+// なので，その部分だけを新しい変数を用いてスコープ内で追加する．
+tStat
+DtpgSat::run_ffr(const TgNetwork& network,
+		 SaFault* f,
+		 TestVector* tv)
+{
+  mCnfTimer.start();
+
+  const TgNode* fnode = f->node();
+  const TgNode* fsrc = fnode;
+  if ( f->is_input_fault() ) {
+    ymuint ipos = f->pos();
+    fsrc = fnode->fanin(ipos);
+  }
+
+  const TgNode* root = ffr_root(fnode);
+  if ( mSolver == NULL || mNetwork != &network || mRoot != root ) {
+    clear();
+
+    // root の TFO とその TFI にマークをつける．
+    // FFR 内のノードは全て root の TFI に含まれる．
+    vector<const TgNode*> queue;
+    mark_cone(network, root, queue);
+
+    mSolver = new_solver();
+    mNetwork = &network;
+    mRoot = root;
+    mSolver->get_stats(mPrevStats);
+    ++ mSolverNum;
+
+    SatSolver& solver = *mSolver;
+
+    // 変数の生成
+    // TFO のノードのみ故障値と故障差の変数を持つ．
+    ymuint n = network.node_num();
+    for (ymuint i = 0; i < n; ++ i) {
+      const TgNode* node = network.node(i);
+      Var& var = mVarMap[node->gid()];
+      if ( var.mMark != kNone ) {
+	var.mGid = solver.new_var();
+	if ( var.mMark == kTFO ) {
+	  var.mFid = solver.new_var();
+	  var.mDid = solver.new_var();
+	}
+      }
+    }
+
+    // 正常回路の CNF を生成
+    make_good_cnf(network, solver);
+
+    // root の故障差
+    Literal glit(gvar(root), kPolPosi);
+    Literal flit(fvar(root), kPolPosi);
+    Literal dlit(dvar(root), kPolPosi);
+    solver.add_clause(~glit, ~flit, ~dlit);
+    solver.add_clause(~glit,  flit,  dlit);
+    solver.add_clause( glit, ~flit,  dlit);
+    solver.add_clause( glit,  flit, ~dlit);
+
+    // root 以外の TFO の故障回路の CNF を生成
+    make_tfo_cnf(network, solver, queue, true);
+  }
+
+  SatSolver& solver = *mSolver;
+
+  // ここから先の節はこの故障だけのもの
+  solver.push();
+
+  // 故障箇所の故障値
+  Literal slit;
+  const TgNode* node;
+  Literal olit;
+  if ( f->is_input_fault() ) {
+    slit = Literal(solver.new_var(), kPolPosi);
+    ymuint ipos = f->pos();
+    ymuint ni = fnode->ni();
+    vector<Literal> inputs(ni);
+    for (ymuint i = 0; i < ni; ++ i) {
+      if ( i == ipos ) {
+	inputs[i] = slit;
+      }
+      else {
+	inputs[i] = Literal(gvar(fnode->fanin(i)), kPolPosi);
+      }
+    }
+    if ( fnode == root ) {
+      olit = Literal(fvar(root), kPolPosi);
+    }
+    else {
+      olit = Literal(solver.new_var(), kPolPosi);
+    }
+    make_node_cnf(solver, network, fnode, olit, inputs);
+  }
+  else {
+    if ( fnode == root ) {
+      olit = Literal(fvar(root), kPolPosi);
+    }
+    else {
+      olit = Literal(solver.new_var(), kPolPosi);
+    }
+    slit = olit;
+  }
+
+  // fnode から root までの経路上の故障回路の CNF を生成
+  // 経路上のノードのファンアウトは一つだけなので，
+  // 経路以外のファンインは正常値となる．
+  for (node = fnode; node != root; ) {
+    const TgNode* onode = node->fanout(0);
+    ymuint ni = onode->ni();
+    vector<Literal> inputs(ni);
+    for (ymuint i = 0; i < ni; ++ i) {
+      const TgNode* inode = onode->fanin(i);
+      if ( inode == node ) {
+	inputs[i] = olit;
+      }
+      else {
+	inputs[i] = Literal(gvar(inode), kPolPosi);
+      }
+    }
+    Literal olit1;
+    if ( onode == root ) {
+      olit1 = Literal(fvar(root), kPolPosi);
+    }
+    else {
+      olit1 = Literal(solver.new_var(), kPolPosi);
+    }
+    make_node_cnf(solver, network, onode, olit1, inputs);
+    node = onode;
+    olit = olit1;
+  }
+
+  // 故障の影響は必ず root を通る．
+  vector<Literal> assumptions(3);
+  if ( f->val() ) {
+    assumptions[0] = Literal(gvar(fsrc), kPolNega);
+    assumptions[1] = slit;
+  }
+  else {
+    assumptions[0] = Literal(gvar(fsrc), kPolPosi);
+    assumptions[1] = ~slit;
+  }
+  assumptions[2] = Literal(dvar(root), kPolPosi);
+
+  mCnfTimer.stop();
+
+  mSatTimer.start();
+  vector<Bool3> model;
+  Bool3 stat = solver.solve(assumptions, model);
+  mSatTimer.stop();
+
+  tStat ans = kAbort;
+  if ( stat == kB3True ) {
+    get_pat(network, false, model, tv);
+    ans = kDetect;
+  }
+  else if ( stat == kB3False ) {
+    ans = kUntest;
+  }
+
+  solver.pop();
+
+  // 統計情報は今回の solve() の分だけにする．
+  SatStats stats;
+  solver.get_stats(stats);
+  mStats = stats;
+  mStats.mRestart -= mPrevStats.mRestart;
+  mStats.mConflictNum -= mPrevStats.mConflictNum;
+  mStats.mDecisionNum -= mPrevStats.mDecisionNum;
+  mStats.mPropagationNum -= mPrevStats.mPropagationNum;
+  mPrevStats = stats;
+
+  return ans;
+}
+
+// @brief root の TFO と その TFI にマークをつける．
+// @param[in] network 対象の回路
+// @param[in] root 起点のノード
+// @param[out] queue TFO のノードを入れるリスト
+// @note queue[0] は root となる．
+void
+DtpgSat::mark_cone(const TgNetwork& network,
+		   const TgNode* root,
+		   vector<const TgNode*>& queue)
+{
+  ymuint n = network.node_num();
+
   mVarMap.clear();
   mVarMap.resize(n);
   for (ymuint i = 0; i < n; ++ i) {
     mVarMap[i].mMark = kNone;
+    mVarMap[i].mPrev = false;
   }
-  
-  // まず fnode の TFO にマークをつける．
+
+  // まず root の TFO にマークをつける．
   // 同時にマークの付いたノードは queue につまれる．
-  vector<const TgNode*> queue;
+  queue.clear();
   queue.reserve(n);
-  mark(fnode) = kTFO;
-  queue.push_back(fnode);
+  mark(root) = kTFO;
+  queue.push_back(root);
   ymuint rpos = 0;
   while ( rpos < queue.size() ) {
     const TgNode* node = queue[rpos];
@@ -330,47 +920,34 @@ DtpgSat::run(const TgNetwork& network,
       }
     }
   }
-  
-  // 以降は kTFO か kTFI マークのついたノードのみを対象とする．
+}
 
-  SatSolver* solver_p = NULL;
+// @brief mMode に従って SAT ソルバを生成する．
+SatSolver*
+DtpgSat::new_solver()
+{
   switch ( mMode ) {
   case 0:
-    solver_p = SatSolverFactory::gen_solver();
-    break;
+    return SatSolverFactory::gen_solver();
 
   case 1:
-    solver_p = SatSolverFactory::gen_recsolver(cout);
-    break;
+    return SatSolverFactory::gen_recsolver(cout);
 
   case 2:
-    solver_p = SatSolverFactory::gen_minisat();
-    break;
+    return SatSolverFactory::gen_minisat();
 
   default:
-    solver_p = SatSolverFactory::gen_solver();
     break;
   }
-  SatSolver& solver = *solver_p;
-  
-  // 変数の生成 (glit, flit, dlit の3つを作る)
-  // ちょっと分かりにくいが fsrc は普通のゲートにも
-  // ファンアウトしているので kTFO マークは付かない．
-  // ただし故障ゲートにファンアウトしているブランチの値
-  // は故障値なので mFid を持つ．
-  for (ymuint i = 0; i < n; ++ i) {
-    const TgNode* node = network.node(i);
-    Var& var = mVarMap[node->gid()];
-    if ( var.mMark != kNone ) {
-      var.mGid = solver.new_var();
-      if ( node == fsrc || var.mMark == kTFO ) {
-	var.mFid = solver.new_var();
-	var.mDid = solver.new_var();
-      }
-    }
-  }
-  
-  // 正常回路の CNF を生成
+  return SatSolverFactory::gen_solver();
+}
+
+// @brief マークの付いたノードの正常回路の CNF を生成する．
+void
+DtpgSat::make_good_cnf(const TgNetwork& network,
+		       SatSolver& solver)
+{
+  ymuint nl = network.logic_num();
   for (ymuint i = 0; i < nl; ++ i) {
     const TgNode* node = network.sorted_logic(i);
     if ( mark(node) == kNone ) continue;
@@ -381,14 +958,9 @@ DtpgSat::run(const TgNetwork& network,
       inputs[j] = Literal(gvar(inode), kPolPosi);
     }
     Literal output(gvar(node), kPolPosi);
-    if ( node->is_cplx_logic() ) {
-      LogExpr lexp = network.get_lexp(node);
-      make_cnf(solver, lexp, output, inputs);
-    }
-    else {
-      make_cnf(solver, node->type(), output, inputs);
-    }
+    make_node_cnf(solver, network, node, output, inputs);
   }
+  ymuint npo = network.output_num2();
   for (ymuint i = 0; i < npo; ++ i) {
     const TgNode* node = network.output(i);
     if ( mark(node) == kNone ) continue;
@@ -398,42 +970,25 @@ DtpgSat::run(const TgNetwork& network,
     solver.add_clause(~input,  output);
     solver.add_clause( input, ~output);
   }
-  
-  // 故障回路の CNF を生成
-  if ( f->is_input_fault() ) {
-    ymuint ipos = f->pos();
-    fsrc = fnode->fanin(ipos);
-    ymuint ni = fnode->ni();
-    vector<Literal> inputs(ni);
-    for (ymuint i = 0; i < ni; ++ i) {
-      const TgNode* inode = fnode->fanin(i);
-      if ( i == ipos ) {
-	inputs[i] = Literal(fvar(inode), kPolPosi);
-      }
-      else {
-	inputs[i] = Literal(gvar(inode), kPolPosi);
-      }
-    }
-    Literal output(fvar(fnode), kPolPosi);
-    if ( fnode->is_cplx_logic() ) {
-      LogExpr lexp = network.get_lexp(fnode);
-      make_cnf(solver, lexp, output, inputs);
-    }
-    else {
-      make_cnf(solver, fnode->type(), output, inputs);
-    }
-    Literal dlit(dvar(fnode), kPolPosi);
-    Literal glit(gvar(fnode), kPolPosi);
-    solver.add_clause(~glit, ~output, ~dlit);
-    solver.add_clause(~glit,  output,  dlit);
-    solver.add_clause( glit, ~output,  dlit);
-    solver.add_clause( glit,  output, ~dlit);
-  }
-  
-  // mark の付いていないノードは正常回路，付いているノードは故障回路
-  // を用いて CNF を作る．
+}
+
+// @brief TFO のノードの故障回路の CNF を生成する．
+// @param[in] network 対象の回路
+// @param[in] solver SAT ソルバ
+// @param[in] queue TFO のノードのリスト
+// @param[in] root_diff queue[0] の故障差も出力の故障差に含める時 true
+// @note queue[0] の故障回路の CNF は作らない．
+void
+DtpgSat::make_tfo_cnf(const TgNetwork& network,
+		      SatSolver& solver,
+		      const vector<const TgNode*>& queue,
+		      bool root_diff)
+{
   vector<Literal> odiff;
-  odiff.reserve(npo);
+  odiff.reserve(network.output_num2());
+  if ( root_diff && queue[0]->is_output() ) {
+    odiff.push_back(Literal(dvar(queue[0]), kPolPosi));
+  }
   for (ymuint i = 1; i < queue.size(); ++ i) {
     const TgNode* node = queue[i];
     ymuint ni = node->ni();
@@ -448,13 +1003,7 @@ DtpgSat::run(const TgNetwork& network,
       }
     }
     Literal output(fvar(node), kPolPosi);
-    if ( node->is_cplx_logic() ) {
-      LogExpr lexp = network.get_lexp(node);
-      make_cnf(solver, lexp, output, inputs);
-    }
-    else {
-      make_cnf(solver, node->type(), output, inputs);
-    }
+    make_node_cnf(solver, network, node, output, inputs);
     Literal glit(gvar(node), kPolPosi);
     Literal dlit(dvar(node), kPolPosi);
     solver.add_clause(~glit, ~output, ~dlit);
@@ -476,46 +1025,128 @@ DtpgSat::run(const TgNetwork& network,
     solver.add_clause(dep);
   }
   solver.add_clause(odiff);
-  
-  vector<Literal> assumptions(2);
-  if ( f->val() ) {
-    assumptions[0] = Literal(gvar(fsrc), kPolNega);
-    assumptions[1] = Literal(fvar(fsrc), kPolPosi);
+}
+
+// @brief 1時刻めの値が必要なノードとその TFI の CNF を生成する．
+// @param[in] network 対象の回路
+// @param[in] solver SAT ソルバ
+// @param[in] fsrc 故障箇所の入力側のノード
+// @note 2時刻めの FF の出力は1時刻めの FF の入力と結びつける．
+// 2時刻めの外部入力は1時刻めとは独立な変数とする(launch-on-capture)．
+void
+DtpgSat::make_prev_cnf(const TgNetwork& network,
+		       SatSolver& solver,
+		       const TgNode* fsrc)
+{
+  ymuint ni1 = network.input_num1();
+  ymuint no1 = network.output_num1();
+  ymuint nff = network.ff_num();
+
+  vector<const TgNode*> queue;
+  add_prev(solver, fsrc, queue);
+
+  // 2時刻めの FF の出力と1時刻めの FF の入力を結びつける．
+  for (ymuint i = 0; i < nff; ++ i) {
+    const TgNode* node = network.input(ni1 + i);
+    if ( mark(node) == kNone ) continue;
+    const TgNode* onode = network.output(no1 + i);
+    add_prev(solver, onode, queue);
+    Literal glit(gvar(node), kPolPosi);
+    Literal plit(pvar(onode), kPolPosi);
+    solver.add_clause(~glit,  plit);
+    solver.add_clause( glit, ~plit);
   }
-  else {
-    assumptions[0] = Literal(gvar(fsrc), kPolPosi);
-    assumptions[1] = Literal(fvar(fsrc), kPolNega);
+
+  // queue に積まれたノードの TFI の CNF を作る．
+  for (ymuint rpos = 0; rpos < queue.size(); ++ rpos) {
+    const TgNode* node = queue[rpos];
+    if ( node->is_input() ) continue;
+    ymuint ni = node->ni();
+    vector<Literal> inputs(ni);
+    for (ymuint j = 0; j < ni; ++ j) {
+      const TgNode* inode = node->fanin(j);
+      add_prev(solver, inode, queue);
+      inputs[j] = Literal(pvar(inode), kPolPosi);
+    }
+    Literal output(pvar(node), kPolPosi);
+    if ( node->is_output() ) {
+      make_cnf(solver, kTgOutput, output, inputs);
+    }
+    else {
+      make_node_cnf(solver, network, node, output, inputs);
+    }
   }
-  
-  vector<Bool3> model;
-  Bool3 stat = solver.solve(assumptions, model);
-  tStat ans = kAbort;
-  if ( stat == kB3True ) {
-    tv->init();
-    ymuint npi = network.input_num2();
-    for (ymuint i = 0; i < npi; ++ i) {
-      const TgNode* node = network.input(i);
-      if ( mark(node) != kNone ) {
-	ymuint idx = gvar(node);
-	if ( model[idx] == kB3True ) {
-	  tv->set_val(i, kVal1);
-	}
-	else {
-	  tv->set_val(i, kVal0);
-	}
-      }
+}
+
+// @brief node に1時刻めの変数を割り当てる．
+// @note 割り当て済みの時は何もしない．
+void
+DtpgSat::add_prev(SatSolver& solver,
+		  const TgNode* node,
+		  vector<const TgNode*>& queue)
+{
+  Var& var = mVarMap[node->gid()];
+  if ( !var.mPrev ) {
+    var.mPrev = true;
+    var.mPid = solver.new_var();
+    queue.push_back(node);
+  }
+}
+
+// @brief テストベクタの入力の値に対応する変数番号を得る．
+// @param[in] node 入力ノード
+// @param[in] prev 1時刻めの値の時 true
+// @param[out] idx 変数番号
+// @return 対応する変数を持たない時(値が検出に関係しない時)は
+// false を返す．
+bool
+DtpgSat::input_var(const TgNode* node,
+		   bool prev,
+		   ymuint& idx) const
+{
+  const Var& var = mVarMap[node->gid()];
+  if ( prev ) {
+    if ( !var.mPrev ) {
+      return false;
     }
-    ans = kDetect;
+    idx = var.mPid;
   }
-  else if ( stat == kB3False ) {
-    ans = kUntest;
+  else {
+    if ( var.mMark == kNone ) {
+      return false;
+    }
+    idx = var.mGid;
   }
+  return true;
+}
 
-  solver_p->get_stats(mStats);
-  
-  delete solver_p;
-  
-  return ans;
+// @brief model から PI の値を取り出してテストベクタを作る．
+// @param[in] tdf 遷移故障の時 true
+// @note 遷移故障の時は外部入力と FF の出力の1時刻めの値を
+// val3() 側に，2時刻めの外部入力の値を pi2_val3() 側に入れる．
+void
+DtpgSat::get_pat(const TgNetwork& network,
+		 bool tdf,
+		 const vector<Bool3>& model,
+		 TestVector* tv)
+{
+  tv->init();
+  ymuint npi = network.input_num2();
+  for (ymuint i = 0; i < npi; ++ i) {
+    ymuint idx;
+    if ( input_var(network.input(i), tdf, idx) ) {
+      tv->set_val(i, (model[idx] == kB3True) ? kVal1 : kVal0);
+    }
+  }
+  if ( tdf ) {
+    ymuint ni1 = network.input_num1();
+    for (ymuint i = 0; i < ni1; ++ i) {
+      ymuint idx;
+      if ( input_var(network.input(i), false, idx) ) {
+	tv->set_pi2_val(i, (model[idx] == kB3True) ? kVal1 : kVal0);
+      }
+    }
+  }
 }
 
 // @brief 直前の実行結果を得る．
@@ -524,12 +1155,92 @@ DtpgSat::stats() const
 {
   return mStats;
 }
-  
+
 // @brief 使用する SAT エンジンを指定する．
 void
 DtpgSat::set_mode(int mode)
 {
+  if ( mMode != mode ) {
+    clear();
+  }
   mMode = mode;
 }
 
+// @brief 使用する SAT エンジンを得る．
+int
+DtpgSat::mode() const
+{
+  return mMode;
+}
+
+// @brief インクリメンタルモードを指定する．
+// @param[in] flag true の時，FFR ごとに一つの SAT ソルバを使い回す．
+void
+DtpgSat::set_incremental(bool flag)
+{
+  if ( !flag ) {
+    clear();
+  }
+  mIncremental = flag;
+}
+
+// @brief インクリメンタルモードの時 true を返す．
+bool
+DtpgSat::incremental() const
+{
+  return mIncremental;
+}
+
+// @brief 使い回している SAT ソルバを解放する．
+void
+DtpgSat::clear()
+{
+  delete mSolver;
+  mSolver = NULL;
+  mNetwork = NULL;
+  mRoot = NULL;
+}
+
+// @brief node を含む FFR の根のノードを返す．
+// @note ファンアウトがちょうど一つのノードはファンアウト先と
+// 同じ FFR に含まれる．
+const TgNode*
+DtpgSat::ffr_root(const TgNode* node)
+{
+  while ( node->fanout_num() == 1 ) {
+    node = node->fanout(0);
+  }
+  return node;
+}
+
+// @brief 時間計測用のカウンタをリセットする．
+void
+DtpgSat::reset_timer()
+{
+  mCnfTimer.reset();
+  mSatTimer.reset();
+  mSolverNum = 0;
+}
+
+// @brief CNF の生成に要した時間の累計を得る．
+USTime
+DtpgSat::cnf_time() const
+{
+  return mCnfTimer.time();
+}
+
+// @brief SAT ソルバの実行に要した時間の累計を得る．
+USTime
+DtpgSat::sat_time() const
+{
+  return mSatTimer.time();
+}
+
+// @brief 生成した SAT ソルバの数を得る．
+ymuint
+DtpgSat::solver_num() const
+{
+  return mSolverNum;
+}
+
 END_NAMESPACE_YM_ATPG_DTPGSAT
@@ -16,6 +16,7 @@
 #include "ym_tgnet/tgnet_nsdef.h"
 #include "ym_tgnet/TgNode.h"
 #include "ym_sat/SatSolver.h"
+#include "ym_utils/StopWatch.h"
 
 
 BEGIN_NAMESPACE_YM_ATPG
@@ -56,10 +57,43 @@ public:
   /// @retval kDetect パタン生成が成功した．
   /// @retval kUntest テスト不能故障だった．
   /// @retval kAbort アボートした．
+  /// @note f が遷移故障の時はインクリメンタルモードによらず
+  /// 故障ごとに2時刻分の CNF を持つ SAT ソルバを作る．
   tStat
   run(const TgNetwork& network,
       SaFault* f,
       TestVector* tv);
+
+  /// @brief 既存のパタンを拡張して故障を検出するパタンを求める．
+  /// @param[in] network 対称の回路
+  /// @param[in] f 対象の故障
+  /// @param[in] cube 値を固定する入力を表すパタン
+  /// @param[out] tv 生成したパタンを入れるベクタ
+  /// @retval kDetect パタン生成が成功した．
+  /// @retval kUntest cube のもとでは検出できなかった．
+  /// @retval kAbort アボートした．
+  /// @note cube の X でない入力の値を仮定に加えて解く．
+  /// tv の X でない入力の値は cube と矛盾しない．
+  /// インクリメンタルモードで使い回している SAT ソルバは用いない．
+  tStat
+  run_with_cube(const TgNetwork& network,
+		SaFault* f,
+		const TestVector* cube,
+		TestVector* tv);
+
+  /// @brief f2 を検出するパタンが必ず f1 も検出するか調べる．
+  /// @param[in] network 対称の回路
+  /// @param[in] f1, f2 対象の故障
+  /// @retval kB3True f1 が f2 を支配する．
+  /// @retval kB3False f2 を検出して f1 を検出しないパタンがある．
+  /// @retval kB3X アボートしたか判定できなかった．
+  /// @note 縮退故障のみを扱う．f2 を検出して f1 を検出しない
+  /// 条件の CNF が充足不能なら支配関係が成り立つ．
+  /// インクリメンタルモードで使い回している SAT ソルバは用いない．
+  Bool3
+  check_dominance(const TgNetwork& network,
+		  SaFault* f1,
+		  SaFault* f2);
   
   /// @brief 直前の実行結果を得る．
   const SatStats&
@@ -69,6 +103,55 @@ public:
   void
   set_mode(int mode);
 
+  /// @brief 使用する SAT エンジンを得る．
+  int
+  mode() const;
+
+  /// @brief インクリメンタルモードを指定する．
+  /// @param[in] flag true の時，FFR ごとに一つの SAT ソルバを使い回す．
+  /// @note インクリメンタルモードでは FFR の根の TFO と TFI の CNF を
+  /// 一度だけ作り，故障ごとに異なる FFR 内の故障回路の CNF だけを
+  /// push()/pop() のスコープ内で追加する．学習節は同じ FFR 内の故障の
+  /// 間で引き継がれるので，同じ FFR の故障を続けて処理すると速くなる．
+  void
+  set_incremental(bool flag);
+
+  /// @brief インクリメンタルモードの時 true を返す．
+  bool
+  incremental() const;
+
+  /// @brief 使い回している SAT ソルバを解放する．
+  /// @note 一連の故障の処理が終わったら呼ぶこと．
+  void
+  clear();
+
+  /// @brief node を含む FFR の根のノードを返す．
+  static
+  const TgNode*
+  ffr_root(const TgNode* node);
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 時間計測に関する関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 時間計測用のカウンタをリセットする．
+  void
+  reset_timer();
+
+  /// @brief CNF の生成に要した時間の累計を得る．
+  USTime
+  cnf_time() const;
+
+  /// @brief SAT ソルバの実行に要した時間の累計を得る．
+  USTime
+  sat_time() const;
+
+  /// @brief 生成した SAT ソルバの数を得る．
+  ymuint
+  solver_num() const;
+
   
 private:
   //////////////////////////////////////////////////////////////////////
@@ -81,6 +164,91 @@ private:
     kTFI
   };
 
+  /// @brief 故障ごとに SAT ソルバを作ってテストパタン生成を行う．
+  /// @note 遷移故障の時は1時刻めの CNF も作る．
+  /// @param[in] cube NULL でなければ X でない入力の値を仮定に加える．
+  tStat
+  run_single(const TgNetwork& network,
+	     SaFault* f,
+	     const TestVector* cube,
+	     TestVector* tv);
+
+  /// @brief FFR ごとの SAT ソルバを使い回してテストパタン生成を行う．
+  tStat
+  run_ffr(const TgNetwork& network,
+	  SaFault* f,
+	  TestVector* tv);
+
+  /// @brief root の TFO と その TFI にマークをつける．
+  /// @param[in] network 対象の回路
+  /// @param[in] root 起点のノード
+  /// @param[out] queue TFO のノードを入れるリスト
+  /// @note queue[0] は root となる．
+  void
+  mark_cone(const TgNetwork& network,
+	    const TgNode* root,
+	    vector<const TgNode*>& queue);
+
+  /// @brief mMode に従って SAT ソルバを生成する．
+  SatSolver*
+  new_solver();
+
+  /// @brief マークの付いたノードの正常回路の CNF を生成する．
+  void
+  make_good_cnf(const TgNetwork& network,
+		SatSolver& solver);
+
+  /// @brief TFO のノードの故障回路の CNF を生成する．
+  /// @param[in] network 対象の回路
+  /// @param[in] solver SAT ソルバ
+  /// @param[in] queue TFO のノードのリスト
+  /// @param[in] root_diff queue[0] の故障差も出力の故障差に含める時 true
+  /// @note queue[0] の故障回路の CNF は作らない．
+  void
+  make_tfo_cnf(const TgNetwork& network,
+	       SatSolver& solver,
+	       const vector<const TgNode*>& queue,
+	       bool root_diff);
+
+  /// @brief 1時刻めの値が必要なノードとその TFI の CNF を生成する．
+  /// @param[in] network 対象の回路
+  /// @param[in] solver SAT ソルバ
+  /// @param[in] fsrc 故障箇所の入力側のノード
+  /// @note 2時刻めの FF の出力は1時刻めの FF の入力と結びつける．
+  /// 2時刻めの外部入力は1時刻めとは独立な変数とする．
+  void
+  make_prev_cnf(const TgNetwork& network,
+		SatSolver& solver,
+		const TgNode* fsrc);
+
+  /// @brief node に1時刻めの変数を割り当てる．
+  /// @note 割り当て済みの時は何もしない．
+  void
+  add_prev(SatSolver& solver,
+	   const TgNode* node,
+	   vector<const TgNode*>& queue);
+
+  /// @brief テストベクタの入力の値に対応する変数番号を得る．
+  /// @param[in] node 入力ノード
+  /// @param[in] prev 1時刻めの値の時 true
+  /// @param[out] idx 変数番号
+  /// @return 対応する変数を持たない時(値が検出に関係しない時)は
+  /// false を返す．
+  bool
+  input_var(const TgNode* node,
+	    bool prev,
+	    ymuint& idx) const;
+
+  /// @brief model から PI の値を取り出してテストベクタを作る．
+  /// @param[in] tdf 遷移故障の時 true
+  /// @note 遷移故障の時は1時刻めの入力と2時刻めの外部入力の値を
+  /// 別々に取り出す．
+  void
+  get_pat(const TgNetwork& network,
+	  bool tdf,
+	  const vector<Bool3>& model,
+	  TestVector* tv);
+
   /// @brief マークを得る．
   Mark&
   mark(const TgNode* node);
@@ -97,6 +265,10 @@ private:
   ymuint
   dvar(const TgNode* node);
 
+  /// @brief 1時刻めの正常回路の変数番号を得る．
+  ymuint
+  pvar(const TgNode* node);
+
   
 private:
   //////////////////////////////////////////////////////////////////////
@@ -116,6 +288,12 @@ private:
 
     // 故障差の変数番号
     ymuint mDid;
+
+    // 1時刻めの変数を持つ時 true にするフラグ
+    bool mPrev;
+
+    // 1時刻めの正常回路の変数番号
+    ymuint mPid;
   };
 
 
@@ -132,9 +310,46 @@ private:
   
   // SAT のモード
   int mMode;
+
+  // インクリメンタルモード
+  bool mIncremental;
+
+  // インクリメンタルモードで使い回している SAT ソルバ
+  SatSolver* mSolver;
+
+  // mSolver が対象としている回路
+  const TgNetwork* mNetwork;
+
+  // mSolver が対象としている FFR の根
+  const TgNode* mRoot;
+
+  // mSolver の前回の実行結果
+  SatStats mPrevStats;
+
+  // CNF の生成時間を計るタイマ
+  StopWatch mCnfTimer;
+
+  // SAT ソルバの実行時間を計るタイマ
+  StopWatch mSatTimer;
+
+  // 生成した SAT ソルバの数
+  ymuint32 mSolverNum;
   
 };
 
+/// @brief ノードの入出力の関係を表す CNF クローズを生成する．
+/// @param[in] solver SAT ソルバ
+/// @param[in] network 対象の回路
+/// @param[in] node 対象のノード
+/// @param[in] output 出力リテラル
+/// @param[in] inputs 入力リテラル
+void
+make_node_cnf(SatSolver& solver,
+	      const TgNetwork& network,
+	      const TgNode* node,
+	      Literal output,
+	      const vector<Literal>& inputs);
+
 // @brief マークを得る．
 inline
 DtpgSat::Mark&
@@ -173,6 +388,16 @@ DtpgSat::dvar(const TgNode* node)
   return var.mDid;
 }
 
+// @brief 1時刻めの正常回路の変数番号を得る．
+inline
+ymuint
+DtpgSat::pvar(const TgNode* node)
+{
+  Var& var = mVarMap[node->gid()];
+  assert_cond(var.mPrev, __FILE__, __LINE__);
+  return var.mPid;
+}
+
 END_NAMESPACE_YM_ATPG_DTPGSAT
 
 #endif // MODBASE_H
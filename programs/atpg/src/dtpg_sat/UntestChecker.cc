@@ -0,0 +1,450 @@
+
+/// @file src/dtpg_sat/UntestChecker.cc
+/// @brief UntestChecker の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id: UntestChecker.cc 2203 2009-04-16 05:04:40Z matsunaga $
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "UntestChecker.h"
+#include "DtpgSat.h"
+#include "SaFault.h"
+#include "ym_tgnet/TgNetwork.h"
+#include "ym_tgnet/TgNode.h"
+
+
+BEGIN_NAMESPACE_YM_ATPG_DTPGSAT
+
+BEGIN_NONAMESPACE
+
+// 一つの含意の条件に対して記録する学習結果の上限
+const ymuint kLearnLimit = 16;
+
+// AND 系のゲートの制御値と出力の反転の有無を得る．
+// AND 系のゲートでなければ false を返す．
+bool
+and_type(const TgNode* node,
+	 Val3& cval,
+	 bool& inv)
+{
+  if ( node->is_cplx_logic() ) {
+    return false;
+  }
+  switch ( node->type() ) {
+  case kTgAnd:  cval = kVal0; inv = false; return true;
+  case kTgNand: cval = kVal0; inv = true;  return true;
+  case kTgOr:   cval = kVal1; inv = false; return true;
+  case kTgNor:  cval = kVal1; inv = true;  return true;
+  default: break;
+  }
+  return false;
+}
+
+// 学習した含意のキーを得る．
+inline
+ymuint
+imp_key(const TgNode* node,
+	Val3 val)
+{
+  return node->gid() * 2 + ((val == kVal1) ? 1 : 0);
+}
+
+// node の ipos 番め以外の入力が非制御値となる条件を加える．
+void
+add_side_cond(const TgNode* node,
+	      ymuint ipos,
+	      vector<pair<const TgNode*, Val3> >& cond)
+{
+  Val3 cval;
+  bool inv;
+  if ( !and_type(node, cval, inv) ) {
+    return;
+  }
+  ymuint ni = node->ni();
+  for (ymuint j = 0; j < ni; ++ j) {
+    if ( j != ipos ) {
+      cond.push_back(make_pair(node->fanin(j), ~cval));
+    }
+  }
+}
+
+END_NONAMESPACE
+
+
+// @brief コンストラクタ
+UntestChecker::UntestChecker() :
+  mNetwork(NULL),
+  mQpos(0),
+  mBase(0),
+  mLearnedNum(0),
+  mConstNum(0),
+  mSolver(NULL),
+  mImpUntestNum(0),
+  mSatUntestNum(0)
+{
+}
+
+// @brief デストラクタ
+UntestChecker::~UntestChecker()
+{
+  clear();
+}
+
+// @brief 内容をクリアする．
+void
+UntestChecker::clear()
+{
+  delete mSolver;
+  mSolver = NULL;
+  mNetwork = NULL;
+  mVal.clear();
+  mTrail.clear();
+  mQpos = 0;
+  mBase = 0;
+  mImpList.clear();
+  mLearnedNum = 0;
+  mConstNum = 0;
+  mVarMap.clear();
+  mImpUntestNum = 0;
+  mSatUntestNum = 0;
+}
+
+// @brief 対象の回路を設定して学習を行う．
+// @param[in] network 対象の回路
+// @param[in] sat_mode SAT エンジンの種類
+// @param[in] max_conflict SAT ソルバのコンフリクト数の上限
+void
+UntestChecker::set_network(const TgNetwork& network,
+			   int sat_mode,
+			   ymuint max_conflict)
+{
+  clear();
+
+  mNetwork = &network;
+  ymuint n = network.node_num();
+  mVal.resize(n, kValX);
+  mTrail.reserve(n);
+  mImpList.resize(n * 2);
+
+  learn();
+
+  switch ( sat_mode ) {
+  case 1:
+    mSolver = SatSolverFactory::gen_recsolver(cout);
+    break;
+
+  case 2:
+    mSolver = SatSolverFactory::gen_minisat();
+    break;
+
+  default:
+    mSolver = SatSolverFactory::gen_solver();
+    break;
+  }
+  SatSolver& solver = *mSolver;
+
+  // 正常回路の CNF を一度だけ作る．
+  mVarMap.resize(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    mVarMap[i] = solver.new_var();
+  }
+  for (ymuint i = 0; i < n; ++ i) {
+    const TgNode* node = network.node(i);
+    if ( node->is_input() ) {
+      continue;
+    }
+    ymuint ni = node->ni();
+    vector<Literal> inputs(ni);
+    for (ymuint j = 0; j < ni; ++ j) {
+      inputs[j] = Literal(mVarMap[node->fanin(j)->gid()], kPolPosi);
+    }
+    Literal output(mVarMap[node->gid()], kPolPosi);
+    make_node_cnf(solver, network, node, output, inputs);
+  }
+  // 学習で見つけた定数を加えておく．
+  for (ymuint i = 0; i < mBase; ++ i) {
+    const TgNode* node = mTrail[i];
+    tPol pol = (mVal[node->gid()] == kVal1) ? kPolPosi : kPolNega;
+    solver.add_clause(Literal(mVarMap[node->gid()], pol));
+  }
+  solver.set_max_conflict(max_conflict);
+}
+
+// @brief 静的学習を行う．
+// @note SOCRATES と同様に，node = val の含意操作の結果 AND 系の
+// ゲートの出力が制御された値になったら，その対偶を記録する．
+// 矛盾が起きた場合は node は反対の値の定数となる．
+void
+UntestChecker::learn()
+{
+  const TgNetwork& network = *mNetwork;
+  ymuint n = network.node_num();
+  for (ymuint i = 0; i < n; ++ i) {
+    const TgNode* node = network.node(i);
+    if ( node->is_output() ) {
+      continue;
+    }
+    if ( node->ni() < 2 && node->fanout_num() < 2 ) {
+      continue;
+    }
+    for (ymuint b = 0; b < 2; ++ b) {
+      Val3 val = (b == 0) ? kVal0 : kVal1;
+      if ( mVal[node->gid()] != kValX ) {
+	break;
+      }
+      ymuint pos = mTrail.size();
+      if ( !assign(node, val) || !propagate() ) {
+	backtrack(pos);
+	if ( assign(node, ~val) && propagate() ) {
+	  ++ mConstNum;
+	}
+	else {
+	  backtrack(pos);
+	}
+	continue;
+      }
+      ymuint nl = 0;
+      for (ymuint j = pos + 1; j < mTrail.size() && nl < kLearnLimit; ++ j) {
+	const TgNode* node1 = mTrail[j];
+	Val3 cval;
+	bool inv;
+	if ( !and_type(node1, cval, inv) ) {
+	  continue;
+	}
+	Val3 val1 = mVal[node1->gid()];
+	if ( val1 != (inv ? ~cval : cval) ) {
+	  continue;
+	}
+	mImpList[imp_key(node1, ~val1)].push_back(make_pair(node, ~val));
+	++ mLearnedNum;
+	++ nl;
+      }
+      backtrack(pos);
+    }
+  }
+  mBase = mTrail.size();
+}
+
+// @brief f が検出不能か調べる．
+bool
+UntestChecker::check(SaFault* f)
+{
+  vector<pair<const TgNode*, Val3> > cond;
+  if ( !make_cond(f, cond) ) {
+    ++ mImpUntestNum;
+    return true;
+  }
+
+  bool ok = true;
+  for (vector<pair<const TgNode*, Val3> >::iterator p = cond.begin();
+       p != cond.end(); ++ p) {
+    if ( !assign(p->first, p->second) ) {
+      ok = false;
+      break;
+    }
+  }
+  if ( ok ) {
+    ok = propagate();
+  }
+  backtrack(mBase);
+  if ( !ok ) {
+    ++ mImpUntestNum;
+    return true;
+  }
+
+  if ( mSolver == NULL ) {
+    return false;
+  }
+  vector<Literal> assumptions;
+  assumptions.reserve(cond.size());
+  for (vector<pair<const TgNode*, Val3> >::iterator p = cond.begin();
+       p != cond.end(); ++ p) {
+    tPol pol = (p->second == kVal1) ? kPolPosi : kPolNega;
+    assumptions.push_back(Literal(mVarMap[p->first->gid()], pol));
+  }
+  vector<Bool3> model;
+  if ( mSolver->solve(assumptions, model) == kB3False ) {
+    ++ mSatUntestNum;
+    return true;
+  }
+  return false;
+}
+
+// @brief f の検出に必要な値の割り当てを求める．
+// @note 故障箇所の値が故障値と異なることと，故障箇所から FFR の
+// 根までの唯一の経路上のゲートの側入力が非制御値であることが必要．
+bool
+UntestChecker::make_cond(SaFault* f,
+			 vector<pair<const TgNode*, Val3> >& cond)
+{
+  const TgNode* fnode = f->node();
+  cond.push_back(make_pair(f->source_node(), ~f->val3()));
+  if ( f->is_input_fault() ) {
+    add_side_cond(fnode, f->pos(), cond);
+  }
+  for (const TgNode* node = fnode; !node->is_output(); ) {
+    ymuint nfo = node->fanout_num();
+    if ( nfo == 0 ) {
+      // どの外部出力にも到達しない．
+      return false;
+    }
+    if ( nfo > 1 ) {
+      break;
+    }
+    const TgEdge* e = node->fanout_edge(0);
+    const TgNode* onode = e->to_node();
+    add_side_cond(onode, e->to_ipos(), cond);
+    node = onode;
+  }
+  return true;
+}
+
+// @brief 値を割り当てる．
+bool
+UntestChecker::assign(const TgNode* node,
+		      Val3 val)
+{
+  Val3& cur = mVal[node->gid()];
+  if ( cur == kValX ) {
+    cur = val;
+    mTrail.push_back(node);
+    return true;
+  }
+  return cur == val;
+}
+
+// @brief 割り当てた値の含意操作を行う．
+bool
+UntestChecker::propagate()
+{
+  while ( mQpos < mTrail.size() ) {
+    const TgNode* node = mTrail[mQpos];
+    ++ mQpos;
+    if ( !imply_gate(node) ) {
+      return false;
+    }
+    ymuint nfo = node->fanout_num();
+    for (ymuint i = 0; i < nfo; ++ i) {
+      if ( !imply_gate(node->fanout(i)) ) {
+	return false;
+      }
+    }
+    const vector<pair<const TgNode*, Val3> >& imp_list
+      = mImpList[imp_key(node, mVal[node->gid()])];
+    for (vector<pair<const TgNode*, Val3> >::const_iterator p = imp_list.begin();
+	 p != imp_list.end(); ++ p) {
+      if ( !assign(p->first, p->second) ) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
+// @brief node の入出力の値から含意を行う．
+bool
+UntestChecker::imply_gate(const TgNode* node)
+{
+  if ( node->is_input() ) {
+    return true;
+  }
+  if ( node->is_output() ||
+       (!node->is_cplx_logic() &&
+	(node->type() == kTgBuff || node->type() == kTgNot)) ) {
+    const TgNode* inode = node->fanin(0);
+    bool inv = !node->is_output() && node->type() == kTgNot;
+    Val3 ival = mVal[inode->gid()];
+    if ( ival != kValX ) {
+      return assign(node, inv ? ~ival : ival);
+    }
+    Val3 oval = mVal[node->gid()];
+    if ( oval != kValX ) {
+      return assign(inode, inv ? ~oval : oval);
+    }
+    return true;
+  }
+
+  Val3 cval;
+  bool inv;
+  if ( !and_type(node, cval, inv) ) {
+    return true;
+  }
+  Val3 c_out = inv ? ~cval : cval;
+  ymuint ni = node->ni();
+  ymuint nx = 0;
+  const TgNode* xnode = NULL;
+  for (ymuint j = 0; j < ni; ++ j) {
+    const TgNode* inode = node->fanin(j);
+    Val3 ival = mVal[inode->gid()];
+    if ( ival == cval ) {
+      return assign(node, c_out);
+    }
+    if ( ival == kValX ) {
+      ++ nx;
+      xnode = inode;
+    }
+  }
+  if ( nx == 0 ) {
+    return assign(node, ~c_out);
+  }
+  Val3 oval = mVal[node->gid()];
+  if ( oval == ~c_out ) {
+    // 全ての入力が非制御値となる．
+    for (ymuint j = 0; j < ni; ++ j) {
+      if ( !assign(node->fanin(j), ~cval) ) {
+	return false;
+      }
+    }
+  }
+  else if ( oval == c_out && nx == 1 ) {
+    // 残った入力が制御値となる．
+    return assign(xnode, cval);
+  }
+  return true;
+}
+
+// @brief 割り当てを pos の時点まで戻す．
+void
+UntestChecker::backtrack(ymuint pos)
+{
+  for (ymuint i = pos; i < mTrail.size(); ++ i) {
+    mVal[mTrail[i]->gid()] = kValX;
+  }
+  mTrail.erase(mTrail.begin() + pos, mTrail.end());
+  if ( mQpos > pos ) {
+    mQpos = pos;
+  }
+}
+
+// @brief 学習した含意の数を得る．
+ymuint
+UntestChecker::learned_num() const
+{
+  return mLearnedNum;
+}
+
+// @brief 学習で見つけた定数ノードの数を得る．
+ymuint
+UntestChecker::const_num() const
+{
+  return mConstNum;
+}
+
+// @brief 含意操作だけで検出不能とわかった故障数を得る．
+ymuint
+UntestChecker::imp_untest_num() const
+{
+  return mImpUntestNum;
+}
+
+// @brief SAT で検出不能とわかった故障数を得る．
+ymuint
+UntestChecker::sat_untest_num() const
+{
+  return mSatUntestNum;
+}
+
+END_NAMESPACE_YM_ATPG_DTPGSAT
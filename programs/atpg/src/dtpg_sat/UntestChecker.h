@@ -0,0 +1,173 @@
+#ifndef UNTESTCHECKER_H
+#define UNTESTCHECKER_H
+
+/// @file src/dtpg_sat/UntestChecker.h
+/// @brief UntestChecker のヘッダファイル
+///
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id: UntestChecker.h 2203 2009-04-16 05:04:40Z matsunaga $
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "dtpgsat_nsdef.h"
+#include "Val3.h"
+#include "ym_tgnet/tgnet_nsdef.h"
+#include "ym_tgnet/TgNode.h"
+#include "ym_sat/SatSolver.h"
+
+
+BEGIN_NAMESPACE_YM_ATPG
+
+class SaFault;
+
+END_NAMESPACE_YM_ATPG
+
+BEGIN_NAMESPACE_YM_ATPG_DTPGSAT
+
+//////////////////////////////////////////////////////////////////////
+/// @class UntestChecker UntestChecker.h "UntestChecker.h"
+/// @brief 故障ごとの探索をせずに検出不能故障を見つけるクラス
+/// @note 正常回路だけを用いて，故障の活性化と FFR 内の伝搬に
+/// 必要な値の割り当てが矛盾することを示す．
+/// まず静的学習で得た含意を含めた含意操作で調べ，矛盾が
+/// 見つからなければ正常回路の CNF を一度だけ作った SAT ソルバに
+/// 割り当てを仮定として与えて調べる．
+/// 遷移故障の場合も2時刻めの条件として同じ判定が成り立つ．
+//////////////////////////////////////////////////////////////////////
+class UntestChecker
+{
+public:
+
+  /// @brief コンストラクタ
+  UntestChecker();
+
+  /// @brief デストラクタ
+  ~UntestChecker();
+
+
+public:
+
+  /// @brief 対象の回路を設定して学習を行う．
+  /// @param[in] network 対象の回路
+  /// @param[in] sat_mode SAT エンジンの種類 (DtpgSat::set_mode() と同じ)
+  /// @param[in] max_conflict SAT ソルバのコンフリクト数の上限
+  void
+  set_network(const TgNetwork& network,
+	      int sat_mode,
+	      ymuint max_conflict = 1000);
+
+  /// @brief f が検出不能か調べる．
+  /// @retval true 検出不能であることが示せた．
+  /// @retval false 示せなかった．
+  bool
+  check(SaFault* f);
+
+  /// @brief 学習した含意の数を得る．
+  ymuint
+  learned_num() const;
+
+  /// @brief 学習で見つけた定数ノードの数を得る．
+  ymuint
+  const_num() const;
+
+  /// @brief 含意操作だけで検出不能とわかった故障数を得る．
+  ymuint
+  imp_untest_num() const;
+
+  /// @brief SAT で検出不能とわかった故障数を得る．
+  ymuint
+  sat_untest_num() const;
+
+  /// @brief 内容をクリアする．
+  void
+  clear();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 下請け関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 静的学習を行う．
+  void
+  learn();
+
+  /// @brief 値を割り当てる．
+  /// @return 矛盾が起きたら false を返す．
+  bool
+  assign(const TgNode* node,
+	 Val3 val);
+
+  /// @brief 割り当てた値の含意操作を行う．
+  /// @return 矛盾が起きたら false を返す．
+  bool
+  propagate();
+
+  /// @brief node の入出力の値から含意を行う．
+  /// @return 矛盾が起きたら false を返す．
+  bool
+  imply_gate(const TgNode* node);
+
+  /// @brief 割り当てを pos の時点まで戻す．
+  void
+  backtrack(ymuint pos);
+
+  /// @brief f の検出に必要な値の割り当てを求める．
+  /// @param[in] f 対象の故障
+  /// @param[out] cond (ノード, 値) のリスト
+  /// @return 外部出力に到達できない時は false を返す．
+  bool
+  make_cond(SaFault* f,
+	    vector<pair<const TgNode*, Val3> >& cond);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 対象の回路
+  const TgNetwork* mNetwork;
+
+  // ノードごとの値
+  vector<Val3> mVal;
+
+  // 値を割り当てたノードのリスト
+  vector<const TgNode*> mTrail;
+
+  // mTrail のうち含意操作の済んだ位置
+  ymuint mQpos;
+
+  // 定数の割り当てを含む基準の位置
+  ymuint mBase;
+
+  // 学習した含意
+  // (ノード番号 * 2 + 値) をキーとして含意される (ノード, 値) を持つ．
+  vector<vector<pair<const TgNode*, Val3> > > mImpList;
+
+  // 学習した含意の数
+  ymuint mLearnedNum;
+
+  // 定数ノードの数
+  ymuint mConstNum;
+
+  // 正常回路の CNF を持つ SAT ソルバ
+  SatSolver* mSolver;
+
+  // ノードごとの変数番号
+  vector<tVarId> mVarMap;
+
+  // 含意操作で検出不能とわかった故障数
+  ymuint mImpUntestNum;
+
+  // SAT で検出不能とわかった故障数
+  ymuint mSatUntestNum;
+
+};
+
+END_NAMESPACE_YM_ATPG_DTPGSAT
+
+#endif // UNTESTCHECKER_H
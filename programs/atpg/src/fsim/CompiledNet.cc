@@ -0,0 +1,195 @@
+
+/// @file fsim/CompiledNet.cc
+/// @brief CompiledNet の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+/// 
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "CompiledNet.h"
+#include "SimNode.h"
+
+
+BEGIN_NAMESPACE_YM_ATPG_FSIM
+
+//////////////////////////////////////////////////////////////////////
+// 正常値計算用に平坦化したネットワーク
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+CompiledNet::CompiledNet() :
+  mInputNum(0)
+{
+}
+
+// @brief デストラクタ
+CompiledNet::~CompiledNet()
+{
+}
+
+// @brief 内容をクリアする．
+void
+CompiledNet::clear()
+{
+  mInputNum = 0;
+  mOpArray.clear();
+  mFaninBegin.clear();
+  mFaninArray.clear();
+  mPosArray.clear();
+  mValArray.clear();
+}
+
+// @brief SimNode のネットワークから命令列を作る．
+// @param[in] node_array ID 番号順に並んだ全てのノードの配列
+// @param[in] type_array 各ノードのゲートの種類
+// @param[in] input_array 外部入力のノードの配列
+void
+CompiledNet::set(const vector<SimNode*>& node_array,
+		 const vector<tTgGateType>& type_array,
+		 const vector<SimNode*>& input_array)
+{
+  clear();
+
+  ymuint node_num = node_array.size();
+  mInputNum = input_array.size();
+
+  // レベルごとにバケツに分ける．
+  ymuint max_level = 0;
+  for (ymuint i = 0; i < node_num; ++ i) {
+    ymuint level = node_array[i]->level();
+    if ( max_level < level ) {
+      max_level = level;
+    }
+  }
+  vector<vector<SimNode*> > level_list(max_level + 1);
+  for (ymuint i = 0; i < node_num; ++ i) {
+    SimNode* node = node_array[i];
+    if ( type_array[i] != kTgInput ) {
+      level_list[node->level()].push_back(node);
+    }
+  }
+
+  // 外部入力を先頭に，論理ノードをレベル順に並べる．
+  mPosArray.resize(node_num);
+  for (ymuint i = 0; i < mInputNum; ++ i) {
+    mPosArray[input_array[i]->id()] = i;
+  }
+  ymuint pos = mInputNum;
+  for (ymuint level = 0; level <= max_level; ++ level) {
+    const vector<SimNode*>& node_list = level_list[level];
+    for (vector<SimNode*>::const_iterator p = node_list.begin();
+	 p != node_list.end(); ++ p) {
+      mPosArray[(*p)->id()] = pos;
+      ++ pos;
+    }
+  }
+  mValArray.resize(pos, kPvAll0);
+
+  // 命令列を作る．
+  ymuint op_num = pos - mInputNum;
+  mOpArray.reserve(op_num);
+  mFaninBegin.reserve(op_num + 1);
+  mFaninBegin.push_back(0);
+  for (ymuint level = 0; level <= max_level; ++ level) {
+    const vector<SimNode*>& node_list = level_list[level];
+    for (vector<SimNode*>::const_iterator p = node_list.begin();
+	 p != node_list.end(); ++ p) {
+      SimNode* node = *p;
+      tOpCode op = kOpBuff;
+      switch ( type_array[node->id()] ) {
+      case kTgBuff: op = kOpBuff; break;
+      case kTgNot:  op = kOpNot;  break;
+      case kTgAnd:  op = kOpAnd;  break;
+      case kTgNand: op = kOpNand; break;
+      case kTgOr:   op = kOpOr;   break;
+      case kTgNor:  op = kOpNor;  break;
+      case kTgXor:  op = kOpXor;  break;
+      case kTgXnor: op = kOpXnor; break;
+      default:
+	assert_not_reached(__FILE__, __LINE__);
+      }
+      mOpArray.push_back(op);
+      ymuint ni = node->nfi();
+      for (ymuint i = 0; i < ni; ++ i) {
+	mFaninArray.push_back(mPosArray[node->fanin(i)->id()]);
+      }
+      mFaninBegin.push_back(mFaninArray.size());
+    }
+  }
+}
+
+// @brief 全ての論理ノードの正常値を計算する．
+void
+CompiledNet::eval()
+{
+  ymuint op_num = mOpArray.size();
+  if ( op_num == 0 ) {
+    return;
+  }
+  PackedVal* val_array = &mValArray[0];
+  PackedVal* dst = val_array + mInputNum;
+  const ymuint8* op_array = &mOpArray[0];
+  const ymuint32* begin_array = &mFaninBegin[0];
+  const ymuint32* fanin_array = &mFaninArray[0];
+  for (ymuint k = 0; k < op_num; ++ k, ++ dst) {
+    const ymuint32* p = fanin_array + begin_array[k];
+    const ymuint32* e = fanin_array + begin_array[k + 1];
+    PackedVal val = val_array[*p];
+    switch ( op_array[k] ) {
+    case kOpBuff:
+      *dst = val;
+      break;
+
+    case kOpNot:
+      *dst = ~val;
+      break;
+
+    case kOpAnd:
+      for (++ p; p != e; ++ p) {
+	val &= val_array[*p];
+      }
+      *dst = val;
+      break;
+
+    case kOpNand:
+      for (++ p; p != e; ++ p) {
+	val &= val_array[*p];
+      }
+      *dst = ~val;
+      break;
+
+    case kOpOr:
+      for (++ p; p != e; ++ p) {
+	val |= val_array[*p];
+      }
+      *dst = val;
+      break;
+
+    case kOpNor:
+      for (++ p; p != e; ++ p) {
+	val |= val_array[*p];
+      }
+      *dst = ~val;
+      break;
+
+    case kOpXor:
+      for (++ p; p != e; ++ p) {
+	val ^= val_array[*p];
+      }
+      *dst = val;
+      break;
+
+    case kOpXnor:
+      for (++ p; p != e; ++ p) {
+	val ^= val_array[*p];
+      }
+      *dst = ~val;
+      break;
+    }
+  }
+}
+
+END_NAMESPACE_YM_ATPG_FSIM
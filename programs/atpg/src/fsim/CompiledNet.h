@@ -0,0 +1,142 @@
+#ifndef FSIM_COMPILEDNET_H
+#define FSIM_COMPILEDNET_H
+
+/// @file fsim/CompiledNet.h
+/// @brief CompiledNet のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+/// 
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "fsim_nsdef.h"
+#include "PackedVal.h"
+#include "ym_tgnet/TgGateTemplate.h"
+
+
+BEGIN_NAMESPACE_YM_ATPG_FSIM
+
+class SimNode;
+
+//////////////////////////////////////////////////////////////////////
+/// @class CompiledNet CompiledNet.h "CompiledNet.h"
+/// @brief 正常値計算用に平坦化したネットワーク
+///
+/// SimNode のネットワークをレベル順に並べ直し，ゲートの種類，
+/// ファンインの番号，値をそれぞれ連続した配列に持つ．
+/// 正常値の計算は仮想関数を使わずに一つのループで行う．
+/// 値の配列はレベル順に並んでいるので，外部入力の値は先頭に，
+/// i 番めの命令の結果は入力数 + i 番めに置かれる．
+//////////////////////////////////////////////////////////////////////
+class CompiledNet
+{
+public:
+
+  /// @brief コンストラクタ
+  CompiledNet();
+
+  /// @brief デストラクタ
+  ~CompiledNet();
+
+
+public:
+
+  /// @brief 内容をクリアする．
+  void
+  clear();
+
+  /// @brief SimNode のネットワークから命令列を作る．
+  /// @param[in] node_array ID 番号順に並んだ全てのノードの配列
+  /// @param[in] type_array 各ノードのゲートの種類
+  /// @param[in] input_array 外部入力のノードの配列
+  void
+  set(const vector<SimNode*>& node_array,
+      const vector<tTgGateType>& type_array,
+      const vector<SimNode*>& input_array);
+
+  /// @brief pos 番めの外部入力の値を設定する．
+  void
+  set_input(ymuint pos,
+	    const PackedVal& val);
+
+  /// @brief 全ての論理ノードの正常値を計算する．
+  void
+  eval();
+
+  /// @brief ノードの正常値を得る．
+  /// @param[in] id ノードの ID 番号
+  const PackedVal&
+  val(ymuint id) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 命令コード
+  //////////////////////////////////////////////////////////////////////
+
+  enum tOpCode {
+    kOpBuff,
+    kOpNot,
+    kOpAnd,
+    kOpNand,
+    kOpOr,
+    kOpNor,
+    kOpXor,
+    kOpXnor
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 外部入力数
+  ymuint mInputNum;
+
+  // 命令コードの配列
+  vector<ymuint8> mOpArray;
+
+  // 各命令のファンインの開始位置の配列
+  // 命令数 + 1 の要素を持つ．
+  vector<ymuint32> mFaninBegin;
+
+  // ファンインの値の位置を並べた配列
+  vector<ymuint32> mFaninArray;
+
+  // ノードの ID 番号から値の位置を得る配列
+  vector<ymuint32> mPosArray;
+
+  // 値の配列
+  vector<PackedVal> mValArray;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief pos 番めの外部入力の値を設定する．
+inline
+void
+CompiledNet::set_input(ymuint pos,
+		       const PackedVal& val)
+{
+  mValArray[pos] = val;
+}
+
+// @brief ノードの正常値を得る．
+// @param[in] id ノードの ID 番号
+inline
+const PackedVal&
+CompiledNet::val(ymuint id) const
+{
+  return mValArray[mPosArray[id]];
+}
+
+END_NAMESPACE_YM_ATPG_FSIM
+
+#endif // FSIM_COMPILEDNET_H
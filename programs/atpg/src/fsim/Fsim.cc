@@ -17,6 +17,7 @@
 #include "SaFault.h"
 #include "TestVector.h"
 #include "ym_utils/StopWatch.h"
+#include <algorithm>
 
 
 BEGIN_NAMESPACE_YM_ATPG_FSIM
@@ -32,6 +33,9 @@ clear_lobs(SimNode* node)
   }
 }
 
+// get_ffr_range() で一度に取り出す FFR の数
+const ymuint kFFRChunk = 16;
+
 END_NONAMESPACE
 
 //////////////////////////////////////////////////////////////////////
@@ -39,7 +43,16 @@ END_NONAMESPACE
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-Fsim::Fsim()
+Fsim::Fsim() :
+  mNetwork(NULL),
+  mTdMode(false),
+  mMaxLevel(0),
+  mThreadNum(1),
+  mRunMode(kRunSingle),
+  mNextFFR(0),
+  mNextGroup(0),
+  mSeqFrame(0),
+  mPatNum(0)
 {
 }
 
@@ -49,6 +62,30 @@ Fsim::~Fsim()
   clear();
 }
   
+// @brief 故障シミュレーションに用いるスレッド数を設定する．
+// @param[in] num スレッド数
+// @note 1 の時はスレッドを作らずに呼び出し元で実行する．
+void
+Fsim::set_thread_num(ymuint num)
+{
+  if ( num == 0 ) {
+    num = 1;
+  }
+  if ( mThreadNum != num ) {
+    mThreadNum = num;
+    if ( mNetwork ) {
+      make_workers();
+    }
+  }
+}
+
+// @brief 故障シミュレーションに用いるスレッド数を返す．
+ymuint
+Fsim::thread_num() const
+{
+  return mThreadNum;
+}
+
 // @brief 対象の故障をセットする
 // @param[in] flist 対象の故障リスト
 void
@@ -57,6 +94,13 @@ Fsim::set_faults(const vector<SaFault*>& flist)
   clear_faults();
   
   ymuint n = flist.size();
+  mTdMode = false;
+  for (ymuint i = 0; i < n; ++ i) {
+    if ( flist[i]->model() == kFmTransition ) {
+      mTdMode = true;
+      break;
+    }
+  }
   mFsimFaults.resize(n);
   for (ymuint i = 0; i < n; ++ i) {
     SaFault* f = flist[i];
@@ -92,75 +136,25 @@ Fsim::run(TestVector* tv,
   
   // tv を全ビットにセットしていく．
   for (ymuint i = 0; i < npi; ++ i) {
-    SimNode* simnode = mInputArray[i];
     PackedVal val = (tv->val3(i) == kVal1) ? kPvAll1 : kPvAll0;
-    simnode->set_gval(val);
+    mCompiledNet.set_input(i, val);
+  }
+  if ( mTdMode ) {
+    ymuint ni1 = mNetwork->input_num1();
+    for (ymuint i = 0; i < ni1; ++ i) {
+      mPi2ValArray[i] = (tv->pi2_val3(i) == kVal1) ? kPvAll1 : kPvAll0;
+    }
   }
   
   // 正常値の計算を行う．
-  for (vector<SimNode*>::iterator q = mLogicArray.begin();
-       q != mLogicArray.end(); ++ q) {
-    SimNode* node = *q;
-    node->calc_gval2();
-  }
+  calc_gval();
 
-  ymuint bitpos = 0;
-  SimFFR* ffr_buff[kPvBitLen];
-  // FFR ごとに処理を行う．
-  for (vector<SimFFR>::iterator p = mFFRArray.begin();
-       p != mFFRArray.end(); ++ p) {
-    SimFFR* ffr = &(*p);
-    if ( ffr->fault_list().empty() ) continue;
-    
-    // FFR 内の故障伝搬を行う．
-    // 結果は FsimFault.mObsMask に保存される．
-    // FFR 内の全ての obs マスクを ffr_req に入れる．
-    // 検出済みの故障は ffr->fault_list() から取り除かれる．
-    PackedVal ffr_req = ffr_simulate(ffr);
-
-    // ffr_req が 0 ならその後のシミュレーションを行う必要はない．
-    if ( ffr_req == kPvAll0 ) {
-      continue;
-    }
-
-    SimNode* root = ffr->root();
-    if ( root->is_output() ) {
-      // 常に観測可能
-      fault_sweep(ffr, det_faults);
-      continue;
-    }
+  // FFR ごとの処理はワーカーに任せる．
+  run_workers(kRunSingle);
 
-    // キューに積んでおく
-    PackedVal bitmask = 1UL << bitpos;
-    PackedVal pat = root->gval() ^ bitmask;
-    root->set_fval(pat);
-    root->set_fmask(~bitmask);
-
-    mClearArray.push_back(root);
-    ymuint no = root->nfo();
-    for (ymuint i = 0; i < no; ++ i) {
-      mEventQ.put(root->fanout(i));
-    }
-    ffr_buff[bitpos] = ffr;
-
-    ++ bitpos;
-    if ( bitpos == kPvBitLen ) {
-      PackedVal obs = eventq_simulate();
-      for (ymuint i = 0; i < kPvBitLen; ++ i, obs >>= 1) {
-	if ( obs & 1UL ) {
-	  fault_sweep(ffr_buff[i], det_faults);
-	}
-      }
-      bitpos = 0;
-    }
-  }
-  if ( bitpos > 0 ) {
-    PackedVal obs = eventq_simulate();
-    for (ymuint i = 0; i < bitpos; ++ i, obs >>= 1) {
-      if ( obs & 1UL ) {
-	fault_sweep(ffr_buff[i], det_faults);
-      }
-    }
+  for (vector<DetInfo>::iterator p = mDetList.begin();
+       p != mDetList.end(); ++ p) {
+    det_faults.push_back(p->mFault);
   }
 }
 
@@ -182,93 +176,49 @@ Fsim::run(const vector<TestVector*>& tv_array,
   // tv_array を入力ごとに固めてセットしていく．
   for (ymuint i = 0; i < npi; ++ i) {
     PackedVal val = kPvAll0;
-    PackedVal bit = 1UL;
-    for (ymuint j = 0; j < nb; ++ j, bit <<= 1) {
+    for (ymuint j = 0; j < nb; ++ j) {
       if ( tv_array[j]->val3(i) == kVal1 ) {
-	val |= bit;
+	val.set_bit(j);
       }
     }
     // 残ったビットには 0 番めのパタンを詰めておく．
     if ( tv_array[0]->val3(i) == kVal1 ) {
-      for (ymuint j = nb; j < kPvBitLen; ++ j, bit <<= 1) {
-	val |= bit;
+      for (ymuint j = nb; j < kPvBitLen; ++ j) {
+	val.set_bit(j);
       }
     }
-    SimNode* simnode = mInputArray[i];
-    simnode->set_gval(val);
-  }
-  
-  // 正常値の計算を行う．
-  for (vector<SimNode*>::iterator q = mLogicArray.begin();
-       q != mLogicArray.end(); ++ q) {
-    SimNode* node = *q;
-    node->calc_gval2();
+    mCompiledNet.set_input(i, val);
   }
-  
-  // FFR ごとに処理を行う．
-  for (vector<SimFFR>::iterator p = mFFRArray.begin();
-       p != mFFRArray.end(); ++ p) {
-    SimFFR* ffr = &(*p);
-    if ( ffr->fault_list().empty() ) continue;
-    
-    // FFR 内の故障伝搬を行う．
-    // 結果は FsimFault.mObsMask に保存される．
-    // FFR 内の全ての obs マスクを ffr_req に入れる．
-    // 検出済みの故障は ffr->fault_list() から取り除かれる．
-    PackedVal ffr_req = ffr_simulate(ffr);
-
-    // ffr_req が 0 ならその後のシミュレーションを行う必要はない．
-    if ( ffr_req == kPvAll0 ) {
-      continue;
-    }
-    
-    // FFR の出力の故障伝搬を行う．
-    SimNode* root = ffr->root();
-    PackedVal obs = kPvAll0;
-    if ( root->is_output() ) {
-      obs = kPvAll1;
-    }
-    else {
-      PackedVal pat = root->gval() ^ ffr_req;
-      root->set_fval(pat);
-      mClearArray.clear();
-      mClearArray.push_back(root);
-      ymuint no = root->nfo();
-      for (ymuint i = 0; i < no; ++ i) {
-	mEventQ.put(root->fanout(i));
-      }
-      obs = eventq_simulate();
-    }
-    
-    // obs と各々の故障の mObsMask との AND が 0 でなければ故障検出
-    // できたということ．対応するテストベクタを記録する．
-    // また，検出済みとなった故障をリストから取り除く
-    vector<FsimFault*>& flist = ffr->fault_list();
-    ymuint fnum = flist.size();
-    ymuint wpos = 0;
-    for (ymuint rpos = 0; rpos < fnum; ++ rpos) {
-      FsimFault* ff = flist[rpos];
-      SaFault* f = ff->mOrigF;
-      if ( f->status() == kFsUndetected || f->status() == kFsAbort ) {
-	PackedVal dbits = obs & ff->mObsMask;
-	if ( dbits ) {
-	  ymuint l;
-	  for (l = 0; (dbits & 1UL) == kPvAll0; ++ l, dbits >>= 1) ;
-	  assert_cond(l < nb, __FILE__, __LINE__);
-	  det_faults[l].push_back(f);
+  if ( mTdMode ) {
+    // 2時刻めの外部入力の値も同様に固めておく．
+    ymuint ni1 = mNetwork->input_num1();
+    for (ymuint i = 0; i < ni1; ++ i) {
+      PackedVal val = kPvAll0;
+      for (ymuint j = 0; j < nb; ++ j) {
+	if ( tv_array[j]->pi2_val3(i) == kVal1 ) {
+	  val.set_bit(j);
 	}
-	else {
-	  if ( wpos != rpos ) {
-	    flist[wpos] = ff;
-	  }
-	  ++ wpos;
+      }
+      if ( tv_array[0]->pi2_val3(i) == kVal1 ) {
+	for (ymuint j = nb; j < kPvBitLen; ++ j) {
+	  val.set_bit(j);
 	}
       }
-    }
-    if ( wpos < fnum ) {
-      flist.erase(flist.begin() + wpos, flist.end());
+      mPi2ValArray[i] = val;
     }
   }
+  
+  // 正常値の計算を行う．
+  calc_gval();
+  
+  // FFR ごとの処理はワーカーに任せる．
+  mPatNum = nb;
+  run_workers(kRunPpsfp);
+
+  for (vector<DetInfo>::iterator p = mDetList.begin();
+       p != mDetList.end(); ++ p) {
+    det_faults[p->mPos].push_back(p->mFault);
+  }
 }
   
 // @brief 一つのパタンで一つの故障に対するシミュレーションを行う．
@@ -284,17 +234,19 @@ Fsim::run(TestVector* tv,
   
   // tv を全ビットにセットしていく．
   for (ymuint i = 0; i < npi; ++ i) {
-    SimNode* simnode = mInputArray[i];
     PackedVal val = (tv->val3(i) == kVal1) ? kPvAll1 : kPvAll0;
-    simnode->set_gval(val);
+    mCompiledNet.set_input(i, val);
+  }
+  if ( mTdMode ) {
+    ymuint ni1 = mNetwork->input_num1();
+    for (ymuint i = 0; i < ni1; ++ i) {
+      mPi2ValArray[i] = (tv->pi2_val3(i) == kVal1) ? kPvAll1 : kPvAll0;
+    }
   }
   
   // 正常値の計算を行う．
-  for (vector<SimNode*>::iterator q = mLogicArray.begin();
-       q != mLogicArray.end(); ++ q) {
-    SimNode* node = *q;
-    node->calc_gval2();
-  }
+  calc_gval();
+  copy_gval(*mWorkerArray[0]);
 
   // FFR 内の故障伝搬を行う．
   SimNode* simnode = NULL;
@@ -316,6 +268,11 @@ Fsim::run(TestVector* tv,
     valdiff = ~valdiff;
   }
   lobs &= valdiff;
+  if ( mTdMode ) {
+    // 1時刻めに故障値と同じ値になっていなければならない．
+    PackedVal prev = mPrevValArray[isimnode->id()];
+    lobs &= (f->val() == 1) ? prev : ~prev;
+  }
 
   cout << f->str() << " : lobs = " << hex << lobs << dec << endl;
   
@@ -331,13 +288,14 @@ Fsim::run(TestVector* tv,
 
   root->set_fval(~root->gval());
 
-  mClearArray.push_back(root);
+  Worker& w = *mWorkerArray[0];
+  w.mClearArray.push_back(root);
   ymuint no = root->nfo();
   for (ymuint i = 0; i < no; ++ i) {
-    mEventQ.put(root->fanout(i));
+    w.mEventQ.put(root->fanout(i));
   }
 
-  PackedVal obs = eventq_simulate() & lobs;
+  PackedVal obs = eventq_simulate(w) & lobs;
   return (obs != kPvAll0);
 }
 
@@ -499,19 +457,23 @@ Fsim::after_set_network(const TgNetwork& network,
       node->set_ffr(ffr);
     }
   }
-  
-  // 消去用の配列の大きさはノード数を越えない．
-  mClearArray.reserve(mNodeArray.size());
 
-  // 最大レベルを求め，イベントキューを初期化する．
-  ymuint max_level = 0;
+  // 最大レベルを求める．
+  mMaxLevel = 0;
   for (ymuint i = 0; i < no; ++ i) {
     SimNode* inode = mOutputArray[i];
-    if ( max_level < inode->level() ) {
-      max_level = inode->level();
+    if ( mMaxLevel < inode->level() ) {
+      mMaxLevel = inode->level();
     }
   }
-  mEventQ.init(max_level);
+
+  // 正常値計算用の命令列を作る．
+  mCompiledNet.set(mNodeArray, mGateTypeArray, mInputArray);
+  mPrevValArray.resize(mNodeArray.size());
+  mPi2ValArray.resize(network.input_num1());
+
+  // ワーカーを作る．
+  make_workers();
 }
 
 // @brief 故障リストの内容が変わった後に呼ばれる関数
@@ -525,6 +487,8 @@ void
 Fsim::clear()
 {
   clear_faults();
+
+  clear_workers();
   
   mSimMap.clear();
 
@@ -534,14 +498,17 @@ Fsim::clear()
     delete *p;
   }
   mNodeArray.clear();
+  mGateTypeArray.clear();
   mInputArray.clear();
   mOutputArray.clear();
   mLogicArray.clear();
 
   mFFRArray.clear();
 
-  mClearArray.clear();
-  
+  mCompiledNet.clear();
+  mPrevValArray.clear();
+  mPi2ValArray.clear();
+  mTdMode = false;
   
   // 念のため
   mNetwork = NULL;
@@ -559,9 +526,284 @@ Fsim::clear_faults()
   mFsimFaults.clear();
 }
 
+// @brief 全てのワーカーで FFR ごとの処理を行う．
+// @param[in] mode 処理の種類
+// @note 結果は FFR 番号順に並べて mDetList に入れる．
+void
+Fsim::run_workers(tRunMode mode)
+{
+  mRunMode = mode;
+  mNextFFR = 0;
+  mNextGroup = 0;
+  mDetList.clear();
+
+  // 0 番めは呼び出し元で動かす．
+  ymuint n = mWorkerArray.size();
+  vector<bool> started(n, false);
+  for (ymuint i = 1; i < n; ++ i) {
+    Worker* w = mWorkerArray[i];
+    if ( pthread_create(&w->mThread, NULL, thread_main, w) == 0 ) {
+      started[i] = true;
+    }
+    // スレッドが作れなかった分の FFR は他のワーカーが処理する．
+  }
+  worker_main(*mWorkerArray[0]);
+  for (ymuint i = 1; i < n; ++ i) {
+    if ( started[i] ) {
+      pthread_join(mWorkerArray[i]->mThread, NULL);
+    }
+  }
+
+  // 各ワーカーの結果をまとめる．
+  // 同じ FFR の故障は一つのワーカーが続けて記録しているので
+  // FFR 番号で安定ソートすればスレッド数によらずに同じ順序になる．
+  for (ymuint i = 0; i < n; ++ i) {
+    vector<DetInfo>& det_list = mWorkerArray[i]->mDetList;
+    mDetList.insert(mDetList.end(), det_list.begin(), det_list.end());
+    det_list.clear();
+  }
+  stable_sort(mDetList.begin(), mDetList.end(), DetLt());
+}
+
+// @brief ワーカーの本体
+void
+Fsim::worker_main(Worker& w)
+{
+  // 正常値は mCompiledNet で計算済みなのでコピーする．
+  copy_gval(w);
+
+  switch ( mRunMode ) {
+  case kRunSingle: single_ffrs(w); break;
+  case kRunPpsfp:  ppsfp_ffrs(w); break;
+  case kRunSeq:    seq_groups(w); break;
+  }
+}
+
+// @brief 入力をセットした後で正常値を計算する．
+// @note 遷移故障の時は1時刻めの値を mPrevValArray に保存してから
+// 2時刻めの値を計算する．2時刻めの外部入力には mPi2ValArray の値を，
+// FF の出力(擬似外部入力)には1時刻めの FF の入力(擬似外部出力)の
+// 値を与える．
+void
+Fsim::calc_gval()
+{
+  mCompiledNet.eval();
+  if ( !mTdMode ) {
+    return;
+  }
+
+  ymuint n = mNodeArray.size();
+  for (ymuint i = 0; i < n; ++ i) {
+    mPrevValArray[i] = mCompiledNet.val(i);
+  }
+  ymuint ni1 = mNetwork->input_num1();
+  ymuint no1 = mNetwork->output_num1();
+  ymuint nff = mNetwork->ff_num();
+  for (ymuint i = 0; i < ni1; ++ i) {
+    mCompiledNet.set_input(i, mPi2ValArray[i]);
+  }
+  for (ymuint i = 0; i < nff; ++ i) {
+    SimNode* onode = mOutputArray[no1 + i];
+    mCompiledNet.set_input(ni1 + i, mPrevValArray[onode->id()]);
+  }
+  mCompiledNet.eval();
+}
+
+// @brief 正常値をワーカーのノードにコピーする．
+void
+Fsim::copy_gval(Worker& w)
+{
+  ymuint n = w.mNodeArray.size();
+  for (ymuint i = 0; i < n; ++ i) {
+    w.mNodeArray[i]->set_gval(mCompiledNet.val(i));
+  }
+}
+
+// @brief スレッドの本体
+void*
+Fsim::thread_main(void* arg)
+{
+  Worker* w = static_cast<Worker*>(arg);
+  w->mFsim->worker_main(*w);
+  return NULL;
+}
+
+// @brief 処理する FFR の範囲を取り出す．
+// @param[out] begin, end 範囲
+// @retval false 全ての FFR を処理し終えた．
+bool
+Fsim::get_ffr_range(ymuint& begin,
+		    ymuint& end)
+{
+  ymuint nffr = mFFRArray.size();
+  if ( mWorkerArray.size() == 1 ) {
+    if ( mNextFFR >= nffr ) {
+      return false;
+    }
+    begin = 0;
+    end = nffr;
+    mNextFFR = nffr;
+    return true;
+  }
+
+  begin = __sync_fetch_and_add(&mNextFFR, kFFRChunk);
+  if ( begin >= nffr ) {
+    return false;
+  }
+  end = begin + kFFRChunk;
+  if ( end > nffr ) {
+    end = nffr;
+  }
+  return true;
+}
+
+// @brief 1パタンを全ビットにセットした時の処理を行う．
+// @note ビットごとに異なる FFR の根の故障を割り当てて
+// まとめてイベントドリブンシミュレーションを行う．
+void
+Fsim::single_ffrs(Worker& w)
+{
+  ymuint bitpos = 0;
+  ymuint ffr_buff[kPvBitLen];
+  ymuint begin;
+  ymuint end;
+  while ( get_ffr_range(begin, end) ) {
+    for (ymuint ffr_id = begin; ffr_id < end; ++ ffr_id) {
+      SimFFR* ffr = &mFFRArray[ffr_id];
+      if ( ffr->fault_list().empty() ) continue;
+
+      // FFR 内の故障伝搬を行う．
+      // 結果は FsimFault.mObsMask に保存される．
+      // FFR 内の全ての obs マスクを ffr_req に入れる．
+      // 検出済みの故障は ffr->fault_list() から取り除かれる．
+      PackedVal ffr_req = ffr_simulate(w, ffr);
+
+      // ffr_req が 0 ならその後のシミュレーションを行う必要はない．
+      if ( ffr_req == kPvAll0 ) {
+	continue;
+      }
+
+      SimNode* root = w.mNodeArray[ffr->root()->id()];
+      if ( root->is_output() ) {
+	// 常に観測可能
+	fault_sweep(w, ffr_id);
+	continue;
+      }
+
+      // キューに積んでおく
+      PackedVal bitmask = pv_bit(bitpos);
+      PackedVal pat = root->gval() ^ bitmask;
+      root->set_fval(pat);
+      root->set_fmask(~bitmask);
+
+      w.mClearArray.push_back(root);
+      ymuint no = root->nfo();
+      for (ymuint i = 0; i < no; ++ i) {
+	w.mEventQ.put(root->fanout(i));
+      }
+      ffr_buff[bitpos] = ffr_id;
+
+      ++ bitpos;
+      if ( bitpos == kPvBitLen ) {
+	PackedVal obs = eventq_simulate(w);
+	for (ymuint i = 0; i < kPvBitLen; ++ i) {
+	  if ( obs.bit(i) ) {
+	    fault_sweep(w, ffr_buff[i]);
+	  }
+	}
+	bitpos = 0;
+      }
+    }
+  }
+  if ( bitpos > 0 ) {
+    PackedVal obs = eventq_simulate(w);
+    for (ymuint i = 0; i < bitpos; ++ i) {
+      if ( obs.bit(i) ) {
+	fault_sweep(w, ffr_buff[i]);
+      }
+    }
+  }
+}
+
+// @brief 複数パタンをセットした時の処理を行う．
+void
+Fsim::ppsfp_ffrs(Worker& w)
+{
+  ymuint begin;
+  ymuint end;
+  while ( get_ffr_range(begin, end) ) {
+    for (ymuint ffr_id = begin; ffr_id < end; ++ ffr_id) {
+      SimFFR* ffr = &mFFRArray[ffr_id];
+      if ( ffr->fault_list().empty() ) continue;
+
+      // FFR 内の故障伝搬を行う．
+      // 結果は FsimFault.mObsMask に保存される．
+      // FFR 内の全ての obs マスクを ffr_req に入れる．
+      // 検出済みの故障は ffr->fault_list() から取り除かれる．
+      PackedVal ffr_req = ffr_simulate(w, ffr);
+
+      // ffr_req が 0 ならその後のシミュレーションを行う必要はない．
+      if ( ffr_req == kPvAll0 ) {
+	continue;
+      }
+
+      // FFR の出力の故障伝搬を行う．
+      SimNode* root = w.mNodeArray[ffr->root()->id()];
+      PackedVal obs = kPvAll0;
+      if ( root->is_output() ) {
+	obs = kPvAll1;
+      }
+      else {
+	PackedVal pat = root->gval() ^ ffr_req;
+	root->set_fval(pat);
+	w.mClearArray.clear();
+	w.mClearArray.push_back(root);
+	ymuint no = root->nfo();
+	for (ymuint i = 0; i < no; ++ i) {
+	  w.mEventQ.put(root->fanout(i));
+	}
+	obs = eventq_simulate(w);
+      }
+
+      // obs と各々の故障の mObsMask との AND が 0 でなければ故障検出
+      // できたということ．対応するテストベクタを記録する．
+      // また，検出済みとなった故障をリストから取り除く
+      vector<FsimFault*>& flist = ffr->fault_list();
+      ymuint fnum = flist.size();
+      ymuint wpos = 0;
+      for (ymuint rpos = 0; rpos < fnum; ++ rpos) {
+	FsimFault* ff = flist[rpos];
+	SaFault* f = ff->mOrigF;
+	if ( f->status() == kFsUndetected || f->status() == kFsAbort ) {
+	  PackedVal dbits = obs & ff->mObsMask;
+	  if ( dbits != kPvAll0 ) {
+	    ymuint l = first_one(dbits);
+	    assert_cond(l < mPatNum, __FILE__, __LINE__);
+	    DetInfo info;
+	    info.mFFRId = ffr_id;
+	    info.mPos = l;
+	    info.mFault = f;
+	    w.mDetList.push_back(info);
+	  }
+	  else {
+	    if ( wpos != rpos ) {
+	      flist[wpos] = ff;
+	    }
+	    ++ wpos;
+	  }
+	}
+      }
+      if ( wpos < fnum ) {
+	flist.erase(flist.begin() + wpos, flist.end());
+      }
+    }
+  }
+}
+
 // @brief FFR 内の故障シミュレーションを行う．
 PackedVal
-Fsim::ffr_simulate(SimFFR* ffr)
+Fsim::ffr_simulate(Worker& w,
+		   SimFFR* ffr)
 {
   PackedVal ffr_req = kPvAll0;
   vector<FsimFault*>& flist = ffr->fault_list();
@@ -581,9 +823,9 @@ Fsim::ffr_simulate(SimFFR* ffr)
     ++ wpos;
       
     // ff の故障伝搬を行う．
-    SimNode* simnode = ff->mNode;
+    SimNode* simnode = w.mNodeArray[ff->mNode->id()];
     PackedVal lobs = simnode->calc_lobs();
-    PackedVal valdiff = ff->mInode->gval();
+    PackedVal valdiff = w.mNodeArray[ff->mInode->id()]->gval();
     if ( f->is_input_fault() ) {
       // 入力の故障
       ymuint ipos = ff->mIpos;
@@ -593,6 +835,11 @@ Fsim::ffr_simulate(SimFFR* ffr)
       valdiff = ~valdiff;
     }
     lobs &= valdiff;
+    if ( mTdMode ) {
+      // 1時刻めに故障値と同じ値になっていなければならない．
+      PackedVal prev = mPrevValArray[ff->mInode->id()];
+      lobs &= (f->val() == 1) ? prev : ~prev;
+    }
     
     ff->mObsMask = lobs;
     ffr_req |= lobs;
@@ -606,7 +853,7 @@ Fsim::ffr_simulate(SimFFR* ffr)
   
   for (ymuint rpos = 0; rpos < fnum; ++ rpos) {
     FsimFault* ff = flist[rpos];
-    SimNode* node = ff->mNode;
+    SimNode* node = w.mNodeArray[ff->mNode->id()];
     clear_lobs(node);
   }
   
@@ -615,49 +862,53 @@ Fsim::ffr_simulate(SimFFR* ffr)
   
 // @brief イベントキューを用いてシミュレーションを行う．
 PackedVal
-Fsim::eventq_simulate()
+Fsim::eventq_simulate(Worker& w)
 {
   PackedVal obs = kPvAll0;
   for ( ; ; ) {
-    SimNode* node = mEventQ.get();
+    SimNode* node = w.mEventQ.get();
     if ( node == NULL ) break;
     PackedVal diff = node->calc_fval2(~obs);
     if ( diff != kPvAll0 ) {
-      mClearArray.push_back(node);
+      w.mClearArray.push_back(node);
       if ( node->is_output() ) {
 	obs |= diff;
       }
       else {
 	ymuint no = node->nfo();
 	for (ymuint i = 0; i < no; ++ i) {
-	  mEventQ.put(node->fanout(i));
+	  w.mEventQ.put(node->fanout(i));
 	}
       }
     }
   }
   // 今の故障シミュレーションで値の変わったノードを元にもどしておく
-  for (vector<SimNode*>::iterator p = mClearArray.begin();
-       p != mClearArray.end(); ++ p) {
+  for (vector<SimNode*>::iterator p = w.mClearArray.begin();
+       p != w.mClearArray.end(); ++ p) {
     (*p)->clear_fval();
   }
-  mClearArray.clear();
+  w.mClearArray.clear();
   return obs;
 }
 
 // @brief ffr 内の故障が検出可能か調べる．
 void
-Fsim::fault_sweep(SimFFR* ffr,
-		  list<SaFault*>& det_faults)
+Fsim::fault_sweep(Worker& w,
+		  ymuint ffr_id)
 {
-  vector<FsimFault*>& flist = ffr->fault_list();
+  vector<FsimFault*>& flist = mFFRArray[ffr_id].fault_list();
   ymuint fnum = flist.size();
   ymuint wpos = 0;
   for (ymuint rpos = 0; rpos < fnum; ++ rpos) {
     FsimFault* ff = flist[rpos];
     SaFault* f = ff->mOrigF;
     if ( f->status() == kFsUndetected || f->status() == kFsAbort ) {
-      if ( ff->mObsMask ) {
-	det_faults.push_back(f);
+      if ( ff->mObsMask != kPvAll0 ) {
+	DetInfo info;
+	info.mFFRId = ffr_id;
+	info.mPos = 0;
+	info.mFault = f;
+	w.mDetList.push_back(info);
       }
       else {
 	if ( wpos != rpos ) {
@@ -672,6 +923,90 @@ Fsim::fault_sweep(SimFFR* ffr,
   }
 }
 
+// @brief ワーカーを作る．
+// @note 0 番めのワーカー以外は SimNode のネットワークを複製する．
+void
+Fsim::make_workers()
+{
+  clear_workers();
+
+  ymuint node_num = mNodeArray.size();
+  ymuint ffr_num = mFFRArray.size();
+  mWorkerArray.resize(mThreadNum);
+  for (ymuint wid = 0; wid < mThreadNum; ++ wid) {
+    Worker* w = new Worker;
+    mWorkerArray[wid] = w;
+    w->mFsim = this;
+    w->mId = wid;
+    w->mEventQ.init(mMaxLevel);
+    // 消去用の配列の大きさはノード数を越えない．
+    w->mClearArray.reserve(node_num);
+    w->mInjMap.resize(node_num, 0);
+    w->mStateDiff.resize(mNetwork->ff_num(), kPvAll0);
+
+    if ( wid == 0 ) {
+      w->mNodeArray = mNodeArray;
+      continue;
+    }
+
+    // ノードの複製を作る．
+    // mNodeArray はファンインが先に来るように並んでいる．
+    w->mNodeArray.resize(node_num);
+    for (ymuint i = 0; i < node_num; ++ i) {
+      SimNode* node = mNodeArray[i];
+      ymuint ni = node->nfi();
+      vector<SimNode*> inputs(ni);
+      for (ymuint j = 0; j < ni; ++ j) {
+	inputs[j] = w->mNodeArray[node->fanin(j)->id()];
+      }
+      SimNode* node1 = SimNode::new_node(i, mGateTypeArray[i], LogExpr(),
+					 inputs);
+      if ( node->is_output() ) {
+	node1->set_output();
+      }
+      w->mNodeArray[i] = node1;
+    }
+    for (ymuint i = 0; i < node_num; ++ i) {
+      SimNode* node = mNodeArray[i];
+      ymuint no = node->nfo();
+      vector<SimNode*> fo_list(no);
+      for (ymuint j = 0; j < no; ++ j) {
+	fo_list[j] = w->mNodeArray[node->fanout(j)->id()];
+      }
+      w->mNodeArray[i]->set_fanout_list(fo_list, node->fanout_ipos());
+    }
+
+    // FFR の複製を作る．
+    w->mFFRArray.resize(ffr_num);
+    for (ymuint i = 0; i < ffr_num; ++ i) {
+      SimNode* root = mFFRArray[i].root();
+      w->mFFRArray[i].set_root(w->mNodeArray[root->id()]);
+    }
+    for (ymuint i = 0; i < node_num; ++ i) {
+      ymuint ffr_id = mNodeArray[i]->ffr() - &mFFRArray[0];
+      w->mNodeArray[i]->set_ffr(&w->mFFRArray[ffr_id]);
+    }
+  }
+}
+
+// @brief ワーカーを破棄する．
+void
+Fsim::clear_workers()
+{
+  for (vector<Worker*>::iterator p = mWorkerArray.begin();
+       p != mWorkerArray.end(); ++ p) {
+    Worker* w = *p;
+    if ( w->mId > 0 ) {
+      for (vector<SimNode*>::iterator q = w->mNodeArray.begin();
+	   q != w->mNodeArray.end(); ++ q) {
+	delete *q;
+      }
+    }
+    delete w;
+  }
+  mWorkerArray.clear();
+}
+
 // @brief logic ノードを作る．
 SimNode*
 Fsim::make_logic(const LogExpr& lexp,
@@ -730,6 +1065,7 @@ Fsim::make_node(tTgGateType type,
   ymuint32 id = mNodeArray.size();
   SimNode* node = SimNode::new_node(id, type, LogExpr(), inputs);
   mNodeArray.push_back(node);
+  mGateTypeArray.push_back(type);
   if ( type != kTgInput ) {
     mLogicArray.push_back(node);
   }
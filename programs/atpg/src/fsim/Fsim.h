@@ -19,6 +19,9 @@
 #include "ym_lexp/LogExpr.h"
 #include "EventQ.h"
 #include "FsimFault.h"
+#include "SimFFR.h"
+#include "CompiledNet.h"
+#include <pthread.h>
 
 
 BEGIN_NAMESPACE_YM_ATPG
@@ -31,7 +34,6 @@ END_NAMESPACE_YM_ATPG
 
 BEGIN_NAMESPACE_YM_ATPG_FSIM
 
-class SimFFR;
 class SimNode;
 
 //////////////////////////////////////////////////////////////////////
@@ -53,9 +55,20 @@ public:
 
 
 public:
+
+  /// @brief 故障シミュレーションに用いるスレッド数を設定する．
+  /// @param[in] num スレッド数
+  /// @note 1 の時はスレッドを作らずに呼び出し元で実行する．
+  void
+  set_thread_num(ymuint num);
+
+  /// @brief 故障シミュレーションに用いるスレッド数を返す．
+  ymuint
+  thread_num() const;
   
   /// @brief 対象の故障をセットする
   /// @param[in] flist 対象の故障リスト
+  /// @note 遷移故障の時は2時刻分のシミュレーションを行う．
   void
   set_faults(const vector<SaFault*>& flist);
   
@@ -80,6 +93,16 @@ public:
   run(TestVector* tv,
       SaFault* f);
 
+  /// @brief 順序回路としてテスト系列の故障シミュレーションを行う．
+  /// @param[in] tv_list テスト系列 (1時刻に1つのテストベクタ)
+  /// @param[out] det_faults 検出された故障を時刻ごとに格納するリストの配列
+  /// @note 各テストベクタの外部入力の部分のみを用いる．
+  /// ただし先頭のテストベクタの FF の部分は初期状態を表す．
+  /// @note 縮退故障のみが対象となる．
+  void
+  run_seq(const vector<TestVector*>& tv_list,
+	  vector<list<SaFault*> >& det_faults);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -98,20 +121,195 @@ private:
   after_update_faults(const vector<SaFault*>& flist);
   
   
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 並列実行用のデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // 検出された故障の情報
+  struct DetInfo
+  {
+    // 故障の属する FFR の番号
+    // run_seq() の時は故障のグループの番号
+    ymuint32 mFFRId;
+
+    // 検出したパタンの番号
+    ymuint32 mPos;
+
+    // 故障
+    SaFault* mFault;
+  };
+
+  // run_seq() で故障を挿入する位置
+  // 出力の故障の時は mIpos を kSeqOutPos にする．
+  struct SeqInj
+  {
+    // 入力位置
+    ymuint32 mIpos;
+
+    // 同じノードの次の要素の位置 + 1 (0 で終わり)
+    ymuint32 mNext;
+
+    // 0 に固定するビット
+    PackedVal mMask0;
+
+    // 1 に固定するビット
+    PackedVal mMask1;
+
+    // 入力の故障の時に書き換える前の入力の故障値
+    PackedVal mOldVal;
+  };
+
+  // スレッドごとの作業領域
+  // 0 番めは Fsim 本体のノードをそのまま用いて呼び出し元で実行する．
+  // それ以外は SimNode のネットワークの複製を持つ．
+  struct Worker
+  {
+    // 親の Fsim
+    Fsim* mFsim;
+
+    // 番号
+    ymuint mId;
+
+    // スレッド
+    pthread_t mThread;
+
+    // ID 番号をキーにして SimNode を入れる配列
+    vector<SimNode*> mNodeArray;
+
+    // 複製用の FFR の配列
+    vector<SimFFR> mFFRArray;
+
+    // イベントキュー
+    EventQ mEventQ;
+
+    // 値を消去する必要のあるノードを入れておく配列
+    vector<SimNode*> mClearArray;
+
+    // 検出された故障のリスト
+    vector<DetInfo> mDetList;
+
+    // run_seq() 用の故障の挿入位置のリスト
+    vector<SeqInj> mInjList;
+
+    // ノードの ID 番号をキーにして mInjList の先頭の位置 + 1 を入れる配列
+    vector<ymuint32> mInjMap;
+
+    // 故障を挿入したノードのリスト
+    vector<SimNode*> mInjNodes;
+
+    // FF ごとの故障回路の状態の差
+    vector<PackedVal> mStateDiff;
+
+    // mStateDiff が 0 でない FF の番号のリスト
+    vector<ymuint32> mFFList;
+  };
+
+  // DetInfo を FFR 番号順に並べるための比較関数
+  struct DetLt
+  {
+    bool
+    operator()(const DetInfo& left,
+	       const DetInfo& right) const
+    {
+      return left.mFFRId < right.mFFRId;
+    }
+  };
+
+  // run_workers() で行う処理の種類
+  enum tRunMode {
+    kRunSingle,
+    kRunPpsfp,
+    kRunSeq
+  };
+
+
 private:
   
+  /// @brief 全てのワーカーで FFR ごとの処理を行う．
+  /// @param[in] mode 処理の種類
+  /// @note 結果は FFR 番号順に並べて mDetList に入れる．
+  void
+  run_workers(tRunMode mode);
+
+  /// @brief ワーカーの本体
+  void
+  worker_main(Worker& w);
+
+  /// @brief 入力をセットした後で正常値を計算する．
+  /// @note 遷移故障の時は1時刻めの値を mPrevValArray に保存してから
+  /// 2時刻めの値を計算する．2時刻めの外部入力の値は mPi2ValArray に
+  /// 入れておくこと．
+  void
+  calc_gval();
+
+  /// @brief 正常値をワーカーのノードにコピーする．
+  void
+  copy_gval(Worker& w);
+
+  /// @brief スレッドの本体
+  static
+  void*
+  thread_main(void* arg);
+
+  /// @brief 処理する FFR の範囲を取り出す．
+  /// @param[out] begin, end 範囲
+  /// @retval false 全ての FFR を処理し終えた．
+  bool
+  get_ffr_range(ymuint& begin,
+		ymuint& end);
+
+  /// @brief 1パタンを全ビットにセットした時の処理を行う．
+  void
+  single_ffrs(Worker& w);
+
+  /// @brief 複数パタンをセットした時の処理を行う．
+  void
+  ppsfp_ffrs(Worker& w);
+  
   /// @brief FFR 内の故障シミュレーションを行う．
   PackedVal
-  ffr_simulate(SimFFR* ffr);
+  ffr_simulate(Worker& w,
+	       SimFFR* ffr);
 
   /// @brief イベントキューを用いてシミュレーションを行う．
   PackedVal
-  eventq_simulate();
+  eventq_simulate(Worker& w);
 
   /// @brief ffr 内の故障が検出可能か調べる．
   void
-  fault_sweep(SimFFR* ffr,
-	      list<SaFault*>& det_faults);
+  fault_sweep(Worker& w,
+	      ymuint ffr_id);
+
+  /// @brief 処理する故障のグループを取り出す．
+  /// @param[out] gid グループ番号
+  /// @retval false 全てのグループを処理し終えた．
+  bool
+  get_group(ymuint& gid);
+
+  /// @brief 順序回路の1時刻分の処理を行う．
+  void
+  seq_groups(Worker& w);
+
+  /// @brief 故障のグループの1時刻分のシミュレーションを行う．
+  void
+  seq_simulate(Worker& w,
+	       ymuint gid);
+
+  /// @brief 故障を挿入したノードの故障値を計算する．
+  /// @return 正常値との差を返す．
+  PackedVal
+  seq_calc_fval(Worker& w,
+		SimNode* node,
+		ymuint pos);
+
+  /// @brief ワーカーを作る．
+  void
+  make_workers();
+
+  /// @brief ワーカーを破棄する．
+  void
+  clear_workers();
 
 
 private:
@@ -185,14 +383,55 @@ private:
   // 入力からのトポロジカル順に並べた logic ノードの配列
   vector<SimNode*> mLogicArray;
 
+  // mNodeArray の各ノードのゲートの種類
+  vector<tTgGateType> mGateTypeArray;
+
   // FFR を納めた配列
   vector<SimFFR> mFFRArray;
 
-  // イベントキュー
-  EventQ mEventQ;
+  // 正常値計算用に平坦化したネットワーク
+  CompiledNet mCompiledNet;
+
+  // 遷移故障を対象にしている時 true にするフラグ
+  bool mTdMode;
+
+  // 遷移故障用の1時刻めの正常値の配列
+  // SimNode の ID 番号をキーにする．
+  vector<PackedVal> mPrevValArray;
+
+  // 遷移故障用の2時刻めの外部入力の値の配列
+  vector<PackedVal> mPi2ValArray;
+
+  // イベントキューの最大レベル
+  ymuint mMaxLevel;
+
+  // スレッド数
+  ymuint mThreadNum;
+
+  // ワーカーの配列
+  vector<Worker*> mWorkerArray;
+
+  // run_workers() で行う処理の種類
+  tRunMode mRunMode;
+
+  // 次に処理する FFR の番号
+  volatile ymuint mNextFFR;
+
+  // run_seq() で次に処理するグループの番号
+  volatile ymuint mNextGroup;
+
+  // run_seq() で現在の時刻に扱う故障のリスト
+  // kPvBitLen 個ずつ順にグループにする．
+  vector<FsimFault*> mSeqFaults;
+
+  // run_seq() の現在の時刻
+  ymuint mSeqFrame;
+
+  // 現在のパタン数
+  ymuint mPatNum;
 
-  // 値を消去する必要のあるノードを入れておく配列
-  vector<SimNode*> mClearArray;
+  // 検出された故障のリスト
+  vector<DetInfo> mDetList;
   
   // 故障シミュレーション用の故障の配列
   vector<FsimFault> mFsimFaults;
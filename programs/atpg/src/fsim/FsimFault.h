@@ -61,6 +61,10 @@ struct FsimFault
 
   // 現在計算中のローカルな故障伝搬マスク
   PackedVal mObsMask;
+
+  // 順序回路のシミュレーションで故障回路の状態が正常回路と
+  // 異なる FF の番号のリスト
+  vector<ymuint32> mStateDiff;
 };
 
 END_NAMESPACE_YM_ATPG_FSIM
@@ -0,0 +1,386 @@
+
+/// @file src/fsim/FsimSeq.cc
+/// @brief Fsim の順序回路用の故障シミュレーションの実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id: FsimSeq.cc 2203 2009-04-16 05:04:40Z matsunaga $
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "Fsim.h"
+#include "ym_tgnet/TgNetwork.h"
+#include "SimNode.h"
+#include "SimFFR.h"
+#include "SaFault.h"
+#include "TestVector.h"
+
+
+BEGIN_NAMESPACE_YM_ATPG_FSIM
+
+BEGIN_NONAMESPACE
+
+// SeqInj::mIpos で出力の故障を表す値
+const ymuint32 kSeqOutPos = 0xFFFFFFFFU;
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// Fsim の順序回路用の関数
+//////////////////////////////////////////////////////////////////////
+
+// @brief 順序回路としてテスト系列の故障シミュレーションを行う．
+// @param[in] tv_list テスト系列 (1時刻に1つのテストベクタ)
+// @param[out] det_faults 検出された故障を時刻ごとに格納するリストの配列
+// @note FF の出力を擬似外部入力とはせずに，正常回路の状態と
+// 故障ごとの故障回路の状態を時刻をまたいで保持する．
+// 故障回路の状態は正常回路と異なる FF のリストとして持ち，
+// 時刻ごとに状態の差があるか活性化される故障だけを kPvBitLen 個
+// ずつのグループにまとめてイベントドリブンで並列に計算する．
+// 検出された故障はその時点で以降の時刻の対象から外す．
+void
+Fsim::run_seq(const vector<TestVector*>& tv_list,
+	      vector<list<SaFault*> >& det_faults)
+{
+  ymuint ni1 = mNetwork->input_num1();
+  ymuint no1 = mNetwork->output_num1();
+  ymuint nff = mNetwork->ff_num();
+  ymuint nt = tv_list.size();
+  assert_cond(det_faults.size() >= nt, __FILE__, __LINE__);
+
+  for (ymuint i = 0; i < nt; ++ i) {
+    det_faults[i].clear();
+  }
+
+  if ( mTdMode || nt == 0 ) {
+    return;
+  }
+
+  // 未検出の故障を集める．
+  // mObsMask は検出されたかどうかの印に用いる．
+  vector<FsimFault*> live_list;
+  for (vector<SimFFR>::iterator p = mFFRArray.begin();
+       p != mFFRArray.end(); ++ p) {
+    vector<FsimFault*>& flist = p->fault_list();
+    for (vector<FsimFault*>::iterator q = flist.begin();
+	 q != flist.end(); ++ q) {
+      FsimFault* ff = *q;
+      ff->mObsMask = kPvAll0;
+      ff->mStateDiff.clear();
+      FaultStatus fs = ff->mOrigF->status();
+      if ( fs == kFsUndetected || fs == kFsAbort ) {
+	live_list.push_back(ff);
+      }
+    }
+  }
+
+  // 正常回路の状態
+  // 初期状態は先頭のテストベクタの FF の部分で与えられる．
+  vector<PackedVal> state(nff, kPvAll0);
+  for (ymuint i = 0; i < nff; ++ i) {
+    state[i] = (tv_list[0]->val3(ni1 + i) == kVal1) ? kPvAll1 : kPvAll0;
+  }
+
+  for (ymuint t = 0; t < nt && !live_list.empty(); ++ t) {
+    TestVector* tv = tv_list[t];
+    for (ymuint i = 0; i < ni1; ++ i) {
+      PackedVal val = (tv->val3(i) == kVal1) ? kPvAll1 : kPvAll0;
+      mCompiledNet.set_input(i, val);
+    }
+    for (ymuint i = 0; i < nff; ++ i) {
+      mCompiledNet.set_input(ni1 + i, state[i]);
+    }
+    mCompiledNet.eval();
+
+    // 状態の差がなく，この時刻に活性化もされない故障は
+    // 故障回路の値が正常回路と等しいので計算しなくてよい．
+    mSeqFaults.clear();
+    for (vector<FsimFault*>::iterator p = live_list.begin();
+	 p != live_list.end(); ++ p) {
+      FsimFault* ff = *p;
+      if ( ff->mStateDiff.empty() ) {
+	bool gval = mCompiledNet.val(ff->mInode->id()).bit(0);
+	if ( gval == (ff->mOrigF->val() == 1) ) {
+	  continue;
+	}
+      }
+      mSeqFaults.push_back(ff);
+    }
+
+    if ( !mSeqFaults.empty() ) {
+      // グループごとの処理はワーカーに任せる．
+      mSeqFrame = t;
+      run_workers(kRunSeq);
+
+      for (vector<DetInfo>::iterator p = mDetList.begin();
+	   p != mDetList.end(); ++ p) {
+	det_faults[t].push_back(p->mFault);
+      }
+
+      // 検出された故障を取り除く．
+      if ( !mDetList.empty() ) {
+	ymuint n = live_list.size();
+	ymuint wpos = 0;
+	for (ymuint rpos = 0; rpos < n; ++ rpos) {
+	  FsimFault* ff = live_list[rpos];
+	  if ( ff->mObsMask == kPvAll0 ) {
+	    live_list[wpos] = ff;
+	    ++ wpos;
+	  }
+	}
+	live_list.erase(live_list.begin() + wpos, live_list.end());
+      }
+    }
+
+    // 正常回路の次の状態
+    for (ymuint i = 0; i < nff; ++ i) {
+      state[i] = mCompiledNet.val(mOutputArray[no1 + i]->id());
+    }
+  }
+  mSeqFaults.clear();
+
+  // run() と同様に検出済みの故障を FFR のリストから取り除いておく．
+  for (vector<SimFFR>::iterator p = mFFRArray.begin();
+       p != mFFRArray.end(); ++ p) {
+    vector<FsimFault*>& flist = p->fault_list();
+    ymuint n = flist.size();
+    ymuint wpos = 0;
+    for (ymuint rpos = 0; rpos < n; ++ rpos) {
+      FsimFault* ff = flist[rpos];
+      ff->mStateDiff.clear();
+      if ( ff->mObsMask == kPvAll0 ) {
+	flist[wpos] = ff;
+	++ wpos;
+      }
+    }
+    flist.erase(flist.begin() + wpos, flist.end());
+  }
+}
+
+// @brief 処理する故障のグループを取り出す．
+// @param[out] gid グループ番号
+// @retval false 全てのグループを処理し終えた．
+bool
+Fsim::get_group(ymuint& gid)
+{
+  ymuint ng = (mSeqFaults.size() + kPvBitLen - 1) / kPvBitLen;
+  if ( mWorkerArray.size() == 1 ) {
+    gid = mNextGroup;
+    ++ mNextGroup;
+  }
+  else {
+    gid = __sync_fetch_and_add(&mNextGroup, 1);
+  }
+  return gid < ng;
+}
+
+// @brief 順序回路の1時刻分の処理を行う．
+void
+Fsim::seq_groups(Worker& w)
+{
+  ymuint gid;
+  while ( get_group(gid) ) {
+    seq_simulate(w, gid);
+  }
+}
+
+// @brief 故障のグループの1時刻分のシミュレーションを行う．
+// @note 各ビットが一つの故障回路に対応する．
+void
+Fsim::seq_simulate(Worker& w,
+		   ymuint gid)
+{
+  ymuint ni1 = mNetwork->input_num1();
+  ymuint no1 = mNetwork->output_num1();
+  ymuint nff = mNetwork->ff_num();
+  ymuint base = gid * kPvBitLen;
+  ymuint nb = mSeqFaults.size() - base;
+  if ( nb > kPvBitLen ) {
+    nb = kPvBitLen;
+  }
+
+  // 故障回路の状態の差と故障の挿入位置を設定する．
+  w.mInjList.clear();
+  for (ymuint b = 0; b < nb; ++ b) {
+    FsimFault* ff = mSeqFaults[base + b];
+    PackedVal bitmask = pv_bit(b);
+    for (vector<ymuint32>::iterator p = ff->mStateDiff.begin();
+	 p != ff->mStateDiff.end(); ++ p) {
+      ymuint i = *p;
+      if ( w.mStateDiff[i] == kPvAll0 ) {
+	w.mFFList.push_back(i);
+      }
+      w.mStateDiff[i] |= bitmask;
+    }
+
+    SaFault* f = ff->mOrigF;
+    SimNode* node = w.mNodeArray[ff->mNode->id()];
+    SeqInj inj;
+    inj.mIpos = f->is_input_fault() ? ff->mIpos : kSeqOutPos;
+    inj.mMask0 = (f->val() == 0) ? bitmask : kPvAll0;
+    inj.mMask1 = (f->val() == 1) ? bitmask : kPvAll0;
+    ymuint32& head = w.mInjMap[node->id()];
+    if ( head == 0 ) {
+      w.mInjNodes.push_back(node);
+    }
+    inj.mNext = head;
+    w.mInjList.push_back(inj);
+    head = w.mInjList.size();
+  }
+
+  for (vector<ymuint32>::iterator p = w.mFFList.begin();
+       p != w.mFFList.end(); ++ p) {
+    ymuint i = *p;
+    SimNode* node = w.mNodeArray[mInputArray[ni1 + i]->id()];
+    node->set_fval(node->gval() ^ w.mStateDiff[i]);
+    w.mStateDiff[i] = kPvAll0;
+    w.mClearArray.push_back(node);
+    ymuint no = node->nfo();
+    for (ymuint j = 0; j < no; ++ j) {
+      w.mEventQ.put(node->fanout(j));
+    }
+  }
+  w.mFFList.clear();
+
+  for (vector<SimNode*>::iterator p = w.mInjNodes.begin();
+       p != w.mInjNodes.end(); ++ p) {
+    SimNode* node = *p;
+    if ( node->nfi() > 0 ) {
+      w.mEventQ.put(node);
+      continue;
+    }
+    // 外部入力(FF の出力)の故障は直接値を設定する．
+    PackedVal val = node->fval();
+    for (ymuint pos = w.mInjMap[node->id()]; pos > 0; ) {
+      const SeqInj& inj = w.mInjList[pos - 1];
+      val &= ~inj.mMask0;
+      val |= inj.mMask1;
+      pos = inj.mNext;
+    }
+    if ( val != node->fval() ) {
+      node->set_fval(val);
+      w.mClearArray.push_back(node);
+      ymuint no = node->nfo();
+      for (ymuint j = 0; j < no; ++ j) {
+	w.mEventQ.put(node->fanout(j));
+      }
+    }
+  }
+
+  // イベントドリブンで故障値を計算する．
+  // 外部出力と FF の入力の両方の値が必要なので出力でも伝搬を止めない．
+  for ( ; ; ) {
+    SimNode* node = w.mEventQ.get();
+    if ( node == NULL ) break;
+    ymuint pos = w.mInjMap[node->id()];
+    PackedVal diff = (pos > 0) ? seq_calc_fval(w, node, pos) :
+      node->calc_fval2(kPvAll1);
+    if ( diff != kPvAll0 ) {
+      w.mClearArray.push_back(node);
+      ymuint no = node->nfo();
+      for (ymuint j = 0; j < no; ++ j) {
+	w.mEventQ.put(node->fanout(j));
+      }
+    }
+  }
+
+  // 外部出力で検出された故障を記録する．
+  PackedVal obs = kPvAll0;
+  for (ymuint i = 0; i < no1; ++ i) {
+    SimNode* node = w.mNodeArray[mOutputArray[i]->id()];
+    obs |= node->gval() ^ node->fval();
+  }
+  for (ymuint b = 0; b < nb; ++ b) {
+    FsimFault* ff = mSeqFaults[base + b];
+    ff->mStateDiff.clear();
+    if ( obs.bit(b) ) {
+      ff->mObsMask = pv_bit(b);
+      DetInfo info;
+      info.mFFRId = gid;
+      info.mPos = mSeqFrame;
+      info.mFault = ff->mOrigF;
+      w.mDetList.push_back(info);
+    }
+  }
+
+  // 検出されなかった故障の次の状態の差を記録する．
+  for (ymuint i = 0; i < nff; ++ i) {
+    SimNode* node = w.mNodeArray[mOutputArray[no1 + i]->id()];
+    PackedVal diff = (node->gval() ^ node->fval()) & ~obs;
+    if ( diff == kPvAll0 ) {
+      continue;
+    }
+    for (ymuint b = 0; b < nb; ++ b) {
+      if ( diff.bit(b) ) {
+	mSeqFaults[base + b]->mStateDiff.push_back(i);
+      }
+    }
+  }
+
+  // 値の変わったノードと故障の挿入位置を元にもどしておく．
+  for (vector<SimNode*>::iterator p = w.mClearArray.begin();
+       p != w.mClearArray.end(); ++ p) {
+    (*p)->clear_fval();
+  }
+  w.mClearArray.clear();
+  for (vector<SimNode*>::iterator p = w.mInjNodes.begin();
+       p != w.mInjNodes.end(); ++ p) {
+    w.mInjMap[(*p)->id()] = 0;
+  }
+  w.mInjNodes.clear();
+}
+
+// @brief 故障を挿入したノードの故障値を計算する．
+// @param[in] pos mInjList 中の先頭の位置 + 1
+// @return 正常値との差を返す．
+// @note 入力の故障は入力の故障値を一時的に書き換えて計算する．
+// 同じ入力に複数の故障がある場合もあるので，書き換える前の値を
+// 全て保存してから書き換える．
+PackedVal
+Fsim::seq_calc_fval(Worker& w,
+		    SimNode* node,
+		    ymuint pos)
+{
+  bool has_input = false;
+  for (ymuint p = pos; p > 0; ) {
+    SeqInj& inj = w.mInjList[p - 1];
+    if ( inj.mIpos != kSeqOutPos ) {
+      inj.mOldVal = node->fanin(inj.mIpos)->fval();
+      has_input = true;
+    }
+    p = inj.mNext;
+  }
+  if ( has_input ) {
+    for (ymuint p = pos; p > 0; ) {
+      const SeqInj& inj = w.mInjList[p - 1];
+      if ( inj.mIpos != kSeqOutPos ) {
+	SimNode* inode = node->fanin(inj.mIpos);
+	PackedVal val = inode->fval();
+	val &= ~inj.mMask0;
+	val |= inj.mMask1;
+	inode->set_fval(val);
+      }
+      p = inj.mNext;
+    }
+  }
+
+  PackedVal val = node->_calc_fval2();
+
+  for (ymuint p = pos; p > 0; ) {
+    const SeqInj& inj = w.mInjList[p - 1];
+    if ( inj.mIpos == kSeqOutPos ) {
+      val &= ~inj.mMask0;
+      val |= inj.mMask1;
+    }
+    else {
+      node->fanin(inj.mIpos)->set_fval(inj.mOldVal);
+    }
+    p = inj.mNext;
+  }
+
+  node->set_fval(val);
+  return node->gval() ^ val;
+}
+
+END_NAMESPACE_YM_ATPG_FSIM
@@ -21,6 +21,27 @@ BEGIN_NAMESPACE_YM_ATPG_FSIM
 BEGIN_NONAMESPACE
 // 値の計算用の作業領域
 vector<PackedVal> tmp1;
+
+// ワードごとの評価用の作業領域
+vector<PvWord> tmpw;
+
+// 論理式をワードごとに評価する．
+PackedVal
+eval_expr(const LogExpr& expr,
+	  const vector<PackedVal>& vals)
+{
+  ymuint ni = vals.size();
+  tmpw.resize(ni);
+  PackedVal ans;
+  for (ymuint w = 0; w < kPvWordNum; ++ w) {
+    for (ymuint i = 0; i < ni; ++ i) {
+      tmpw[i] = vals[i].word(w);
+    }
+    ans.set_word(w, expr.eval(tmpw));
+  }
+  return ans;
+}
+
 END_NONAMESPACE
 
 // @brief コンストラクタ
@@ -47,7 +68,7 @@ SnCplx::_calc_gval2()
     SimNode* inode = mFanins[i];
     tmp1[i] = inode->gval();
   }
-  return mExpr.eval(tmp1);
+  return eval_expr(mExpr, tmp1);
 }
 
 // @brief 故障値の計算を行う．(2値版)
@@ -60,7 +81,7 @@ SnCplx::_calc_fval2()
     SimNode* inode = mFanins[i];
     tmp1[i] = inode->fval();
   }
-  return mExpr.eval(tmp1);
+  return eval_expr(mExpr, tmp1);
 }
 
 // @brief ゲートの入力から出力までの可観測性を計算する．(2値版)
@@ -76,7 +97,7 @@ SnCplx::calc_gobs2(ymuint ipos)
   for (ymuint i = ipos + 1; i < ni; ++ i) {
     tmp1[i] = mFanins[i]->gval();
   }
-  PackedVal val = mExpr.eval(tmp1);
+  PackedVal val = eval_expr(mExpr, tmp1);
   return val ^ gval();
 }
 
@@ -142,7 +142,7 @@ FsimX::run(TestVector* tv,
     }
 
     // キューに積んでおく
-    PackedVal bitmask = 1UL << bitpos;
+    PackedVal bitmask = pv_bit(bitpos);
     PackedVal3 fval = ite(bitmask, ~gval, gval);
     root->set_fval(fval);
     root->set_fmask(~bitmask);
@@ -157,8 +157,8 @@ FsimX::run(TestVector* tv,
     ++ bitpos;
     if ( bitpos == kPvBitLen ) {
       PackedVal obs = calc_fval();
-      for (ymuint i = 0; i < bitpos; ++ i, obs >>= 1) {
-	if ( obs & 1UL ) {
+      for (ymuint i = 0; i < bitpos; ++ i) {
+	if ( obs.bit(i) ) {
 	  fault_sweep(ffr_buff[i], det_faults);
 	}
       }
@@ -167,8 +167,8 @@ FsimX::run(TestVector* tv,
   }
   if ( bitpos > 0 ) {
     PackedVal obs = calc_fval();
-    for (ymuint i = 0; i < bitpos; ++ i, obs >>= 1) {
-      if ( obs & 1UL ) {
+    for (ymuint i = 0; i < bitpos; ++ i) {
+      if ( obs.bit(i) ) {
 	fault_sweep(ffr_buff[i], det_faults);
       }
     }
@@ -198,15 +198,14 @@ FsimX::run(const vector<TestVector*>& tv_array,
   for (ymuint i = 0; i < npi; ++ i) {
     PackedVal val_0 = kPvAll0;
     PackedVal val_1 = kPvAll0;
-    PackedVal bit = 1UL;
-    for (ymuint j = 0; j < nb; ++ j, bit <<= 1) {
+    for (ymuint j = 0; j < nb; ++ j) {
       switch ( tv_array[j]->val3(i) ) {
       case kVal0:
-	val_0 |= bit;
+	val_0.set_bit(j);
 	break;
 	
       case kVal1:
-	val_1 |= bit;
+	val_1.set_bit(j);
 	break;
 
       default:
@@ -217,14 +216,14 @@ FsimX::run(const vector<TestVector*>& tv_array,
     // 残ったビットには 0 番めのパタンを詰めておく．
     switch ( tv_array[0]->val3(i) ) {
     case kVal0:
-      for (ymuint j = nb; j < kPvBitLen; ++ j, bit <<= 1) {
-	val_0 |= bit;
+      for (ymuint j = nb; j < kPvBitLen; ++ j) {
+	val_0.set_bit(j);
       }
       break;
       
     case kVal1:
-      for (ymuint j = nb; j < kPvBitLen; ++ j, bit <<= 1) {
-	val_1 |= bit;
+      for (ymuint j = nb; j < kPvBitLen; ++ j) {
+	val_1.set_bit(j);
       }
       break;
 
@@ -291,9 +290,8 @@ FsimX::run(const vector<TestVector*>& tv_array,
       SaFault* f = ff->mOrigF;
       if ( f->status() == kFsUndetected || f->status() == kFsAbort ) {
 	PackedVal dbits = obs & ff->mObsMask;
-	if ( dbits ) {
-	  ymuint l;
-	  for (l = 0; (dbits & 1UL) == kPvAll0; ++ l, dbits >>= 1) ;
+	if ( dbits != kPvAll0 ) {
+	  ymuint l = first_one(dbits);
 	  assert_cond(l < nb, __FILE__, __LINE__);
 	  det_faults[l].push_back(f);
 	}
@@ -771,7 +769,7 @@ FsimX::fault_sweep(SimFFR* ffr,
     FsimFault* ff = flist[rpos];
     SaFault* f = ff->mOrigF;
     if ( f->status() == kFsUndetected || f->status() == kFsAbort ) {
-      if ( ff->mObsMask ) {
+      if ( ff->mObsMask != kPvAll0 ) {
 	det_faults.push_back(f);
       }
 #if 0
@@ -22,6 +22,27 @@ BEGIN_NONAMESPACE
 // 値の計算用の作業領域
 vector<PackedVal> tmp0;
 vector<PackedVal> tmp1;
+
+// ワードごとの評価用の作業領域
+vector<PvWord> tmpw;
+
+// 論理式をワードごとに評価する．
+PackedVal
+eval_expr(const LogExpr& expr,
+	  const vector<PackedVal>& vals)
+{
+  ymuint ni = vals.size();
+  tmpw.resize(ni);
+  PackedVal ans;
+  for (ymuint w = 0; w < kPvWordNum; ++ w) {
+    for (ymuint i = 0; i < ni; ++ i) {
+      tmpw[i] = vals[i].word(w);
+    }
+    ans.set_word(w, expr.eval(tmpw));
+  }
+  return ans;
+}
+
 END_NONAMESPACE
 
 // @brief コンストラクタ
@@ -51,8 +72,8 @@ SnCplx::_calc_gval3()
     tmp0[i] = tmp._pat0();
     tmp1[i] = tmp._pat1();
   }
-  PackedVal val0 = mExpr[0].eval(tmp0);
-  PackedVal val1 = mExpr[1].eval(tmp1);
+  PackedVal val0 = eval_expr(mExpr[0], tmp0);
+  PackedVal val1 = eval_expr(mExpr[1], tmp1);
   return PackedVal3(val0, val1);
 }
 
@@ -68,8 +89,8 @@ SnCplx::_calc_fval3()
     tmp0[i] = tmp._pat0();
     tmp1[i] = tmp._pat1();
   }
-  PackedVal val0 = mExpr[0].eval(tmp0);
-  PackedVal val1 = mExpr[1].eval(tmp1);
+  PackedVal val0 = eval_expr(mExpr[0], tmp0);
+  PackedVal val1 = eval_expr(mExpr[1], tmp1);
   return PackedVal3(val0, val1);
 }
 
@@ -95,8 +116,8 @@ SnCplx::calc_gobs3(ymuint ipos)
     tmp0[i] = tmp._pat0();
     tmp1[i] = tmp._pat1();
   }
-  PackedVal fval_0 = mExpr[0].eval(tmp0);
-  PackedVal fval_1 = mExpr[1].eval(tmp1);
+  PackedVal fval_0 = eval_expr(mExpr[0], tmp0);
+  PackedVal fval_1 = eval_expr(mExpr[1], tmp1);
   PackedVal3 new_fval(fval_0, fval_1);
   return new_fval.diff(gval());
 }
@@ -59,7 +59,8 @@ AtpgMgr::after_set_network()
   tv_mgr.clear();
 
   size_t ni = network.input_num2();
-  tv_mgr.init(ni);
+  size_t npi = network.input_num1();
+  tv_mgr.init(ni, npi);
   
   for (list<ModBase*>::iterator p = mModList.begin();
        p != mModList.end(); ++ p) {
@@ -72,7 +73,11 @@ AtpgMgr::after_set_network()
 void
 AtpgMgr::after_update_faults()
 {
-  const vector<SaFault*>& flist = _fault_mgr().remain_list();
+  FaultMgr& fmgr = _fault_mgr();
+  const vector<SaFault*>& flist = fmgr.remain_list();
+
+  // 遷移故障の時は2時刻めの外部入力の値を持つベクタを用いる．
+  _tv_mgr().set_tdf_mode(fmgr.model() == kFmTransition);
   
   for (list<ModBase*>::iterator p = mModList.begin();
        p != mModList.end(); ++ p) {
@@ -81,6 +86,13 @@ AtpgMgr::after_update_faults()
   }
 }
 
+// @brief 故障シミュレーションに用いるスレッド数を設定する．
+void
+AtpgMgr::set_fsim_thread_num(ymuint num)
+{
+  mFsim->set_thread_num(num);
+}
+
 // @brief モジュールを登録する．
 void
 AtpgMgr::bind_module(ModBase* mod)
@@ -12,6 +12,7 @@
 #include "Dtpg.h"
 #include "dtpg_classic/DtpgCl.h"
 #include "dtpg_sat/DtpgSat.h"
+#include "dtpg_sat/UntestChecker.h"
 #include "fsim/Fsim.h"
 #include "fsim3/Fsim3.h"
 #include "fsimx/FsimX.h"
@@ -24,10 +25,28 @@
 #include "TvBuff.h"
 
 #include "ym_tgnet/TgNode.h"
+#include <algorithm>
 
 
 BEGIN_NAMESPACE_YM_ATPG
 
+BEGIN_NONAMESPACE
+
+// 故障を FFR の根の番号順に並べるための比較関数
+struct FfrLt
+{
+  bool
+  operator()(SaFault* f1,
+	     SaFault* f2) const
+  {
+    const TgNode* root1 = DtpgSat::ffr_root(f1->node());
+    const TgNode* root2 = DtpgSat::ffr_root(f2->node());
+    return root1->gid() < root2->gid();
+  }
+};
+
+END_NONAMESPACE
+
 // DTPG の結果を故障シミュレーションで検証する時に 1 にする．
 const int verify_dtpg = 1;
 
@@ -37,18 +56,31 @@ Dtpg::Dtpg(AtpgMgr* mgr) :
   AtpgFunctor(mgr),
   mSat(false),
   mScoping(false),
+  mKeepX(false),
+  mCompLimit(0),
+  mCompPos(0),
+  mFirstPos(0),
+  mThreadNum(1),
+  mLearning(false),
   mDtpgCl(new DtpgCl()),
   mDtpgSat(new DtpgSat()),
   mDynMode(nsDtpgCl::kDynNone),
   mTvBuff(mgr),
-  mTmpTv(NULL)
+  mTmpTv(NULL),
+  mCompTv(NULL)
 {
   mgr->bind_module(mDtpgCl);
+  pthread_mutex_init(&mMutex, NULL);
+  pthread_cond_init(&mResultCond, NULL);
+  pthread_cond_init(&mSlotCond, NULL);
 }
 
 // @brief デストラクタ
 Dtpg::~Dtpg()
 {
+  pthread_cond_destroy(&mSlotCond);
+  pthread_cond_destroy(&mResultCond);
+  pthread_mutex_destroy(&mMutex);
 }
 
 // @brief 未検出の故障に対してテストパタン生成を行う．
@@ -65,6 +97,13 @@ Dtpg::operator()(tSimMode sim_mode)
     mStats.mAbortNum = 0;
     mStats.mPatNum = 0;
     mStats.mTime = USTime(0.0, 0.0, 0.0);
+    mStats.mSolverNum = 0;
+    mStats.mCnfTime = USTime(0.0, 0.0, 0.0);
+    mStats.mSatTime = USTime(0.0, 0.0, 0.0);
+    mStats.mCompNum = 0;
+    mStats.mLearnUntestNum = 0;
+    mStats.mLearnTime = USTime(0.0, 0.0, 0.0);
+    mStats.mSavedTime = USTime(0.0, 0.0, 0.0);
     return;
   }
   
@@ -76,10 +115,7 @@ Dtpg::operator()(tSimMode sim_mode)
   MStopWatch& timer = _timer();
 
   mTmpTv = tvmgr.new_vector();
-  
-  fsim.set_faults(flist);
-  fsim3.set_faults(flist);
-  fsimx.set_faults(flist);
+  mCompTv = tvmgr.new_vector();
   
   int old_tm_id = timer.change(TM_DTPG);
   
@@ -89,23 +125,61 @@ Dtpg::operator()(tSimMode sim_mode)
   ymuint d_num0 = fmgr.det_num();
   ymuint r_num0 = fmgr.untest_num();
   ymuint p_num0 = tv_list.size();
+
+  mStats.mLearnUntestNum = 0;
+  mStats.mLearnTime = USTime(0.0, 0.0, 0.0);
+  mStats.mSavedTime = USTime(0.0, 0.0, 0.0);
+  if ( mLearning ) {
+    learn_untest();
+  }
+  
+  fsim.set_faults(flist);
+  fsim3.set_faults(flist);
+  fsimx.set_faults(flist);
   
   mStats.mDtpgNum = 0;
+  mStats.mBtNum = 0;
+  mStats.mSolverNum = 0;
+  mStats.mCnfTime = USTime(0.0, 0.0, 0.0);
+  mStats.mSatTime = USTime(0.0, 0.0, 0.0);
+  mStats.mCompNum = 0;
+  mCompPos = 0;
   
   mTvBuff.clear();
- 
-  if ( mSat ) {
-    dtpg2(sim_mode);
-  }
-  else {
-    dtpg1(sim_mode);
-  }
+
+  for (mFirstPos = 0; ; ) {
+    // 遷移故障は SAT モードでのみ扱える．
+    if ( mSat || fmgr.model() == kFmTransition ) {
+      if ( mThreadNum > 1 ) {
+	dtpg_mt(sim_mode);
+      }
+      else {
+	dtpg2(sim_mode);
+      }
+    }
+    else {
+      dtpg1(sim_mode);
+    }
     
-  mTvBuff.flush();
+    mTvBuff.flush();
   
-  fmgr.update();
+    fmgr.update();
+
+    ymuint nr = fmgr.released_num();
+    if ( nr == 0 ) {
+      break;
+    }
+    // 支配する故障が検出できなかったので対象から外していた故障が
+    // 未検出リストの末尾に戻された．それらだけをもう一度処理する．
+    mFirstPos = flist.size() - nr;
+    fsim.set_faults(flist);
+    fsim3.set_faults(flist);
+    fsimx.set_faults(flist);
+  }
+  mFirstPos = 0;
 
   tvmgr.delete_vector(mTmpTv);
+  tvmgr.delete_vector(mCompTv);
   
   mStats.mDetectNum = fmgr.det_num() - d_num0;
   mStats.mUntestNum = fmgr.untest_num() - r_num0;
@@ -113,10 +187,57 @@ Dtpg::operator()(tSimMode sim_mode)
   mStats.mPatNum = tv_list.size() - p_num0;
   local_timer.stop();
   mStats.mTime = local_timer.time();
+
+  if ( mStats.mLearnUntestNum > 0 && mStats.mDtpgNum > 0 ) {
+    // 本体のパタン生成の1回あたりの平均時間から見積もる．
+    double r = double(mStats.mLearnUntestNum) / mStats.mDtpgNum;
+    USTime t = mStats.mTime;
+    USTime lt = mStats.mLearnTime;
+    mStats.mSavedTime = USTime((t.usr_time_usec() - lt.usr_time_usec()) * r,
+			       (t.sys_time_usec() - lt.sys_time_usec()) * r,
+			       (t.real_time_usec() - lt.real_time_usec()) * r);
+  }
   
   timer.change(old_tm_id);
 }
 
+// @brief 検出不能故障の前処理を行う．
+// @note 支配関係で外していた故障が戻された場合はそれらも調べる．
+void
+Dtpg::learn_untest()
+{
+  FaultMgr& fmgr = _fault_mgr();
+  const vector<SaFault*>& flist = fmgr.remain_list();
+
+  StopWatch local_timer;
+  local_timer.start();
+
+  ymuint r_num0 = fmgr.untest_num();
+
+  UntestChecker checker;
+  checker.set_network(_network(), mDtpgSat->mode());
+  for (ymuint first = 0; ; ) {
+    ymuint n = flist.size();
+    for (ymuint i = first; i < n; ++ i) {
+      SaFault* f = flist[i];
+      if ( f->status() == kFsUndetected && checker.check(f) ) {
+	fmgr.set_status(f, kFsUntestable);
+      }
+    }
+    fmgr.update();
+    ymuint nr = fmgr.released_num();
+    if ( nr == 0 ) {
+      break;
+    }
+    first = flist.size() - nr;
+  }
+
+  local_timer.stop();
+
+  mStats.mLearnUntestNum = fmgr.untest_num() - r_num0;
+  mStats.mLearnTime = local_timer.time();
+}
+
 // @brief 未検出の故障に対してテストパタン生成を行う．
 // @param[in] sim_mode シミュレーションモード
 void
@@ -169,7 +290,7 @@ Dtpg::dtpg1(tSimMode sim_mode)
     
     mCurFaults.clear();
     mCurFaults.reserve(flist.size());
-    for (vector<SaFault*>::const_iterator p = flist.begin();
+    for (vector<SaFault*>::const_iterator p = flist.begin() + mFirstPos;
 	 p != flist.end(); ++ p) {
       mCurFaults.push_back(*p);
     }
@@ -177,7 +298,7 @@ Dtpg::dtpg1(tSimMode sim_mode)
     
     mDtpgCl->deactivate();
   }
-  mStats.mBtNum = mDtpgCl->total_backtrack_count();
+  mStats.mBtNum += mDtpgCl->total_backtrack_count();
 }
 
 // @brief 未検出の故障に対してテストパタン生成を行う．
@@ -186,65 +307,320 @@ void
 Dtpg::dtpg2(tSimMode sim_mode)
 {
   FaultMgr& fmgr = _fault_mgr();
-  vector<TestVector*>& tv_list = _tv_list();
   
   const vector<SaFault*>& flist = fmgr.remain_list();
   
   mCurFaults.clear();
   mCurFaults.reserve(flist.size());
-  for (vector<SaFault*>::const_iterator p = flist.begin();
+  for (vector<SaFault*>::const_iterator p = flist.begin() + mFirstPos;
        p != flist.end(); ++ p) {
     mCurFaults.push_back(*p);
   }
+
+  bool incremental = mDtpgSat->incremental();
+  if ( incremental ) {
+    // 同じ FFR の故障が続くように並べ替える．
+    stable_sort(mCurFaults.begin(), mCurFaults.end(), FfrLt());
+  }
   
   mTvBuff.clear();
   
-  mStats.mBtNum = 0;
+  mDtpgSat->reset_timer();
   
-  switch ( sim_mode ) {
-  case kSimNone:
-    for (ymuint i = 0; i < mCurFaults.size(); ++ i) {
-      SaFault* f = mCurFaults[i];
+  if ( sim_mode == kSimPpsfp && !incremental ) {
+    ymuint cf_num = mCurFaults.size();
+    while ( cf_num > 0 ) {
+      // ランダムに故障を抜き出す．
+      ymuint pos = ymuint(mFselGen.int32() % cf_num);
+      SaFault* f = mCurFaults[pos];
+      -- cf_num;
+      if ( pos < cf_num ) {
+	mCurFaults[pos] = mCurFaults[cf_num];
+      }
+      
       TestVector* cur_tv = dtpg_sub(f);
       if ( cur_tv ) {
-	tv_list.push_back(cur_tv);
+	put_pat(cur_tv, sim_mode);
       }
     }
-    break;
-
-  case kSimSingle:
+  }
+  else {
+    // インクリメンタルモードでは SAT ソルバを使い回すために
+    // FFR の順に処理する．
     for (ymuint i = 0; i < mCurFaults.size(); ++ i) {
       SaFault* f = mCurFaults[i];
       TestVector* cur_tv = dtpg_sub(f);
       if ( cur_tv ) {
-	mTvBuff.put(cur_tv);
-	mTvBuff.flush();
-	tv_list.push_back(cur_tv);
+	put_pat(cur_tv, sim_mode);
       }
     }
-    break;
+  }
 
-  case kSimPpsfp:
-    {
-      ymuint cf_num = mCurFaults.size();
-      while ( cf_num > 0 ) {
-	// ランダムに故障を抜き出す．
-	ymuint pos = ymuint(mFselGen.int32() % cf_num);
-	SaFault* f = mCurFaults[pos];
-	-- cf_num;
-	if ( pos < cf_num ) {
-	  mCurFaults[pos] = mCurFaults[cf_num];
+  mDtpgSat->clear();
+
+  mStats.mSolverNum += mDtpgSat->solver_num();
+  mStats.mCnfTime += mDtpgSat->cnf_time();
+  mStats.mSatTime += mDtpgSat->sat_time();
+}
+
+// @brief ワーカースレッドを用いてパタン生成を行う．
+// @param[in] sim_mode シミュレーションモード
+// @note ワーカーは故障を取り出してパタン生成を行い，結果を自分の
+// 作業領域に置いて受け取られるのを待つ．
+// 呼び出し元のスレッドは結果を受け取って故障シミュレーションを行う．
+// 故障の状態を書き換えるのは呼び出し元のスレッドだけで，ワーカーは
+// 故障を取り出した時に状態を調べて処理済みのものを飛ばす．
+void
+Dtpg::dtpg_mt(tSimMode sim_mode)
+{
+  FaultMgr& fmgr = _fault_mgr();
+  TvMgr& tvmgr = _tv_mgr();
+  MStopWatch& timer = _timer();
+  
+  const vector<SaFault*>& flist = fmgr.remain_list();
+  
+  mCurFaults.clear();
+  mCurFaults.reserve(flist.size());
+  for (vector<SaFault*>::const_iterator p = flist.begin() + mFirstPos;
+       p != flist.end(); ++ p) {
+    mCurFaults.push_back(*p);
+  }
+  ymuint nf = mCurFaults.size();
+
+  // 取り出す単位を決める．
+  // インクリメンタルモードでは同じ FFR の故障を同じワーカーが
+  // 続けて処理するように FFR ごとにまとめる．
+  // そうでなければ dtpg2() と同様にランダムな順序で一つずつ取り出す．
+  bool incremental = mDtpgSat->incremental();
+  mGroupArray.clear();
+  mGroupArray.reserve(nf + 1);
+  if ( incremental ) {
+    stable_sort(mCurFaults.begin(), mCurFaults.end(), FfrLt());
+    const TgNode* prev_root = NULL;
+    for (ymuint i = 0; i < nf; ++ i) {
+      const TgNode* root = DtpgSat::ffr_root(mCurFaults[i]->node());
+      if ( root != prev_root ) {
+	mGroupArray.push_back(i);
+	prev_root = root;
+      }
+    }
+  }
+  else {
+    for (ymuint i = nf; i > 1; -- i) {
+      ymuint pos = ymuint(mFselGen.int32() % i);
+      SaFault* tmp = mCurFaults[i - 1];
+      mCurFaults[i - 1] = mCurFaults[pos];
+      mCurFaults[pos] = tmp;
+    }
+    for (ymuint i = 0; i < nf; ++ i) {
+      mGroupArray.push_back(i);
+    }
+  }
+  mGroupArray.push_back(nf);
+  mNextGroup = 0;
+  
+  mTvBuff.clear();
+  
+  mDtpgSat->reset_timer();
+
+  int old_timer_id = timer.change(TM_SAT);
+
+  // ワーカーを起動する．
+  mWorkerArray.resize(mThreadNum);
+  mActiveNum = 0;
+  for (ymuint i = 0; i < mThreadNum; ++ i) {
+    Worker* w = new Worker;
+    w->mDtpg = this;
+    w->mDtpgSat = new DtpgSat();
+    w->mDtpgSat->set_mode(mDtpgSat->mode());
+    w->mDtpgSat->set_incremental(incremental);
+    w->mTv = tvmgr.new_vector();
+    w->mFault = NULL;
+    w->mFull = false;
+    w->mDtpgNum = 0;
+    w->mBtNum = 0;
+    mWorkerArray[i] = w;
+  }
+  // 起動したワーカーがすぐに終わった時に備えて先に数えておく．
+  mActiveNum = mThreadNum;
+  vector<bool> started(mThreadNum, false);
+  for (ymuint i = 0; i < mThreadNum; ++ i) {
+    Worker* w = mWorkerArray[i];
+    if ( pthread_create(&w->mThread, NULL, thread_main, w) == 0 ) {
+      started[i] = true;
+    }
+    else {
+      // スレッドが作れなかった分の故障は他のワーカーが処理する．
+      pthread_mutex_lock(&mMutex);
+      -- mActiveNum;
+      pthread_mutex_unlock(&mMutex);
+    }
+  }
+
+  if ( mActiveNum == 0 ) {
+    // 一つもスレッドが作れなかったので1スレッドで処理する．
+    timer.change(old_timer_id);
+    for (ymuint i = 0; i < mThreadNum; ++ i) {
+      Worker* w = mWorkerArray[i];
+      tvmgr.delete_vector(w->mTv);
+      delete w->mDtpgSat;
+      delete w;
+    }
+    mWorkerArray.clear();
+    dtpg2(sim_mode);
+    return;
+  }
+
+  // 結果を受け取って処理する．
+  vector<SaFault*> f_list;
+  vector<tStat> stat_list;
+  vector<TestVector*> tv_list;
+  for ( ; ; ) {
+    pthread_mutex_lock(&mMutex);
+    for ( ; ; ) {
+      for (ymuint i = 0; i < mThreadNum; ++ i) {
+	Worker* w = mWorkerArray[i];
+	if ( w->mFull ) {
+	  TestVector* tv = NULL;
+	  if ( w->mStat == kDetect ) {
+	    tv = tvmgr.new_vector();
+	    tv->init();
+	    tv->copy(*w->mTv);
+	  }
+	  f_list.push_back(w->mFault);
+	  stat_list.push_back(w->mStat);
+	  tv_list.push_back(tv);
+	  w->mFull = false;
 	}
-	
-	TestVector* cur_tv = dtpg_sub(f);
-	if ( cur_tv ) {
-	  mTvBuff.put(cur_tv);
-	  tv_list.push_back(cur_tv);
+      }
+      if ( !f_list.empty() || mActiveNum == 0 ) {
+	break;
+      }
+      pthread_cond_wait(&mResultCond, &mMutex);
+    }
+    pthread_cond_broadcast(&mSlotCond);
+    pthread_mutex_unlock(&mMutex);
+
+    if ( f_list.empty() ) {
+      // 全てのワーカーが終わった．
+      break;
+    }
+
+    timer.change(old_timer_id);
+    for (ymuint i = 0; i < f_list.size(); ++ i) {
+      SaFault* f = f_list[i];
+      TestVector* tv = tv_list[i];
+      if ( f->status() != kFsUndetected ) {
+	// パタン生成中に故障シミュレーションで検出されていた．
+	if ( tv ) {
+	  tvmgr.delete_vector(tv);
 	}
+	continue;
+      }
+      if ( tv ) {
+	mTmpTv->init();
+	mTmpTv->copy(*tv);
+	tvmgr.delete_vector(tv);
+      }
+      mDetFaults.clear();
+      TestVector* cur_tv = after_dtpg(f, stat_list[i]);
+      if ( cur_tv ) {
+	put_pat(cur_tv, sim_mode);
       }
     }
-    break;
+    f_list.clear();
+    stat_list.clear();
+    tv_list.clear();
+    timer.change(TM_SAT);
+  }
+
+  // ワーカーを片付ける．
+  for (ymuint i = 0; i < mThreadNum; ++ i) {
+    Worker* w = mWorkerArray[i];
+    if ( started[i] ) {
+      pthread_join(w->mThread, NULL);
+    }
+    mStats.mDtpgNum += w->mDtpgNum;
+    mStats.mBtNum += w->mBtNum;
+    mStats.mSolverNum += w->mDtpgSat->solver_num();
+    mStats.mCnfTime += w->mDtpgSat->cnf_time();
+    mStats.mSatTime += w->mDtpgSat->sat_time();
+    tvmgr.delete_vector(w->mTv);
+    delete w->mDtpgSat;
+    delete w;
+  }
+  mWorkerArray.clear();
+
+  timer.change(old_timer_id);
+
+  // 動的圧縮で用いた分
+  mDtpgSat->clear();
+  mStats.mSolverNum += mDtpgSat->solver_num();
+  mStats.mCnfTime += mDtpgSat->cnf_time();
+  mStats.mSatTime += mDtpgSat->sat_time();
+}
+
+// @brief ワーカーの本体
+void
+Dtpg::worker_main(Worker& w)
+{
+  const TgNetwork& network = _network();
+  ymuint begin;
+  ymuint end;
+  while ( get_fault_range(begin, end) ) {
+    for (ymuint i = begin; i < end; ++ i) {
+      SaFault* f = mCurFaults[i];
+      if ( f->status() != kFsUndetected ) {
+	// すでに検出されていた．
+	continue;
+      }
+      tStat stat = w.mDtpgSat->run(network, f, w.mTv);
+      ++ w.mDtpgNum;
+      w.mBtNum += w.mDtpgSat->stats().mDecisionNum;
+
+      pthread_mutex_lock(&mMutex);
+      w.mFault = f;
+      w.mStat = stat;
+      w.mFull = true;
+      pthread_cond_signal(&mResultCond);
+      while ( w.mFull ) {
+	pthread_cond_wait(&mSlotCond, &mMutex);
+      }
+      pthread_mutex_unlock(&mMutex);
+    }
+  }
+  w.mDtpgSat->clear();
+
+  pthread_mutex_lock(&mMutex);
+  -- mActiveNum;
+  pthread_cond_signal(&mResultCond);
+  pthread_mutex_unlock(&mMutex);
+}
+
+// @brief スレッドの本体
+void*
+Dtpg::thread_main(void* arg)
+{
+  Worker* w = static_cast<Worker*>(arg);
+  w->mDtpg->worker_main(*w);
+  return NULL;
+}
+
+// @brief 処理する故障の範囲を取り出す．
+// @param[out] begin, end 範囲
+// @retval false 全ての故障を取り出し終えた．
+bool
+Dtpg::get_fault_range(ymuint& begin,
+		      ymuint& end)
+{
+  ymuint ng = mGroupArray.size() - 1;
+  ymuint pos = __sync_fetch_and_add(&mNextGroup, 1);
+  if ( pos >= ng ) {
+    return false;
   }
+  begin = mGroupArray[pos];
+  end = mGroupArray[pos + 1];
+  return true;
 }
 
 void
@@ -296,11 +672,9 @@ Dtpg::dtpg_sub(SaFault* f)
     return NULL;
   }
   
-  FaultMgr& fmgr = _fault_mgr();
-    
   ++ mStats.mDtpgNum;
   tStat stat;
-  if ( mSat ) {
+  if ( mSat || f->model() == kFmTransition ) {
     MStopWatch& timer = _timer();
     int old_timer_id = timer.change(TM_SAT);
     TgNetwork& network = _network();
@@ -312,6 +686,20 @@ Dtpg::dtpg_sub(SaFault* f)
   else {
     stat = mDtpgCl->run(f, mCurFaults, mDynMode, mTmpTv, mDetFaults);
   }
+  return after_dtpg(f, stat);
+}
+
+// @brief パタン生成の結果を処理する．
+// @param[in] f 対象の故障
+// @param[in] stat パタン生成の結果
+// @return stat が kDetect の時は mTmpTv をもとにしたパタンを返す．
+// @note mTmpTv で検出される故障は検出済みにする．
+TestVector*
+Dtpg::after_dtpg(SaFault* f,
+		 tStat stat)
+{
+  FaultMgr& fmgr = _fault_mgr();
+
   if ( stat == kUntest ) {
     // 検出不能故障
     fmgr.set_status(f, kFsUntestable);
@@ -323,15 +711,41 @@ Dtpg::dtpg_sub(SaFault* f)
     return NULL;
   }
 
+  if ( mCompLimit > 0 ) {
+    compact(f);
+  }
+
   TvMgr& tvmgr = _tv_mgr();
   TestVector* cur_tv = tvmgr.new_vector();
-  cur_tv->set_from_random(mPatGen);
+  if ( mKeepX ) {
+    cur_tv->init();
+  }
+  else {
+    cur_tv->set_from_random(mPatGen);
+  }
   cur_tv->copy(*mTmpTv);
 
   if ( verify_dtpg ) {
-    Fsim3& fsimx = _fsim3();
     list<SaFault*> flist;
-    fsimx.run(mTmpTv, flist);
+    if ( f->model() == kFmTransition ) {
+      // Fsim3 は遷移故障を扱えないので Fsim で検証する．
+      // Fsim は X を 0 とみなすので X を埋めた後の cur_tv を用いる．
+      // X を残す時は埋め方によって結果が変わるので f 以外の故障は
+      // 検出済みにしない．
+      Fsim& fsim = _fsim();
+      fsim.run(cur_tv, flist);
+      if ( mKeepX ) {
+	bool det = (find(flist.begin(), flist.end(), f) != flist.end());
+	flist.clear();
+	if ( det ) {
+	  flist.push_back(f);
+	}
+      }
+    }
+    else {
+      Fsim3& fsimx = _fsim3();
+      fsimx.run(mTmpTv, flist);
+    }
 
     for (list<SaFault*>::iterator p = flist.begin();
 	 p != flist.end(); ++ p) {
@@ -366,6 +780,77 @@ Dtpg::dtpg_sub(SaFault* f)
   }
   return cur_tv;
 }
+
+// @brief 生成したパタンをシミュレーションモードに従って登録する．
+void
+Dtpg::put_pat(TestVector* tv,
+	      tSimMode sim_mode)
+{
+  vector<TestVector*>& tv_list = _tv_list();
+  switch ( sim_mode ) {
+  case kSimNone:
+    break;
+
+  case kSimSingle:
+    mTvBuff.put(tv);
+    mTvBuff.flush();
+    break;
+
+  case kSimPpsfp:
+    mTvBuff.put(tv);
+    break;
+  }
+  tv_list.push_back(tv);
+}
+
+// @brief mTmpTv を拡張して f 以外の未検出の故障も検出するようにする．
+// @param[in] f 最初の対象の故障
+// @note mTmpTv の X でない入力を固定して SAT で解くので，
+// 検出できた故障の分だけ mTmpTv の X が減っていく．
+// mTmpTv の X でない入力はそれぞれの故障の影響範囲の入力を全て
+// 含んでいるので，X をどう埋めても全ての故障が検出される．
+void
+Dtpg::compact(SaFault* f)
+{
+  FaultMgr& fmgr = _fault_mgr();
+  TgNetwork& network = _network();
+  MStopWatch& timer = _timer();
+  int old_timer_id = timer.change(TM_SAT);
+
+  // 毎回先頭から調べると同じ故障ばかり試すことになるので
+  // 前回の続きから調べる．
+  const vector<SaFault*>& flist = fmgr.remain_list();
+  ymuint n = flist.size();
+  ymuint ntry = 0;
+  for (ymuint i = 0; i < n && ntry < mCompLimit; ++ i) {
+    if ( mTmpTv->x_num() == 0 ) {
+      // もう拡張できない．
+      break;
+    }
+    if ( mCompPos >= n ) {
+      mCompPos = 0;
+    }
+    SaFault* f1 = flist[mCompPos];
+    ++ mCompPos;
+    if ( f1 == f || f1->status() != kFsUndetected ) {
+      continue;
+    }
+    if ( find(mDetFaults.begin(), mDetFaults.end(), f1) != mDetFaults.end() ) {
+      continue;
+    }
+    ++ ntry;
+    tStat stat = mDtpgSat->run_with_cube(network, f1, mTmpTv, mCompTv);
+    mStats.mBtNum += mDtpgSat->stats().mDecisionNum;
+    if ( stat == kDetect ) {
+      mTmpTv->copy(*mCompTv);
+      mDetFaults.push_back(f1);
+      ++ mStats.mCompNum;
+    }
+    // cube のもとで検出できなくても検出不能とは限らない．
+  }
+
+  timer.change(old_timer_id);
+}
   
 // @brief 直前の実行結果を返す．
 const DtpgStats&
@@ -432,6 +917,23 @@ Dtpg::set_sat_mode(int mode)
   mDtpgSat->set_mode(mode);
 }
 
+// @brief FFR ごとに SAT ソルバを使い回すかどうかを指定する．
+void
+Dtpg::set_sat_incremental(bool flag)
+{
+  mDtpgSat->set_incremental(flag);
+}
+
+// @brief SAT モードでパタン生成を行うスレッド数を設定する．
+void
+Dtpg::set_thread_num(ymuint num)
+{
+  if ( num == 0 ) {
+    num = 1;
+  }
+  mThreadNum = num;
+}
+
 // @brief スコーピングの制御を行う．
 void
 Dtpg::set_scoping(bool flag)
@@ -439,6 +941,27 @@ Dtpg::set_scoping(bool flag)
   mScoping = flag;
 }
 
+// @brief 生成したパタンの X を残すかどうかを指定する．
+void
+Dtpg::set_keep_x(bool flag)
+{
+  mKeepX = flag;
+}
+
+// @brief 動的圧縮の制御を行う．
+void
+Dtpg::set_compaction(ymuint limit)
+{
+  mCompLimit = limit;
+}
+
+// @brief 検出不能故障の前処理を行うかどうかを指定する．
+void
+Dtpg::set_learning(bool flag)
+{
+  mLearning = flag;
+}
+
 // @brief バックトラック数のカウンタをクリアする．
 void
 Dtpg::clear_backtrack_count()
@@ -474,6 +997,9 @@ DtpgStats::DtpgStats()
   mPatNum = 0;
   mDtpgNum = 0;
   mBtNum = 0;
+  mSolverNum = 0;
+  mCompNum = 0;
+  mLearnUntestNum = 0;
 }
 
 // @brief デストラクタ
@@ -530,4 +1056,53 @@ DtpgStats::time() const
   return mTime;
 }
 
+// @brief SAT モードで生成した SAT ソルバの数を得る．
+ymuint
+DtpgStats::solver_count() const
+{
+  return mSolverNum;
+}
+
+// @brief SAT モードで CNF の生成に要した時間を得る．
+USTime
+DtpgStats::cnf_time() const
+{
+  return mCnfTime;
+}
+
+// @brief SAT モードで SAT ソルバの実行に要した時間を得る．
+USTime
+DtpgStats::sat_time() const
+{
+  return mSatTime;
+}
+
+// @brief 動的圧縮で追加の対象として検出した故障数を得る．
+ymuint
+DtpgStats::compacted_faults() const
+{
+  return mCompNum;
+}
+
+// @brief 前処理で検出不能と判定した故障数を得る．
+ymuint
+DtpgStats::learned_untestable_faults() const
+{
+  return mLearnUntestNum;
+}
+
+// @brief 前処理に要した時間を得る．
+USTime
+DtpgStats::learning_time() const
+{
+  return mLearnTime;
+}
+
+// @brief 前処理で省いたパタン生成の時間の見積もりを得る．
+USTime
+DtpgStats::saved_time() const
+{
+  return mSavedTime;
+}
+
 END_NAMESPACE_YM_ATPG
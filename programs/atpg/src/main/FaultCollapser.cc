@@ -0,0 +1,261 @@
+
+/// @file src/main/FaultCollapser.cc
+/// @brief FaultCollapser の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id: FaultCollapser.cc 2203 2009-04-16 05:04:40Z matsunaga $
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "FaultCollapser.h"
+#include "dtpg_sat/DtpgSat.h"
+#include "fsim/Fsim.h"
+#include "SaFault.h"
+#include "FaultMgr.h"
+#include "TestVector.h"
+#include "TvMgr.h"
+#include "ym_utils/StopWatch.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_YM_ATPG
+
+BEGIN_NONAMESPACE
+
+// シグネチャの辞書式順で故障番号を並べるための比較関数
+struct SigLt
+{
+  SigLt(const vector<ymuint>& sig,
+	ymuint w) :
+    mSig(sig),
+    mW(w)
+  {
+  }
+
+  bool
+  operator()(ymuint left,
+	     ymuint right) const
+  {
+    for (ymuint i = 0; i < mW; ++ i) {
+      ymuint l = mSig[left * mW + i];
+      ymuint r = mSig[right * mW + i];
+      if ( l != r ) {
+	return l < r;
+      }
+    }
+    return false;
+  }
+
+  const vector<ymuint>& mSig;
+
+  ymuint mW;
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス FaultCollapser
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+FaultCollapser::FaultCollapser(AtpgMgr* mgr) :
+  AtpgFunctor(mgr),
+  mDtpgSat(new DtpgSat())
+{
+}
+
+// @brief デストラクタ
+FaultCollapser::~FaultCollapser()
+{
+  delete mDtpgSat;
+}
+
+// @brief 等価な故障を対象から外す．
+// @param[in] round_num 故障シミュレーションの回数
+// @note 各回の並列パタン故障シミュレーションで最初に検出した
+// パタンの番号を並べたものをシグネチャとする．等価な故障は
+// 検出パタンの集合が等しいのでシグネチャも等しくなる．
+void
+FaultCollapser::operator()(ymuint round_num)
+{
+  StopWatch local_timer;
+  MStopWatch& timer = _timer();
+
+  int old_timer_id = timer.change(TM_FSIM);
+
+  local_timer.start();
+
+  mStats.mCollapsedNum = 0;
+  mStats.mCheckNum = 0;
+
+  FaultMgr& fault_mgr = _fault_mgr();
+  vector<SaFault*> flist(fault_mgr.remain_list());
+  ymuint nf = flist.size();
+  if ( fault_mgr.model() == kFmStuckAt && nf > 1 && round_num > 0 ) {
+    TvMgr& tv_mgr = _tv_mgr();
+    Fsim& fsim = _fsim();
+
+    hash_map<ympuint, ymuint> id_map;
+    for (ymuint i = 0; i < nf; ++ i) {
+      id_map.insert(make_pair(reinterpret_cast<ympuint>(flist[i]), i));
+    }
+
+    // 検出されなかった時は kPvBitLen とする．
+    vector<ymuint> sig(nf * round_num, kPvBitLen);
+    vector<TestVector*> tv_array(kPvBitLen);
+    for (ymuint i = 0; i < kPvBitLen; ++ i) {
+      tv_array[i] = tv_mgr.new_vector();
+    }
+    vector<list<SaFault*> > det_faults(kPvBitLen);
+    for (ymuint r = 0; r < round_num; ++ r) {
+      for (ymuint i = 0; i < kPvBitLen; ++ i) {
+	tv_array[i]->set_from_random(mPatGen);
+      }
+      // Fsim は検出した故障を内部のリストから取り除くので
+      // 毎回設定し直す．
+      fsim.set_faults(flist);
+      fsim.run(tv_array, det_faults);
+      for (ymuint i = 0; i < kPvBitLen; ++ i) {
+	for (list<SaFault*>::iterator p = det_faults[i].begin();
+	     p != det_faults[i].end(); ++ p) {
+	  ymuint id = id_map[reinterpret_cast<ympuint>(*p)];
+	  sig[id * round_num + r] = i;
+	}
+      }
+    }
+    for (ymuint i = 0; i < kPvBitLen; ++ i) {
+      tv_mgr.delete_vector(tv_array[i]);
+    }
+    fsim.set_faults(fault_mgr.remain_list());
+
+    vector<ymuint> order(nf);
+    for (ymuint i = 0; i < nf; ++ i) {
+      order[i] = i;
+    }
+    SigLt lt(sig, round_num);
+    sort(order.begin(), order.end(), lt);
+
+    timer.change(TM_SAT);
+
+    vector<SaFault*> group;
+    for (ymuint b = 0; b < nf; ) {
+      ymuint e = b + 1;
+      while ( e < nf && !lt(order[b], order[e]) ) {
+	++ e;
+      }
+      // 一度も検出されなかった故障は扱わない．
+      bool detected = false;
+      for (ymuint r = 0; r < round_num; ++ r) {
+	if ( sig[order[b] * round_num + r] != kPvBitLen ) {
+	  detected = true;
+	  break;
+	}
+      }
+      if ( detected && e - b > 1 ) {
+	group.clear();
+	for (ymuint i = b; i < e; ++ i) {
+	  group.push_back(flist[order[i]]);
+	}
+	collapse_group(group);
+      }
+      b = e;
+    }
+    fault_mgr.update();
+  }
+
+  local_timer.stop();
+
+  timer.change(old_timer_id);
+
+  mStats.mTime = local_timer.time();
+}
+
+// @brief 検出パタンの等しい故障のグループを処理する．
+// @param[in] group 故障のグループ
+// @note 先頭の故障を代表として，それに支配される故障を対象から
+// 外す．残った故障で同じことを繰り返す．
+// シグネチャが偶然一致しただけの大きなグループで時間がかからない
+// ように，調べる回数はグループの大きさの定数倍までとする．
+void
+FaultCollapser::collapse_group(vector<SaFault*>& group)
+{
+  TgNetwork& network = _network();
+  FaultMgr& fault_mgr = _fault_mgr();
+
+  ymuint limit = group.size() * 4;
+  ymuint count = 0;
+  vector<SaFault*> rest;
+  while ( group.size() > 1 && count < limit ) {
+    SaFault* rep = group[0];
+    rest.clear();
+    ymuint n = group.size();
+    for (ymuint i = 1; i < n; ++ i) {
+      SaFault* f = group[i];
+      if ( count >= limit ) {
+	break;
+      }
+      ++ count;
+      ++ mStats.mCheckNum;
+      Bool3 stat = mDtpgSat->check_dominance(network, f, rep);
+      if ( stat == kB3True ) {
+	if ( fault_mgr.add_dominance(f, rep) ) {
+	  ++ mStats.mCollapsedNum;
+	}
+      }
+      else {
+	rest.push_back(f);
+      }
+    }
+    group.swap(rest);
+  }
+}
+
+// @brief 直前の実行結果を得る．
+const FaultCollapserStats&
+FaultCollapser::stats() const
+{
+  return mStats;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス FaultCollapserStats
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+FaultCollapserStats::FaultCollapserStats()
+{
+  mCollapsedNum = 0;
+  mCheckNum = 0;
+}
+
+// @brief デストラクタ
+FaultCollapserStats::~FaultCollapserStats()
+{
+}
+
+// @brief 対象から外した故障数を得る．
+ymuint
+FaultCollapserStats::collapsed_faults() const
+{
+  return mCollapsedNum;
+}
+
+// @brief 支配関係を調べた回数を得る．
+ymuint
+FaultCollapserStats::check_count() const
+{
+  return mCheckNum;
+}
+
+// @brief 計算時間を得る．
+USTime
+FaultCollapserStats::time() const
+{
+  return mTime;
+}
+
+END_NAMESPACE_YM_ATPG
@@ -1,6 +1,6 @@
 
 /// @file src/main/MinPat.cc
-/// @brief Fsim の実装ファイル
+/// @brief MinPat の実装ファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
 /// $Id: MinPat.cc 2203 2009-04-16 05:04:40Z matsunaga $
@@ -11,14 +11,33 @@
 
 #include "MinPat.h"
 #include "fsim/Fsim.h"
-#include "base/SaFault.h"
-#include "base/FaultMgr.h"
-#include "base/TvMgr.h"
+#include "fsim3/Fsim3.h"
+#include "SaFault.h"
+#include "FaultMgr.h"
+#include "TestVector.h"
+#include "TvMgr.h"
 #include "ym_utils/StopWatch.h"
+#include <algorithm>
 
 
 BEGIN_NAMESPACE_YM_ATPG
 
+BEGIN_NONAMESPACE
+
+// X の少ない順に並べるための比較関数
+struct XnumLt
+{
+  bool
+  operator()(const pair<ymuint, TestVector*>& left,
+	     const pair<ymuint, TestVector*>& right) const
+  {
+    return left.first < right.first;
+  }
+};
+
+END_NONAMESPACE
+
+
 //////////////////////////////////////////////////////////////////////
 // クラス MinPat
 //////////////////////////////////////////////////////////////////////
@@ -35,113 +54,285 @@ MinPat::~MinPat()
 }
 
 // @brief テストベクタの最小化を行う．
-// @param[in] mode モード
+// @param[in] mode 最小化モード (kMinPatReverse などの論理和)
+// @param[in] rand_iter ランダムな順序の故障シミュレーションの回数
+// @note 手順は以下の通り．
+//  1. X を含むパタンを3値の故障シミュレーションで絞り込んでから
+//     両立するものを併合し，残った X を乱数で埋める．
+//  2. 逆順とランダムな順序の故障シミュレーションで不要なパタンを
+//     取り除く．
+//  3. 元のパタンでしか検出されていなかった故障があればそれを
+//     検出する元のパタンを加える．
+// 3値のシミュレーションでは X を特定の値にしても検出した故障は
+// 検出されたままなので，1. で検出結果が失われるのは X を 0 とみなして
+// 検出されていた故障だけである．3. はそのためにある．
 void
-MinPat::operator()(ymuint mode)
+MinPat::operator()(ymuint mode,
+		   ymuint rand_iter)
 {
   StopWatch local_timer;
   MStopWatch& timer = _timer();
 
   int old_timer_id = timer.change(TM_FSIM);
-  
+
   local_timer.start();
-  
+
   FaultMgr& fault_mgr = _fault_mgr();
   TvMgr& tv_mgr = _tv_mgr();
   vector<TestVector*>& tv_list = _tv_list();
-  Fsim& fsim = _fsim();
-  
-  fsim.set_faults(fault_mgr.remain_list());
-  
-  ymuint fnum = fault_mgr.remain_list().size();
-  ymuint undet_i = 0;
-  ymuint epat_num = 0;
-  ymuint total_det_count = 0;
-  
-  TestVector* tv_array[kPvBitLen];
-  for (ymuint i = 0; i < kPvBitLen; ++ i) {
-    tv_array[i] = tv_mgr.new_vector();
-  }
-  
-  vector<TestVector*> cur_array;
-  cur_array.reserve(kPvBitLen);
-  vector<list<SaFault*> > det_faults(kPvBitLen);
-  
-  ymuint pat_num = 0;
-  for ( ; ; ) {
-    if ( pat_num < max_pat ) {
-      TestVector* tv = tv_array[cur_array.size()];
-      tv->set_from_random(mPatGen);
-      cur_array.push_back(tv);
-      ++ pat_num;
-      if ( cur_array.size() < kPvBitLen ) {
-	continue;
-      }
+
+  mFaultList = fault_mgr.det_list();
+
+  ymuint nv = tv_list.size();
+  mStats.mPatNum1 = nv;
+
+  // 作業用の複製を作る．
+  // 元のパタンは 3. のためにとっておく．
+  vector<TestVector*> cur_list(nv);
+  bool has_x = false;
+  for (ymuint i = 0; i < nv; ++ i) {
+    TestVector* tv = tv_mgr.new_vector();
+    tv->init();
+    tv->copy(*tv_list[i]);
+    cur_list[i] = tv;
+    if ( !has_x && tv->x_num() > 0 ) {
+      has_x = true;
     }
-    else if ( cur_array.empty() ) {
-      break;
+  }
+
+  if ( (mode & kMinPatMerge) && has_x ) {
+    if ( fault_mgr.model() == kFmStuckAt ) {
+      // Fsim3 は縮退故障しか扱えない．
+      drop_by_fsim3(cur_list);
     }
+    merge(cur_list);
+  }
+  for (vector<TestVector*>::iterator p = cur_list.begin();
+       p != cur_list.end(); ++ p) {
+    (*p)->fix_x_from_random(mRandGen);
+  }
 
-    fsim.run(cur_array, det_faults);
-    
-    ymuint det_count = 0;
-    for (ymuint i = 0; i < cur_array.size(); ++ i) {
-      ymuint det_count1 = det_faults[i].size();
-      if ( det_count1 ) {
-	det_count += det_count1;
-	TestVector* tv = cur_array[i];
-	tv_list.push_back(tv);
-	tv_array[i] = tv_mgr.new_vector();
-	++ epat_num;
-	for (list<SaFault*>::iterator p = det_faults[i].begin();
-	     p != det_faults[i].end(); ++ p) {
-	  SaFault* f = *p;
-	  if ( f->status() == kFsNotYet ) {
-	    fault_mgr.set_detected(f, tv);
-	  }
-	}
+  if ( mode & kMinPatReverse ) {
+    reverse(cur_list.begin(), cur_list.end());
+    drop_by_fsim(cur_list);
+    reverse(cur_list.begin(), cur_list.end());
+  }
+
+  if ( mode & kMinPatRandom ) {
+    for (ymuint i = 0; i < rand_iter; ++ i) {
+      ymuint n = cur_list.size();
+      for (ymuint j = n; j > 1; -- j) {
+	ymuint k = mRandGen.int32() % j;
+	TestVector* tmp = cur_list[j - 1];
+	cur_list[j - 1] = cur_list[k];
+	cur_list[k] = tmp;
       }
+      drop_by_fsim(cur_list);
     }
-    cur_array.clear();
-    
-    fault_mgr.update();
-    total_det_count += det_count;
-    
-    if ( total_det_count == fnum ) {
-      // すべての故障を検出した．
-      break;
+  }
+
+  // 取りこぼした故障を元のパタンで検出する．
+  // 元のパタンの X は Fsim と同じく 0 とみなす．
+  reset_faults();
+  Fsim& fsim = _fsim();
+  fsim.set_faults(mFaultList);
+  ymuint remain = mFaultList.size();
+  vector<list<SaFault*> > det_faults(kPvBitLen);
+  vector<TestVector*> tmp_list;
+  tmp_list.reserve(kPvBitLen);
+  for (ymuint b = 0; b < cur_list.size(); b += kPvBitLen) {
+    ymuint e = b + kPvBitLen;
+    if ( e > cur_list.size() ) {
+      e = cur_list.size();
     }
-    if ( det_count < min_f ) {
-      // 検出故障数の下限を下回った
-      break;
+    tmp_list.assign(cur_list.begin() + b, cur_list.begin() + e);
+    fsim.run(tmp_list, det_faults);
+    for (ymuint i = 0; i < tmp_list.size(); ++ i) {
+      for (list<SaFault*>::iterator p = det_faults[i].begin();
+	   p != det_faults[i].end(); ++ p) {
+	fault_mgr.set_status(*p, kFsDetected);
+	-- remain;
+      }
     }
-    if ( det_count > 0 ) {
-      undet_i = 0;
+  }
+  for (ymuint i = 0; i < nv && remain > 0; ++ i) {
+    TestVector* tv = tv_list[i];
+    bool used = false;
+    list<SaFault*> det_list;
+    fsim.run(tv, det_list);
+    for (list<SaFault*>::iterator p = det_list.begin();
+	 p != det_list.end(); ++ p) {
+      fault_mgr.set_status(*p, kFsDetected);
+      -- remain;
+      used = true;
     }
-    else {
-      ++ undet_i;
-      if ( undet_i > max_i ) {
-	// 未検出の回数が max_i を越えた．
-	break;
+    if ( used ) {
+      for (ymuint j = 0; j < tv->ni(); ++ j) {
+	if ( tv->val3(j) == kValX ) {
+	  tv->set_val(j, kVal0);
+	}
       }
+      cur_list.push_back(tv);
+      tv_list[i] = NULL;
     }
   }
 
-  for (ymuint i = 0; i < kPvBitLen; ++ i) {
-    tv_mgr.delete_vector(tv_array[i]);
+  // 元のパタンを置き換える．
+  for (vector<TestVector*>::iterator p = tv_list.begin();
+       p != tv_list.end(); ++ p) {
+    if ( *p ) {
+      tv_mgr.delete_vector(*p);
+    }
+  }
+  tv_list = cur_list;
+
+  // 元のパタン以外で検出されていた故障もあり得るので
+  // 検出済みの状態に戻しておく．
+  for (vector<SaFault*>::iterator p = mFaultList.begin();
+       p != mFaultList.end(); ++ p) {
+    fault_mgr.set_status(*p, kFsDetected);
   }
+  mFaultList.clear();
 
   local_timer.stop();
-  USTime time = local_timer.time();
 
   timer.change(old_timer_id);
 
-  mStats.mDetectNum = total_det_count;
-  mStats.mPatNum = pat_num;
-  mStats.mEfPatNum = epat_num;
+  mStats.mPatNum2 = tv_list.size();
   mStats.mTime = local_timer.time();
 }
-  
+
+// @brief 3値の故障シミュレーションで不要なパタンを取り除く．
+// @param[inout] tv_list 対象のパタンのリスト
+// @note 後ろのパタンから順にシミュレーションを行う．
+void
+MinPat::drop_by_fsim3(vector<TestVector*>& tv_list)
+{
+  FaultMgr& fault_mgr = _fault_mgr();
+  TvMgr& tv_mgr = _tv_mgr();
+  Fsim3& fsim3 = _fsim3();
+
+  reset_faults();
+  fsim3.set_faults(mFaultList);
+
+  ymuint n = tv_list.size();
+  ymuint wpos = n;
+  for (ymuint rpos = n; rpos > 0; ) {
+    -- rpos;
+    TestVector* tv = tv_list[rpos];
+    list<SaFault*> det_list;
+    fsim3.run(tv, det_list);
+    if ( det_list.empty() ) {
+      tv_mgr.delete_vector(tv);
+      continue;
+    }
+    for (list<SaFault*>::iterator p = det_list.begin();
+	 p != det_list.end(); ++ p) {
+      fault_mgr.set_status(*p, kFsDetected);
+    }
+    -- wpos;
+    tv_list[wpos] = tv;
+  }
+  tv_list.erase(tv_list.begin(), tv_list.begin() + wpos);
+}
+
+// @brief 両立するパタンを併合する．
+// @param[inout] tv_list 対象のパタンのリスト
+// @note X の少ないパタンから順に，最初に見つかった両立する
+// パタンに併合していく．
+void
+MinPat::merge(vector<TestVector*>& tv_list)
+{
+  TvMgr& tv_mgr = _tv_mgr();
+
+  ymuint n = tv_list.size();
+  vector<pair<ymuint, TestVector*> > tmp_list(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    TestVector* tv = tv_list[i];
+    tmp_list[i] = make_pair(tv->x_num(), tv);
+  }
+  stable_sort(tmp_list.begin(), tmp_list.end(), XnumLt());
+
+  tv_list.clear();
+  for (ymuint i = 0; i < n; ++ i) {
+    TestVector* tv = tmp_list[i].second;
+    bool merged = false;
+    for (vector<TestVector*>::iterator p = tv_list.begin();
+	 p != tv_list.end(); ++ p) {
+      TestVector* tv1 = *p;
+      if ( tv1->is_compatible(*tv) ) {
+	tv1->copy(*tv);
+	merged = true;
+	break;
+      }
+    }
+    if ( merged ) {
+      tv_mgr.delete_vector(tv);
+    }
+    else {
+      tv_list.push_back(tv);
+    }
+  }
+}
+
+// @brief 故障シミュレーションで不要なパタンを取り除く．
+// @param[inout] tv_list 対象のパタンのリスト
+// @note 前から順に，最初に検出したパタンに故障を割り当てて，
+// 一つも故障が割り当てられなかったパタンを取り除く．
+// 並列パタン故障シミュレーションは故障を検出したパタンのうち
+// 最初のものを返すので，前から kPvBitLen 個ずつまとめて
+// シミュレーションしても結果は変わらない．
+void
+MinPat::drop_by_fsim(vector<TestVector*>& tv_list)
+{
+  FaultMgr& fault_mgr = _fault_mgr();
+  TvMgr& tv_mgr = _tv_mgr();
+  Fsim& fsim = _fsim();
+
+  reset_faults();
+  fsim.set_faults(mFaultList);
+
+  vector<list<SaFault*> > det_faults(kPvBitLen);
+  vector<TestVector*> tmp_list;
+  tmp_list.reserve(kPvBitLen);
+  ymuint n = tv_list.size();
+  ymuint wpos = 0;
+  for (ymuint b = 0; b < n; b += kPvBitLen) {
+    ymuint e = b + kPvBitLen;
+    if ( e > n ) {
+      e = n;
+    }
+    tmp_list.assign(tv_list.begin() + b, tv_list.begin() + e);
+    fsim.run(tmp_list, det_faults);
+    for (ymuint i = 0; i < tmp_list.size(); ++ i) {
+      TestVector* tv = tmp_list[i];
+      if ( det_faults[i].empty() ) {
+	tv_mgr.delete_vector(tv);
+	continue;
+      }
+      for (list<SaFault*>::iterator p = det_faults[i].begin();
+	   p != det_faults[i].end(); ++ p) {
+	fault_mgr.set_status(*p, kFsDetected);
+      }
+      tv_list[wpos] = tv;
+      ++ wpos;
+    }
+  }
+  tv_list.erase(tv_list.begin() + wpos, tv_list.end());
+}
+
+// @brief 対象の故障の状態を未検出に戻す．
+// @note FaultMgr::update() を呼ばなければ検出済みのリストは変わらない．
+void
+MinPat::reset_faults()
+{
+  FaultMgr& fault_mgr = _fault_mgr();
+  for (vector<SaFault*>::iterator p = mFaultList.begin();
+       p != mFaultList.end(); ++ p) {
+    fault_mgr.set_status(*p, kFsUndetected);
+  }
+}
+
 // @brief 直前の実行結果を得る．
 const MinPatStats&
 MinPat::stats() const
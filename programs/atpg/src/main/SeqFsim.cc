@@ -0,0 +1,263 @@
+
+/// @file src/main/SeqFsim.cc
+/// @brief SeqFsim の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id: SeqFsim.cc 2203 2009-04-16 05:04:40Z matsunaga $
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "SeqFsim.h"
+#include "fsim/Fsim.h"
+#include "SaFault.h"
+#include "FaultMgr.h"
+#include "TestVector.h"
+#include "TvMgr.h"
+#include "ym_utils/StopWatch.h"
+
+
+BEGIN_NAMESPACE_YM_ATPG
+
+BEGIN_NONAMESPACE
+
+// 0, 1, X の並びを tv の pos 番めから設定する．
+// 不適切な文字を含んでいたら false を返す．
+bool
+set_vals(TestVector* tv,
+	 ymuint pos,
+	 const string& str)
+{
+  ymuint n = str.size();
+  for (ymuint i = 0; i < n; ++ i) {
+    Val3 val = kValX;
+    switch ( str[i] ) {
+    case '0': val = kVal0; break;
+    case '1': val = kVal1; break;
+    case 'X':
+    case 'x': val = kValX; break;
+    default: return false;
+    }
+    tv->set_val(pos + i, val);
+  }
+  return true;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス SeqFsim
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+SeqFsim::SeqFsim(AtpgMgr* mgr) :
+  AtpgFunctor(mgr)
+{
+}
+
+// @brief デストラクタ
+SeqFsim::~SeqFsim()
+{
+}
+
+// @brief テスト系列を読み込んで故障シミュレーションを行う．
+// @param[in] s テスト系列を読み込むストリーム
+// @param[in] err_out エラーメッセージを出力するストリーム
+// @return 読み込みに失敗した時には false を返す．
+bool
+SeqFsim::operator()(istream& s,
+		    ostream& err_out)
+{
+  FaultMgr& fault_mgr = _fault_mgr();
+  if ( fault_mgr.model() != kFmStuckAt ) {
+    err_out << "Only stuck-at faults are supported in sequential fault simulation."
+	    << endl;
+    return false;
+  }
+
+  TvMgr& tv_mgr = _tv_mgr();
+  vector<TestVector*> tv_list;
+  if ( !read(s, err_out, tv_list) ) {
+    for (vector<TestVector*>::iterator p = tv_list.begin();
+	 p != tv_list.end(); ++ p) {
+      tv_mgr.delete_vector(*p);
+    }
+    return false;
+  }
+
+  StopWatch local_timer;
+  MStopWatch& timer = _timer();
+
+  int old_timer_id = timer.change(TM_FSIM);
+
+  local_timer.start();
+
+  Fsim& fsim = _fsim();
+
+  ymuint nt = tv_list.size();
+  vector<list<SaFault*> > det_faults(nt);
+  fsim.set_faults(fault_mgr.remain_list());
+  fsim.run_seq(tv_list, det_faults);
+  // Fsim::run_seq() は検出した故障を内部のリストから取り除くので
+  // 設定し直しておく．
+  fsim.set_faults(fault_mgr.remain_list());
+
+  ymuint det_count = 0;
+  ymuint last_frame = 0;
+  for (ymuint t = 0; t < nt; ++ t) {
+    if ( !det_faults[t].empty() ) {
+      last_frame = t + 1;
+    }
+    for (list<SaFault*>::iterator p = det_faults[t].begin();
+	 p != det_faults[t].end(); ++ p) {
+      SaFault* f = *p;
+      if ( f->status() == kFsUndetected || f->status() == kFsAbort ) {
+	fault_mgr.set_status(f, kFsDetected);
+	++ det_count;
+      }
+    }
+  }
+  fault_mgr.update();
+
+  for (vector<TestVector*>::iterator p = tv_list.begin();
+       p != tv_list.end(); ++ p) {
+    tv_mgr.delete_vector(*p);
+  }
+
+  local_timer.stop();
+
+  timer.change(old_timer_id);
+
+  mStats.mDetectNum = det_count;
+  mStats.mFrameNum = nt;
+  mStats.mLastFrame = last_frame;
+  mStats.mTime = local_timer.time();
+
+  return true;
+}
+
+// @brief テスト系列を読み込む．
+// @param[in] s 入力ストリーム
+// @param[in] err_out エラーメッセージを出力するストリーム
+// @param[out] tv_list 読み込んだテスト系列
+// @return 読み込みに失敗した時には false を返す．
+// @note FF の初期状態は先頭のテストベクタの FF の部分に入れる．
+bool
+SeqFsim::read(istream& s,
+	      ostream& err_out,
+	      vector<TestVector*>& tv_list)
+{
+  TgNetwork& network = _network();
+  TvMgr& tv_mgr = _tv_mgr();
+  ymuint ni1 = network.input_num1();
+  ymuint nff = network.ff_num();
+
+  string init_str(nff, '0');
+  string buf;
+  for (ymuint line = 1; getline(s, buf); ++ line) {
+    istringstream is(buf);
+    string word;
+    if ( !(is >> word) || word[0] == '#' ) {
+      continue;
+    }
+    bool init = false;
+    if ( word == "init" ) {
+      if ( !tv_list.empty() ) {
+	err_out << "line " << line
+		<< ": \"init\" must precede test vectors." << endl;
+	return false;
+      }
+      if ( !(is >> word) ) {
+	word = string();
+      }
+      init = true;
+    }
+    string rest;
+    if ( is >> rest ) {
+      err_out << "line " << line << ": syntax error." << endl;
+      return false;
+    }
+    ymuint n = init ? nff : ni1;
+    if ( word.size() != n ) {
+      err_out << "line " << line << ": " << n
+	      << " values are expected." << endl;
+      return false;
+    }
+    if ( init ) {
+      init_str = word;
+      continue;
+    }
+    TestVector* tv = tv_mgr.new_vector();
+    tv_list.push_back(tv);
+    if ( !set_vals(tv, 0, word) ) {
+      err_out << "line " << line << ": illegal character." << endl;
+      return false;
+    }
+  }
+  if ( tv_list.empty() ) {
+    return true;
+  }
+  if ( !set_vals(tv_list[0], ni1, init_str) ) {
+    err_out << "illegal character in the initial state." << endl;
+    return false;
+  }
+  return true;
+}
+
+// @brief 直前の実行結果を得る．
+const SeqFsimStats&
+SeqFsim::stats() const
+{
+  return mStats;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス SeqFsimStats
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+SeqFsimStats::SeqFsimStats()
+{
+  mDetectNum = 0;
+  mFrameNum = 0;
+  mLastFrame = 0;
+}
+
+// @brief デストラクタ
+SeqFsimStats::~SeqFsimStats()
+{
+}
+
+// @brief 検出した故障数を得る．
+ymuint
+SeqFsimStats::detected_faults() const
+{
+  return mDetectNum;
+}
+
+// @brief テスト系列の長さ(時刻数)を得る．
+ymuint
+SeqFsimStats::frame_num() const
+{
+  return mFrameNum;
+}
+
+// @brief 最後に故障を検出した時刻を得る．
+// @note 故障を検出しなかった時は 0 を返す．
+ymuint
+SeqFsimStats::last_effective_frame() const
+{
+  return mLastFrame;
+}
+
+// @brief 計算時間を得る．
+USTime
+SeqFsimStats::time() const
+{
+  return mTime;
+}
+
+END_NAMESPACE_YM_ATPG
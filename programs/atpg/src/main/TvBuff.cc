@@ -19,11 +19,20 @@
 
 BEGIN_NAMESPACE_YM_ATPG
 
+BEGIN_NONAMESPACE
+
+// 故障シミュレーションを行うまでに貯めるパタン数
+// PackedVal の幅(kPvBitLen)に合わせて増やすと検出済みの故障を
+// 落とすのが遅れて冗長なパタンが増えるので1ワード分に固定する．
+const ymuint kBuffSize = kPvWordBitLen;
+
+END_NONAMESPACE
+
 // @brief コンストラクタ
 TvBuff::TvBuff(AtpgMgr* mgr) :
   mMgr(mgr)
 {
-  mBuff.reserve(kPvBitLen);
+  mBuff.reserve(kBuffSize);
 }
   
 // @brief デストラクタ
@@ -45,7 +54,7 @@ void
 TvBuff::put(TestVector* tv)
 {
   mBuff.push_back(tv);
-  if ( mBuff.size() == kPvBitLen ) {
+  if ( mBuff.size() == kBuffSize ) {
     do_simulation();
   }
 }
@@ -0,0 +1,272 @@
+
+/// @file atpg/tests/seqfsim_test.cc
+/// @brief SeqFsim のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "AtpgMgr.h"
+#include "SeqFsim.h"
+#include "FaultMgr.h"
+#include "SaFault.h"
+#include "ym_tgnet/TgNetwork.h"
+#include "ym_tgnet/TgNode.h"
+#include "ym_tgnet/TgBlifReader.h"
+#include "ym_lexp/LogExpr.h"
+#include "ym_utils/RandGen.h"
+
+
+BEGIN_NAMESPACE_YM_ATPG
+
+BEGIN_NONAMESPACE
+
+// 1つの論理ノードの出力値を計算する．
+int
+eval_node(const TgNetwork& network,
+	  const TgNode* node,
+	  const vector<int>& ivals)
+{
+  ymuint ni = node->ni();
+  if ( node->is_cplx_logic() ) {
+    vector<ymulong> tmp(ni);
+    for (ymuint i = 0; i < ni; ++ i) {
+      tmp[i] = ivals[i] ? ~0UL : 0UL;
+    }
+    return network.get_lexp(node).eval(tmp) & 1UL;
+  }
+
+  int val = 0;
+  switch ( node->type() ) {
+  case kTgConst0:
+    val = 0;
+    break;
+
+  case kTgConst1:
+    val = 1;
+    break;
+
+  case kTgBuff:
+    val = ivals[0];
+    break;
+
+  case kTgNot:
+    val = ivals[0] ^ 1;
+    break;
+
+  case kTgAnd:
+  case kTgNand:
+    val = 1;
+    for (ymuint i = 0; i < ni; ++ i) {
+      val &= ivals[i];
+    }
+    if ( node->type() == kTgNand ) {
+      val ^= 1;
+    }
+    break;
+
+  case kTgOr:
+  case kTgNor:
+    val = 0;
+    for (ymuint i = 0; i < ni; ++ i) {
+      val |= ivals[i];
+    }
+    if ( node->type() == kTgNor ) {
+      val ^= 1;
+    }
+    break;
+
+  case kTgXor:
+  case kTgXnor:
+    val = 0;
+    for (ymuint i = 0; i < ni; ++ i) {
+      val ^= ivals[i];
+    }
+    if ( node->type() == kTgXnor ) {
+      val ^= 1;
+    }
+    break;
+
+  default:
+    assert_not_reached(__FILE__, __LINE__);
+  }
+  return val;
+}
+
+// 1時刻分の回路を計算する．
+// fault が NULL でなければその故障を挿入する．
+void
+eval_frame(const TgNetwork& network,
+	   const vector<int>& ivals,
+	   vector<int>& state,
+	   SaFault* fault,
+	   vector<int>& vals)
+{
+  ymuint ni1 = network.input_num1();
+  ymuint nff = network.ff_num();
+  ymuint no1 = network.output_num1();
+
+  for (ymuint i = 0; i < ni1 + nff; ++ i) {
+    const TgNode* node = network.input(i);
+    int val = (i < ni1) ? ivals[i] : state[i - ni1];
+    if ( fault && fault->node() == node && fault->is_output_fault() ) {
+      val = fault->val();
+    }
+    vals[node->gid()] = val;
+  }
+
+  vector<int> tmp;
+  ymuint nl = network.logic_num();
+  for (ymuint i = 0; i < nl; ++ i) {
+    const TgNode* node = network.sorted_logic(i);
+    ymuint ni = node->ni();
+    tmp.resize(ni);
+    for (ymuint j = 0; j < ni; ++ j) {
+      tmp[j] = vals[node->fanin(j)->gid()];
+      if ( fault && fault->node() == node && fault->is_input_fault() &&
+	   fault->pos() == j ) {
+	tmp[j] = fault->val();
+      }
+    }
+    int val = eval_node(network, node, tmp);
+    if ( fault && fault->node() == node && fault->is_output_fault() ) {
+      val = fault->val();
+    }
+    vals[node->gid()] = val;
+  }
+
+  for (ymuint i = 0; i < nff; ++ i) {
+    state[i] = vals[network.output(no1 + i)->fanin(0)->gid()];
+  }
+}
+
+// 1つの故障ごとに良い回路と故障回路を並べて計算する．
+// 故障を検出したら true を返す．
+bool
+serial_fsim(const TgNetwork& network,
+	    const vector<vector<int> >& seq,
+	    SaFault* fault)
+{
+  ymuint nn = network.node_num();
+  ymuint nff = network.ff_num();
+  ymuint no1 = network.output_num1();
+
+  vector<int> gvals(nn);
+  vector<int> fvals(nn);
+  vector<int> gstate(nff, 0);
+  vector<int> fstate(nff, 0);
+  for (vector<vector<int> >::const_iterator p = seq.begin();
+       p != seq.end(); ++ p) {
+    eval_frame(network, *p, gstate, NULL, gvals);
+    eval_frame(network, *p, fstate, fault, fvals);
+    for (ymuint i = 0; i < no1; ++ i) {
+      ymuint id = network.output(i)->fanin(0)->gid();
+      if ( gvals[id] != fvals[id] ) {
+	return true;
+      }
+    }
+  }
+  return false;
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM_ATPG
+
+
+int
+main(int argc,
+     char** argv)
+{
+  using namespace std;
+  using namespace nsYm;
+  using namespace nsYm::nsAtpg;
+
+  ymuint thread_num = 1;
+  ymuint length = 100;
+  ymuint32 seed = 1;
+  int base = 1;
+  for ( ; base < argc && argv[base][0] == '-'; base += 2) {
+    if ( base + 1 == argc ) {
+      break;
+    }
+    string opt = argv[base];
+    int val = atoi(argv[base + 1]);
+    if ( opt == "-t" ) {
+      thread_num = val;
+    }
+    else if ( opt == "-l" ) {
+      length = val;
+    }
+    else if ( opt == "-s" ) {
+      seed = val;
+    }
+    else {
+      break;
+    }
+  }
+  if ( base + 1 != argc ) {
+    cerr << "USAGE : " << argv[0]
+	 << " [-t <threads>] [-l <length>] [-s <seed>] blif-file" << endl;
+    return 2;
+  }
+
+  AtpgMgr mgr;
+  TgNetwork& network = mgr._network();
+  FaultMgr& fault_mgr = mgr._fault_mgr();
+
+  TgBlifReader reader;
+  if ( !reader(argv[base], network) ) {
+    cerr << "Error in reading " << argv[base] << endl;
+    return 1;
+  }
+  mgr.after_set_network();
+  fault_mgr.set_ssa_fault(network);
+  mgr.after_update_faults();
+  mgr.set_fsim_thread_num(thread_num);
+
+  // ランダムなテスト系列を作る．
+  RandGen randgen;
+  randgen.init(seed);
+  ymuint ni1 = network.input_num1();
+  vector<vector<int> > seq(length, vector<int>(ni1));
+  ostringstream buf;
+  for (ymuint t = 0; t < length; ++ t) {
+    for (ymuint i = 0; i < ni1; ++ i) {
+      seq[t][i] = randgen.int32() & 1U;
+      buf << seq[t][i];
+    }
+    buf << endl;
+  }
+
+  vector<SaFault*> fault_list(fault_mgr.remain_list());
+  SeqFsim seqfsim(&mgr);
+  istringstream is(buf.str());
+  if ( !seqfsim(is, cerr) ) {
+    return 1;
+  }
+
+  // 1つずつ計算した結果と比較する．
+  ymuint nerr = 0;
+  for (vector<SaFault*>::iterator p = fault_list.begin();
+       p != fault_list.end(); ++ p) {
+    SaFault* f = *p;
+    bool det = (f->status() == kFsDetected);
+    if ( det ) {
+      cout << f->str() << endl;
+    }
+    if ( serial_fsim(network, seq, f) != det ) {
+      cerr << "Error: " << f->str() << " is "
+	   << (det ? "detected" : "not detected")
+	   << " by SeqFsim" << endl;
+      ++ nerr;
+    }
+  }
+  if ( nerr > 0 ) {
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,359 @@
+
+/// @file atpg/tests/tdf_test.cc
+/// @brief 遷移故障の Dtpg のテストプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// $Id$
+///
+/// Copyright (C) 2005-2010 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "AtpgMgr.h"
+#include "Dtpg.h"
+#include "FaultMgr.h"
+#include "SaFault.h"
+#include "TestVector.h"
+#include "ym_tgnet/TgNetwork.h"
+#include "ym_tgnet/TgNode.h"
+#include "ym_tgnet/TgBlifReader.h"
+#include "ym_lexp/LogExpr.h"
+
+
+BEGIN_NAMESPACE_YM_ATPG
+
+BEGIN_NONAMESPACE
+
+// 1つの論理ノードの出力値を 64 パタン分計算する．
+ymulong
+eval_node(const TgNetwork& network,
+	  const TgNode* node,
+	  const vector<ymulong>& ivals)
+{
+  ymuint ni = node->ni();
+  if ( node->is_cplx_logic() ) {
+    return network.get_lexp(node).eval(ivals);
+  }
+
+  ymulong val = 0UL;
+  switch ( node->type() ) {
+  case kTgConst0:
+    val = 0UL;
+    break;
+
+  case kTgConst1:
+    val = ~0UL;
+    break;
+
+  case kTgBuff:
+    val = ivals[0];
+    break;
+
+  case kTgNot:
+    val = ~ivals[0];
+    break;
+
+  case kTgAnd:
+  case kTgNand:
+    val = ~0UL;
+    for (ymuint i = 0; i < ni; ++ i) {
+      val &= ivals[i];
+    }
+    if ( node->type() == kTgNand ) {
+      val = ~val;
+    }
+    break;
+
+  case kTgOr:
+  case kTgNor:
+    val = 0UL;
+    for (ymuint i = 0; i < ni; ++ i) {
+      val |= ivals[i];
+    }
+    if ( node->type() == kTgNor ) {
+      val = ~val;
+    }
+    break;
+
+  case kTgXor:
+  case kTgXnor:
+    val = 0UL;
+    for (ymuint i = 0; i < ni; ++ i) {
+      val ^= ivals[i];
+    }
+    if ( node->type() == kTgXnor ) {
+      val = ~val;
+    }
+    break;
+
+  default:
+    assert_not_reached(__FILE__, __LINE__);
+  }
+  return val;
+}
+
+// 1時刻分の回路を 64 パタン分計算する．
+// ivals は外部入力と FF の出力の順に並んでいる．
+// fault が NULL でなければその故障を縮退故障として挿入する．
+void
+eval_frame(const TgNetwork& network,
+	   const vector<ymulong>& ivals,
+	   SaFault* fault,
+	   vector<ymulong>& vals)
+{
+  ymulong fval = 0UL;
+  if ( fault && fault->val() ) {
+    fval = ~0UL;
+  }
+
+  ymuint ni2 = network.input_num2();
+  for (ymuint i = 0; i < ni2; ++ i) {
+    const TgNode* node = network.input(i);
+    ymulong val = ivals[i];
+    if ( fault && fault->node() == node && fault->is_output_fault() ) {
+      val = fval;
+    }
+    vals[node->gid()] = val;
+  }
+
+  vector<ymulong> tmp;
+  ymuint nl = network.logic_num();
+  for (ymuint i = 0; i < nl; ++ i) {
+    const TgNode* node = network.sorted_logic(i);
+    ymuint ni = node->ni();
+    tmp.resize(ni);
+    for (ymuint j = 0; j < ni; ++ j) {
+      tmp[j] = vals[node->fanin(j)->gid()];
+      if ( fault && fault->node() == node && fault->is_input_fault() &&
+	   fault->pos() == j ) {
+	tmp[j] = fval;
+      }
+    }
+    ymulong val = eval_node(network, node, tmp);
+    if ( fault && fault->node() == node && fault->is_output_fault() ) {
+      val = fval;
+    }
+    vals[node->gid()] = val;
+  }
+}
+
+// launch-on-capture で遷移故障を 64 パタン分シミュレーションする．
+// ivals は1時刻めの外部入力と FF の出力の値，
+// pi2vals は2時刻めの外部入力の値．
+// 検出された故障の det の要素を true にする．
+void
+tdf_fsim(const TgNetwork& network,
+	 const vector<ymulong>& ivals,
+	 const vector<ymulong>& pi2vals,
+	 const vector<SaFault*>& fault_list,
+	 vector<bool>& det)
+{
+  ymuint nn = network.node_num();
+  ymuint ni1 = network.input_num1();
+  ymuint ni2 = network.input_num2();
+  ymuint no1 = network.output_num1();
+  ymuint no2 = network.output_num2();
+  ymuint nff = network.ff_num();
+
+  // 1時刻めの正常値
+  vector<ymulong> vals1(nn);
+  eval_frame(network, ivals, NULL, vals1);
+
+  // 2時刻めの入力は外部入力が pi2vals，FF の出力が1時刻めの FF の入力
+  vector<ymulong> ivals2(ni2);
+  for (ymuint i = 0; i < ni1; ++ i) {
+    ivals2[i] = pi2vals[i];
+  }
+  for (ymuint i = 0; i < nff; ++ i) {
+    ivals2[ni1 + i] = vals1[network.output(no1 + i)->fanin(0)->gid()];
+  }
+  vector<ymulong> gvals(nn);
+  eval_frame(network, ivals2, NULL, gvals);
+
+  vector<ymulong> fvals(nn);
+  ymuint nf = fault_list.size();
+  for (ymuint k = 0; k < nf; ++ k) {
+    if ( det[k] ) {
+      continue;
+    }
+    SaFault* f = fault_list[k];
+    // 1時刻めの故障箇所の値が故障値と等しいこと．
+    ymulong v1 = vals1[f->source_node()->gid()];
+    ymulong act = f->val() ? v1 : ~v1;
+    if ( act == 0UL ) {
+      continue;
+    }
+    eval_frame(network, ivals2, f, fvals);
+    ymulong diff = 0UL;
+    for (ymuint i = 0; i < no2; ++ i) {
+      ymuint id = network.output(i)->fanin(0)->gid();
+      diff |= gvals[id] ^ fvals[id];
+    }
+    if ( act & diff ) {
+      det[k] = true;
+    }
+  }
+}
+
+END_NONAMESPACE
+
+END_NAMESPACE_YM_ATPG
+
+
+// 遷移故障を対象に SAT で Dtpg を実行し，
+// - 検出済みとなった故障が生成されたパタンで検出されること
+// - 検出不能となった故障が生成されたパタンで検出されないこと
+// - 入力の値の数が -e の値以下なら検出不能となった故障が
+//   どの2時刻のパタンでも検出されないこと
+// を独立な2時刻分のシミュレーションで確かめる．
+int
+main(int argc,
+     char** argv)
+{
+  using namespace std;
+  using namespace nsYm;
+  using namespace nsYm::nsAtpg;
+
+  ymuint exhaust_max = 20;
+  int base = 1;
+  for ( ; base < argc && argv[base][0] == '-'; base += 2) {
+    if ( base + 1 == argc ) {
+      break;
+    }
+    string opt = argv[base];
+    int val = atoi(argv[base + 1]);
+    if ( opt == "-e" ) {
+      exhaust_max = val;
+    }
+    else {
+      break;
+    }
+  }
+  if ( base + 1 != argc ) {
+    cerr << "USAGE : " << argv[0]
+	 << " [-e <exhaust_max>] blif-file" << endl;
+    return 2;
+  }
+
+  AtpgMgr mgr;
+  TgNetwork& network = mgr._network();
+  FaultMgr& fault_mgr = mgr._fault_mgr();
+  // Dtpg は after_set_network() より前に登録しておく必要がある．
+  Dtpg dtpg(&mgr);
+
+  TgBlifReader reader;
+  if ( !reader(argv[base], network) ) {
+    cerr << "Error in reading " << argv[base] << endl;
+    return 1;
+  }
+  mgr.after_set_network();
+  fault_mgr.set_tdf_fault(network);
+  mgr.after_update_faults();
+
+  vector<SaFault*> fault_list(fault_mgr.remain_list());
+  dtpg.set_sat(true);
+  dtpg(kSimPpsfp);
+
+  const DtpgStats& stats = dtpg.stats();
+  cout << "detected:   " << stats.detected_faults() << endl
+       << "untestable: " << stats.untestable_faults() << endl
+       << "aborted:    " << stats.aborted_faults() << endl;
+
+  ymuint ni1 = network.input_num1();
+  ymuint ni2 = network.input_num2();
+  ymuint nf = fault_list.size();
+
+  // 生成されたパタンを 64 個ずつシミュレーションする．
+  // 余ったビットには先頭のパタンを詰めておく．
+  const vector<TestVector*>& tv_list = mgr._tv_list();
+  vector<bool> det(nf, false);
+  vector<ymulong> ivals(ni2);
+  vector<ymulong> pi2vals(ni1);
+  for (ymuint top = 0; top < tv_list.size(); top += 64) {
+    for (ymuint i = 0; i < ni2; ++ i) {
+      ivals[i] = 0UL;
+    }
+    for (ymuint i = 0; i < ni1; ++ i) {
+      pi2vals[i] = 0UL;
+    }
+    for (ymuint b = 0; b < 64; ++ b) {
+      ymuint pos = top + b;
+      if ( pos >= tv_list.size() ) {
+	pos = top;
+      }
+      const TestVector* tv = tv_list[pos];
+      for (ymuint i = 0; i < ni2; ++ i) {
+	if ( tv->val3(i) == kVal1 ) {
+	  ivals[i] |= (1UL << b);
+	}
+      }
+      for (ymuint i = 0; i < ni1; ++ i) {
+	if ( tv->pi2_val3(i) == kVal1 ) {
+	  pi2vals[i] |= (1UL << b);
+	}
+      }
+    }
+    tdf_fsim(network, ivals, pi2vals, fault_list, det);
+  }
+
+  ymuint nerr = 0;
+  for (ymuint k = 0; k < nf; ++ k) {
+    SaFault* f = fault_list[k];
+    if ( f->status() == kFsDetected && !det[k] ) {
+      cerr << "Error: " << f->str()
+	   << " is not detected by the generated patterns" << endl;
+      ++ nerr;
+    }
+    else if ( f->status() == kFsUntestable && det[k] ) {
+      cerr << "Error: " << f->str()
+	   << " is untestable but detected by the generated patterns" << endl;
+      ++ nerr;
+    }
+  }
+
+  // 入力数が少なければ全ての2時刻のパタンで検出不能故障を確かめる．
+  // パタン番号のビット i を i 番めの値(1時刻めの入力，2時刻めの
+  // 外部入力の順)に割り当てる．
+  ymuint nb = ni2 + ni1;
+  if ( nb <= exhaust_max ) {
+    vector<SaFault*> untest_list;
+    for (ymuint k = 0; k < nf; ++ k) {
+      SaFault* f = fault_list[k];
+      if ( f->status() == kFsUntestable ) {
+	untest_list.push_back(f);
+      }
+    }
+    vector<bool> udet(untest_list.size(), false);
+    ymuint nw = (nb > 6) ? (1U << (nb - 6)) : 1;
+    for (ymuint w = 0; w < nw; ++ w) {
+      for (ymuint i = 0; i < nb; ++ i) {
+	ymulong pat = 0UL;
+	for (ymuint b = 0; b < 64; ++ b) {
+	  ymuint64 p = (static_cast<ymuint64>(w) << 6) + b;
+	  if ( (p >> i) & 1U ) {
+	    pat |= (1UL << b);
+	  }
+	}
+	if ( i < ni2 ) {
+	  ivals[i] = pat;
+	}
+	else {
+	  pi2vals[i - ni2] = pat;
+	}
+      }
+      tdf_fsim(network, ivals, pi2vals, untest_list, udet);
+    }
+    for (ymuint k = 0; k < untest_list.size(); ++ k) {
+      if ( udet[k] ) {
+	cerr << "Error: " << untest_list[k]->str()
+	     << " is untestable but detectable" << endl;
+	++ nerr;
+      }
+    }
+  }
+
+  if ( nerr > 0 ) {
+    return 1;
+  }
+  return 0;
+}
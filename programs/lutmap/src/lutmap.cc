@@ -164,6 +164,7 @@ main(int argc,
 	      4,            // LUT の入力数
 	      0,            // スラック
 	      3,            // モード(0から3の値)
+	      0,            // カット数(0 なら全て列挙する)
 	      lut_network,
 	      lut_num,
 	      depth);
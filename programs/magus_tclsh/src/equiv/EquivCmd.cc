@@ -54,7 +54,7 @@ EquivCmdBase::EquivCmdBase(MagMgr* mgr) :
   
   mPoptSat = new TclPoptStr(this, "sat",
 			    "specify SAT-Solver",
-			    "ymsat|minisat|satlog");
+			    "ymsat|minisat|satlog|portfolio|portfolio-det");
   
   mPoptSatlog = new TclPoptStr(this, "satlog",
 			       "output logfile for SAT solver",
@@ -384,6 +384,19 @@ EquivCmd::EquivCmd(MagMgr* mgr) :
   
   mPoptSigSize = new TclPoptInt(this, "sigsize",
 				"specify the size of signature");
+
+  mPoptSweep = new TclPopt(this, "sweep",
+			   "use SAT sweeping on the whole miter");
+
+  mPoptThreads = new TclPoptInt(this, "threads",
+				"specify the number of SAT threads for -sweep");
+
+  mPoptSeq = new TclPopt(this, "seq",
+			 "check sequential equivalence from the reset state");
+  new_popt_group(mPoptSweep, mPoptSeq);
+
+  mPoptDepth = new TclPoptInt(this, "depth",
+			      "specify the max depth of BMC/k-induction for -seq");
   
   set_usage_string("<network1> ?<network2>?");
 }
@@ -409,16 +422,44 @@ EquivCmd::cmd_proc(TclObjVector& objv)
       sigsize = mPoptSigSize->val();
     }
     
+    ymuint thread_num = 1;
+    if ( mPoptThreads->is_specified() && mPoptThreads->val() > 0 ) {
+      thread_num = mPoptThreads->val();
+    }
+
+    ymuint max_depth = 8;
+    if ( mPoptDepth->is_specified() && mPoptDepth->val() >= 0 ) {
+      max_depth = mPoptDepth->val();
+    }
+    
     const BNetwork& src_network1 = *network1();
     const BNetwork& src_network2 = *network2();
     
     vector<Bool3> comp_stats;
-    check_ceq(src_network1, src_network2,
-	      input_match(), output_match(),
-	      log_level(), &cout,
-	      sat_type(), sat_option(), sat_out(),
-	      sigsize,
-	      comp_stats);
+    if ( mPoptSweep->is_specified() ) {
+      sweep_ceq(src_network1, src_network2,
+		input_match(), output_match(),
+		log_level(), &cout,
+		sat_type(), sat_option(),
+		thread_num,
+		comp_stats);
+    }
+    else if ( mPoptSeq->is_specified() ) {
+      check_sceq(src_network1, src_network2,
+		 input_match(), output_match(),
+		 log_level(), &cout,
+		 sat_type(), sat_option(), sat_out(),
+		 sigsize, max_depth,
+		 comp_stats);
+    }
+    else {
+      check_ceq(src_network1, src_network2,
+		input_match(), output_match(),
+		log_level(), &cout,
+		sat_type(), sat_option(), sat_out(),
+		sigsize,
+		comp_stats);
+    }
     
     bool has_neq = false;
     bool has_abt = false;
@@ -200,6 +200,18 @@ private:
   // sigsize オプション解析用のオブジェクト
   TclPoptInt* mPoptSigSize;
 
+  // sweep オプション解析用のオブジェクト
+  TclPopt* mPoptSweep;
+
+  // threads オプション解析用のオブジェクト
+  TclPoptInt* mPoptThreads;
+
+  // seq オプション解析用のオブジェクト
+  TclPopt* mPoptSeq;
+
+  // depth オプション解析用のオブジェクト
+  TclPoptInt* mPoptDepth;
+
 };
 
 
@@ -29,6 +29,8 @@ AreaMapCmd::AreaMapCmd(MagMgr* mgr,
 			       "tree|df|dag|fo");
   mPoptResub = new TclPopt(this, "resub",
 			   "do cut resubstitution");
+  mPoptCutNum = new TclPoptInt(this, "cut_num",
+				"keep only the best <INT> cuts per node");
   mPoptVerbose = new TclPopt(this, "verbose",
 			     "verbose mode");
   set_usage_string("<#inputs>[=INT]");
@@ -64,6 +66,11 @@ AreaMapCmd::cmd_proc(TclObjVector& objv)
     mode |= 2;
   }
 
+  ymuint cut_num = 0;
+  if ( mPoptCutNum->is_specified() && mPoptCutNum->val() > 0 ) {
+    cut_num = mPoptCutNum->val();
+  }
+
   ymuint objc = objv.size();
   if ( objc != 2 ) {
     print_usage();
@@ -79,7 +86,7 @@ AreaMapCmd::cmd_proc(TclObjVector& objv)
   ymuint lut_num;
   ymuint depth;
 
-  area_map(sbjgraph(), limit, mode, lutnetwork(), lut_num, depth);
+  area_map(sbjgraph(), limit, mode, cut_num, lutnetwork(), lut_num, depth);
 
   set_var("::magus::lutmap_stats", "lut_num",
 	  lut_num,
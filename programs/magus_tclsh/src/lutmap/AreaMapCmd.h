@@ -53,6 +53,9 @@ private:
   // resub オプションの解析用オブジェクト
   TclPopt* mPoptResub;
 
+  // cut_num オプションの解析用オブジェクト
+  TclPoptInt* mPoptCutNum;
+
   // verbose オプションの解析用オブジェクト
   TclPopt* mPoptVerbose;
 
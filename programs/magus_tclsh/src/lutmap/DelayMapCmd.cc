@@ -33,6 +33,8 @@ DelayMapCmd::DelayMapCmd(MagMgr* mgr,
 			      "specify slack value");
   mPoptResub = new TclPopt(this, "resub",
 			   "do cut resubstitution");
+  mPoptCutNum = new TclPoptInt(this, "cut_num",
+				"keep only the best <INT> cuts per node");
   mPoptVerbose = new TclPopt(this, "verbose",
 			     "verbose mode");
   set_usage_string("<#inputs>[=INT]");
@@ -74,6 +76,11 @@ DelayMapCmd::cmd_proc(TclObjVector& objv)
     mode |= 2;
   }
 
+  ymuint cut_num = 0;
+  if ( mPoptCutNum->is_specified() && mPoptCutNum->val() > 0 ) {
+    cut_num = mPoptCutNum->val();
+  }
+
   if ( mPoptVerbose->is_specified() ) {
     verbose = true;
   }
@@ -93,7 +100,8 @@ DelayMapCmd::cmd_proc(TclObjVector& objv)
 
     ymuint lut_num;
     ymuint depth;
-    delay_map(sbjgraph(), limit, slack, mode, lutnetwork(), lut_num, depth);
+    delay_map(sbjgraph(), limit, slack, mode, cut_num,
+	      lutnetwork(), lut_num, depth);
 
     set_var("::magus::lutmap_stats", "lut_num",
 	    lut_num,